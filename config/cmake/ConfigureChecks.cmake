@@ -152,6 +152,22 @@ if (NOT WINDOWS)
   endif ()
 endif ()
 
+#-----------------------------------------------------------------------------
+#  Check if the io_uring driver can be built
+#-----------------------------------------------------------------------------
+if (CMAKE_SYSTEM_NAME MATCHES "Linux")
+  option (HDF5_ENABLE_IOURING_VFD "Build the Linux io_uring Virtual File Driver" OFF)
+  if (HDF5_ENABLE_IOURING_VFD)
+    CHECK_INCLUDE_FILE ("linux/io_uring.h" HAVE_LINUX_IO_URING_H)
+    CHECK_SYMBOL_EXISTS (__NR_io_uring_setup "sys/syscall.h" HAVE_NR_IO_URING_SETUP)
+    if (HAVE_LINUX_IO_URING_H AND HAVE_NR_IO_URING_SETUP)
+      set (${HDF_PREFIX}_HAVE_IOURING 1)
+    else ()
+      message (FATAL_ERROR "The io_uring VFD was requested but cannot be built: <linux/io_uring.h> or the io_uring system calls were not found")
+    endif ()
+  endif ()
+endif ()
+
 #-----------------------------------------------------------------------------
 # Check if C has __float128 extension
 #-----------------------------------------------------------------------------
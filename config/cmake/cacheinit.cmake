@@ -27,6 +27,7 @@ set (ALLOW_UNSUPPORTED OFF CACHE BOOL "Enable unsupported combinations of config
 set (HDF5_ENABLE_DEPRECATED_SYMBOLS ON CACHE BOOL "Enable deprecated public API symbols" FORCE)
 
 set (HDF5_ENABLE_DIRECT_VFD OFF CACHE BOOL "Build the Direct I/O Virtual File Driver" FORCE)
+set (HDF5_ENABLE_IOURING_VFD OFF CACHE BOOL "Build the Linux io_uring Virtual File Driver" FORCE)
 
 set (HDF5_ENABLE_PARALLEL OFF CACHE BOOL "Enable parallel build (requires MPI)" FORCE)
 
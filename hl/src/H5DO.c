@@ -97,6 +97,250 @@ done:
     return(ret_value);
 } /* end H5DOwrite_chunk() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5DOwrite_chunks
+ *
+ * Purpose:     Writes NCHUNKS entire chunks to the file directly.  Chunk
+ *              U has logical offset OFFSETS[U], filter mask FILTERS[U]
+ *              and DATA_SIZES[U] bytes of data in BUFS[U].  File space
+ *              for the new chunks is allocated together and the chunks
+ *              are written with one vector write.  A chunk may appear
+ *              only once in a call.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5DOwrite_chunks(hid_t dset_id, hid_t dxpl_id, size_t nchunks, 
+    const uint32_t filters[], const hsize_t *offsets[], const size_t data_sizes[],
+    const void *bufs[])
+{
+    hbool_t created_dxpl = FALSE;       /* Whether we created a DXPL */
+    hbool_t do_direct_write = TRUE;     /* Flag for direct writes */
+    size_t no_chunks = 0;               /* Number of chunks to reset the DXPL with */
+    size_t u;                           /* Local index variable */
+    herr_t  ret_value = FAIL;           /* Return value */
+    
+    /* Check arguments */
+    if(dset_id < 0)
+        goto done;
+    if(!filters || !offsets || !data_sizes || !bufs)
+        goto done;
+    for(u = 0; u < nchunks; u++)
+        if(!offsets[u] || !bufs[u] || !data_sizes[u])
+            goto done;
+
+    /* Nothing to do */
+    if(0 == nchunks) {
+        ret_value = SUCCEED;
+        goto done;
+    } /* end if */
+
+    /* If the user passed in a default DXPL, create one to pass to H5Dwrite() */
+    if(H5P_DEFAULT == dxpl_id) {
+	if((dxpl_id = H5Pcreate(H5P_DATASET_XFER)) < 0)
+            goto done;
+        created_dxpl = TRUE;
+    } /* end if */
+
+    /* Set direct write parameters */
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_WRITE_FLAG_NAME, &do_direct_write) < 0)
+        goto done;
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_WRITE_NCHUNKS_NAME, &nchunks) < 0)
+        goto done;
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_WRITE_FILTERS_LIST_NAME, &filters) < 0)
+        goto done;
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_WRITE_OFFSET_LIST_NAME, &offsets) < 0)
+        goto done;
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZE_LIST_NAME, &data_sizes) < 0)
+        goto done;
+
+    /* Write chunks */
+    if(H5Dwrite(dset_id, 0, H5S_ALL, H5S_ALL, dxpl_id, bufs) < 0)
+        goto done;
+
+    /* Indicate success */
+    ret_value = SUCCEED;
+
+done:
+    if(created_dxpl) {
+        if(H5Pclose(dxpl_id) < 0)
+            ret_value = FAIL;
+    } /* end if */
+    else if(H5P_DEFAULT != dxpl_id) {
+        /* Reset the direct write parameters on user DXPL */
+        do_direct_write = FALSE;
+        if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_WRITE_FLAG_NAME, &do_direct_write) < 0)
+            ret_value = FAIL;
+        if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_WRITE_NCHUNKS_NAME, &no_chunks) < 0)
+            ret_value = FAIL;
+    } /* end if */
+
+    return(ret_value);
+} /* end H5DOwrite_chunks() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5DOread_chunk
+ *
+ * Purpose:     Reads an entire chunk from the file directly, as it is
+ *              stored, without passing it through the filter pipeline.
+ *              The chunk's filter mask is returned in FILTERS.  BUF must
+ *              be large enough for the stored chunk, whose size can be
+ *              found with H5Dget_chunk_info_by_coord.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5DOread_chunk(hid_t dset_id, hid_t dxpl_id, const hsize_t *offset, uint32_t *filters,
+         void *buf)
+{
+    hbool_t created_dxpl = FALSE;       /* Whether we created a DXPL */
+    hbool_t do_direct_read = TRUE;      /* Flag for direct reads */
+    herr_t  ret_value = FAIL;           /* Return value */
+
+    /* Check arguments */
+    if(dset_id < 0)
+        goto done;
+    if(!buf)
+        goto done;
+    if(!offset)
+        goto done;
+    if(!filters)
+        goto done;
+
+    /* If the user passed in a default DXPL, create one to pass to H5Dread() */
+    if(H5P_DEFAULT == dxpl_id) {
+	if((dxpl_id = H5Pcreate(H5P_DATASET_XFER)) < 0)
+            goto done;
+        created_dxpl = TRUE;
+    } /* end if */
+
+    /* Set direct read parameters */
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_READ_FLAG_NAME, &do_direct_read) < 0)
+        goto done;
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_READ_OFFSET_NAME, &offset) < 0)
+        goto done;
+
+    /* Read chunk */
+    if(H5Dread(dset_id, 0, H5S_ALL, H5S_ALL, dxpl_id, buf) < 0)
+        goto done;
+
+    /* Get the chunk's filter mask */
+    if(H5Pget(dxpl_id, H5D_XFER_DIRECT_CHUNK_READ_FILTERS_NAME, filters) < 0)
+        goto done;
+
+    /* Indicate success */
+    ret_value = SUCCEED;
+
+done:
+    if(created_dxpl) {
+        if(H5Pclose(dxpl_id) < 0)
+            ret_value = FAIL;
+    } /* end if */
+    else if(H5P_DEFAULT != dxpl_id) {
+        /* Reset the direct read flag on user DXPL */
+        do_direct_read = FALSE;
+        if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_READ_FLAG_NAME, &do_direct_read) < 0)
+            ret_value = FAIL;
+    } /* end if */
+
+    return(ret_value);
+} /* end H5DOread_chunk() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5DOread_chunks
+ *
+ * Purpose:     Reads NCHUNKS entire chunks from the file directly, as
+ *              they are stored, into BUF with a single vector read.  The
+ *              chunks are placed one after another in the order of
+ *              OFFSETS; the size and filter mask of chunk U are returned
+ *              in DATA_SIZES[U] and FILTERS[U].  Chunks that haven't been
+ *              written get a size of zero.  The call fails without
+ *              reading anything if the chunks need more than BUF_SIZE
+ *              bytes.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5DOread_chunks(hid_t dset_id, hid_t dxpl_id, size_t nchunks, const hsize_t *offsets[],
+    uint32_t filters[], size_t data_sizes[], void *buf, size_t buf_size)
+{
+    hbool_t created_dxpl = FALSE;       /* Whether we created a DXPL */
+    hbool_t do_direct_read = TRUE;      /* Flag for direct reads */
+    size_t no_chunks = 0;               /* Number of chunks to reset the DXPL with */
+    size_t u;                           /* Local index variable */
+    herr_t  ret_value = FAIL;           /* Return value */
+
+    /* Check arguments */
+    if(dset_id < 0)
+        goto done;
+    if(!offsets || !filters || !data_sizes)
+        goto done;
+    if(buf_size > 0 && !buf)
+        goto done;
+    for(u = 0; u < nchunks; u++)
+        if(!offsets[u])
+            goto done;
+
+    /* Nothing to do */
+    if(0 == nchunks) {
+        ret_value = SUCCEED;
+        goto done;
+    } /* end if */
+
+    /* If the user passed in a default DXPL, create one to pass to H5Dread() */
+    if(H5P_DEFAULT == dxpl_id) {
+	if((dxpl_id = H5Pcreate(H5P_DATASET_XFER)) < 0)
+            goto done;
+        created_dxpl = TRUE;
+    } /* end if */
+
+    /* Set direct read parameters */
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_READ_FLAG_NAME, &do_direct_read) < 0)
+        goto done;
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_READ_NCHUNKS_NAME, &nchunks) < 0)
+        goto done;
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_READ_OFFSET_LIST_NAME, &offsets) < 0)
+        goto done;
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_READ_FILTERS_LIST_NAME, &filters) < 0)
+        goto done;
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_READ_DATASIZE_LIST_NAME, &data_sizes) < 0)
+        goto done;
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_READ_BUF_SIZE_NAME, &buf_size) < 0)
+        goto done;
+
+    /* Read chunks */
+    if(H5Dread(dset_id, 0, H5S_ALL, H5S_ALL, dxpl_id, buf) < 0)
+        goto done;
+
+    /* Indicate success */
+    ret_value = SUCCEED;
+
+done:
+    if(created_dxpl) {
+        if(H5Pclose(dxpl_id) < 0)
+            ret_value = FAIL;
+    } /* end if */
+    else if(H5P_DEFAULT != dxpl_id) {
+        /* Reset the direct read parameters on user DXPL */
+        do_direct_read = FALSE;
+        if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_READ_FLAG_NAME, &do_direct_read) < 0)
+            ret_value = FAIL;
+        if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_READ_NCHUNKS_NAME, &no_chunks) < 0)
+            ret_value = FAIL;
+    } /* end if */
+
+    return(ret_value);
+} /* end H5DOread_chunks() */
+
 
 /*
  * Function:	H5DOappend()
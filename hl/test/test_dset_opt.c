@@ -34,11 +34,14 @@
 #define DATASETNAME4        "data_conv"
 #define DATASETNAME5        "contiguous_dset"
 #define DATASETNAME6        "invalid_argue"
+#define DATASETNAME7        "direct_write_multi"
+#define DATASETNAME8        "direct_read"
 #define RANK         2
 #define NX     16
 #define NY     16
 #define CHUNK_NX     4
 #define CHUNK_NY     4
+#define NCHUNKS      ((NX / CHUNK_NX) * (NY / CHUNK_NY))
 
 #define DEFLATE_SIZE_ADJUST(s) (ceil(((double)(s))*(double)1.001F)+12)
 
@@ -334,6 +337,386 @@ error:
 }
 #endif /* H5_HAVE_FILTER_DEFLATE */
 
+/*-------------------------------------------------------------------------
+ * Function:	test_direct_chunk_write_multi
+ *
+ * Purpose:	Test writing a batch of chunks with H5DOwrite_chunks
+ *
+ * Return:	Success:	0
+ *
+ *		Failure:	1
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifdef H5_HAVE_FILTER_DEFLATE
+static int
+test_direct_chunk_write_multi (hid_t file)
+{
+    hid_t       dataspace = -1, dataset = -1;
+    hid_t       cparms = -1, dxpl = -1;
+    hsize_t     dims[2]  = {NX, NY};
+    hsize_t     maxdims[2] = {H5S_UNLIMITED, H5S_UNLIMITED};
+    hsize_t     chunk_dims[2] ={CHUNK_NX, CHUNK_NY};
+    int         check[NX][NY];
+    int         chunk_data[NCHUNKS][CHUNK_NX][CHUNK_NY];
+    hsize_t     offsets[NCHUNKS][2];
+    const hsize_t *offset_ptrs[NCHUNKS];
+    uint32_t    filters[NCHUNKS];
+    size_t      data_sizes[NCHUNKS];
+    void        *bufs[NCHUNKS];
+    size_t      buf_size = CHUNK_NX*CHUNK_NY*sizeof(int);
+    size_t      nchunks;
+    int         pass;
+    int         i, j, k;
+    herr_t      status;
+
+    TESTING("batched direct chunk write with H5DOwrite_chunks");
+
+    HDmemset(bufs, 0, sizeof(bufs));
+
+    if((dataspace = H5Screate_simple(RANK, dims, maxdims)) < 0)
+        goto error;
+
+    if((cparms = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        goto error;
+    if(H5Pset_chunk(cparms, RANK, chunk_dims) < 0)
+        goto error;
+    if(H5Pset_deflate(cparms, 6) < 0)
+        goto error;
+
+    if((dataset = H5Dcreate2(file, DATASETNAME7, H5T_NATIVE_INT, dataspace, H5P_DEFAULT,
+			cparms, H5P_DEFAULT)) < 0)
+        goto error;
+
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0)
+        goto error;
+
+    /* Write all the chunks in one batch, then overwrite every other chunk
+     * with data that compresses to a different size, in reverse order */
+    for(pass = 0; pass < 2; pass++) {
+        nchunks = 0;
+        for(k = 0; k < NCHUNKS; k++) {
+            int c = (pass == 0) ? k : (NCHUNKS - 1 - k);
+
+            if(pass == 1 && (c % 2))
+                continue;
+
+            /* Initialize the chunk's data */
+            for(i = 0; i < CHUNK_NX; i++)
+                for(j = 0; j < CHUNK_NY; j++)
+                    chunk_data[c][i][j] = (pass == 0) ? (c * 1000) + i : (c * 7919) + (i * CHUNK_NY) + j;
+
+            offsets[nchunks][0] = (hsize_t)((c / (NY / CHUNK_NY)) * CHUNK_NX);
+            offsets[nchunks][1] = (hsize_t)((c % (NY / CHUNK_NY)) * CHUNK_NY);
+            offset_ptrs[nchunks] = offsets[nchunks];
+
+            /* Store the last chunk of the batch unfiltered, skipping deflate */
+            if(k == NCHUNKS - 1) {
+                if(NULL == (bufs[nchunks] = HDmalloc(buf_size)))
+                    goto error;
+                HDmemcpy(bufs[nchunks], chunk_data[c], buf_size);
+                data_sizes[nchunks] = buf_size;
+                filters[nchunks] = 0x1;
+            } /* end if */
+            else {
+                uLongf z_dst_nbytes = (uLongf)DEFLATE_SIZE_ADJUST(buf_size);
+
+                if(NULL == (bufs[nchunks] = HDmalloc(z_dst_nbytes)))
+                    goto error;
+                if(Z_OK != compress2((Bytef *)bufs[nchunks], &z_dst_nbytes, (const Bytef *)chunk_data[c], (uLong)buf_size, 6))
+                    goto error;
+                data_sizes[nchunks] = (size_t)z_dst_nbytes;
+                filters[nchunks] = 0;
+            } /* end else */
+            nchunks++;
+        } /* end for */
+
+        if((status = H5DOwrite_chunks(dataset, dxpl, nchunks, filters, offset_ptrs, data_sizes, (const void **)bufs)) < 0)
+            goto error;
+
+        for(k = 0; k < NCHUNKS; k++) {
+            if(bufs[k])
+                HDfree(bufs[k]);
+            bufs[k] = NULL;
+        } /* end for */
+
+        /* Reopen the dataset and read everything back */
+        if(H5Dclose(dataset) < 0)
+            goto error;
+        if((dataset = H5Dopen2(file, DATASETNAME7, H5P_DEFAULT)) < 0)
+            goto error;
+        if(H5Dread(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, check) < 0)
+            goto error;
+
+        for(i = 0; i < NX; i++)
+            for(j = 0; j < NY; j++) {
+                int c = ((i / CHUNK_NX) * (NY / CHUNK_NY)) + (j / CHUNK_NY);
+
+                if(check[i][j] != chunk_data[c][i % CHUNK_NX][j % CHUNK_NY]) {
+                    printf("    pass %d: read different values than written.", pass);
+                    printf("    At index %d,%d\n", i, j);
+                    goto error;
+                } /* end if */
+            } /* end for */
+    } /* end for */
+
+    /* A batch that writes the same chunk twice should fail */
+    offsets[0][0] = offsets[0][1] = 0;
+    offset_ptrs[0] = offset_ptrs[1] = offsets[0];
+    data_sizes[0] = data_sizes[1] = buf_size;
+    filters[0] = filters[1] = 0x1;
+    bufs[0] = bufs[1] = chunk_data[0];
+    H5E_BEGIN_TRY {
+        status = H5DOwrite_chunks(dataset, dxpl, (size_t)2, filters, offset_ptrs, data_sizes, (const void **)bufs);
+    } H5E_END_TRY;
+    bufs[0] = bufs[1] = NULL;
+    if(status >= 0)
+        goto error;
+
+    /* The DXPL should be usable for a single chunk write afterwards */
+    if(H5DOwrite_chunk(dataset, dxpl, 0x1, offsets[0], buf_size, chunk_data[0]) < 0)
+        goto error;
+
+    if(H5Dclose(dataset) < 0)
+        goto error;
+    if(H5Sclose(dataspace) < 0)
+        goto error;
+    if(H5Pclose(cparms) < 0)
+        goto error;
+    if(H5Pclose(dxpl) < 0)
+        goto error;
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dataset);
+        H5Sclose(dataspace);
+        H5Pclose(cparms);
+        H5Pclose(dxpl);
+    } H5E_END_TRY;
+
+    for(k = 0; k < NCHUNKS; k++)
+        if(bufs[k])
+            HDfree(bufs[k]);
+
+    return 1;
+}
+#endif /* H5_HAVE_FILTER_DEFLATE */
+
+/*-------------------------------------------------------------------------
+ * Function:	test_direct_chunk_read
+ *
+ * Purpose:	Test reading chunks as they are stored with H5DOread_chunk
+ *              and H5DOread_chunks, and querying them with
+ *              H5Dget_chunk_info_by_coord
+ *
+ * Return:	Success:	0
+ *
+ *		Failure:	1
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifdef H5_HAVE_FILTER_DEFLATE
+static int
+test_direct_chunk_read (hid_t file)
+{
+    hid_t       dataspace = -1, dataset = -1;
+    hid_t       mem_space = -1;
+    hid_t       cparms = -1, dxpl = -1;
+    hsize_t     dims[2]  = {NX, NY};
+    hsize_t     chunk_dims[2] ={CHUNK_NX, CHUNK_NY};
+    hsize_t     half_dims[2] = {NX / 2, NY};
+    hsize_t     start[2] = {0, 0};
+    int         data[NX / 2][NY];
+    int         check_chunk[CHUNK_NX][CHUNK_NY];
+    hsize_t     offsets[NCHUNKS][2];
+    const hsize_t *offset_ptrs[NCHUNKS];
+    uint32_t    filters[NCHUNKS];
+    size_t      data_sizes[NCHUNKS];
+    size_t      buf_size = CHUNK_NX*CHUNK_NY*sizeof(int);
+    size_t      arena_size = NCHUNKS * (size_t)DEFLATE_SIZE_ADJUST(buf_size);
+    unsigned char *arena = NULL;
+    unsigned char *pos;
+    unsigned    filter_mask;
+    uint32_t    read_filter_mask;
+    haddr_t     addr;
+    hsize_t     size;
+    int         i, j, k;
+    herr_t      status;
+
+    TESTING("direct chunk read with H5DOread_chunk and H5DOread_chunks");
+
+    if(NULL == (arena = (unsigned char *)HDmalloc(arena_size)))
+        goto error;
+
+    if((dataspace = H5Screate_simple(RANK, dims, NULL)) < 0)
+        goto error;
+    if((mem_space = H5Screate_simple(RANK, half_dims, NULL)) < 0)
+        goto error;
+
+    if((cparms = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        goto error;
+    if(H5Pset_chunk(cparms, RANK, chunk_dims) < 0)
+        goto error;
+    if(H5Pset_deflate(cparms, 6) < 0)
+        goto error;
+
+    if((dataset = H5Dcreate2(file, DATASETNAME8, H5T_NATIVE_INT, dataspace, H5P_DEFAULT,
+			cparms, H5P_DEFAULT)) < 0)
+        goto error;
+
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0)
+        goto error;
+
+    /* Write the first half of the dataset.  The chunks stay dirty in the
+     * chunk cache, so the direct reads have to write them out first. */
+    for(i = 0; i < NX / 2; i++)
+        for(j = 0; j < NY; j++)
+            data[i][j] = (i * NY) + j;
+    if(H5Sselect_hyperslab(dataspace, H5S_SELECT_SET, start, NULL, half_dims, NULL) < 0)
+        goto error;
+    if(H5Dwrite(dataset, H5T_NATIVE_INT, mem_space, dataspace, H5P_DEFAULT, data) < 0)
+        goto error;
+
+    /* Query and read one chunk */
+    offsets[0][0] = CHUNK_NX;
+    offsets[0][1] = CHUNK_NY;
+    if(H5Dget_chunk_info_by_coord(dataset, offsets[0], &filter_mask, &addr, &size) < 0)
+        goto error;
+    if(filter_mask != 0 || addr == HADDR_UNDEF || size == 0 || size > arena_size)
+        goto error;
+    if(H5DOread_chunk(dataset, dxpl, offsets[0], &read_filter_mask, arena) < 0)
+        goto error;
+    if(read_filter_mask != 0)
+        goto error;
+    {
+        uLongf check_nbytes = (uLongf)buf_size;
+
+        if(Z_OK != uncompress((Bytef *)check_chunk, &check_nbytes, (const Bytef *)arena, (uLong)size))
+            goto error;
+        if(check_nbytes != buf_size)
+            goto error;
+    }
+    for(i = 0; i < CHUNK_NX; i++)
+        for(j = 0; j < CHUNK_NY; j++)
+            if(check_chunk[i][j] != data[CHUNK_NX + i][CHUNK_NY + j]) {
+                printf("    1. Read different values than written.");
+                printf("    At index %d,%d\n", i, j);
+                goto error;
+            } /* end if */
+
+    /* Chunks in the second half haven't been written */
+    offsets[0][0] = NX - CHUNK_NX;
+    offsets[0][1] = 0;
+    if(H5Dget_chunk_info_by_coord(dataset, offsets[0], &filter_mask, &addr, &size) < 0)
+        goto error;
+    if(addr != HADDR_UNDEF || size != 0)
+        goto error;
+    H5E_BEGIN_TRY {
+        status = H5DOread_chunk(dataset, dxpl, offsets[0], &read_filter_mask, arena);
+    } H5E_END_TRY;
+    if(status >= 0)
+        goto error;
+
+    /* Replace one chunk with unfiltered data, skipping deflate */
+    offsets[0][0] = 0;
+    offsets[0][1] = NY - CHUNK_NY;
+    for(i = 0; i < CHUNK_NX; i++)
+        for(j = 0; j < CHUNK_NY; j++)
+            check_chunk[i][j] = data[i][(NY - CHUNK_NY) + j];
+    if(H5DOwrite_chunk(dataset, dxpl, 0x1, offsets[0], buf_size, check_chunk) < 0)
+        goto error;
+
+    /* Read all the chunks in one call, in reverse order */
+    for(k = 0; k < NCHUNKS; k++) {
+        int c = NCHUNKS - 1 - k;
+
+        offsets[k][0] = (hsize_t)((c / (NY / CHUNK_NY)) * CHUNK_NX);
+        offsets[k][1] = (hsize_t)((c % (NY / CHUNK_NY)) * CHUNK_NY);
+        offset_ptrs[k] = offsets[k];
+    } /* end for */
+
+    /* A buffer that's too small should be rejected */
+    H5E_BEGIN_TRY {
+        status = H5DOread_chunks(dataset, dxpl, (size_t)NCHUNKS, offset_ptrs, filters, data_sizes, arena, (size_t)16);
+    } H5E_END_TRY;
+    if(status >= 0)
+        goto error;
+
+    if(H5DOread_chunks(dataset, dxpl, (size_t)NCHUNKS, offset_ptrs, filters, data_sizes, arena, arena_size) < 0)
+        goto error;
+
+    pos = arena;
+    for(k = 0; k < NCHUNKS; k++) {
+        hsize_t x0 = offsets[k][0], y0 = offsets[k][1];
+
+        if(x0 >= NX / 2) {
+            if(data_sizes[k] != 0)
+                goto error;
+            continue;
+        } /* end if */
+
+        if(x0 == 0 && y0 == NY - CHUNK_NY) {
+            if(filters[k] != 0x1 || data_sizes[k] != buf_size)
+                goto error;
+            HDmemcpy(check_chunk, pos, buf_size);
+        } /* end if */
+        else {
+            uLongf check_nbytes = (uLongf)buf_size;
+
+            if(filters[k] != 0 || data_sizes[k] == 0)
+                goto error;
+            if(Z_OK != uncompress((Bytef *)check_chunk, &check_nbytes, (const Bytef *)pos, (uLong)data_sizes[k]))
+                goto error;
+        } /* end else */
+        pos += data_sizes[k];
+
+        for(i = 0; i < CHUNK_NX; i++)
+            for(j = 0; j < CHUNK_NY; j++)
+                if(check_chunk[i][j] != data[x0 + (hsize_t)i][y0 + (hsize_t)j]) {
+                    printf("    2. Read different values than written.");
+                    printf("    At index %d,%d\n", i, j);
+                    goto error;
+                } /* end if */
+    } /* end for */
+
+    /* The DXPL should be usable for a normal read afterwards */
+    if(H5Dread(dataset, H5T_NATIVE_INT, mem_space, dataspace, dxpl, data) < 0)
+        goto error;
+
+    if(H5Dclose(dataset) < 0)
+        goto error;
+    if(H5Sclose(mem_space) < 0)
+        goto error;
+    if(H5Sclose(dataspace) < 0)
+        goto error;
+    if(H5Pclose(cparms) < 0)
+        goto error;
+    if(H5Pclose(dxpl) < 0)
+        goto error;
+    HDfree(arena);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dataset);
+        H5Sclose(mem_space);
+        H5Sclose(dataspace);
+        H5Pclose(cparms);
+        H5Pclose(dxpl);
+    } H5E_END_TRY;
+
+    if(arena)
+        HDfree(arena);
+
+    return 1;
+}
+#endif /* H5_HAVE_FILTER_DEFLATE */
+
 /*-------------------------------------------------------------------------
  * Function:	test_skip_compress_write1
  *
@@ -1117,6 +1500,8 @@ int main( void )
     /* Test direct chunk write */
 #ifdef H5_HAVE_FILTER_DEFLATE
     nerrors += test_direct_chunk_write(file_id);
+    nerrors += test_direct_chunk_write_multi(file_id);
+    nerrors += test_direct_chunk_read(file_id);
 #endif /* H5_HAVE_FILTER_DEFLATE */
     nerrors += test_skip_compress_write1(file_id);
     nerrors += test_skip_compress_write2(file_id);
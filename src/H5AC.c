@@ -3176,3 +3176,34 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5AC_remove_entry() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5AC_flush_write_batch()
+ *
+ * Purpose:     Write out the entry images staged by a metadata cache
+ *		flush in progress, if any.  Called before file space is
+ *		freed, so that a staged image can't land in space that
+ *		has already been released.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5AC_flush_write_batch(H5F_t *f, hid_t dxpl_id)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity check */
+    HDassert(f);
+    HDassert(f->shared);
+
+    if(H5C_flush_write_batch(f, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "can't write staged entry images")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5AC_flush_write_batch() */
+
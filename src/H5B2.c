@@ -162,6 +162,7 @@ H5B2_create(H5F_t *f, hid_t dxpl_id, const H5B2_create_t *cparam, void *ctx_udat
     /* Create v2 B-tree wrapper */
     if(NULL == (bt2 = H5FL_MALLOC(H5B2_t)))
         HGOTO_ERROR(H5E_BTREE, H5E_CANTALLOC, NULL, "memory allocation failed for v2 B-tree info")
+    bt2->bulk = NULL;
 
     /* Look up the B-tree header */
     if(NULL == (hdr = H5B2__hdr_protect(f, dxpl_id, hdr_addr, ctx_udata, H5AC__NO_FLAGS_SET)))
@@ -231,6 +232,7 @@ H5B2_open(H5F_t *f, hid_t dxpl_id, haddr_t addr, void *ctx_udata)
     /* Create v2 B-tree info */
     if(NULL == (bt2 = H5FL_MALLOC(H5B2_t)))
         HGOTO_ERROR(H5E_BTREE, H5E_CANTALLOC, NULL, "memory allocation failed for v2 B-tree info")
+    bt2->bulk = NULL;
 
     /* Point v2 B-tree wrapper at header */
     bt2->hdr = hdr;
@@ -289,6 +291,13 @@ H5B2_insert(H5B2_t *bt2, hid_t dxpl_id, void *udata)
     /* Get the v2 B-tree header */
     hdr = bt2->hdr;
 
+    /* Add the record to a bulk load in progress */
+    if(bt2->bulk && bt2->bulk->nloaded < bt2->bulk->nrec) {
+        if(H5B2__bulk_insert(hdr, dxpl_id, bt2->bulk, udata) < 0)
+            HGOTO_ERROR(H5E_BTREE, H5E_CANTINSERT, FAIL, "unable to bulk load record into B-tree")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
     /* Insert the record */
     if(H5B2__insert(hdr, dxpl_id, udata) < 0)
         HGOTO_ERROR(H5E_BTREE, H5E_CANTINSERT, FAIL, "unable to insert record into B-tree")
@@ -297,6 +306,118 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5B2_insert() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5B2_bulk_begin
+ *
+ * Purpose:	Start loading NREC records into an empty B-tree.  The
+ *		records are then passed to H5B2_insert or H5B2_update in key
+ *		order, and the B-tree is built from the root down, with each
+ *		node filled as it's created, instead of splitting and
+ *		redistributing nodes.  H5B2_bulk_end finishes the load.
+ *
+ *		If the B-tree isn't empty, the records are inserted one at
+ *		a time as usual.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5B2_bulk_begin(H5B2_t *bt2, hid_t dxpl_id, hsize_t nrec)
+{
+    H5B2_hdr_t	*hdr;                   /* Pointer to the B-tree header */
+    H5B2_bulk_t *bulk = NULL;           /* Bulk load information */
+    herr_t	ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Check arguments. */
+    HDassert(bt2);
+    HDassert(NULL == bt2->bulk);
+
+    /* Set the shared v2 B-tree header's file context for this operation */
+    bt2->hdr->f = bt2->f;
+
+    /* Get the v2 B-tree header */
+    hdr = bt2->hdr;
+
+    /* Only load an empty B-tree */
+    if(0 == nrec || H5F_addr_defined(hdr->root.addr))
+        HGOTO_DONE(SUCCEED)
+    HDassert(0 == hdr->depth);
+
+    /* Forget any min & max records from before the B-tree was emptied */
+    hdr->min_native_rec = H5MM_xfree(hdr->min_native_rec);
+    hdr->max_native_rec = H5MM_xfree(hdr->max_native_rec);
+
+    /* Make the B-tree deep enough for the records */
+    while(hdr->node_info[hdr->depth].cum_max_nrec < nrec)
+        if(H5B2__add_depth(hdr) < 0)
+            HGOTO_ERROR(H5E_BTREE, H5E_CANTINIT, FAIL, "unable to increase depth of B-tree")
+
+    /* Allocate the bulk load information */
+    if(NULL == (bulk = (H5B2_bulk_t *)H5MM_calloc(sizeof(H5B2_bulk_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for B-tree bulk load")
+    bulk->nrec = nrec;
+    if(NULL == (bulk->level = (H5B2_bulk_level_t *)H5MM_calloc(sizeof(H5B2_bulk_level_t) * (size_t)(hdr->depth + 1))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for B-tree bulk load")
+    if(NULL == (bulk->prev = (uint8_t *)H5MM_malloc(hdr->cls->nrec_size)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for B-tree bulk load")
+
+    /* Create the root and the first node at each depth below it */
+    if(H5B2__bulk_open(hdr, dxpl_id, bulk, hdr->depth, hdr, &hdr->root, nrec) < 0)
+        HGOTO_ERROR(H5E_BTREE, H5E_CANTINIT, FAIL, "unable to create root node")
+
+    bt2->bulk = bulk;
+
+done:
+    if(ret_value < 0 && bulk)
+        if(H5B2__bulk_release(hdr, dxpl_id, bulk) < 0)
+            HDONE_ERROR(H5E_BTREE, H5E_CANTRELEASE, FAIL, "unable to release B-tree bulk load")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5B2_bulk_begin() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5B2_bulk_end
+ *
+ * Purpose:	Finish a bulk load started with H5B2_bulk_begin.  It's an
+ *		error if fewer records were loaded than were announced.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5B2_bulk_end(H5B2_t *bt2, hid_t dxpl_id)
+{
+    H5B2_bulk_t *bulk;                  /* Bulk load information */
+    herr_t	ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Check arguments. */
+    HDassert(bt2);
+
+    /* Check for a bulk load */
+    if(NULL == (bulk = bt2->bulk))
+        HGOTO_DONE(SUCCEED)
+    bt2->bulk = NULL;
+
+    /* Set the shared v2 B-tree header's file context for this operation */
+    bt2->hdr->f = bt2->f;
+
+    if(bulk->nloaded < bulk->nrec)
+        HDONE_ERROR(H5E_BTREE, H5E_CANTINSERT, FAIL, "fewer records loaded into B-tree than expected")
+    if(H5B2__bulk_release(bt2->hdr, dxpl_id, bulk) < 0)
+        HGOTO_ERROR(H5E_BTREE, H5E_CANTRELEASE, FAIL, "unable to release B-tree bulk load")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5B2_bulk_end() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5B2_update
@@ -333,6 +454,14 @@ H5B2_update(H5B2_t *bt2, hid_t dxpl_id, void *udata, H5B2_modify_t op, void *op_
     /* Get the v2 B-tree header */
     hdr = bt2->hdr;
 
+    /* Add the record to a bulk load in progress, where it can't match an
+     * existing record */
+    if(bt2->bulk && bt2->bulk->nloaded < bt2->bulk->nrec) {
+        if(H5B2__bulk_insert(hdr, dxpl_id, bt2->bulk, udata) < 0)
+            HGOTO_ERROR(H5E_BTREE, H5E_CANTINSERT, FAIL, "unable to bulk load record into B-tree")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
     /* Check if the root node is allocated yet */
     if(!H5F_addr_defined(hdr->root.addr)) {
         /* Create root node as leaf node in B-tree */
@@ -1408,6 +1537,14 @@ H5B2_close(H5B2_t *bt2, hid_t dxpl_id)
     HDassert(bt2);
     HDassert(bt2->f);
 
+    /* Release the nodes of an unfinished bulk load */
+    if(bt2->bulk) {
+        bt2->hdr->f = bt2->f;
+        if(H5B2__bulk_release(bt2->hdr, dxpl_id, bt2->bulk) < 0)
+            HDONE_ERROR(H5E_BTREE, H5E_CANTRELEASE, FAIL, "unable to release B-tree bulk load")
+        bt2->bulk = NULL;
+    } /* end if */
+
     /* Decrement file reference & check if this is the last open v2 B-tree using the shared B-tree header */
     if(0 == H5B2__hdr_fuse_decr(bt2->hdr)) {
         /* Set the shared v2 B-tree header's file context for this operation */
@@ -37,6 +37,7 @@
 #include "H5private.h"		/* Generic Functions			*/
 #include "H5B2pkg.h"		/* v2 B-trees				*/
 #include "H5Eprivate.h"		/* Error handling		  	*/
+#include "H5MMprivate.h"	/* Memory management			*/
 #include "H5VMprivate.h"	/* Vectors and arrays 			*/
 
 
@@ -348,8 +349,6 @@ H5B2__split_root(H5B2_hdr_t *hdr, hid_t dxpl_id)
     H5B2_internal_t *new_root = NULL;   /* Pointer to new root node */
     unsigned new_root_flags = H5AC__NO_FLAGS_SET;   /* Cache flags for new root node */
     H5B2_node_ptr_t old_root_ptr;       /* Old node pointer to root node in B-tree */
-    size_t sz_max_nrec;                 /* Temporary variable for range checking */
-    unsigned u_max_nrec_size;           /* Temporary variable for range checking */
     herr_t ret_value = SUCCEED;         /* Return value */
 
     FUNC_ENTER_PACKAGE
@@ -358,25 +357,8 @@ H5B2__split_root(H5B2_hdr_t *hdr, hid_t dxpl_id)
     HDassert(hdr);
 
     /* Update depth of B-tree */
-    hdr->depth++;
-
-    /* Re-allocate array of node info structs */
-    if(NULL == (hdr->node_info = H5FL_SEQ_REALLOC(H5B2_node_info_t, hdr->node_info, (size_t)(hdr->depth + 1))))
-        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
-
-    /* Update node info for new depth of tree */
-    sz_max_nrec = H5B2_NUM_INT_REC(hdr, hdr->depth);
-    H5_CHECKED_ASSIGN(hdr->node_info[hdr->depth].max_nrec, unsigned, sz_max_nrec, size_t)
-    hdr->node_info[hdr->depth].split_nrec = (hdr->node_info[hdr->depth].max_nrec * hdr->split_percent) / 100;
-    hdr->node_info[hdr->depth].merge_nrec = (hdr->node_info[hdr->depth].max_nrec * hdr->merge_percent) / 100;
-    hdr->node_info[hdr->depth].cum_max_nrec = ((hdr->node_info[hdr->depth].max_nrec + 1) *
-        hdr->node_info[hdr->depth - 1].cum_max_nrec) + hdr->node_info[hdr->depth].max_nrec;
-    u_max_nrec_size = H5VM_limit_enc_size((uint64_t)hdr->node_info[hdr->depth].cum_max_nrec);
-    H5_CHECKED_ASSIGN(hdr->node_info[hdr->depth].cum_max_nrec_size, uint8_t, u_max_nrec_size, unsigned)
-    if(NULL == (hdr->node_info[hdr->depth].nat_rec_fac = H5FL_fac_init(hdr->cls->nrec_size * hdr->node_info[hdr->depth].max_nrec)))
-	HGOTO_ERROR(H5E_RESOURCE, H5E_CANTINIT, FAIL, "can't create node native key block factory")
-    if(NULL == (hdr->node_info[hdr->depth].node_ptr_fac = H5FL_fac_init(sizeof(H5B2_node_ptr_t) * (hdr->node_info[hdr->depth].max_nrec + 1))))
-	HGOTO_ERROR(H5E_RESOURCE, H5E_CANTINIT, FAIL, "can't create internal 'branch' node node pointer block factory")
+    if(H5B2__add_depth(hdr) < 0)
+        HGOTO_ERROR(H5E_BTREE, H5E_CANTINIT, FAIL, "unable to increase depth of B-tree")
 
     /* Keep old root node pointer info */
     old_root_ptr = hdr->root;
@@ -405,6 +387,55 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5B2__split_root() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5B2__add_depth
+ *
+ * Purpose:	Increase the depth of the B-tree by one, setting up the node
+ *		info for the new depth.  The caller creates the new root.
+ *
+ * Return:	Success:	Non-negative
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5B2__add_depth(H5B2_hdr_t *hdr)
+{
+    size_t sz_max_nrec;                 /* Temporary variable for range checking */
+    unsigned u_max_nrec_size;           /* Temporary variable for range checking */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check arguments. */
+    HDassert(hdr);
+
+    /* Update depth of B-tree */
+    hdr->depth++;
+
+    /* Re-allocate array of node info structs */
+    if(NULL == (hdr->node_info = H5FL_SEQ_REALLOC(H5B2_node_info_t, hdr->node_info, (size_t)(hdr->depth + 1))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+
+    /* Update node info for new depth of tree */
+    sz_max_nrec = H5B2_NUM_INT_REC(hdr, hdr->depth);
+    H5_CHECKED_ASSIGN(hdr->node_info[hdr->depth].max_nrec, unsigned, sz_max_nrec, size_t)
+    hdr->node_info[hdr->depth].split_nrec = (hdr->node_info[hdr->depth].max_nrec * hdr->split_percent) / 100;
+    hdr->node_info[hdr->depth].merge_nrec = (hdr->node_info[hdr->depth].max_nrec * hdr->merge_percent) / 100;
+    hdr->node_info[hdr->depth].cum_max_nrec = ((hdr->node_info[hdr->depth].max_nrec + 1) *
+        hdr->node_info[hdr->depth - 1].cum_max_nrec) + hdr->node_info[hdr->depth].max_nrec;
+    u_max_nrec_size = H5VM_limit_enc_size((uint64_t)hdr->node_info[hdr->depth].cum_max_nrec);
+    H5_CHECKED_ASSIGN(hdr->node_info[hdr->depth].cum_max_nrec_size, uint8_t, u_max_nrec_size, unsigned)
+    if(NULL == (hdr->node_info[hdr->depth].nat_rec_fac = H5FL_fac_init(hdr->cls->nrec_size * hdr->node_info[hdr->depth].max_nrec)))
+	HGOTO_ERROR(H5E_RESOURCE, H5E_CANTINIT, FAIL, "can't create node native key block factory")
+    if(NULL == (hdr->node_info[hdr->depth].node_ptr_fac = H5FL_fac_init(sizeof(H5B2_node_ptr_t) * (hdr->node_info[hdr->depth].max_nrec + 1))))
+	HGOTO_ERROR(H5E_RESOURCE, H5E_CANTINIT, FAIL, "can't create internal 'branch' node node pointer block factory")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5B2__add_depth() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5B2__redistribute2
@@ -1485,6 +1516,267 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5B2__insert() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5B2__bulk_open
+ *
+ * Purpose:	Create the node at DEPTH that will hold ALL_NREC records in
+ *		its subtree, and the first child below it at each depth down
+ *		to a leaf, and protect them for a bulk load.
+ *
+ *		An internal node gets as few children as can hold its
+ *		records, with the records spread evenly between them, so
+ *		every node below the root is at least half full.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5B2__bulk_open(H5B2_hdr_t *hdr, hid_t dxpl_id, H5B2_bulk_t *bulk,
+    uint16_t depth, void *parent, H5B2_node_ptr_t *node_ptr, hsize_t all_nrec)
+{
+    herr_t	ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check arguments. */
+    HDassert(hdr);
+    HDassert(bulk);
+    HDassert(node_ptr);
+    HDassert(all_nrec > 0);
+    HDassert(all_nrec <= hdr->node_info[depth].cum_max_nrec);
+
+    while(1) {
+        H5B2_bulk_level_t *level = &bulk->level[depth];    /* Node being opened */
+
+        HDassert(NULL == level->node);
+
+        node_ptr->node_nrec = 0;
+        node_ptr->all_nrec = 0;
+        level->node_ptr = node_ptr;
+        level->all_nrec = all_nrec;
+        level->curr = 0;
+
+        if(depth > 0) {
+            H5B2_internal_t *internal;      /* New internal node */
+            hsize_t child_max = hdr->node_info[depth - 1].cum_max_nrec + 1;  /* Max. records in a child, plus its separator */
+            hsize_t nchildren;              /* Number of children */
+
+            /* Create and protect the internal node */
+            if(H5B2__create_internal(hdr, dxpl_id, parent, node_ptr, depth) < 0)
+                HGOTO_ERROR(H5E_BTREE, H5E_CANTINIT, FAIL, "unable to create B-tree internal node")
+            if(NULL == (internal = H5B2__protect_internal(hdr, dxpl_id, parent, node_ptr, depth, FALSE, H5AC__NO_FLAGS_SET)))
+                HGOTO_ERROR(H5E_BTREE, H5E_CANTPROTECT, FAIL, "unable to protect B-tree internal node")
+            level->node = internal;
+
+            /* Spread the records between as few children as hold them */
+            nchildren = (all_nrec + child_max) / child_max;
+            HDassert(nchildren <= (hsize_t)hdr->node_info[depth].max_nrec + 1);
+            level->nrec = (uint16_t)(nchildren - 1);
+            level->child_nrec = (all_nrec - level->nrec) / nchildren;
+            level->child_rem = (uint16_t)((all_nrec - level->nrec) % nchildren);
+
+            /* Open the first child */
+            parent = internal;
+            node_ptr = &internal->node_ptrs[0];
+            all_nrec = level->child_nrec + (level->child_rem > 0 ? 1 : 0);
+            depth--;
+        } /* end if */
+        else {
+            /* Create and protect the leaf node */
+            if(H5B2__create_leaf(hdr, dxpl_id, parent, node_ptr) < 0)
+                HGOTO_ERROR(H5E_BTREE, H5E_CANTINIT, FAIL, "unable to create B-tree leaf node")
+            if(NULL == (level->node = H5B2__protect_leaf(hdr, dxpl_id, parent, node_ptr, FALSE, H5AC__NO_FLAGS_SET)))
+                HGOTO_ERROR(H5E_BTREE, H5E_CANTPROTECT, FAIL, "unable to protect B-tree leaf node")
+            HDassert(all_nrec <= hdr->node_info[0].max_nrec);
+            level->nrec = (uint16_t)all_nrec;
+            break;
+        } /* end else */
+    } /* end while */
+
+    /* Records go into the new leaf next */
+    bulk->lowest = 0;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5B2__bulk_open() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5B2__bulk_close_node
+ *
+ * Purpose:	Set the record counts of a node filled by a bulk load and
+ *		release it to the metadata cache.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5B2__bulk_close_node(H5B2_hdr_t *hdr, hid_t dxpl_id, H5B2_bulk_t *bulk,
+    unsigned depth)
+{
+    H5B2_bulk_level_t *level = &bulk->level[depth];    /* Node to close */
+    herr_t	ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(level->node);
+
+    level->node_ptr->node_nrec = level->curr;
+    if(depth > 0) {
+        H5B2_internal_t *internal = (H5B2_internal_t *)level->node;
+
+        internal->nrec = level->curr;
+        level->node_ptr->all_nrec = level->all_nrec;
+        if(H5AC_unprotect(hdr->f, dxpl_id, H5AC_BT2_INT, level->node_ptr->addr, internal, H5AC__DIRTIED_FLAG) < 0)
+            HGOTO_ERROR(H5E_BTREE, H5E_CANTUNPROTECT, FAIL, "unable to release B-tree internal node")
+    } /* end if */
+    else {
+        H5B2_leaf_t *leaf = (H5B2_leaf_t *)level->node;
+
+        leaf->nrec = level->curr;
+        level->node_ptr->all_nrec = level->curr;
+        if(H5AC_unprotect(hdr->f, dxpl_id, H5AC_BT2_LEAF, level->node_ptr->addr, leaf, H5AC__DIRTIED_FLAG) < 0)
+            HGOTO_ERROR(H5E_BTREE, H5E_CANTUNPROTECT, FAIL, "unable to release B-tree leaf node")
+    } /* end else */
+
+done:
+    level->node = NULL;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5B2__bulk_close_node() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5B2__bulk_insert
+ *
+ * Purpose:	Add the next record of a bulk load: into the leaf being
+ *		filled, or as the separator before the next child of the
+ *		lowest internal node being filled, opening that child.
+ *		Nodes are released as they fill, so each node is written to
+ *		the file once, when the metadata cache flushes it.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5B2__bulk_insert(H5B2_hdr_t *hdr, hid_t dxpl_id, H5B2_bulk_t *bulk,
+    void *udata)
+{
+    H5B2_bulk_level_t *level;           /* Lowest node being filled */
+    uint8_t     *native;                /* Native form of record */
+    herr_t	ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check arguments. */
+    HDassert(hdr);
+    HDassert(bulk);
+    HDassert(bulk->nloaded < bulk->nrec);
+    HDassert(bulk->lowest <= hdr->depth);
+
+    /* Records must come in key order */
+    if(bulk->nloaded > 0) {
+        int cmp;                        /* Comparison value of records */
+
+        if((hdr->cls->compare)(udata, bulk->prev, &cmp) < 0)
+            HGOTO_ERROR(H5E_BTREE, H5E_CANTCOMPARE, FAIL, "can't compare btree2 records")
+        if(cmp <= 0)
+            HGOTO_ERROR(H5E_BTREE, H5E_BADVALUE, FAIL, "records not in key order")
+    } /* end if */
+
+    level = &bulk->level[bulk->lowest];
+    if(bulk->lowest > 0) {
+        H5B2_internal_t *internal = (H5B2_internal_t *)level->node;
+        hsize_t child_nrec;             /* Number of records in next child */
+
+        /* Store the separator before the next child */
+        native = H5B2_INT_NREC(internal, hdr, level->curr);
+        if((hdr->cls->store)(native, udata) < 0)
+            HGOTO_ERROR(H5E_BTREE, H5E_CANTINSERT, FAIL, "unable to store record")
+        level->curr++;
+
+        /* Open the next child, down to a leaf */
+        child_nrec = level->child_nrec + (level->curr < level->child_rem ? 1 : 0);
+        if(H5B2__bulk_open(hdr, dxpl_id, bulk, (uint16_t)(bulk->lowest - 1), internal, &internal->node_ptrs[level->curr], child_nrec) < 0)
+            HGOTO_ERROR(H5E_BTREE, H5E_CANTINIT, FAIL, "unable to create B-tree nodes")
+    } /* end if */
+    else {
+        /* Store the record in the leaf */
+        native = H5B2_LEAF_NREC((H5B2_leaf_t *)level->node, hdr, level->curr);
+        if((hdr->cls->store)(native, udata) < 0)
+            HGOTO_ERROR(H5E_BTREE, H5E_CANTINSERT, FAIL, "unable to store record")
+        level->curr++;
+
+        /* Close the leaf once it's full, and the nodes above it whose last
+         * child it is */
+        if(level->curr == level->nrec) {
+            unsigned depth = 0;         /* Depth of node to close */
+
+            do {
+                if(H5B2__bulk_close_node(hdr, dxpl_id, bulk, depth) < 0)
+                    HGOTO_ERROR(H5E_BTREE, H5E_CANTUNPROTECT, FAIL, "unable to release B-tree node")
+                depth++;
+            } while(depth <= hdr->depth && bulk->level[depth].curr == bulk->level[depth].nrec);
+            bulk->lowest = depth;
+        } /* end if */
+    } /* end else */
+
+    /* Keep the record for checking the order of the next one */
+    HDmemcpy(bulk->prev, native, hdr->cls->nrec_size);
+    bulk->nloaded++;
+
+    /* Mark B-tree header as dirty, once the root has its record counts */
+    if(bulk->nloaded == bulk->nrec) {
+        HDassert(bulk->lowest > hdr->depth);
+        if(H5B2__hdr_dirty(hdr) < 0)
+            HGOTO_ERROR(H5E_BTREE, H5E_CANTMARKDIRTY, FAIL, "unable to mark B-tree header dirty")
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5B2__bulk_insert() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5B2__bulk_release
+ *
+ * Purpose:	Release the nodes still being filled by an unfinished bulk
+ *		load and free the bulk load information.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5B2__bulk_release(H5B2_hdr_t *hdr, hid_t dxpl_id, H5B2_bulk_t *bulk)
+{
+    unsigned    u;                      /* Local index variable */
+    herr_t	ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check arguments. */
+    HDassert(hdr);
+    HDassert(bulk);
+
+    /* Release the nodes from the bottom up, keeping the records stored */
+    if(bulk->level)
+        for(u = 0; u <= hdr->depth; u++)
+            if(bulk->level[u].node && H5B2__bulk_close_node(hdr, dxpl_id, bulk, u) < 0)
+                HDONE_ERROR(H5E_BTREE, H5E_CANTUNPROTECT, FAIL, "unable to release B-tree node")
+
+    /* Free the bulk load information */
+    H5MM_xfree(bulk->level);
+    H5MM_xfree(bulk->prev);
+    H5MM_xfree(bulk);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5B2__bulk_release() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5B2__iterate_node
@@ -247,10 +247,31 @@ typedef struct H5B2_internal_t {
     uint64_t    shadow_epoch;   /* Epoch of node, for making shadow copies */
 } H5B2_internal_t;
 
+/* Node being filled at one depth of a bulk load (see H5B2_bulk_begin) */
+typedef struct H5B2_bulk_level_t {
+    void        *node;          /* Node being filled (protected), or NULL */
+    H5B2_node_ptr_t *node_ptr;  /* Node pointer to node, in parent or header */
+    hsize_t     all_nrec;       /* Number of records in node and all it's children */
+    uint16_t    nrec;           /* Number of records in node */
+    uint16_t    curr;           /* Number of records stored in node so far */
+    hsize_t     child_nrec;     /* Number of records in each child, before spreading the remainder */
+    uint16_t    child_rem;      /* Number of children with one record more */
+} H5B2_bulk_level_t;
+
+/* Bulk load of an empty B-tree from records in key order */
+typedef struct H5B2_bulk_t {
+    hsize_t     nrec;           /* Number of records to load */
+    hsize_t     nloaded;        /* Number of records loaded so far */
+    unsigned    lowest;         /* Lowest depth with a node being filled */
+    uint8_t     *prev;          /* Native form of last record loaded */
+    H5B2_bulk_level_t *level;   /* Nodes being filled, indexed by depth */
+} H5B2_bulk_t;
+
 /* v2 B-tree */
 struct H5B2_t {
     H5B2_hdr_t  *hdr;           /* Pointer to internal v2 B-tree header info */
     H5F_t      *f;              /* Pointer to file for v2 B-tree */
+    H5B2_bulk_t *bulk;          /* Bulk load in progress, or NULL */
 };
 
 /* Node position, for min/max determination */
@@ -388,6 +409,7 @@ H5_DLL H5B2_internal_t *H5B2__protect_internal(H5B2_hdr_t *hdr, hid_t dxpl_id,
 
 /* Routines for allocating nodes */
 H5_DLL herr_t H5B2__split_root(H5B2_hdr_t *hdr, hid_t dxpl_id);
+H5_DLL herr_t H5B2__add_depth(H5B2_hdr_t *hdr);
 H5_DLL herr_t H5B2__create_leaf(H5B2_hdr_t *hdr, hid_t dxpl_id, void *parent,
     H5B2_node_ptr_t *node_ptr);
 H5_DLL herr_t H5B2__create_internal(H5B2_hdr_t *hdr, hid_t dxpl_id, void *parent,
@@ -400,6 +422,12 @@ H5_DLL herr_t H5B2__internal_free(H5B2_internal_t *i);
 
 /* Routines for inserting records */
 H5_DLL herr_t H5B2__insert(H5B2_hdr_t *hdr, hid_t dxpl_id, void *udata);
+H5_DLL herr_t H5B2__bulk_open(H5B2_hdr_t *hdr, hid_t dxpl_id, H5B2_bulk_t *bulk,
+    uint16_t depth, void *parent, H5B2_node_ptr_t *node_ptr, hsize_t all_nrec);
+H5_DLL herr_t H5B2__bulk_insert(H5B2_hdr_t *hdr, hid_t dxpl_id,
+    H5B2_bulk_t *bulk, void *udata);
+H5_DLL herr_t H5B2__bulk_release(H5B2_hdr_t *hdr, hid_t dxpl_id,
+    H5B2_bulk_t *bulk);
 H5_DLL herr_t H5B2__insert_internal(H5B2_hdr_t *hdr, hid_t dxpl_id,
     uint16_t depth, unsigned *parent_cache_info_flags_ptr,
     H5B2_node_ptr_t *curr_node_ptr, H5B2_nodepos_t curr_pos, void *parent, void *udata);
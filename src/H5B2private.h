@@ -132,6 +132,8 @@ H5_DLL H5B2_t *H5B2_create(H5F_t *f, hid_t dxpl_id, const H5B2_create_t *cparam,
 H5_DLL H5B2_t *H5B2_open(H5F_t *f, hid_t dxpl_id, haddr_t addr, void *ctx_udata);
 H5_DLL herr_t H5B2_get_addr(const H5B2_t *bt2, haddr_t *addr/*out*/);
 H5_DLL herr_t H5B2_insert(H5B2_t *bt2, hid_t dxpl_id, void *udata);
+H5_DLL herr_t H5B2_bulk_begin(H5B2_t *bt2, hid_t dxpl_id, hsize_t nrec);
+H5_DLL herr_t H5B2_bulk_end(H5B2_t *bt2, hid_t dxpl_id);
 H5_DLL herr_t H5B2_iterate(H5B2_t *bt2, hid_t dxpl_id, H5B2_operator_t op,
     void *op_data);
 H5_DLL htri_t H5B2_find(H5B2_t *bt2, hid_t dxpl_id, void *udata,
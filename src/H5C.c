@@ -155,6 +155,9 @@ static void * H5C_load_entry(H5F_t *             f,
                              haddr_t             addr,
                              void *              udata);
 
+static herr_t H5C__write_batch_add(H5F_t *f, hid_t dxpl_id,
+    const H5C_cache_entry_t *entry_ptr, H5FD_mem_t mem_type);
+
 static herr_t H5C__mark_flush_dep_dirty(H5C_cache_entry_t * entry);
 
 static herr_t H5C__mark_flush_dep_clean(H5C_cache_entry_t * entry);
@@ -163,8 +166,8 @@ static herr_t H5C__verify_len_eoa(H5F_t *f, const H5C_class_t * type,
     haddr_t addr, size_t *len, hbool_t actual);
 
 #if H5C_DO_SLIST_SANITY_CHECKS
-static hbool_t H5C_entry_in_skip_list(H5C_t * cache_ptr, 
-                                      H5C_cache_entry_t *target_ptr);
+static hbool_t H5C_entry_in_slist(H5C_t * cache_ptr, 
+                                  H5C_cache_entry_t *target_ptr);
 #endif /* H5C_DO_SLIST_SANITY_CHECKS */
 
 #if H5C_DO_EXTREME_SANITY_CHECKS
@@ -263,8 +266,8 @@ H5C_create(size_t		      max_cache_size,
     if(NULL == (cache_ptr = H5FL_CALLOC(H5C_t)))
 	HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed")
 
-    if(NULL == (cache_ptr->slist_ptr = H5SL_create(H5SL_TYPE_HADDR, NULL)))
-        HGOTO_ERROR(H5E_CACHE, H5E_CANTCREATE, NULL, "can't create skip list.")
+    if(NULL == (cache_ptr->index = (H5C_cache_entry_t **)H5MM_calloc((size_t)H5C__HASH_TABLE_MIN_LEN * sizeof(H5C_cache_entry_t *))))
+	HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for cache index")
 
     if(NULL == (cache_ptr->tag_list = H5SL_create(H5SL_TYPE_HADDR, NULL)))
         HGOTO_ERROR(H5E_CACHE, H5E_CANTCREATE, NULL, "can't create skip list for tagged entry addresses.")
@@ -317,8 +320,9 @@ H5C_create(size_t		      max_cache_size,
 	cache_ptr->slist_ring_size[i]		= (size_t)0;
     } /* end for */
 
-    for(i = 0; i < H5C__HASH_TABLE_LEN; i++)
-        (cache_ptr->index)[i] = NULL;
+    /* The index array was zeroed when it was allocated */
+    cache_ptr->index_nbuckets			= H5C__HASH_TABLE_MIN_LEN;
+    cache_ptr->index_nbits			= H5C__HASH_TABLE_MIN_BITS;
 
     cache_ptr->il_len				= 0;
     cache_ptr->il_size				= (size_t)0;
@@ -331,6 +335,9 @@ H5C_create(size_t		      max_cache_size,
     cache_ptr->slist_changed			= FALSE;
     cache_ptr->slist_len			= 0;
     cache_ptr->slist_size			= (size_t)0;
+    cache_ptr->slist_head			= NULL;
+    cache_ptr->slist_tail			= NULL;
+    cache_ptr->slist_sorted			= TRUE;
 
 #if H5C_DO_SANITY_CHECKS
     cache_ptr->slist_len_increase		= 0;
@@ -461,6 +468,15 @@ H5C_create(size_t		      max_cache_size,
     cache_ptr->rdfsm_settled		= FALSE;
     cache_ptr->mdfsm_settled		= FALSE;
 
+    /* initialize write batch related fields: */
+    cache_ptr->write_batch_enabled	= FALSE;
+    cache_ptr->write_batch_type		= H5FD_MEM_DEFAULT;
+    cache_ptr->write_batch_addr		= HADDR_UNDEF;
+    cache_ptr->write_batch_len		= 0;
+    cache_ptr->write_batch_buf		= NULL;
+    cache_ptr->write_batch_writes	= 0;
+    cache_ptr->write_batch_entries	= 0;
+
     if ( H5C_reset_cache_hit_rate_stats(cache_ptr) != SUCCEED ) {
 
         /* this should be impossible... */
@@ -482,12 +498,12 @@ H5C_create(size_t		      max_cache_size,
 done:
     if(NULL == ret_value) {
         if(cache_ptr != NULL) {
-            if(cache_ptr->slist_ptr != NULL)
-                H5SL_close(cache_ptr->slist_ptr);
-
             if(cache_ptr->tag_list != NULL)
                 H5SL_close(cache_ptr->tag_list);
 
+            if(cache_ptr->index != NULL)
+                cache_ptr->index = (H5C_cache_entry_t **)H5MM_xfree(cache_ptr->index);
+
             cache_ptr->magic = 0;
             cache_ptr = H5FL_FREE(H5C_t, cache_ptr);
         } /* end if */
@@ -824,16 +840,17 @@ H5C_dest(H5F_t * f, hid_t dxpl_id)
         if(H5C__generate_cache_image(f, dxpl_id, cache_ptr) < 0)
             HGOTO_ERROR(H5E_CACHE, H5E_CANTCREATE, FAIL, "Can't generate metadata cache image")
 
-    if(cache_ptr->slist_ptr != NULL) {
-        H5SL_close(cache_ptr->slist_ptr);
-        cache_ptr->slist_ptr = NULL;
-    } /* end if */
-
     if(cache_ptr->tag_list != NULL) {
         H5SL_destroy(cache_ptr->tag_list, H5C_free_tag_list_cb, NULL);
         cache_ptr->tag_list = NULL;
     } /* end if */
 
+    HDassert(cache_ptr->write_batch_len == 0);
+    cache_ptr->write_batch_buf = (uint8_t *)H5MM_xfree(cache_ptr->write_batch_buf);
+
+    HDassert(cache_ptr->index_len == 0);
+    cache_ptr->index = (H5C_cache_entry_t **)H5MM_xfree(cache_ptr->index);
+
 #ifndef NDEBUG
 #if H5C_DO_SANITY_CHECKS
     if(cache_ptr->get_entry_ptr_from_addr_counter > 0)
@@ -1037,7 +1054,6 @@ H5C_flush_cache(H5F_t *f, hid_t dxpl_id, unsigned flags)
     cache_ptr = f->shared->cache;
     HDassert(cache_ptr);
     HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
-    HDassert(cache_ptr->slist_ptr);
 
 #if H5C_DO_SANITY_CHECKS
     HDassert(cache_ptr->index_ring_len[H5C_RING_UNDEFINED] == 0);
@@ -1486,6 +1502,9 @@ H5C_insert_entry(H5F_t *             f,
     entry_ptr->il_next = NULL;
     entry_ptr->il_prev = NULL;
 
+    entry_ptr->slist_next = NULL;
+    entry_ptr->slist_prev = NULL;
+
     entry_ptr->next = NULL;
     entry_ptr->prev = NULL;
 
@@ -2022,7 +2041,6 @@ H5C_move_entry(H5C_t *	     cache_ptr,
         H5C__DELETE_FROM_INDEX(cache_ptr, entry_ptr, FAIL)
 
         if(entry_ptr->in_slist) {
-            HDassert(cache_ptr->slist_ptr);
             H5C__REMOVE_ENTRY_FROM_SLIST(cache_ptr, entry_ptr, FALSE)
         } /* end if */
     } /* end if */
@@ -5387,7 +5405,6 @@ H5C_flush_invalidate_cache(H5F_t *f, hid_t dxpl_id, unsigned flags)
     cache_ptr = f->shared->cache;
     HDassert(cache_ptr);
     HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
-    HDassert(cache_ptr->slist_ptr);
 
 #if H5C_DO_SANITY_CHECKS
 {
@@ -5524,13 +5541,13 @@ H5C_flush_invalidate_ring(H5F_t * f, hid_t dxpl_id, H5C_ring_t ring,
 {
     H5C_t              *cache_ptr;
     hbool_t             restart_slist_scan;
+    hbool_t             opened_write_batch = FALSE;
     uint32_t            protected_entries = 0;
     int32_t             i;
     int32_t             cur_ring_pel_len;
     int32_t             old_ring_pel_len;
     unsigned            cooked_flags;
     unsigned            evict_flags;
-    H5SL_node_t        *node_ptr = NULL;
     H5C_cache_entry_t  *entry_ptr = NULL;
     H5C_cache_entry_t  *next_entry_ptr = NULL;
 #if H5C_DO_SANITY_CHECKS
@@ -5546,7 +5563,6 @@ H5C_flush_invalidate_ring(H5F_t * f, hid_t dxpl_id, H5C_ring_t ring,
     cache_ptr = f->shared->cache;
     HDassert(cache_ptr);
     HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
-    HDassert(cache_ptr->slist_ptr);
     HDassert(ring > H5C_RING_UNDEFINED);
     HDassert(ring < H5C_RING_NTYPES);
 
@@ -5557,6 +5573,14 @@ H5C_flush_invalidate_ring(H5F_t * f, hid_t dxpl_id, H5C_ring_t ring,
     cooked_flags = flags & H5C__FLUSH_CLEAR_ONLY_FLAG;
     evict_flags = flags & H5C__EVICT_ALLOW_LAST_PINS_FLAG;
 
+    /* Stage the images of the entries written by this flush, as in
+     * H5C_flush_ring().
+     */
+    if(!cache_ptr->write_batch_enabled && NULL == cache_ptr->aux_ptr) {
+        cache_ptr->write_batch_enabled = TRUE;
+        opened_write_batch = TRUE;
+    } /* end if */
+
     /* The flush proceedure here is a bit strange.
      *
      * In the outer while loop we make at least one pass through the
@@ -5642,21 +5666,18 @@ H5C_flush_invalidate_ring(H5F_t * f, hid_t dxpl_id, H5C_ring_t ring,
 
         /* this done, start the scan of the slist */
         restart_slist_scan = TRUE;
-        while(restart_slist_scan || (node_ptr != NULL)) {
+        while(restart_slist_scan || (next_entry_ptr != NULL)) {
             if(restart_slist_scan) {
                 restart_slist_scan = FALSE;
 
-                /* Start at beginning of skip list */
-                node_ptr = H5SL_first(cache_ptr->slist_ptr);
-                if(node_ptr == NULL)
+                /* Start at beginning of the slist, sorting it into
+                 * increasing address order if necessary.
+                 */
+                next_entry_ptr = H5C__slist_first(cache_ptr);
+                if(next_entry_ptr == NULL)
                     /* the slist is empty -- break out of inner loop */
                     break;
 
-                /* Get cache entry for this node */
-                next_entry_ptr = (H5C_cache_entry_t *)H5SL_item(node_ptr);
-                if(NULL == next_entry_ptr)
-                    HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "next_entry_ptr == NULL ?!?!")
-
                 HDassert(next_entry_ptr->magic == H5C__H5C_CACHE_ENTRY_T_MAGIC);
                 HDassert(next_entry_ptr->is_dirty);
                 HDassert(next_entry_ptr->in_slist);
@@ -5682,22 +5703,17 @@ H5C_flush_invalidate_ring(H5F_t * f, hid_t dxpl_id, H5C_ring_t ring,
             HDassert(entry_ptr->is_dirty);
             HDassert(entry_ptr->ring >= ring);
 
-            /* increment node pointer now, before we delete its target
-             * from the slist.
+            /* advance to the next entry now, before we delete the
+             * current entry from the slist.
              */
-            node_ptr = H5SL_next(node_ptr);
-            if(node_ptr != NULL) {
-                next_entry_ptr = (H5C_cache_entry_t *)H5SL_item(node_ptr);
-                if(NULL == next_entry_ptr)
-                    HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "next_entry_ptr == NULL ?!?!")
+            next_entry_ptr = entry_ptr->slist_next;
+            if(next_entry_ptr != NULL) {
                 HDassert(next_entry_ptr->magic == H5C__H5C_CACHE_ENTRY_T_MAGIC);
                 HDassert(next_entry_ptr->is_dirty);
                 HDassert(next_entry_ptr->in_slist);
                 HDassert(next_entry_ptr->ring >= ring);
                 HDassert(entry_ptr != next_entry_ptr);
             } /* end if */
-            else
-                next_entry_ptr = NULL;
 
             /* Note that we now remove nodes from the slist as we flush
              * the associated entries, instead of leaving them there
@@ -5761,12 +5777,12 @@ H5C_flush_invalidate_ring(H5F_t * f, hid_t dxpl_id, H5C_ring_t ring,
          * the scan, either before or after scan pointer.  The following
          * asserts take this into account.
          *
-         * Don't bother with the sanity checks if node_ptr != NULL, as
+         * Don't bother with the sanity checks if next_entry_ptr != NULL, as
          * in this case we broke out of the loop because it got changed
          * out from under us.
          */
 
-        if(node_ptr == NULL) {
+        if(next_entry_ptr == NULL) {
             HDassert(cache_ptr->slist_len == (initial_slist_len + cache_ptr->slist_len_increase));
             HDassert((int64_t)cache_ptr->slist_size == ((int64_t)initial_slist_size + cache_ptr->slist_size_increase));
         } /* end if */
@@ -5928,6 +5944,13 @@ H5C_flush_invalidate_ring(H5F_t * f, hid_t dxpl_id, H5C_ring_t ring,
         HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "Can't unpin all pinned entries in ring.")
 
 done:
+    /* Write out the images still staged */
+    if(opened_write_batch) {
+        cache_ptr->write_batch_enabled = FALSE;
+        if(H5C_flush_write_batch(f, dxpl_id) < 0)
+            HDONE_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "can't write staged entry images")
+    } /* end if */
+
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5C_flush_invalidate_ring() */
 
@@ -5965,8 +5988,8 @@ H5C_flush_ring(H5F_t *f, hid_t dxpl_id, H5C_ring_t ring,  unsigned flags)
     hbool_t		ignore_protected;
     hbool_t		tried_to_flush_protected_entry = FALSE;
     hbool_t		restart_slist_scan;
+    hbool_t		opened_write_batch = FALSE;
     uint32_t		protected_entries = 0;
-    H5SL_node_t * 	node_ptr = NULL;
     H5C_cache_entry_t *	entry_ptr = NULL;
     H5C_cache_entry_t *	next_entry_ptr = NULL;
 #if H5C_DO_SANITY_CHECKS
@@ -5980,7 +6003,6 @@ H5C_flush_ring(H5F_t *f, hid_t dxpl_id, H5C_ring_t ring,  unsigned flags)
 
     HDassert(cache_ptr);
     HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
-    HDassert(cache_ptr->slist_ptr);
     HDassert((flags & H5C__FLUSH_INVALIDATE_FLAG) == 0);
     HDassert(ring > H5C_RING_UNDEFINED);
     HDassert(ring < H5C_RING_NTYPES);
@@ -6018,6 +6040,14 @@ H5C_flush_ring(H5F_t *f, hid_t dxpl_id, H5C_ring_t ring,  unsigned flags)
      */
     cache_ptr->slist_changed = FALSE;
 
+    /* Stage the images of the entries written by this flush, so that
+     * runs of adjacent entries go to the file in a single write.
+     */
+    if(!cache_ptr->write_batch_enabled && NULL == cache_ptr->aux_ptr) {
+        cache_ptr->write_batch_enabled = TRUE;
+        opened_write_batch = TRUE;
+    } /* end if */
+
     while((cache_ptr->slist_ring_len[ring] > 0) &&
 	    (protected_entries == 0)  &&
 	    (flushed_entries_last_pass)) {
@@ -6064,23 +6094,19 @@ H5C_flush_ring(H5F_t *f, hid_t dxpl_id, H5C_ring_t ring,  unsigned flags)
 
         restart_slist_scan = TRUE;
 
-        while((restart_slist_scan ) || (node_ptr != NULL)) {
+        while((restart_slist_scan ) || (next_entry_ptr != NULL)) {
             if(restart_slist_scan) {
                 restart_slist_scan = FALSE;
 
-                /* Start at beginning of skip list */
-                node_ptr = H5SL_first(cache_ptr->slist_ptr);
+                /* Start at beginning of the slist, sorting it into
+                 * increasing address order if necessary.
+                 */
+                next_entry_ptr = H5C__slist_first(cache_ptr);
 
-                if(node_ptr == NULL)
+                if(next_entry_ptr == NULL)
                     /* the slist is empty -- break out of inner loop */
                     break;
 
-                /* Get cache entry for this node */
-                next_entry_ptr = (H5C_cache_entry_t *)H5SL_item(node_ptr);
-
-                if(NULL == next_entry_ptr)
-                    HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "next_entry_ptr == NULL ?!?!")
-
                 HDassert(next_entry_ptr->magic == H5C__H5C_CACHE_ENTRY_T_MAGIC);
                 HDassert(next_entry_ptr->is_dirty);
                 HDassert(next_entry_ptr->in_slist);
@@ -6111,15 +6137,11 @@ H5C_flush_ring(H5F_t *f, hid_t dxpl_id, H5C_ring_t ring,  unsigned flags)
             if(!flush_marked_entries || entry_ptr->flush_marker)
                 HDassert(entry_ptr->ring >= ring);
 
-            /* Advance node pointer now, before we delete its target
-             * from the slist.
+            /* Advance to the next entry now, before we delete the
+             * current entry from the slist.
              */
-            node_ptr = H5SL_next(node_ptr);
-            if(node_ptr != NULL) {
-                next_entry_ptr = (H5C_cache_entry_t *)H5SL_item(node_ptr);
-                if(NULL == next_entry_ptr)
-                    HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "next_entry_ptr == NULL ?!?!")
-
+            next_entry_ptr = entry_ptr->slist_next;
+            if(next_entry_ptr != NULL) {
                 HDassert(next_entry_ptr->magic == H5C__H5C_CACHE_ENTRY_T_MAGIC);
                 HDassert(next_entry_ptr->is_dirty);
                 HDassert(next_entry_ptr->in_slist);
@@ -6129,8 +6151,6 @@ H5C_flush_ring(H5F_t *f, hid_t dxpl_id, H5C_ring_t ring,  unsigned flags)
 
                 HDassert(entry_ptr != next_entry_ptr);
             } /* end if */
-            else
-                next_entry_ptr = NULL;
 
             if((!flush_marked_entries || entry_ptr->flush_marker) 
                     && (!entry_ptr->flush_me_last ||
@@ -6171,7 +6191,7 @@ H5C_flush_ring(H5F_t *f, hid_t dxpl_id, H5C_ring_t ring,  unsigned flags)
                     flushed_entries_last_pass = TRUE;
                 } /* end else */
             } /* end if */
-        } /* while ( ( restart_slist_scan ) || ( node_ptr != NULL ) ) */
+        } /* while ( ( restart_slist_scan ) || ( next_entry_ptr != NULL ) ) */
 
 #if H5C_DO_SANITY_CHECKS
         /* Verify that the slist size and length are as expected. */
@@ -6193,6 +6213,13 @@ H5C_flush_ring(H5F_t *f, hid_t dxpl_id, H5C_ring_t ring,  unsigned flags)
 #endif /* H5C_DO_SANITY_CHECKS */
 
 done:
+    /* Write out the images still staged */
+    if(opened_write_batch) {
+        cache_ptr->write_batch_enabled = FALSE;
+        if(H5C_flush_write_batch(f, dxpl_id) < 0)
+            HDONE_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "can't write staged entry images")
+    } /* end if */
+
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5C_flush_ring() */
 
@@ -6412,7 +6439,14 @@ H5C__flush_single_entry(H5F_t *f, hid_t dxpl_id, H5C_cache_entry_t *entry_ptr,
             else
                 mem_type = entry_ptr->type->mem_type;
 
-            if(H5F_block_write(f, mem_type, entry_ptr->addr, entry_ptr->size, dxpl_id, entry_ptr->image_ptr) < 0)
+            /* While a ring is being flushed, stage the image so that it
+             * can be written together with the images of adjacent entries.
+             */
+            if(cache_ptr->write_batch_enabled) {
+                if(H5C__write_batch_add(f, dxpl_id, entry_ptr, mem_type) < 0)
+                    HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "Can't stage image for write.")
+            } /* end if */
+            else if(H5F_block_write(f, mem_type, entry_ptr->addr, entry_ptr->size, dxpl_id, entry_ptr->image_ptr) < 0)
                 HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "Can't write image to file.")
         } /* end if */
 
@@ -6690,6 +6724,297 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5C__flush_single_entry() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__write_batch_add
+ *
+ * Purpose:     Stage the image of an entry that is being flushed in the
+ *		cache's write batch.
+ *
+ *		If the image doesn't start where the current run ends,
+ *		can't share a write with it, or would overflow the
+ *		staging buffer, the run is written out first.  The same
+ *		is done if the entry is a flush dependency parent, so
+ *		that its children are in the file before it is.
+ *
+ *		Images too large for the staging buffer are written
+ *		directly.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__write_batch_add(H5F_t *f, hid_t dxpl_id, const H5C_cache_entry_t *entry_ptr,
+    H5FD_mem_t mem_type)
+{
+    H5C_t *     cache_ptr;
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(f->shared);
+    cache_ptr = f->shared->cache;
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+    HDassert(cache_ptr->write_batch_enabled);
+    HDassert(entry_ptr);
+    HDassert(entry_ptr->image_ptr);
+    HDassert(H5F_addr_defined(entry_ptr->addr));
+
+    if(cache_ptr->write_batch_len > 0) {
+        hbool_t     can_extend;         /* Whether the image can extend the run */
+
+        /* Images of different types only share a write when the metadata
+         * accumulator would have combined them anyway.
+         */
+        if(mem_type == cache_ptr->write_batch_type)
+            can_extend = TRUE;
+        else
+            can_extend = (f->shared->feature_flags & H5FD_FEAT_ACCUMULATE_METADATA)
+                    && mem_type != H5FD_MEM_DRAW && mem_type != H5FD_MEM_GHEAP
+                    && cache_ptr->write_batch_type != H5FD_MEM_DRAW
+                    && cache_ptr->write_batch_type != H5FD_MEM_GHEAP;
+
+        if(!can_extend || entry_ptr->flush_dep_nchildren > 0
+                || !H5F_addr_eq(entry_ptr->addr, cache_ptr->write_batch_addr + cache_ptr->write_batch_len)
+                || (cache_ptr->write_batch_len + entry_ptr->size) > H5C__WRITE_BATCH_MAX_SIZE)
+            if(H5C_flush_write_batch(f, dxpl_id) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "can't write staged entry images")
+    } /* end if */
+
+    if(entry_ptr->size > H5C__WRITE_BATCH_MAX_SIZE) {
+        if(H5F_block_write(f, mem_type, entry_ptr->addr, entry_ptr->size, dxpl_id, entry_ptr->image_ptr) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "Can't write image to file.")
+    } /* end if */
+    else {
+        if(NULL == cache_ptr->write_batch_buf)
+            if(NULL == (cache_ptr->write_batch_buf = (uint8_t *)H5MM_malloc(H5C__WRITE_BATCH_MAX_SIZE)))
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for write batch buffer")
+
+        /* Start a new run if needed */
+        if(cache_ptr->write_batch_len == 0) {
+            cache_ptr->write_batch_type = mem_type;
+            cache_ptr->write_batch_addr = entry_ptr->addr;
+        } /* end if */
+
+        HDmemcpy(cache_ptr->write_batch_buf + cache_ptr->write_batch_len, entry_ptr->image_ptr, entry_ptr->size);
+        cache_ptr->write_batch_len += entry_ptr->size;
+        cache_ptr->write_batch_entries++;
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__write_batch_add() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C_flush_write_batch
+ *
+ * Purpose:     Write the run of entry images staged in the cache's write
+ *		batch to the file, if there is one.
+ *
+ *		Besides being called at the end of a flush, this must be
+ *		called before anything is read from the file or file space
+ *		is freed while a flush is in progress.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_flush_write_batch(H5F_t *f, hid_t dxpl_id)
+{
+    H5C_t *     cache_ptr;
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(f->shared);
+    cache_ptr = f->shared->cache;
+
+    if(cache_ptr && cache_ptr->write_batch_len > 0) {
+        size_t len = cache_ptr->write_batch_len;
+
+        HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+        HDassert(cache_ptr->write_batch_buf);
+
+        /* Reset the run before the write, so that it isn't issued again
+         * if the write fails.
+         */
+        cache_ptr->write_batch_len = 0;
+        cache_ptr->write_batch_writes++;
+
+        if(H5F_block_write(f, cache_ptr->write_batch_type, cache_ptr->write_batch_addr,
+                len, dxpl_id, cache_ptr->write_batch_buf) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "Can't write image to file.")
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C_flush_write_batch() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__grow_index
+ *
+ * Purpose:     Double the number of buckets in the cache's hash table
+ *		index, and rehash all entries in the index into the new
+ *		bucket array.
+ *
+ *		This is called from H5C__INSERT_IN_INDEX when the number
+ *		of entries in the index reaches index_nbuckets times
+ *		H5C__HASH_TABLE_MAX_LOAD.  Once the index reaches
+ *		H5C__HASH_TABLE_MAX_LEN buckets, it is left alone and
+ *		the chains are allowed to grow instead.
+ *
+ *		The old array is only released once the new one has been
+ *		allocated, so the index is unchanged on failure.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C__grow_index(H5C_t *cache_ptr)
+{
+    H5C_cache_entry_t **new_index = NULL;   /* New bucket array */
+    H5C_cache_entry_t * entry_ptr;          /* Entry being rehashed */
+    uint32_t            new_nbuckets;       /* Length of new bucket array */
+    herr_t              ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+    HDassert(cache_ptr->index);
+    HDassert(cache_ptr->index_nbuckets == ((uint32_t)1 << cache_ptr->index_nbits));
+
+    if(cache_ptr->index_nbuckets >= H5C__HASH_TABLE_MAX_LEN)
+        HGOTO_DONE(SUCCEED)
+
+    new_nbuckets = cache_ptr->index_nbuckets * 2;
+    if(NULL == (new_index = (H5C_cache_entry_t **)H5MM_calloc((size_t)new_nbuckets * sizeof(H5C_cache_entry_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for cache index")
+
+    H5MM_xfree(cache_ptr->index);
+    cache_ptr->index = new_index;
+    cache_ptr->index_nbuckets = new_nbuckets;
+    cache_ptr->index_nbits++;
+
+    /* The index list holds every entry in the index, so walk it to
+     * rebuild the hash chains.
+     */
+    for(entry_ptr = cache_ptr->il_head; entry_ptr != NULL; entry_ptr = entry_ptr->il_next) {
+        int k = H5C__HASH_FCN(cache_ptr, entry_ptr->addr);
+
+        entry_ptr->ht_prev = NULL;
+        entry_ptr->ht_next = new_index[k];
+        if(new_index[k] != NULL)
+            new_index[k]->ht_prev = entry_ptr;
+        new_index[k] = entry_ptr;
+    } /* end for */
+
+    H5C__UPDATE_STATS_FOR_HT_RESIZE(cache_ptr)
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__grow_index() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__slist_first
+ *
+ * Purpose:     Return the first entry in the slist, sorting the slist
+ *		into increasing address order first if it is not already
+ *		known to be sorted.
+ *
+ *		Entries are appended to the slist as they are marked 
+ *		dirty, so the list is usually made up of a few long runs
+ *		of increasing addresses.  The sort is a natural merge 
+ *		sort on the slist_next pointers -- each pass merges 
+ *		adjacent pairs of runs -- so a list that is already 
+ *		nearly in order is sorted in one or two passes, and a
+ *		sorted list costs a single scan.
+ *
+ * Return:      Pointer to the entry with the lowest address in the 
+ *		slist, or NULL if the slist is empty.
+ *
+ *-------------------------------------------------------------------------
+ */
+H5C_cache_entry_t *
+H5C__slist_first(H5C_t *cache_ptr)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Sanity checks */
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+
+    if(!cache_ptr->slist_sorted) {
+        H5C_cache_entry_t * list = cache_ptr->slist_head;  /* List being sorted */
+        H5C_cache_entry_t * prev_ptr = NULL;    /* Previous entry, when relinking */
+        H5C_cache_entry_t * entry_ptr;          /* Current entry, when relinking */
+        unsigned            nruns;              /* Number of runs merged in a pass */
+
+        do {
+            H5C_cache_entry_t * merged = NULL;      /* Output of this pass */
+            H5C_cache_entry_t **tail_ptr = &merged; /* End of the output */
+
+            nruns = 0;
+            while(list != NULL) {
+                H5C_cache_entry_t *runs[2] = {NULL, NULL};
+                unsigned u;
+
+                /* Cut the next two runs of increasing addresses off 
+                 * the front of the list.
+                 */
+                for(u = 0; u < 2 && list != NULL; u++) {
+                    H5C_cache_entry_t *run_end = list;
+
+                    runs[u] = list;
+                    while(run_end->slist_next != NULL &&
+                            H5F_addr_lt(run_end->addr, run_end->slist_next->addr))
+                        run_end = run_end->slist_next;
+                    list = run_end->slist_next;
+                    run_end->slist_next = NULL;
+                } /* end for */
+
+                /* Merge them onto the end of the output */
+                while(runs[0] != NULL && runs[1] != NULL) {
+                    u = H5F_addr_lt(runs[0]->addr, runs[1]->addr) ? 0 : 1;
+                    *tail_ptr = runs[u];
+                    tail_ptr = &(runs[u]->slist_next);
+                    runs[u] = runs[u]->slist_next;
+                } /* end while */
+                *tail_ptr = (runs[0] != NULL) ? runs[0] : runs[1];
+                while(*tail_ptr != NULL)
+                    tail_ptr = &((*tail_ptr)->slist_next);
+
+                nruns++;
+            } /* end while */
+
+            list = merged;
+        } while(nruns > 1);
+
+        /* Restore the prev pointers and the head and tail of the slist */
+        for(entry_ptr = list; entry_ptr != NULL; entry_ptr = entry_ptr->slist_next) {
+            entry_ptr->slist_prev = prev_ptr;
+            prev_ptr = entry_ptr;
+        } /* end for */
+        cache_ptr->slist_head = list;
+        cache_ptr->slist_tail = prev_ptr;
+        cache_ptr->slist_sorted = TRUE;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(cache_ptr->slist_head)
+} /* H5C__slist_first() */
+
 
 /*-------------------------------------------------------------------------
  *
@@ -6816,6 +7141,12 @@ H5C_load_entry(H5F_t *              f,
     HDassert(!((type->flags & H5C__CLASS_SKIP_READS) &&
                (type->flags & H5C__CLASS_SPECULATIVE_LOAD_FLAG)));
 
+    /* Entry images staged by a flush in progress must reach the file
+     * before anything is read back from it.
+     */
+    if(H5C_flush_write_batch(f, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, NULL, "can't write staged entry images")
+
     /* Call the get_initial_load_size callback, to retrieve the initial size of image */
     if(type->get_initial_load_size(udata, &len) < 0)
         HGOTO_ERROR(H5E_CACHE, H5E_CANTGET, NULL, "can't retrieve image size")
@@ -7043,6 +7374,8 @@ H5C_load_entry(H5F_t *              f,
     entry->ht_prev                      = NULL;
     entry->il_next                      = NULL;
     entry->il_prev             	        = NULL;
+    entry->slist_next                   = NULL;
+    entry->slist_prev                   = NULL;
 
     entry->next                         = NULL;
     entry->prev                         = NULL;
@@ -7837,43 +8170,39 @@ done:
 
 /*-------------------------------------------------------------------------
  *
- * Function:    H5C_entry_in_skip_list
+ * Function:    H5C_entry_in_slist
  *
- * Purpose:     Debugging function that scans skip list to see if it 
- *		is in present.  We need this, as it is possible for 
- *		an entry to be in the skip list twice.
+ * Purpose:     Debugging function that scans the slist to see if the
+ *		entry is present.  We need this, as it is possible for 
+ *		an entry to be in the slist twice.
  *
- * Return:      FALSE if the entry is not in the skip list, and TRUE 
+ * Return:      FALSE if the entry is not in the slist, and TRUE 
  *		if it is.
  *
  * Programmer:  John Mainzer, 11/1/14
  *
  * Changes:
  *
- *		None.
+ *		Renamed from H5C_entry_in_skip_list(), and modified to
+ *		scan the intrusive slist instead of a skip list.
  *
  *-------------------------------------------------------------------------
  */
 #if H5C_DO_SLIST_SANITY_CHECKS
 
 static hbool_t
-H5C_entry_in_skip_list(H5C_t * cache_ptr, H5C_cache_entry_t *target_ptr)
+H5C_entry_in_slist(H5C_t * cache_ptr, H5C_cache_entry_t *target_ptr)
 {
     hbool_t in_slist              = FALSE;
-    H5SL_node_t *       node_ptr  = NULL;
     H5C_cache_entry_t *	entry_ptr = NULL;
 
     HDassert( cache_ptr );
     HDassert( cache_ptr->magic == H5C__H5C_T_MAGIC );
-    HDassert( cache_ptr->slist_ptr );
 
-    node_ptr = H5SL_first(cache_ptr->slist_ptr);
+    entry_ptr = cache_ptr->slist_head;
 
-    while ( ( node_ptr != NULL ) && ( ! in_slist ) )
+    while ( ( entry_ptr != NULL ) && ( ! in_slist ) )
     {
-        entry_ptr = (H5C_cache_entry_t *)H5SL_item(node_ptr);
-
-	HDassert( entry_ptr );
 	HDassert( entry_ptr->magic == H5C__H5C_CACHE_ENTRY_T_MAGIC );
         HDassert( entry_ptr->is_dirty );
         HDassert( entry_ptr->in_slist );
@@ -7884,13 +8213,13 @@ H5C_entry_in_skip_list(H5C_t * cache_ptr, H5C_cache_entry_t *target_ptr)
 
 	} else {
 
-	    node_ptr = H5SL_next(node_ptr);
+	    entry_ptr = entry_ptr->slist_next;
 	}
     }
 
     return(in_slist);
 
-} /* H5C_entry_in_skip_list() */
+} /* H5C_entry_in_slist() */
 #endif /* H5C_DO_SLIST_SANITY_CHECKS */
 
 
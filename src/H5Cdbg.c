@@ -111,7 +111,7 @@ H5C_dump_cache(H5C_t * cache_ptr, const char *  cache_name)
      * Do this, as we want to display cache entries in increasing address
      * order.
      */
-    for(i = 0; i < H5C__HASH_TABLE_LEN; i++) {
+    for(i = 0; i < (int)cache_ptr->index_nbuckets; i++) {
         entry_ptr = cache_ptr->index[i];
 
         while(entry_ptr != NULL) {
@@ -202,7 +202,6 @@ H5C_dump_cache_skip_list(H5C_t * cache_ptr, char * calling_fcn)
     herr_t              ret_value = SUCCEED;   /* Return value */
     int                 i;
     H5C_cache_entry_t * entry_ptr = NULL;
-    H5SL_node_t *       node_ptr = NULL;
 
     FUNC_ENTER_NOAPI(FAIL)
 
@@ -222,11 +221,7 @@ H5C_dump_cache_skip_list(H5C_t * cache_ptr, char * calling_fcn)
                   "Num:    Addr:               Len: Prot/Pind: Dirty: Type:\n");
 
         i = 0;
-        node_ptr = H5SL_first(cache_ptr->slist_ptr);
-        if(node_ptr != NULL)
-            entry_ptr = (H5C_cache_entry_t *)H5SL_item(node_ptr);
-        else
-            entry_ptr = NULL;
+        entry_ptr = H5C__slist_first(cache_ptr);
 
         while(entry_ptr != NULL) {
             HDassert( entry_ptr->magic == H5C__H5C_CACHE_ENTRY_T_MAGIC );
@@ -241,16 +236,7 @@ H5C_dump_cache_skip_list(H5C_t * cache_ptr, char * calling_fcn)
                (int)(entry_ptr->is_dirty),
                entry_ptr->type->name);
 
-            HDfprintf(stdout, "		node_ptr = 0x%llx, item = 0x%llx\n",
-                      (unsigned long long)node_ptr,
-                      (unsigned long long)H5SL_item(node_ptr));
-
-            /* increment node_ptr before we delete its target */
-            node_ptr = H5SL_next(node_ptr);
-            if(node_ptr != NULL)
-                entry_ptr = (H5C_cache_entry_t *)H5SL_item(node_ptr);
-            else
-                entry_ptr = NULL;
+            entry_ptr = entry_ptr->slist_next;
 
             i++;
         } /* end while */
@@ -491,6 +477,20 @@ H5C_stats(H5C_t * cache_ptr,
               average_successful_search_depth,
               average_failed_search_depth);
 
+    HDfprintf(stdout,
+              "%s  Max HT suc / failed search depth   = %ld / %ld\n",
+              cache_ptr->prefix,
+              (long)(cache_ptr->max_successful_ht_search_depth),
+              (long)(cache_ptr->max_failed_ht_search_depth));
+
+    HDfprintf(stdout,
+              "%s  HT buckets / resizes / load        = %lu / %ld / %f\n",
+              cache_ptr->prefix,
+              (unsigned long)(cache_ptr->index_nbuckets),
+              (long)(cache_ptr->total_ht_resizes),
+              ((double)(cache_ptr->index_len)) /
+              ((double)(cache_ptr->index_nbuckets)));
+
     HDfprintf(stdout,
              "%s  current (max) index size / length  = %ld (%ld) / %lu (%lu)\n",
               cache_ptr->prefix,
@@ -877,6 +877,9 @@ H5C_stats__reset(H5C_t H5_ATTR_UNUSED * cache_ptr)
     cache_ptr->total_successful_ht_search_depth	= 0;
     cache_ptr->failed_ht_searches		= 0;
     cache_ptr->total_failed_ht_search_depth	= 0;
+    cache_ptr->max_successful_ht_search_depth	= 0;
+    cache_ptr->max_failed_ht_search_depth	= 0;
+    cache_ptr->total_ht_resizes			= 0;
 
     cache_ptr->max_index_len			= 0;
     cache_ptr->max_index_size			= (size_t)0;
@@ -620,6 +620,8 @@ H5C__deserialize_prefetched_entry(H5F_t *f, hid_t dxpl_id, H5C_t *cache_ptr,
     ds_entry_ptr->ht_prev                   	= NULL;
     ds_entry_ptr->il_next                   	= NULL;
     ds_entry_ptr->il_prev                   	= NULL;
+    ds_entry_ptr->slist_next                   	= NULL;
+    ds_entry_ptr->slist_prev                   	= NULL;
 
     /* Initialize fields supporting replacement policies: */
     ds_entry_ptr->next                      	= NULL;
@@ -3339,7 +3341,6 @@ H5C__serialize_cache(H5F_t *f, hid_t dxpl_id)
     cache_ptr = f->shared->cache;
     HDassert(cache_ptr);
     HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
-    HDassert(cache_ptr->slist_ptr);
 
 #if H5C_DO_SANITY_CHECKS
     HDassert(cache_ptr->index_ring_len[H5C_RING_UNDEFINED] == 0);
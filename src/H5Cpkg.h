@@ -49,9 +49,16 @@
 #define H5C__MAX_EPOCH_MARKERS                  10
 
 /* Cache configuration settings */
-#define H5C__HASH_TABLE_LEN     (64 * 1024) /* must be a power of 2 */
+#define H5C__HASH_TABLE_MIN_BITS 12
+#define H5C__HASH_TABLE_MAX_BITS 30
+#define H5C__HASH_TABLE_MIN_LEN ((uint32_t)1 << H5C__HASH_TABLE_MIN_BITS)
+#define H5C__HASH_TABLE_MAX_LEN ((uint32_t)1 << H5C__HASH_TABLE_MAX_BITS)
+#define H5C__HASH_TABLE_MAX_LOAD 1          /* entries per bucket before growth */
 #define H5C__H5C_T_MAGIC	0x005CAC0E
 
+/* Size of the buffer used to coalesce entry images written during a flush */
+#define H5C__WRITE_BATCH_MAX_SIZE       ((size_t)(1024 * 1024))
+
 /* Initial allocated size of the "flush_dep_parent" array */
 #define H5C_FLUSH_DEP_PARENT_INIT 8
 
@@ -665,11 +672,18 @@ if ( ( ( ( (head_ptr) == NULL ) || ( (tail_ptr) == NULL ) ) &&             \
 	if ( success ) {                                            \
 	    (cache_ptr)->successful_ht_searches++;                  \
 	    (cache_ptr)->total_successful_ht_search_depth += depth; \
+	    if ( (depth) > (cache_ptr)->max_successful_ht_search_depth ) \
+	        (cache_ptr)->max_successful_ht_search_depth = (depth); \
 	} else {                                                    \
 	    (cache_ptr)->failed_ht_searches++;                      \
 	    (cache_ptr)->total_failed_ht_search_depth += depth;     \
+	    if ( (depth) > (cache_ptr)->max_failed_ht_search_depth ) \
+	        (cache_ptr)->max_failed_ht_search_depth = (depth);  \
 	}
 
+#define H5C__UPDATE_STATS_FOR_HT_RESIZE(cache_ptr) \
+	(cache_ptr)->total_ht_resizes++;
+
 #define H5C__UPDATE_STATS_FOR_UNPIN(cache_ptr, entry_ptr) \
 	((cache_ptr)->unpins)[(entry_ptr)->type->id]++;
 
@@ -921,6 +935,7 @@ if ( ( ( ( (head_ptr) == NULL ) || ( (tail_ptr) == NULL ) ) &&             \
 #define H5C__UPDATE_STATS_FOR_HT_INSERTION(cache_ptr)
 #define H5C__UPDATE_STATS_FOR_HT_DELETION(cache_ptr)
 #define H5C__UPDATE_STATS_FOR_HT_SEARCH(cache_ptr, success, depth)
+#define H5C__UPDATE_STATS_FOR_HT_RESIZE(cache_ptr)
 #define H5C__UPDATE_STATS_FOR_INSERTION(cache_ptr, entry_ptr)
 #define H5C__UPDATE_STATS_FOR_CLEAR(cache_ptr, entry_ptr)
 #define H5C__UPDATE_STATS_FOR_FLUSH(cache_ptr, entry_ptr)
@@ -971,13 +986,21 @@ if ( ( ( ( (head_ptr) == NULL ) || ( (tail_ptr) == NULL ) ) &&             \
  *
  *                                              JRM -- 10/15/15
  *
+ *   - Made the number of hash buckets variable.  The hash function
+ *     now folds the full entry address into 32 bits and scrambles it
+ *     with a multiplicative (Fibonacci) hash, keeping the high
+ *     index_nbits bits of the product.  H5C__INSERT_IN_INDEX doubles
+ *     the bucket array via H5C__grow_index() when the load factor
+ *     exceeds H5C__HASH_TABLE_MAX_LOAD.
+ *
  ***********************************************************************/
 
-/* H5C__HASH_TABLE_LEN is defined in H5Cpkg.h.  It mut be a power of two. */
-
-#define H5C__HASH_MASK		((size_t)(H5C__HASH_TABLE_LEN - 1) << 3)
-
-#define H5C__HASH_FCN(x)	(int)((unsigned)((x) & H5C__HASH_MASK) >> 3)
+/* The number of buckets (cache_ptr->index_nbuckets) is always a power of 
+ * two, equal to 1 << cache_ptr->index_nbits. 
+ */
+#define H5C__HASH_FCN(cache_ptr, x)                                     \
+    (int)((((uint32_t)(x) ^ (uint32_t)((uint64_t)(x) >> 32))            \
+           * (uint32_t)0x9E3779B9UL) >> (32 - (cache_ptr)->index_nbits))
 
 #if H5C_DO_SANITY_CHECKS
 
@@ -989,8 +1012,9 @@ if ( ( (cache_ptr) == NULL ) ||                                         \
      ( (entry_ptr)->ht_next != NULL ) ||                                \
      ( (entry_ptr)->ht_prev != NULL ) ||                                \
      ( (entry_ptr)->size <= 0 ) ||                                      \
-     ( H5C__HASH_FCN((entry_ptr)->addr) < 0 ) ||                        \
-     ( H5C__HASH_FCN((entry_ptr)->addr) >= H5C__HASH_TABLE_LEN ) ||     \
+     ( H5C__HASH_FCN(cache_ptr, (entry_ptr)->addr) < 0 ) ||             \
+     ( (uint32_t)H5C__HASH_FCN(cache_ptr, (entry_ptr)->addr) >=         \
+       (cache_ptr)->index_nbuckets ) ||                                 \
      ( (cache_ptr)->index_size !=                                       \
        ((cache_ptr)->clean_index_size +                                 \
 	(cache_ptr)->dirty_index_size) ) ||                             \
@@ -1043,14 +1067,15 @@ if ( ( (cache_ptr) == NULL ) ||                                         \
      ( (cache_ptr)->index_size < (entry_ptr)->size ) ||                 \
      ( ! H5F_addr_defined((entry_ptr)->addr) ) ||                       \
      ( (entry_ptr)->size <= 0 ) ||                                      \
-     ( H5C__HASH_FCN((entry_ptr)->addr) < 0 ) ||                        \
-     ( H5C__HASH_FCN((entry_ptr)->addr) >= H5C__HASH_TABLE_LEN ) ||     \
-     ( ((cache_ptr)->index)[(H5C__HASH_FCN((entry_ptr)->addr))]         \
+     ( H5C__HASH_FCN(cache_ptr, (entry_ptr)->addr) < 0 ) ||             \
+     ( (uint32_t)H5C__HASH_FCN(cache_ptr, (entry_ptr)->addr) >=         \
+       (cache_ptr)->index_nbuckets ) ||                                 \
+     ( ((cache_ptr)->index)[(H5C__HASH_FCN(cache_ptr, (entry_ptr)->addr))] \
        == NULL ) ||                                                     \
-     ( ( ((cache_ptr)->index)[(H5C__HASH_FCN((entry_ptr)->addr))]       \
+     ( ( ((cache_ptr)->index)[(H5C__HASH_FCN(cache_ptr, (entry_ptr)->addr))] \
        != (entry_ptr) ) &&                                              \
        ( (entry_ptr)->ht_prev == NULL ) ) ||                            \
-     ( ( ((cache_ptr)->index)[(H5C__HASH_FCN((entry_ptr)->addr))] ==    \
+     ( ( ((cache_ptr)->index)[(H5C__HASH_FCN(cache_ptr, (entry_ptr)->addr))] == \
          (entry_ptr) ) &&                                               \
        ( (entry_ptr)->ht_prev != NULL ) ) ||                            \
      ( (cache_ptr)->index_size !=                                       \
@@ -1109,8 +1134,9 @@ if ( ( (cache_ptr) == NULL ) ||                                             \
      ( (cache_ptr)->index_size !=                                           \
        ((cache_ptr)->clean_index_size + (cache_ptr)->dirty_index_size) ) || \
      ( ! H5F_addr_defined(Addr) ) ||                                        \
-     ( H5C__HASH_FCN(Addr) < 0 ) ||                                         \
-     ( H5C__HASH_FCN(Addr) >= H5C__HASH_TABLE_LEN ) ) {                     \
+     ( H5C__HASH_FCN(cache_ptr, Addr) < 0 ) ||                              \
+     ( (uint32_t)H5C__HASH_FCN(cache_ptr, Addr) >=                          \
+       (cache_ptr)->index_nbuckets ) ) {                                    \
     HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, fail_val, "Pre HT search SC failed") \
 }
 
@@ -1328,7 +1354,12 @@ if ( ( (cache_ptr)->index_size !=                                           \
 {                                                                            \
     int k;                                                                   \
     H5C__PRE_HT_INSERT_SC(cache_ptr, entry_ptr, fail_val)                    \
-    k = H5C__HASH_FCN((entry_ptr)->addr);                                    \
+    if((cache_ptr)->index_len >=                                             \
+            (cache_ptr)->index_nbuckets * H5C__HASH_TABLE_MAX_LOAD)          \
+        if(H5C__grow_index(cache_ptr) < 0)                                   \
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, fail_val,                  \
+                        "can't grow cache index")                            \
+    k = H5C__HASH_FCN(cache_ptr, (entry_ptr)->addr);                         \
     if(((cache_ptr)->index)[k] != NULL) {                                    \
         (entry_ptr)->ht_next = ((cache_ptr)->index)[k];                      \
         (entry_ptr)->ht_next->ht_prev = (entry_ptr);                         \
@@ -1363,7 +1394,7 @@ if ( ( (cache_ptr)->index_size !=                                           \
 {                                                                            \
     int k;                                                                   \
     H5C__PRE_HT_REMOVE_SC(cache_ptr, entry_ptr)                              \
-    k = H5C__HASH_FCN((entry_ptr)->addr);                                    \
+    k = H5C__HASH_FCN(cache_ptr, (entry_ptr)->addr);                         \
     if((entry_ptr)->ht_next)                                                 \
         (entry_ptr)->ht_next->ht_prev = (entry_ptr)->ht_prev;                \
     if((entry_ptr)->ht_prev)                                                 \
@@ -1402,7 +1433,7 @@ if ( ( (cache_ptr)->index_size !=                                           \
     int k;                                                                  \
     int depth = 0;                                                          \
     H5C__PRE_HT_SEARCH_SC(cache_ptr, Addr, fail_val)                        \
-    k = H5C__HASH_FCN(Addr);                                                \
+    k = H5C__HASH_FCN(cache_ptr, Addr);                                     \
     entry_ptr = ((cache_ptr)->index)[k];                                    \
     while(entry_ptr) {                                                      \
         if(H5F_addr_eq(Addr, (entry_ptr)->addr)) {                          \
@@ -1430,7 +1461,7 @@ if ( ( (cache_ptr)->index_size !=                                           \
 {                                                                           \
     int k;                                                                  \
     H5C__PRE_HT_SEARCH_SC(cache_ptr, Addr, fail_val)                        \
-    k = H5C__HASH_FCN(Addr);                                                \
+    k = H5C__HASH_FCN(cache_ptr, Addr);                                     \
     entry_ptr = ((cache_ptr)->index)[k];                                    \
     while(entry_ptr) {                                                      \
         if(H5F_addr_eq(Addr, (entry_ptr)->addr)) {                          \
@@ -1521,9 +1552,14 @@ if ( ( (cache_ptr)->index_size !=                                           \
  * Macro:	H5C__INSERT_ENTRY_IN_SLIST
  *
  * Purpose:     Insert the specified instance of H5C_cache_entry_t into
- *		the skip list in the specified instance of H5C_t.  Update
+ *		the slist in the specified instance of H5C_t.  Update
  *		the associated length and size fields.
  *
+ *		The entry is appended to the tail of the slist.  If this
+ *		puts the slist out of address order, the slist_sorted
+ *		flag is cleared, and the list is sorted the next time
+ *		H5C__slist_first() is called.
+ *
  * Return:      N/A
  *
  * Programmer:  John Mainzer, 5/10/04
@@ -1577,7 +1613,7 @@ if ( ( (cache_ptr)->index_size !=                                           \
 
 #if H5C_DO_SLIST_SANITY_CHECKS
 #define ENTRY_IN_SLIST(cache_ptr, entry_ptr) \
-    H5C_entry_in_skip_list((cache_ptr), (entry_ptr))
+    H5C_entry_in_slist((cache_ptr), (entry_ptr))
 #else /* H5C_DO_SLIST_SANITY_CHECKS */
 #define ENTRY_IN_SLIST(cache_ptr, entry_ptr) FALSE
 #endif /* H5C_DO_SLIST_SANITY_CHECKS */
@@ -1600,9 +1636,18 @@ if ( ( (cache_ptr)->index_size !=                                           \
     HDassert( (cache_ptr)->slist_ring_size[(entry_ptr)->ring] <=               \
               (cache_ptr)->slist_size );                                       \
                                                                                \
-    if(H5SL_insert((cache_ptr)->slist_ptr, entry_ptr, &(entry_ptr)->addr) < 0) \
-        HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, (fail_val),                       \
-                    "Can't insert entry in skip list")                         \
+    (entry_ptr)->slist_next = NULL;                                            \
+    (entry_ptr)->slist_prev = (cache_ptr)->slist_tail;                         \
+    if((cache_ptr)->slist_tail == NULL) {                                      \
+        HDassert( (cache_ptr)->slist_head == NULL );                           \
+        (cache_ptr)->slist_head = (entry_ptr);                                 \
+    } /* end if */                                                             \
+    else {                                                                     \
+        if(H5F_addr_lt((entry_ptr)->addr, (cache_ptr)->slist_tail->addr))      \
+            (cache_ptr)->slist_sorted = FALSE;                                 \
+        (cache_ptr)->slist_tail->slist_next = (entry_ptr);                     \
+    } /* end else */                                                           \
+    (cache_ptr)->slist_tail = (entry_ptr);                                     \
                                                                                \
     (entry_ptr)->in_slist = TRUE;                                              \
     (cache_ptr)->slist_changed = TRUE;                                         \
@@ -1636,9 +1681,18 @@ if ( ( (cache_ptr)->index_size !=                                           \
     HDassert( (cache_ptr)->slist_ring_size[(entry_ptr)->ring] <=               \
               (cache_ptr)->slist_size );                                       \
                                                                                \
-    if(H5SL_insert((cache_ptr)->slist_ptr, entry_ptr, &(entry_ptr)->addr) < 0) \
-        HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, (fail_val),                       \
-                    "Can't insert entry in skip list")                         \
+    (entry_ptr)->slist_next = NULL;                                            \
+    (entry_ptr)->slist_prev = (cache_ptr)->slist_tail;                         \
+    if((cache_ptr)->slist_tail == NULL) {                                      \
+        HDassert( (cache_ptr)->slist_head == NULL );                           \
+        (cache_ptr)->slist_head = (entry_ptr);                                 \
+    } /* end if */                                                             \
+    else {                                                                     \
+        if(H5F_addr_lt((entry_ptr)->addr, (cache_ptr)->slist_tail->addr))      \
+            (cache_ptr)->slist_sorted = FALSE;                                 \
+        (cache_ptr)->slist_tail->slist_next = (entry_ptr);                     \
+    } /* end else */                                                           \
+    (cache_ptr)->slist_tail = (entry_ptr);                                     \
                                                                                \
     (entry_ptr)->in_slist = TRUE;                                              \
     (cache_ptr)->slist_changed = TRUE;                                         \
@@ -1660,9 +1714,12 @@ if ( ( (cache_ptr)->index_size !=                                           \
  * Function:    H5C__REMOVE_ENTRY_FROM_SLIST
  *
  * Purpose:     Remove the specified instance of H5C_cache_entry_t from the
- *		index skip list in the specified instance of H5C_t.  Update
+ *		slist in the specified instance of H5C_t.  Update
  *		the associated length and size fields.
  *
+ *		Unlinking an entry does not disturb the order of the 
+ *		remaining entries, so the slist_sorted flag is unchanged.
+ *
  * Return:      N/A
  *
  * Programmer:  John Mainzer, 5/10/04
@@ -1680,7 +1737,6 @@ if ( ( (cache_ptr)->index_size !=                                           \
     HDassert( ((entry_ptr)->ro_ref_count) == 0 );                           \
     HDassert( (entry_ptr)->size > 0 );                                      \
     HDassert( (entry_ptr)->in_slist );                                      \
-    HDassert( (cache_ptr)->slist_ptr );                                     \
     HDassert( (entry_ptr)->ring > H5C_RING_UNDEFINED );                     \
     HDassert( (entry_ptr)->ring < H5C_RING_NTYPES );                        \
     HDassert( (cache_ptr)->slist_ring_len[(entry_ptr)->ring] <=             \
@@ -1688,10 +1744,23 @@ if ( ( (cache_ptr)->index_size !=                                           \
     HDassert( (cache_ptr)->slist_ring_size[(entry_ptr)->ring] <=            \
               (cache_ptr)->slist_size );                                    \
                                                                             \
-    if ( H5SL_remove((cache_ptr)->slist_ptr, &(entry_ptr)->addr)            \
-             != (entry_ptr) )                                               \
+    if ( ( ( (entry_ptr)->slist_prev == NULL ) !=                           \
+           ( (cache_ptr)->slist_head == (entry_ptr) ) ) ||                  \
+         ( ( (entry_ptr)->slist_next == NULL ) !=                           \
+           ( (cache_ptr)->slist_tail == (entry_ptr) ) ) )                   \
         HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL,                          \
-                    "Can't delete entry from skip list.")                   \
+                    "Can't delete entry from slist.")                       \
+                                                                            \
+    if ( (entry_ptr)->slist_prev == NULL )                                  \
+        (cache_ptr)->slist_head = (entry_ptr)->slist_next;                  \
+    else                                                                    \
+        (entry_ptr)->slist_prev->slist_next = (entry_ptr)->slist_next;      \
+    if ( (entry_ptr)->slist_next == NULL )                                  \
+        (cache_ptr)->slist_tail = (entry_ptr)->slist_prev;                  \
+    else                                                                    \
+        (entry_ptr)->slist_next->slist_prev = (entry_ptr)->slist_prev;      \
+    (entry_ptr)->slist_next = NULL;                                         \
+    (entry_ptr)->slist_prev = NULL;                                         \
                                                                             \
     HDassert( (cache_ptr)->slist_len > 0 );                                 \
     if(!(during_flush))                                                     \
@@ -1718,7 +1787,6 @@ if ( ( (cache_ptr)->index_size !=                                           \
     HDassert( !((entry_ptr)->is_read_only) );                               \
     HDassert( ((entry_ptr)->ro_ref_count) == 0 );                           \
     HDassert( (entry_ptr)->in_slist );                                      \
-    HDassert( (cache_ptr)->slist_ptr );                                     \
     HDassert( (entry_ptr)->ring > H5C_RING_UNDEFINED );                     \
     HDassert( (entry_ptr)->ring < H5C_RING_NTYPES );                        \
     HDassert( (cache_ptr)->slist_ring_len[(entry_ptr)->ring] <=             \
@@ -1726,10 +1794,23 @@ if ( ( (cache_ptr)->index_size !=                                           \
     HDassert( (cache_ptr)->slist_ring_size[(entry_ptr)->ring] <=            \
               (cache_ptr)->slist_size );                                    \
                                                                             \
-    if ( H5SL_remove((cache_ptr)->slist_ptr, &(entry_ptr)->addr)            \
-             != (entry_ptr) )                                               \
+    if ( ( ( (entry_ptr)->slist_prev == NULL ) !=                           \
+           ( (cache_ptr)->slist_head == (entry_ptr) ) ) ||                  \
+         ( ( (entry_ptr)->slist_next == NULL ) !=                           \
+           ( (cache_ptr)->slist_tail == (entry_ptr) ) ) )                   \
         HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL,                          \
-                    "Can't delete entry from skip list.")                   \
+                    "Can't delete entry from slist.")                       \
+                                                                            \
+    if ( (entry_ptr)->slist_prev == NULL )                                  \
+        (cache_ptr)->slist_head = (entry_ptr)->slist_next;                  \
+    else                                                                    \
+        (entry_ptr)->slist_prev->slist_next = (entry_ptr)->slist_next;      \
+    if ( (entry_ptr)->slist_next == NULL )                                  \
+        (cache_ptr)->slist_tail = (entry_ptr)->slist_prev;                  \
+    else                                                                    \
+        (entry_ptr)->slist_next->slist_prev = (entry_ptr)->slist_prev;      \
+    (entry_ptr)->slist_next = NULL;                                         \
+    (entry_ptr)->slist_prev = NULL;                                         \
                                                                             \
     HDassert( (cache_ptr)->slist_len > 0 );                                 \
     if(!(during_flush))                                                     \
@@ -3689,20 +3770,25 @@ typedef struct H5C_tag_info_t {
  *		index by ring.  Note that the sum of all cells in this array 
  *		must equal the value stored in dirty_index_size above.
  *
- * index:	Array of pointer to H5C_cache_entry_t of size
- *		H5C__HASH_TABLE_LEN.  At present, this value is a power
- *		of two, not the usual prime number.
+ * index:	Dynamically allocated array of pointer to H5C_cache_entry_t
+ *		of length index_nbuckets.  Entries hashing to the same
+ *		bucket are chained through their ht_next and ht_prev fields.
+ *
+ *		The hash function (H5C__HASH_FCN) mixes all bits of the
+ *		entry address, so that the bucket distribution does not
+ *		depend on the way in which HDF5 allocates file space.
  *
- *		I hope that the variable size of cache elements, the large
- *		hash table size, and the way in which HDF5 allocates space
- *		will combine to avoid problems with periodicity.  If so, we
- *		can use a trivial hash function (a bit-and and a 3 bit left
- *		shift) with some small savings.
+ *		The array starts with H5C__HASH_TABLE_MIN_LEN buckets, and
+ *		is doubled by H5C__grow_index() whenever index_len exceeds
+ *		index_nbuckets * H5C__HASH_TABLE_MAX_LOAD, so the expected
+ *		chain length stays bounded however many entries the cache
+ *		holds.  The array is never shrunk.
  *
- *		If not, it will become evident in the statistics. Changing
- *		to the usual prime number length hash table will require
- *		changing the H5C__HASH_FCN macro and the deletion of the
- *		H5C__HASH_MASK #define.  No other changes should be required.
+ * index_nbuckets: Number of buckets in the index array.  This is always
+ *		a power of two, no smaller than H5C__HASH_TABLE_MIN_LEN.
+ *
+ * index_nbits:	Base 2 logarithm of index_nbuckets, i.e. the number of
+ *		bits of the hash value used to select a bucket.
  *
  * il_len:	Number of entries on the index list.  
  *
@@ -3779,6 +3865,12 @@ typedef struct H5C_tag_info_t {
  * or to maintain the list is an open question.  At a guess, it depends
  * on how frequently the cache is flushed.  We will see how it goes.
  *
+ * (The skip list has been replaced by a doubly linked list threaded
+ * through the entries themselves.  Entries are appended as they are
+ * marked dirty, and the list is sorted by address only when a flush
+ * needs to scan it.  Since entries are dirtied far more often than
+ * the cache is flushed, this is the cheaper of the two.)
+ *
  * For now at least, I will not remove dirty entries from the list as they
  * are flushed. (this has been changed -- dirty entries are now removed from
  * the skip list as they are flushed.  JRM - 10/25/05)
@@ -3808,9 +3900,11 @@ typedef struct H5C_tag_info_t {
  *		slist by ring.  Note that the sum of all cells in this 
  *		array must equal the value stored in slist_size above.
  *
- * slist_ptr:   pointer to the instance of H5SL_t used maintain a sorted
- *              list of dirty entries in the cache.  This sorted list has
- *              two uses:
+ * slist_head:  Pointer to the head of the doubly linked list of dirty
+ *              entries in the cache, or NULL if the list is empty.
+ *              The list is threaded through the slist_next and 
+ *              slist_prev fields of the entries.  When sorted (see 
+ *		slist_sorted below), this list has two uses:
  *
  *              a) It allows us to flush dirty entries in increasing address
  *                 order, which results in significant savings.
@@ -3820,6 +3914,16 @@ typedef struct H5C_tag_info_t {
  *                 don't use this at present, I hope that this will allow
  *                 some optimizations when I get to it.
  *
+ * slist_tail:  Pointer to the tail of the slist, or NULL if the list 
+ *		is empty.  New entries are appended at the tail.
+ *
+ * slist_sorted: Boolean flag indicating whether the slist is known to
+ *		be in increasing address order.  The flag is cleared when
+ *		an entry is appended whose address is less than that of 
+ *		the entry at the tail, and set again by H5C__slist_first(),
+ *		which sorts the list if necessary.  Removing entries 
+ *		does not affect the flag.
+ *
  * num_last_entries: The number of entries in the cache that can only be
  *		flushed after all other entries in the cache have
  *              been flushed. At this time, this will only ever be
@@ -4337,6 +4441,42 @@ typedef struct H5C_tag_info_t {
  *		space managers.
  *
  *
+ * Write batch related fields:
+ *
+ * While a ring is being flushed, the images of the entries written are
+ * not handed to H5F_block_write() one at a time.  Instead, they are
+ * copied into a staging buffer for as long as each image starts at the
+ * address where the previous one ended, and the whole run is issued as
+ * a single write when it can't be extended any further.  Since an image
+ * is only ever appended to the end of the run, and the run is written
+ * out before any image that doesn't follow on from it is staged, the
+ * writes reach the file in exactly the order the flush generated them.
+ *
+ * The run is also written out before staging the image of an entry that
+ * is a flush dependency parent, so that the images of its children are
+ * in the file before its own is, before the cache reads an entry from
+ * the file, and before file space is freed.
+ *
+ * write_batch_enabled: Boolean flag indicating whether entry images
+ *		are to be staged in the write batch.  This field is set
+ *		by H5C_flush_ring() and H5C_flush_invalidate_ring() for
+ *		the duration of the flush.
+ *
+ * write_batch_type: Memory type of the first image in the current run.
+ *
+ * write_batch_addr: File address of the first image in the current run.
+ *
+ * write_batch_len: Number of bytes in the current run, or zero if no
+ *		images are staged.
+ *
+ * write_batch_buf: Staging buffer of H5C__WRITE_BATCH_MAX_SIZE bytes,
+ *		allocated the first time an image is staged.
+ *
+ * write_batch_writes: Number of writes issued for runs of staged images.
+ *
+ * write_batch_entries: Number of entry images staged in runs.
+ *
+ *
  * Statistics collection fields:
  *
  * When enabled, these fields are used to collect statistics as described
@@ -4483,6 +4623,15 @@ typedef struct H5C_tag_info_t {
  *              entries examined in unsuccessful searches of the hash
  *		table in the current epoch.
  *
+ * max_successful_ht_search_depth: Longest search depth seen in a
+ *		successful search of the hash table in the current epoch.
+ *
+ * max_failed_ht_search_depth: Longest search depth seen in an
+ *		unsuccessful search of the hash table in the current epoch.
+ *
+ * total_ht_resizes: Number of times the hash table bucket array has
+ *		been grown in the current epoch.
+ *
  * max_index_len:  Largest value attained by the index_len field in the
  *              current epoch.
  *
@@ -4673,7 +4822,9 @@ struct H5C_t {
     size_t			clean_index_ring_size[H5C_RING_NTYPES];
     size_t			dirty_index_size;
     size_t			dirty_index_ring_size[H5C_RING_NTYPES];
-    H5C_cache_entry_t *	        index[H5C__HASH_TABLE_LEN];
+    H5C_cache_entry_t **        index;
+    uint32_t                    index_nbuckets;
+    unsigned                    index_nbits;
     uint32_t                    il_len;
     size_t                      il_size;
     H5C_cache_entry_t *	        il_head;
@@ -4690,7 +4841,9 @@ struct H5C_t {
     size_t                      slist_size;
     uint32_t			slist_ring_len[H5C_RING_NTYPES];
     size_t			slist_ring_size[H5C_RING_NTYPES];
-    H5SL_t *                    slist_ptr;
+    H5C_cache_entry_t *         slist_head;
+    H5C_cache_entry_t *         slist_tail;
+    hbool_t                     slist_sorted;
     uint32_t                    num_last_entries;
 #if H5C_DO_SANITY_CHECKS
     int64_t			slist_len_increase;
@@ -4787,6 +4940,15 @@ struct H5C_t {
     hbool_t 			rdfsm_settled;
     hbool_t			mdfsm_settled;
 
+    /* Fields for coalescing entry writes during a flush */
+    hbool_t			write_batch_enabled;
+    H5FD_mem_t			write_batch_type;
+    haddr_t			write_batch_addr;
+    size_t			write_batch_len;
+    uint8_t *			write_batch_buf;
+    int64_t			write_batch_writes;
+    int64_t			write_batch_entries;
+
 #if H5C_COLLECT_CACHE_STATS
     /* stats fields */
     int64_t                     hits[H5C__MAX_NUM_TYPE_IDS + 1];
@@ -4820,6 +4982,9 @@ struct H5C_t {
     int64_t			total_successful_ht_search_depth;
     int64_t			failed_ht_searches;
     int64_t			total_failed_ht_search_depth;
+    int64_t			max_successful_ht_search_depth;
+    int64_t			max_failed_ht_search_depth;
+    int64_t			total_ht_resizes;
     uint32_t                    max_index_len;
     size_t                      max_index_size;
     size_t                      max_clean_index_size;
@@ -4895,6 +5060,8 @@ H5_DLL herr_t H5C__deserialize_prefetched_entry(H5F_t * f, hid_t dxpl_id,
     const H5C_class_t * type, haddr_t addr, void * udata);
 
 /* General routines */
+H5_DLL herr_t H5C__grow_index(H5C_t *cache_ptr);
+H5_DLL H5C_cache_entry_t *H5C__slist_first(H5C_t *cache_ptr);
 H5_DLL herr_t H5C__flush_single_entry(H5F_t *f, hid_t dxpl_id,
     H5C_cache_entry_t *entry_ptr, unsigned flags);
 H5_DLL herr_t H5C__generate_cache_image(H5F_t *f, hid_t dxpl_id, H5C_t *cache_ptr);
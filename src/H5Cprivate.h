@@ -80,10 +80,9 @@
 /* Upper and lower limits on cache size.  These limits are picked
  * out of a hat -- you should be able to change them as necessary.
  *
- * However, if you need a very big cache, you should also increase the
- * size of the hash table (H5C__HASH_TABLE_LEN in H5Cpkg.h).  The current
- * upper bound on cache size is rather large for the current hash table
- * size.
+ * The hash table index grows with the number of entries in the cache
+ * (see H5C__HASH_TABLE_MAX_LOAD in H5Cpkg.h), so it need not be resized
+ * by hand when these limits are changed.
  */
 #define H5C__MAX_MAX_CACHE_SIZE		((size_t)(128 * 1024 * 1024))
 #define H5C__MIN_MAX_CACHE_SIZE		((size_t)(1024))
@@ -1111,7 +1110,8 @@ typedef int H5C_ring_t;
  *
  *		   					JRM -- 3/16/06
  *
- * in_slist:	Boolean flag indicating whether the entry is in the skip list
+ * in_slist:	Boolean flag indicating whether the entry is in the slist
+ *		(the list of dirty entries -- see slist_next below).
  *		As a general rule, entries are placed in the list when they
  *              are marked dirty.  However they may remain in the list after
  *              being flushed.
@@ -1119,6 +1119,10 @@ typedef int H5C_ring_t;
  *              Update: Dirty entries are now removed from the skip list
  *			when they are flushed.
  *
+ *		Update: The slist is no longer a skip list, but a doubly
+ *			linked list threaded through the entries, which is
+ *			sorted by address when a flush scans it.
+ *
  * flush_marker:  Boolean flag indicating that the entry is to be flushed
  *		the next time H5C_flush_cache() is called with the
  *		H5C__FLUSH_MARKED_ENTRIES_FLAG.  The flag is reset when
@@ -1267,6 +1271,19 @@ typedef int H5C_ring_t;
  *		index list, or NULL if there is no previous entry.
  *
  *
+ * Fields supporting the slist:
+ *
+ * Dirty entries are kept on a doubly linked list (the slist), which the
+ * flush code sorts into increasing address order before scanning it.
+ * See the comments on the slist fields of H5C_t in H5Cpkg.h.
+ *
+ * slist_next:	Next pointer in the slist, or NULL if there is no next
+ *		entry or the entry is not in the slist.
+ *
+ * slist_prev:	Prev pointer in the slist, or NULL if there is no 
+ *		previous entry or the entry is not in the slist.
+ *
+ *
  * Fields supporting replacement policies:
  *
  * The cache must have a replacement policy, and it will usually be
@@ -1605,6 +1622,10 @@ typedef struct H5C_cache_entry_t {
     struct H5C_cache_entry_t   *il_next;
     struct H5C_cache_entry_t   *il_prev;
 
+    /* fields supporting the slist: */
+    struct H5C_cache_entry_t   *slist_next;
+    struct H5C_cache_entry_t   *slist_prev;
+
     /* fields supporting replacement policies: */
     struct H5C_cache_entry_t   *next;
     struct H5C_cache_entry_t   *prev;
@@ -2274,6 +2295,7 @@ H5_DLL herr_t H5C_cork(H5C_t *cache_ptr, haddr_t obj_addr, unsigned action, hboo
 H5_DLL herr_t H5C_get_entry_ring(const H5F_t *f, haddr_t addr, H5C_ring_t *ring);
 H5_DLL herr_t H5C_unsettle_entry_ring(void *thing);
 H5_DLL herr_t H5C_remove_entry(void *thing);
+H5_DLL herr_t H5C_flush_write_batch(H5F_t *f, hid_t dxpl_id);
 H5_DLL herr_t H5C_cache_image_status(H5F_t * f, hbool_t *load_ci_ptr, 
     hbool_t *write_ci_ptr);
 
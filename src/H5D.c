@@ -621,6 +621,142 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Dget_offset() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dget_chunk_info_by_coord
+ *
+ * Purpose:	Retrieves the filter mask, file address and stored size of
+ *		the chunk of a chunked dataset at logical offset OFFSET,
+ *		which must fall on a chunk boundary.  If the chunk hasn't
+ *		been written, ADDR is set to HADDR_UNDEF and SIZE to zero.
+ *		Any of the output arguments may be NULL.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dget_chunk_info_by_coord(hid_t dset_id, const hsize_t *offset, unsigned *filter_mask,
+    haddr_t *addr, hsize_t *size)
+{
+    H5D_t	*dset;                  /* Dataset to query */
+    herr_t	ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE5("e", "i*h*Iu*a*h", dset_id, offset, filter_mask, addr, size);
+
+    /* Check args */
+    if(NULL == (dset = (H5D_t *)H5I_object_verify(dset_id, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if(H5D_CHUNKED != dset->shared->layout.type)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
+    if(NULL == offset)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no chunk offset")
+
+    /* Get the chunk's information */
+    if(H5D__get_chunk_info_by_coord(dset, H5AC_ind_read_dxpl_id, offset, filter_mask, addr, size) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get chunk info")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dget_chunk_info_by_coord() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dget_chunk_info_by_range
+ *
+ * Purpose:	Retrieves the logical offsets, filter masks, file addresses
+ *		and stored sizes of the written chunks of a chunked dataset
+ *		that hold any of the COUNT elements from START, in order of
+ *		their file addresses.  The chunk index is searched once for
+ *		all the chunks.  OFFSETS holds the dataset's rank
+ *		coordinates for each chunk.  At most MAX_CHUNKS chunks are
+ *		returned and NCHUNKS is set to the number of chunks in the
+ *		range, so a call with MAX_CHUNKS of zero sizes the output
+ *		arrays.  Any of the output arrays may be NULL.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dget_chunk_info_by_range(hid_t dset_id, const hsize_t *start, const hsize_t *count,
+    size_t max_chunks, hsize_t *offsets, unsigned *filter_masks, haddr_t *addrs,
+    hsize_t *sizes, size_t *nchunks)
+{
+    H5D_t	*dset;                  /* Dataset to query */
+    herr_t	ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE9("e", "i*h*hz*h*Iu*a*h*z", dset_id, start, count, max_chunks, offsets,
+             filter_masks, addrs, sizes, nchunks);
+
+    /* Check args */
+    if(NULL == (dset = (H5D_t *)H5I_object_verify(dset_id, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if(H5D_CHUNKED != dset->shared->layout.type)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
+    if(NULL == start || NULL == count)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no range")
+    if(NULL == nchunks)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no chunk count")
+
+    /* Get the chunks' information */
+    if(H5D__get_chunk_info_by_range(dset, H5AC_ind_read_dxpl_id, start, count, max_chunks,
+            offsets, filter_masks, addrs, sizes, nchunks) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get chunk info")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dget_chunk_info_by_range() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dget_chunk_cache_stats
+ *
+ * Purpose:	Retrieves the hit, miss, bypass, creation, flush and resize
+ *		counts of a chunked dataset's raw data chunk cache since the
+ *		dataset was opened, and the cache's current size and use.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dget_chunk_cache_stats(hid_t dset_id, H5D_chunk_cache_stats_t *stats)
+{
+    H5D_t	*dset;                  /* Dataset to query */
+    const H5D_rdcc_t *rdcc;             /* Dataset's chunk cache */
+    herr_t	ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "i*x", dset_id, stats);
+
+    /* Check args */
+    if(NULL == (dset = (H5D_t *)H5I_object_verify(dset_id, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if(H5D_CHUNKED != dset->shared->layout.type)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
+    if(NULL == stats)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no statistics buffer")
+
+    /* Get the cache's statistics */
+    rdcc = &(dset->shared->cache.chunk);
+    stats->nhits = rdcc->stats.nhits;
+    stats->nmisses = rdcc->stats.nmisses;
+    stats->nbypasses = rdcc->stats.nbypasses;
+    stats->ninits = rdcc->stats.ninits;
+    stats->nflushes = rdcc->stats.nflushes;
+    stats->nresizes = rdcc->stats.nresizes;
+    stats->nbytes_max = rdcc->nbytes_max;
+    stats->nbytes_used = rdcc->nbytes_used;
+    stats->nslots = rdcc->nslots;
+    stats->nused = (size_t)rdcc->nused;
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dget_chunk_cache_stats() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Diterate
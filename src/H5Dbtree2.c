@@ -1351,6 +1351,7 @@ static herr_t
 H5D__bt2_idx_copy_setup(const H5D_chk_idx_info_t *idx_info_src,
     const H5D_chk_idx_info_t *idx_info_dst)
 {
+    hsize_t     nrec;                       /* Number of chunks to copy */
     herr_t      ret_value = SUCCEED;        /* Return value */
 
     FUNC_ENTER_STATIC
@@ -1383,6 +1384,13 @@ H5D__bt2_idx_copy_setup(const H5D_chk_idx_info_t *idx_info_src,
         HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize chunked storage")
     HDassert(H5F_addr_defined(idx_info_dst->storage->idx_addr));
 
+    /* The chunks are copied in key order, so build the destination v2 B-tree
+     * from them in bulk */
+    if(H5B2_get_nrec(idx_info_src->storage->u.btree2.bt2, &nrec) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get number of records in v2 B-tree")
+    if(H5B2_bulk_begin(idx_info_dst->storage->u.btree2.bt2, idx_info_dst->dxpl_id, nrec) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't start bulk load of v2 B-tree")
+
     /* Reset metadata tag */
     H5_END_TAG(FAIL);
 
@@ -1421,6 +1429,10 @@ H5D__bt2_idx_copy_shutdown(H5O_storage_chunk_t *storage_src,
         HGOTO_ERROR(H5E_DATASET, H5E_CANTCLOSEOBJ, FAIL, "unable to close v2 B-tree")
     storage_src->u.btree2.bt2 = NULL;
 
+    /* Finish loading the v2 B-tree for destination file */
+    if(H5B2_bulk_end(storage_dst->u.btree2.bt2, dxpl_id) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to finish bulk load of v2 B-tree")
+
     /* Close v2 B-tree for destination file */
     if(H5B2_close(storage_dst->u.btree2.bt2, dxpl_id) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTCLOSEOBJ, FAIL, "unable to close v2 B-tree")
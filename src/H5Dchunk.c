@@ -28,16 +28,19 @@
  *		contains code to optionally align chunks on disk block
  *		boundaries for performance.
  *
- *		The chunk cache is an extendible hash indexed by a function
- *		of storage B-tree address and chunk N-dimensional offset
- *		within the dataset.  Collisions are not resolved -- one of
- *		the two chunks competing for the hash slot must be preempted
- *		from the cache.  All entries in the hash also participate in
- *		a doubly-linked list and entries are penalized by moving them
- *		toward the front of the list.  When a new chunk is about to
- *		be added to the cache the heap is pruned by preempting
- *		entries near the front of the list to make room for the new
- *		entry which is added to the end of the list.
+ *		The chunk cache is a set-associative hash indexed by a
+ *		function of the chunk's N-dimensional offset within the
+ *		dataset.  The hash value selects a set of 'nways' slots and
+ *		the chunk may occupy any free slot in that set.  A chunk is
+ *		only preempted because of a collision when every slot in its
+ *		set is in use, in which case the victim is chosen from that
+ *		set using the same LRU/w0 policy as the rest of the cache.
+ *		All entries in the hash also participate in a doubly-linked
+ *		list and entries are penalized by moving them toward the
+ *		front of the list.  When a new chunk is about to be added to
+ *		the cache the heap is pruned by preempting entries near the
+ *		front of the list to make room for the new entry which is
+ *		added to the end of the list.
  */
 
 /****************/
@@ -108,6 +111,35 @@
 
 /*#define H5D_CHUNK_DEBUG */
 
+/* Whether a cache entry has been completely read and/or completely written,
+ * but not partially read or partially written.  Such entries are favored for
+ * preemption, according to the w0 setting of the cache.
+ */
+#define H5D_RDCC_ENT_FULLY_ACCESSED(ent, chunk_size)                          \
+    ((0 == (ent)->rd_count && 0 == (ent)->wr_count) ||                      \
+     (0 == (ent)->rd_count && (chunk_size) == (ent)->wr_count) ||           \
+     ((chunk_size) == (ent)->rd_count && 0 == (ent)->wr_count))
+
+/* Number of chunks per filter thread handled together by a batch of
+ * chunks read or written with H5D__chunk_read_pipeline/H5D__chunk_write_batch.
+ */
+#define H5D_CHUNK_BATCH_PER_THREAD 2
+
+/* Bytes of unfiltered chunks that H5D__chunk_read_pipeline reads ahead and
+ * hands to the filter threads at once, when that is more chunks than
+ * H5D_CHUNK_BATCH_PER_THREAD per thread.
+ */
+#define H5D_CHUNK_READAHEAD_SIZE (4 * 1024 * 1024)
+
+/* Minimum number of chunks a read must touch before their locations are
+ * looked up with a single pass over the chunk index instead of one query
+ * per chunk.  The selection must also cover at least 1 in
+ * H5D_CHUNK_ADDR_TABLE_DENSITY of the dataset's chunks, as the whole index
+ * is iterated over.
+ */
+#define H5D_CHUNK_ADDR_TABLE_MIN        32
+#define H5D_CHUNK_ADDR_TABLE_DENSITY    8
+
 /* Flags for the "edge_chunk_state" field below */
 #define H5D_RDCC_DISABLE_FILTERS 0x01u          /* Disable filters on this chunk */
 #define H5D_RDCC_NEWLY_DISABLED_FILTERS 0x02u   /* Filters have been disabled since
@@ -131,6 +163,7 @@ typedef struct H5D_rdcc_ent_t {
     hsize_t     chunk_idx;  	/*index of chunk in dataset             */
     uint8_t	*chunk;		/*the unfiltered chunk data		*/
     unsigned	idx;		/*index in hash table			*/
+    hsize_t	last_access;	/*value of cache's 'ticks' at last use	*/
     struct H5D_rdcc_ent_t *next;/*next item in doubly-linked list	*/
     struct H5D_rdcc_ent_t *prev;/*previous item in doubly-linked list	*/
     struct H5D_rdcc_ent_t *tmp_next;/*next item in temporary doubly-linked list */
@@ -138,6 +171,59 @@ typedef struct H5D_rdcc_ent_t {
 } H5D_rdcc_ent_t;
 typedef H5D_rdcc_ent_t *H5D_rdcc_ent_ptr_t; /* For free lists */
 
+/* Copy of the elements selected in a chunk to the application's buffer,
+ * done by the filter thread which unfiltered the chunk.
+ */
+typedef struct H5D_chunk_scatter_t {
+    void                *buf;           /* Application's buffer */
+    H5S_strided_t       file_layout;    /* Chunk's selection within the chunk */
+    H5S_strided_t       mem_layout;     /* Chunk's selection in the buffer */
+    size_t              nbytes;         /* Bytes selected */
+} H5D_chunk_scatter_t;
+
+/* Chunk whose data is run through the filter pipeline together with other
+ * chunks of the same I/O operation, on the filter threads of the DXPL.
+ */
+typedef struct H5D_chunk_batch_ent_t {
+    H5D_chunk_info_t    *chunk_info;    /* Chunk information from the chunk map */
+    H5D_chunk_ud_t      udata;          /* Chunk index pass-through */
+    void                *chunk;         /* Chunk buffer, or NULL if chunk isn't in the batch */
+    size_t              nbytes;         /* Bytes of data in chunk buffer */
+    size_t              buf_size;       /* Allocated size of chunk buffer */
+    H5D_chunk_scatter_t *scatter;       /* Copy to do once the chunk is unfiltered, or NULL */
+    hbool_t             done;           /* Whether the chunk was read by H5D__chunk_read_pipeline */
+} H5D_chunk_batch_ent_t;
+
+/* Entry for one chunk in a batched direct chunk write */
+typedef struct H5D_chunk_direct_ent_t {
+    hsize_t             scaled[H5O_LAYOUT_NDIMS];       /* Scaled coordinates of chunk */
+    unsigned            ndims;          /* Number of dimensions in scaled coordinates */
+    size_t              idx;            /* Index of chunk in caller's arrays */
+    H5D_chunk_ud_t      udata;          /* Chunk index pass-through */
+    hbool_t             need_alloc;     /* Whether the chunk needs new file space */
+} H5D_chunk_direct_ent_t;
+
+/* Location of one stored chunk, in an address table */
+typedef struct H5D_chunk_addr_t {
+    hsize_t             chunk_index;    /* Linear index of chunk in dataset */
+    haddr_t             addr;           /* Address of chunk in file */
+    uint32_t            nbytes;         /* Size of stored chunk */
+    unsigned            filter_mask;    /* Excluded filters */
+} H5D_chunk_addr_t;
+
+/* Locations of the stored chunks within a range of chunks, sorted by
+ * their linear indices, from a single pass over the chunk index */
+typedef struct H5D_chunk_addr_table_t {
+    unsigned            ndims;          /* Number of dimensions in scaled coordinates */
+    hsize_t             start[H5O_LAYOUT_NDIMS];        /* Scaled coordinates of first chunk in range */
+    hsize_t             end[H5O_LAYOUT_NDIMS];          /* Scaled coordinates of last chunk in range */
+    const hsize_t       *down_chunks;   /* "Down" size of chunk dimensions */
+    size_t              nused;          /* Number of chunks in table */
+    size_t              nalloc;         /* Number of entries allocated */
+    H5D_chunk_addr_t    *addrs;         /* Array of chunk locations */
+    unsigned            nflushes;       /* Chunk cache flush count when table was built */
+} H5D_chunk_addr_table_t;
+
 /* Callback info for iteration to prune chunks */
 typedef struct H5D_chunk_it_ud1_t {
     H5D_chunk_common_ud_t common;       /* Common info for B-tree user data (must be first) */
@@ -283,23 +369,58 @@ static herr_t H5D__chunk_file_cb(void *elem, const H5T_t *type, unsigned ndims,
 static herr_t H5D__chunk_mem_cb(void *elem, const H5T_t *type, unsigned ndims,
     const hsize_t *coords, void *fm);
 static unsigned H5D__chunk_hash_val(const H5D_shared_t *shared, const hsize_t *scaled);
+static unsigned H5D__chunk_cache_find_slot(const H5D_rdcc_t *rdcc, unsigned set,
+    size_t chunk_size);
 static herr_t H5D__chunk_flush_entry(const H5D_t *dset, hid_t dxpl_id,
     const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *ent, hbool_t reset);
+static int H5D__chunk_addr_table_cb(const H5D_chunk_rec_t *chunk_rec, void *_table);
+static int H5D__chunk_addr_index_cmp(const void *_addr1, const void *_addr2);
+static int H5D__chunk_addr_addr_cmp(const void *_addr1, const void *_addr2);
+static herr_t H5D__chunk_addr_table_build(const H5D_t *dset, hid_t dxpl_id,
+    const hsize_t *start, const hsize_t *end, H5D_chunk_addr_table_t *table);
+static void H5D__chunk_addr_table_find(const H5D_t *dset,
+    const H5D_chunk_addr_table_t *table, const hsize_t *scaled, H5D_chunk_ud_t *udata);
+static herr_t H5D__chunk_lookup_table(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_chunk_addr_table_t *table, const hsize_t *scaled, H5D_chunk_ud_t *udata);
 static herr_t H5D__chunk_cache_evict(const H5D_t *dset, hid_t dxpl_id,
     const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *ent, hbool_t flush);
+static int H5D__chunk_wb_cmp(const void *_scaled1, const void *_scaled2);
+static herr_t H5D__chunk_wb_queue(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *ent);
+static herr_t H5D__chunk_wb_drain(const H5D_t *dset, hid_t dxpl_id);
 static hbool_t H5D__chunk_is_partial_edge_chunk(unsigned dset_ndims,
     const uint32_t *chunk_dims, const hsize_t *chunk_scaled, const hsize_t *dset_dims);
 static void *H5D__chunk_lock(const H5D_io_info_t *io_info,
-    H5D_chunk_ud_t *udata, hbool_t relax, hbool_t prev_unfilt_chunk);
+    H5D_chunk_ud_t *udata, hbool_t relax, hbool_t prev_unfilt_chunk,
+    void *chunk_buf);
 static herr_t H5D__chunk_unlock(const H5D_io_info_t *io_info,
     const H5D_chunk_ud_t *udata, hbool_t dirty, void *chunk,
     uint32_t naccessed);
+static hbool_t H5D__chunk_batch_eligible(const H5D_io_info_t *io_info,
+    const H5D_chunk_ud_t *udata);
+static herr_t H5D__chunk_filter_batch(const H5D_io_info_t *io_info,
+    H5D_chunk_batch_ent_t *batch, size_t nents, unsigned flags);
+static herr_t H5D__chunk_scatter_op(const void *chunk, size_t nbytes, void *_scatter);
+static herr_t H5D__chunk_read_pipeline(H5D_io_info_t *io_info,
+    const H5D_type_info_t *type_info, H5D_io_info_t *cpt_io_info,
+    H5D_chunk_batch_ent_t *ents, size_t nents, size_t window_max);
+static herr_t H5D__chunk_write_batch(const H5D_io_info_t *io_info,
+    H5D_chunk_batch_ent_t *batch, size_t nents);
+static void H5D__chunk_free_batch(const H5D_io_info_t *io_info,
+    H5D_chunk_batch_ent_t *batch, size_t nents);
+static int H5D__chunk_batch_addr_cmp(const void *_ent1, const void *_ent2);
 static herr_t H5D__chunk_cache_prune(const H5D_t *dset, hid_t dxpl_id,
     const H5D_dxpl_cache_t *dxpl_cache, size_t size);
+static herr_t H5D__chunk_cache_auto_resize(const H5D_io_info_t *io_info);
 static herr_t H5D__chunk_prune_fill(H5D_chunk_it_ud1_t *udata, hbool_t new_unfilt_chunk);
 static herr_t H5D__chunk_file_alloc(const H5D_chk_idx_info_t *idx_info,
     const H5F_block_t *old_chunk, H5F_block_t *new_chunk, hbool_t *need_insert,
     hsize_t scaled[]);
+static herr_t H5D__chunk_check_size_len(const H5D_chk_idx_info_t *idx_info,
+    hsize_t length);
+static int H5D__chunk_direct_ent_cmp(const void *_ent1, const void *_ent2);
+static herr_t H5D__chunk_lookup_stored(const H5D_t *dset, hid_t dxpl_id,
+    const hsize_t *scaled, H5D_chunk_ud_t *udata);
 #ifdef H5_HAVE_PARALLEL
 static herr_t H5D__chunk_collective_fill(const H5D_t *dset, hid_t dxpl_id,
     H5D_chunk_coll_info_t *chunk_info, size_t chunk_size, const void *fill_buf);
@@ -491,245 +612,959 @@ done:
     FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
 } /* end H5D__chunk_direct_write() */
 
-
+
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_set_info_real
- *
- * Purpose:	Internal routine to set the information about chunks for a dataset
+ * Function:	H5D__chunk_direct_ent_cmp
  *
- * Return:	Non-negative on success/Negative on failure
+ * Purpose:	Compare two batched direct write entries by the scaled
+ *              coordinates of their chunks, for qsort().
  *
- * Programmer:	Quincey Koziol
- *              Tuesday, June 30, 2009
+ * Return:	<0, 0, >0 as for strcmp()
  *
  *-------------------------------------------------------------------------
  */
-static herr_t
-H5D__chunk_set_info_real(H5O_layout_chunk_t *layout, unsigned ndims,
-    const hsize_t *curr_dims, const hsize_t *max_dims)
+static int
+H5D__chunk_direct_ent_cmp(const void *_ent1, const void *_ent2)
 {
-    unsigned u;                 /* Local index variable */
-    herr_t ret_value = SUCCEED; /* Return value */
-
-    FUNC_ENTER_STATIC
-
-    /* Sanity checks */
-    HDassert(layout);
-    HDassert(ndims > 0);
-    HDassert(curr_dims);
+    const H5D_chunk_direct_ent_t *ent1 = (const H5D_chunk_direct_ent_t *)_ent1;
+    const H5D_chunk_direct_ent_t *ent2 = (const H5D_chunk_direct_ent_t *)_ent2;
+    unsigned u;                         /* Local index variable */
+    int ret_value = 0;                  /* Return value */
 
-    /* Compute the # of chunks in dataset dimensions */
-    for(u = 0, layout->nchunks = 1, layout->max_nchunks = 1; u < ndims; u++) {
-        /* Round up to the next integer # of chunks, to accomodate partial chunks */
-	layout->chunks[u] = ((curr_dims[u] + layout->dim[u]) - 1) / layout->dim[u];
-        if(H5S_UNLIMITED == max_dims[u])
-            layout->max_chunks[u] = H5S_UNLIMITED;
-        else
-            layout->max_chunks[u] = ((max_dims[u] + layout->dim[u]) - 1) / layout->dim[u];
+    FUNC_ENTER_STATIC_NOERR
 
-        /* Accumulate the # of chunks */
-	layout->nchunks *= layout->chunks[u];
-	layout->max_nchunks *= layout->max_chunks[u];
-    } /* end for */
+    HDassert(ent1->ndims == ent2->ndims);
 
-    /* Get the "down" sizes for each dimension */
-    if(H5VM_array_down(ndims, layout->chunks, layout->down_chunks) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "can't compute 'down' chunk size value")
-    if(H5VM_array_down(ndims, layout->max_chunks, layout->max_down_chunks) < 0)
-	HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "can't compute 'down' chunk size value")
+    for(u = 0; u < ent1->ndims; u++)
+        if(ent1->scaled[u] != ent2->scaled[u]) {
+            ret_value = (ent1->scaled[u] < ent2->scaled[u]) ? -1 : 1;
+            break;
+        } /* end if */
 
-done:
     FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5D__chunk_set_info_real() */
+} /* end H5D__chunk_direct_ent_cmp() */
+
 
-
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_set_info
+ * Function:	H5D__chunk_direct_write_multi
  *
- * Purpose:	Sets the information about chunks for a dataset
+ * Purpose:	Internal routine to write several chunks directly into the
+ *              file.  The chunks are looked up in index order, file space
+ *              for all the new (or resized) chunks is allocated as one
+ *              extent, the data is written with a single vector write and
+ *              the new chunks are then inserted into the index.
  *
- * Return:	Non-negative on success/Negative on failure
+ *              OFFSETS[U] is the logical offset of chunk U and must fall on
+ *              a chunk boundary.  A chunk may appear only once in a batch.
  *
- * Programmer:	Quincey Koziol
- *              Tuesday, June 30, 2009
+ * Return:	Non-negative on success/Negative on failure
  *
  *-------------------------------------------------------------------------
  */
 herr_t
-H5D__chunk_set_info(const H5D_t *dset)
+H5D__chunk_direct_write_multi(const H5D_t *dset, hid_t dxpl_id, size_t nchunks,
+    const uint32_t filters[], const hsize_t *offsets[], const size_t data_sizes[],
+    const void *bufs[])
 {
+    const H5O_layout_t *layout = &(dset->shared->layout);       /* Dataset layout */
+    const H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);	/* Raw data chunk cache */
+    H5D_chunk_direct_ent_t *ents = NULL;        /* Per-chunk information */
+    H5FD_mem_t *types = NULL;           /* Memory types for vector write */
+    haddr_t *addrs = NULL;              /* File addresses for vector write */
+    size_t *sizes = NULL;               /* Sizes for vector write */
+    const void **vbufs = NULL;          /* Buffers for vector write */
+    H5D_chk_idx_info_t idx_info;        /* Chunked index info */
+    H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
+    H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
+    hbool_t dxpl_cache_filled = FALSE;  /* Whether the DXPL cache has been filled */
+    H5D_io_info_t io_info;              /* to hold the dset and two dxpls (meta and raw data) */
+    hbool_t md_dxpl_generated = FALSE;  /* bool to indicate whether we should free the md_dxpl_id at exit */
+    hsize_t alloc_size = 0;             /* Size of extent for new chunks */
+    haddr_t alloc_addr = HADDR_UNDEF;   /* Address of extent for new chunks */
+    size_t u;                           /* Local index variable */
     herr_t ret_value = SUCCEED;         /* Return value */
 
-    FUNC_ENTER_PACKAGE
+    FUNC_ENTER_PACKAGE_TAG(dxpl_id, dset->oloc.addr, FAIL)
 
-    /* Sanity checks */
-    HDassert(dset);
+    HDassert(nchunks > 0);
+    HDassert(filters && offsets && data_sizes && bufs);
 
-    /* Set the base layout information */
-    if(H5D__chunk_set_info_real(&dset->shared->layout.u.chunk, dset->shared->ndims, dset->shared->curr_dims, dset->shared->max_dims) < 0)
-	HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "can't set layout's chunk info")
+    io_info.dset = dset;
+    io_info.raw_dxpl_id = dxpl_id;
+    io_info.md_dxpl_id = dxpl_id;
 
-    /* Call the index's "resize" callback */
-    if(dset->shared->layout.storage.u.chunk.ops->resize && (dset->shared->layout.storage.u.chunk.ops->resize)(&dset->shared->layout.u.chunk) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "unable to resize chunk index information")
+    /* set the dxpl IO type for sanity checking at the FD layer */
+#ifdef H5_DEBUG_BUILD
+    if(H5D_set_io_info_dxpls(&io_info, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "can't set metadata and raw data dxpls")
+    md_dxpl_generated = TRUE;
+#endif /* H5_DEBUG_BUILD */
 
-done:
-    FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5D__chunk_set_info() */
+    /* Allocate the per-chunk information and the vector write arrays */
+    if(NULL == (ents = (H5D_chunk_direct_ent_t *)H5MM_malloc(nchunks * sizeof(H5D_chunk_direct_ent_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk information")
+    if(NULL == (types = (H5FD_mem_t *)H5MM_malloc(nchunks * sizeof(H5FD_mem_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for memory types")
+    if(NULL == (addrs = (haddr_t *)H5MM_malloc(nchunks * sizeof(haddr_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for addresses")
+    if(NULL == (sizes = (size_t *)H5MM_malloc(nchunks * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for sizes")
+    if(NULL == (vbufs = (const void **)H5MM_malloc(nchunks * sizeof(void *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for buffers")
 
-
-/*-------------------------------------------------------------------------
- * Function:	H5D__chunk_set_sizes
- *
- * Purpose:     Sets chunk and type sizes.
- *
- * Return:      SUCCEED/FAIL
- *
- * Programmer:	Dana Robinson
- *              December 2015
- *
- *-------------------------------------------------------------------------
- */
-herr_t
-H5D__chunk_set_sizes(H5D_t *dset)
-{
-    uint64_t chunk_size;            /* Size of chunk in bytes */
-    unsigned max_enc_bytes_per_dim; /* Max. number of bytes required to encode this dimension */
-    unsigned u;                     /* Iterator */
-    herr_t ret_value = SUCCEED;     /* Return value */
+    /* Compose chunked index info struct */
+    idx_info.f = dset->oloc.file;
+    idx_info.dxpl_id = io_info.md_dxpl_id;
+    idx_info.pline = &(dset->shared->dcpl_cache.pline);
+    idx_info.layout = &(dset->shared->layout.u.chunk);
+    idx_info.storage = &(dset->shared->layout.storage.u.chunk);
 
-    FUNC_ENTER_NOAPI(FAIL)
+    /* Check the chunk sizes and compute the chunks' scaled coordinates */
+    for(u = 0; u < nchunks; u++) {
+        HDassert(offsets[u]);
+        HDassert(bufs[u]);
 
-    /* Sanity checks */
-    HDassert(dset);
+        if(0 == data_sizes[u])
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "chunk size is zero")
+#if H5_SIZEOF_SIZE_T > 4
+        if(data_sizes[u] > ((size_t)0xffffffff))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADRANGE, FAIL, "chunk too large for 32-bit length")
+#endif /* H5_SIZEOF_SIZE_T > 4 */
+        if(idx_info.pline->nused > 0) {
+            if(H5D__chunk_check_size_len(&idx_info, (hsize_t)data_sizes[u]) < 0)
+                HGOTO_ERROR(H5E_ARGS, H5E_BADRANGE, FAIL, "invalid chunk size")
+        } /* end if */
+        else if(data_sizes[u] != layout->u.chunk.size)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "size of unfiltered chunk doesn't match dataset's chunk size")
 
-    /* Increment # of chunk dimensions, to account for datatype size as last element */
-    dset->shared->layout.u.chunk.ndims++;
+        H5VM_chunk_scaled(dset->shared->ndims, offsets[u], layout->u.chunk.dim, ents[u].scaled);
+        ents[u].scaled[dset->shared->ndims] = 0;
+        ents[u].ndims = dset->shared->ndims;
+        ents[u].idx = u;
+    } /* end for */
 
-    /* Set the last dimension of the chunk size to the size of the datatype */
-    dset->shared->layout.u.chunk.dim[dset->shared->layout.u.chunk.ndims - 1] = (uint32_t)H5T_GET_SIZE(dset->shared->type);
+    /* Sort the chunks into index order, which also brings duplicates together */
+    if(nchunks > 1) {
+        HDqsort(ents, nchunks, sizeof(H5D_chunk_direct_ent_t), H5D__chunk_direct_ent_cmp);
+        for(u = 1; u < nchunks; u++)
+            if(0 == H5D__chunk_direct_ent_cmp(&ents[u - 1], &ents[u]))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "chunk written more than once in batch")
+    } /* end if */
 
-    /* Compute number of bytes to use for encoding chunk dimensions */
-    max_enc_bytes_per_dim = 0;
-    for(u = 0; u < (unsigned)dset->shared->layout.u.chunk.ndims; u++) {
-        unsigned enc_bytes_per_dim;     /* Number of bytes required to encode this dimension */
+    /* Allocate dataspace and initialize it if it hasn't been. */
+    if(!(*layout->ops->is_space_alloc)(&layout->storage)) {
+ 	/* Allocate storage */
+        if(H5D__alloc_storage(&io_info, H5D_ALLOC_WRITE, FALSE, NULL) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize storage")
+    } /* end if */
 
-        /* Get encoded size of dim, in bytes */
-        enc_bytes_per_dim = (H5VM_log2_gen(dset->shared->layout.u.chunk.dim[u]) + 8) / 8;
+    /* Look up the chunks, release the space of chunks that are changing size
+     * and add up the space needed for new chunks */
+    for(u = 0; u < nchunks; u++) {
+        H5D_chunk_direct_ent_t *ent = &ents[u];         /* Chunk's entry */
 
-        /* Check if this is the largest value so far */
-        if(enc_bytes_per_dim > max_enc_bytes_per_dim)
-            max_enc_bytes_per_dim = enc_bytes_per_dim;
+        /* Find out the file address of the chunk (if any) */
+        if(H5D__chunk_lookup(dset, io_info.md_dxpl_id, ent->scaled, &ent->udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+
+        /* Sanity check */
+        HDassert((H5F_addr_defined(ent->udata.chunk_block.offset) && ent->udata.chunk_block.length > 0) || 
+                (!H5F_addr_defined(ent->udata.chunk_block.offset) && ent->udata.chunk_block.length == 0));
+
+        /* Evict the (old) entry from the cache if present, but do not flush
+         * it to disk */
+        if(UINT_MAX != ent->udata.idx_hint) {
+            if(!dxpl_cache_filled) {
+                /* Fill the DXPL cache values for later use */
+                if(H5D__get_dxpl_cache(io_info.raw_dxpl_id, &dxpl_cache) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
+                dxpl_cache_filled = TRUE;
+            } /* end if */
+
+            if(H5D__chunk_cache_evict(dset, io_info.md_dxpl_id, dxpl_cache, rdcc->slot[ent->udata.idx_hint], FALSE) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTREMOVE, FAIL, "unable to evict chunk")
+        } /* end if */
+
+        /* Existing chunks of the same size are overwritten in place */
+        if(H5F_addr_defined(ent->udata.chunk_block.offset) && ent->udata.chunk_block.length == (hsize_t)data_sizes[ent->idx])
+            ent->need_alloc = FALSE;
+        else {
+            /* Chunks with implicit addresses can't move */
+            HDassert(idx_info.storage->idx_type != H5D_CHUNK_IDX_NONE);
+
+            /* Release the previous chunk */
+            /* Only free the old location if not doing SWMR writes - otherwise
+             * we must keep the old chunk around in case a reader has an
+             * outdated version of the B-tree node
+             */
+            if(H5F_addr_defined(ent->udata.chunk_block.offset) && !(H5F_INTENT(dset->oloc.file) & H5F_ACC_SWMR_WRITE))
+                if(H5MF_xfree(dset->oloc.file, H5FD_MEM_DRAW, io_info.md_dxpl_id, ent->udata.chunk_block.offset, ent->udata.chunk_block.length) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to free chunk")
+
+            ent->udata.chunk_block.offset = HADDR_UNDEF;
+            ent->udata.chunk_block.length = (hsize_t)data_sizes[ent->idx];
+            ent->need_alloc = TRUE;
+            alloc_size += (hsize_t)data_sizes[ent->idx];
+        } /* end else */
     } /* end for */
-    HDassert(max_enc_bytes_per_dim > 0 && max_enc_bytes_per_dim <= 8);
-    dset->shared->layout.u.chunk.enc_bytes_per_dim = max_enc_bytes_per_dim;
 
-    /* Compute and store the total size of a chunk */
-    /* (Use 64-bit value to ensure that we can detect >4GB chunks) */
-    for(u = 1, chunk_size = (uint64_t)dset->shared->layout.u.chunk.dim[0]; u < dset->shared->layout.u.chunk.ndims; u++)
-        chunk_size *= (uint64_t)dset->shared->layout.u.chunk.dim[u];
+    /* Allocate one extent for all the new chunks */
+    if(alloc_size > 0)
+        if(HADDR_UNDEF == (alloc_addr = H5MF_alloc(dset->oloc.file, H5FD_MEM_DRAW, io_info.md_dxpl_id, alloc_size)))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "file allocation failed")
 
-    /* Check for chunk larger than can be represented in 32-bits */
-    /* (Chunk size is encoded in 32-bit value in v1 B-tree records) */
-    if(chunk_size > (uint64_t)0xffffffff)
-        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "chunk size must be < 4GB")
+    /* Assign the new chunks their place in the extent and set up the write */
+    for(u = 0; u < nchunks; u++) {
+        H5D_chunk_direct_ent_t *ent = &ents[u];         /* Chunk's entry */
 
-    H5_CHECKED_ASSIGN(dset->shared->layout.u.chunk.size, uint32_t, chunk_size, uint64_t);
+        if(ent->need_alloc) {
+            ent->udata.chunk_block.offset = alloc_addr;
+            alloc_addr += ent->udata.chunk_block.length;
+        } /* end if */
+
+        types[u] = H5FD_MEM_DRAW;
+        addrs[u] = ent->udata.chunk_block.offset;
+        sizes[u] = data_sizes[ent->idx];
+        vbufs[u] = bufs[ent->idx];
+    } /* end for */
+
+    /* Write the data to the file */
+    if(H5F_block_write_vector(dset->oloc.file, nchunks, types, addrs, sizes, io_info.raw_dxpl_id, vbufs) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
+
+    /* Insert the chunk records into the index */
+    for(u = 0; u < nchunks; u++) {
+        H5D_chunk_direct_ent_t *ent = &ents[u];         /* Chunk's entry */
+
+        /* Set the chunk's filter mask to the new settings */
+        ent->udata.filter_mask = filters[ent->idx];
+
+        /* (Chunks overwritten in place with a new filter mask need their
+         *  index record updated too) */
+        if(layout->storage.u.chunk.ops->insert)
+            if(ent->need_alloc || idx_info.pline->nused > 0)
+                if((layout->storage.u.chunk.ops->insert)(&idx_info, &ent->udata, NULL) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
+
+        /* Cache the chunk's info, in case it's accessed again shortly */
+        H5D__chunk_cinfo_cache_update(&dset->shared->cache.chunk.last, &ent->udata);
+    } /* end for */
 
 done:
-    FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5D__chunk_set_sizes */
+    if(ents)
+        H5MM_xfree(ents);
+    if(types)
+        H5MM_xfree(types);
+    if(addrs)
+        H5MM_xfree(addrs);
+    if(sizes)
+        H5MM_xfree(sizes);
+    if(vbufs)
+        H5MM_xfree(vbufs);
+#ifdef H5_DEBUG_BUILD
+    if(md_dxpl_generated && H5I_dec_ref(io_info.md_dxpl_id) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTDEC, FAIL, "can't close metadata dxpl")
+#endif /* H5_DEBUG_BUILD */
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__chunk_direct_write_multi() */
+
 
-
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_construct
+ * Function:	H5D__chunk_check_offset
  *
- * Purpose:	Constructs new chunked layout information for dataset
+ * Purpose:	Check that the logical offset of a chunk passed in by the
+ *              application is within the dataset and falls on a chunk
+ *              boundary.
  *
  * Return:	Non-negative on success/Negative on failure
  *
- * Programmer:	Quincey Koziol
- *              Thursday, May 22, 2008
- *
  *-------------------------------------------------------------------------
  */
-static herr_t
-H5D__chunk_construct(H5F_t H5_ATTR_UNUSED *f, H5D_t *dset)
+herr_t
+H5D__chunk_check_offset(const H5D_t *dset, const hsize_t *offset)
 {
-    unsigned u;                 /* Local index variable */
-    herr_t ret_value = SUCCEED; /* Return value */
+    unsigned u;                         /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
 
-    FUNC_ENTER_STATIC
+    FUNC_ENTER_PACKAGE
 
-    /* Sanity checks */
-    HDassert(f);
     HDassert(dset);
+    HDassert(H5D_CHUNKED == dset->shared->layout.type);
 
-    /* Check for invalid chunk dimension rank */
-    if(0 == dset->shared->layout.u.chunk.ndims)
-        HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "no chunk information set?")
-    if(dset->shared->layout.u.chunk.ndims != dset->shared->ndims)
-        HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "dimensionality of chunks doesn't match the dataspace")
-
-    /* Set chunk sizes */
-    if(H5D__chunk_set_sizes(dset) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "unable to set chunk sizes")
-    HDassert((unsigned)(dset->shared->layout.u.chunk.ndims) <= NELMTS(dset->shared->layout.u.chunk.dim));
-
-    /* Chunked storage is not compatible with external storage (currently) */
-    if(dset->shared->dcpl_cache.efl.nused > 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "external storage not supported with chunked layout")
+    if(NULL == offset)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no chunk offset")
 
-    /* Sanity check dimensions */
-    for(u = 0; u < dset->shared->layout.u.chunk.ndims - 1; u++) {
-        /* Don't allow zero-sized chunk dimensions */
-        if(0 == dset->shared->layout.u.chunk.dim[u])
-            HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "chunk size must be > 0, dim = %u ", u)
+    for(u = 0; u < dset->shared->ndims; u++) {
+        /* Make sure the offset doesn't exceed the dataset's dimensions */
+        if(offset[u] > dset->shared->curr_dims[u])
+            HGOTO_ERROR(H5E_DATASPACE, H5E_BADTYPE, FAIL, "offset exceeds dimensions of dataset")
 
-        /*
-         * The chunk size of a dimension with a fixed size cannot exceed
-         * the maximum dimension size. If any dimension size is zero, there
-         * will be no such restriction.
-         */
-        if(dset->shared->curr_dims[u] && dset->shared->max_dims[u] != H5S_UNLIMITED && dset->shared->max_dims[u] < dset->shared->layout.u.chunk.dim[u])
-            HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "chunk size must be <= maximum dimension size for fixed-sized dimensions")
+        /* Make sure the offset fall right on a chunk's boundary */
+        if(offset[u] % dset->shared->layout.u.chunk.dim[u])
+            HGOTO_ERROR(H5E_DATASPACE, H5E_BADTYPE, FAIL, "offset doesn't fall on chunks's boundary")
     } /* end for */
 
-    /* Reset address and pointer of the array struct for the chunked storage index */
-    if(H5D_chunk_idx_reset(&dset->shared->layout.storage.u.chunk, TRUE) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to reset chunked storage index")
-
 done:
     FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5D__chunk_construct() */
+} /* end H5D__chunk_check_offset() */
+
 
-
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_init
+ * Function:	H5D__chunk_lookup_stored
  *
- * Purpose:	Initialize the raw data chunk cache for a dataset.  This is
- *		called when the dataset is initialized.
+ * Purpose:	Look up the address, size and filter mask of a chunk as it
+ *              is stored in the file.  If the chunk is dirty in the chunk
+ *              cache it is flushed first (but stays cached), so that the
+ *              file holds its current contents.
  *
  * Return:	Non-negative on success/Negative on failure
  *
- * Programmer:	Robb Matzke
- *              Monday, May 18, 1998
- *
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5D__chunk_init(H5F_t *f, hid_t dxpl_id, const H5D_t *dset, hid_t dapl_id)
+H5D__chunk_lookup_stored(const H5D_t *dset, hid_t dxpl_id, const hsize_t *scaled,
+    H5D_chunk_ud_t *udata)
 {
-    H5D_chk_idx_info_t idx_info;        /* Chunked index info */
-    H5D_rdcc_t	*rdcc = &(dset->shared->cache.chunk);   /* Convenience pointer to dataset's chunk cache */
-    H5P_genplist_t *dapl;               /* Data access property list object pointer */
-    H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
-    herr_t      ret_value = SUCCEED;    /* Return value */
+    herr_t ret_value = SUCCEED;         /* Return value */
 
     FUNC_ENTER_STATIC
 
-    /* Sanity check */
-    HDassert(f);
+    HDassert(dset);
+    HDassert(scaled);
+    HDassert(udata);
+
+    /* Find out the file address of the chunk (if any) */
+    if(H5D__chunk_lookup(dset, dxpl_id, scaled, udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+
+    /* Chunks in the cache don't carry their filter mask, so go to the index */
+    if(UINT_MAX != udata->idx_hint) {
+        H5D_rdcc_ent_t *ent = dset->shared->cache.chunk.slot[udata->idx_hint];
+        H5D_chk_idx_info_t idx_info;    /* Chunked index info */
+
+        /* Write out the chunk's current contents */
+        if(ent->dirty) {
+            H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
+            H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
+
+            if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
+            if(H5D__chunk_flush_entry(dset, dxpl_id, dxpl_cache, ent, FALSE) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
+        } /* end if */
+
+        /* Compose chunked index info struct */
+        idx_info.f = dset->oloc.file;
+        idx_info.dxpl_id = dxpl_id;
+        idx_info.pline = &dset->shared->dcpl_cache.pline;
+        idx_info.layout = &dset->shared->layout.u.chunk;
+        idx_info.storage = &dset->shared->layout.storage.u.chunk;
+
+        udata->chunk_block.offset = HADDR_UNDEF;
+        udata->chunk_block.length = 0;
+        udata->filter_mask = 0;
+        if((dset->shared->layout.storage.u.chunk.ops->get_addr)(&idx_info, udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't query chunk address")
+    } /* end if */
+
+    /* Sanity check */
+    HDassert((H5F_addr_defined(udata->chunk_block.offset) && udata->chunk_block.length > 0) || 
+            (!H5F_addr_defined(udata->chunk_block.offset) && udata->chunk_block.length == 0));
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_lookup_stored() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_direct_read
+ *
+ * Purpose:	Internal routine to read a chunk's stored (filtered) bytes
+ *              directly from the file, without going through the chunk
+ *              cache or the filter pipeline.  BUF must be large enough
+ *              for the stored chunk.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_direct_read(const H5D_t *dset, hid_t dxpl_id, const hsize_t *offset,
+    uint32_t *filters, void *buf)
+{
+    H5D_chunk_ud_t udata;               /* User data for querying chunk info */
+    hsize_t scaled[H5O_LAYOUT_NDIMS];   /* Scaled coordinates for this chunk */
+    H5D_io_info_t io_info;              /* to hold the dset and two dxpls (meta and raw data) */
+    hbool_t md_dxpl_generated = FALSE;  /* bool to indicate whether we should free the md_dxpl_id at exit */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE_TAG(dxpl_id, dset->oloc.addr, FAIL)
+
+    HDassert(offset);
+    HDassert(filters);
+    HDassert(buf);
+
+    io_info.dset = dset;
+    io_info.raw_dxpl_id = dxpl_id;
+    io_info.md_dxpl_id = dxpl_id;
+
+    /* set the dxpl IO type for sanity checking at the FD layer */
+#ifdef H5_DEBUG_BUILD
+    if(H5D_set_io_info_dxpls(&io_info, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "can't set metadata and raw data dxpls")
+    md_dxpl_generated = TRUE;
+#endif /* H5_DEBUG_BUILD */
+
+    /* Make sure the dataset's storage has been allocated */
+    if(!(*dset->shared->layout.ops->is_space_alloc)(&dset->shared->layout.storage))
+        HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "chunk address isn't defined")
+
+    /* Calculate the index of this chunk */
+    H5VM_chunk_scaled(dset->shared->ndims, offset, dset->shared->layout.u.chunk.dim, scaled);
+    scaled[dset->shared->ndims] = 0;
+
+    /* Find out where the chunk is stored */
+    if(H5D__chunk_lookup_stored(dset, io_info.md_dxpl_id, scaled, &udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+
+    /* Make sure the chunk has been written */
+    if(!H5F_addr_defined(udata.chunk_block.offset))
+        HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "chunk address isn't defined")
+
+    /* Read the chunk's bytes from the file */
+    if(H5F_block_read(dset->oloc.file, H5FD_MEM_DRAW, udata.chunk_block.offset, (size_t)udata.chunk_block.length, io_info.raw_dxpl_id, buf) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to read raw data chunk")
+
+    *filters = udata.filter_mask;
+
+done:
+#ifdef H5_DEBUG_BUILD
+    if(md_dxpl_generated && H5I_dec_ref(io_info.md_dxpl_id) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTDEC, FAIL, "can't close metadata dxpl")
+#endif /* H5_DEBUG_BUILD */
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__chunk_direct_read() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_direct_read_multi
+ *
+ * Purpose:	Internal routine to read the stored bytes of several chunks
+ *              into ARENA, one after another in the order given, with a
+ *              single vector read.  The size and filter mask of chunk U
+ *              are returned in DATA_SIZES[U] and FILTERS[U]; chunks that
+ *              haven't been written get a size of zero.  Nothing is read
+ *              unless all the chunks fit in ARENA_SIZE bytes.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_direct_read_multi(const H5D_t *dset, hid_t dxpl_id, size_t nchunks,
+    const hsize_t *offsets[], uint32_t filters[], size_t data_sizes[],
+    void *arena, size_t arena_size)
+{
+    H5FD_mem_t *types = NULL;           /* Memory types for vector read */
+    haddr_t *addrs = NULL;              /* File addresses for vector read */
+    size_t *sizes = NULL;               /* Sizes for vector read */
+    void **bufs = NULL;                 /* Buffers for vector read */
+    H5D_io_info_t io_info;              /* to hold the dset and two dxpls (meta and raw data) */
+    hbool_t md_dxpl_generated = FALSE;  /* bool to indicate whether we should free the md_dxpl_id at exit */
+    hbool_t space_alloc;                /* Whether the dataset's storage has been allocated */
+    size_t nused = 0;                   /* Number of blocks to read */
+    size_t total = 0;                   /* Bytes needed in arena */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE_TAG(dxpl_id, dset->oloc.addr, FAIL)
+
+    HDassert(nchunks > 0);
+    HDassert(offsets && filters && data_sizes);
+    HDassert(arena || 0 == arena_size);
+
+    io_info.dset = dset;
+    io_info.raw_dxpl_id = dxpl_id;
+    io_info.md_dxpl_id = dxpl_id;
+
+    /* set the dxpl IO type for sanity checking at the FD layer */
+#ifdef H5_DEBUG_BUILD
+    if(H5D_set_io_info_dxpls(&io_info, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "can't set metadata and raw data dxpls")
+    md_dxpl_generated = TRUE;
+#endif /* H5_DEBUG_BUILD */
+
+    /* Allocate the vector read arrays */
+    if(NULL == (types = (H5FD_mem_t *)H5MM_malloc(nchunks * sizeof(H5FD_mem_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for memory types")
+    if(NULL == (addrs = (haddr_t *)H5MM_malloc(nchunks * sizeof(haddr_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for addresses")
+    if(NULL == (sizes = (size_t *)H5MM_malloc(nchunks * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for sizes")
+    if(NULL == (bufs = (void **)H5MM_malloc(nchunks * sizeof(void *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for buffers")
+
+    /* No chunks are stored if the dataset's storage hasn't been allocated */
+    space_alloc = (*dset->shared->layout.ops->is_space_alloc)(&dset->shared->layout.storage);
+
+    /* Look up the chunks and lay them out in the arena */
+    for(u = 0; u < nchunks; u++) {
+        H5D_chunk_ud_t udata;           /* User data for querying chunk info */
+        hsize_t scaled[H5O_LAYOUT_NDIMS];       /* Scaled coordinates for this chunk */
+
+        HDassert(offsets[u]);
+
+        if(space_alloc) {
+            /* Calculate the index of this chunk */
+            H5VM_chunk_scaled(dset->shared->ndims, offsets[u], dset->shared->layout.u.chunk.dim, scaled);
+            scaled[dset->shared->ndims] = 0;
+
+            /* Find out where the chunk is stored */
+            if(H5D__chunk_lookup_stored(dset, io_info.md_dxpl_id, scaled, &udata) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+        } /* end if */
+        else {
+            udata.filter_mask = 0;
+            udata.chunk_block.offset = HADDR_UNDEF;
+            udata.chunk_block.length = 0;
+        } /* end else */
+
+        filters[u] = udata.filter_mask;
+        H5_CHECKED_ASSIGN(data_sizes[u], size_t, udata.chunk_block.length, hsize_t);
+
+        if(H5F_addr_defined(udata.chunk_block.offset)) {
+            if(data_sizes[u] > arena_size - total)
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "chunks don't fit in buffer")
+
+            types[nused] = H5FD_MEM_DRAW;
+            addrs[nused] = udata.chunk_block.offset;
+            sizes[nused] = data_sizes[u];
+            bufs[nused] = (uint8_t *)arena + total;
+            nused++;
+            total += data_sizes[u];
+        } /* end if */
+    } /* end for */
+
+    /* Read the chunks' bytes from the file */
+    if(nused > 0)
+        if(H5F_block_read_vector(dset->oloc.file, nused, types, addrs, sizes, io_info.raw_dxpl_id, bufs) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to read raw data chunks")
+
+done:
+    if(types)
+        H5MM_xfree(types);
+    if(addrs)
+        H5MM_xfree(addrs);
+    if(sizes)
+        H5MM_xfree(sizes);
+    if(bufs)
+        H5MM_xfree(bufs);
+#ifdef H5_DEBUG_BUILD
+    if(md_dxpl_generated && H5I_dec_ref(io_info.md_dxpl_id) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTDEC, FAIL, "can't close metadata dxpl")
+#endif /* H5_DEBUG_BUILD */
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__chunk_direct_read_multi() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__get_chunk_info_by_coord
+ *
+ * Purpose:	Retrieve the filter mask, file address and stored size of
+ *              the chunk at logical offset OFFSET.  A chunk that hasn't
+ *              been written has an undefined address and a size of zero.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__get_chunk_info_by_coord(const H5D_t *dset, hid_t dxpl_id, const hsize_t *offset,
+    unsigned *filter_mask, haddr_t *addr, hsize_t *size)
+{
+    H5D_chunk_ud_t udata;               /* User data for querying chunk info */
+    hsize_t scaled[H5O_LAYOUT_NDIMS];   /* Scaled coordinates for this chunk */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE_TAG(dxpl_id, dset->oloc.addr, FAIL)
+
+    HDassert(dset);
+    HDassert(H5D_CHUNKED == dset->shared->layout.type);
+
+    if(H5D__chunk_check_offset(dset, offset) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_BADVALUE, FAIL, "invalid chunk offset")
+
+    /* Nothing is stored if the dataset's storage hasn't been allocated */
+    if(!(*dset->shared->layout.ops->is_space_alloc)(&dset->shared->layout.storage)) {
+        udata.filter_mask = 0;
+        udata.chunk_block.offset = HADDR_UNDEF;
+        udata.chunk_block.length = 0;
+    } /* end if */
+    else {
+        /* Calculate the index of this chunk */
+        H5VM_chunk_scaled(dset->shared->ndims, offset, dset->shared->layout.u.chunk.dim, scaled);
+        scaled[dset->shared->ndims] = 0;
+
+        /* Find out where the chunk is stored */
+        if(H5D__chunk_lookup_stored(dset, dxpl_id, scaled, &udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+    } /* end else */
+
+    if(filter_mask)
+        *filter_mask = udata.filter_mask;
+    if(addr)
+        *addr = udata.chunk_block.offset;
+    if(size)
+        *size = udata.chunk_block.length;
+
+done:
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__get_chunk_info_by_coord() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__get_chunk_info_by_range
+ *
+ * Purpose:	Retrieve the logical offsets, filter masks, file addresses
+ *              and stored sizes of the chunks that have been written
+ *              within the COUNT elements from START, in order of their
+ *              file addresses, with a single pass over the chunk index.
+ *              Information about at most MAX_CHUNKS chunks is returned;
+ *              NCHUNKS is set to the number of chunks in the range.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__get_chunk_info_by_range(const H5D_t *dset, hid_t dxpl_id, const hsize_t *start,
+    const hsize_t *count, size_t max_chunks, hsize_t *offsets, unsigned *filter_masks,
+    haddr_t *addrs, hsize_t *sizes, size_t *nchunks)
+{
+    const H5O_layout_chunk_t *layout = &(dset->shared->layout.u.chunk);   /* Chunk layout */
+    H5D_chunk_addr_table_t table;       /* Locations of the chunks in the range */
+    hbool_t     table_built = FALSE;    /* Whether the table was built */
+    hsize_t     scaled_start[H5O_LAYOUT_NDIMS];     /* Scaled coordinates of first chunk */
+    hsize_t     scaled_end[H5O_LAYOUT_NDIMS];       /* Scaled coordinates of last chunk */
+    unsigned    ndims = dset->shared->ndims;        /* Rank of dataset */
+    unsigned    u;                      /* Local index variable */
+    size_t      v;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE_TAG(dxpl_id, dset->oloc.addr, FAIL)
+
+    HDassert(dset);
+    HDassert(H5D_CHUNKED == dset->shared->layout.type);
+    HDassert(start);
+    HDassert(count);
+    HDassert(nchunks);
+
+    *nchunks = 0;
+
+    /* Check the range */
+    for(u = 0; u < ndims; u++)
+        if(start[u] + count[u] > dset->shared->curr_dims[u] || start[u] + count[u] < start[u])
+            HGOTO_ERROR(H5E_DATASPACE, H5E_BADRANGE, FAIL, "range extends beyond dataset's extent")
+    for(u = 0; u < ndims; u++)
+        if(0 == count[u])
+            HGOTO_DONE(SUCCEED)
+
+    /* Nothing is stored if the dataset's storage hasn't been allocated */
+    if(!(*dset->shared->layout.ops->is_space_alloc)(&dset->shared->layout.storage))
+        HGOTO_DONE(SUCCEED)
+
+    /* Write out the queued and cached chunks that haven't been written
+     * out, so that the index holds their current locations */
+    if(H5D__chunk_wb_drain(dset, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write queued chunks")
+    if(dset->shared->cache.chunk.head) {
+        H5D_dxpl_cache_t _dxpl_cache;   /* Data transfer property cache buffer */
+        H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
+        H5D_rdcc_ent_t *ent;            /* Cache entry */
+
+        if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
+        for(ent = dset->shared->cache.chunk.head; ent; ent = ent->next)
+            if(H5D__chunk_flush_entry(dset, dxpl_id, dxpl_cache, ent, FALSE) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
+    } /* end if */
+
+    /* Look up the chunks in the range */
+    for(u = 0; u < ndims; u++) {
+        scaled_start[u] = start[u] / layout->dim[u];
+        scaled_end[u] = (start[u] + count[u] - 1) / layout->dim[u];
+    } /* end for */
+    if(H5D__chunk_addr_table_build(dset, dxpl_id, scaled_start, scaled_end, &table) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to look up chunk addresses")
+    table_built = TRUE;
+
+    /* Order the chunks by their location in the file */
+    HDqsort(table.addrs, table.nused, sizeof(H5D_chunk_addr_t), H5D__chunk_addr_addr_cmp);
+
+    /* Copy out the chunks' information */
+    for(v = 0; v < table.nused && v < max_chunks; v++) {
+        if(offsets) {
+            hsize_t scaled[H5O_LAYOUT_NDIMS];   /* Scaled coordinates of chunk */
+
+            H5VM_array_calc_pre(table.addrs[v].chunk_index, ndims, table.down_chunks, scaled);
+            for(u = 0; u < ndims; u++)
+                offsets[(v * ndims) + u] = scaled[u] * layout->dim[u];
+        } /* end if */
+        if(filter_masks)
+            filter_masks[v] = table.addrs[v].filter_mask;
+        if(addrs)
+            addrs[v] = table.addrs[v].addr;
+        if(sizes)
+            sizes[v] = table.addrs[v].nbytes;
+    } /* end for */
+    *nchunks = table.nused;
+
+done:
+    if(table_built)
+        table.addrs = (H5D_chunk_addr_t *)H5MM_xfree(table.addrs);
+
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__get_chunk_info_by_range() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_set_info_real
+ *
+ * Purpose:	Internal routine to set the information about chunks for a dataset
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Quincey Koziol
+ *              Tuesday, June 30, 2009
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_set_info_real(H5O_layout_chunk_t *layout, unsigned ndims,
+    const hsize_t *curr_dims, const hsize_t *max_dims)
+{
+    unsigned u;                 /* Local index variable */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(layout);
+    HDassert(ndims > 0);
+    HDassert(curr_dims);
+
+    /* Compute the # of chunks in dataset dimensions */
+    for(u = 0, layout->nchunks = 1, layout->max_nchunks = 1; u < ndims; u++) {
+        /* Round up to the next integer # of chunks, to accomodate partial chunks */
+	layout->chunks[u] = ((curr_dims[u] + layout->dim[u]) - 1) / layout->dim[u];
+        if(H5S_UNLIMITED == max_dims[u])
+            layout->max_chunks[u] = H5S_UNLIMITED;
+        else
+            layout->max_chunks[u] = ((max_dims[u] + layout->dim[u]) - 1) / layout->dim[u];
+
+        /* Accumulate the # of chunks */
+	layout->nchunks *= layout->chunks[u];
+	layout->max_nchunks *= layout->max_chunks[u];
+    } /* end for */
+
+    /* Get the "down" sizes for each dimension */
+    if(H5VM_array_down(ndims, layout->chunks, layout->down_chunks) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "can't compute 'down' chunk size value")
+    if(H5VM_array_down(ndims, layout->max_chunks, layout->max_down_chunks) < 0)
+	HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "can't compute 'down' chunk size value")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_set_info_real() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_set_info
+ *
+ * Purpose:	Sets the information about chunks for a dataset
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Quincey Koziol
+ *              Tuesday, June 30, 2009
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_set_info(const H5D_t *dset)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(dset);
+
+    /* Set the base layout information */
+    if(H5D__chunk_set_info_real(&dset->shared->layout.u.chunk, dset->shared->ndims, dset->shared->curr_dims, dset->shared->max_dims) < 0)
+	HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "can't set layout's chunk info")
+
+    /* Call the index's "resize" callback */
+    if(dset->shared->layout.storage.u.chunk.ops->resize && (dset->shared->layout.storage.u.chunk.ops->resize)(&dset->shared->layout.u.chunk) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "unable to resize chunk index information")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_set_info() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_set_sizes
+ *
+ * Purpose:     Sets chunk and type sizes.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ * Programmer:	Dana Robinson
+ *              December 2015
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_set_sizes(H5D_t *dset)
+{
+    uint64_t chunk_size;            /* Size of chunk in bytes */
+    unsigned max_enc_bytes_per_dim; /* Max. number of bytes required to encode this dimension */
+    unsigned u;                     /* Iterator */
+    herr_t ret_value = SUCCEED;     /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(dset);
+
+    /* Increment # of chunk dimensions, to account for datatype size as last element */
+    dset->shared->layout.u.chunk.ndims++;
+
+    /* Set the last dimension of the chunk size to the size of the datatype */
+    dset->shared->layout.u.chunk.dim[dset->shared->layout.u.chunk.ndims - 1] = (uint32_t)H5T_GET_SIZE(dset->shared->type);
+
+    /* Compute number of bytes to use for encoding chunk dimensions */
+    max_enc_bytes_per_dim = 0;
+    for(u = 0; u < (unsigned)dset->shared->layout.u.chunk.ndims; u++) {
+        unsigned enc_bytes_per_dim;     /* Number of bytes required to encode this dimension */
+
+        /* Get encoded size of dim, in bytes */
+        enc_bytes_per_dim = (H5VM_log2_gen(dset->shared->layout.u.chunk.dim[u]) + 8) / 8;
+
+        /* Check if this is the largest value so far */
+        if(enc_bytes_per_dim > max_enc_bytes_per_dim)
+            max_enc_bytes_per_dim = enc_bytes_per_dim;
+    } /* end for */
+    HDassert(max_enc_bytes_per_dim > 0 && max_enc_bytes_per_dim <= 8);
+    dset->shared->layout.u.chunk.enc_bytes_per_dim = max_enc_bytes_per_dim;
+
+    /* Compute and store the total size of a chunk */
+    /* (Use 64-bit value to ensure that we can detect >4GB chunks) */
+    for(u = 1, chunk_size = (uint64_t)dset->shared->layout.u.chunk.dim[0]; u < dset->shared->layout.u.chunk.ndims; u++)
+        chunk_size *= (uint64_t)dset->shared->layout.u.chunk.dim[u];
+
+    /* Check for chunk larger than can be represented in 32-bits */
+    /* (Chunk size is encoded in 32-bit value in v1 B-tree records) */
+    if(chunk_size > (uint64_t)0xffffffff)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "chunk size must be < 4GB")
+
+    H5_CHECKED_ASSIGN(dset->shared->layout.u.chunk.size, uint32_t, chunk_size, uint64_t);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_set_sizes */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_construct
+ *
+ * Purpose:	Constructs new chunked layout information for dataset
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Quincey Koziol
+ *              Thursday, May 22, 2008
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_construct(H5F_t H5_ATTR_UNUSED *f, H5D_t *dset)
+{
+    unsigned u;                 /* Local index variable */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(dset);
+
+    /* Check for invalid chunk dimension rank */
+    if(0 == dset->shared->layout.u.chunk.ndims)
+        HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "no chunk information set?")
+    if(dset->shared->layout.u.chunk.ndims != dset->shared->ndims)
+        HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "dimensionality of chunks doesn't match the dataspace")
+
+    /* Set chunk sizes */
+    if(H5D__chunk_set_sizes(dset) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "unable to set chunk sizes")
+    HDassert((unsigned)(dset->shared->layout.u.chunk.ndims) <= NELMTS(dset->shared->layout.u.chunk.dim));
+
+    /* Chunked storage is not compatible with external storage (currently) */
+    if(dset->shared->dcpl_cache.efl.nused > 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "external storage not supported with chunked layout")
+
+    /* Sanity check dimensions */
+    for(u = 0; u < dset->shared->layout.u.chunk.ndims - 1; u++) {
+        /* Don't allow zero-sized chunk dimensions */
+        if(0 == dset->shared->layout.u.chunk.dim[u])
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "chunk size must be > 0, dim = %u ", u)
+
+        /*
+         * The chunk size of a dimension with a fixed size cannot exceed
+         * the maximum dimension size. If any dimension size is zero, there
+         * will be no such restriction.
+         */
+        if(dset->shared->curr_dims[u] && dset->shared->max_dims[u] != H5S_UNLIMITED && dset->shared->max_dims[u] < dset->shared->layout.u.chunk.dim[u])
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "chunk size must be <= maximum dimension size for fixed-sized dimensions")
+    } /* end for */
+
+    /* Reset address and pointer of the array struct for the chunked storage index */
+    if(H5D_chunk_idx_reset(&dset->shared->layout.storage.u.chunk, TRUE) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to reset chunked storage index")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_construct() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_init
+ *
+ * Purpose:	Initialize the raw data chunk cache for a dataset.  This is
+ *		called when the dataset is initialized.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Robb Matzke
+ *              Monday, May 18, 1998
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_init(H5F_t *f, hid_t dxpl_id, const H5D_t *dset, hid_t dapl_id)
+{
+    H5D_chk_idx_info_t idx_info;        /* Chunked index info */
+    H5D_rdcc_t	*rdcc = &(dset->shared->cache.chunk);   /* Convenience pointer to dataset's chunk cache */
+    H5P_genplist_t *dapl;               /* Data access property list object pointer */
+    H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(f);
     HDassert(dset);
     H5D_CHUNK_STORAGE_INDEX_CHK(sc);
 
@@ -752,10 +1587,35 @@ H5D__chunk_init(H5F_t *f, hid_t dxpl_id, const H5D_t *dset, hid_t dapl_id)
     if(rdcc->w0 < 0)
         rdcc->w0 = H5F_RDCC_W0(f);
 
+    if(H5P_get(dapl, H5D_ACS_DATA_CACHE_NUM_WAYS_NAME, &rdcc->nways) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get data cache associativity")
+
+    if(H5P_get(dapl, H5D_ACS_DATA_CACHE_AUTO_RESIZE_NAME, &rdcc->auto_resize) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get data cache automatic resizing")
+
+    /* Only filtered chunks are written behind, and not in parallel, where
+     * chunks are written collectively */
+    if(H5P_get(dapl, H5D_ACS_WRITE_BEHIND_NBYTES_NAME, &rdcc->wb_nbytes_max) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get write-behind queue size")
+    if(rdcc->wb_nbytes_max < dset->shared->layout.u.chunk.size
+            || !dset->shared->dcpl_cache.pline.nused
+            || H5F_HAS_FEATURE(f, H5FD_FEAT_HAS_MPI))
+        rdcc->wb_nbytes_max = 0;
+
     /* If nbytes_max or nslots is 0, set them both to 0 and avoid allocating space */
-    if(!rdcc->nbytes_max || !rdcc->nslots)
-        rdcc->nbytes_max = rdcc->nslots = 0;
+    if(!rdcc->nbytes_max || !rdcc->nslots) {
+        rdcc->nbytes_max = rdcc->nslots = rdcc->nsets = 0;
+        rdcc->auto_resize = FALSE;
+    } /* end if */
     else {
+        /* Group the slots into sets, with all slots in one set if there are
+         * fewer slots than ways.  Any slots left over after dividing into
+         * sets are not used. */
+        HDassert(rdcc->nways > 0);
+        if(rdcc->nways > rdcc->nslots)
+            H5_CHECKED_ASSIGN(rdcc->nways, unsigned, rdcc->nslots, size_t);
+        rdcc->nsets = rdcc->nslots / rdcc->nways;
+
         rdcc->slot = H5FL_SEQ_CALLOC(H5D_rdcc_ent_ptr_t, rdcc->nslots);
         if(NULL == rdcc->slot)
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
@@ -764,6 +1624,9 @@ H5D__chunk_init(H5F_t *f, hid_t dxpl_id, const H5D_t *dset, hid_t dapl_id)
         H5D__chunk_cinfo_cache_reset(&(rdcc->last));
     } /* end else */
 
+    /* The cache never shrinks below the size the application asked for */
+    rdcc->nbytes_min = rdcc->nbytes_max;
+
     /* Compute scaled dimension info, if dataset dims > 1 */
     if(dset->shared->ndims > 1) {
         unsigned u;                         /* Local index value */
@@ -1950,7 +2813,7 @@ done:
  */
 static herr_t
 H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
-    hsize_t H5_ATTR_UNUSED nelmts, const H5S_t H5_ATTR_UNUSED *file_space, const H5S_t H5_ATTR_UNUSED *mem_space,
+    hsize_t H5_ATTR_UNUSED nelmts, const H5S_t *file_space, const H5S_t H5_ATTR_UNUSED *mem_space,
     H5D_chunk_map_t *fm)
 {
     H5SL_node_t *chunk_node;            /* Current node in chunk skip list */
@@ -1962,6 +2825,14 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     hbool_t     cpt_dirty;              /* Temporary placeholder for compact storage "dirty" flag */
     uint32_t    src_accessed_bytes = 0; /* Total accessed size in a chunk */
     hbool_t     skip_missing_chunks = FALSE;    /* Whether to skip missing chunks */
+    H5D_chunk_batch_ent_t *ents = NULL; /* Chunks looked up ahead of the read */
+    size_t      nents = 0;              /* # of chunks looked up */
+    size_t      curr_ent = 0;           /* Entry of current chunk */
+    size_t      window_max;             /* Max. # of chunks read ahead */
+    H5D_io_vec_t vec;                   /* Blocks of uncached chunks deferred for one vector read */
+    hbool_t     use_vec = FALSE;        /* Whether blocks are deferred */
+    H5D_chunk_addr_table_t table;       /* Locations of the selected chunks */
+    H5D_chunk_addr_table_t *tablep = NULL;  /* Pointer to table, if it was built */
     herr_t	ret_value = SUCCEED;	/*return value		*/
 
     FUNC_ENTER_STATIC
@@ -1972,6 +2843,10 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     HDassert(type_info);
     HDassert(fm);
 
+    /* Resize the chunk cache for the access pattern, if the last epoch ended */
+    if(io_info->dset->shared->cache.chunk.auto_resize && H5D__chunk_cache_auto_resize(io_info) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTRESIZE, FAIL, "unable to resize chunk cache")
+
     /* Set up "nonexistent" I/O info object */
     HDmemcpy(&nonexistent_io_info, io_info, sizeof(nonexistent_io_info));
     nonexistent_io_info.layout_ops = *H5D_LOPS_NONEXISTENT;
@@ -1984,6 +2859,16 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     /* Initialize temporary contiguous storage info */
     H5_CHECKED_ASSIGN(ctg_store.contig.dset_size, hsize_t, io_info->dset->shared->layout.u.chunk.size, uint32_t);
 
+    /* Gather the reads of consecutive chunks that bypass the chunk cache into
+     * vectors for the file driver, when the data goes directly into the
+     * application's buffer.
+     */
+    if(io_info->io_ops.single_read == H5D__select_read && H5F_HAS_VECTOR_IO(io_info->dset->oloc.file)) {
+        HDmemset(&vec, 0, sizeof(vec));
+        ctg_io_info.vec = &vec;
+        use_vec = TRUE;
+    } /* end if */
+
     /* Set up compact I/O info object */
     HDmemcpy(&cpt_io_info, io_info, sizeof(cpt_io_info));
     cpt_io_info.store = &cpt_store;
@@ -2010,18 +2895,92 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
             skip_missing_chunks = TRUE;
     }
 
+    /* When many of the dataset's chunks are read, look up their locations
+     * with one pass over the chunk index, instead of searching the index
+     * for each chunk.  (The other indices hold one chunk at most, or
+     * none.)
+     */
+    {
+        const H5O_layout_t *layout = &(io_info->dset->shared->layout);  /* Dataset's layout */
+        size_t nsel_chunks = fm->use_single ? 1 : H5SL_count(fm->sel_chunks);  /* # of chunks selected */
+
+        if((H5D_CHUNK_IDX_BTREE == layout->u.chunk.idx_type || H5D_CHUNK_IDX_BT2 == layout->u.chunk.idx_type
+                    || H5D_CHUNK_IDX_EARRAY == layout->u.chunk.idx_type || H5D_CHUNK_IDX_FARRAY == layout->u.chunk.idx_type)
+                && nsel_chunks >= H5D_CHUNK_ADDR_TABLE_MIN
+                && (hsize_t)nsel_chunks * H5D_CHUNK_ADDR_TABLE_DENSITY >= layout->u.chunk.nchunks
+                && (*layout->ops->is_space_alloc)(&layout->storage)) {
+            hsize_t sel_start[H5O_LAYOUT_NDIMS];    /* Selection's first element */
+            hsize_t sel_end[H5O_LAYOUT_NDIMS];      /* Selection's last element */
+            unsigned u;                 /* Local index variable */
+
+            if(H5S_SELECT_BOUNDS(file_space, sel_start, sel_end) < 0)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "unable to get selection bounds")
+            for(u = 0; u < fm->f_ndims; u++) {
+                sel_start[u] /= layout->u.chunk.dim[u];
+                sel_end[u] /= layout->u.chunk.dim[u];
+            } /* end for */
+            if(H5D__chunk_addr_table_build(io_info->dset, io_info->md_dxpl_id, sel_start, sel_end, &table) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to look up chunk addresses")
+            tablep = &table;
+        } /* end if */
+    }
+
+    /* If filter threads were requested, look up all the chunks first and
+     * run the ones that need to be unfiltered through the read pipeline */
+    if(io_info->dxpl_cache->filter_threads > 1 && io_info->dset->shared->dcpl_cache.pline.nused > 0) {
+        nents = fm->use_single ? 1 : H5SL_count(fm->sel_chunks);
+        if(NULL == (ents = (H5D_chunk_batch_ent_t *)H5MM_malloc(nents * sizeof(H5D_chunk_batch_ent_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk list")
+        for(chunk_node = H5D_CHUNK_GET_FIRST_NODE(fm); chunk_node; chunk_node = H5D_CHUNK_GET_NEXT_NODE(fm, chunk_node)) {
+            H5D_chunk_batch_ent_t *bent = &ents[curr_ent++];  /* Chunk's entry */
+
+            bent->chunk_info = H5D_CHUNK_GET_NODE_INFO(fm, chunk_node);
+            bent->chunk = NULL;
+            bent->scatter = NULL;
+            bent->done = FALSE;
+            if(H5D__chunk_lookup_table(io_info->dset, io_info->md_dxpl_id, tablep, bent->chunk_info->scaled, &bent->udata) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+        } /* end for */
+        HDassert(curr_ent == nents);
+        curr_ent = 0;
+
+        /* Read ahead as many chunks as fit in H5D_CHUNK_READAHEAD_SIZE */
+        window_max = H5D_CHUNK_READAHEAD_SIZE / io_info->dset->shared->layout.u.chunk.size;
+        if(window_max < (size_t)io_info->dxpl_cache->filter_threads * H5D_CHUNK_BATCH_PER_THREAD)
+            window_max = (size_t)io_info->dxpl_cache->filter_threads * H5D_CHUNK_BATCH_PER_THREAD;
+
+        if(H5D__chunk_read_pipeline(io_info, type_info, &cpt_io_info, ents, nents, window_max) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to read chunks")
+    } /* end if */
+
     /* Iterate through nodes in chunk skip list */
     chunk_node = H5D_CHUNK_GET_FIRST_NODE(fm);
     while(chunk_node) {
         H5D_chunk_info_t *chunk_info;   /* Chunk information */
         H5D_chunk_ud_t udata;		/* Chunk index pass-through	*/
+        H5D_chunk_batch_ent_t *bent = NULL; /* Chunk's entry, if looked up already */
 
         /* Get the actual chunk information from the skip list node */
         chunk_info = H5D_CHUNK_GET_NODE_INFO(fm, chunk_node);
 
-        /* Get the info for the chunk in the file */
-        if(H5D__chunk_lookup(io_info->dset, io_info->md_dxpl_id, chunk_info->scaled, &udata) < 0)
-            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+        if(ents) {
+            bent = &ents[curr_ent++];
+            HDassert(bent->chunk_info == chunk_info);
+
+            /* Skip chunks read by the pipeline */
+            if(bent->done) {
+                chunk_node = H5D_CHUNK_GET_NEXT_NODE(fm, chunk_node);
+                continue;
+            } /* end if */
+        } /* end if */
+
+        /* Get the info for the chunk in the file (chunks that were cached
+         * when looked up may have been evicted by the pipeline since) */
+        if(bent && UINT_MAX == bent->udata.idx_hint)
+            udata = bent->udata;
+        else
+            if(H5D__chunk_lookup_table(io_info->dset, io_info->md_dxpl_id, tablep, chunk_info->scaled, &udata) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
 
         /* Sanity check */
         HDassert((H5F_addr_defined(udata.chunk_block.offset) && udata.chunk_block.length > 0) || 
@@ -2041,6 +3000,10 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
             if((cacheable = H5D__chunk_cacheable(io_info, udata.chunk_block.offset, FALSE)) < 0)
                 HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't tell if chunk is cacheable")
             if(cacheable) {
+                /* Finish the deferred reads before using the chunk cache */
+                if(use_vec && H5D__io_vec_read(io_info->dset->oloc.file, io_info->raw_dxpl_id, &vec) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "deferred block read failed")
+
                 /* Load the chunk into cache and lock it. */
 
                 /* Compute # of bytes accessed in chunk */
@@ -2048,7 +3011,7 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
                 src_accessed_bytes = chunk_info->chunk_points * (uint32_t)type_info->src_type_size;
 
                 /* Lock the chunk into the cache */
-                if(NULL == (chunk = H5D__chunk_lock(io_info, &udata, FALSE, FALSE)))
+                if(NULL == (chunk = H5D__chunk_lock(io_info, &udata, FALSE, FALSE, NULL)))
                     HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
 
                 /* Set up the storage buffer information for this chunk */
@@ -2060,6 +3023,7 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
             else if(H5F_addr_defined(udata.chunk_block.offset)) {
                 /* Set up the storage address information for this chunk */
                 ctg_store.contig.dset_addr = udata.chunk_block.offset;
+                io_info->dset->shared->cache.chunk.stats.nbypasses++;
 
                 /* Point I/O info at temporary I/O info for this chunk */
                 chk_io_info = &ctg_io_info;
@@ -2083,7 +3047,19 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
         chunk_node = H5D_CHUNK_GET_NEXT_NODE(fm, chunk_node);
     } /* end while */
 
+    /* Read the remaining deferred blocks */
+    if(use_vec && H5D__io_vec_read(io_info->dset->oloc.file, io_info->raw_dxpl_id, &vec) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "deferred block read failed")
+
 done:
+    ents = (H5D_chunk_batch_ent_t *)H5MM_xfree(ents);
+    if(tablep)
+        table.addrs = (H5D_chunk_addr_t *)H5MM_xfree(table.addrs);
+
+    /* Release the vector of deferred blocks */
+    if(use_vec)
+        H5D__io_vec_free(&vec);
+
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5D__chunk_read() */
 
@@ -2112,6 +3088,11 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     H5D_storage_t cpt_store;            /* Chunk storage information as compact dataset */
     hbool_t     cpt_dirty;              /* Temporary placeholder for compact storage "dirty" flag */
     uint32_t    dst_accessed_bytes = 0; /* Total accessed size in a chunk */
+    H5D_chunk_batch_ent_t *batch = NULL;        /* Chunks filtered together */
+    size_t      batch_max = 0;          /* Max. # of chunks in a batch */
+    size_t      batch_nents = 0;        /* # of chunks in current batch */
+    H5D_io_vec_t vec;                   /* Blocks of uncached chunks deferred for one vector write */
+    hbool_t     use_vec = FALSE;        /* Whether blocks are deferred */
     herr_t	ret_value = SUCCEED;	/* Return value		*/
 
     FUNC_ENTER_STATIC
@@ -2122,6 +3103,10 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     HDassert(type_info);
     HDassert(fm);
 
+    /* Resize the chunk cache for the access pattern, if the last epoch ended */
+    if(io_info->dset->shared->cache.chunk.auto_resize && H5D__chunk_cache_auto_resize(io_info) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTRESIZE, FAIL, "unable to resize chunk cache")
+
     /* Set up contiguous I/O info object */
     HDmemcpy(&ctg_io_info, io_info, sizeof(ctg_io_info));
     ctg_io_info.store = &ctg_store;
@@ -2130,6 +3115,16 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     /* Initialize temporary contiguous storage info */
     H5_CHECKED_ASSIGN(ctg_store.contig.dset_size, hsize_t, io_info->dset->shared->layout.u.chunk.size, uint32_t);
 
+    /* Gather the writes of consecutive chunks that bypass the chunk cache
+     * into vectors for the file driver, when the data comes directly from
+     * the application's buffer.
+     */
+    if(io_info->io_ops.single_write == H5D__select_write && H5F_HAS_VECTOR_IO(io_info->dset->oloc.file)) {
+        HDmemset(&vec, 0, sizeof(vec));
+        ctg_io_info.vec = &vec;
+        use_vec = TRUE;
+    } /* end if */
+
     /* Set up compact I/O info object */
     HDmemcpy(&cpt_io_info, io_info, sizeof(cpt_io_info));
     cpt_io_info.store = &cpt_store;
@@ -2138,6 +3133,13 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     /* Initialize temporary compact storage info */
     cpt_store.compact.dirty = &cpt_dirty;
 
+    /* Set up to filter whole chunks in batches, if filter threads were requested */
+    if(io_info->dxpl_cache->filter_threads > 1 && io_info->dset->shared->dcpl_cache.pline.nused > 0) {
+        batch_max = (size_t)io_info->dxpl_cache->filter_threads * H5D_CHUNK_BATCH_PER_THREAD;
+        if(NULL == (batch = (H5D_chunk_batch_ent_t *)H5MM_malloc(batch_max * sizeof(H5D_chunk_batch_ent_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk batch")
+    } /* end if */
+
     /* Iterate through nodes in chunk skip list */
     chunk_node = H5D_CHUNK_GET_FIRST_NODE(fm);
     while(chunk_node) {
@@ -2148,6 +3150,7 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
         H5D_chunk_ud_t udata;		/* Index pass-through	*/
         htri_t cacheable;               /* Whether the chunk is cacheable */
         hbool_t need_insert = FALSE;    /* Whether the chunk needs to be inserted into the index */
+        hbool_t batched = FALSE;        /* Whether the chunk was added to the batch */
 
         /* Get the actual chunk information from the skip list node */
         chunk_info = H5D_CHUNK_GET_NODE_INFO(fm, chunk_node);
@@ -2171,84 +3174,581 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
              * simply allocate space instead of load the chunk. */
             hbool_t entire_chunk = TRUE;       /* Whether whole chunk is selected */
 
+            /* Finish the deferred writes before using the chunk cache */
+            if(use_vec && H5D__io_vec_write(io_info->dset->oloc.file, io_info->raw_dxpl_id, &vec) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "deferred block write failed")
+
             /* Compute # of bytes accessed in chunk */
             H5_CHECK_OVERFLOW(type_info->dst_type_size, /*From:*/ size_t, /*To:*/ uint32_t);
             dst_accessed_bytes = chunk_info->chunk_points * (uint32_t)type_info->dst_type_size;
 
-            /* Determine if we will access all the data in the chunk */
-            if(dst_accessed_bytes != ctg_store.contig.dset_size ||
-                    (chunk_info->chunk_points * type_info->src_type_size) != ctg_store.contig.dset_size ||
-		    fm->fsel_type == H5S_SEL_POINTS)
-                entire_chunk = FALSE;
+            /* Determine if we will access all the data in the chunk */
+            if(dst_accessed_bytes != ctg_store.contig.dset_size ||
+                    (chunk_info->chunk_points * type_info->src_type_size) != ctg_store.contig.dset_size ||
+		    fm->fsel_type == H5S_SEL_POINTS)
+                entire_chunk = FALSE;
+
+            /* Whole chunks that aren't cached are filtered and written
+             * with the rest of the batch, bypassing the cache */
+            if(batch && entire_chunk && H5D__chunk_batch_eligible(io_info, &udata)) {
+                H5D_chunk_batch_ent_t *bent = &batch[batch_nents];  /* Chunk's entry in the batch */
+
+                bent->chunk_info = chunk_info;
+                bent->udata = udata;
+                bent->scatter = NULL;
+                bent->nbytes = bent->buf_size = (size_t)ctg_store.contig.dset_size;
+                if(NULL == (bent->chunk = H5D__chunk_mem_alloc(bent->buf_size, &(io_info->dset->shared->dcpl_cache.pline))))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
+                batch_nents++;
+                batched = TRUE;
+
+                /* The chunk's data is gathered into the batch's buffer */
+                chunk = bent->chunk;
+            } /* end if */
+            else
+                /* Lock the chunk into the cache */
+                if(NULL == (chunk = H5D__chunk_lock(io_info, &udata, entire_chunk, FALSE, NULL)))
+                    HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
+
+            /* Set up the storage buffer information for this chunk */
+            cpt_store.compact.buf = chunk;
+
+            /* Point I/O info at main I/O info for this chunk */
+            chk_io_info = &cpt_io_info;
+        } /* end if */
+        else {
+            io_info->dset->shared->cache.chunk.stats.nbypasses++;
+
+            /* If the chunk hasn't been allocated on disk, do so now. */
+            if(!H5F_addr_defined(udata.chunk_block.offset)) {
+                /* Compose chunked index info struct */
+                idx_info.f = io_info->dset->oloc.file;
+                idx_info.dxpl_id = io_info->md_dxpl_id;
+                idx_info.pline = &(io_info->dset->shared->dcpl_cache.pline);
+                idx_info.layout = &(io_info->dset->shared->layout.u.chunk);
+                idx_info.storage = &(io_info->dset->shared->layout.storage.u.chunk);
+
+                /* Set up the size of chunk for user data */
+                udata.chunk_block.length = io_info->dset->shared->layout.u.chunk.size;
+
+                /* Allocate the chunk */
+		if(H5D__chunk_file_alloc(&idx_info, NULL, &udata.chunk_block, &need_insert, chunk_info->scaled) < 0)
+		    HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert/resize chunk on chunk level")
+
+                /* Make sure the address of the chunk is returned. */
+                if(!H5F_addr_defined(udata.chunk_block.offset))
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "chunk address isn't defined")
+
+                /* Cache the new chunk information */
+                H5D__chunk_cinfo_cache_update(&io_info->dset->shared->cache.chunk.last, &udata);
+            } /* end if */
+
+            /* Set up the storage address information for this chunk */
+            ctg_store.contig.dset_addr = udata.chunk_block.offset;
+
+            /* No chunk cached */
+            chunk = NULL;
+
+            /* Point I/O info at temporary I/O info for this chunk */
+            chk_io_info = &ctg_io_info;
+        } /* end else */
+
+        /* Perform the actual write operation */
+        if((io_info->io_ops.single_write)(chk_io_info, type_info,
+                (hsize_t)chunk_info->chunk_points, chunk_info->fspace, chunk_info->mspace) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "chunked write failed")
+
+	/* Write out the batch once it's full, release the cache lock on the
+         * chunk, or insert chunk into index. */
+        if(batched) {
+            if(batch_nents == batch_max) {
+                if(H5D__chunk_write_batch(io_info, batch, batch_nents) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write batch of chunks")
+                batch_nents = 0;
+            } /* end if */
+        } /* end if */
+	else if(chunk) {
+	    if(H5D__chunk_unlock(io_info, &udata, TRUE, chunk, dst_accessed_bytes) < 0)
+		HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to unlock raw data chunk")
+	} /* end if */
+	else {
+            if(need_insert && io_info->dset->shared->layout.storage.u.chunk.ops->insert)
+                if((io_info->dset->shared->layout.storage.u.chunk.ops->insert)(&idx_info, &udata, NULL) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
+	} /* end else */
+
+        /* Advance to next chunk in list */
+        chunk_node = H5D_CHUNK_GET_NEXT_NODE(fm, chunk_node);
+    } /* end while */
+
+    /* Write the remaining deferred blocks */
+    if(use_vec && H5D__io_vec_write(io_info->dset->oloc.file, io_info->raw_dxpl_id, &vec) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "deferred block write failed")
+
+    /* Write out the last, partial batch */
+    if(batch_nents > 0) {
+        if(H5D__chunk_write_batch(io_info, batch, batch_nents) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write batch of chunks")
+        batch_nents = 0;
+    } /* end if */
+
+done:
+    /* Release the batch of chunks */
+    if(batch) {
+        H5D__chunk_free_batch(io_info, batch, batch_nents);
+        batch = (H5D_chunk_batch_ent_t *)H5MM_xfree(batch);
+    } /* end if */
+
+    /* Release the vector of deferred blocks */
+    if(use_vec)
+        H5D__io_vec_free(&vec);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_write() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_batch_eligible
+ *
+ * Purpose:	Determine whether a chunk's data can be run through the
+ *		filter pipeline as part of a batch: it must not be in the
+ *		chunk cache and the dataset's filters must apply to it.
+ *
+ * Return:	TRUE/FALSE
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5D__chunk_batch_eligible(const H5D_io_info_t *io_info, const H5D_chunk_ud_t *udata)
+{
+    const H5D_shared_t *shared = io_info->dset->shared;    /* Dataset's shared info */
+    hbool_t ret_value = TRUE;           /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(shared->dcpl_cache.pline.nused > 0);
+
+    if(UINT_MAX != udata->idx_hint)
+        ret_value = FALSE;
+    else if((shared->layout.u.chunk.flags & H5O_LAYOUT_CHUNK_DONT_FILTER_PARTIAL_BOUND_CHUNKS)
+            && H5D__chunk_is_partial_edge_chunk(shared->ndims, shared->layout.u.chunk.dim,
+                    udata->common.scaled, shared->curr_dims))
+        ret_value = FALSE;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_batch_eligible() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_filter_batch
+ *
+ * Purpose:	Run the chunk buffers of a batch through the dataset's
+ *		filter pipeline (forward, or in reverse if FLAGS includes
+ *		H5Z_FLAG_REVERSE), on the filter threads of the DXPL.
+ *		Entries without a chunk buffer are skipped.  The copies of
+ *		entries with a scatter operation are done right after their
+ *		chunk is unfiltered, on the same thread.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_filter_batch(const H5D_io_info_t *io_info, H5D_chunk_batch_ent_t *batch,
+    size_t nents, unsigned flags)
+{
+    H5Z_pipeline_job_t *jobs = NULL;    /* Buffers for the filter pipeline */
+    size_t      njobs = 0;              /* Number of buffers to filter */
+    size_t      u, v;                   /* Local index variables */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(batch);
+
+    if(NULL == (jobs = (H5Z_pipeline_job_t *)H5MM_malloc(nents * sizeof(H5Z_pipeline_job_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for filter jobs")
+
+    /* Hand the chunk buffers to the pipeline */
+    for(u = 0; u < nents; u++)
+        if(batch[u].chunk) {
+            jobs[njobs].filter_mask = batch[u].udata.filter_mask;
+            jobs[njobs].nbytes = batch[u].nbytes;
+            jobs[njobs].buf_size = batch[u].buf_size;
+            jobs[njobs].buf = batch[u].chunk;
+            jobs[njobs].op = batch[u].scatter ? H5D__chunk_scatter_op : NULL;
+            jobs[njobs].op_data = batch[u].scatter;
+            njobs++;
+        } /* end if */
+
+    /* Filter the chunks */
+    if(H5Z_pipeline_batch(&(io_info->dset->shared->dcpl_cache.pline), flags,
+            io_info->dxpl_cache->err_detect, io_info->dxpl_cache->filter_cb,
+            io_info->dxpl_cache->filter_threads, njobs, jobs) < 0)
+        ret_value = FAIL;
+
+    /* Take the [possibly reallocated] buffers back, even on failure, so
+     * they are released properly */
+    for(u = v = 0; u < nents; u++)
+        if(batch[u].chunk) {
+            batch[u].udata.filter_mask = jobs[v].filter_mask;
+            batch[u].nbytes = jobs[v].nbytes;
+            batch[u].buf_size = jobs[v].buf_size;
+            batch[u].chunk = jobs[v].buf;
+            v++;
+        } /* end if */
+
+    if(ret_value < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "data pipeline failed")
+
+done:
+    jobs = (H5Z_pipeline_job_t *)H5MM_xfree(jobs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_filter_batch() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_batch_addr_cmp
+ *
+ * Purpose:	Compare the file addresses of two chunks in a batch, for
+ *		sorting with HDqsort().
+ *
+ * Return:	-1, 0 or 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_batch_addr_cmp(const void *_ent1, const void *_ent2)
+{
+    const H5D_chunk_batch_ent_t *ent1 = *(const H5D_chunk_batch_ent_t * const *)_ent1;
+    const H5D_chunk_batch_ent_t *ent2 = *(const H5D_chunk_batch_ent_t * const *)_ent2;
+    int ret_value = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(H5F_addr_lt(ent1->udata.chunk_block.offset, ent2->udata.chunk_block.offset))
+        ret_value = -1;
+    else if(H5F_addr_gt(ent1->udata.chunk_block.offset, ent2->udata.chunk_block.offset))
+        ret_value = 1;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_batch_addr_cmp() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_scatter_op
+ *
+ * Purpose:	Copy the elements selected in a chunk which was just
+ *		unfiltered into the application's buffer.  Called by
+ *		H5Z_pipeline_batch() on the thread that unfiltered the chunk,
+ *		so it relies on nothing but the precomputed strided layouts.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_scatter_op(const void *chunk, size_t H5_ATTR_UNUSED nbytes, void *_scatter)
+{
+    H5D_chunk_scatter_t *scatter = (H5D_chunk_scatter_t *)_scatter;
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(chunk);
+    HDassert(scatter);
+
+    if(H5S_select_strided_copy(scatter->buf, &scatter->mem_layout, (hsize_t)0,
+            chunk, &scatter->file_layout, (hsize_t)0, scatter->nbytes) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "unable to copy chunk's elements")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_scatter_op() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_read_pipeline
+ *
+ * Purpose:	Read the chunks that aren't in the chunk cache and need to
+ *		be unfiltered, out of the NENTS chunk map entries in ENTS,
+ *		whose addresses have already been looked up.
+ *
+ *		The chunks are read from the file in address order by the
+ *		calling thread, WINDOW_MAX at a time, with a single vector
+ *		read when the file driver supports it.  Each window is then
+ *		unfiltered on the filter threads of the DXPL.  When the data
+ *		needs no type conversion and both selections of a chunk are
+ *		regular, the same thread also copies the chunk's elements
+ *		into the application's buffer.  Finally the chunks enter the
+ *		chunk cache in address order, and the elements of the other
+ *		chunks are read from the cache through CPT_IO_INFO as usual.
+ *		The entries of the chunks read here are marked done.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_read_pipeline(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
+    H5D_io_info_t *cpt_io_info, H5D_chunk_batch_ent_t *ents, size_t nents,
+    size_t window_max)
+{
+    H5F_t       *f = io_info->dset->oloc.file;  /* File for the dataset */
+    const H5O_pline_t *pline = &(io_info->dset->shared->dcpl_cache.pline); /* I/O pipeline info */
+    H5D_chunk_batch_ent_t **sorted = NULL;  /* Entries to read, in address order */
+    H5D_chunk_batch_ent_t *window = NULL;   /* Chunks being read & unfiltered */
+    H5D_chunk_scatter_t *scatter = NULL;    /* Copies for the chunks in the window */
+    H5FD_mem_t  *types = NULL;          /* Vector of memory types */
+    haddr_t     *addrs = NULL;          /* Vector of chunk addresses */
+    size_t      *sizes = NULL;          /* Vector of chunk sizes */
+    void        **bufs = NULL;          /* Vector of chunk buffers */
+    hbool_t     direct;                 /* Whether elements can go straight to the application's buffer */
+    size_t      nsorted = 0;            /* Number of chunks to read */
+    size_t      nwindow = 0;            /* Number of chunks in the window */
+    size_t      u, v;                   /* Local index variables */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(ents);
+    HDassert(window_max > 0);
+
+    if(NULL == (sorted = (H5D_chunk_batch_ent_t **)H5MM_malloc(nents * sizeof(H5D_chunk_batch_ent_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk list")
+
+    /* Pick out the chunks to read, in file address order */
+    for(u = 0; u < nents; u++)
+        if(H5F_addr_defined(ents[u].udata.chunk_block.offset) && H5D__chunk_batch_eligible(io_info, &ents[u].udata))
+            sorted[nsorted++] = &ents[u];
+    if(0 == nsorted)
+        HGOTO_DONE(SUCCEED)
+    if(nsorted > 1)
+        HDqsort(sorted, nsorted, sizeof(H5D_chunk_batch_ent_t *), H5D__chunk_batch_addr_cmp);
+
+    if(window_max > nsorted)
+        window_max = nsorted;
+    if(NULL == (window = (H5D_chunk_batch_ent_t *)H5MM_malloc(window_max * sizeof(H5D_chunk_batch_ent_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk batch")
+    if(NULL == (scatter = (H5D_chunk_scatter_t *)H5MM_malloc(window_max * sizeof(H5D_chunk_scatter_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk copies")
+    if(H5F_HAS_VECTOR_IO(f)) {
+        if(NULL == (types = (H5FD_mem_t *)H5MM_malloc(window_max * sizeof(H5FD_mem_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+        if(NULL == (addrs = (haddr_t *)H5MM_malloc(window_max * sizeof(haddr_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+        if(NULL == (sizes = (size_t *)H5MM_malloc(window_max * sizeof(size_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+        if(NULL == (bufs = (void **)H5MM_malloc(window_max * sizeof(void *))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+    } /* end if */
+
+    /* Without type conversion, the elements are copied directly between the
+     * chunk and the application's buffer */
+    direct = (hbool_t)(io_info->io_ops.single_read == H5D__select_read);
+
+    for(u = 0; u < nsorted; u += window_max) {
+        /* Read the next window of chunks */
+        for(nwindow = 0; nwindow < window_max && (u + nwindow) < nsorted; nwindow++) {
+            H5D_chunk_batch_ent_t *bent = &window[nwindow];    /* Chunk's entry in the window */
+
+            *bent = *sorted[u + nwindow];
+            H5_CHECKED_ASSIGN(bent->nbytes, size_t, bent->udata.chunk_block.length, hsize_t);
+            bent->buf_size = bent->nbytes;
+            bent->scatter = NULL;
+            if(NULL == (bent->chunk = H5D__chunk_mem_alloc(bent->buf_size, pline)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
+        } /* end for */
+        if(bufs) {
+            for(v = 0; v < nwindow; v++) {
+                types[v] = H5FD_MEM_DRAW;
+                addrs[v] = window[v].udata.chunk_block.offset;
+                sizes[v] = window[v].nbytes;
+                bufs[v] = window[v].chunk;
+            } /* end for */
+            if(H5F_block_read_vector(f, nwindow, types, addrs, sizes, io_info->raw_dxpl_id, bufs) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunks")
+        } /* end if */
+        else
+            for(v = 0; v < nwindow; v++)
+                if(H5F_block_read(f, H5FD_MEM_DRAW, window[v].udata.chunk_block.offset,
+                        window[v].nbytes, io_info->raw_dxpl_id, window[v].chunk) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
+
+        /* Set up the copies to the application's buffer */
+        if(direct)
+            for(v = 0; v < nwindow; v++) {
+                H5D_chunk_info_t *chunk_info = window[v].chunk_info;   /* Chunk information */
+                htri_t is_strided;      /* Whether both selections are regular */
+
+                if((is_strided = H5S_select_get_strided(chunk_info->fspace, type_info->src_type_size, &scatter[v].file_layout)) < 0)
+                    HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't describe chunk's selection")
+                if(is_strided && (is_strided = H5S_select_get_strided(chunk_info->mspace, type_info->src_type_size, &scatter[v].mem_layout)) < 0)
+                    HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't describe memory selection")
+                if(is_strided) {
+                    scatter[v].buf = io_info->u.rbuf;
+                    scatter[v].nbytes = chunk_info->chunk_points * type_info->src_type_size;
+                    window[v].scatter = &scatter[v];
+                } /* end if */
+            } /* end for */
+
+        /* Unfilter the chunks, copying their elements out where possible */
+        if(H5D__chunk_filter_batch(io_info, window, nwindow, H5Z_FLAG_REVERSE) < 0)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "data pipeline read failed")
+
+        /* Hand the chunks over to the chunk cache */
+        for(v = 0; v < nwindow; v++) {
+            H5D_chunk_batch_ent_t *bent = &window[v];  /* Chunk's entry in the window */
+            H5D_chunk_info_t *chunk_info = bent->chunk_info;   /* Chunk information */
+            void        *chunk_buf = bent->chunk;   /* Chunk's unfiltered data */
+            void        *chunk;         /* Pointer to locked chunk buffer */
+            uint32_t    src_accessed_bytes;     /* Total accessed size in the chunk */
+
+            /* Set chunk's [scaled] coordinates */
+            io_info->store->chunk.scaled = chunk_info->scaled;
+
+            /* Lock the chunk into the cache, which takes over its buffer */
+            bent->chunk = NULL;
+            if(NULL == (chunk = H5D__chunk_lock(io_info, &bent->udata, FALSE, FALSE, chunk_buf)))
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
+
+            /* Read the chunk's elements, if they weren't copied yet */
+            if(NULL == bent->scatter) {
+                cpt_io_info->store->compact.buf = chunk;
+                if((io_info->io_ops.single_read)(cpt_io_info, type_info,
+                        (hsize_t)chunk_info->chunk_points, chunk_info->fspace, chunk_info->mspace) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "chunked read failed")
+            } /* end if */
+
+            /* Release the cache lock on the chunk */
+            H5_CHECK_OVERFLOW(type_info->src_type_size, /*From:*/ size_t, /*To:*/ uint32_t);
+            src_accessed_bytes = chunk_info->chunk_points * (uint32_t)type_info->src_type_size;
+            if(H5D__chunk_unlock(io_info, &bent->udata, FALSE, chunk, src_accessed_bytes) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to unlock raw data chunk")
+
+            sorted[u + v]->done = TRUE;
+        } /* end for */
+        nwindow = 0;
+    } /* end for */
+
+done:
+    /* Release the chunks of an unfinished window */
+    if(window) {
+        H5D__chunk_free_batch(io_info, window, nwindow);
+        window = (H5D_chunk_batch_ent_t *)H5MM_xfree(window);
+    } /* end if */
+    scatter = (H5D_chunk_scatter_t *)H5MM_xfree(scatter);
+    types = (H5FD_mem_t *)H5MM_xfree(types);
+    addrs = (haddr_t *)H5MM_xfree(addrs);
+    sizes = (size_t *)H5MM_xfree(sizes);
+    bufs = (void **)H5MM_xfree(bufs);
+    sorted = (H5D_chunk_batch_ent_t **)H5MM_xfree(sorted);
 
-            /* Lock the chunk into the cache */
-            if(NULL == (chunk = H5D__chunk_lock(io_info, &udata, entire_chunk, FALSE)))
-                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_read_pipeline() */
 
-            /* Set up the storage buffer information for this chunk */
-            cpt_store.compact.buf = chunk;
 
-            /* Point I/O info at main I/O info for this chunk */
-            chk_io_info = &cpt_io_info;
-        } /* end if */
-        else {
-            /* If the chunk hasn't been allocated on disk, do so now. */
-            if(!H5F_addr_defined(udata.chunk_block.offset)) {
-                /* Compose chunked index info struct */
-                idx_info.f = io_info->dset->oloc.file;
-                idx_info.dxpl_id = io_info->md_dxpl_id;
-                idx_info.pline = &(io_info->dset->shared->dcpl_cache.pline);
-                idx_info.layout = &(io_info->dset->shared->layout.u.chunk);
-                idx_info.storage = &(io_info->dset->shared->layout.storage.u.chunk);
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_write_batch
+ *
+ * Purpose:	Filter the whole chunks of a batch together on the filter
+ *		threads of the DXPL, then allocate space for them and write
+ *		them to the file in batch order, from the calling thread.
+ *		The chunk buffers are released as they are written.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_write_batch(const H5D_io_info_t *io_info, H5D_chunk_batch_ent_t *batch,
+    size_t nents)
+{
+    const H5D_t *dset = io_info->dset;  /* Local pointer to dataset info */
+    H5D_chk_idx_info_t idx_info;        /* Chunked index info */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
 
-                /* Set up the size of chunk for user data */
-                udata.chunk_block.length = io_info->dset->shared->layout.u.chunk.size;
+    FUNC_ENTER_STATIC
 
-                /* Allocate the chunk */
-		if(H5D__chunk_file_alloc(&idx_info, NULL, &udata.chunk_block, &need_insert, chunk_info->scaled) < 0)
-		    HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert/resize chunk on chunk level")
+    HDassert(batch);
 
-                /* Make sure the address of the chunk is returned. */
-                if(!H5F_addr_defined(udata.chunk_block.offset))
-                    HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "chunk address isn't defined")
+    /* Filter the chunks */
+    for(u = 0; u < nents; u++)
+        batch[u].udata.filter_mask = 0;
+    if(H5D__chunk_filter_batch(io_info, batch, nents, 0) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "output pipeline failed")
 
-                /* Cache the new chunk information */
-                H5D__chunk_cinfo_cache_update(&io_info->dset->shared->cache.chunk.last, &udata);
-            } /* end if */
+    /* Compose chunked index info struct */
+    idx_info.f = dset->oloc.file;
+    idx_info.dxpl_id = io_info->md_dxpl_id;
+    idx_info.pline = &(dset->shared->dcpl_cache.pline);
+    idx_info.layout = &(dset->shared->layout.u.chunk);
+    idx_info.storage = &(dset->shared->layout.storage.u.chunk);
 
-            /* Set up the storage address information for this chunk */
-            ctg_store.contig.dset_addr = udata.chunk_block.offset;
+    for(u = 0; u < nents; u++) {
+        H5D_chunk_batch_ent_t *bent = &batch[u];       /* Chunk's entry in the batch */
+        H5F_block_t old_block = bent->udata.chunk_block;    /* Chunk's current location in file */
+        hbool_t need_insert = FALSE;    /* Whether the chunk needs to be inserted into the index */
 
-            /* No chunk cached */
-            chunk = NULL;
+#if H5_SIZEOF_SIZE_T > 4
+        /* Check for the chunk expanding too much to encode in a 32-bit value */
+        if(bent->nbytes > ((size_t)0xffffffff))
+            HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "chunk too large for 32-bit length")
+#endif /* H5_SIZEOF_SIZE_T > 4 */
+        H5_CHECKED_ASSIGN(bent->udata.chunk_block.length, hsize_t, bent->nbytes, size_t);
 
-            /* Point I/O info at temporary I/O info for this chunk */
-            chk_io_info = &ctg_io_info;
-        } /* end else */
+        /* Create the chunk if it doesn't exist, or reallocate the chunk if
+         * its size changed */
+        if(H5D__chunk_file_alloc(&idx_info, &old_block, &bent->udata.chunk_block, &need_insert, bent->chunk_info->scaled) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert/resize chunk on chunk level")
+        HDassert(H5F_addr_defined(bent->udata.chunk_block.offset));
 
-        /* Perform the actual write operation */
-        if((io_info->io_ops.single_write)(chk_io_info, type_info,
-                (hsize_t)chunk_info->chunk_points, chunk_info->fspace, chunk_info->mspace) < 0)
-            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "chunked write failed")
+        /* Write the data to the file */
+        if(H5F_block_write(dset->oloc.file, H5FD_MEM_DRAW, bent->udata.chunk_block.offset, bent->nbytes, io_info->raw_dxpl_id, bent->chunk) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
 
-	/* Release the cache lock on the chunk, or insert chunk into index. */
-	if(chunk) {
-	    if(H5D__chunk_unlock(io_info, &udata, TRUE, chunk, dst_accessed_bytes) < 0)
-		HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to unlock raw data chunk")
-	} /* end if */
-	else {
-            if(need_insert && io_info->dset->shared->layout.storage.u.chunk.ops->insert)
-                if((io_info->dset->shared->layout.storage.u.chunk.ops->insert)(&idx_info, &udata, NULL) < 0)
-                    HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
-	} /* end else */
+        /* Insert the chunk record into the index */
+        if(need_insert && dset->shared->layout.storage.u.chunk.ops->insert)
+            if((dset->shared->layout.storage.u.chunk.ops->insert)(&idx_info, &bent->udata, dset) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
 
-        /* Advance to next chunk in list */
-        chunk_node = H5D_CHUNK_GET_NEXT_NODE(fm, chunk_node);
-    } /* end while */
+        /* Cache the chunk's info, in case it's accessed again shortly */
+        H5D__chunk_cinfo_cache_update(&dset->shared->cache.chunk.last, &bent->udata);
+
+        /* Release the chunk's buffer */
+        bent->chunk = H5D__chunk_mem_xfree(bent->chunk, &(dset->shared->dcpl_cache.pline));
+    } /* end for */
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
-} /* H5D__chunk_write() */
+} /* end H5D__chunk_write_batch() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_free_batch
+ *
+ * Purpose:	Release the chunk buffers remaining in a batch.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_free_batch(const H5D_io_info_t *io_info, H5D_chunk_batch_ent_t *batch,
+    size_t nents)
+{
+    size_t      u;                      /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < nents; u++)
+        if(batch[u].chunk)
+            batch[u].chunk = H5D__chunk_mem_xfree(batch[u].chunk, &(io_info->dset->shared->dcpl_cache.pline));
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_free_batch() */
 
 
 /*-------------------------------------------------------------------------
@@ -2283,6 +3783,10 @@ H5D__chunk_flush(H5D_t *dset, hid_t dxpl_id)
     if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
 
+    /* Write out the chunks queued behind */
+    if(H5D__chunk_wb_drain(dset, dxpl_id) < 0)
+        nerrors++;
+
     /* Loop over all entries in the chunk cache */
     for(ent = rdcc->head; ent; ent = next) {
 	next = ent->next;
@@ -2389,6 +3893,10 @@ H5D__chunk_dest(H5D_t *dset, hid_t dxpl_id)
 	if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache, ent, TRUE) < 0)
 	    nerrors++;
     } /* end for */
+
+    /* Write out the chunks queued behind, including those just evicted */
+    if(H5D__chunk_wb_drain(dset, dxpl_id) < 0)
+        nerrors++;
     
     /* Continue even if there are failures. */
     if(nerrors)
@@ -2397,6 +3905,10 @@ H5D__chunk_dest(H5D_t *dset, hid_t dxpl_id)
     /* Release cache structures */
     if(rdcc->slot)
         rdcc->slot = H5FL_SEQ_FREE(H5D_rdcc_ent_ptr_t, rdcc->slot);
+    if(rdcc->wb_queue)
+        H5SL_close(rdcc->wb_queue);
+    if(rdcc->auto_resize && rdcc->nbytes_max > rdcc->nbytes_min)
+        H5F_rdcc_budget_release(dset->oloc.file, rdcc->nbytes_max - rdcc->nbytes_min);
     HDmemset(rdcc, 0, sizeof(H5D_rdcc_t));
 
     /* Compose chunked index info struct */
@@ -2614,54 +4126,357 @@ H5D__chunk_create(const H5D_t *dset /*in,out*/, hid_t dxpl_id)
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5D__chunk_create() */
+} /* end H5D__chunk_create() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_hash_val
+ *
+ * Purpose:	To calculate an index based on the dataset's scaled coordinates and
+ *		sizes of the faster dimensions.  The index is the set of
+ *		slots in the chunk cache that the chunk may occupy.
+ *
+ * Return:	Hash value index
+ *
+ * Programmer:	Vailin Choi; Nov 2014
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+H5D__chunk_hash_val(const H5D_shared_t *shared, const hsize_t *scaled)
+{
+    hsize_t val;        /* Intermediate value */
+    unsigned ndims = shared->ndims;      /* Rank of dataset */
+    unsigned ret = 0;   /* Value to return */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(shared);
+    HDassert(scaled);
+
+    /* If the fastest changing dimension doesn't have enough entropy, use
+     *  other dimensions too
+     */
+    if(ndims > 1 && shared->cache.chunk.scaled_dims[ndims - 1] <= shared->cache.chunk.nsets) {
+        unsigned u;          /* Local index variable */
+
+        val = scaled[0];
+        for(u = 1; u < ndims; u++) {
+            val <<= shared->cache.chunk.scaled_encode_bits[u];
+            val ^= scaled[u];
+        } /* end for */
+    } /* end if */
+    else
+        val = scaled[ndims - 1];
+
+    /* Modulo value against the number of sets of slots */
+    ret = (unsigned)(val % shared->cache.chunk.nsets);
+
+    FUNC_LEAVE_NOAPI(ret)
+} /* H5D__chunk_hash_val() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_find_slot
+ *
+ * Purpose:	Choose the slot in a set of the chunk cache that a new entry
+ *		will occupy.  An empty slot is used if there is one.
+ *		Otherwise the unlocked entry in the set that should be
+ *		preempted is chosen: the least recently used entry, unless
+ *		one of the oldest W0 fraction of entries has been fully read
+ *		or written, in which case the oldest of those is chosen.
+ *		This is the same policy H5D__chunk_cache_prune() applies to
+ *		the cache as a whole.
+ *
+ * Return:	Index of the slot in the hash table, or UINT_MAX if every
+ *		slot in the set is locked.
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+H5D__chunk_cache_find_slot(const H5D_rdcc_t *rdcc, unsigned set, size_t chunk_size)
+{
+    H5D_rdcc_ent_t *lru = NULL;         /* Least recently used unlocked entry */
+    H5D_rdcc_ent_t *full = NULL;        /* Least recently used unlocked, fully accessed entry */
+    unsigned    start_idx = set * rdcc->nways;  /* Index of first slot in set */
+    unsigned    nunlocked = 0;          /* Number of unlocked entries in set */
+    unsigned    u;                      /* Local index variable */
+    unsigned    ret_value = UINT_MAX;   /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity checks */
+    HDassert(rdcc);
+    HDassert(set < rdcc->nsets);
+
+    /* Look for an empty slot, tracking preemption candidates along the way */
+    for(u = start_idx; u < start_idx + rdcc->nways; u++) {
+        H5D_rdcc_ent_t *ent = rdcc->slot[u];
+
+        if(NULL == ent)
+            HGOTO_DONE(u)
+        if(!ent->locked) {
+            nunlocked++;
+            if(NULL == lru || ent->last_access < lru->last_access)
+                lru = ent;
+            if(H5D_RDCC_ENT_FULLY_ACCESSED(ent, chunk_size) &&
+                    (NULL == full || ent->last_access < full->last_access))
+                full = ent;
+        } /* end if */
+    } /* end for */
+
+    /* Check for all the slots in the set being locked */
+    if(NULL == lru)
+        HGOTO_DONE(UINT_MAX)
+
+    /* Prefer the oldest fully accessed entry, if it's among the oldest w0
+     * fraction of the unlocked entries in the set */
+    if(full && full != lru) {
+        unsigned nolder = 0;            /* Number of unlocked entries older than 'full' */
+
+        for(u = start_idx; u < start_idx + rdcc->nways; u++)
+            if(!rdcc->slot[u]->locked && rdcc->slot[u]->last_access < full->last_access)
+                nolder++;
+        if((double)nolder < rdcc->w0 * (double)nunlocked)
+            lru = full;
+    } /* end if */
+
+    ret_value = lru->idx;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_cache_find_slot() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_addr_table_cb
+ *
+ * Purpose:	Add a chunk record from the chunk index to the address
+ *		table, if the chunk is within the table's range.
+ *
+ * Return:	H5_ITER_CONT/H5_ITER_ERROR
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_addr_table_cb(const H5D_chunk_rec_t *chunk_rec, void *_table)
+{
+    H5D_chunk_addr_table_t *table = (H5D_chunk_addr_table_t *)_table;
+    H5D_chunk_addr_t *addr;             /* Chunk's entry in the table */
+    unsigned    u;                      /* Local index variable */
+    int         ret_value = H5_ITER_CONT;   /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Skip chunks outside the range */
+    for(u = 0; u < table->ndims; u++)
+        if(chunk_rec->scaled[u] < table->start[u] || chunk_rec->scaled[u] > table->end[u])
+            HGOTO_DONE(H5_ITER_CONT)
+
+    /* Make room for the chunk */
+    if(table->nused == table->nalloc) {
+        size_t new_nalloc = MAX(64, table->nalloc * 2);     /* New number of entries */
+        H5D_chunk_addr_t *new_addrs;    /* New array of entries */
+
+        if(NULL == (new_addrs = (H5D_chunk_addr_t *)H5MM_realloc(table->addrs, new_nalloc * sizeof(H5D_chunk_addr_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, H5_ITER_ERROR, "memory allocation failed for chunk address table")
+        table->addrs = new_addrs;
+        table->nalloc = new_nalloc;
+    } /* end if */
+
+    addr = &table->addrs[table->nused++];
+    addr->chunk_index = H5VM_array_offset_pre(table->ndims, table->down_chunks, chunk_rec->scaled);
+    addr->addr = chunk_rec->chunk_addr;
+    addr->nbytes = chunk_rec->nbytes;
+    addr->filter_mask = chunk_rec->filter_mask;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_addr_table_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_addr_index_cmp
+ *
+ * Purpose:	Compare the linear indices of two chunks in an address
+ *		table, for sorting with HDqsort().
+ *
+ * Return:	-1, 0 or 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_addr_index_cmp(const void *_addr1, const void *_addr2)
+{
+    const H5D_chunk_addr_t *addr1 = (const H5D_chunk_addr_t *)_addr1;
+    const H5D_chunk_addr_t *addr2 = (const H5D_chunk_addr_t *)_addr2;
+    int ret_value = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(addr1->chunk_index < addr2->chunk_index)
+        ret_value = -1;
+    else if(addr1->chunk_index > addr2->chunk_index)
+        ret_value = 1;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_addr_index_cmp() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_addr_addr_cmp
+ *
+ * Purpose:	Compare the file addresses of two chunks in an address
+ *		table, for sorting with HDqsort().
+ *
+ * Return:	-1, 0 or 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_addr_addr_cmp(const void *_addr1, const void *_addr2)
+{
+    const H5D_chunk_addr_t *addr1 = (const H5D_chunk_addr_t *)_addr1;
+    const H5D_chunk_addr_t *addr2 = (const H5D_chunk_addr_t *)_addr2;
+    int ret_value = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(H5F_addr_lt(addr1->addr, addr2->addr))
+        ret_value = -1;
+    else if(H5F_addr_gt(addr1->addr, addr2->addr))
+        ret_value = 1;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_addr_addr_cmp() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_addr_table_build
+ *
+ * Purpose:	Look up all the stored chunks whose scaled coordinates are
+ *		between START and END (inclusive) with a single iteration
+ *		over the chunk index, into an address table sorted by the
+ *		chunks' linear indices.  The table stays valid until a chunk
+ *		is flushed from the chunk cache, which may move chunks or
+ *		add them to the index.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_addr_table_build(const H5D_t *dset, hid_t dxpl_id, const hsize_t *start,
+    const hsize_t *end, H5D_chunk_addr_table_t *table)
+{
+    H5D_chk_idx_info_t idx_info;        /* Chunked index info */
+    unsigned    u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(dset);
+    HDassert(start);
+    HDassert(end);
+    HDassert(table);
+
+    /* Set up the table */
+    table->ndims = dset->shared->layout.u.chunk.ndims - 1;
+    for(u = 0; u < table->ndims; u++) {
+        table->start[u] = start[u];
+        table->end[u] = end[u];
+    } /* end for */
+    table->down_chunks = dset->shared->layout.u.chunk.down_chunks;
+    table->nused = table->nalloc = 0;
+    table->addrs = NULL;
+    table->nflushes = dset->shared->cache.chunk.stats.nflushes;
+
+    /* Compose chunked index info struct */
+    idx_info.f = dset->oloc.file;
+    idx_info.dxpl_id = dxpl_id;
+    idx_info.pline = &dset->shared->dcpl_cache.pline;
+    idx_info.layout = &dset->shared->layout.u.chunk;
+    idx_info.storage = &dset->shared->layout.storage.u.chunk;
+
+    /* Collect the chunks */
+    if((dset->shared->layout.storage.u.chunk.ops->iterate)(&idx_info, H5D__chunk_addr_table_cb, table) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to iterate over chunk index")
+
+    /* Sort them by linear index, unless the index returned them in order */
+    for(u = 1; u < table->nused; u++)
+        if(table->addrs[u - 1].chunk_index > table->addrs[u].chunk_index) {
+            HDqsort(table->addrs, table->nused, sizeof(H5D_chunk_addr_t), H5D__chunk_addr_index_cmp);
+            break;
+        } /* end if */
+
+done:
+    if(ret_value < 0)
+        table->addrs = (H5D_chunk_addr_t *)H5MM_xfree(table->addrs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_addr_table_build() */
+
 
-
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_hash_val
- *
- * Purpose:	To calculate an index based on the dataset's scaled coordinates and
- *		sizes of the faster dimensions.
+ * Function:	H5D__chunk_addr_table_find
  *
- * Return:	Hash value index
+ * Purpose:	Find a chunk's location in an address table, filling in
+ *		the information that the chunk index's 'get_addr' callback
+ *		would.  Chunks that aren't in the table don't exist in the
+ *		file.
  *
- * Programmer:	Vailin Choi; Nov 2014
+ * Return:	void
  *
  *-------------------------------------------------------------------------
  */
-static unsigned
-H5D__chunk_hash_val(const H5D_shared_t *shared, const hsize_t *scaled)
+static void
+H5D__chunk_addr_table_find(const H5D_t *dset, const H5D_chunk_addr_table_t *table,
+    const hsize_t *scaled, H5D_chunk_ud_t *udata)
 {
-    hsize_t val;        /* Intermediate value */
-    unsigned ndims = shared->ndims;      /* Rank of dataset */
-    unsigned ret = 0;   /* Value to return */
+    const H5O_layout_chunk_t *layout = &(dset->shared->layout.u.chunk);   /* Chunk layout */
+    hsize_t     chunk_index;            /* Linear index of chunk */
+    size_t      lo, hi;                 /* Bounds of binary search */
 
     FUNC_ENTER_STATIC_NOERR
 
-    /* Sanity check */
-    HDassert(shared);
+    HDassert(table);
     HDassert(scaled);
+    HDassert(udata);
 
-    /* If the fastest changing dimension doesn't have enough entropy, use
-     *  other dimensions too
-     */
-    if(ndims > 1 && shared->cache.chunk.scaled_dims[ndims - 1] <= shared->cache.chunk.nslots) {
-        unsigned u;          /* Local index variable */
+    /* Find the chunk in the table */
+    chunk_index = H5VM_array_offset_pre(table->ndims, table->down_chunks, scaled);
+    lo = 0;
+    hi = table->nused;
+    while(lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
 
-        val = scaled[0];
-        for(u = 1; u < ndims; u++) {
-            val <<= shared->cache.chunk.scaled_encode_bits[u];
-            val ^= scaled[u];
-        } /* end for */
+        if(table->addrs[mid].chunk_index < chunk_index)
+            lo = mid + 1;
+        else
+            hi = mid;
+    } /* end while */
+    if(lo < table->nused && table->addrs[lo].chunk_index == chunk_index) {
+        udata->chunk_block.offset = table->addrs[lo].addr;
+        udata->chunk_block.length = table->addrs[lo].nbytes;
+        udata->filter_mask = table->addrs[lo].filter_mask;
     } /* end if */
-    else
-        val = scaled[ndims - 1];
 
-    /* Modulo value against the number of array slots */
-    ret = (unsigned)(val % shared->cache.chunk.nslots);
+    /* Set the chunk's position in an array index */
+    if(H5D_CHUNK_IDX_EARRAY == layout->idx_type && layout->u.earray.unlim_dim > 0) {
+        hsize_t swizzled_coords[H5O_LAYOUT_NDIMS];     /* Swizzled chunk coordinates */
+        unsigned u;                     /* Local index variable */
+
+        for(u = 0; u < table->ndims; u++)
+            swizzled_coords[u] = scaled[u] * layout->dim[u];
+        H5VM_swizzle_coords(hsize_t, swizzled_coords, layout->u.earray.unlim_dim);
+        udata->chunk_idx = H5VM_chunk_index(table->ndims, swizzled_coords, layout->u.earray.swizzled_dim, layout->u.earray.swizzled_down_chunks);
+    } /* end if */
+    else if(H5D_CHUNK_IDX_EARRAY == layout->idx_type || H5D_CHUNK_IDX_FARRAY == layout->idx_type)
+        udata->chunk_idx = H5VM_array_offset_pre(table->ndims, layout->max_down_chunks, scaled);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_addr_table_find() */
 
-    FUNC_LEAVE_NOAPI(ret)
-} /* H5D__chunk_hash_val() */
 
 
 /*-------------------------------------------------------------------------
@@ -2680,6 +4495,34 @@ H5D__chunk_hash_val(const H5D_shared_t *shared, const hsize_t *scaled)
 herr_t
 H5D__chunk_lookup(const H5D_t *dset, hid_t dxpl_id, const hsize_t *scaled,
     H5D_chunk_ud_t *udata)
+{
+    herr_t ret_value = SUCCEED;	        /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    if(H5D__chunk_lookup_table(dset, dxpl_id, NULL, scaled, udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't look up chunk")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_lookup() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_lookup_table
+ *
+ * Purpose:	Looks up a chunk like H5D__chunk_lookup.  When TABLE is
+ *              non-NULL and still valid, the location of a chunk that
+ *              isn't in the chunk cache is taken from it instead of from
+ *              the chunk index.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_lookup_table(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_chunk_addr_table_t *table, const hsize_t *scaled, H5D_chunk_ud_t *udata)
 {
     H5D_rdcc_ent_t  *ent = NULL;        /* Cache entry */
     H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
@@ -2687,7 +4530,7 @@ H5D__chunk_lookup(const H5D_t *dset, hid_t dxpl_id, const hsize_t *scaled,
     hbool_t found = FALSE;              /* In cache? */
     herr_t ret_value = SUCCEED;	        /* Return value */
 
-    FUNC_ENTER_PACKAGE
+    FUNC_ENTER_STATIC
 
     /* Sanity checks */
     HDassert(dset);
@@ -2709,24 +4552,33 @@ H5D__chunk_lookup(const H5D_t *dset, hid_t dxpl_id, const hsize_t *scaled,
 
     /* Check for chunk in cache */
     if(dset->shared->cache.chunk.nslots > 0) {
-        /* Determine the chunk's location in the hash table */
-	idx = H5D__chunk_hash_val(dset->shared, scaled);
-
-        /* Get the chunk cache entry for that location */
-        ent = dset->shared->cache.chunk.slot[idx];
-        if(ent) {
-            unsigned u;                  /* Counter */
-
-            /* Speculatively set the 'found' flag */
-            found = TRUE;
-
-            /* Verify that the cache entry is the correct chunk */
-            for(u = 0; u < dset->shared->ndims; u++)
-                if(scaled[u] != ent->scaled[u]) {
-                    found = FALSE;
+        const H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);  /* Raw data chunk cache */
+        unsigned end_idx;               /* Index of slot after the chunk's set */
+
+        /* Determine the location of the chunk's set in the hash table */
+	idx = H5D__chunk_hash_val(dset->shared, scaled) * rdcc->nways;
+        end_idx = idx + rdcc->nways;
+
+        /* Search the set for the chunk */
+        for(; idx < end_idx; idx++) {
+            /* Get the chunk cache entry for this location */
+            ent = rdcc->slot[idx];
+            if(ent) {
+                unsigned u;                  /* Counter */
+
+                /* Speculatively set the 'found' flag */
+                found = TRUE;
+
+                /* Verify that the cache entry is the correct chunk */
+                for(u = 0; u < dset->shared->ndims; u++)
+                    if(scaled[u] != ent->scaled[u]) {
+                        found = FALSE;
+                        break;
+                    } /* end if */
+                if(found)
                     break;
-                } /* end if */
-        } /* end if */
+            } /* end if */
+        } /* end for */
     } /* end if */
 
     /* Retrieve chunk addr */
@@ -2740,8 +4592,24 @@ H5D__chunk_lookup(const H5D_t *dset, hid_t dxpl_id, const hsize_t *scaled,
         /* Invalidate idx_hint, to signal that the chunk is not in cache */
         udata->idx_hint = UINT_MAX;
 
+        /* Write out the queued chunks if this chunk is among them, so it
+         * can be found in the index */
+        if(dset->shared->cache.chunk.wb_queue
+                && H5SL_count(dset->shared->cache.chunk.wb_queue) > 0) {
+            hsize_t key[H5O_LAYOUT_NDIMS];      /* Chunk's zero-padded scaled coordinates */
+
+            HDmemset(key, 0, sizeof(key));
+            HDmemcpy(key, scaled, dset->shared->ndims * sizeof(hsize_t));
+            if(H5SL_search(dset->shared->cache.chunk.wb_queue, key))
+                if(H5D__chunk_wb_drain(dset, dxpl_id) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write queued chunks")
+        } /* end if */
+
+        /* Check the address table, if it's still valid */
+        if(table && table->nflushes == dset->shared->cache.chunk.stats.nflushes)
+            H5D__chunk_addr_table_find(dset, table, scaled, udata);
         /* Check for cached information */
-        if(!H5D__chunk_cinfo_cache_found(&dset->shared->cache.chunk.last, udata)) {
+        else if(!H5D__chunk_cinfo_cache_found(&dset->shared->cache.chunk.last, udata)) {
             H5D_chk_idx_info_t idx_info;        /* Chunked index info */
 #ifdef H5_HAVE_PARALLEL
             H5P_coll_md_read_flag_t temp_cmr;   /* Temp value to hold the coll metadata read setting */
@@ -2781,7 +4649,7 @@ H5D__chunk_lookup(const H5D_t *dset, hid_t dxpl_id, const hsize_t *scaled,
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
-} /* H5D__chunk_lookup() */
+} /* H5D__chunk_lookup_table() */
 
 
 /*-------------------------------------------------------------------------
@@ -2988,6 +4856,7 @@ H5D__chunk_cache_evict(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
     H5D_rdcc_ent_t *ent, hbool_t flush)
 {
     H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);
+    hbool_t     queued = FALSE;         /* Whether the entry was queued to be written behind */
     herr_t      ret_value = SUCCEED;       /* Return value */
 
     FUNC_ENTER_STATIC
@@ -2998,7 +4867,17 @@ H5D__chunk_cache_evict(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
     HDassert(!ent->locked);
     HDassert(ent->idx < rdcc->nslots);
 
-    if(flush) {
+    /* Queue dirty filtered chunks to be written behind, if possible */
+    if(flush && ent->dirty && ent->chunk && rdcc->wb_nbytes_max > 0
+            && !ent->edge_chunk_state) {
+        if(H5D__chunk_wb_queue(dset, dxpl_id, dxpl_cache, ent) < 0) {
+	    HDONE_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot queue indexed storage buffer")
+            ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk, &(dset->shared->dcpl_cache.pline));
+        } /* end if */
+        else
+            queued = TRUE;
+    } /* end if */
+    else if(flush) {
 	/* Flush */
 	if(H5D__chunk_flush_entry(dset, dxpl_id, dxpl_cache, ent, TRUE) < 0)
 	    HDONE_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
@@ -3043,12 +4922,227 @@ H5D__chunk_cache_evict(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
     rdcc->nbytes_used -= dset->shared->layout.u.chunk.size;
     --rdcc->nused;
 
-    /* Free */
-    ent = H5FL_FREE(H5D_rdcc_ent_t, ent);
+    /* Free, unless the write-behind queue holds the entry now */
+    if(!queued)
+        ent = H5FL_FREE(H5D_rdcc_ent_t, ent);
 
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_cache_evict() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_wb_cmp
+ *
+ * Purpose:     Compare the scaled coordinates of two chunks in the
+ *              write-behind queue.  Coordinates past the dataset's rank
+ *              are always zero.
+ *
+ * Return:      -1, 0 or 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_wb_cmp(const void *_scaled1, const void *_scaled2)
+{
+    const hsize_t *scaled1 = (const hsize_t *)_scaled1;
+    const hsize_t *scaled2 = (const hsize_t *)_scaled2;
+    unsigned    u;                      /* Local index variable */
+    int         ret_value = 0;          /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < H5O_LAYOUT_NDIMS; u++)
+        if(scaled1[u] != scaled2[u]) {
+            ret_value = scaled1[u] < scaled2[u] ? -1 : 1;
+            break;
+        } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_wb_cmp() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_wb_queue
+ *
+ * Purpose:     Add a dirty chunk which is being evicted from the cache to
+ *              the write-behind queue, which takes over the entry and its
+ *              unfiltered buffer.  The queue is drained first if it has
+ *              no room for the chunk.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_wb_queue(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *ent)
+{
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);   /* Raw data chunk cache */
+    size_t      chunk_size = (size_t)dset->shared->layout.u.chunk.size;  /* Size of a chunk */
+    unsigned    u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(dxpl_cache);
+    HDassert(ent);
+    HDassert(ent->dirty);
+    HDassert(dset->shared->dcpl_cache.pline.nused > 0);
+
+    /* Make room for the chunk */
+    if(rdcc->wb_nbytes_used + chunk_size > rdcc->wb_nbytes_max)
+        if(H5D__chunk_wb_drain(dset, dxpl_id) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write queued chunks")
+
+    /* Create the queue, the first time it's used */
+    if(NULL == rdcc->wb_queue)
+        if(NULL == (rdcc->wb_queue = H5SL_create(H5SL_TYPE_GENERIC, H5D__chunk_wb_cmp)))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTCREATE, FAIL, "can't create write-behind queue")
+
+    /* Clear the coordinates past the dataset's rank, for comparisons */
+    for(u = dset->shared->ndims; u < H5O_LAYOUT_NDIMS; u++)
+        ent->scaled[u] = 0;
+
+    if(H5SL_insert(rdcc->wb_queue, ent, ent->scaled) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "can't insert chunk into write-behind queue")
+    rdcc->wb_nbytes_used += chunk_size;
+
+    /* Filter the queued chunks the way this write would have */
+    rdcc->wb_err_detect = dxpl_cache->err_detect;
+    rdcc->wb_filter_cb = dxpl_cache->filter_cb;
+    rdcc->wb_filter_threads = dxpl_cache->filter_threads;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_wb_queue() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_wb_drain
+ *
+ * Purpose:     Write out the chunks in the write-behind queue.  They are
+ *              filtered together on the filter threads, then allocated,
+ *              written and inserted into the index in the order of their
+ *              scaled coordinates, from the calling thread.  The queue is
+ *              left empty, even on failure.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_wb_drain(const H5D_t *dset, hid_t dxpl_id)
+{
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);   /* Raw data chunk cache */
+    const H5O_pline_t *pline = &(dset->shared->dcpl_cache.pline);  /* I/O pipeline info */
+    H5D_chk_idx_info_t idx_info;        /* Chunked index info */
+    H5D_rdcc_ent_t **ents = NULL;       /* Queued entries, in order */
+    H5Z_pipeline_job_t *jobs = NULL;    /* Buffers for the filter pipeline */
+    size_t      nents = 0;              /* Number of queued entries */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC_TAG(dxpl_id, dset->oloc.addr, FAIL)
+
+    if(NULL == rdcc->wb_queue || 0 == (nents = H5SL_count(rdcc->wb_queue)))
+        HGOTO_DONE(SUCCEED)
+
+    /* Take the entries off the queue */
+    if(NULL == (ents = (H5D_rdcc_ent_t **)H5MM_calloc(nents * sizeof(H5D_rdcc_ent_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for queued chunks")
+    if(NULL == (jobs = (H5Z_pipeline_job_t *)H5MM_calloc(nents * sizeof(H5Z_pipeline_job_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for filter jobs")
+    for(u = 0; u < nents; u++) {
+        ents[u] = (H5D_rdcc_ent_t *)H5SL_remove_first(rdcc->wb_queue);
+        HDassert(ents[u]);
+
+        /* Hand the chunk's buffer to the pipeline */
+        jobs[u].nbytes = jobs[u].buf_size = (size_t)dset->shared->layout.u.chunk.size;
+        jobs[u].buf = ents[u]->chunk;
+        ents[u]->chunk = NULL;
+    } /* end for */
+    rdcc->wb_nbytes_used = 0;
+
+    /* Filter the chunks */
+    if(H5Z_pipeline_batch(pline, 0, rdcc->wb_err_detect, rdcc->wb_filter_cb,
+            rdcc->wb_filter_threads, nents, jobs) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "output pipeline failed")
+
+    /* Compose chunked index info struct */
+    idx_info.f = dset->oloc.file;
+    idx_info.dxpl_id = dxpl_id;
+    idx_info.pline = pline;
+    idx_info.layout = &dset->shared->layout.u.chunk;
+    idx_info.storage = &dset->shared->layout.storage.u.chunk;
+
+    for(u = 0; u < nents; u++) {
+        H5D_rdcc_ent_t *ent = ents[u];  /* Queued entry */
+        H5D_chunk_ud_t udata;           /* Index pass-through */
+        hbool_t need_insert = FALSE;    /* Whether the chunk needs to be inserted into the index */
+
+#if H5_SIZEOF_SIZE_T > 4
+        /* Check for the chunk expanding too much to encode in a 32-bit value */
+        if(jobs[u].nbytes > ((size_t)0xffffffff))
+            HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "chunk too large for 32-bit length")
+#endif /* H5_SIZEOF_SIZE_T > 4 */
+
+        /* Set up user data for index callbacks */
+        udata.common.layout = &dset->shared->layout.u.chunk;
+        udata.common.storage = &dset->shared->layout.storage.u.chunk;
+        udata.common.scaled = ent->scaled;
+        udata.chunk_block.offset = ent->chunk_block.offset;
+        H5_CHECKED_ASSIGN(udata.chunk_block.length, hsize_t, jobs[u].nbytes, size_t);
+        udata.filter_mask = jobs[u].filter_mask;
+        udata.chunk_idx = ent->chunk_idx;
+
+        /* Create the chunk if it doesn't exist, or reallocate the chunk if
+         * its size changed */
+        if(H5D__chunk_file_alloc(&idx_info, &(ent->chunk_block), &udata.chunk_block, &need_insert, ent->scaled) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert/resize chunk on chunk level")
+        HDassert(H5F_addr_defined(udata.chunk_block.offset));
+
+        /* Write the data to the file */
+        if(H5F_block_write(dset->oloc.file, H5FD_MEM_DRAW, udata.chunk_block.offset, jobs[u].nbytes, H5AC_rawdata_dxpl_id, jobs[u].buf) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
+
+        /* Insert the chunk record into the index */
+        if(need_insert && dset->shared->layout.storage.u.chunk.ops->insert)
+            if((dset->shared->layout.storage.u.chunk.ops->insert)(&idx_info, &udata, dset) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
+
+        /* Cache the chunk's info, in case it's accessed again shortly */
+        H5D__chunk_cinfo_cache_update(&rdcc->last, &udata);
+
+        /* Increment # of flushed entries */
+        rdcc->stats.nflushes++;
+    } /* end for */
+
+done:
+    /* Release the entries, written or not */
+    if(ents) {
+        for(u = 0; u < nents; u++)
+            if(ents[u]) {
+                jobs[u].buf = H5D__chunk_mem_xfree(jobs[u].buf, pline);
+                ents[u] = H5FL_FREE(H5D_rdcc_ent_t, ents[u]);
+            } /* end if */
+        ents = (H5D_rdcc_ent_t **)H5MM_xfree(ents);
+    } /* end if */
+    jobs = (H5Z_pipeline_job_t *)H5MM_xfree(jobs);
+
+    /* Drop any chunks still queued after a failure */
+    if(ret_value < 0 && rdcc->wb_queue) {
+        H5D_rdcc_ent_t *ent;            /* Queued entry */
+
+        while(NULL != (ent = (H5D_rdcc_ent_t *)H5SL_remove_first(rdcc->wb_queue))) {
+            ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk, pline);
+            ent = H5FL_FREE(H5D_rdcc_ent_t, ent);
+        } /* end while */
+        rdcc->wb_nbytes_used = 0;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__chunk_wb_drain() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__chunk_cache_prune
@@ -3108,9 +5202,7 @@ H5D__chunk_cache_prune(const H5D_t *dset, hid_t dxpl_id,
 	/* Give each method a chance */
 	for(i = 0; i < nmeth && (rdcc->nbytes_used + size) > total; i++) {
 	    if(0 == i && p[0] && !p[0]->locked &&
-                    ((0 == p[0]->rd_count && 0 == p[0]->wr_count) ||
-                     (0 == p[0]->rd_count && dset->shared->layout.u.chunk.size == p[0]->wr_count) ||
-                     (dset->shared->layout.u.chunk.size == p[0]->rd_count && 0 == p[0]->wr_count))) {
+                    H5D_RDCC_ENT_FULLY_ACCESSED(p[0], dset->shared->layout.u.chunk.size)) {
 		/*
 		 * Method 0: Preempt entries that have been completely written
 		 * and/or completely read but not entries that are partially
@@ -3157,6 +5249,96 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_cache_prune() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_auto_resize
+ *
+ * Purpose:	At the end of each epoch of H5D_CHUNK_CACHE_EPOCH_LENGTH
+ *		chunk accesses, resize the chunk cache for the hit rate of
+ *		the epoch.  Below H5D_CHUNK_CACHE_LOWER_HR, the cache doubles
+ *		(or grows to hold one chunk), as far as the file's budget
+ *		for chunk caches allows.  Above H5D_CHUNK_CACHE_UPPER_HR, the
+ *		chunks not accessed for the last H5D_CHUNK_CACHE_AGE_EPOCHS
+ *		epochs are evicted and the cache shrinks to the chunks left,
+ *		but never below its original size.  The number of slots
+ *		doesn't change.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_auto_resize(const H5D_io_info_t *io_info)
+{
+    const H5D_t *dset = io_info->dset;  /* Dataset whose cache is resized */
+    H5D_rdcc_t	*rdcc = &(dset->shared->cache.chunk);   /* Dataset's chunk cache */
+    unsigned    naccesses;              /* Chunk accesses so far */
+    unsigned    epoch_naccesses;        /* Chunk accesses in the epoch */
+    double      hit_rate;               /* Hit rate of the epoch */
+    unsigned    ring_idx;               /* Index of the oldest epoch in the ring */
+    herr_t	ret_value = SUCCEED;	/* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(rdcc->auto_resize);
+    HDassert(rdcc->nslots > 0);
+
+    /* Check for the end of the epoch */
+    naccesses = rdcc->stats.nhits + rdcc->stats.nmisses + rdcc->stats.nbypasses;
+    epoch_naccesses = naccesses - rdcc->epoch_naccesses;
+    if(epoch_naccesses < H5D_CHUNK_CACHE_EPOCH_LENGTH)
+        HGOTO_DONE(SUCCEED)
+    hit_rate = (double)(rdcc->stats.nhits - rdcc->epoch_nhits) / (double)epoch_naccesses;
+    ring_idx = rdcc->nepochs % H5D_CHUNK_CACHE_AGE_EPOCHS;
+
+    if(hit_rate < H5D_CHUNK_CACHE_LOWER_HR) {
+        size_t chunk_size = (size_t)dset->shared->layout.u.chunk.size;
+        size_t new_max;                 /* Size the cache grows to */
+
+        /* Double the cache, or grow it to hold one chunk */
+        new_max = MAX(2 * rdcc->nbytes_max, chunk_size);
+        if(new_max > rdcc->nbytes_max) {
+            size_t granted = H5F_rdcc_budget_reserve(dset->oloc.file, new_max - rdcc->nbytes_max);
+
+            if(granted > 0) {
+                rdcc->nbytes_max += granted;
+                rdcc->stats.nresizes++;
+            } /* end if */
+        } /* end if */
+    } /* end if */
+    else if(hit_rate > H5D_CHUNK_CACHE_UPPER_HR && rdcc->nepochs >= H5D_CHUNK_CACHE_AGE_EPOCHS
+            && rdcc->nbytes_max > rdcc->nbytes_min) {
+        hsize_t     threshold = rdcc->epoch_ticks[ring_idx];    /* Last access before the oldest epoch */
+        H5D_rdcc_ent_t *ent, *next;     /* Cache entries */
+        size_t      new_max;            /* Size the cache shrinks to */
+
+        /* Evict the chunks not accessed since the oldest epoch in the ring */
+        for(ent = rdcc->head; ent; ent = next) {
+            next = ent->next;
+            if(!ent->locked && ent->last_access <= threshold)
+                if(H5D__chunk_cache_evict(dset, io_info->md_dxpl_id, io_info->dxpl_cache, ent, TRUE) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt chunk from cache")
+        } /* end for */
+
+        /* Give the room no longer needed back to the file's budget */
+        new_max = MAX(rdcc->nbytes_used, rdcc->nbytes_min);
+        if(new_max < rdcc->nbytes_max) {
+            H5F_rdcc_budget_release(dset->oloc.file, rdcc->nbytes_max - new_max);
+            rdcc->nbytes_max = new_max;
+            rdcc->stats.nresizes++;
+        } /* end if */
+    } /* end if */
+
+    /* Start the next epoch */
+    rdcc->epoch_nhits = rdcc->stats.nhits;
+    rdcc->epoch_naccesses = naccesses;
+    rdcc->epoch_ticks[ring_idx] = rdcc->ticks;
+    rdcc->nepochs++;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_auto_resize() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__chunk_lock
@@ -3176,6 +5358,12 @@ done:
  *		for output functions that are about to overwrite the entire
  *		chunk.
  *
+ *		If CHUNK_BUF is non-NULL, it holds the chunk's data already
+ *		read from the file and run back through the filter pipeline
+ *		by the caller (see H5D__chunk_read_pipeline), and is used in
+ *		place of reading the chunk.  The chunk must not be in the
+ *		cache.  This routine takes ownership of the buffer.
+ *
  * Return:	Success:	Ptr to a file chunk.
  *
  *		Failure:	NULL
@@ -3187,7 +5375,7 @@ done:
  */
 static void *
 H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
-    hbool_t relax, hbool_t prev_unfilt_chunk)
+    hbool_t relax, hbool_t prev_unfilt_chunk, void *chunk_buf)
 {
     const H5D_t         *dset = io_info->dset;  /* Local pointer to the dataset info */
     const H5O_pline_t   *pline = &(dset->shared->dcpl_cache.pline); /* I/O pipeline info - always equal to the pline passed to H5D__chunk_mem_alloc */
@@ -3214,6 +5402,8 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
     HDassert(TRUE == H5P_isa_class(io_info->raw_dxpl_id, H5P_DATASET_XFER));
     HDassert(!(udata->new_unfilt_chunk && prev_unfilt_chunk));
     HDassert(!rdcc->tmp_head);
+    HDassert(!chunk_buf || (UINT_MAX == udata->idx_hint && !relax
+            && !prev_unfilt_chunk && !udata->new_unfilt_chunk));
 
     /* Get the chunk's size */
     HDassert(layout->u.chunk.size > 0);
@@ -3242,6 +5432,7 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
          * Already in the cache.  Count a hit.
          */
         rdcc->stats.nhits++;
+        ent->last_access = ++rdcc->ticks;
 
         /* Make adjustments if the edge chunk status changed recently */
         if(pline->nused) {
@@ -3386,8 +5577,19 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
              *      or an init if it isn't.
              */
 
+            /* Check if the chunk was already read and unfiltered */
+            if(chunk_buf) {
+                HDassert(H5F_addr_defined(chunk_addr));
+                HDassert(old_pline && old_pline->nused);
+
+                chunk = chunk_buf;
+                chunk_buf = NULL;
+
+                /* Increment # of cache misses */
+                rdcc->stats.nmisses++;
+            } /* end if */
             /* Check if the chunk exists on disk */
-            if(H5F_addr_defined(chunk_addr)) {
+            else if(H5F_addr_defined(chunk_addr)) {
                 size_t my_chunk_alloc = chunk_alloc;	/* Allocated buffer size */
                 size_t buf_alloc = chunk_alloc;	        /* [Re-]allocated buffer size */
 
@@ -3469,14 +5671,16 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
 
         /* See if the chunk can be cached */
         if(rdcc->nslots > 0 && chunk_size <= rdcc->nbytes_max) {
-            /* Calculate the index */
-            udata->idx_hint = H5D__chunk_hash_val(io_info->dset->shared, udata->common.scaled);
-
-            /* Add the chunk to the cache only if the slot is not already locked */
-            ent = rdcc->slot[udata->idx_hint];
-            if(!ent || !ent->locked) {
+            /* Choose a slot in the chunk's set */
+            udata->idx_hint = H5D__chunk_cache_find_slot(rdcc,
+                    H5D__chunk_hash_val(io_info->dset->shared, udata->common.scaled),
+                    chunk_size);
+
+            /* Add the chunk to the cache only if a slot in the set is not
+             * locked */
+            if(UINT_MAX != udata->idx_hint) {
                 /* Preempt enough things from the cache to make room */
-                if(ent) {
+                if(NULL != (ent = rdcc->slot[udata->idx_hint])) {
                     if(H5D__chunk_cache_evict(io_info->dset, io_info->md_dxpl_id, io_info->dxpl_cache, ent, TRUE) < 0)
                         HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk from cache")
                 } /* end if */
@@ -3499,6 +5703,7 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
                 H5_CHECKED_ASSIGN(ent->rd_count, uint32_t, chunk_size, size_t);
                 H5_CHECKED_ASSIGN(ent->wr_count, uint32_t, chunk_size, size_t);
                 ent->chunk = (uint8_t *)chunk;
+                ent->last_access = ++rdcc->ticks;
 
                 /* Add it to the cache */
                 HDassert(NULL == rdcc->slot[udata->idx_hint]);
@@ -3554,6 +5759,10 @@ done:
         if(chunk)
             chunk = H5D__chunk_mem_xfree(chunk, pline);
 
+    /* Release the caller's chunk buffer, if it wasn't used */
+    if(chunk_buf)
+        chunk_buf = H5D__chunk_mem_xfree(chunk_buf, pline);
+
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_lock() */
 
@@ -3728,6 +5937,10 @@ H5D__chunk_allocated(H5D_t *dset, hid_t dxpl_id, hsize_t *nbytes)
     if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
 
+    /* Write out the chunks queued behind */
+    if(H5D__chunk_wb_drain(dset, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write queued chunks")
+
     /* Search for cached chunks that haven't been written out */
     for(ent = rdcc->head; ent; ent = ent->next) {
         /* Flush the chunk out to disk, to make certain the size is correct later */
@@ -4344,7 +6557,7 @@ H5D__chunk_update_old_edge_chunks(H5D_t *dset, hid_t dxpl_id, hsize_t old_dim[])
                     || (UINT_MAX != chk_udata.idx_hint)) {
                 /* Lock the chunk into cache.  H5D__chunk_lock will take care of
                 * updating the chunk to no longer be an edge chunk. */
-                if(NULL == (chunk = (void *)H5D__chunk_lock(&chk_io_info, &chk_udata, FALSE, TRUE)))
+                if(NULL == (chunk = (void *)H5D__chunk_lock(&chk_io_info, &chk_udata, FALSE, TRUE, NULL)))
                     HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to lock raw data chunk")
 
                 /* Unlock the chunk */
@@ -4612,7 +6825,7 @@ H5D__chunk_prune_fill(H5D_chunk_it_ud1_t *udata, hbool_t new_unfilt_chunk)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTSELECT, FAIL, "unable to select hyperslab")
 
     /* Lock the chunk into the cache, to get a pointer to the chunk buffer */
-    if(NULL == (chunk = (void *)H5D__chunk_lock(io_info, &chk_udata, FALSE, FALSE)))
+    if(NULL == (chunk = (void *)H5D__chunk_lock(io_info, &chk_udata, FALSE, FALSE, NULL)))
         HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to lock raw data chunk")
 
 
@@ -5277,7 +7490,7 @@ herr_t
 H5D__chunk_update_cache(H5D_t *dset, hid_t dxpl_id)
 {
     H5D_rdcc_t         *rdcc = &(dset->shared->cache.chunk);	/*raw data chunk cache */
-    H5D_rdcc_ent_t     *ent, *next;	/*cache entry  */
+    H5D_rdcc_ent_t     *ent;	        /*cache entry  */
     H5D_rdcc_ent_t     tmp_head;        /* Sentinel entry for temporary entry list */
     H5D_rdcc_ent_t     *tmp_tail;       /* Tail pointer for temporary entry list */
     H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
@@ -5302,59 +7515,42 @@ H5D__chunk_update_cache(H5D_t *dset, hid_t dxpl_id)
     rdcc->tmp_head = &tmp_head;
     tmp_tail = &tmp_head;
 
-    /* Recompute the index for each cached chunk that is in a dataset */
-    for(ent = rdcc->head; ent; ent = next) {
-        unsigned	    old_idx;	/* Previous index number	*/
-
-        /* Get the pointer to the next cache entry */
-        next = ent->next;
-
-        /* Compute the index for the chunk entry */
-        old_idx = ent->idx;   /* Save for later */
-        ent->idx = H5D__chunk_hash_val(dset->shared, ent->scaled);
-
-        if(old_idx != ent->idx) {
-            H5D_rdcc_ent_t     *old_ent;	/* Old cache entry  */
-
-            /* Check if there is already a chunk at this chunk's new location */
-            old_ent = rdcc->slot[ent->idx];
-            if(old_ent != NULL) {
-                HDassert(old_ent->locked == FALSE);
-                HDassert(old_ent->deleted == FALSE);
-
-                /* Insert the old entry into the temporary list, but do not
-                 * evict (yet).  Make sure we do not make any calls to the index
-                 * until all chunks have updated indices! */
-                HDassert(!old_ent->tmp_next);
-                HDassert(!old_ent->tmp_prev);
-                tmp_tail->tmp_next = old_ent;
-                old_ent->tmp_prev = tmp_tail;
-                tmp_tail = old_ent;
-            } /* end if */
+    /* Remove all the entries from the hash table, since the set for any of
+     *  them may have changed */
+    if(rdcc->slot)
+        HDmemset(rdcc->slot, 0, rdcc->nslots * sizeof(H5D_rdcc_ent_t *));
+
+    /* Re-insert each cached chunk into its (possibly new) set, starting with
+     *  the most recently used.  Chunks which don't fit in their set are put on
+     *  the temporary list, but not evicted (yet).  Make sure we do not make any
+     *  calls to the index until all chunks have updated indices!
+     */
+    for(ent = rdcc->tail; ent; ent = ent->prev) {
+        unsigned idx;           /* Index of slot in hash table */
+        unsigned end_idx;       /* Index of slot after chunk's set */
+
+        HDassert(ent->locked == FALSE);
+        HDassert(ent->deleted == FALSE);
+        HDassert(!ent->tmp_next);
+        HDassert(!ent->tmp_prev);
+
+        /* Look for an empty slot in the chunk's set */
+        idx = H5D__chunk_hash_val(dset->shared, ent->scaled) * rdcc->nways;
+        for(end_idx = idx + rdcc->nways; idx < end_idx; idx++)
+            if(NULL == rdcc->slot[idx])
+                break;
 
+        if(idx < end_idx) {
             /* Insert this chunk into correct location in hash table */
-            rdcc->slot[ent->idx] = ent;
-
-            /* If this chunk was previously on the temporary list and therefore
-             * not in the hash table, remove it from the temporary list.
-             * Otherwise clear the old hash table slot. */
-            if(ent->tmp_prev) {
-                HDassert(tmp_head.tmp_next);
-                HDassert(tmp_tail != &tmp_head);
-                ent->tmp_prev->tmp_next = ent->tmp_next;
-                if(ent->tmp_next) {
-                    ent->tmp_next->tmp_prev = ent->tmp_prev;
-                    ent->tmp_next = NULL;
-                } /* end if */
-                else {
-                    HDassert(tmp_tail == ent);
-                    tmp_tail = ent->tmp_prev;
-                } /* end else */
-                ent->tmp_prev = NULL;
-            } /* end if */
-            else
-                rdcc->slot[old_idx] = NULL;
+            rdcc->slot[idx] = ent;
+            ent->idx = idx;
         } /* end if */
+        else {
+            /* Insert the entry into the temporary list */
+            tmp_tail->tmp_next = ent;
+            ent->tmp_prev = tmp_tail;
+            tmp_tail = ent;
+        } /* end else */
     } /* end for */
 
     /* tmp_tail is no longer needed, and will be invalidated by
@@ -6262,28 +8458,10 @@ H5D__chunk_file_alloc(const H5D_chk_idx_info_t *idx_info, const H5F_block_t *old
 
     /* Check for filters on chunks */
     if(idx_info->pline->nused > 0) {
-        /* Sanity/error checking block */
+        /* Sanity/error checking */
 	HDassert(idx_info->storage->idx_type != H5D_CHUNK_IDX_NONE);
-        {
-            unsigned allow_chunk_size_len;          /* Allowed size of encoded chunk size */
-            unsigned new_chunk_size_len;            /* Size of encoded chunk size */
-
-            /* Compute the size required for encoding the size of a chunk, allowing
-             * for an extra byte, in case the filter makes the chunk larger.
-             */
-            allow_chunk_size_len = 1 + ((H5VM_log2_gen((uint64_t)(idx_info->layout->size)) + 8) / 8);
-            if(allow_chunk_size_len > 8)
-                allow_chunk_size_len = 8;
-
-            /* Compute encoded size of chunk */
-            new_chunk_size_len = (H5VM_log2_gen((uint64_t)(new_chunk->length)) + 8) / 8;
-            if(new_chunk_size_len > 8)
-                HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "encoded chunk size is more than 8 bytes?!?")
-
-            /* Check if the chunk became too large to be encoded */
-            if(new_chunk_size_len > allow_chunk_size_len)
-                HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "chunk size can't be encoded")
-        } /* end block */
+        if(H5D__chunk_check_size_len(idx_info, new_chunk->length) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "invalid chunk size")
 
 	if(old_chunk && H5F_addr_defined(old_chunk->offset)) {
 	    /* Sanity check */
@@ -6359,6 +8537,49 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5D__chunk_file_alloc() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_check_size_len()
+ *
+ * Purpose:     Check that the size of a filtered chunk can be encoded in
+ *              the chunk index.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_check_size_len(const H5D_chk_idx_info_t *idx_info, hsize_t length)
+{
+    unsigned allow_chunk_size_len;      /* Allowed size of encoded chunk size */
+    unsigned new_chunk_size_len;        /* Size of encoded chunk size */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(idx_info);
+    HDassert(idx_info->layout);
+
+    /* Compute the size required for encoding the size of a chunk, allowing
+     * for an extra byte, in case the filter makes the chunk larger.
+     */
+    allow_chunk_size_len = 1 + ((H5VM_log2_gen((uint64_t)(idx_info->layout->size)) + 8) / 8);
+    if(allow_chunk_size_len > 8)
+        allow_chunk_size_len = 8;
+
+    /* Compute encoded size of chunk */
+    new_chunk_size_len = (H5VM_log2_gen((uint64_t)length) + 8) / 8;
+    if(new_chunk_size_len > 8)
+        HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "encoded chunk size is more than 8 bytes?!?")
+
+    /* Check if the chunk became too large to be encoded */
+    if(new_chunk_size_len > allow_chunk_size_len)
+        HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "chunk size can't be encoded")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_check_size_len() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5D__chunk_format_convert_cb
@@ -41,6 +41,7 @@
 #include "H5FLprivate.h"	/* Free Lists                           */
 #include "H5Iprivate.h"		/* IDs			  		*/
 #include "H5MFprivate.h"	/* File memory management		*/
+#include "H5MMprivate.h"	/* Memory management			*/
 #include "H5Oprivate.h"		/* Object headers		  	*/
 #include "H5Pprivate.h"		/* Property lists			*/
 #include "H5VMprivate.h"		/* Vector and array functions		*/
@@ -50,6 +51,12 @@
 /* Local Macros */
 /****************/
 
+/* Initial # of blocks allocated for a vector of deferred I/O */
+#define H5D_IO_VEC_INIT_NALLOC  32
+
+/* Max. # of blocks deferred before the vector is passed to the file driver */
+#define H5D_IO_VEC_MAX_NUSED    1024
+
 
 /******************/
 /* Local Typedefs */
@@ -62,6 +69,7 @@ typedef struct H5D_contig_readvv_sieve_ud_t {
     const H5D_contig_storage_t *store_contig;    /* Contiguous storage info for this I/O operation */
     unsigned char *rbuf;        /* Pointer to buffer to fill */
     hid_t dxpl_id;              /* DXPL for operation */
+    H5D_io_vec_t *vec;          /* Deferred blocks (NULL for immediate I/O) */
 } H5D_contig_readvv_sieve_ud_t;
 
 /* Callback info for [plain] readvv operation */
@@ -70,6 +78,7 @@ typedef struct H5D_contig_readvv_ud_t {
     haddr_t dset_addr;          /* Address of dataset */
     unsigned char *rbuf;        /* Pointer to buffer to fill */
     hid_t dxpl_id;              /* DXPL for operation */
+    H5D_io_vec_t *vec;          /* Deferred blocks (NULL for immediate I/O) */
 } H5D_contig_readvv_ud_t;
 
 /* Callback info for sieve buffer writevv operation */
@@ -79,6 +88,7 @@ typedef struct H5D_contig_writevv_sieve_ud_t {
     const H5D_contig_storage_t *store_contig;    /* Contiguous storage info for this I/O operation */
     const unsigned char *wbuf;  /* Pointer to buffer to write */
     hid_t dxpl_id;              /* DXPL for operation */
+    H5D_io_vec_t *vec;          /* Deferred blocks (NULL for immediate I/O) */
 } H5D_contig_writevv_sieve_ud_t;
 
 /* Callback info for [plain] writevv operation */
@@ -87,6 +97,7 @@ typedef struct H5D_contig_writevv_ud_t {
     haddr_t dset_addr;          /* Address of dataset */
     const unsigned char *wbuf;  /* Pointer to buffer to write */
     hid_t dxpl_id;              /* DXPL for operation */
+    H5D_io_vec_t *vec;          /* Deferred blocks (NULL for immediate I/O) */
 } H5D_contig_writevv_ud_t;
 
 
@@ -112,6 +123,10 @@ static herr_t H5D__contig_flush(H5D_t *dset, hid_t dxpl_id);
 /* Helper routines */
 static herr_t H5D__contig_write_one(H5D_io_info_t *io_info, hsize_t offset,
     size_t size);
+static herr_t H5D__contig_block_read(const H5F_t *file, H5D_io_vec_t *vec,
+    haddr_t addr, size_t len, hid_t dxpl_id, unsigned char *buf);
+static herr_t H5D__contig_block_write(const H5F_t *file, H5D_io_vec_t *vec,
+    haddr_t addr, size_t len, hid_t dxpl_id, const unsigned char *buf);
 
 
 /*********************/
@@ -591,6 +606,8 @@ H5D__contig_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     hsize_t nelmts, const H5S_t *file_space, const H5S_t *mem_space,
     H5D_chunk_map_t H5_ATTR_UNUSED *fm)
 {
+    H5D_io_vec_t vec;                   /* Blocks deferred across the whole read */
+    hbool_t     use_vec = FALSE;        /* Whether the blocks are deferred */
     herr_t	ret_value = SUCCEED;	/*return value		*/
 
     FUNC_ENTER_PACKAGE
@@ -602,11 +619,32 @@ H5D__contig_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     HDassert(mem_space);
     HDassert(file_space);
 
+    /* When the data goes directly into the application's buffer, the blocks
+     * for all of the selection's sequences can be gathered into vectors
+     * for the file driver.  (Type conversion needs each batch of
+     * sequences to be complete before it's used.)
+     */
+    if(io_info->io_ops.single_read == H5D__select_read && NULL == io_info->vec
+            && H5F_HAS_VECTOR_IO(io_info->dset->oloc.file)) {
+        HDmemset(&vec, 0, sizeof(vec));
+        io_info->vec = &vec;
+        use_vec = TRUE;
+    } /* end if */
+
     /* Read data */
     if((io_info->io_ops.single_read)(io_info, type_info, nelmts, file_space, mem_space) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "contiguous read failed")
 
+    /* Pass the remaining deferred blocks to the file driver */
+    if(use_vec && H5D__io_vec_read(io_info->dset->oloc.file, io_info->raw_dxpl_id, &vec) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "deferred block read failed")
+
 done:
+    if(use_vec) {
+        io_info->vec = NULL;
+        H5D__io_vec_free(&vec);
+    } /* end if */
+
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__contig_read() */
 
@@ -628,6 +666,8 @@ H5D__contig_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     hsize_t nelmts, const H5S_t *file_space, const H5S_t *mem_space,
     H5D_chunk_map_t H5_ATTR_UNUSED *fm)
 {
+    H5D_io_vec_t vec;                   /* Blocks deferred across the whole write */
+    hbool_t     use_vec = FALSE;        /* Whether the blocks are deferred */
     herr_t	ret_value = SUCCEED;	/*return value		*/
 
     FUNC_ENTER_PACKAGE
@@ -639,11 +679,32 @@ H5D__contig_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     HDassert(mem_space);
     HDassert(file_space);
 
+    /* When the data goes directly from the application's buffer, the blocks
+     * for all of the selection's sequences can be gathered into vectors
+     * for the file driver.  (Type conversion needs each batch of
+     * sequences to be complete before it's used.)
+     */
+    if(io_info->io_ops.single_write == H5D__select_write && NULL == io_info->vec
+            && H5F_HAS_VECTOR_IO(io_info->dset->oloc.file)) {
+        HDmemset(&vec, 0, sizeof(vec));
+        io_info->vec = &vec;
+        use_vec = TRUE;
+    } /* end if */
+
     /* Write data */
     if((io_info->io_ops.single_write)(io_info, type_info, nelmts, file_space, mem_space) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "contiguous write failed")
 
+    /* Pass the remaining deferred blocks to the file driver */
+    if(use_vec && H5D__io_vec_write(io_info->dset->oloc.file, io_info->raw_dxpl_id, &vec) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "deferred block write failed")
+
 done:
+    if(use_vec) {
+        io_info->vec = NULL;
+        H5D__io_vec_free(&vec);
+    } /* end if */
+
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__contig_write() */
 
@@ -686,6 +747,238 @@ done:
 }   /* end H5D__contig_write_one() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:	H5D__io_vec_add
+ *
+ * Purpose:	Append a raw data block to a vector of deferred I/O.  A
+ *		block that directly follows the previous one, both in the
+ *		file and in memory, is merged into it.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__io_vec_add(H5D_io_vec_t *vec, haddr_t addr, size_t size, void *buf)
+{
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check args */
+    HDassert(vec);
+    HDassert(H5F_addr_defined(addr));
+    HDassert(buf);
+
+    /* Check if the block can be merged with the previous one */
+    if(vec->nused > 0) {
+        size_t prev = vec->nused - 1;   /* Index of previous block */
+
+        if(H5F_addr_eq(vec->addrs[prev] + vec->sizes[prev], addr)
+                && (unsigned char *)vec->bufs[prev] + vec->sizes[prev] == (unsigned char *)buf
+                && vec->sizes[prev] <= ((size_t)-1 - size)) {
+            vec->sizes[prev] += size;
+            HGOTO_DONE(SUCCEED)
+        } /* end if */
+    } /* end if */
+
+    /* Make room for another block */
+    if(vec->nused == vec->nalloc) {
+        size_t new_nalloc = MAX(H5D_IO_VEC_INIT_NALLOC, 2 * vec->nalloc);  /* New # of blocks */
+
+        if(NULL == (vec->types = (H5FD_mem_t *)H5MM_realloc(vec->types, new_nalloc * sizeof(H5FD_mem_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+        if(NULL == (vec->addrs = (haddr_t *)H5MM_realloc(vec->addrs, new_nalloc * sizeof(haddr_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+        if(NULL == (vec->sizes = (size_t *)H5MM_realloc(vec->sizes, new_nalloc * sizeof(size_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+        if(NULL == (vec->bufs = (void **)H5MM_realloc(vec->bufs, new_nalloc * sizeof(void *))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for I/O vector")
+        vec->nalloc = new_nalloc;
+    } /* end if */
+
+    /* Append the block */
+    vec->types[vec->nused] = H5FD_MEM_DRAW;
+    vec->addrs[vec->nused] = addr;
+    vec->sizes[vec->nused] = size;
+    vec->bufs[vec->nused] = buf;
+    vec->nused++;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__io_vec_add() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__io_vec_read
+ *
+ * Purpose:	Read the blocks in a vector of deferred I/O from the file
+ *		and empty the vector.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__io_vec_read(const H5F_t *f, hid_t dxpl_id, H5D_io_vec_t *vec)
+{
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check args */
+    HDassert(f);
+    HDassert(vec);
+
+    if(vec->nused > 0) {
+        /* Reset the vector first, so a failed read isn't retried */
+        size_t nused = vec->nused;
+
+        vec->nused = 0;
+        if(H5F_block_read_vector(f, nused, vec->types, vec->addrs, vec->sizes, dxpl_id, vec->bufs) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "vector read failed")
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__io_vec_read() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__io_vec_write
+ *
+ * Purpose:	Write the blocks in a vector of deferred I/O to the file
+ *		and empty the vector.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__io_vec_write(const H5F_t *f, hid_t dxpl_id, H5D_io_vec_t *vec)
+{
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check args */
+    HDassert(f);
+    HDassert(vec);
+
+    if(vec->nused > 0) {
+        /* Reset the vector first, so a failed write isn't retried */
+        size_t nused = vec->nused;
+
+        vec->nused = 0;
+        if(H5F_block_write_vector(f, nused, vec->types, vec->addrs, vec->sizes, dxpl_id, (const void **)vec->bufs) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "vector write failed")
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__io_vec_write() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__io_vec_free
+ *
+ * Purpose:	Release the memory for a vector of deferred I/O.  Any
+ *		blocks still in the vector are dropped.
+ *
+ * Return:	<none>
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5D__io_vec_free(H5D_io_vec_t *vec)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    HDassert(vec);
+
+    vec->types = (H5FD_mem_t *)H5MM_xfree(vec->types);
+    vec->addrs = (haddr_t *)H5MM_xfree(vec->addrs);
+    vec->sizes = (size_t *)H5MM_xfree(vec->sizes);
+    vec->bufs = (void **)H5MM_xfree(vec->bufs);
+    vec->nused = vec->nalloc = 0;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__io_vec_free() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__contig_block_read
+ *
+ * Purpose:	Read a block of raw data directly into the application's
+ *		buffer, or defer the read by adding the block to a vector.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__contig_block_read(const H5F_t *file, H5D_io_vec_t *vec, haddr_t addr,
+    size_t len, hid_t dxpl_id, unsigned char *buf)
+{
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(vec) {
+        /* Defer the read */
+        if(H5D__io_vec_add(vec, addr, len, buf) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "can't add block to I/O vector")
+
+        /* Read the blocks, if enough have been gathered */
+        if(vec->nused >= H5D_IO_VEC_MAX_NUSED && H5D__io_vec_read(file, dxpl_id, vec) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "deferred block read failed")
+    } /* end if */
+    else
+        if(H5F_block_read(file, H5FD_MEM_DRAW, addr, len, dxpl_id, buf) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "block read failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__contig_block_read() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__contig_block_write
+ *
+ * Purpose:	Write a block of raw data directly from the application's
+ *		buffer, or defer the write by adding the block to a vector.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__contig_block_write(const H5F_t *file, H5D_io_vec_t *vec, haddr_t addr,
+    size_t len, hid_t dxpl_id, const unsigned char *buf)
+{
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(vec) {
+        /* Defer the write */
+        /* (Casting away const OK, the block is only written from) */
+        if(H5D__io_vec_add(vec, addr, len, (void *)buf) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "can't add block to I/O vector")
+
+        /* Write the blocks, if enough have been gathered */
+        if(vec->nused >= H5D_IO_VEC_MAX_NUSED && H5D__io_vec_write(file, dxpl_id, vec) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "deferred block write failed")
+    } /* end if */
+    else
+        if(H5F_block_write(file, H5FD_MEM_DRAW, addr, len, dxpl_id, buf) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "block write failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__contig_block_write() */
+
+
 /*-------------------------------------------------------------------------
  * Function:	H5D__contig_readvv_sieve_cb
  *
@@ -735,7 +1028,7 @@ H5D__contig_readvv_sieve_cb(hsize_t dst_off, hsize_t src_off, size_t len,
     if(NULL == dset_contig->sieve_buf) {
         /* Check if we can actually hold the I/O request in the sieve buffer */
         if(len > dset_contig->sieve_buf_size) {
-            if(H5F_block_read(file, H5FD_MEM_DRAW, addr, len, udata->dxpl_id, buf) < 0)
+            if(H5D__contig_block_read(file, udata->vec, addr, len, udata->dxpl_id, buf) < 0)
                 HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "block read failed")
         } /* end if */
         else {
@@ -803,7 +1096,7 @@ H5D__contig_readvv_sieve_cb(hsize_t dst_off, hsize_t src_off, size_t len,
                 } /* end if */
 
                 /* Read directly into the user's buffer */
-                if(H5F_block_read(file, H5FD_MEM_DRAW, addr, len, udata->dxpl_id, buf) < 0)
+                if(H5D__contig_block_read(file, udata->vec, addr, len, udata->dxpl_id, buf) < 0)
                     HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "block read failed")
             } /* end if */
             /* Element size fits within the buffer size */
@@ -879,10 +1172,10 @@ H5D__contig_readvv_cb(hsize_t dst_off, hsize_t src_off, size_t len, void *_udata
 
     FUNC_ENTER_STATIC
 
-    /* Write data */
-    if(H5F_block_read(udata->file, H5FD_MEM_DRAW, (udata->dset_addr + dst_off),
+    /* Read data */
+    if(H5D__contig_block_read(udata->file, udata->vec, (udata->dset_addr + dst_off),
             len, udata->dxpl_id, (udata->rbuf + src_off)) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "block write failed")
+        HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "block read failed")
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
@@ -912,6 +1205,8 @@ H5D__contig_readvv(const H5D_io_info_t *io_info,
     size_t dset_max_nseq, size_t *dset_curr_seq, size_t dset_len_arr[], hsize_t dset_off_arr[],
     size_t mem_max_nseq, size_t *mem_curr_seq, size_t mem_len_arr[], hsize_t mem_off_arr[])
 {
+    H5D_io_vec_t local_vec;     /* Blocks deferred during this call */
+    H5D_io_vec_t *vec = NULL;   /* Vector of deferred blocks to use */
     ssize_t ret_value = -1;     /* Return value */
 
     FUNC_ENTER_STATIC
@@ -925,6 +1220,17 @@ H5D__contig_readvv(const H5D_io_info_t *io_info,
     HDassert(mem_len_arr);
     HDassert(mem_off_arr);
 
+    /* Gather the blocks read directly from the file into a vector, if the
+     * file driver can read them all at once.  (Use the caller's vector if
+     * there is one, otherwise read the blocks at the end of this call.)
+     */
+    if(io_info->vec)
+        vec = io_info->vec;
+    else if(H5F_HAS_VECTOR_IO(io_info->dset->oloc.file)) {
+        HDmemset(&local_vec, 0, sizeof(local_vec));
+        vec = &local_vec;
+    } /* end if */
+
     /* Check if data sieving is enabled */
     if(H5F_HAS_FEATURE(io_info->dset->oloc.file, H5FD_FEAT_DATA_SIEVE)) {
         H5D_contig_readvv_sieve_ud_t udata;     /* User data for H5VM_opvv() operator */
@@ -935,6 +1241,7 @@ H5D__contig_readvv(const H5D_io_info_t *io_info,
         udata.store_contig = &(io_info->store->contig);
         udata.rbuf = (unsigned char *)io_info->u.rbuf;
         udata.dxpl_id = io_info->raw_dxpl_id;
+        udata.vec = vec;
 
         /* Call generic sequence operation routine */
         if((ret_value = H5VM_opvv(dset_max_nseq, dset_curr_seq, dset_len_arr, dset_off_arr,
@@ -950,6 +1257,7 @@ H5D__contig_readvv(const H5D_io_info_t *io_info,
         udata.dset_addr = io_info->store->contig.dset_addr;
         udata.rbuf = (unsigned char *)io_info->u.rbuf;
         udata.dxpl_id = io_info->raw_dxpl_id;
+        udata.vec = vec;
 
         /* Call generic sequence operation routine */
         if((ret_value = H5VM_opvv(dset_max_nseq, dset_curr_seq, dset_len_arr, dset_off_arr,
@@ -958,7 +1266,14 @@ H5D__contig_readvv(const H5D_io_info_t *io_info,
             HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't perform vectorized read")
     } /* end else */
 
+    /* Pass the deferred blocks to the file driver */
+    if(vec == &local_vec && H5D__io_vec_read(io_info->dset->oloc.file, io_info->raw_dxpl_id, vec) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "deferred block read failed")
+
 done:
+    if(vec == &local_vec)
+        H5D__io_vec_free(&local_vec);
+
     FUNC_LEAVE_NOAPI(ret_value)
 }   /* end H5D__contig_readvv() */
 
@@ -1012,10 +1327,14 @@ H5D__contig_writevv_sieve_cb(hsize_t dst_off, hsize_t src_off, size_t len,
     if(NULL == dset_contig->sieve_buf) {
         /* Check if we can actually hold the I/O request in the sieve buffer */
         if(len > dset_contig->sieve_buf_size) {
-            if(H5F_block_write(file, H5FD_MEM_DRAW, addr, len, udata->dxpl_id, buf) < 0)
+            if(H5D__contig_block_write(file, udata->vec, addr, len, udata->dxpl_id, buf) < 0)
                 HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "block write failed")
         } /* end if */
         else {
+            /* Write any deferred blocks before the sieve buffer is read */
+            if(udata->vec && H5D__io_vec_write(file, udata->dxpl_id, udata->vec) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "deferred block write failed")
+
             /* Allocate room for the data sieve buffer */
             if(NULL == (dset_contig->sieve_buf = H5FL_BLK_CALLOC(sieve_buf, dset_contig->sieve_buf_size)))
                 HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "memory allocation failed")
@@ -1080,6 +1399,10 @@ H5D__contig_writevv_sieve_cb(hsize_t dst_off, hsize_t src_off, size_t len,
                         || ((sieve_end - 1) >= addr && (sieve_end - 1) < (contig_end + 1))) {
                     /* Flush the sieve buffer, if it's dirty */
                     if(dset_contig->sieve_dirty) {
+                        /* Write any deferred blocks first, to keep the writes in order */
+                        if(udata->vec && H5D__io_vec_write(file, udata->dxpl_id, udata->vec) < 0)
+                            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "deferred block write failed")
+
                         /* Write to file */
                         if(H5F_block_write(file, H5FD_MEM_DRAW, sieve_start, sieve_size, udata->dxpl_id, dset_contig->sieve_buf) < 0)
                             HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "block write failed")
@@ -1094,7 +1417,7 @@ H5D__contig_writevv_sieve_cb(hsize_t dst_off, hsize_t src_off, size_t len,
                 } /* end if */
 
                 /* Write directly from the user's buffer */
-                if(H5F_block_write(file, H5FD_MEM_DRAW, addr, len, udata->dxpl_id, buf) < 0)
+                if(H5D__contig_block_write(file, udata->vec, addr, len, udata->dxpl_id, buf) < 0)
                     HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "block write failed")
             } /* end if */
             /* Element size fits within the buffer size */
@@ -1131,6 +1454,10 @@ H5D__contig_writevv_sieve_cb(hsize_t dst_off, hsize_t src_off, size_t len,
                 } /* end if */
                 /* Can't add the new data onto the existing sieve buffer */
                 else {
+                    /* Write any deferred blocks before the sieve buffer is flushed or read */
+                    if(udata->vec && H5D__io_vec_write(file, udata->dxpl_id, udata->vec) < 0)
+                        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "deferred block write failed")
+
                     /* Flush the sieve buffer if it's dirty */
                     if(dset_contig->sieve_dirty) {
                         /* Write to file */
@@ -1207,7 +1534,7 @@ H5D__contig_writevv_cb(hsize_t dst_off, hsize_t src_off, size_t len, void *_udat
     FUNC_ENTER_STATIC
 
     /* Write data */
-    if(H5F_block_write(udata->file, H5FD_MEM_DRAW, (udata->dset_addr + dst_off), len, udata->dxpl_id, (udata->wbuf + src_off)) < 0)
+    if(H5D__contig_block_write(udata->file, udata->vec, (udata->dset_addr + dst_off), len, udata->dxpl_id, (udata->wbuf + src_off)) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "block write failed")
 
 done:
@@ -1238,6 +1565,8 @@ H5D__contig_writevv(const H5D_io_info_t *io_info,
     size_t dset_max_nseq, size_t *dset_curr_seq, size_t dset_len_arr[], hsize_t dset_off_arr[],
     size_t mem_max_nseq, size_t *mem_curr_seq, size_t mem_len_arr[], hsize_t mem_off_arr[])
 {
+    H5D_io_vec_t local_vec;             /* Blocks deferred during this call */
+    H5D_io_vec_t *vec = NULL;           /* Vector of deferred blocks to use */
     ssize_t ret_value = -1;             /* Return value (Size of sequence in bytes) */
 
     FUNC_ENTER_STATIC
@@ -1251,6 +1580,17 @@ H5D__contig_writevv(const H5D_io_info_t *io_info,
     HDassert(mem_len_arr);
     HDassert(mem_off_arr);
 
+    /* Gather the blocks written directly to the file into a vector, if the
+     * file driver can write them all at once.  (Use the caller's vector if
+     * there is one, otherwise write the blocks at the end of this call.)
+     */
+    if(io_info->vec)
+        vec = io_info->vec;
+    else if(H5F_HAS_VECTOR_IO(io_info->dset->oloc.file)) {
+        HDmemset(&local_vec, 0, sizeof(local_vec));
+        vec = &local_vec;
+    } /* end if */
+
     /* Check if data sieving is enabled */
     if(H5F_HAS_FEATURE(io_info->dset->oloc.file, H5FD_FEAT_DATA_SIEVE)) {
         H5D_contig_writevv_sieve_ud_t udata;    /* User data for H5VM_opvv() operator */
@@ -1261,6 +1601,7 @@ H5D__contig_writevv(const H5D_io_info_t *io_info,
         udata.store_contig = &(io_info->store->contig);
         udata.wbuf = (const unsigned char *)io_info->u.wbuf;
         udata.dxpl_id = io_info->raw_dxpl_id;
+        udata.vec = vec;
 
         /* Call generic sequence operation routine */
         if((ret_value = H5VM_opvv(dset_max_nseq, dset_curr_seq, dset_len_arr, dset_off_arr,
@@ -1276,6 +1617,7 @@ H5D__contig_writevv(const H5D_io_info_t *io_info,
         udata.dset_addr = io_info->store->contig.dset_addr;
         udata.wbuf = (const unsigned char *)io_info->u.wbuf;
         udata.dxpl_id = io_info->raw_dxpl_id;
+        udata.vec = vec;
 
         /* Call generic sequence operation routine */
         if((ret_value = H5VM_opvv(dset_max_nseq, dset_curr_seq, dset_len_arr, dset_off_arr,
@@ -1284,7 +1626,14 @@ H5D__contig_writevv(const H5D_io_info_t *io_info,
             HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't perform vectorized read")
     } /* end else */
 
+    /* Pass the deferred blocks to the file driver */
+    if(vec == &local_vec && H5D__io_vec_write(io_info->dset->oloc.file, io_info->raw_dxpl_id, vec) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "deferred block write failed")
+
 done:
+    if(vec == &local_vec)
+        H5D__io_vec_free(&local_vec);
+
     FUNC_LEAVE_NOAPI(ret_value)
 }   /* end H5D__contig_writevv() */
 
@@ -385,6 +385,10 @@ H5D__get_dxpl_cache_real(hid_t dxpl_id, H5D_dxpl_cache_t *cache)
     if(H5P_get(dx_plist, H5D_XFER_FILTER_CB_NAME, &cache->filter_cb) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve filter callback function")
 
+    /* Get number of filter pipeline threads */
+    if(H5P_get(dx_plist, H5D_XFER_FILTER_THREADS_NAME, &cache->filter_threads) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve number of filter threads")
+
     /* Look at the data transform property */
     /* (Note: 'peek', not 'get' - if this turns out to be a problem, we should
      *          add a H5D__free_dxpl_cache() routine. -QAK)
@@ -1886,6 +1890,12 @@ H5D_close(H5D_t *dataset)
         /* Free the external file prefix */
         dataset->shared->extfile_prefix = (char *)H5MM_xfree(dataset->shared->extfile_prefix);
 
+        /* Free the datatype conversion buffers kept for I/O */
+        if(dataset->shared->tconv_buf)
+            dataset->shared->tconv_buf = H5FL_BLK_FREE(type_conv, dataset->shared->tconv_buf);
+        if(dataset->shared->bkg_buf)
+            dataset->shared->bkg_buf = H5FL_BLK_FREE(type_conv, dataset->shared->bkg_buf);
+
         /* Release layout, fill-value, efl & pipeline messages */
         if(dataset->shared->dcpl_id != H5P_DATASET_CREATE_DEFAULT)
             free_failed |= (H5O_msg_reset(H5O_PLINE_ID, &dataset->shared->dcpl_cache.pline) < 0) ||
@@ -2805,10 +2815,10 @@ H5D__set_extent(H5D_t *dset, const hsize_t *size, hid_t dxpl_id)
                     dset->shared->cache.chunk.scaled_dims[u] = scaled;
 
                     /* Check if algorithm for computing hash values will change */
-                    if((scaled > dset->shared->cache.chunk.nslots &&
-                                dset->shared->cache.chunk.scaled_dims[u] <= dset->shared->cache.chunk.nslots)
-                            || (scaled <= dset->shared->cache.chunk.nslots &&
-                                dset->shared->cache.chunk.scaled_dims[u] > dset->shared->cache.chunk.nslots))
+                    if((scaled > dset->shared->cache.chunk.nsets &&
+                                dset->shared->cache.chunk.scaled_dims[u] <= dset->shared->cache.chunk.nsets)
+                            || (scaled <= dset->shared->cache.chunk.nsets &&
+                                dset->shared->cache.chunk.scaled_dims[u] > dset->shared->cache.chunk.nsets))
                         update_chunks = TRUE;
 
                     /* Check if the number of bits required to encode the scaled size value changed */
@@ -3500,6 +3510,12 @@ H5D_get_access_plist(H5D_t *dset)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set data cache byte size")
         if(H5P_set(new_plist, H5D_ACS_PREEMPT_READ_CHUNKS_NAME, &(dset->shared->cache.chunk.w0)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set preempt read chunks")
+        if(H5P_set(new_plist, H5D_ACS_DATA_CACHE_NUM_WAYS_NAME, &(dset->shared->cache.chunk.nways)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set data cache associativity")
+        if(H5P_set(new_plist, H5D_ACS_DATA_CACHE_AUTO_RESIZE_NAME, &(dset->shared->cache.chunk.auto_resize)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set data cache automatic resizing")
+        if(H5P_set(new_plist, H5D_ACS_WRITE_BEHIND_NBYTES_NAME, &(dset->shared->cache.chunk.wb_nbytes_max)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set write-behind queue size")
         if(H5P_set(new_plist, H5D_ACS_APPEND_FLUSH_NAME, &dset->shared->append_flush) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set append flush property")
     } /* end if */
@@ -54,6 +54,7 @@
 /* Internal I/O routines */
 static herr_t H5D__pre_write(H5D_t *dset, hbool_t direct_write, hid_t mem_type_id, 
     const H5S_t *mem_space, const H5S_t *file_space, hid_t dxpl_id, const void *buf);
+static herr_t H5D__direct_chunk_read(H5D_t *dset, hid_t dxpl_id, void *buf);
 
 /* Setup/teardown routines */
 static herr_t H5D__ioinfo_init(H5D_t *dset,
@@ -64,15 +65,16 @@ const
     hid_t dxpl_id, const H5D_type_info_t *type_info, H5D_storage_t *store,
     H5D_io_info_t *io_info);
 static herr_t H5D__typeinfo_init(const H5D_t *dset, const H5D_dxpl_cache_t *dxpl_cache,
-    hid_t dxpl_id, hid_t mem_type_id, hbool_t do_write,
+    hid_t dxpl_id, hid_t mem_type_id, hbool_t do_write, hsize_t nelmts,
     H5D_type_info_t *type_info);
+static size_t H5D__typeinfo_strip_size(void);
 #ifdef H5_HAVE_PARALLEL
 static herr_t H5D__ioinfo_adjust(H5D_io_info_t *io_info, const H5D_t *dset,
     hid_t dxpl_id, const H5S_t *file_space, const H5S_t *mem_space,
     const H5D_type_info_t *type_info, const H5D_chunk_map_t *fm);
 static herr_t H5D__ioinfo_term(H5D_io_info_t *io_info);
 #endif /* H5_HAVE_PARALLEL */
-static herr_t H5D__typeinfo_term(const H5D_type_info_t *type_info);
+static herr_t H5D__typeinfo_term(const H5D_t *dset, const H5D_type_info_t *type_info);
 
 
 /*********************/
@@ -129,6 +131,8 @@ H5Dread(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
     H5D_t		   *dset = NULL;
     const H5S_t		   *mem_space = NULL;
     const H5S_t		   *file_space = NULL;
+    H5P_genplist_t 	   *plist;      /* Property list pointer */
+    hbool_t                 direct_read = FALSE;
     herr_t                  ret_value = SUCCEED;  /* Return value */
 
     FUNC_ENTER_API(FAIL)
@@ -168,9 +172,24 @@ H5Dread(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
         if(TRUE != H5P_isa_class(plist_id, H5P_DATASET_XFER))
             HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not xfer parms")
 
-    /* read raw data */
-    if(H5D__read(dset, mem_type_id, mem_space, file_space, plist_id, buf/*out*/) < 0)
-	HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read data")
+    /* Get the dataset transfer property list */
+    if(NULL == (plist = (H5P_genplist_t *)H5I_object(plist_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset transfer property list")
+
+    /* Retrieve the 'direct read' flag */
+    if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_READ_FLAG_NAME, &direct_read) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting flag for direct chunk read")
+
+    if(direct_read) {
+        /* read chunks as stored */
+        if(H5D__direct_chunk_read(dset, plist_id, buf/*out*/) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read chunk directly")
+    } /* end if */
+    else {
+        /* read raw data */
+        if(H5D__read(dset, mem_type_id, mem_space, file_space, plist_id, buf/*out*/) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read data")
+    } /* end else */
 
 done:
     FUNC_LEAVE_API(ret_value)
@@ -299,11 +318,7 @@ H5D__pre_write(H5D_t *dset, hbool_t direct_write, hid_t mem_type_id,
     /* Direct chunk write */
     if(direct_write) {
         H5P_genplist_t *plist;      /* Property list pointer */
-        uint32_t direct_filters;
-        hsize_t *direct_offset;
-        uint32_t direct_datasize;
-	hsize_t  internal_offset[H5O_LAYOUT_NDIMS];
-	unsigned u;                 /* Local index variable */
+        size_t direct_nchunks;      /* Number of chunks in a batched direct write */
 
         /* Get the dataset transfer property list */
         if(NULL == (plist = (H5P_genplist_t *)H5I_object(dxpl_id)))
@@ -312,34 +327,64 @@ H5D__pre_write(H5D_t *dset, hbool_t direct_write, hid_t mem_type_id,
         if(H5D_CHUNKED != dset->shared->layout.type)
 	    HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
 
-        /* Retrieve parameters for direct chunk write */
-        if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_WRITE_FILTERS_NAME, &direct_filters) < 0)
-            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting filter info for direct chunk write")
-        if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_WRITE_OFFSET_NAME, &direct_offset) < 0)
-            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting offset info for direct chunk write")
-        if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZE_NAME, &direct_datasize) < 0)
-            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting data size for direct chunk write")
-
-	/* The library's chunking code requires the offset terminates with a zero. So transfer the 
-         * offset array to an internal offset array */ 
-	for(u = 0; u < dset->shared->ndims; u++) {
-	    /* Make sure the offset doesn't exceed the dataset's dimensions */
-            if(direct_offset[u] > dset->shared->curr_dims[u])
-		HGOTO_ERROR(H5E_DATASPACE, H5E_BADTYPE, FAIL, "offset exceeds dimensions of dataset")
-
-            /* Make sure the offset fall right on a chunk's boundary */
-	    if(direct_offset[u] % dset->shared->layout.u.chunk.dim[u])
-		HGOTO_ERROR(H5E_DATASPACE, H5E_BADTYPE, FAIL, "offset doesn't fall on chunks's boundary")
-
-	    internal_offset[u] = direct_offset[u]; 
-	} /* end for */
-	   
-	/* Terminate the offset with a zero */ 
-	internal_offset[dset->shared->ndims] = 0;
-
-	/* write raw data */
-	if(H5D__chunk_direct_write(dset, dxpl_id, direct_filters, internal_offset, direct_datasize, buf) < 0)
-	    HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write chunk directly")
+        if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_WRITE_NCHUNKS_NAME, &direct_nchunks) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting number of chunks for direct chunk write")
+
+        /* Batched direct chunk write */
+        if(direct_nchunks > 0) {
+            const uint32_t *direct_filters_list;
+            const hsize_t **direct_offset_list;
+            const size_t *direct_datasize_list;
+            size_t u;                   /* Local index variable */
+
+            /* Retrieve parameters for batched direct chunk write */
+            if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_WRITE_FILTERS_LIST_NAME, &direct_filters_list) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting filter info for direct chunk write")
+            if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_WRITE_OFFSET_LIST_NAME, &direct_offset_list) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting offset info for direct chunk write")
+            if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZE_LIST_NAME, &direct_datasize_list) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting data size for direct chunk write")
+            if(!direct_filters_list || !direct_offset_list || !direct_datasize_list || !buf)
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "chunk information not set for direct chunk write")
+
+            for(u = 0; u < direct_nchunks; u++)
+                if(H5D__chunk_check_offset(dset, direct_offset_list[u]) < 0)
+                    HGOTO_ERROR(H5E_DATASPACE, H5E_BADVALUE, FAIL, "invalid offset for direct chunk write")
+
+            /* write raw data */
+            if(H5D__chunk_direct_write_multi(dset, dxpl_id, direct_nchunks, direct_filters_list, direct_offset_list, direct_datasize_list, (const void **)buf) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write chunks directly")
+        } /* end if */
+        else {
+            uint32_t direct_filters;
+            hsize_t *direct_offset;
+            uint32_t direct_datasize;
+            hsize_t  internal_offset[H5O_LAYOUT_NDIMS];
+            unsigned u;                 /* Local index variable */
+
+            /* Retrieve parameters for direct chunk write */
+            if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_WRITE_FILTERS_NAME, &direct_filters) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting filter info for direct chunk write")
+            if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_WRITE_OFFSET_NAME, &direct_offset) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting offset info for direct chunk write")
+            if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZE_NAME, &direct_datasize) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting data size for direct chunk write")
+
+            if(H5D__chunk_check_offset(dset, direct_offset) < 0)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_BADVALUE, FAIL, "invalid offset for direct chunk write")
+
+            /* The library's chunking code requires the offset terminates with a zero. So transfer the 
+             * offset array to an internal offset array */ 
+            for(u = 0; u < dset->shared->ndims; u++)
+                internal_offset[u] = direct_offset[u]; 
+
+            /* Terminate the offset with a zero */ 
+            internal_offset[dset->shared->ndims] = 0;
+
+            /* write raw data */
+            if(H5D__chunk_direct_write(dset, dxpl_id, direct_filters, internal_offset, direct_datasize, buf) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write chunk directly")
+        } /* end else */
     } /* end if */
     else {     /* Normal write */
         /* write raw data */
@@ -351,6 +396,91 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__pre_write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__direct_chunk_read
+ *
+ * Purpose:	Read the stored bytes of one or more whole chunks, as set
+ *              up in the DXPL by H5DOread_chunk() or H5DOread_chunks().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__direct_chunk_read(H5D_t *dset, hid_t dxpl_id, void *buf)
+{
+    H5P_genplist_t *plist;              /* Property list pointer */
+    size_t direct_nchunks;              /* Number of chunks in a batched direct read */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Get the dataset transfer property list */
+    if(NULL == (plist = (H5P_genplist_t *)H5I_object(dxpl_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset transfer property list")
+
+    if(H5D_CHUNKED != dset->shared->layout.type)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
+
+    if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_READ_NCHUNKS_NAME, &direct_nchunks) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting number of chunks for direct chunk read")
+
+    /* Batched direct chunk read */
+    if(direct_nchunks > 0) {
+        const hsize_t **direct_offset_list;
+        uint32_t *direct_filters_list;
+        size_t *direct_datasize_list;
+        size_t direct_buf_size;
+        size_t u;                   /* Local index variable */
+
+        /* Retrieve parameters for batched direct chunk read */
+        if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_READ_OFFSET_LIST_NAME, &direct_offset_list) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting offset info for direct chunk read")
+        if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_READ_FILTERS_LIST_NAME, &direct_filters_list) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting filter info for direct chunk read")
+        if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_READ_DATASIZE_LIST_NAME, &direct_datasize_list) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting data size info for direct chunk read")
+        if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_READ_BUF_SIZE_NAME, &direct_buf_size) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting buffer size for direct chunk read")
+        if(!direct_offset_list || !direct_filters_list || !direct_datasize_list || (direct_buf_size > 0 && !buf))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "chunk information not set for direct chunk read")
+
+        for(u = 0; u < direct_nchunks; u++)
+            if(H5D__chunk_check_offset(dset, direct_offset_list[u]) < 0)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_BADVALUE, FAIL, "invalid offset for direct chunk read")
+
+        /* read raw data */
+        if(H5D__chunk_direct_read_multi(dset, dxpl_id, direct_nchunks, direct_offset_list, direct_filters_list, direct_datasize_list, buf, direct_buf_size) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read chunks directly")
+    } /* end if */
+    else {
+        hsize_t *direct_offset;
+        uint32_t direct_filters = 0;
+
+        /* Retrieve parameters for direct chunk read */
+        if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_READ_OFFSET_NAME, &direct_offset) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting offset info for direct chunk read")
+        if(NULL == buf)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no buffer for direct chunk read")
+
+        if(H5D__chunk_check_offset(dset, direct_offset) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_BADVALUE, FAIL, "invalid offset for direct chunk read")
+
+        /* read raw data */
+        if(H5D__chunk_direct_read(dset, dxpl_id, direct_offset, &direct_filters, buf) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read chunk directly")
+
+        /* Return the chunk's filter mask */
+        if(H5P_set(plist, H5D_XFER_DIRECT_CHUNK_READ_FILTERS_NAME, &direct_filters) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "error setting filter info for direct chunk read")
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__direct_chunk_read() */
+
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__read
@@ -414,7 +544,7 @@ H5D__read(H5D_t *dataset, hid_t mem_type_id, const H5S_t *mem_space,
         HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
 
     /* Set up datatype info for operation */
-    if(H5D__typeinfo_init(dataset, dxpl_cache, dxpl_id, mem_type_id, FALSE, &type_info) < 0)
+    if(H5D__typeinfo_init(dataset, dxpl_cache, dxpl_id, mem_type_id, FALSE, nelmts, &type_info) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to set up type info")
     type_info_init = TRUE;
 
@@ -566,7 +696,7 @@ done:
     }
 
     /* Shut down datatype info for operation */
-    if(type_info_init && H5D__typeinfo_term(&type_info) < 0)
+    if(type_info_init && H5D__typeinfo_term(dataset, &type_info) < 0)
         HDONE_ERROR(H5E_DATASET, H5E_CANTCLOSEOBJ, FAIL, "unable to shut down type info")
 
     /* discard projected mem space if it was created */
@@ -639,12 +769,22 @@ H5D__write(H5D_t *dataset, hid_t mem_type_id, const H5S_t *mem_space,
     if(0 == (H5F_INTENT(dataset->oloc.file) & H5F_ACC_RDWR))
 	HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "no write intent on file")
 
+    /* Initialize dataspace information */
+    if(!file_space)
+        file_space = dataset->shared->space;
+    if(!mem_space)
+        mem_space = file_space;
+
+    if((snelmts = H5S_GET_SELECT_NPOINTS(mem_space)) < 0)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "src dataspace has invalid selection")
+    H5_CHECKED_ASSIGN(nelmts, hsize_t, snelmts, hssize_t);
+
     /* Fill the DXPL cache values for later use */
     if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
 
     /* Set up datatype info for operation */
-    if(H5D__typeinfo_init(dataset, dxpl_cache, dxpl_id, mem_type_id, TRUE, &type_info) < 0)
+    if(H5D__typeinfo_init(dataset, dxpl_cache, dxpl_id, mem_type_id, TRUE, nelmts, &type_info) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to set up type info")
     type_info_init = TRUE;
 
@@ -679,16 +819,6 @@ H5D__write(H5D_t *dataset, hid_t mem_type_id, const H5S_t *mem_space,
     } /* end else */
 #endif /*H5_HAVE_PARALLEL*/
 
-    /* Initialize dataspace information */
-    if(!file_space)
-        file_space = dataset->shared->space;
-    if(!mem_space)
-        mem_space = file_space;
-
-    if((snelmts = H5S_GET_SELECT_NPOINTS(mem_space)) < 0)
-	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "src dataspace has invalid selection")
-    H5_CHECKED_ASSIGN(nelmts, hsize_t, snelmts, hssize_t);
-
     /* Make certain that the number of elements in each selection is the same */
     if(nelmts != (hsize_t)H5S_GET_SELECT_NPOINTS(file_space))
 	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "src and dest data spaces have different sizes")
@@ -792,6 +922,10 @@ H5D__write(H5D_t *dataset, hid_t mem_type_id, const H5S_t *mem_space,
     if((*io_info.io_ops.multi_write)(&io_info, &type_info, nelmts, file_space, mem_space, fm) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write data")
 
+    /* Complete any writes the file driver is still working on */
+    if(H5F_block_wait(dataset->oloc.file, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't complete data writes")
+
 #ifdef OLD_WAY
 /*
  * This was taken out because it can be called in a parallel program with
@@ -831,7 +965,7 @@ done:
     }
 
     /* Shut down datatype info for operation */
-    if(type_info_init && H5D__typeinfo_term(&type_info) < 0)
+    if(type_info_init && H5D__typeinfo_term(dataset, &type_info) < 0)
         HDONE_ERROR(H5E_DATASET, H5E_CANTCLOSEOBJ, FAIL, "unable to shut down type info")
 
     /* discard projected mem space if it was created */
@@ -889,6 +1023,7 @@ const
     io_info->dset = dset;
     io_info->dxpl_cache = dxpl_cache;
     io_info->store = store;
+    io_info->vec = NULL;
 
     /* Set I/O operations to initial values */
     io_info->layout_ops = *dset->shared->layout.ops;
@@ -930,6 +1065,12 @@ done:
  * Purpose:	Routine for determining correct datatype information for
  *              each I/O action.
  *
+ *              With the library's default buffer settings the conversion
+ *              buffers are sized to the NELMTS elements selected, up to
+ *              the size returned by H5D__typeinfo_strip_size(), and are
+ *              borrowed from the dataset, which keeps the last ones used
+ *              between I/O calls.
+ *
  * Return:	Non-negative on success/Negative on failure
  *
  * Programmer:	Quincey Koziol
@@ -939,7 +1080,7 @@ done:
  */
 static herr_t
 H5D__typeinfo_init(const H5D_t *dset, const H5D_dxpl_cache_t *dxpl_cache,
-    hid_t dxpl_id, hid_t mem_type_id, hbool_t do_write,
+    hid_t dxpl_id, hid_t mem_type_id, hbool_t do_write, hsize_t nelmts,
     H5D_type_info_t *type_info)
 {
     const H5T_t	*src_type;              /* Source datatype */
@@ -1000,6 +1141,7 @@ H5D__typeinfo_init(const H5D_t *dset, const H5D_dxpl_cache_t *dxpl_cache,
     } /* end if */
     else {
         size_t	target_size;		/* Desired buffer size	*/
+        hbool_t default_buffer_info;    /* Whether the buffer information are the defaults */
 
         /* Check if the datatypes are compound subsets of one another */
         type_info->cmpd_subset = H5T_path_compound_subset(type_info->tpath);
@@ -1025,14 +1167,23 @@ H5D__typeinfo_init(const H5D_t *dset, const H5D_dxpl_cache_t *dxpl_cache,
         /* Get buffer size from DXPL */
         target_size = dxpl_cache->max_temp_buf;
 
-        /* If the buffer is too small to hold even one element, try to make it bigger */
-        if(target_size < type_info->max_type_size) {
-            hbool_t default_buffer_info;    /* Whether the buffer information are the defaults */
+        /* Detect if we have all default settings for buffers */
+        default_buffer_info = (hbool_t)((H5D_TEMP_BUF_SIZE == dxpl_cache->max_temp_buf)
+                && (NULL == dxpl_cache->tconv_buf) && (NULL == dxpl_cache->bkgr_buf));
 
-            /* Detect if we have all default settings for buffers */
-            default_buffer_info = (hbool_t)((H5D_TEMP_BUF_SIZE == dxpl_cache->max_temp_buf)
-                    && (NULL == dxpl_cache->tconv_buf) && (NULL == dxpl_cache->bkgr_buf));
+        /*
+         * With the default settings, size the buffer for the selection,
+         * up to a strip that stays in the processor's cache while it is
+         * gathered, converted and scattered.
+         */
+        if(default_buffer_info) {
+            target_size = H5D__typeinfo_strip_size();
+            if(nelmts < (hsize_t)(target_size / type_info->max_type_size))
+                target_size = (size_t)nelmts * type_info->max_type_size;
+        } /* end if */
 
+        /* If the buffer is too small to hold even one element, try to make it bigger */
+        if(target_size < type_info->max_type_size) {
             /* Check if we are using the default buffer info */
             if(default_buffer_info)
                 /* OK to get bigger for library default settings */
@@ -1054,27 +1205,52 @@ H5D__typeinfo_init(const H5D_t *dset, const H5D_dxpl_cache_t *dxpl_cache,
          * supplied one through the xfer properties. Instead of allocating a
          * buffer which is the exact size, we allocate the target size.  The
          * malloc() is usually less resource-intensive if we allocate/free the
-         * same size over and over.
+         * same size over and over.  The dataset's buffer from an earlier
+         * call is used when it is large enough.
          */
         if(NULL == (type_info->tconv_buf = (uint8_t *)dxpl_cache->tconv_buf)) {
-            /* Allocate temporary buffer */
-            if(NULL == (type_info->tconv_buf = H5FL_BLK_MALLOC(type_conv, target_size)))
-                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for type conversion")
+            if(dset->shared->tconv_buf && dset->shared->tconv_buf_size >= target_size) {
+                /* Borrow the dataset's buffer */
+                type_info->tconv_buf = dset->shared->tconv_buf;
+                type_info->tconv_buf_size = dset->shared->tconv_buf_size;
+                dset->shared->tconv_buf = NULL;
+                dset->shared->tconv_buf_size = 0;
+            } /* end if */
+            else {
+                /* Allocate temporary buffer */
+                if(NULL == (type_info->tconv_buf = H5FL_BLK_MALLOC(type_conv, target_size)))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for type conversion")
+                type_info->tconv_buf_size = target_size;
+            } /* end else */
             type_info->tconv_buf_allocated = TRUE;
         } /* end if */
         if(type_info->need_bkg && NULL == (type_info->bkg_buf = (uint8_t *)dxpl_cache->bkgr_buf)) {
             size_t	bkg_size;		/* Desired background buffer size	*/
 
             /* Compute the background buffer size */
-            /* (don't try to use buffers smaller than the default size) */
+            /* (don't try to use buffers smaller than the default size,
+             *  unless the default size was adapted to the selection) */
             bkg_size = type_info->request_nelmts * type_info->dst_type_size;
-            if(bkg_size < dxpl_cache->max_temp_buf)
+            if(!default_buffer_info && bkg_size < dxpl_cache->max_temp_buf)
                 bkg_size = dxpl_cache->max_temp_buf;
 
-            /* Allocate background buffer */
-            /* (Need calloc()-like call since memory needs to be initialized) */
-            if(NULL == (type_info->bkg_buf = H5FL_BLK_CALLOC(type_conv, bkg_size)))
-                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for background conversion")
+            if(dset->shared->bkg_buf && dset->shared->bkg_buf_size >= bkg_size) {
+                /* Borrow the dataset's buffer */
+                /* (Its contents are left over from earlier I/O, but the
+                 *  background is gathered before every conversion that
+                 *  uses it) */
+                type_info->bkg_buf = dset->shared->bkg_buf;
+                type_info->bkg_buf_size = dset->shared->bkg_buf_size;
+                dset->shared->bkg_buf = NULL;
+                dset->shared->bkg_buf_size = 0;
+            } /* end if */
+            else {
+                /* Allocate background buffer */
+                /* (Need calloc()-like call since memory needs to be initialized) */
+                if(NULL == (type_info->bkg_buf = H5FL_BLK_CALLOC(type_conv, bkg_size)))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for background conversion")
+                type_info->bkg_buf_size = bkg_size;
+            } /* end else */
             type_info->bkg_buf_allocated = TRUE;
         } /* end if */
     } /* end else */
@@ -1083,6 +1259,46 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__typeinfo_init() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__typeinfo_strip_size
+ *
+ * Purpose:	Determine the size of the datatype conversion buffer used
+ *              with the library's default buffer settings: the larger of
+ *              one core's share of the processor's L2 or L3 cache and
+ *              H5D_TEMP_BUF_SIZE.  The size is only looked up once.
+ *
+ * Return:	Buffer size in bytes (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5D__typeinfo_strip_size(void)
+{
+    static size_t strip_size = 0;       /* Size found on first call */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(0 == strip_size) {
+        size_t cache_size = 0;          /* Cache bytes available to one core */
+#if defined(_SC_LEVEL2_CACHE_SIZE) && defined(_SC_LEVEL3_CACHE_SIZE) && defined(_SC_NPROCESSORS_ONLN)
+        long l2 = HDsysconf(_SC_LEVEL2_CACHE_SIZE);
+        long l3 = HDsysconf(_SC_LEVEL3_CACHE_SIZE);
+        long ncpus = HDsysconf(_SC_NPROCESSORS_ONLN);
+
+        if(l2 > 0)
+            cache_size = (size_t)l2;
+        if(l3 > 0 && ncpus > 0 && (size_t)(l3 / ncpus) > cache_size)
+            cache_size = (size_t)(l3 / ncpus);
+#endif /* _SC_LEVEL2_CACHE_SIZE && _SC_LEVEL3_CACHE_SIZE && _SC_NPROCESSORS_ONLN */
+
+        /* Keep the conversion and background buffers within the cache */
+        strip_size = MAX(cache_size / 2, H5D_TEMP_BUF_SIZE);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(strip_size)
+} /* end H5D__typeinfo_strip_size() */
+
 #ifdef H5_HAVE_PARALLEL
 
 /*-------------------------------------------------------------------------
@@ -1238,6 +1454,10 @@ done:
  *
  * Purpose:	Common logic for terminating a type info object
  *
+ *              Buffers the library allocated are handed to the dataset for
+ *              later I/O calls when it doesn't hold a larger one already;
+ *              the smaller buffer is released.
+ *
  * Return:	Non-negative on success/Negative on failure
  *
  * Programmer:	Quincey Koziol
@@ -1246,18 +1466,32 @@ done:
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5D__typeinfo_term(const H5D_type_info_t *type_info)
+H5D__typeinfo_term(const H5D_t *dset, const H5D_type_info_t *type_info)
 {
     FUNC_ENTER_STATIC_NOERR
 
-    /* Check for releasing datatype conversion & background buffers */
+    /* Check for keeping or releasing datatype conversion & background buffers */
     if(type_info->tconv_buf_allocated) {
         HDassert(type_info->tconv_buf);
-        (void)H5FL_BLK_FREE(type_conv, type_info->tconv_buf);
+        if(dset->shared->tconv_buf_size < type_info->tconv_buf_size) {
+            if(dset->shared->tconv_buf)
+                (void)H5FL_BLK_FREE(type_conv, dset->shared->tconv_buf);
+            dset->shared->tconv_buf = type_info->tconv_buf;
+            dset->shared->tconv_buf_size = type_info->tconv_buf_size;
+        } /* end if */
+        else
+            (void)H5FL_BLK_FREE(type_conv, type_info->tconv_buf);
     } /* end if */
     if(type_info->bkg_buf_allocated) {
         HDassert(type_info->bkg_buf);
-        (void)H5FL_BLK_FREE(type_conv, type_info->bkg_buf);
+        if(dset->shared->bkg_buf_size < type_info->bkg_buf_size) {
+            if(dset->shared->bkg_buf)
+                (void)H5FL_BLK_FREE(type_conv, dset->shared->bkg_buf);
+            dset->shared->bkg_buf = type_info->bkg_buf;
+            dset->shared->bkg_buf_size = type_info->bkg_buf_size;
+        } /* end if */
+        else
+            (void)H5FL_BLK_FREE(type_conv, type_info->bkg_buf);
     } /* end if */
 
     FUNC_LEAVE_NOAPI(SUCCEED)
@@ -54,6 +54,7 @@
     (io_info)->md_dxpl_id = dxpl_m;                                     \
     (io_info)->store = str;                                             \
     (io_info)->op_type = H5D_IO_OP_WRITE;                               \
+    (io_info)->vec = NULL;                                              \
     (io_info)->u.wbuf = buf
 #define H5D_BUILD_IO_INFO_RD(io_info, ds, dxpl_c, dxpl_m, dxpl_r, str, buf) \
     (io_info)->dset = ds;                                               \
@@ -62,12 +63,23 @@
     (io_info)->md_dxpl_id = dxpl_m;                                     \
     (io_info)->store = str;                                             \
     (io_info)->op_type = H5D_IO_OP_READ;                                \
+    (io_info)->vec = NULL;                                              \
     (io_info)->u.rbuf = buf
 
 /* Flags for marking aspects of a dataset dirty */
 #define H5D_MARK_SPACE  0x01
 #define H5D_MARK_LAYOUT  0x02
 
+/* Automatic resizing of the raw data chunk cache, after the metadata
+ * cache's H5C__auto_adjust_cache_size: the hit rate is checked after each
+ * epoch of chunk accesses, the cache doubles when it's below the lower
+ * threshold, and the chunks not accessed for the last few epochs are
+ * evicted when it's above the upper threshold */
+#define H5D_CHUNK_CACHE_EPOCH_LENGTH    100     /* Chunk accesses per epoch */
+#define H5D_CHUNK_CACHE_LOWER_HR        0.9     /* Grow the cache below this hit rate */
+#define H5D_CHUNK_CACHE_UPPER_HR        0.999   /* Age out chunks above this hit rate */
+#define H5D_CHUNK_CACHE_AGE_EPOCHS      3       /* Epochs a chunk must go unaccessed to age out */
+
 /* Default creation parameters for chunk index data structures */
 /* See H5O_layout_chunk_t */
 
@@ -114,8 +126,10 @@ typedef struct H5D_type_info_t {
     size_t request_nelmts;		/* Requested strip mine	*/
     uint8_t *tconv_buf;	                /* Datatype conv buffer	*/
     hbool_t tconv_buf_allocated;        /* Whether the type conversion buffer was allocated */
+    size_t tconv_buf_size;              /* Size of allocated type conversion buffer */
     uint8_t *bkg_buf;	                /* Background buffer	*/
     hbool_t bkg_buf_allocated;          /* Whether the background buffer was allocated */
+    size_t bkg_buf_size;                /* Size of allocated background buffer */
 } H5D_type_info_t;
 
 /* Forward declaration of structs used below */
@@ -210,6 +224,18 @@ typedef enum H5D_io_op_type_t {
     H5D_IO_OP_WRITE         /* Write operation */
 } H5D_io_op_type_t;
 
+/* List of raw data blocks whose I/O is deferred, so that they can be
+ * passed to the file driver in a single vector I/O call.
+ */
+typedef struct H5D_io_vec_t {
+    size_t nused;           /* Number of blocks in the list */
+    size_t nalloc;          /* Number of blocks allocated */
+    H5FD_mem_t *types;      /* Memory type of each block */
+    haddr_t *addrs;         /* File address of each block */
+    size_t *sizes;          /* Size of each block */
+    void **bufs;            /* Memory buffer for each block */
+} H5D_io_vec_t;
+
 typedef struct H5D_io_info_t {
     const H5D_t *dset;          /* Pointer to dataset being operated on */
 #ifndef H5_HAVE_PARALLEL
@@ -231,6 +257,7 @@ typedef struct H5D_io_info_t {
     H5D_layout_ops_t layout_ops;    /* Dataset layout I/O operation function pointers */
     H5D_io_ops_t io_ops;        /* I/O operation function pointers */
     H5D_io_op_type_t op_type;
+    H5D_io_vec_t *vec;          /* Deferred raw data blocks, shared across calls (or NULL) */
     union {
         void *rbuf;             /* Pointer to buffer for read */
         const void *wbuf;       /* Pointer to buffer to write */
@@ -413,21 +440,45 @@ typedef struct H5D_rdcc_t {
         unsigned	nhits;	/* Number of cache hits			*/
         unsigned	nmisses;/* Number of cache misses		*/
         unsigned	nflushes;/* Number of cache flushes		*/
+        unsigned	nbypasses;/* Number of accesses to chunks too large for the cache */
+        unsigned	nresizes;/* Number of automatic cache resizes	*/
     } stats;
     size_t		nbytes_max; /* Maximum cached raw data in bytes	*/
     size_t		nslots;	/* Number of chunk slots allocated	*/
+    unsigned		nways;	/* Number of slots (ways) in each set	*/
+    size_t		nsets;	/* Number of sets of slots in the hash table */
     double		w0;     /* Chunk preemption policy          */
+    hsize_t		ticks;	/* Access counter, for LRU within a set */
     struct H5D_rdcc_ent_t *head; /* Head of doubly linked list		*/
     struct H5D_rdcc_ent_t *tail; /* Tail of doubly linked list		*/
     struct H5D_rdcc_ent_t *tmp_head; /* Head of temporary doubly linked list.  Chunks on this list are not in the hash table (slot).  The head entry is a sentinel (does not refer to an actual chunk). */
     size_t		nbytes_used; /* Current cached raw data in bytes */
     int			nused;	/* Number of chunk slots in use		*/
     H5D_chunk_cached_t last;    /* Cached copy of last chunk information */
-    struct H5D_rdcc_ent_t **slot; /* Chunk slots, each points to a chunk*/
+    struct H5D_rdcc_ent_t **slot; /* Chunk slots, each points to a chunk.
+                                   * Slots are grouped into 'nsets' sets of
+                                   * 'nways' consecutive slots each */
     H5SL_t		*sel_chunks; /* Skip list containing information for each chunk selected */
     H5S_t		*single_space; /* Dataspace for single element I/O on chunks */
     H5D_chunk_info_t    *single_chunk_info;  /* Pointer to single chunk's info */
 
+    /* Automatic resizing (see H5D__chunk_cache_auto_resize) */
+    hbool_t		auto_resize;	/* Whether to resize the cache automatically */
+    size_t		nbytes_min;	/* Size set by the application, which the cache never shrinks below */
+    unsigned		epoch_nhits;	/* Hits at the start of the epoch */
+    unsigned		epoch_naccesses; /* Hits, misses and bypasses at the start of the epoch */
+    unsigned		nepochs;	/* Number of epochs completed */
+    hsize_t		epoch_ticks[H5D_CHUNK_CACHE_AGE_EPOCHS]; /* Access counter at the start of the last few epochs */
+
+    /* Write-behind queue of evicted dirty chunks, waiting to be filtered
+     * and written together (see H5D__chunk_wb_drain) */
+    size_t		wb_nbytes_max;	/* Maximum queued raw data in bytes, or 0 to write chunks when evicted */
+    size_t		wb_nbytes_used;	/* Current queued raw data in bytes */
+    H5SL_t		*wb_queue;	/* Queued entries, by scaled coordinates */
+    H5Z_EDC_t		wb_err_detect;	/* Error detection for filtering queued chunks */
+    H5Z_cb_t		wb_filter_cb;	/* Filter callback for filtering queued chunks */
+    unsigned		wb_filter_threads; /* Number of threads filtering queued chunks */
+
     /* Cached information about scaled dataspace dimensions */
     hsize_t             scaled_dims[H5S_MAX_RANK];          /* The scaled dim sizes */
     hsize_t             scaled_power2up[H5S_MAX_RANK];      /* The scaled dim sizes, rounded up to next power of 2 */
@@ -478,6 +529,12 @@ typedef struct H5D_shared_t {
 
     H5D_append_flush_t  append_flush;   /* Append flush property information */
     char                *extfile_prefix; /* expanded external file prefix */
+
+    /* Datatype conversion buffers kept between I/O calls */
+    uint8_t             *tconv_buf;     /* Type conversion buffer, or NULL */
+    size_t              tconv_buf_size; /* Size of type conversion buffer */
+    uint8_t             *bkg_buf;       /* Background buffer, or NULL */
+    size_t              bkg_buf_size;   /* Size of background buffer */
 } H5D_shared_t;
 
 struct H5D_t {
@@ -654,6 +711,11 @@ H5_DLL herr_t H5D__contig_write(H5D_io_info_t *io_info, const H5D_type_info_t *t
 H5_DLL herr_t H5D__contig_copy(H5F_t *f_src, const H5O_storage_contig_t *storage_src,
     H5F_t *f_dst, H5O_storage_contig_t *storage_dst, H5T_t *src_dtype,
     H5O_copy_t *cpy_info, hid_t dxpl_id);
+H5_DLL herr_t H5D__io_vec_add(H5D_io_vec_t *vec, haddr_t addr, size_t size,
+    void *buf);
+H5_DLL herr_t H5D__io_vec_read(const H5F_t *f, hid_t dxpl_id, H5D_io_vec_t *vec);
+H5_DLL herr_t H5D__io_vec_write(const H5F_t *f, hid_t dxpl_id, H5D_io_vec_t *vec);
+H5_DLL void H5D__io_vec_free(H5D_io_vec_t *vec);
 H5_DLL herr_t H5D__contig_delete(H5F_t *f, hid_t dxpl_id,
     const H5O_storage_t *store);
 
@@ -687,6 +749,20 @@ H5_DLL herr_t H5D__chunk_delete(H5F_t *f, hid_t dxpl_id, H5O_t *oh,
     H5O_storage_t *store);
 H5_DLL herr_t H5D__chunk_direct_write(const H5D_t *dset, hid_t dxpl_id, uint32_t filters, 
          hsize_t *offset, uint32_t data_size, const void *buf);
+H5_DLL herr_t H5D__chunk_direct_write_multi(const H5D_t *dset, hid_t dxpl_id,
+    size_t nchunks, const uint32_t filters[], const hsize_t *offsets[],
+    const size_t data_sizes[], const void *bufs[]);
+H5_DLL herr_t H5D__chunk_direct_read(const H5D_t *dset, hid_t dxpl_id,
+    const hsize_t *offset, uint32_t *filters, void *buf);
+H5_DLL herr_t H5D__chunk_direct_read_multi(const H5D_t *dset, hid_t dxpl_id,
+    size_t nchunks, const hsize_t *offsets[], uint32_t filters[],
+    size_t data_sizes[], void *arena, size_t arena_size);
+H5_DLL herr_t H5D__chunk_check_offset(const H5D_t *dset, const hsize_t *offset);
+H5_DLL herr_t H5D__get_chunk_info_by_coord(const H5D_t *dset, hid_t dxpl_id,
+    const hsize_t *offset, unsigned *filter_mask, haddr_t *addr, hsize_t *size);
+H5_DLL herr_t H5D__get_chunk_info_by_range(const H5D_t *dset, hid_t dxpl_id,
+    const hsize_t *start, const hsize_t *count, size_t max_chunks, hsize_t *offsets,
+    unsigned *filter_masks, haddr_t *addrs, hsize_t *sizes, size_t *nchunks);
 #ifdef H5D_CHUNK_DEBUG
 H5_DLL herr_t H5D__chunk_stats(const H5D_t *dset, hbool_t headers);
 #endif /* H5D_CHUNK_DEBUG */
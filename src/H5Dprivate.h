@@ -52,6 +52,9 @@
 #define H5D_ACS_DATA_CACHE_NUM_SLOTS_NAME   "rdcc_nslots"   /* Size of raw data chunk cache(slots) */
 #define H5D_ACS_DATA_CACHE_BYTE_SIZE_NAME   "rdcc_nbytes"   /* Size of raw data chunk cache(bytes) */
 #define H5D_ACS_PREEMPT_READ_CHUNKS_NAME    "rdcc_w0"       /* Preemption read chunks first */
+#define H5D_ACS_DATA_CACHE_NUM_WAYS_NAME    "rdcc_nways"    /* Associativity of raw data chunk cache */
+#define H5D_ACS_DATA_CACHE_AUTO_RESIZE_NAME "rdcc_auto_resize" /* Whether to resize raw data chunk cache automatically */
+#define H5D_ACS_WRITE_BEHIND_NBYTES_NAME    "rdcc_wb_nbytes" /* Size of raw data chunk write-behind queue(bytes) */
 #define H5D_ACS_VDS_VIEW_NAME               "vds_view"      /* VDS view option */
 #define H5D_ACS_VDS_PRINTF_GAP_NAME         "vds_printf_gap" /* VDS printf gap size */
 #define H5D_ACS_APPEND_FLUSH_NAME    "append_flush"         /* Append flush actions */
@@ -81,6 +84,7 @@
 #define H5D_MPIO_GLOBAL_NO_COLLECTIVE_CAUSE_NAME "global_no_collective_cause"  /* cause of broken collective I/O in all processes */
 #define H5D_XFER_EDC_NAME               "err_detect"    /* EDC */
 #define H5D_XFER_FILTER_CB_NAME         "filter_cb"     /* Filter callback function */
+#define H5D_XFER_FILTER_THREADS_NAME    "filter_threads" /* Number of threads for the filter pipeline */
 #define H5D_XFER_CONV_CB_NAME           "type_conv_cb"  /* Type conversion callback function */
 #define H5D_XFER_XFORM_NAME             "data_transform" /* Data transform */
 #ifdef H5_HAVE_INSTRUMENTED_LIBRARY
@@ -135,6 +139,7 @@ typedef struct H5D_dxpl_cache_t {
     H5FD_mpio_collective_opt_t coll_opt_mode; /* Parallel transfer with independent IO or collective IO with this mode */
 #endif /*H5_HAVE_PARALLEL*/
     H5Z_cb_t filter_cb;         /* Filter callback function (H5D_XFER_FILTER_CB_NAME) */
+    unsigned filter_threads;    /* Number of filter pipeline threads (H5D_XFER_FILTER_THREADS_NAME) */
     H5Z_data_xform_t *data_xform_prop; /* Data transform prop (H5D_XFER_XFORM_NAME) */
 } H5D_dxpl_cache_t;
 
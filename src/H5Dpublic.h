@@ -42,6 +42,20 @@
 #define H5D_XFER_DIRECT_CHUNK_WRITE_FILTERS_NAME	"direct_chunk_filters"
 #define H5D_XFER_DIRECT_CHUNK_WRITE_OFFSET_NAME		"direct_chunk_offset"
 #define H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZE_NAME	"direct_chunk_datasize"
+#define H5D_XFER_DIRECT_CHUNK_WRITE_NCHUNKS_NAME	"direct_chunk_nchunks"
+#define H5D_XFER_DIRECT_CHUNK_WRITE_FILTERS_LIST_NAME	"direct_chunk_filters_list"
+#define H5D_XFER_DIRECT_CHUNK_WRITE_OFFSET_LIST_NAME	"direct_chunk_offset_list"
+#define H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZE_LIST_NAME	"direct_chunk_datasize_list"
+
+/* Property names for H5DOread_chunk */
+#define H5D_XFER_DIRECT_CHUNK_READ_FLAG_NAME		"direct_chunk_read_flag"
+#define H5D_XFER_DIRECT_CHUNK_READ_OFFSET_NAME		"direct_chunk_read_offset"
+#define H5D_XFER_DIRECT_CHUNK_READ_FILTERS_NAME		"direct_chunk_read_filters"
+#define H5D_XFER_DIRECT_CHUNK_READ_NCHUNKS_NAME		"direct_chunk_read_nchunks"
+#define H5D_XFER_DIRECT_CHUNK_READ_OFFSET_LIST_NAME	"direct_chunk_read_offset_list"
+#define H5D_XFER_DIRECT_CHUNK_READ_FILTERS_LIST_NAME	"direct_chunk_read_filters_list"
+#define H5D_XFER_DIRECT_CHUNK_READ_DATASIZE_LIST_NAME	"direct_chunk_read_datasize_list"
+#define H5D_XFER_DIRECT_CHUNK_READ_BUF_SIZE_NAME	"direct_chunk_read_buf_size"
  
 /*******************/
 /* Public Typedefs */
@@ -112,6 +126,20 @@ typedef enum H5D_vds_view_t {
 /* Callback for H5Pset_append_flush() in a dataset access property list */
 typedef herr_t (*H5D_append_cb_t)(hid_t dataset_id, hsize_t *cur_dims, void *op_data);
 
+/* Statistics of a dataset's raw data chunk cache, from H5Dget_chunk_cache_stats() */
+typedef struct H5D_chunk_cache_stats_t {
+    unsigned    nhits;          /* Chunk accesses satisfied by the cache */
+    unsigned    nmisses;        /* Chunk accesses that read the chunk into the cache */
+    unsigned    nbypasses;      /* Chunk accesses that went to the file because the chunk is too large for the cache */
+    unsigned    ninits;         /* Chunks created in the cache */
+    unsigned    nflushes;       /* Chunks written to the file */
+    unsigned    nresizes;       /* Automatic resizes of the cache */
+    size_t      nbytes_max;     /* Current size of the cache (bytes) */
+    size_t      nbytes_used;    /* Bytes of chunks in the cache */
+    size_t      nslots;         /* Number of chunk slots */
+    size_t      nused;          /* Number of chunks in the cache */
+} H5D_chunk_cache_stats_t;
+
 /********************/
 /* Public Variables */
 /********************/
@@ -149,6 +177,12 @@ H5_DLL hid_t H5Dget_create_plist(hid_t dset_id);
 H5_DLL hid_t H5Dget_access_plist(hid_t dset_id);
 H5_DLL hsize_t H5Dget_storage_size(hid_t dset_id);
 H5_DLL haddr_t H5Dget_offset(hid_t dset_id);
+H5_DLL herr_t H5Dget_chunk_info_by_coord(hid_t dset_id, const hsize_t *offset,
+    unsigned *filter_mask, haddr_t *addr, hsize_t *size);
+H5_DLL herr_t H5Dget_chunk_info_by_range(hid_t dset_id, const hsize_t *start,
+    const hsize_t *count, size_t max_chunks, hsize_t *offsets, unsigned *filter_masks,
+    haddr_t *addrs, hsize_t *sizes, size_t *nchunks);
+H5_DLL herr_t H5Dget_chunk_cache_stats(hid_t dset_id, H5D_chunk_cache_stats_t *stats);
 H5_DLL herr_t H5Dread(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
 			hid_t file_space_id, hid_t plist_id, void *buf/*out*/);
 H5_DLL herr_t H5Dwrite(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
@@ -49,6 +49,8 @@ static herr_t H5D__scatter_file(const H5D_io_info_t *io_info,
 static size_t H5D__gather_file(const H5D_io_info_t *io_info,
     const H5S_t *file_space, H5S_sel_iter_t *file_iter, size_t nelmts,
     void *buf);
+static htri_t H5D__strided_mem(const H5S_t *space, H5S_sel_iter_t *iter,
+    size_t nelmts, hbool_t gather, void *dst, const void *src);
 static size_t H5D__gather_mem(const void *_buf,
     const H5S_t *space, H5S_sel_iter_t *iter, size_t nelmts,
     const H5D_dxpl_cache_t *dxpl_cache, void *_tgath_buf/*out*/);
@@ -266,6 +268,64 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5D__gather_file() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__strided_mem
+ *
+ * Purpose:	Copies NELMTS elements between the selection of SPACE in
+ *		application memory and a contiguous buffer, starting at the
+ *		current position of ITER, using strided loops instead of
+ *		sequence lists when the selection is regular.  When GATHER
+ *		is set, SRC is the application memory, otherwise DST is.
+ *		ITER is advanced past the elements copied.
+ *
+ * Return:	Success:	TRUE if the elements were copied, FALSE
+ *				if the selection isn't regular
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static htri_t
+H5D__strided_mem(const H5S_t *space, H5S_sel_iter_t *iter, size_t nelmts,
+    hbool_t gather, void *dst, const void *src)
+{
+    H5S_strided_t layout;       /* Selection as strided loops */
+    hssize_t npoints;           /* Number of elements in selection */
+    hsize_t skip;               /* Bytes of the selection already iterated over */
+    htri_t is_strided;          /* Whether the selection is regular */
+    htri_t ret_value = TRUE;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Describe the selection as strided loops, if possible */
+    if((is_strided = H5S_select_get_strided(space, iter->elmt_size, &layout)) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't describe selection")
+    if(!is_strided)
+        HGOTO_DONE(FALSE)
+
+    /* Start where the iterator is */
+    if((npoints = H5S_GET_SELECT_NPOINTS(space)) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOUNT, FAIL, "can't get number of elements selected")
+    skip = ((hsize_t)npoints - iter->elmt_left) * iter->elmt_size;
+
+    if(gather)
+        H5S_select_strided_copy(dst, NULL, (hsize_t)0, src, &layout, skip, nelmts * iter->elmt_size);
+    else
+        H5S_select_strided_copy(dst, &layout, skip, src, NULL, (hsize_t)0, nelmts * iter->elmt_size);
+
+    /* Advance the iterator, or just mark it finished when it has no more
+     * elements (stepping a regular hyperslab iterator is per block) */
+    if(nelmts < iter->elmt_left) {
+        if(H5S_SELECT_ITER_NEXT(iter, nelmts) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTNEXT, FAIL, "unable to advance selection iterator")
+    } /* end if */
+    else
+        iter->elmt_left = 0;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* H5D__strided_mem() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__scatter_mem
@@ -296,6 +356,7 @@ H5D__scatter_mem (const void *_tscat_buf, const H5S_t *space,
     size_t curr_seq;            /* Current sequence being processed */
     size_t nelem;               /* Number of elements used in sequences */
     size_t vec_size;            /* Vector length */
+    htri_t is_strided;          /* Whether the selection was copied with strided loops */
     herr_t ret_value = SUCCEED; /* Number of elements scattered */
 
     FUNC_ENTER_PACKAGE
@@ -307,6 +368,12 @@ H5D__scatter_mem (const void *_tscat_buf, const H5S_t *space,
     HDassert(nelmts > 0);
     HDassert(buf);
 
+    /* Copy regular selections without sequence lists */
+    if((is_strided = H5D__strided_mem(space, iter, nelmts, FALSE, buf, tscat_buf)) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "strided copy failed")
+    if(is_strided)
+        HGOTO_DONE(SUCCEED)
+
     /* Allocate the vector I/O arrays */
     if(dxpl_cache->vec_size > H5D_IO_VECTOR_SIZE)
         vec_size = dxpl_cache->vec_size;
@@ -380,6 +447,7 @@ H5D__gather_mem(const void *_buf, const H5S_t *space,
     size_t curr_seq;            /* Current sequence being processed */
     size_t nelem;               /* Number of elements used in sequences */
     size_t vec_size;            /* Vector length */
+    htri_t is_strided;          /* Whether the selection was copied with strided loops */
     size_t ret_value = nelmts;  /* Number of elements gathered */
 
     FUNC_ENTER_STATIC
@@ -391,6 +459,12 @@ H5D__gather_mem(const void *_buf, const H5S_t *space,
     HDassert(nelmts > 0);
     HDassert(tgath_buf);
 
+    /* Copy regular selections without sequence lists */
+    if((is_strided = H5D__strided_mem(space, iter, nelmts, TRUE, tgath_buf, buf)) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, 0, "strided copy failed")
+    if(is_strided)
+        HGOTO_DONE(nelmts)
+
     /* Allocate the vector I/O arrays */
     if(dxpl_cache->vec_size > H5D_IO_VECTOR_SIZE)
         vec_size = dxpl_cache->vec_size;
@@ -493,6 +567,38 @@ H5D__scatgath_read(const H5D_io_info_t *io_info, const H5D_type_info_t *type_inf
         HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize background selection information")
     bkg_iter_init = TRUE;	/*file selection iteration info has been initialized */
 
+    /*
+     * If no background is needed, the destination type is at least as wide
+     * as the source and the memory selection is one contiguous block, the
+     * file data fits in that block: read it there and convert it in place,
+     * bypassing the conversion buffer and the scatter.
+     */
+    if(H5T_BKG_NO == type_info->need_bkg && type_info->dst_type_size >= type_info->src_type_size
+            && !(type_info->cmpd_subset && H5T_SUBSET_FALSE != type_info->cmpd_subset->subset)
+            && nelmts <= (hsize_t)((size_t)-1 / type_info->dst_type_size)
+            && TRUE == H5S_SELECT_IS_CONTIGUOUS(mem_space)) {
+        hsize_t mem_off;        /* Offset of block in application buffer */
+        size_t  mem_len;        /* Length of block in application buffer */
+        size_t  nseq, nelem;    /* Sequences and elements in block */
+        uint8_t *block;         /* Block in application buffer */
+
+        if(H5S_SELECT_GET_SEQ_LIST(mem_space, 0, mem_iter, (size_t)1, (size_t)nelmts, &nseq, &nelem, &mem_off, &mem_len) < 0)
+            HGOTO_ERROR(H5E_INTERNAL, H5E_UNSUPPORTED, FAIL, "sequence length generation failed")
+        if(nseq != 1 || nelem != nelmts)
+            HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "contiguous memory selection is not a single block")
+        block = (uint8_t *)buf + mem_off;
+
+        if(H5D__gather_file(io_info, file_space, file_iter, (size_t)nelmts, block/*out*/) != nelmts)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file gather failed")
+        if(H5T_convert(type_info->tpath, type_info->src_type_id, type_info->dst_type_id,
+                (size_t)nelmts, (size_t)0, (size_t)0, block, NULL, io_info->md_dxpl_id) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTCONVERT, FAIL, "datatype conversion failed")
+        if(!type_info->is_xform_noop)
+            if(H5Z_xform_eval(dxpl_cache->data_xform_prop, block, (size_t)nelmts, type_info->mem_type) < 0)
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Error performing data transform")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
     /* Start strip mining... */
     for(smine_start = 0; smine_start < nelmts; smine_start += smine_nelmts) {
         size_t n;               /* Elements operated on */
@@ -114,6 +114,35 @@ H5D__select_io(const H5D_io_info_t *io_info, size_t elmt_size,
     HDassert(TRUE == H5P_isa_class(io_info->raw_dxpl_id, H5P_DATASET_XFER));
     HDassert(io_info->u.rbuf);
 
+    /* Copy directly between regular selections when the storage is a buffer
+     * in memory (compact datasets and chunks in the chunk cache) */
+    if(nelmts > 1 && io_info->layout_ops.readvv == H5D_LOPS_COMPACT->readvv) {
+        H5S_strided_t file_layout;      /* File selection as strided loops */
+        H5S_strided_t mem_layout;       /* Memory selection as strided loops */
+        htri_t file_strided;            /* Whether the file selection is regular */
+        htri_t mem_strided = FALSE;     /* Whether the memory selection is regular */
+
+        if((file_strided = H5S_select_get_strided(file_space, elmt_size, &file_layout)) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't describe file selection")
+        if(file_strided && (mem_strided = H5S_select_get_strided(mem_space, elmt_size, &mem_layout)) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't describe memory selection")
+        if(file_strided && mem_strided) {
+            if(io_info->op_type == H5D_IO_OP_READ)
+                H5S_select_strided_copy(io_info->u.rbuf, &mem_layout, (hsize_t)0,
+                        io_info->store->compact.buf, &file_layout, (hsize_t)0, nelmts * elmt_size);
+            else {
+                HDassert(io_info->op_type == H5D_IO_OP_WRITE);
+                H5S_select_strided_copy(io_info->store->compact.buf, &file_layout, (hsize_t)0,
+                        io_info->u.wbuf, &mem_layout, (hsize_t)0, nelmts * elmt_size);
+
+                /* Mark the buffer as dirty, as H5D__compact_writevv() does */
+                *io_info->store->compact.dirty = TRUE;
+            } /* end else */
+
+            HGOTO_DONE(SUCCEED)
+        } /* end if */
+    } /* end if */
+
     /* Allocate the vector I/O arrays */
     if(io_info->dxpl_cache->vec_size > H5D_IO_VECTOR_SIZE)
         vec_size = io_info->dxpl_cache->vec_size;
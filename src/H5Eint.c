@@ -44,6 +44,19 @@
 /* Local Macros */
 /****************/
 
+/* Error stacks are per-thread in thread-safe builds, but the error class and
+ * message IDs they reference are shared.  Serialize updates to the IDs'
+ * reference counts so that library worker threads (see H5TS_run_tasks) may
+ * push and clear errors at the same time.
+ */
+#ifdef H5_HAVE_THREADSAFE
+#define H5E_LOCK_IDS        H5TS_mutex_lock_simple(&H5TS_errstk_lock_g)
+#define H5E_UNLOCK_IDS      H5TS_mutex_unlock_simple(&H5TS_errstk_lock_g)
+#else /* H5_HAVE_THREADSAFE */
+#define H5E_LOCK_IDS
+#define H5E_UNLOCK_IDS
+#endif /* H5_HAVE_THREADSAFE */
+
 
 /******************/
 /* Local Typedefs */
@@ -820,15 +833,18 @@ H5E_push_stack(H5E_t *estack, const char *file, const char *func, unsigned line,
     HDassert(estack);
 
     if(estack->nused < H5E_NSLOTS) {
+        herr_t inc_ret;         /* Result of incrementing the IDs */
+
         /* Increment the IDs to indicate that they are used in this stack */
-        if(H5I_inc_ref(cls_id, FALSE) < 0)
+        H5E_LOCK_IDS;
+        if((inc_ret = H5I_inc_ref(cls_id, FALSE)) >= 0)
+            if((inc_ret = H5I_inc_ref(maj_id, FALSE)) >= 0)
+                inc_ret = H5I_inc_ref(min_id, FALSE);
+        H5E_UNLOCK_IDS;
+        if(inc_ret < 0)
             HGOTO_DONE(FAIL)
 	estack->slot[estack->nused].cls_id = cls_id;
-        if(H5I_inc_ref(maj_id, FALSE) < 0)
-            HGOTO_DONE(FAIL)
 	estack->slot[estack->nused].maj_num = maj_id;
-        if(H5I_inc_ref(min_id, FALSE) < 0)
-            HGOTO_DONE(FAIL)
 	estack->slot[estack->nused].min_num = min_id;
 	if(NULL == (estack->slot[estack->nused].func_name = H5MM_xstrdup(func)))
             HGOTO_DONE(FAIL)
@@ -877,12 +893,20 @@ H5E_clear_entries(H5E_t *estack, size_t nentries)
 
         /* Decrement the IDs to indicate that they are no longer used by this stack */
         /* (In reverse order that they were incremented, so that reference counts work well) */
-        if(H5I_dec_ref(error->min_num) < 0)
+        H5E_LOCK_IDS;
+        if(H5I_dec_ref(error->min_num) < 0) {
+            H5E_UNLOCK_IDS;
             HGOTO_ERROR(H5E_ERROR, H5E_CANTDEC, FAIL, "unable to decrement ref count on error message")
-        if(H5I_dec_ref(error->maj_num) < 0)
+        } /* end if */
+        if(H5I_dec_ref(error->maj_num) < 0) {
+            H5E_UNLOCK_IDS;
             HGOTO_ERROR(H5E_ERROR, H5E_CANTDEC, FAIL, "unable to decrement ref count on error message")
-        if(H5I_dec_ref(error->cls_id) < 0)
+        } /* end if */
+        if(H5I_dec_ref(error->cls_id) < 0) {
+            H5E_UNLOCK_IDS;
             HGOTO_ERROR(H5E_ERROR, H5E_CANTDEC, FAIL, "unable to decrement ref count on error class")
+        } /* end if */
+        H5E_UNLOCK_IDS;
 
         /* Release strings */
         if(error->func_name)
@@ -1493,6 +1493,42 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Fget_metadata_read_retry_info() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Fget_meta_readahead_stats
+ *
+ * Purpose:     Retrieve the statistics for the metadata readahead pages of
+ *              a file (see H5Pset_meta_readahead).
+ *
+ * Return:      Success:        non-negative on success
+ *              Failure:        Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Fget_meta_readahead_stats(hid_t file_id, H5F_meta_readahead_stats_t *stats)
+{
+    H5F_t       *file;                  /* File object for file ID */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "i*x", file_id, stats);
+
+    /* Check args */
+    if(!stats)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no stats struct")
+
+    /* Get the file pointer */
+    if(NULL == (file = (H5F_t *)H5I_object_verify(file_id, H5I_FILE)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "not a file ID")
+
+    /* Copy the statistics */
+    *stats = file->shared->meta_pages.stats;
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Fget_meta_readahead_stats() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5Fget_free_sections
@@ -1615,6 +1615,147 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5FDwrite() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FDread_vector
+ *
+ * Purpose:	Reads COUNT blocks from FILE according to the data transfer
+ *		property list DXPL_ID (which may be the constant
+ *		H5P_DEFAULT).  Block U is SIZES[U] bytes of type TYPES[U]
+ *		starting at address ADDRS[U], and is written into the buffer
+ *		BUFS[U].  Drivers with a 'read_vector' callback receive all
+ *		the blocks in one call.
+ *
+ * Return:	Success:	Non-negative. The read results are written
+ *				into the BUFS buffers which should be
+ *				allocated by the caller.
+ *
+ *		Failure:	Negative. The contents of BUFS are undefined.
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5FDread_vector(H5FD_t *file, hid_t dxpl_id, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    void *bufs[]/*out*/)
+{
+    H5P_genplist_t *dxpl;               /* DXPL object */
+    haddr_t     *rel_addrs = NULL;      /* Relative addresses of the blocks */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE7("e", "*xiz*Mt*a*zx", file, dxpl_id, count, types, addrs, sizes, bufs);
+
+    /* Check args */
+    if(!file || !file->cls)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid file pointer")
+
+    /* Get the default dataset transfer property list if the user didn't provide one */
+    if(H5P_DEFAULT == dxpl_id)
+        dxpl_id = H5P_DATASET_XFER_DEFAULT;
+    else
+        if(TRUE != H5P_isa_class(dxpl_id, H5P_DATASET_XFER))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a data transfer property list")
+    if(count > 0 && (!types || !addrs || !sizes || !bufs))
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "null array")
+    for(u = 0; u < count; u++)
+        if(!bufs[u])
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "null result buffer")
+
+    /* Get the DXPL plist object for DXPL ID */
+    if(NULL == (dxpl = (H5P_genplist_t *)H5I_object(dxpl_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
+
+    /* Compensate for base address addition in internal routine */
+    if(count > 0 && file->base_addr > 0) {
+        if(NULL == (rel_addrs = (haddr_t *)H5MM_malloc(count * sizeof(haddr_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for addresses")
+        for(u = 0; u < count; u++)
+            rel_addrs[u] = addrs[u] - file->base_addr;
+        addrs = rel_addrs;
+    } /* end if */
+
+    /* Do the real work */
+    if(H5FD_read_vector(file, dxpl, count, types, addrs, sizes, bufs) < 0)
+	HGOTO_ERROR(H5E_VFL, H5E_READERROR, FAIL, "file vector read request failed")
+
+done:
+    if(rel_addrs)
+        H5MM_xfree(rel_addrs);
+
+    FUNC_LEAVE_API(ret_value)
+} /* end H5FDread_vector() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FDwrite_vector
+ *
+ * Purpose:	Writes COUNT blocks to FILE according to the data transfer
+ *		property list DXPL_ID (which may be the constant
+ *		H5P_DEFAULT).  Block U is SIZES[U] bytes of type TYPES[U]
+ *		taken from the buffer BUFS[U] and written at address
+ *		ADDRS[U].  The blocks must not overlap.
+ *
+ * Return:	Success:	Non-negative
+ *
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5FDwrite_vector(H5FD_t *file, hid_t dxpl_id, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    const void *bufs[])
+{
+    H5P_genplist_t *dxpl;               /* DXPL object */
+    haddr_t     *rel_addrs = NULL;      /* Relative addresses of the blocks */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE7("e", "*xiz*Mt*a*z**x", file, dxpl_id, count, types, addrs, sizes, bufs);
+
+    /* Check args */
+    if(!file || !file->cls)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid file pointer")
+
+    /* Get the default dataset transfer property list if the user didn't provide one */
+    if(H5P_DEFAULT == dxpl_id)
+        dxpl_id = H5P_DATASET_XFER_DEFAULT;
+    else
+        if(TRUE != H5P_isa_class(dxpl_id, H5P_DATASET_XFER))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a data transfer property list")
+    if(count > 0 && (!types || !addrs || !sizes || !bufs))
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "null array")
+    for(u = 0; u < count; u++)
+        if(!bufs[u])
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "null buffer")
+
+    /* Get the DXPL plist object for DXPL ID */
+    if(NULL == (dxpl = (H5P_genplist_t *)H5I_object(dxpl_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
+
+    /* Compensate for base address addition in internal routine */
+    if(count > 0 && file->base_addr > 0) {
+        if(NULL == (rel_addrs = (haddr_t *)H5MM_malloc(count * sizeof(haddr_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for addresses")
+        for(u = 0; u < count; u++)
+            rel_addrs[u] = addrs[u] - file->base_addr;
+        addrs = rel_addrs;
+    } /* end if */
+
+    /* The real work */
+    if(H5FD_write_vector(file, dxpl, count, types, addrs, sizes, bufs) < 0)
+	HGOTO_ERROR(H5E_VFL, H5E_WRITEERROR, FAIL, "file vector write request failed")
+
+done:
+    if(rel_addrs)
+        H5MM_xfree(rel_addrs);
+
+    FUNC_LEAVE_API(ret_value)
+} /* end H5FDwrite_vector() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5FDflush
@@ -1690,6 +1831,35 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_flush() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_wait
+ *
+ * Purpose:	Completes any I/O requests the driver has accepted but not
+ *		yet finished.  Drivers without a 'wait' callback complete
+ *		every request before returning from it, so nothing happens.
+ *
+ * Return:	Success:	Non-negative
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5FD_wait(H5FD_t *file, hid_t dxpl_id)
+{
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(file && file->cls);
+
+    if(file->cls->wait && (file->cls->wait)(file, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_WRITEERROR, FAIL, "driver wait request failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_wait() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5FDtruncate
@@ -139,6 +139,12 @@ static herr_t H5FD__core_read(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, had
             size_t size, void *buf);
 static herr_t H5FD__core_write(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr_t addr,
             size_t size, const void *buf);
+static herr_t H5FD__core_read_vector(H5FD_t *_file, hid_t dxpl_id, size_t count,
+            const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+            void *bufs[]);
+static herr_t H5FD__core_write_vector(H5FD_t *_file, hid_t dxpl_id, size_t count,
+            const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+            const void *bufs[]);
 static herr_t H5FD__core_flush(H5FD_t *_file, hid_t dxpl_id, hbool_t closing);
 static herr_t H5FD__core_truncate(H5FD_t *_file, hid_t dxpl_id, hbool_t closing);
 static herr_t H5FD_core_lock(H5FD_t *_file, hbool_t rw);
@@ -176,7 +182,9 @@ static const H5FD_class_t H5FD_core_g = {
     H5FD__core_truncate,        /* truncate             */
     H5FD_core_lock,             /* lock                 */
     H5FD_core_unlock,           /* unlock               */
-    H5FD_FLMAP_DICHOTOMY        /* fl_map               */
+    H5FD_FLMAP_DICHOTOMY,       /* fl_map               */
+    H5FD__core_read_vector,     /* read_vector          */
+    H5FD__core_write_vector     /* write_vector         */
 };
 
 /* Define a free list to manage the region type */
@@ -1279,6 +1287,67 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD__core_write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__core_read_vector
+ *
+ * Purpose:     Reads COUNT blocks from FILE, block U being SIZES[U] bytes
+ *              at address ADDRS[U], into the buffers BUFS.  Each block is
+ *              copied out of the memory buffer as by H5FD__core_read().
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__core_read_vector(H5FD_t *_file, hid_t dxpl_id, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    void *bufs[]/*out*/)
+{
+    size_t      u;                              /* Local index variable */
+    herr_t      ret_value = SUCCEED;            /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    for(u = 0; u < count; u++)
+        if(H5FD__core_read(_file, types[u], dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "block read failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__core_read_vector() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__core_write_vector
+ *
+ * Purpose:     Writes COUNT blocks to FILE, block U being SIZES[U] bytes
+ *              at address ADDRS[U], from the buffers BUFS.  Each block is
+ *              copied into the memory buffer as by H5FD__core_write(), in
+ *              order.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__core_write_vector(H5FD_t *_file, hid_t dxpl_id, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    const void *bufs[])
+{
+    size_t      u;                              /* Local index variable */
+    herr_t      ret_value = SUCCEED;            /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    for(u = 0; u < count; u++)
+        if(H5FD__core_write(_file, types[u], dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "block write failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__core_write_vector() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5FD__core_flush
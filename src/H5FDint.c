@@ -39,6 +39,7 @@
 #include "H5Fprivate.h"         /* File access				*/
 #include "H5FDpkg.h"		/* File Drivers				*/
 #include "H5Iprivate.h"		/* IDs			  		*/
+#include "H5MMprivate.h"	/* Memory management			*/
 
 
 /****************/
@@ -298,6 +299,164 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_read_vector
+ *
+ * Purpose:	Private version of H5FDread_vector()
+ *
+ *              Reads COUNT blocks, block U being SIZES[U] bytes of type
+ *              TYPES[U] at the relative address ADDRS[U], into BUFS[U].
+ *              The request is passed to the driver's 'read_vector'
+ *              callback in one call, or to its 'read' callback one block
+ *              at a time when the driver has no 'read_vector' callback.
+ *
+ * Return:	Success:	Non-negative
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5FD_read_vector(H5FD_t *file,
+#ifndef H5_DEBUG_BUILD
+const
+#endif /* H5_DEBUG_BUILD */
+H5P_genplist_t *dxpl, size_t count, const H5FD_mem_t types[],
+    const haddr_t addrs[], const size_t sizes[], void *bufs[]/*out*/)
+{
+    haddr_t     *abs_addrs = NULL;      /* Absolute addresses of the blocks */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(file && file->cls);
+    HDassert(TRUE == H5P_class_isa(H5P_CLASS(dxpl), H5P_CLS_DATASET_XFER_g));
+    HDassert(0 == count || (types && addrs && sizes && bufs));
+
+    /* Fall back to one driver call per block */
+    if(NULL == file->cls->read_vector) {
+        for(u = 0; u < count; u++)
+            if(H5FD_read(file, dxpl, types[u], addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_VFL, H5E_READERROR, FAIL, "driver read request failed")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
+    /* The no-op case */
+    if(0 == count)
+        HGOTO_DONE(SUCCEED)
+
+    /* Check the blocks against the end of the allocated space (see the
+     * comment in H5FD_read() about SWMR readers)
+     */
+    for(u = 0; u < count; u++) {
+        haddr_t eoa;
+
+        HDassert(bufs[u]);
+        if(HADDR_UNDEF == (eoa = (file->cls->get_eoa)(file, types[u])))
+            HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "driver get_eoa request failed")
+        if(!(file->access_flags & H5F_ACC_SWMR_READ) && ((addrs[u] + file->base_addr + sizes[u]) > eoa))
+            HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size = %llu, eoa = %llu", (unsigned long long)(addrs[u] + file->base_addr), (unsigned long long)sizes[u], (unsigned long long)eoa)
+    } /* end for */
+
+    /* Convert to absolute addresses */
+    if(file->base_addr > 0) {
+        if(NULL == (abs_addrs = (haddr_t *)H5MM_malloc(count * sizeof(haddr_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for addresses")
+        for(u = 0; u < count; u++)
+            abs_addrs[u] = addrs[u] + file->base_addr;
+        addrs = abs_addrs;
+    } /* end if */
+
+    /* Dispatch to driver */
+    if((file->cls->read_vector)(file, H5P_PLIST_ID(dxpl), count, types, addrs, sizes, bufs) < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_READERROR, FAIL, "driver read vector request failed")
+
+done:
+    if(abs_addrs)
+        H5MM_xfree(abs_addrs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_read_vector() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_write_vector
+ *
+ * Purpose:	Private version of H5FDwrite_vector()
+ *
+ *              Writes COUNT blocks, block U being SIZES[U] bytes of type
+ *              TYPES[U] from BUFS[U] to the relative address ADDRS[U].
+ *              The blocks must not overlap.  As for H5FD_read_vector(),
+ *              drivers without a 'write_vector' callback get one 'write'
+ *              call per block.
+ *
+ * Return:	Success:	Non-negative
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5FD_write_vector(H5FD_t *file,
+#ifndef H5_DEBUG_BUILD
+const
+#endif /* H5_DEBUG_BUILD */
+H5P_genplist_t *dxpl, size_t count, const H5FD_mem_t types[],
+    const haddr_t addrs[], const size_t sizes[], const void *bufs[])
+{
+    haddr_t     *abs_addrs = NULL;      /* Absolute addresses of the blocks */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(file && file->cls);
+    HDassert(TRUE == H5P_class_isa(H5P_CLASS(dxpl), H5P_CLS_DATASET_XFER_g));
+    HDassert(0 == count || (types && addrs && sizes && bufs));
+
+    /* Fall back to one driver call per block */
+    if(NULL == file->cls->write_vector) {
+        for(u = 0; u < count; u++)
+            if(H5FD_write(file, dxpl, types[u], addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_VFL, H5E_WRITEERROR, FAIL, "driver write request failed")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
+    /* The no-op case */
+    if(0 == count)
+        HGOTO_DONE(SUCCEED)
+
+    /* Check the blocks against the end of the allocated space */
+    for(u = 0; u < count; u++) {
+        haddr_t eoa;
+
+        HDassert(bufs[u]);
+        if(HADDR_UNDEF == (eoa = (file->cls->get_eoa)(file, types[u])))
+            HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "driver get_eoa request failed")
+        if((addrs[u] + file->base_addr + sizes[u]) > eoa)
+            HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size=%llu, eoa=%llu", (unsigned long long)(addrs[u] + file->base_addr), (unsigned long long)sizes[u], (unsigned long long)eoa)
+    } /* end for */
+
+    /* Convert to absolute addresses */
+    if(file->base_addr > 0) {
+        if(NULL == (abs_addrs = (haddr_t *)H5MM_malloc(count * sizeof(haddr_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for addresses")
+        for(u = 0; u < count; u++)
+            abs_addrs[u] = addrs[u] + file->base_addr;
+        addrs = abs_addrs;
+    } /* end if */
+
+    /* Dispatch to driver */
+    if((file->cls->write_vector)(file, H5P_PLIST_ID(dxpl), count, types, addrs, sizes, bufs) < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_WRITEERROR, FAIL, "driver write vector request failed")
+
+done:
+    if(abs_addrs)
+        H5MM_xfree(abs_addrs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_write_vector() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5FD_set_eoa
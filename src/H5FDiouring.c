@@ -0,0 +1,1520 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: The Linux io_uring file driver.  Reads and writes are queued
+ *          on an io_uring submission ring shared with the kernel, which
+ *          carries them out while the library goes on working.
+ *
+ *          Writes are copied into buffers owned by the driver, submitted,
+ *          and left in flight; at most 'queue_depth' requests are in
+ *          flight at once.  Outstanding writes are completed when
+ *          H5Dwrite() returns, when the file is flushed or truncated and
+ *          when it is closed, and errors from them are reported then.
+ *          Reads (and writes to bytes which an earlier write still in
+ *          flight covers) wait for the data they depend on, so the file
+ *          always looks as if every request had completed in order.
+ *
+ *          The rings are set up with the raw system calls, so the driver
+ *          doesn't need liburing.
+ */
+
+#include "H5FDdrvr_module.h" /* This source code file is part of the H5FD driver module */
+
+
+#include "H5private.h"      /* Generic Functions        */
+#include "H5Eprivate.h"     /* Error handling           */
+#include "H5Fprivate.h"     /* File access              */
+#include "H5FDprivate.h"    /* File drivers             */
+#include "H5FDiouring.h"    /* io_uring file driver     */
+#include "H5FLprivate.h"    /* Free Lists               */
+#include "H5Iprivate.h"     /* IDs                      */
+#include "H5MMprivate.h"    /* Memory management        */
+#include "H5Pprivate.h"     /* Property lists           */
+
+#ifdef H5_HAVE_IOURING
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+/* The driver identification number, initialized at runtime */
+static hid_t H5FD_IOURING_g = 0;
+
+/* Largest number of bytes transferred by one request (the length field of
+ * a submission queue entry is 32 bits wide)
+ */
+#define H5FD_IOURING_MAX_IO     ((size_t)1 << 30)
+
+/* Driver-specific file access properties */
+typedef struct H5FD_iouring_fapl_t {
+    unsigned    queue_depth;    /* Number of requests kept in flight    */
+} H5FD_iouring_fapl_t;
+
+/* One request in flight.  The 'addr', 'buf' and 'size' fields describe the
+ * part of the request not yet transferred, so that a short transfer can be
+ * resubmitted for the rest.
+ */
+typedef struct H5FD_iouring_req_t {
+    hbool_t         busy;       /* Whether the request is in flight     */
+    hbool_t         is_write;   /* Whether the request is a write       */
+    haddr_t         addr;       /* File address of the remaining data   */
+    unsigned char   *buf;       /* Remaining data                       */
+    size_t          size;       /* Number of bytes remaining            */
+    unsigned char   *bounce;    /* Driver-owned copy of write data      */
+    size_t          bounce_size; /* Size of the bounce buffer           */
+} H5FD_iouring_req_t;
+
+/* The submission and completion rings, mapped from the kernel */
+typedef struct H5FD_iouring_ring_t {
+    int             fd;         /* io_uring file descriptor             */
+    void            *sq_ptr;    /* Mapped submission ring               */
+    size_t          sq_len;     /* Size of the submission ring mapping  */
+    void            *cq_ptr;    /* Mapped completion ring               */
+    size_t          cq_len;     /* Size of the completion ring mapping  */
+    struct io_uring_sqe *sqes;  /* Mapped submission queue entries      */
+    size_t          sqes_len;   /* Size of the entries mapping          */
+    unsigned        *sq_head;   /* Submission ring head (kernel)        */
+    unsigned        *sq_tail;   /* Submission ring tail (driver)        */
+    unsigned        sq_mask;    /* Submission ring index mask           */
+    unsigned        *sq_array;  /* Submission ring of entry indices     */
+    unsigned        *cq_head;   /* Completion ring head (driver)        */
+    unsigned        *cq_tail;   /* Completion ring tail (kernel)        */
+    unsigned        cq_mask;    /* Completion ring index mask           */
+    struct io_uring_cqe *cqes;  /* Completion queue entries             */
+} H5FD_iouring_ring_t;
+
+/* The description of a file belonging to this driver.  The 'eof' value
+ * includes the writes still in flight, and is updated when they are
+ * submitted.  Errors from requests which completed in the background are
+ * kept in 'io_errno' until they can be reported.
+ */
+typedef struct H5FD_iouring_t {
+    H5FD_t              pub;        /* public stuff, must be first      */
+    int                 fd;         /* the filesystem file descriptor   */
+    haddr_t             eoa;        /* end of allocated region          */
+    haddr_t             eof;        /* end of file; current file size   */
+    char                filename[H5FD_MAX_FILENAME_LEN];    /* Copy of file name from open operation */
+    dev_t               device;     /* file device number               */
+    ino_t               inode;      /* file i-node number               */
+    H5FD_iouring_fapl_t fa;         /* file access properties           */
+
+    H5FD_iouring_ring_t ring;       /* The kernel rings                 */
+    H5FD_iouring_req_t  *reqs;      /* Request slots, 'queue_depth' of them */
+    unsigned            *free_reqs; /* Stack of free request slots      */
+    unsigned            nfree;      /* Number of free request slots     */
+    unsigned            nwrites;    /* Number of writes in flight       */
+    unsigned            nreads;     /* Number of reads in flight        */
+    unsigned            to_submit;  /* Entries queued but not yet submitted */
+    int                 io_errno;   /* First error from a background request */
+    haddr_t             io_err_addr; /* Address of the failed request   */
+} H5FD_iouring_t;
+
+/*
+ * These macros check for overflow of various quantities.  These macros
+ * assume that HDoff_t is signed and haddr_t and size_t are unsigned.
+ *
+ * ADDR_OVERFLOW:   Checks whether a file address of type `haddr_t'
+ *                  is too large to be represented by the second argument
+ *                  of the file seek function.
+ *
+ * SIZE_OVERFLOW:   Checks whether a buffer size of type `hsize_t' is too
+ *                  large to be represented by the `size_t' type.
+ *
+ * REGION_OVERFLOW: Checks whether an address and size pair describe data
+ *                  which can be addressed entirely by the second
+ *                  argument of the file seek function.
+ */
+#define MAXADDR (((haddr_t)1<<(8*sizeof(HDoff_t)-1))-1)
+#define ADDR_OVERFLOW(A)    (HADDR_UNDEF==(A) || ((A) & ~(haddr_t)MAXADDR))
+#define SIZE_OVERFLOW(Z)    ((Z) & ~(hsize_t)MAXADDR)
+#define REGION_OVERFLOW(A,Z)    (ADDR_OVERFLOW(A) || SIZE_OVERFLOW(Z) ||    \
+                                 HADDR_UNDEF==(A)+(Z) ||                    \
+                                (HDoff_t)((A)+(Z))<(HDoff_t)(A))
+
+/* Accesses to the ring indices shared with the kernel */
+#define H5FD_IOURING_LOAD(P)        __atomic_load_n((P), __ATOMIC_ACQUIRE)
+#define H5FD_IOURING_STORE(P, V)    __atomic_store_n((P), (V), __ATOMIC_RELEASE)
+
+/* Prototypes */
+static herr_t H5FD_iouring_term(void);
+static void *H5FD_iouring_fapl_get(H5FD_t *file);
+static void *H5FD_iouring_fapl_copy(const void *_old_fa);
+static H5FD_t *H5FD_iouring_open(const char *name, unsigned flags, hid_t fapl_id,
+            haddr_t maxaddr);
+static herr_t H5FD_iouring_close(H5FD_t *_file);
+static int H5FD_iouring_cmp(const H5FD_t *_f1, const H5FD_t *_f2);
+static herr_t H5FD_iouring_query(const H5FD_t *_f1, unsigned long *flags);
+static haddr_t H5FD_iouring_get_eoa(const H5FD_t *_file, H5FD_mem_t type);
+static herr_t H5FD_iouring_set_eoa(H5FD_t *_file, H5FD_mem_t type, haddr_t addr);
+static haddr_t H5FD_iouring_get_eof(const H5FD_t *_file, H5FD_mem_t type);
+static herr_t  H5FD_iouring_get_handle(H5FD_t *_file, hid_t fapl, void** file_handle);
+static herr_t H5FD_iouring_read(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr_t addr,
+            size_t size, void *buf);
+static herr_t H5FD_iouring_write(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr_t addr,
+            size_t size, const void *buf);
+static herr_t H5FD_iouring_flush(H5FD_t *_file, hid_t dxpl_id, hbool_t closing);
+static herr_t H5FD_iouring_truncate(H5FD_t *_file, hid_t dxpl_id, hbool_t closing);
+static herr_t H5FD_iouring_lock(H5FD_t *_file, hbool_t rw);
+static herr_t H5FD_iouring_unlock(H5FD_t *_file);
+static herr_t H5FD_iouring_read_vector(H5FD_t *_file, hid_t dxpl_id, size_t count,
+            const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+            void *bufs[]);
+static herr_t H5FD_iouring_write_vector(H5FD_t *_file, hid_t dxpl_id, size_t count,
+            const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+            const void *bufs[]);
+static herr_t H5FD_iouring_wait(H5FD_t *_file, hid_t dxpl_id);
+
+static herr_t H5FD_iouring_ring_init(H5FD_iouring_ring_t *ring, unsigned entries);
+static void H5FD_iouring_ring_term(H5FD_iouring_ring_t *ring);
+static void H5FD_iouring_queue(H5FD_iouring_t *file, unsigned idx);
+static herr_t H5FD_iouring_submit(H5FD_iouring_t *file, hbool_t wait);
+static void H5FD_iouring_complete(H5FD_iouring_t *file, unsigned idx, int res);
+static herr_t H5FD_iouring_get_req(H5FD_iouring_t *file, unsigned *idx);
+static hbool_t H5FD_iouring_overlaps(const H5FD_iouring_t *file, haddr_t addr,
+            size_t size);
+static herr_t H5FD_iouring_wait_all(H5FD_iouring_t *file);
+
+static const H5FD_class_t H5FD_iouring_g = {
+    "iouring",                  /* name                 */
+    MAXADDR,                    /* maxaddr              */
+    H5F_CLOSE_WEAK,             /* fc_degree            */
+    H5FD_iouring_term,          /* terminate            */
+    NULL,                       /* sb_size              */
+    NULL,                       /* sb_encode            */
+    NULL,                       /* sb_decode            */
+    sizeof(H5FD_iouring_fapl_t), /* fapl_size           */
+    H5FD_iouring_fapl_get,      /* fapl_get             */
+    H5FD_iouring_fapl_copy,     /* fapl_copy            */
+    NULL,                       /* fapl_free            */
+    0,                          /* dxpl_size            */
+    NULL,                       /* dxpl_copy            */
+    NULL,                       /* dxpl_free            */
+    H5FD_iouring_open,          /* open                 */
+    H5FD_iouring_close,         /* close                */
+    H5FD_iouring_cmp,           /* cmp                  */
+    H5FD_iouring_query,         /* query                */
+    NULL,                       /* get_type_map         */
+    NULL,                       /* alloc                */
+    NULL,                       /* free                 */
+    H5FD_iouring_get_eoa,       /* get_eoa              */
+    H5FD_iouring_set_eoa,       /* set_eoa              */
+    H5FD_iouring_get_eof,       /* get_eof              */
+    H5FD_iouring_get_handle,    /* get_handle           */
+    H5FD_iouring_read,          /* read                 */
+    H5FD_iouring_write,         /* write                */
+    H5FD_iouring_flush,         /* flush                */
+    H5FD_iouring_truncate,      /* truncate             */
+    H5FD_iouring_lock,          /* lock                 */
+    H5FD_iouring_unlock,        /* unlock               */
+    H5FD_FLMAP_DICHOTOMY,       /* fl_map               */
+    H5FD_iouring_read_vector,   /* read_vector          */
+    H5FD_iouring_write_vector,  /* write_vector         */
+    H5FD_iouring_wait           /* wait                 */
+};
+
+/* Declare a free list to manage the H5FD_iouring_t struct */
+H5FL_DEFINE_STATIC(H5FD_iouring_t);
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__init_package
+ *
+ * Purpose:     Initializes any interface-specific data or routines.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__init_package(void)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    if(H5FD_iouring_init() < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "unable to initialize io_uring VFD")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5FD__init_package() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_init
+ *
+ * Purpose:     Initialize this driver by registering the driver with the
+ *              library.
+ *
+ * Return:      Success:    The driver ID for the io_uring driver.
+ *              Failure:    Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+hid_t
+H5FD_iouring_init(void)
+{
+    hid_t ret_value = H5I_INVALID_HID;          /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    if(H5I_VFL != H5I_get_type(H5FD_IOURING_g))
+        H5FD_IOURING_g = H5FD_register(&H5FD_iouring_g, sizeof(H5FD_class_t), FALSE);
+
+    /* Set return value */
+    ret_value = H5FD_IOURING_g;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_init() */
+
+
+/*---------------------------------------------------------------------------
+ * Function:    H5FD_iouring_term
+ *
+ * Purpose:     Shut down the VFD
+ *
+ * Returns:     SUCCEED (Can't fail)
+ *
+ *---------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_term(void)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Reset VFL ID */
+    H5FD_IOURING_g = 0;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5FD_iouring_term() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_fapl_iouring
+ *
+ * Purpose:     Modify the file access property list to use the
+ *              H5FD_IOURING driver defined in this source file.
+ *              QUEUE_DEPTH is the number of requests the driver keeps in
+ *              flight; zero selects H5FD_IOURING_QUEUE_DEPTH_DEF.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_fapl_iouring(hid_t fapl_id, unsigned queue_depth)
+{
+    H5P_genplist_t      *plist;         /* Property list pointer */
+    H5FD_iouring_fapl_t fa;
+    herr_t ret_value;
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", fapl_id, queue_depth);
+
+    if(NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a file access property list")
+    if(queue_depth > H5FD_IOURING_QUEUE_DEPTH_MAX)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "queue depth too large")
+
+    fa.queue_depth = (queue_depth != 0) ? queue_depth : H5FD_IOURING_QUEUE_DEPTH_DEF;
+
+    ret_value = H5P_set_driver(plist, H5FD_IOURING, &fa);
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_fapl_iouring() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_fapl_iouring
+ *
+ * Purpose:     Returns information about the io_uring file access
+ *              property list though the function arguments.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_fapl_iouring(hid_t fapl_id, unsigned *queue_depth/*out*/)
+{
+    H5P_genplist_t              *plist;         /* Property list pointer */
+    const H5FD_iouring_fapl_t   *fa;
+    herr_t ret_value = SUCCEED;                 /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", fapl_id, queue_depth);
+
+    if(NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a file access list")
+    if(H5FD_IOURING != H5P_peek_driver(plist))
+        HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "incorrect VFL driver")
+    if(NULL == (fa = (const H5FD_iouring_fapl_t *)H5P_peek_driver_info(plist)))
+        HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "bad VFL driver info")
+
+    if(queue_depth)
+        *queue_depth = fa->queue_depth;
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_fapl_iouring() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_fapl_get
+ *
+ * Purpose:     Returns a file access property list which indicates how the
+ *              specified file is being accessed. The return list could be
+ *              used to access another file the same way.
+ *
+ * Return:      Success:    Ptr to new file access property list with all
+ *                          members copied from the file struct.
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5FD_iouring_fapl_get(H5FD_t *_file)
+{
+    H5FD_iouring_t  *file = (H5FD_iouring_t *)_file;
+    void *ret_value = NULL;     /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Set return value */
+    ret_value = H5FD_iouring_fapl_copy(&(file->fa));
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_fapl_get() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_fapl_copy
+ *
+ * Purpose:     Copies the io_uring-specific file access properties.
+ *
+ * Return:      Success:    Ptr to a new property list
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5FD_iouring_fapl_copy(const void *_old_fa)
+{
+    const H5FD_iouring_fapl_t *old_fa = (const H5FD_iouring_fapl_t *)_old_fa;
+    H5FD_iouring_fapl_t *new_fa = NULL;
+    void *ret_value = NULL;     /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    if(NULL == (new_fa = (H5FD_iouring_fapl_t *)H5MM_malloc(sizeof(H5FD_iouring_fapl_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed")
+
+    /* Copy the general information */
+    HDmemcpy(new_fa, old_fa, sizeof(H5FD_iouring_fapl_t));
+
+    /* Set return value */
+    ret_value = new_fa;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_fapl_copy() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_ring_init
+ *
+ * Purpose:     Sets up an io_uring instance with room for ENTRIES
+ *              requests and maps its rings into memory.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_ring_init(H5FD_iouring_ring_t *ring, unsigned entries)
+{
+    struct io_uring_params  p;              /* Ring parameters */
+    unsigned char   *sq_ptr, *cq_ptr;       /* Bytewise aliases of the mappings */
+    herr_t ret_value = SUCCEED;             /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(ring);
+    HDassert(entries > 0);
+
+    HDmemset(ring, 0, sizeof(*ring));
+    ring->fd = -1;
+
+    /* Create the instance */
+    HDmemset(&p, 0, sizeof(p));
+    if((ring->fd = (int)syscall(__NR_io_uring_setup, entries, &p)) < 0)
+        HSYS_GOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "unable to set up io_uring instance")
+
+    /* Map the rings and the submission queue entries */
+    ring->sq_len = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    if(MAP_FAILED == (ring->sq_ptr = mmap(NULL, ring->sq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, (off_t)IORING_OFF_SQ_RING))) {
+        ring->sq_ptr = NULL;
+        HSYS_GOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "unable to map io_uring submission ring")
+    } /* end if */
+    ring->cq_len = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if(MAP_FAILED == (ring->cq_ptr = mmap(NULL, ring->cq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, (off_t)IORING_OFF_CQ_RING))) {
+        ring->cq_ptr = NULL;
+        HSYS_GOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "unable to map io_uring completion ring")
+    } /* end if */
+    ring->sqes_len = p.sq_entries * sizeof(struct io_uring_sqe);
+    if(MAP_FAILED == (ring->sqes = (struct io_uring_sqe *)mmap(NULL, ring->sqes_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, (off_t)IORING_OFF_SQES))) {
+        ring->sqes = NULL;
+        HSYS_GOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "unable to map io_uring submission entries")
+    } /* end if */
+
+    /* Locate the ring fields */
+    sq_ptr = (unsigned char *)ring->sq_ptr;
+    cq_ptr = (unsigned char *)ring->cq_ptr;
+    ring->sq_head = (unsigned *)(sq_ptr + p.sq_off.head);
+    ring->sq_tail = (unsigned *)(sq_ptr + p.sq_off.tail);
+    ring->sq_mask = *(unsigned *)(sq_ptr + p.sq_off.ring_mask);
+    ring->sq_array = (unsigned *)(sq_ptr + p.sq_off.array);
+    ring->cq_head = (unsigned *)(cq_ptr + p.cq_off.head);
+    ring->cq_tail = (unsigned *)(cq_ptr + p.cq_off.tail);
+    ring->cq_mask = *(unsigned *)(cq_ptr + p.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)(cq_ptr + p.cq_off.cqes);
+
+done:
+    if(ret_value < 0)
+        H5FD_iouring_ring_term(ring);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_ring_init() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_ring_term
+ *
+ * Purpose:     Unmaps the rings and closes the io_uring instance.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5FD_iouring_ring_term(H5FD_iouring_ring_t *ring)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(ring);
+
+    if(ring->sqes)
+        munmap(ring->sqes, ring->sqes_len);
+    if(ring->cq_ptr)
+        munmap(ring->cq_ptr, ring->cq_len);
+    if(ring->sq_ptr)
+        munmap(ring->sq_ptr, ring->sq_len);
+    if(ring->fd >= 0)
+        HDclose(ring->fd);
+    HDmemset(ring, 0, sizeof(*ring));
+    ring->fd = -1;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5FD_iouring_ring_term() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_open
+ *
+ * Purpose:     Create and/or opens a file as an HDF5 file.
+ *
+ * Return:      Success:    A pointer to a new file data structure. The
+ *                          public fields will be initialized by the
+ *                          caller, which is always H5FD_open().
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5FD_t *
+H5FD_iouring_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxaddr)
+{
+    H5FD_iouring_t  *file       = NULL;     /* io_uring VFD info        */
+    const H5FD_iouring_fapl_t *fa = NULL;   /* Driver properties        */
+    H5FD_iouring_fapl_t default_fa;         /* Default driver properties */
+    H5P_genplist_t  *plist;                 /* Property list pointer    */
+    int             fd          = -1;       /* File descriptor          */
+    int             o_flags;                /* Flags for open() call    */
+    h5_stat_t       sb;
+    unsigned        u;                      /* Local index variable     */
+    H5FD_t          *ret_value = NULL;      /* Return value             */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* Sanity check on file offsets */
+    HDcompile_assert(sizeof(HDoff_t) >= sizeof(size_t));
+
+    /* Check arguments */
+    if(!name || !*name)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, NULL, "invalid file name")
+    if(0 == maxaddr || HADDR_UNDEF == maxaddr)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADRANGE, NULL, "bogus maxaddr")
+    if(ADDR_OVERFLOW(maxaddr))
+        HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, NULL, "bogus maxaddr")
+
+    /* Get the driver specific information */
+    if(NULL == (plist = (H5P_genplist_t *)H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, NULL, "not a file access property list")
+    if(NULL == (fa = (const H5FD_iouring_fapl_t *)H5P_peek_driver_info(plist))) {
+        default_fa.queue_depth = H5FD_IOURING_QUEUE_DEPTH_DEF;
+        fa = &default_fa;
+    } /* end if */
+
+    /* Build the open flags */
+    o_flags = (H5F_ACC_RDWR & flags) ? O_RDWR : O_RDONLY;
+    if(H5F_ACC_TRUNC & flags)
+        o_flags |= O_TRUNC;
+    if(H5F_ACC_CREAT & flags)
+        o_flags |= O_CREAT;
+    if(H5F_ACC_EXCL & flags)
+        o_flags |= O_EXCL;
+
+    /* Open the file */
+    if((fd = HDopen(name, o_flags, 0666)) < 0) {
+        int myerrno = errno;
+        HGOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, NULL, "unable to open file: name = '%s', errno = %d, error message = '%s', flags = %x, o_flags = %x", name, myerrno, HDstrerror(myerrno), flags, (unsigned)o_flags);
+    } /* end if */
+
+    if(HDfstat(fd, &sb) < 0)
+        HSYS_GOTO_ERROR(H5E_FILE, H5E_BADFILE, NULL, "unable to fstat file")
+
+    /* Create the new file struct */
+    if(NULL == (file = H5FL_CALLOC(H5FD_iouring_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "unable to allocate file struct")
+    file->ring.fd = -1;
+
+    file->fd = fd;
+    H5_CHECKED_ASSIGN(file->eof, haddr_t, sb.st_size, h5_stat_size_t);
+    file->device = sb.st_dev;
+    file->inode = sb.st_ino;
+    file->fa = *fa;
+
+    /* Retain a copy of the name used to open the file, for possible error reporting */
+    HDstrncpy(file->filename, name, sizeof(file->filename));
+    file->filename[sizeof(file->filename) - 1] = '\0';
+
+    /* Set up the request slots, all free */
+    if(NULL == (file->reqs = (H5FD_iouring_req_t *)H5MM_calloc(file->fa.queue_depth * sizeof(H5FD_iouring_req_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "unable to allocate request slots")
+    if(NULL == (file->free_reqs = (unsigned *)H5MM_malloc(file->fa.queue_depth * sizeof(unsigned))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "unable to allocate request slots")
+    for(u = 0; u < file->fa.queue_depth; u++)
+        file->free_reqs[u] = file->fa.queue_depth - u - 1;
+    file->nfree = file->fa.queue_depth;
+
+    /* Set up the rings */
+    if(H5FD_iouring_ring_init(&file->ring, file->fa.queue_depth) < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, NULL, "unable to set up io_uring")
+
+    /* Set return value */
+    ret_value = (H5FD_t*)file;
+
+done:
+    if(NULL == ret_value) {
+        if(fd >= 0)
+            HDclose(fd);
+        if(file) {
+            H5MM_xfree(file->reqs);
+            H5MM_xfree(file->free_reqs);
+            file = H5FL_FREE(H5FD_iouring_t, file);
+        } /* end if */
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_open() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_close
+ *
+ * Purpose:     Completes the outstanding requests and closes an HDF5
+ *              file.
+ *
+ * Return:      Success:    SUCCEED
+ *              Failure:    FAIL, file not closed.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_close(H5FD_t *_file)
+{
+    H5FD_iouring_t *file = (H5FD_iouring_t *)_file;
+    unsigned    u;                          /* Local index variable */
+    herr_t      ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* Sanity check */
+    HDassert(file);
+
+    /* Complete the outstanding requests, but release the file even when
+     * they failed
+     */
+    if(H5FD_iouring_wait_all(file) < 0)
+        HDONE_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to complete outstanding I/O")
+
+    /* Close the underlying file */
+    if(HDclose(file->fd) < 0)
+        HSYS_DONE_ERROR(H5E_IO, H5E_CANTCLOSEFILE, FAIL, "unable to close file")
+
+    /* Release the rings and request slots */
+    H5FD_iouring_ring_term(&file->ring);
+    for(u = 0; u < file->fa.queue_depth; u++)
+        H5MM_xfree(file->reqs[u].bounce);
+    H5MM_xfree(file->reqs);
+    H5MM_xfree(file->free_reqs);
+
+    /* Release the file info */
+    file = H5FL_FREE(H5FD_iouring_t, file);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_close() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_cmp
+ *
+ * Purpose:     Compares two files belonging to this driver using an
+ *              arbitrary (but consistent) ordering.
+ *
+ * Return:      Success:    A value like strcmp()
+ *              Failure:    never fails (arguments were checked by the
+ *                          caller).
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5FD_iouring_cmp(const H5FD_t *_f1, const H5FD_t *_f2)
+{
+    const H5FD_iouring_t    *f1 = (const H5FD_iouring_t *)_f1;
+    const H5FD_iouring_t    *f2 = (const H5FD_iouring_t *)_f2;
+    int ret_value = 0;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+#ifdef H5_DEV_T_IS_SCALAR
+    if(f1->device < f2->device) HGOTO_DONE(-1)
+    if(f1->device > f2->device) HGOTO_DONE(1)
+#else /* H5_DEV_T_IS_SCALAR */
+    /* If dev_t isn't a scalar value on this system, just use memcmp to
+     * determine if the values are the same or not.  The actual return value
+     * shouldn't really matter...
+     */
+    if(HDmemcmp(&(f1->device),&(f2->device),sizeof(dev_t)) < 0) HGOTO_DONE(-1)
+    if(HDmemcmp(&(f1->device),&(f2->device),sizeof(dev_t)) > 0) HGOTO_DONE(1)
+#endif /* H5_DEV_T_IS_SCALAR */
+    if(f1->inode < f2->inode) HGOTO_DONE(-1)
+    if(f1->inode > f2->inode) HGOTO_DONE(1)
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_cmp() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_query
+ *
+ * Purpose:     Set the flags that this VFL driver is capable of supporting.
+ *              (listed in H5FDpublic.h)
+ *
+ *              Writes still in flight are invisible to other processes,
+ *              so the driver doesn't support SWMR.
+ *
+ * Return:      SUCCEED (Can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_query(const H5FD_t H5_ATTR_UNUSED *_file, unsigned long *flags /* out */)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Set the VFL feature flags that this driver supports */
+    if(flags) {
+        *flags = 0;
+        *flags |= H5FD_FEAT_AGGREGATE_METADATA;     /* OK to aggregate metadata allocations                             */
+        *flags |= H5FD_FEAT_ACCUMULATE_METADATA;    /* OK to accumulate metadata for faster writes                      */
+        *flags |= H5FD_FEAT_DATA_SIEVE;             /* OK to perform data sieving for faster raw data reads & writes    */
+        *flags |= H5FD_FEAT_AGGREGATE_SMALLDATA;    /* OK to aggregate "small" raw data allocations                     */
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5FD_iouring_query() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_get_eoa
+ *
+ * Purpose:     Gets the end-of-address marker for the file. The EOA marker
+ *              is the first address past the last byte allocated in the
+ *              format address space.
+ *
+ * Return:      The end-of-address marker.
+ *
+ *-------------------------------------------------------------------------
+ */
+static haddr_t
+H5FD_iouring_get_eoa(const H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type)
+{
+    const H5FD_iouring_t    *file = (const H5FD_iouring_t *)_file;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    FUNC_LEAVE_NOAPI(file->eoa)
+} /* end H5FD_iouring_get_eoa() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_set_eoa
+ *
+ * Purpose:     Set the end-of-address marker for the file. This function is
+ *              called shortly after an existing HDF5 file is opened in order
+ *              to tell the driver where the end of the HDF5 data is located.
+ *
+ * Return:      SUCCEED (Can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_set_eoa(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, haddr_t addr)
+{
+    H5FD_iouring_t  *file = (H5FD_iouring_t *)_file;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    file->eoa = addr;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5FD_iouring_set_eoa() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_get_eof
+ *
+ * Purpose:     Returns the end-of-file marker, counting the writes still
+ *              in flight.
+ *
+ * Return:      End of file address, the first address past the end of the
+ *              "file", either the filesystem file or the HDF5 file.
+ *
+ *-------------------------------------------------------------------------
+ */
+static haddr_t
+H5FD_iouring_get_eof(const H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type)
+{
+    const H5FD_iouring_t    *file = (const H5FD_iouring_t *)_file;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    FUNC_LEAVE_NOAPI(file->eof)
+} /* end H5FD_iouring_get_eof() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_get_handle
+ *
+ * Purpose:     Returns the file handle of the io_uring file driver.
+ *
+ * Returns:     SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_get_handle(H5FD_t *_file, hid_t H5_ATTR_UNUSED fapl, void **file_handle)
+{
+    H5FD_iouring_t      *file = (H5FD_iouring_t *)_file;
+    herr_t              ret_value = SUCCEED;
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    if(!file_handle)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "file handle not valid")
+
+    *file_handle = &(file->fd);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_get_handle() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_queue
+ *
+ * Purpose:     Places request slot IDX on the submission ring.  It is
+ *              handed to the kernel by the next H5FD_iouring_submit().
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5FD_iouring_queue(H5FD_iouring_t *file, unsigned idx)
+{
+    H5FD_iouring_ring_t *ring = &file->ring;
+    H5FD_iouring_req_t  *req = &file->reqs[idx];
+    struct io_uring_sqe *sqe;           /* Entry for the request */
+    unsigned            tail;           /* Submission ring tail */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(req->busy);
+    HDassert(req->size > 0 && req->size <= H5FD_IOURING_MAX_IO);
+
+    /* There is always room, since a ring has at least 'queue_depth'
+     * entries and no more requests than that are in flight
+     */
+    tail = *ring->sq_tail;
+    HDassert(tail - H5FD_IOURING_LOAD(ring->sq_head) <= ring->sq_mask);
+
+    sqe = &ring->sqes[tail & ring->sq_mask];
+    HDmemset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = (uint8_t)(req->is_write ? IORING_OP_WRITE : IORING_OP_READ);
+    sqe->fd = file->fd;
+    sqe->off = (uint64_t)req->addr;
+    sqe->addr = (uint64_t)(uintptr_t)req->buf;
+    sqe->len = (uint32_t)req->size;
+    sqe->user_data = (uint64_t)idx;
+    ring->sq_array[tail & ring->sq_mask] = tail & ring->sq_mask;
+
+    H5FD_IOURING_STORE(ring->sq_tail, tail + 1);
+    file->to_submit++;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5FD_iouring_queue() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_complete
+ *
+ * Purpose:     Handles the completion of request slot IDX with result
+ *              RES.  Short transfers are queued again for the rest of the
+ *              data; reads reaching the end of the file fill the rest of
+ *              the buffer with zeros.  Failures are kept in the file
+ *              struct until they are reported.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5FD_iouring_complete(H5FD_iouring_t *file, unsigned idx, int res)
+{
+    H5FD_iouring_req_t  *req = &file->reqs[idx];
+    hbool_t             finished = TRUE;    /* Whether the slot is done with */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(idx < file->fa.queue_depth);
+    HDassert(req->busy);
+
+    if(res < 0) {
+        /* Try again after a transient failure */
+        if(-EINTR == res || -EAGAIN == res)
+            finished = FALSE;
+        else if(0 == file->io_errno) {
+            file->io_errno = -res;
+            file->io_err_addr = req->addr;
+        } /* end if */
+    } /* end if */
+    else if(0 == res) {
+        if(req->is_write) {
+            /* A write which makes no progress won't make any later on */
+            if(0 == file->io_errno) {
+                file->io_errno = EIO;
+                file->io_err_addr = req->addr;
+            } /* end if */
+        } /* end if */
+        else
+            /* end of file but not end of format address space */
+            HDmemset(req->buf, 0, req->size);
+    } /* end if */
+    else {
+        HDassert((size_t)res <= req->size);
+
+        req->addr += (haddr_t)res;
+        req->buf += res;
+        req->size -= (size_t)res;
+        finished = (hbool_t)(0 == req->size);
+    } /* end else */
+
+    if(finished) {
+        /* Release the slot */
+        req->busy = FALSE;
+        if(req->is_write)
+            file->nwrites--;
+        else
+            file->nreads--;
+        file->free_reqs[file->nfree++] = idx;
+    } /* end if */
+    else
+        /* Queue the rest of the request again */
+        H5FD_iouring_queue(file, idx);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5FD_iouring_complete() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_submit
+ *
+ * Purpose:     Hands the queued requests to the kernel and handles the
+ *              completions available.  When WAIT is set, blocks until at
+ *              least one request has completed first.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_submit(H5FD_iouring_t *file, hbool_t wait)
+{
+    H5FD_iouring_ring_t *ring = &file->ring;
+    unsigned    head, tail;             /* Completion ring indices */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(!wait || file->nreads + file->nwrites > 0);
+
+    if(file->to_submit > 0 || wait) {
+        long    ret;                    /* Number of entries submitted */
+
+        do {
+            ret = syscall(__NR_io_uring_enter, ring->fd, file->to_submit, wait ? 1U : 0U, wait ? IORING_ENTER_GETEVENTS : 0U, NULL, 0);
+        } while(-1 == ret && EINTR == errno);
+
+        if(ret < 0) {
+            int myerrno = errno;
+
+            HGOTO_ERROR(H5E_IO, H5E_CANTINIT, FAIL, "io_uring submission failed: filename = '%s', errno = %d, error message = '%s', requests = %u", file->filename, myerrno, HDstrerror(myerrno), file->to_submit)
+        } /* end if */
+
+        HDassert((unsigned)ret <= file->to_submit);
+        file->to_submit -= (unsigned)ret;
+    } /* end if */
+
+    /* Handle the completions */
+    head = *ring->cq_head;
+    tail = H5FD_IOURING_LOAD(ring->cq_tail);
+    while(head != tail) {
+        const struct io_uring_cqe *cqe = &ring->cqes[head & ring->cq_mask];
+
+        H5FD_iouring_complete(file, (unsigned)cqe->user_data, cqe->res);
+        head++;
+    } /* end while */
+    H5FD_IOURING_STORE(ring->cq_head, head);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_submit() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_get_req
+ *
+ * Purpose:     Finds a free request slot, waiting for a request in flight
+ *              to complete when there is none.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_get_req(H5FD_iouring_t *file, unsigned *idx)
+{
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    while(0 == file->nfree)
+        if(H5FD_iouring_submit(file, TRUE) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_CANTINIT, FAIL, "unable to complete I/O request")
+
+    *idx = file->free_reqs[--file->nfree];
+    HDassert(!file->reqs[*idx].busy);
+    file->reqs[*idx].busy = TRUE;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_get_req() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_overlaps
+ *
+ * Purpose:     Checks whether a write in flight covers any of the SIZE
+ *              bytes at address ADDR.
+ *
+ * Return:      TRUE/FALSE
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5FD_iouring_overlaps(const H5FD_iouring_t *file, haddr_t addr, size_t size)
+{
+    unsigned    u;                      /* Local index variable */
+    hbool_t     ret_value = FALSE;      /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    if(file->nwrites > 0)
+        for(u = 0; u < file->fa.queue_depth; u++) {
+            const H5FD_iouring_req_t *req = &file->reqs[u];
+
+            if(req->busy && req->is_write && H5F_addr_overlap(addr, size, req->addr, req->size))
+                HGOTO_DONE(TRUE)
+        } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_overlaps() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_wait_all
+ *
+ * Purpose:     Completes every request in flight and reports the first
+ *              failure among the requests completed in the background.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_wait_all(H5FD_iouring_t *file)
+{
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    while(file->nreads + file->nwrites > 0)
+        if(H5FD_iouring_submit(file, TRUE) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_CANTINIT, FAIL, "unable to complete I/O requests")
+
+    if(file->io_errno != 0) {
+        int myerrno = file->io_errno;
+        haddr_t myaddr = file->io_err_addr;
+
+        file->io_errno = 0;
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "asynchronous file I/O failed: filename = '%s', errno = %d, error message = '%s', offset = %llu", file->filename, myerrno, HDstrerror(myerrno), (unsigned long long)myaddr)
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_wait_all() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_read
+ *
+ * Purpose:     Reads SIZE bytes of data from FILE beginning at address ADDR
+ *              into buffer BUF according to data transfer properties in
+ *              DXPL_ID.
+ *
+ * Return:      Success:    SUCCEED. Result is stored in caller-supplied
+ *                          buffer BUF.
+ *              Failure:    FAIL, Contents of buffer BUF are undefined.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_read(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id,
+    haddr_t addr, size_t size, void *buf /*out*/)
+{
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    if(H5FD_iouring_read_vector(_file, dxpl_id, (size_t)1, &type, &addr, &size, &buf) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read block")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_read() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_write
+ *
+ * Purpose:     Queues a write of SIZE bytes of data from buffer BUF to FILE
+ *              at address ADDR.  The data are copied, so BUF may be reused
+ *              as soon as this returns.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_write(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id,
+    haddr_t addr, size_t size, const void *buf)
+{
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    if(H5FD_iouring_write_vector(_file, dxpl_id, (size_t)1, &type, &addr, &size, &buf) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write block")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_write() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_read_vector
+ *
+ * Purpose:     Reads COUNT blocks from FILE, block U being SIZES[U] bytes
+ *              at address ADDRS[U], into the buffers BUFS.  All the blocks
+ *              are submitted together (as far as the queue depth allows)
+ *              and the call returns once they have all arrived.
+ *
+ * Return:      Success:    SUCCEED. Results are stored in caller-supplied
+ *                          buffers BUFS.
+ *              Failure:    FAIL, Contents of buffers BUFS are undefined.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_read_vector(H5FD_t *_file, hid_t H5_ATTR_UNUSED dxpl_id, size_t count,
+    const H5FD_mem_t H5_ATTR_UNUSED types[], const haddr_t addrs[], const size_t sizes[],
+    void *bufs[]/*out*/)
+{
+    H5FD_iouring_t  *file       = (H5FD_iouring_t *)_file;
+    size_t          u;                                  /* Local index variable */
+    herr_t          ret_value   = SUCCEED;              /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file && file->pub.cls);
+    HDassert(0 == count || (addrs && sizes && bufs));
+
+    for(u = 0; u < count; u++) {
+        haddr_t         addr = addrs[u];
+        size_t          size = sizes[u];
+        unsigned char   *buf = (unsigned char *)bufs[u];
+
+        HDassert(buf);
+
+        /* Check for overflow conditions */
+        if(!H5F_addr_defined(addr))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu", (unsigned long long)addr)
+        if(REGION_OVERFLOW(addr, size))
+            HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu", (unsigned long long)addr)
+
+        /* Wait for the writes in flight which the block depends on */
+        while(H5FD_iouring_overlaps(file, addr, size))
+            if(H5FD_iouring_submit(file, TRUE) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to complete I/O request")
+
+        /* Queue the block, in pieces no larger than a request can carry */
+        while(size > 0) {
+            H5FD_iouring_req_t  *req;
+            unsigned            idx;
+
+            if(H5FD_iouring_get_req(file, &idx) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to get I/O request")
+            req = &file->reqs[idx];
+            req->is_write = FALSE;
+            req->addr = addr;
+            req->buf = buf;
+            req->size = MIN(size, H5FD_IOURING_MAX_IO);
+            file->nreads++;
+            H5FD_iouring_queue(file, idx);
+
+            addr += (haddr_t)req->size;
+            buf += req->size;
+            size -= req->size;
+        } /* end while */
+    } /* end for */
+
+    /* Wait for the data */
+    while(file->nreads > 0)
+        if(H5FD_iouring_submit(file, TRUE) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to complete I/O request")
+    if(file->io_errno != 0)
+        if(H5FD_iouring_wait_all(file) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file read failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_read_vector() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_write_vector
+ *
+ * Purpose:     Queues writes of COUNT blocks to FILE, block U being
+ *              SIZES[U] bytes from BUFS[U] at address ADDRS[U].  The
+ *              blocks are copied and submitted, and the call returns
+ *              without waiting for them unless the queue is full.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_write_vector(H5FD_t *_file, hid_t H5_ATTR_UNUSED dxpl_id, size_t count,
+    const H5FD_mem_t H5_ATTR_UNUSED types[], const haddr_t addrs[], const size_t sizes[],
+    const void *bufs[])
+{
+    H5FD_iouring_t  *file       = (H5FD_iouring_t *)_file;
+    size_t          u;                                  /* Local index variable */
+    herr_t          ret_value   = SUCCEED;              /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file && file->pub.cls);
+    HDassert(0 == count || (addrs && sizes && bufs));
+
+    /* Report failures of earlier writes before taking on more */
+    if(file->io_errno != 0)
+        if(H5FD_iouring_wait_all(file) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file write failed")
+
+    for(u = 0; u < count; u++) {
+        haddr_t             addr = addrs[u];
+        size_t              size = sizes[u];
+        const unsigned char *buf = (const unsigned char *)bufs[u];
+
+        HDassert(buf);
+
+        /* Check for overflow conditions */
+        if(!H5F_addr_defined(addr))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu", (unsigned long long)addr)
+        if(REGION_OVERFLOW(addr, size))
+            HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size = %llu", (unsigned long long)addr, (unsigned long long)size)
+
+        /* Let writes in flight to the same bytes land first */
+        while(H5FD_iouring_overlaps(file, addr, size))
+            if(H5FD_iouring_submit(file, TRUE) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to complete I/O request")
+
+        /* Copy and queue the block, in pieces no larger than a request can
+         * carry
+         */
+        while(size > 0) {
+            H5FD_iouring_req_t  *req;
+            unsigned            idx;
+            size_t              nbytes = MIN(size, H5FD_IOURING_MAX_IO);
+
+            if(H5FD_iouring_get_req(file, &idx) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to get I/O request")
+            req = &file->reqs[idx];
+            if(req->bounce_size < nbytes) {
+                unsigned char *bounce;
+
+                if(NULL == (bounce = (unsigned char *)H5MM_realloc(req->bounce, nbytes))) {
+                    req->busy = FALSE;
+                    file->free_reqs[file->nfree++] = idx;
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate write buffer")
+                } /* end if */
+                req->bounce = bounce;
+                req->bounce_size = nbytes;
+            } /* end if */
+            HDmemcpy(req->bounce, buf, nbytes);
+            req->is_write = TRUE;
+            req->addr = addr;
+            req->buf = req->bounce;
+            req->size = nbytes;
+            file->nwrites++;
+            H5FD_iouring_queue(file, idx);
+
+            addr += (haddr_t)nbytes;
+            buf += nbytes;
+            size -= nbytes;
+        } /* end while */
+
+        /* Update eof */
+        if(addr > file->eof)
+            file->eof = addr;
+    } /* end for */
+
+    /* Start the kernel on the writes */
+    if(H5FD_iouring_submit(file, FALSE) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to submit I/O requests")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_write_vector() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_wait
+ *
+ * Purpose:     Completes the writes in flight.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_wait(H5FD_t *_file, hid_t H5_ATTR_UNUSED dxpl_id)
+{
+    H5FD_iouring_t  *file = (H5FD_iouring_t *)_file;
+    herr_t          ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file);
+
+    if(H5FD_iouring_wait_all(file) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to complete outstanding I/O")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_wait() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_flush
+ *
+ * Purpose:     Completes the writes in flight.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_flush(H5FD_t *_file, hid_t H5_ATTR_UNUSED dxpl_id, hbool_t H5_ATTR_UNUSED closing)
+{
+    H5FD_iouring_t  *file = (H5FD_iouring_t *)_file;
+    herr_t          ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file);
+
+    if(H5FD_iouring_wait_all(file) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to complete outstanding I/O")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_flush() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_truncate
+ *
+ * Purpose:     Completes the writes in flight and makes sure that the true
+ *              file size is the same (or larger) than the end-of-address.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_truncate(H5FD_t *_file, hid_t H5_ATTR_UNUSED dxpl_id, hbool_t H5_ATTR_UNUSED closing)
+{
+    H5FD_iouring_t  *file = (H5FD_iouring_t *)_file;
+    herr_t          ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file);
+
+    if(H5FD_iouring_wait_all(file) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to complete outstanding I/O")
+
+    /* Extend the file to make sure it's large enough */
+    if(!H5F_addr_eq(file->eoa, file->eof)) {
+        if(-1 == HDftruncate(file->fd, (HDoff_t)file->eoa))
+            HSYS_GOTO_ERROR(H5E_IO, H5E_SEEKERROR, FAIL, "unable to extend file properly")
+
+        /* Update the eof value */
+        file->eof = file->eoa;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_truncate() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_lock
+ *
+ * Purpose:     To place an advisory lock on a file.
+ *		The lock type to apply depends on the parameter "rw":
+ *			TRUE--opens for write: an exclusive lock
+ *			FALSE--opens for read: a shared lock
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_lock(H5FD_t *_file, hbool_t rw)
+{
+    H5FD_iouring_t *file = (H5FD_iouring_t *)_file;   /* VFD file struct    */
+    int lock_flags;                             /* file locking flags       */
+    herr_t ret_value = SUCCEED;                 /* Return value             */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file);
+
+    /* Set exclusive or shared lock based on rw status */
+    lock_flags = rw ? LOCK_EX : LOCK_SH;
+
+    /* Place a non-blocking lock on the file */
+    if(HDflock(file->fd, lock_flags | LOCK_NB) < 0) {
+        if(ENOSYS == errno)
+            HSYS_GOTO_ERROR(H5E_FILE, H5E_BADFILE, FAIL, "file locking disabled on this file system (use HDF5_USE_FILE_LOCKING environment variable to override)")
+        else
+            HSYS_GOTO_ERROR(H5E_FILE, H5E_BADFILE, FAIL, "unable to lock file")
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_lock() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_unlock
+ *
+ * Purpose:     To remove the existing lock on the file
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_iouring_unlock(H5FD_t *_file)
+{
+    H5FD_iouring_t *file = (H5FD_iouring_t *)_file;   /* VFD file struct    */
+    herr_t ret_value = SUCCEED;                 /* Return value             */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file);
+
+    if(HDflock(file->fd, LOCK_UN) < 0) {
+        if(ENOSYS == errno)
+            HSYS_GOTO_ERROR(H5E_FILE, H5E_BADFILE, FAIL, "file locking disabled on this file system (use HDF5_USE_FILE_LOCKING environment variable to override)")
+        else
+            HSYS_GOTO_ERROR(H5E_FILE, H5E_BADFILE, FAIL, "unable to unlock file")
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_unlock() */
+
+#endif /* H5_HAVE_IOURING */
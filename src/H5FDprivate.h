@@ -171,7 +171,20 @@ const
 #endif /* H5_DEBUG_BUILD */
 H5P_genplist_t *dxpl, H5FD_mem_t type,
     haddr_t addr, size_t size, const void *buf);
+H5_DLL herr_t H5FD_read_vector(H5FD_t *file,
+#ifndef H5_DEBUG_BUILD
+const
+#endif /* H5_DEBUG_BUILD */
+H5P_genplist_t *dxpl, size_t count, const H5FD_mem_t types[],
+    const haddr_t addrs[], const size_t sizes[], void *bufs[]/*out*/);
+H5_DLL herr_t H5FD_write_vector(H5FD_t *file,
+#ifndef H5_DEBUG_BUILD
+const
+#endif /* H5_DEBUG_BUILD */
+H5P_genplist_t *dxpl, size_t count, const H5FD_mem_t types[],
+    const haddr_t addrs[], const size_t sizes[], const void *bufs[]);
 H5_DLL herr_t H5FD_flush(H5FD_t *file, hid_t dxpl_id, hbool_t closing);
+H5_DLL herr_t H5FD_wait(H5FD_t *file, hid_t dxpl_id);
 H5_DLL herr_t H5FD_truncate(H5FD_t *file, hid_t dxpl_id, hbool_t closing);
 H5_DLL herr_t H5FD_lock(H5FD_t *file, hbool_t rw);
 H5_DLL herr_t H5FD_unlock(H5FD_t *file);
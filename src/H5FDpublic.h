@@ -282,6 +282,23 @@ typedef struct H5FD_class_t {
     herr_t  (*lock)(H5FD_t *file, hbool_t rw);
     herr_t  (*unlock)(H5FD_t *file);
     H5FD_mem_t fl_map[H5FD_MEM_NTYPES];
+
+    /* Optional vectored I/O.  These come last so that drivers initializing
+     * the class positionally without them get NULL, and the library falls
+     * back to calling 'read'/'write' once per block.
+     */
+    herr_t  (*read_vector)(H5FD_t *file, hid_t dxpl, size_t count,
+                           const H5FD_mem_t types[], const haddr_t addrs[],
+                           const size_t sizes[], void *bufs[]);
+    herr_t  (*write_vector)(H5FD_t *file, hid_t dxpl, size_t count,
+                            const H5FD_mem_t types[], const haddr_t addrs[],
+                            const size_t sizes[], const void *bufs[]);
+
+    /* Optional completion of asynchronous I/O.  Drivers which return from
+     * 'write' before the data reach the file complete those requests here;
+     * the library calls it before returning from H5Dwrite().
+     */
+    herr_t  (*wait)(H5FD_t *file, hid_t dxpl);
 } H5FD_class_t;
 
 /* A free list is a singly-linked list of address/size pairs. */
@@ -359,6 +376,12 @@ H5_DLL herr_t H5FDread(H5FD_t *file, H5FD_mem_t type, hid_t dxpl_id,
                        haddr_t addr, size_t size, void *buf/*out*/);
 H5_DLL herr_t H5FDwrite(H5FD_t *file, H5FD_mem_t type, hid_t dxpl_id,
                         haddr_t addr, size_t size, const void *buf);
+H5_DLL herr_t H5FDread_vector(H5FD_t *file, hid_t dxpl_id, size_t count,
+                              const H5FD_mem_t types[], const haddr_t addrs[],
+                              const size_t sizes[], void *bufs[]/*out*/);
+H5_DLL herr_t H5FDwrite_vector(H5FD_t *file, hid_t dxpl_id, size_t count,
+                               const H5FD_mem_t types[], const haddr_t addrs[],
+                               const size_t sizes[], const void *bufs[]);
 H5_DLL herr_t H5FDflush(H5FD_t *file, hid_t dxpl_id, hbool_t closing);
 H5_DLL herr_t H5FDtruncate(H5FD_t *file, hid_t dxpl_id, hbool_t closing);
 H5_DLL herr_t H5FDlock(H5FD_t *file, hbool_t rw);
@@ -18,11 +18,13 @@
  *              Thursday, July 29, 1999
  *
  * Purpose: The POSIX unbuffered file driver using only the HDF5 public
- *          API and with a few optimizations: the lseek() call is made
- *          only when the current file position is unknown or needs to be
- *          changed based on previous I/O through this driver (don't mix
- *          I/O from this driver with I/O from other parts of the
- *          application to the same file).
+ *          API and with a few optimizations: where the system has them,
+ *          I/O is done with pread()/pwrite(), and runs of blocks adjacent
+ *          in the file are transferred with one preadv()/pwritev() call.
+ *          Otherwise the lseek() call is made only when the current file
+ *          position is unknown or needs to be changed based on previous
+ *          I/O through this driver (don't mix I/O from this driver with
+ *          I/O from other parts of the application to the same file).
  */
 
 #include "H5FDdrvr_module.h" /* This source code file is part of the H5FD driver module */
@@ -38,27 +40,49 @@
 #include "H5MMprivate.h"    /* Memory management        */
 #include "H5Pprivate.h"     /* Property lists           */
 
+/* Use positional I/O, which leaves the file position alone, when the
+ * system has it.  Vectored I/O is only used along with it.
+ */
+#if defined(H5_HAVE_PREAD) && defined(H5_HAVE_PWRITE)
+#define H5FD_SEC2_USE_PREADWRITE
+#if defined(H5_HAVE_PREADV) && defined(H5_HAVE_PWRITEV)
+#define H5FD_SEC2_USE_PREADV
+#endif
+#endif
+
+/* Maximum number of blocks transferred by one preadv()/pwritev() call */
+#ifdef H5FD_SEC2_USE_PREADV
+#if defined(IOV_MAX) && IOV_MAX < 64
+#define H5FD_SEC2_MAX_IOV   IOV_MAX
+#else
+#define H5FD_SEC2_MAX_IOV   64
+#endif
+#endif /* H5FD_SEC2_USE_PREADV */
+
 /* The driver identification number, initialized at runtime */
 static hid_t H5FD_SEC2_g = 0;
 
 /* The description of a file belonging to this driver. The 'eoa' and 'eof'
  * determine the amount of hdf5 address space in use and the high-water mark
- * of the file (the current size of the underlying filesystem file). The
- * 'pos' value is used to eliminate file position updates when they would be a
- * no-op. Unfortunately we've found systems that use separate file position
- * indicators for reading and writing so the lseek can only be eliminated if
- * the current operation is the same as the previous operation.  When opening
- * a file the 'eof' will be set to the current file size, `eoa' will be set
- * to zero, 'pos' will be set to H5F_ADDR_UNDEF (as it is when an error
- * occurs), and 'op' will be set to H5F_OP_UNKNOWN.
+ * of the file (the current size of the underlying filesystem file). Without
+ * pread()/pwrite(), the 'pos' value is used to eliminate file position
+ * updates when they would be a no-op. Unfortunately we've found systems that
+ * use separate file position indicators for reading and writing so the lseek
+ * can only be eliminated if the current operation is the same as the
+ * previous operation.  When opening a file the 'eof' will be set to the
+ * current file size, `eoa' will be set to zero, 'pos' will be set to
+ * H5F_ADDR_UNDEF (as it is when an error occurs), and 'op' will be set to
+ * H5F_OP_UNKNOWN.
  */
 typedef struct H5FD_sec2_t {
     H5FD_t          pub;    /* public stuff, must be first      */
     int             fd;     /* the filesystem file descriptor   */
     haddr_t         eoa;    /* end of allocated region          */
     haddr_t         eof;    /* end of file; current file size   */
+#ifndef H5FD_SEC2_USE_PREADWRITE
     haddr_t         pos;    /* current file I/O position        */
     H5FD_file_op_t  op;     /* last operation                   */
+#endif /* H5FD_SEC2_USE_PREADWRITE */
     char            filename[H5FD_MAX_FILENAME_LEN];    /* Copy of file name from open operation */
 #ifndef H5_HAVE_WIN32_API
     /* On most systems the combination of device and i-node number uniquely
@@ -137,6 +161,18 @@ static herr_t H5FD_sec2_read(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, hadd
             size_t size, void *buf);
 static herr_t H5FD_sec2_write(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr_t addr,
             size_t size, const void *buf);
+static herr_t H5FD_sec2_read_vector(H5FD_t *_file, hid_t dxpl_id, size_t count,
+            const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+            void *bufs[]);
+static herr_t H5FD_sec2_write_vector(H5FD_t *_file, hid_t dxpl_id, size_t count,
+            const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+            const void *bufs[]);
+#ifdef H5FD_SEC2_USE_PREADV
+static herr_t H5FD_sec2_preadv(H5FD_sec2_t *file, haddr_t addr, struct iovec *iov,
+            int niov);
+static herr_t H5FD_sec2_pwritev(H5FD_sec2_t *file, haddr_t addr, struct iovec *iov,
+            int niov);
+#endif /* H5FD_SEC2_USE_PREADV */
 static herr_t H5FD_sec2_truncate(H5FD_t *_file, hid_t dxpl_id, hbool_t closing);
 static herr_t H5FD_sec2_lock(H5FD_t *_file, hbool_t rw);
 static herr_t H5FD_sec2_unlock(H5FD_t *_file);
@@ -173,7 +209,9 @@ static const H5FD_class_t H5FD_sec2_g = {
     H5FD_sec2_truncate,         /* truncate             */
     H5FD_sec2_lock,             /* lock                 */
     H5FD_sec2_unlock,           /* unlock               */
-    H5FD_FLMAP_DICHOTOMY        /* fl_map               */
+    H5FD_FLMAP_DICHOTOMY,       /* fl_map               */
+    H5FD_sec2_read_vector,      /* read_vector          */
+    H5FD_sec2_write_vector      /* write_vector         */
 };
 
 /* Declare a free list to manage the H5FD_sec2_t struct */
@@ -357,8 +395,10 @@ H5FD_sec2_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxaddr)
 
     file->fd = fd;
     H5_CHECKED_ASSIGN(file->eof, haddr_t, sb.st_size, h5_stat_size_t);
+#ifndef H5FD_SEC2_USE_PREADWRITE
     file->pos = HADDR_UNDEF;
     file->op = OP_UNKNOWN;
+#endif /* H5FD_SEC2_USE_PREADWRITE */
 #ifdef H5_HAVE_WIN32_API
     file->hFile = (HANDLE)_get_osfhandle(fd);
     if(INVALID_HANDLE_VALUE == file->hFile)
@@ -683,11 +723,13 @@ H5FD_sec2_read(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNUS
     if(REGION_OVERFLOW(addr, size))
         HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu", (unsigned long long)addr)
 
-    /* Seek to the correct location */
+#ifndef H5FD_SEC2_USE_PREADWRITE
+    /* Seek to the correct location (if we don't have pread) */
     if(addr != file->pos || OP_READ != file->op) {
         if(HDlseek(file->fd, (HDoff_t)addr, SEEK_SET) < 0)
             HSYS_GOTO_ERROR(H5E_IO, H5E_SEEKERROR, FAIL, "unable to seek to proper position")
     } /* end if */
+#endif /* H5FD_SEC2_USE_PREADWRITE */
 
     /* Read data, being careful of interrupted system calls, partial results,
      * and the end of the file.
@@ -706,13 +748,21 @@ H5FD_sec2_read(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNUS
             bytes_in = (h5_posix_io_t)size;
 
         do {
+#ifdef H5FD_SEC2_USE_PREADWRITE
+            bytes_read = HDpread(file->fd, buf, bytes_in, (HDoff_t)addr);
+#else
             bytes_read = HDread(file->fd, buf, bytes_in);
+#endif /* H5FD_SEC2_USE_PREADWRITE */
         } while(-1 == bytes_read && EINTR == errno);
         
         if(-1 == bytes_read) { /* error */
             int myerrno = errno;
             time_t mytime = HDtime(NULL);
+#ifdef H5FD_SEC2_USE_PREADWRITE
+            HDoff_t myoffset = (HDoff_t)addr;
+#else
             HDoff_t myoffset = HDlseek(file->fd, (HDoff_t)0, SEEK_CUR);
+#endif /* H5FD_SEC2_USE_PREADWRITE */
 
             HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file read failed: time = %s, filename = '%s', file descriptor = %d, errno = %d, error message = '%s', buf = %p, total read size = %llu, bytes this sub-read = %llu, bytes actually read = %llu, offset = %llu", HDctime(&mytime), file->filename, file->fd, myerrno, HDstrerror(myerrno), buf, (unsigned long long)size, (unsigned long long)bytes_in, (unsigned long long)bytes_read, (unsigned long long)myoffset);
         } /* end if */
@@ -731,16 +781,20 @@ H5FD_sec2_read(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNUS
         buf = (char *)buf + bytes_read;
     } /* end while */
 
+#ifndef H5FD_SEC2_USE_PREADWRITE
     /* Update current position */
     file->pos = addr;
     file->op = OP_READ;
+#endif /* H5FD_SEC2_USE_PREADWRITE */
 
 done:
+#ifndef H5FD_SEC2_USE_PREADWRITE
     if(ret_value < 0) {
         /* Reset last file I/O information */
         file->pos = HADDR_UNDEF;
         file->op = OP_UNKNOWN;
     } /* end if */
+#endif /* H5FD_SEC2_USE_PREADWRITE */
 
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_sec2_read() */
@@ -778,11 +832,13 @@ H5FD_sec2_write(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNU
     if(REGION_OVERFLOW(addr, size))
         HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size = %llu", (unsigned long long)addr, (unsigned long long)size)
 
-    /* Seek to the correct location */
+#ifndef H5FD_SEC2_USE_PREADWRITE
+    /* Seek to the correct location (if we don't have pwrite) */
     if(addr != file->pos || OP_WRITE != file->op) {
         if(HDlseek(file->fd, (HDoff_t)addr, SEEK_SET) < 0)
             HSYS_GOTO_ERROR(H5E_IO, H5E_SEEKERROR, FAIL, "unable to seek to proper position")
     } /* end if */
+#endif /* H5FD_SEC2_USE_PREADWRITE */
 
     /* Write the data, being careful of interrupted system calls and partial
      * results
@@ -801,13 +857,21 @@ H5FD_sec2_write(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNU
             bytes_in = (h5_posix_io_t)size;
 
         do {
+#ifdef H5FD_SEC2_USE_PREADWRITE
+            bytes_wrote = HDpwrite(file->fd, buf, bytes_in, (HDoff_t)addr);
+#else
             bytes_wrote = HDwrite(file->fd, buf, bytes_in);
+#endif /* H5FD_SEC2_USE_PREADWRITE */
         } while(-1 == bytes_wrote && EINTR == errno);
         
         if(-1 == bytes_wrote) { /* error */
             int myerrno = errno;
             time_t mytime = HDtime(NULL);
+#ifdef H5FD_SEC2_USE_PREADWRITE
+            HDoff_t myoffset = (HDoff_t)addr;
+#else
             HDoff_t myoffset = HDlseek(file->fd, (HDoff_t)0, SEEK_CUR);
+#endif /* H5FD_SEC2_USE_PREADWRITE */
 
             HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file write failed: time = %s, filename = '%s', file descriptor = %d, errno = %d, error message = '%s', buf = %p, total write size = %llu, bytes this sub-write = %llu, bytes actually written = %llu, offset = %llu", HDctime(&mytime), file->filename, file->fd, myerrno, HDstrerror(myerrno), buf, (unsigned long long)size, (unsigned long long)bytes_in, (unsigned long long)bytes_wrote, (unsigned long long)myoffset);
         } /* end if */
@@ -820,22 +884,300 @@ H5FD_sec2_write(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNU
         buf = (const char *)buf + bytes_wrote;
     } /* end while */
 
-    /* Update current position and eof */
+#ifndef H5FD_SEC2_USE_PREADWRITE
+    /* Update current position */
     file->pos = addr;
     file->op = OP_WRITE;
-    if(file->pos > file->eof)
-        file->eof = file->pos;
+#endif /* H5FD_SEC2_USE_PREADWRITE */
+
+    /* Update eof */
+    if(addr > file->eof)
+        file->eof = addr;
 
 done:
+#ifndef H5FD_SEC2_USE_PREADWRITE
     if(ret_value < 0) {
         /* Reset last file I/O information */
         file->pos = HADDR_UNDEF;
         file->op = OP_UNKNOWN;
     } /* end if */
+#endif /* H5FD_SEC2_USE_PREADWRITE */
 
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_sec2_write() */
 
+
+#ifdef H5FD_SEC2_USE_PREADV
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_sec2_preadv
+ *
+ * Purpose:     Reads the NIOV blocks described by IOV, which follow each
+ *              other in the file starting at address ADDR, with as few
+ *              preadv() calls as the system allows.  The entries of IOV
+ *              are consumed as the data arrive.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_sec2_preadv(H5FD_sec2_t *file, haddr_t addr, struct iovec *iov, int niov)
+{
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file);
+    HDassert(iov);
+
+    /* Read data, being careful of interrupted system calls, partial results,
+     * and the end of the file.
+     */
+    while(niov > 0) {
+        h5_posix_io_ret_t   bytes_read      = -1;   /* # of bytes actually read */
+
+        do {
+            bytes_read = HDpreadv(file->fd, iov, niov, (HDoff_t)addr);
+        } while(-1 == bytes_read && EINTR == errno);
+
+        if(-1 == bytes_read) { /* error */
+            int myerrno = errno;
+            time_t mytime = HDtime(NULL);
+
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file vector read failed: time = %s, filename = '%s', file descriptor = %d, errno = %d, error message = '%s', blocks = %d, offset = %llu", HDctime(&mytime), file->filename, file->fd, myerrno, HDstrerror(myerrno), niov, (unsigned long long)addr);
+        } /* end if */
+
+        if(0 == bytes_read) {
+            /* end of file but not end of format address space */
+            for(; niov > 0; iov++, niov--)
+                HDmemset(iov->iov_base, 0, iov->iov_len);
+            break;
+        } /* end if */
+
+        addr += (haddr_t)bytes_read;
+
+        /* Skip the blocks completed and advance into a partial one */
+        while(niov > 0 && (size_t)bytes_read >= iov->iov_len) {
+            bytes_read -= (h5_posix_io_ret_t)iov->iov_len;
+            iov++;
+            niov--;
+        } /* end while */
+        if(bytes_read > 0) {
+            iov->iov_base = (char *)iov->iov_base + bytes_read;
+            iov->iov_len -= (size_t)bytes_read;
+        } /* end if */
+    } /* end while */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_sec2_preadv() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_sec2_pwritev
+ *
+ * Purpose:     Writes the NIOV blocks described by IOV to the file, one
+ *              after the other starting at address ADDR, with as few
+ *              pwritev() calls as the system allows.  The entries of IOV
+ *              are consumed as the data are written.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_sec2_pwritev(H5FD_sec2_t *file, haddr_t addr, struct iovec *iov, int niov)
+{
+    herr_t          ret_value   = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file);
+    HDassert(iov);
+
+    /* Write the data, being careful of interrupted system calls and partial
+     * results
+     */
+    while(niov > 0) {
+        h5_posix_io_ret_t   bytes_wrote     = -1;   /* # of bytes written   */
+
+        do {
+            bytes_wrote = HDpwritev(file->fd, iov, niov, (HDoff_t)addr);
+        } while(-1 == bytes_wrote && EINTR == errno);
+
+        if(-1 == bytes_wrote) { /* error */
+            int myerrno = errno;
+            time_t mytime = HDtime(NULL);
+
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file vector write failed: time = %s, filename = '%s', file descriptor = %d, errno = %d, error message = '%s', blocks = %d, offset = %llu", HDctime(&mytime), file->filename, file->fd, myerrno, HDstrerror(myerrno), niov, (unsigned long long)addr);
+        } /* end if */
+
+        addr += (haddr_t)bytes_wrote;
+
+        /* Skip the blocks completed and advance into a partial one */
+        while(niov > 0 && (size_t)bytes_wrote >= iov->iov_len) {
+            bytes_wrote -= (h5_posix_io_ret_t)iov->iov_len;
+            iov++;
+            niov--;
+        } /* end while */
+        if(bytes_wrote > 0) {
+            iov->iov_base = (char *)iov->iov_base + bytes_wrote;
+            iov->iov_len -= (size_t)bytes_wrote;
+        } /* end if */
+    } /* end while */
+
+    /* Update eof */
+    if(addr > file->eof)
+        file->eof = addr;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_sec2_pwritev() */
+#endif /* H5FD_SEC2_USE_PREADV */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_sec2_read_vector
+ *
+ * Purpose:     Reads COUNT blocks from FILE, block U being SIZES[U] bytes
+ *              at address ADDRS[U], into the buffers BUFS.  Runs of blocks
+ *              which follow each other in the file are read with one
+ *              preadv() call when the system has it; other blocks are read
+ *              as by H5FD_sec2_read().
+ *
+ * Return:      Success:    SUCCEED. Results are stored in caller-supplied
+ *                          buffers BUFS.
+ *              Failure:    FAIL, Contents of buffers BUFS are undefined.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_sec2_read_vector(H5FD_t *_file, hid_t dxpl_id, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    void *bufs[]/*out*/)
+{
+    H5FD_sec2_t     *file       = (H5FD_sec2_t *)_file;
+#ifdef H5FD_SEC2_USE_PREADV
+    struct iovec    iov[H5FD_SEC2_MAX_IOV];             /* Blocks of one run */
+#endif /* H5FD_SEC2_USE_PREADV */
+    size_t          u = 0;                              /* Local index variable */
+    herr_t          ret_value   = SUCCEED;              /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file && file->pub.cls);
+    HDassert(0 == count || (types && addrs && sizes && bufs));
+
+    while(u < count) {
+#ifdef H5FD_SEC2_USE_PREADV
+        haddr_t     addr = addrs[u];    /* Address of the run */
+        size_t      nbytes = 0;         /* Size of the run */
+        int         niov = 0;           /* Number of blocks in the run */
+
+        /* Gather the blocks which follow each other in the file */
+        while(u + (size_t)niov < count && niov < H5FD_SEC2_MAX_IOV
+                && addrs[u + (size_t)niov] == addr + nbytes
+                && sizes[u + (size_t)niov] <= H5_POSIX_MAX_IO_BYTES - nbytes) {
+            iov[niov].iov_base = bufs[u + (size_t)niov];
+            iov[niov].iov_len = sizes[u + (size_t)niov];
+            nbytes += sizes[u + (size_t)niov];
+            niov++;
+        } /* end while */
+
+        if(niov > 1) {
+            /* Check for overflow conditions */
+            if(!H5F_addr_defined(addr))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu", (unsigned long long)addr)
+            if(REGION_OVERFLOW(addr, nbytes))
+                HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu", (unsigned long long)addr)
+
+            if(H5FD_sec2_preadv(file, addr, iov, niov) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read blocks")
+            u += (size_t)niov;
+            continue;
+        } /* end if */
+#endif /* H5FD_SEC2_USE_PREADV */
+
+        if(H5FD_sec2_read(_file, types[u], dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read block")
+        u++;
+    } /* end while */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_sec2_read_vector() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_sec2_write_vector
+ *
+ * Purpose:     Writes COUNT blocks to FILE, block U being SIZES[U] bytes
+ *              from BUFS[U] at address ADDRS[U].  Runs of blocks which
+ *              follow each other in the file are written with one
+ *              pwritev() call when the system has it; other blocks are
+ *              written as by H5FD_sec2_write().
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_sec2_write_vector(H5FD_t *_file, hid_t dxpl_id, size_t count,
+    const H5FD_mem_t types[], const haddr_t addrs[], const size_t sizes[],
+    const void *bufs[])
+{
+    H5FD_sec2_t     *file       = (H5FD_sec2_t *)_file;
+#ifdef H5FD_SEC2_USE_PREADV
+    struct iovec    iov[H5FD_SEC2_MAX_IOV];             /* Blocks of one run */
+#endif /* H5FD_SEC2_USE_PREADV */
+    size_t          u = 0;                              /* Local index variable */
+    herr_t          ret_value   = SUCCEED;              /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file && file->pub.cls);
+    HDassert(0 == count || (types && addrs && sizes && bufs));
+
+    while(u < count) {
+#ifdef H5FD_SEC2_USE_PREADV
+        haddr_t     addr = addrs[u];    /* Address of the run */
+        size_t      nbytes = 0;         /* Size of the run */
+        int         niov = 0;           /* Number of blocks in the run */
+
+        /* Gather the blocks which follow each other in the file */
+        while(u + (size_t)niov < count && niov < H5FD_SEC2_MAX_IOV
+                && addrs[u + (size_t)niov] == addr + nbytes
+                && sizes[u + (size_t)niov] <= H5_POSIX_MAX_IO_BYTES - nbytes) {
+            iov[niov].iov_base = (void *)bufs[u + (size_t)niov];   /* Casting away const OK, pwritev() doesn't modify the buffers */
+            iov[niov].iov_len = sizes[u + (size_t)niov];
+            nbytes += sizes[u + (size_t)niov];
+            niov++;
+        } /* end while */
+
+        if(niov > 1) {
+            /* Check for overflow conditions */
+            if(!H5F_addr_defined(addr))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu", (unsigned long long)addr)
+            if(REGION_OVERFLOW(addr, nbytes))
+                HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size = %llu", (unsigned long long)addr, (unsigned long long)nbytes)
+
+            if(H5FD_sec2_pwritev(file, addr, iov, niov) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write blocks")
+            u += (size_t)niov;
+            continue;
+        } /* end if */
+#endif /* H5FD_SEC2_USE_PREADV */
+
+        if(H5FD_sec2_write(_file, types[u], dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write block")
+        u++;
+    } /* end while */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_sec2_write_vector() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5FD_sec2_truncate
@@ -896,9 +1238,11 @@ H5FD_sec2_truncate(H5FD_t *_file, hid_t H5_ATTR_UNUSED dxpl_id, hbool_t H5_ATTR_
         /* Update the eof value */
         file->eof = file->eoa;
 
+#ifndef H5FD_SEC2_USE_PREADWRITE
         /* Reset last file I/O information */
         file->pos = HADDR_UNDEF;
         file->op = OP_UNKNOWN;
+#endif /* H5FD_SEC2_USE_PREADWRITE */
     } /* end if */
 
 done:
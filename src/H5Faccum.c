@@ -52,6 +52,38 @@
 #define H5F_ACCUM_THRESHOLD     2048
 #define H5F_ACCUM_MAX_SIZE      (1024 *1024) /* Max. accum. buf size (max. I/Os will be 1/2 this size) */
 
+/* Macros for the LRU list of metadata readahead pages */
+#define H5F_ACCUM_PAGE_UNLINK(pages, page)                                  \
+{                                                                           \
+    if((page)->prev)                                                        \
+        (page)->prev->next = (page)->next;                                  \
+    else                                                                    \
+        (pages)->head = (page)->next;                                       \
+    if((page)->next)                                                        \
+        (page)->next->prev = (page)->prev;                                  \
+    else                                                                    \
+        (pages)->tail = (page)->prev;                                       \
+    (page)->prev = (page)->next = NULL;                                     \
+}
+#define H5F_ACCUM_PAGE_LINK_HEAD(pages, page)                               \
+{                                                                           \
+    (page)->next = (pages)->head;                                           \
+    if((pages)->head)                                                       \
+        (pages)->head->prev = (page);                                       \
+    else                                                                    \
+        (pages)->tail = (page);                                             \
+    (pages)->head = (page);                                                 \
+}
+#define H5F_ACCUM_PAGE_LINK_TAIL(pages, page)                               \
+{                                                                           \
+    (page)->prev = (pages)->tail;                                           \
+    if((pages)->tail)                                                       \
+        (pages)->tail->next = (page);                                       \
+    else                                                                    \
+        (pages)->head = (page);                                             \
+    (pages)->tail = (page);                                                 \
+}
+
 
 /******************/
 /* Local Typedefs */
@@ -72,6 +104,10 @@ typedef enum {
 /********************/
 /* Local Prototypes */
 /********************/
+static void H5F__accum_page_update(H5F_meta_page_t *page, haddr_t addr,
+    size_t size, const void *buf);
+static herr_t H5F__accum_page_read(const H5F_io_info_t *fio_info,
+    H5FD_mem_t map_type, haddr_t addr, size_t size, void *buf);
 
 
 /*********************/
@@ -91,6 +127,10 @@ typedef enum {
 /* Declare a PQ free list to manage the metadata accumulator buffer */
 H5FL_BLK_DEFINE_STATIC(meta_accum);
 
+/* Declare free lists to manage the metadata readahead pages */
+H5FL_DEFINE_STATIC(H5F_meta_page_t);
+H5FL_BLK_DEFINE_STATIC(meta_page);
+
 
 
 /*-------------------------------------------------------------------------
@@ -203,7 +243,12 @@ H5F__accum_read(const H5F_io_info_t *fio_info, H5FD_mem_t map_type, haddr_t addr
                 accum->loc = new_addr;
                 accum->size = new_size;
             } /* end if */
-            /* Current read doesn't overlap with metadata accumulator, read it from file */
+            /* Current read doesn't overlap with metadata accumulator, read it
+             * through the readahead pages, if on, or from file */
+            else if(fio_info->f->shared->meta_pages.page_size > 0 && size <= fio_info->f->shared->meta_pages.page_size) {
+                if(H5F__accum_page_read(fio_info, map_type, addr, size, buf) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "can't read metadata readahead pages")
+            } /* end if */
             else {
                 /* Dispatch to driver */
                 if(H5FD_read(fio_info->f->shared->lf, fio_info->dxpl, map_type, addr, size, buf) < 0)
@@ -263,6 +308,156 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5F__accum_read() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__accum_page_update
+ *
+ * Purpose:	Copy the part of the data for ADDR & SIZE that falls in a
+ *		readahead page into the page.
+ *
+ * Return:	none
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5F__accum_page_update(H5F_meta_page_t *page, haddr_t addr, size_t size,
+    const void *buf)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(page);
+    HDassert(buf);
+
+    if(H5F_addr_overlap(addr, size, page->addr, page->len)) {
+        haddr_t start = MAX(addr, page->addr);                          /* Start of overlap */
+        haddr_t end = MIN(addr + size, page->addr + page->len);        /* End of overlap */
+
+        HDmemcpy(page->buf + (start - page->addr), (const unsigned char *)buf + (start - addr), (size_t)(end - start));
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5F__accum_page_update() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__accum_page_read
+ *
+ * Purpose:	Read metadata through the file's readahead pages: the
+ *		page-aligned pages of the file that the read falls in are
+ *		read whole, if they aren't held already, and the least
+ *		recently used page is evicted to make room when all the
+ *		pages are in use.
+ *
+ *		Pages are kept up to date by H5F__accum_write, and with the
+ *		dirty metadata in the accumulator when they are read, so
+ *		they can hold raw data as well as metadata.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5F__accum_page_read(const H5F_io_info_t *fio_info, H5FD_mem_t map_type,
+    haddr_t addr, size_t size, void *buf/*out*/)
+{
+    H5F_meta_pages_t *pages;            /* Alias for file's readahead pages */
+    H5F_meta_accum_t *accum;            /* Alias for file's metadata accumulator */
+    haddr_t     eoa;                    /* End of allocated space in file */
+    haddr_t     page_addr;              /* Address of page */
+    hbool_t     hit = TRUE;             /* Whether the read was found in the pages */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(fio_info);
+    HDassert(buf);
+
+    /* Set up aliases */
+    pages = &fio_info->f->shared->meta_pages;
+    accum = &fio_info->f->shared->accum;
+    HDassert(pages->page_size > 0);
+    HDassert(size <= pages->page_size);
+
+    /* Leave reads past the end of the allocated space for the driver to report */
+    if(HADDR_UNDEF == (eoa = H5FD_get_eoa(fio_info->f->shared->lf, map_type)))
+        HGOTO_ERROR(H5E_IO, H5E_CANTGET, FAIL, "driver get_eoa request failed")
+    if(H5F_addr_gt(addr + size, eoa)) {
+        if(H5FD_read(fio_info->f->shared->lf, fio_info->dxpl, map_type, addr, size, buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "driver read request failed")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
+    pages->stats.nreads++;
+
+    /* Copy the data from each page the read falls in */
+    page_addr = addr - (addr % pages->page_size);
+    while(H5F_addr_lt(page_addr, addr + size)) {
+        H5F_meta_page_t *page;          /* Page holding data */
+        haddr_t start = MAX(addr, page_addr);                          /* Start of data in page */
+        haddr_t end = MIN(addr + size, page_addr + pages->page_size);  /* End of data in page */
+
+        /* Look for the page, most recently used first */
+        for(page = pages->head; page; page = page->next)
+            if(H5F_addr_eq(page->addr, page_addr))
+                break;
+
+        /* Read the page, if it's not held, or the file has grown since
+         * the page was read at the end of the file */
+        if(NULL == page || H5F_addr_gt(end, page->addr + page->len)) {
+            if(NULL == page) {
+                /* Allocate a new page, or evict the least recently used one */
+                if(pages->npages < pages->max_pages) {
+                    if(NULL == (page = H5FL_CALLOC(H5F_meta_page_t)))
+                        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate metadata readahead page")
+                    if(NULL == (page->buf = H5FL_BLK_MALLOC(meta_page, pages->page_size))) {
+                        page = H5FL_FREE(H5F_meta_page_t, page);
+                        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate metadata readahead page")
+                    } /* end if */
+                    pages->npages++;
+                } /* end if */
+                else {
+                    page = pages->tail;
+                    H5F_ACCUM_PAGE_UNLINK(pages, page)
+                    pages->stats.nevictions++;
+                } /* end else */
+                page->addr = page_addr;
+            } /* end if */
+            else
+                H5F_ACCUM_PAGE_UNLINK(pages, page)
+
+            /* Read the page */
+            H5_CHECKED_ASSIGN(page->len, size_t, MIN(pages->page_size, eoa - page_addr), hsize_t);
+            if(H5FD_read(fio_info->f->shared->lf, fio_info->dxpl, map_type, page_addr, page->len, page->buf) < 0) {
+                page->len = 0;
+                H5F_ACCUM_PAGE_LINK_TAIL(pages, page)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "driver read request failed")
+            } /* end if */
+            pages->stats.nfills++;
+            hit = FALSE;
+
+            /* Add the dirty metadata in the accumulator, not written to the file yet */
+            if(accum->dirty)
+                H5F__accum_page_update(page, accum->loc + accum->dirty_off, accum->dirty_len, accum->buf + accum->dirty_off);
+        } /* end if */
+        else
+            H5F_ACCUM_PAGE_UNLINK(pages, page)
+
+        /* Make the page the most recently used */
+        H5F_ACCUM_PAGE_LINK_HEAD(pages, page)
+
+        /* Copy the data out of the page */
+        HDmemcpy((unsigned char *)buf + (start - addr), page->buf + (start - page_addr), (size_t)(end - start));
+
+        page_addr += pages->page_size;
+    } /* end while */
+
+    if(hit)
+        pages->stats.nhits++;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__accum_page_read() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5F__accum_adjust
@@ -430,6 +625,14 @@ H5F__accum_write(const H5F_io_info_t *fio_info, H5FD_mem_t map_type, haddr_t add
     HDassert(fio_info->dxpl);
     HDassert(buf);
 
+    /* Keep the readahead pages up to date, for raw data too */
+    if(fio_info->f->shared->meta_pages.npages > 0) {
+        H5F_meta_page_t *page;              /* Readahead page */
+
+        for(page = fio_info->f->shared->meta_pages.head; page; page = page->next)
+            H5F__accum_page_update(page, addr, size, buf);
+    } /* end if */
+
     /* Check for accumulating metadata */
     if((fio_info->f->shared->feature_flags & H5FD_FEAT_ACCUMULATE_METADATA) && map_type != H5FD_MEM_DRAW) {
         H5F_meta_accum_t *accum;     /* Alias for file's metadata accumulator */
@@ -1060,6 +1263,16 @@ H5F__accum_reset(const H5F_io_info_t *fio_info, hbool_t flush)
         if(H5F__accum_flush(fio_info) < 0)
             HGOTO_ERROR(H5E_FILE, H5E_CANTFLUSH, FAIL, "can't flush metadata accumulator")
 
+    /* Free the metadata readahead pages */
+    while(fio_info->f->shared->meta_pages.head) {
+        H5F_meta_page_t *page = fio_info->f->shared->meta_pages.head;  /* Page to free */
+
+        H5F_ACCUM_PAGE_UNLINK(&fio_info->f->shared->meta_pages, page)
+        page->buf = H5FL_BLK_FREE(meta_page, page->buf);
+        page = H5FL_FREE(H5F_meta_page_t, page);
+    } /* end while */
+    fio_info->f->shared->meta_pages.npages = 0;
+
     /* Check if we need to reset the metadata accumulator information */
     if(fio_info->f->shared->feature_flags & H5FD_FEAT_ACCUMULATE_METADATA) {
         /* Sanity check */
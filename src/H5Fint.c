@@ -157,6 +157,8 @@ H5F_get_access_plist(H5F_t *f, hbool_t app_ref)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set data cache byte size")
     if(H5P_set(new_plist, H5F_ACS_PREEMPT_READ_CHUNKS_NAME, &(f->shared->rdcc_w0)) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set preempt read chunks")
+    if(H5P_set(new_plist, H5F_ACS_DATA_CACHE_BUDGET_NAME, &(f->shared->rdcc_budget)) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set data cache budget")
     if(H5P_set(new_plist, H5F_ACS_ALIGN_THRHD_NAME, &(f->shared->threshold)) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set alignment threshold")
     if(H5P_set(new_plist, H5F_ACS_ALIGN_NAME, &(f->shared->alignment)) < 0)
@@ -165,6 +167,10 @@ H5F_get_access_plist(H5F_t *f, hbool_t app_ref)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set garbage collect reference")
     if(H5P_set(new_plist, H5F_ACS_META_BLOCK_SIZE_NAME, &(f->shared->meta_aggr.alloc_size)) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set metadata cache size")
+    if(H5P_set(new_plist, H5F_ACS_META_READAHEAD_SIZE_NAME, &(f->shared->meta_pages.page_size)) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set metadata readahead page size")
+    if(H5P_set(new_plist, H5F_ACS_META_READAHEAD_NPAGES_NAME, &(f->shared->meta_pages.max_pages)) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set number of metadata readahead pages")
     if(H5P_set(new_plist, H5F_ACS_SIEVE_BUF_SIZE_NAME, &(f->shared->sieve_buf_size)) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't sieve buffer size")
     if(H5P_set(new_plist, H5F_ACS_SDATA_BLOCK_SIZE_NAME, &(f->shared->sdata_aggr.alloc_size)) < 0)
@@ -635,6 +641,8 @@ H5F_new(H5F_file_t *shared, unsigned flags, hid_t fcpl_id, hid_t fapl_id, H5FD_t
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get data cache byte size")
         if(H5P_get(plist, H5F_ACS_PREEMPT_READ_CHUNKS_NAME, &(f->shared->rdcc_w0)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get preempt read chunk")
+        if(H5P_get(plist, H5F_ACS_DATA_CACHE_BUDGET_NAME, &(f->shared->rdcc_budget)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get data cache budget")
         if(H5P_get(plist, H5F_ACS_ALIGN_THRHD_NAME, &(f->shared->threshold)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get alignment threshold")
         if(H5P_get(plist, H5F_ACS_ALIGN_NAME, &(f->shared->alignment)) < 0)
@@ -655,6 +663,10 @@ H5F_new(H5F_file_t *shared, unsigned flags, hid_t fcpl_id, hid_t fapl_id, H5FD_t
         if(H5P_get(plist, H5F_ACS_META_BLOCK_SIZE_NAME, &(f->shared->meta_aggr.alloc_size)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get metadata cache size")
         f->shared->meta_aggr.feature_flag = H5FD_FEAT_AGGREGATE_METADATA;
+        if(H5P_get(plist, H5F_ACS_META_READAHEAD_SIZE_NAME, &(f->shared->meta_pages.page_size)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get metadata readahead page size")
+        if(H5P_get(plist, H5F_ACS_META_READAHEAD_NPAGES_NAME, &(f->shared->meta_pages.max_pages)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get number of metadata readahead pages")
         if(H5P_get(plist, H5F_ACS_SDATA_BLOCK_SIZE_NAME, &(f->shared->sdata_aggr.alloc_size)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get 'small data' cache size")
         f->shared->sdata_aggr.feature_flag = H5FD_FEAT_AGGREGATE_SMALLDATA;
@@ -703,6 +715,11 @@ H5F_new(H5F_file_t *shared, unsigned flags, hid_t fcpl_id, hid_t fapl_id, H5FD_t
          */
         f->shared->use_tmp_space = !H5F_HAS_FEATURE(f, H5FD_FEAT_HAS_MPI);
 
+        /* Metadata readahead pages would go stale in parallel, where one
+         * process writes the metadata that all read */
+        if(H5F_HAS_FEATURE(f, H5FD_FEAT_HAS_MPI))
+            f->shared->meta_pages.page_size = 0;
+
         /* Retrieve the # of read attempts here so that sohm in superblock will get the correct # of attempts */
         if(H5P_get(plist, H5F_ACS_METADATA_READ_ATTEMPTS_NAME, &f->shared->read_attempts) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get the # of read attempts")
@@ -2315,6 +2332,65 @@ H5F_set_sohm_nindexes(H5F_t *f, unsigned nindexes)
     FUNC_LEAVE_NOAPI(SUCCEED)
 } /* H5F_set_sohm_nindexes() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5F_rdcc_budget_reserve
+ *
+ * Purpose:     Reserve up to NBYTES of the file's memory budget for
+ *              growing raw data chunk caches.
+ *
+ * Return:      Number of bytes reserved, which may be less than NBYTES
+ *
+ *-------------------------------------------------------------------------
+ */
+size_t
+H5F_rdcc_budget_reserve(H5F_t *f, size_t nbytes)
+{
+    size_t avail;                       /* Bytes left in the budget */
+
+    /* Use FUNC_ENTER_NOAPI_NOINIT_NOERR here to avoid performance issues */
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Sanity check */
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(f->shared->rdcc_budget_used <= f->shared->rdcc_budget);
+
+    avail = f->shared->rdcc_budget - f->shared->rdcc_budget_used;
+    if(nbytes > avail)
+        nbytes = avail;
+    f->shared->rdcc_budget_used += nbytes;
+
+    FUNC_LEAVE_NOAPI(nbytes)
+} /* H5F_rdcc_budget_reserve() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5F_rdcc_budget_release
+ *
+ * Purpose:     Return NBYTES reserved with H5F_rdcc_budget_reserve to
+ *              the file's memory budget for raw data chunk caches.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5F_rdcc_budget_release(H5F_t *f, size_t nbytes)
+{
+    /* Use FUNC_ENTER_NOAPI_NOINIT_NOERR here to avoid performance issues */
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Sanity check */
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(nbytes <= f->shared->rdcc_budget_used);
+
+    f->shared->rdcc_budget_used -= nbytes;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5F_rdcc_budget_release() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5F_set_store_msg_crt_idx
@@ -199,6 +199,161 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5F_block_write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_block_read_vector
+ *
+ * Purpose:	Reads a list of raw data blocks from a file/server/etc into
+ *		a list of buffers with a single call to the file driver.
+ *		The addresses are relative to the base address for the file.
+ *
+ *		Raw data reads are never satisfied from the metadata
+ *		accumulator, so the blocks are handed to the driver's
+ *		vector read callback (or its fallback) directly.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F_block_read_vector(const H5F_t *f, size_t count, const H5FD_mem_t types[],
+    const haddr_t addrs[], const size_t sizes[], hid_t dxpl_id, void *bufs[]/*out*/)
+{
+    H5P_genplist_t *dxpl;               /* DXPL for operation */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(count == 0 || (types && addrs && sizes && bufs));
+
+    /* Check for attempting I/O on 'temporary' file address */
+    for(u = 0; u < count; u++) {
+        HDassert(types[u] == H5FD_MEM_DRAW);
+        HDassert(H5F_addr_defined(addrs[u]));
+        HDassert(bufs[u]);
+
+        if(H5F_addr_le(f->shared->tmp_addr, (addrs[u] + sizes[u])))
+            HGOTO_ERROR(H5E_IO, H5E_BADRANGE, FAIL, "attempting I/O in temporary file space")
+    } /* end for */
+
+    /* Get the property list */
+    if(NULL == (dxpl = (H5P_genplist_t *)H5I_object(dxpl_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
+
+    /* Pass the blocks to the file driver */
+    if(H5FD_read_vector(f->shared->lf, dxpl, count, types, addrs, sizes, bufs) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "vector read failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_block_read_vector() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_block_write_vector
+ *
+ * Purpose:	Writes a list of raw data blocks from memory to a
+ *		file/server/etc with a single call to the file driver.
+ *		The addresses are relative to the base address for the file.
+ *
+ *		When a block overlaps the metadata accumulator (or the file
+ *		is open for SWMR writing) the blocks are written one at a
+ *		time through the accumulator instead, so that it sees the
+ *		new data.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F_block_write_vector(const H5F_t *f, size_t count, const H5FD_mem_t types[],
+    const haddr_t addrs[], const size_t sizes[], hid_t dxpl_id, const void *bufs[])
+{
+    H5F_meta_accum_t *accum;            /* Alias for file's metadata accumulator */
+    hbool_t     use_accum = FALSE;      /* Whether to go through the accumulator */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(H5F_INTENT(f) & H5F_ACC_RDWR);
+    HDassert(count == 0 || (types && addrs && sizes && bufs));
+
+    /* Set up alias for file's metadata accumulator info */
+    accum = &f->shared->accum;
+
+    /* Check the blocks */
+    for(u = 0; u < count; u++) {
+        HDassert(types[u] == H5FD_MEM_DRAW);
+        HDassert(H5F_addr_defined(addrs[u]));
+        HDassert(bufs[u]);
+
+        /* Check for attempting I/O on 'temporary' file address */
+        if(H5F_addr_le(f->shared->tmp_addr, (addrs[u] + sizes[u])))
+            HGOTO_ERROR(H5E_IO, H5E_BADRANGE, FAIL, "attempting I/O in temporary file space")
+
+        /* Check for overlap w/accumulator */
+        if(accum->size > 0 && H5F_addr_overlap(addrs[u], sizes[u], accum->loc, accum->size))
+            use_accum = TRUE;
+    } /* end for */
+    if((H5F_INTENT(f) & H5F_ACC_SWMR_WRITE) > 0)
+        use_accum = TRUE;
+
+    if(use_accum) {
+        /* Write the blocks individually, through the metadata accumulator */
+        for(u = 0; u < count; u++)
+            if(H5F_block_write(f, types[u], addrs[u], sizes[u], dxpl_id, bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "block write failed")
+    } /* end if */
+    else {
+        H5P_genplist_t *dxpl;           /* DXPL for operation */
+
+        /* Get the property list */
+        if(NULL == (dxpl = (H5P_genplist_t *)H5I_object(dxpl_id)))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
+
+        /* Pass the blocks to the file driver */
+        if(H5FD_write_vector(f->shared->lf, dxpl, count, types, addrs, sizes, bufs) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "vector write failed")
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_block_write_vector() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_block_wait
+ *
+ * Purpose:	Waits for the file driver to complete any writes it has
+ *		accepted but not yet finished, reporting errors from them.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F_block_wait(const H5F_t *f, hid_t dxpl_id)
+{
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(f);
+    HDassert(f->shared);
+
+    if(H5FD_wait(f->shared->lf, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to complete outstanding I/O")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_block_wait() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5F_flush_tagged_metadata
@@ -200,6 +200,25 @@ typedef struct H5F_meta_accum_t {
     hbool_t             dirty;          /* Flag to indicate that the accumulated metadata is dirty */
 } H5F_meta_accum_t;
 
+/* Page of the file read ahead for metadata reads (see H5Pset_meta_readahead) */
+typedef struct H5F_meta_page_t {
+    haddr_t             addr;           /* File address of the page */
+    size_t              len;            /* Amount of the page read (less than the page size at the end of the file) */
+    unsigned char      *buf;            /* Buffer holding the page */
+    struct H5F_meta_page_t *prev;       /* Previous (more recently used) page in LRU list */
+    struct H5F_meta_page_t *next;       /* Next (less recently used) page in LRU list */
+} H5F_meta_page_t;
+
+/* Structure for metadata readahead pages */
+typedef struct H5F_meta_pages_t {
+    size_t              page_size;      /* Size of each page (0 turns readahead off) */
+    size_t              max_pages;      /* Max. number of pages held */
+    size_t              npages;         /* Number of pages held */
+    H5F_meta_page_t    *head;           /* Most recently used page */
+    H5F_meta_page_t    *tail;           /* Least recently used page */
+    H5F_meta_readahead_stats_t stats;   /* Readahead statistics */
+} H5F_meta_pages_t;
+
 /* Enum for free space manager state */
 typedef enum H5F_fs_state_t {
     H5F_FS_STATE_CLOSED,                /* Free space manager is closed */
@@ -303,6 +322,8 @@ struct H5F_file_t {
     size_t	rdcc_nslots;	/* Size of raw data chunk cache (slots)	*/
     size_t	rdcc_nbytes;	/* Size of raw data chunk cache	(bytes)	*/
     double	rdcc_w0;	/* Preempt read chunks first? [0.0..1.0]*/
+    size_t	rdcc_budget;	/* Memory budget for growing raw data chunk caches (bytes) */
+    size_t	rdcc_budget_used; /* Part of budget used by open datasets (bytes) */
     size_t      sieve_buf_size; /* Size of the data sieve buffer allocated (in bytes) */
     hsize_t	threshold;	/* Threshold for alignment		*/
     hsize_t	alignment;	/* Alignment				*/
@@ -332,6 +353,7 @@ struct H5F_file_t {
 
     /* Metadata accumulator information */
     H5F_meta_accum_t accum;     /* Metadata accumulator info           	*/
+    H5F_meta_pages_t meta_pages; /* Metadata readahead pages info        */
 
     /* Metadata retry info */
     unsigned 		read_attempts;	/* The # of reads to try when reading metadata with checksum */
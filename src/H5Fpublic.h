@@ -200,6 +200,16 @@ typedef struct H5F_retry_info_t {
     uint32_t *retries[H5F_NUM_METADATA_READ_RETRY_TYPES];
 } H5F_retry_info_t;
 
+/* Statistics for metadata readahead (see H5Pset_meta_readahead) */
+/* Used by public routine H5Fget_meta_readahead_stats() */
+/* (The driver reads saved by readahead are nreads - nfills) */
+typedef struct H5F_meta_readahead_stats_t {
+    hsize_t nreads;             /* # of metadata reads looked up in the pages */
+    hsize_t nhits;              /* # of those reads found in the pages */
+    hsize_t nfills;             /* # of driver reads to fill pages */
+    hsize_t nevictions;         /* # of pages evicted for other pages */
+} H5F_meta_readahead_stats_t;
+
 /* Callback for H5Pset_object_flush_cb() in a file access property list */
 typedef herr_t (*H5F_flush_cb_t)(hid_t object_id, void *udata);
 
@@ -242,6 +252,7 @@ H5_DLL herr_t H5Freset_mdc_hit_rate_stats(hid_t file_id);
 H5_DLL ssize_t H5Fget_name(hid_t obj_id, char *name, size_t size);
 H5_DLL herr_t H5Fget_info2(hid_t obj_id, H5F_info2_t *finfo);
 H5_DLL herr_t H5Fget_metadata_read_retry_info(hid_t file_id, H5F_retry_info_t *info);
+H5_DLL herr_t H5Fget_meta_readahead_stats(hid_t file_id, H5F_meta_readahead_stats_t *stats);
 H5_DLL herr_t H5Fstart_swmr_write(hid_t file_id);
 H5_DLL ssize_t H5Fget_free_sections(hid_t file_id, H5F_mem_t type,
     size_t nsects, H5F_sect_info_t *sect_info/*out*/);
@@ -939,6 +939,31 @@ H5F_has_feature(const H5F_t *f, unsigned feature)
     FUNC_LEAVE_NOAPI((hbool_t)(f->shared->lf->feature_flags&feature))
 } /* end H5F_has_feature() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_has_vector_io
+ *
+ * Purpose:	Check if a file's driver provides its own vector read and
+ *		write callbacks (rather than relying on the generic
+ *		block-at-a-time fallback).
+ *
+ * Return:	TRUE/FALSE (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+hbool_t
+H5F_has_vector_io(const H5F_t *f)
+{
+    /* Use FUNC_ENTER_NOAPI_NOINIT_NOERR here to avoid performance issues */
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(f->shared->lf);
+
+    FUNC_LEAVE_NOAPI((hbool_t)(f->shared->lf->cls->read_vector != NULL && f->shared->lf->cls->write_vector != NULL))
+} /* end H5F_has_vector_io() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5F_get_driver_id
@@ -63,6 +63,21 @@
 #define H5D_ACS_PREEMPT_READ_CHUNKS_DEF         H5D_CHUNK_CACHE_W0_DEFAULT
 #define H5D_ACS_PREEMPT_READ_CHUNKS_ENC         H5P__encode_double
 #define H5D_ACS_PREEMPT_READ_CHUNKS_DEC         H5P__decode_double
+/* Definitions for associativity of raw data chunk cache */
+#define H5D_ACS_DATA_CACHE_NUM_WAYS_SIZE        sizeof(unsigned)
+#define H5D_ACS_DATA_CACHE_NUM_WAYS_DEF         8
+#define H5D_ACS_DATA_CACHE_NUM_WAYS_ENC         H5P__encode_unsigned
+#define H5D_ACS_DATA_CACHE_NUM_WAYS_DEC         H5P__decode_unsigned
+/* Definitions for automatic resizing of raw data chunk cache */
+#define H5D_ACS_DATA_CACHE_AUTO_RESIZE_SIZE     sizeof(hbool_t)
+#define H5D_ACS_DATA_CACHE_AUTO_RESIZE_DEF      FALSE
+#define H5D_ACS_DATA_CACHE_AUTO_RESIZE_ENC      H5P__encode_hbool_t
+#define H5D_ACS_DATA_CACHE_AUTO_RESIZE_DEC      H5P__decode_hbool_t
+/* Definitions for size of raw data chunk write-behind queue(bytes) */
+#define H5D_ACS_WRITE_BEHIND_NBYTES_SIZE        sizeof(size_t)
+#define H5D_ACS_WRITE_BEHIND_NBYTES_DEF         0
+#define H5D_ACS_WRITE_BEHIND_NBYTES_ENC         H5P__encode_size_t
+#define H5D_ACS_WRITE_BEHIND_NBYTES_DEC         H5P__decode_size_t
 /* Definitions for VDS view option */
 #define H5D_ACS_VDS_VIEW_SIZE                   sizeof(H5D_vds_view_t)
 #define H5D_ACS_VDS_VIEW_DEF                    H5D_VDS_LAST_AVAILABLE
@@ -182,6 +197,9 @@ H5P__dacc_reg_prop(H5P_genclass_t *pclass)
     size_t rdcc_nslots = H5D_ACS_DATA_CACHE_NUM_SLOTS_DEF;      /* Default raw data chunk cache # of slots */
     size_t rdcc_nbytes = H5D_ACS_DATA_CACHE_BYTE_SIZE_DEF;      /* Default raw data chunk cache # of bytes */
     double rdcc_w0 = H5D_ACS_PREEMPT_READ_CHUNKS_DEF;           /* Default raw data chunk cache dirty ratio */
+    unsigned rdcc_nways = H5D_ACS_DATA_CACHE_NUM_WAYS_DEF;      /* Default raw data chunk cache associativity */
+    hbool_t auto_resize = H5D_ACS_DATA_CACHE_AUTO_RESIZE_DEF;   /* Default raw data chunk cache automatic resizing */
+    size_t wb_nbytes = H5D_ACS_WRITE_BEHIND_NBYTES_DEF;         /* Default raw data chunk write-behind queue size */
     H5D_vds_view_t virtual_view = H5D_ACS_VDS_VIEW_DEF;         /* Default VDS view option */
     hsize_t printf_gap = H5D_ACS_VDS_PRINTF_GAP_DEF;            /* Default VDS printf gap */
     herr_t ret_value = SUCCEED;         /* Return value */
@@ -203,6 +221,21 @@ H5P__dacc_reg_prop(H5P_genclass_t *pclass)
              NULL, NULL, NULL, H5D_ACS_PREEMPT_READ_CHUNKS_ENC, H5D_ACS_PREEMPT_READ_CHUNKS_DEC, NULL, NULL, NULL, NULL) < 0)
          HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the associativity of the raw data chunk cache */
+    if(H5P_register_real(pclass, H5D_ACS_DATA_CACHE_NUM_WAYS_NAME, H5D_ACS_DATA_CACHE_NUM_WAYS_SIZE, &rdcc_nways,
+             NULL, NULL, NULL, H5D_ACS_DATA_CACHE_NUM_WAYS_ENC, H5D_ACS_DATA_CACHE_NUM_WAYS_DEC, NULL, NULL, NULL, NULL) < 0)
+         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the automatic resizing of the raw data chunk cache */
+    if(H5P_register_real(pclass, H5D_ACS_DATA_CACHE_AUTO_RESIZE_NAME, H5D_ACS_DATA_CACHE_AUTO_RESIZE_SIZE, &auto_resize,
+             NULL, NULL, NULL, H5D_ACS_DATA_CACHE_AUTO_RESIZE_ENC, H5D_ACS_DATA_CACHE_AUTO_RESIZE_DEC, NULL, NULL, NULL, NULL) < 0)
+         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the size of the raw data chunk write-behind queue */
+    if(H5P_register_real(pclass, H5D_ACS_WRITE_BEHIND_NBYTES_NAME, H5D_ACS_WRITE_BEHIND_NBYTES_SIZE, &wb_nbytes,
+             NULL, NULL, NULL, H5D_ACS_WRITE_BEHIND_NBYTES_ENC, H5D_ACS_WRITE_BEHIND_NBYTES_DEC, NULL, NULL, NULL, NULL) < 0)
+         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
     /* Register the VDS view option */
     if(H5P_register_real(pclass, H5D_ACS_VDS_VIEW_NAME, H5D_ACS_VDS_VIEW_SIZE, &virtual_view,
             NULL, NULL, NULL, H5D_ACS_VDS_VIEW_ENC, H5D_ACS_VDS_VIEW_DEC,
@@ -615,6 +648,229 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_chunk_cache() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_chunk_cache_ways
+ *
+ * Purpose:	Set the associativity of the raw data chunk cache: the
+ *		number of slots that a chunk may occupy.  The RDCC_NSLOTS
+ *		slots set with H5Pset_chunk_cache (or H5Pset_cache) are
+ *		divided into sets of RDCC_NWAYS slots each, and a chunk is
+ *		only preempted from the cache because of a hash collision
+ *		when every slot in its set is in use.  A value of 1 gives a
+ *		direct-mapped cache.  The default is 8.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_cache_ways(hid_t dapl_id, unsigned rdcc_nways)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", dapl_id, rdcc_nways);
+
+    /* Check arguments */
+    if(rdcc_nways == 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "raw data cache associativity must be positive")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set value */
+    if(H5P_set(plist, H5D_ACS_DATA_CACHE_NUM_WAYS_NAME, &rdcc_nways) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set data cache associativity")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_cache_ways() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_chunk_cache_ways
+ *
+ * Purpose:	Retrieves the associativity of the raw data chunk cache.
+ *		For the access property list of an open dataset, this is
+ *		the associativity in use, which is never more than the
+ *		number of slots in the cache.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_cache_ways(hid_t dapl_id, unsigned *rdcc_nways)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "i*Iu", dapl_id, rdcc_nways);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value */
+    if(rdcc_nways)
+        if(H5P_get(plist, H5D_ACS_DATA_CACHE_NUM_WAYS_NAME, rdcc_nways) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get data cache associativity")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_cache_ways() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_chunk_cache_auto_resize
+ *
+ * Purpose:	Set whether the raw data chunk cache is resized as the
+ *		dataset is accessed.  Like the automatic resizing of the
+ *		metadata cache, the cache's hit rate is checked after each
+ *		epoch of chunk accesses: when it is low the cache grows,
+ *		within the memory budget of the file (see
+ *		H5Pset_chunk_cache_budget), and when it is high the chunks
+ *		not accessed for several epochs are evicted and the cache
+ *		shrinks, never below the size set with H5Pset_chunk_cache.
+ *		The default is FALSE.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_cache_auto_resize(hid_t dapl_id, hbool_t auto_resize)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ib", dapl_id, auto_resize);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set value */
+    if(H5P_set(plist, H5D_ACS_DATA_CACHE_AUTO_RESIZE_NAME, &auto_resize) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set data cache automatic resizing")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_cache_auto_resize() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_chunk_cache_auto_resize
+ *
+ * Purpose:	Retrieves whether the raw data chunk cache is resized
+ *		automatically.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_cache_auto_resize(hid_t dapl_id, hbool_t *auto_resize)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "i*b", dapl_id, auto_resize);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value */
+    if(auto_resize)
+        if(H5P_get(plist, H5D_ACS_DATA_CACHE_AUTO_RESIZE_NAME, auto_resize) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get data cache automatic resizing")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_cache_auto_resize() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_chunk_write_behind
+ *
+ * Purpose:	Set the size of the raw data chunk write-behind queue.
+ *		When it is non-zero, dirty filtered chunks evicted from
+ *		the chunk cache are held in a queue of up to NBYTES bytes
+ *		of unfiltered data instead of being written immediately.
+ *		Queued chunks are run through the filter pipeline
+ *		together, using the filter threads set with
+ *		H5Pset_filter_threads, and written in index order when the
+ *		queue fills, when one of them is accessed again, or when
+ *		the dataset is flushed or closed.  The default is 0, which
+ *		writes each chunk as it is evicted.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_write_behind(hid_t dapl_id, size_t nbytes)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iz", dapl_id, nbytes);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set value */
+    if(H5P_set(plist, H5D_ACS_WRITE_BEHIND_NBYTES_NAME, &nbytes) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set write-behind queue size")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_write_behind() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_chunk_write_behind
+ *
+ * Purpose:	Retrieves the size of the raw data chunk write-behind
+ *		queue.  For the access property list of an open dataset,
+ *		this is the size in use, which is 0 when the dataset
+ *		cannot queue chunks.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_write_behind(hid_t dapl_id, size_t *nbytes)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "i*z", dapl_id, nbytes);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value */
+    if(nbytes)
+        if(H5P_get(plist, H5D_ACS_WRITE_BEHIND_NBYTES_NAME, nbytes) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get write-behind queue size")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_write_behind() */
+
 
 /*-------------------------------------------------------------------------
  * Function:       H5P__encode_chunk_cache_nslots
@@ -3038,6 +3038,65 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pset_shuffle() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_bitshuffle
+ *
+ * Purpose:	Adds the bitshuffle filter (H5Z_FILTER_BITSHUFFLE) to the
+ *		pipeline.  BLOCK_SIZE is the number of elements transposed
+ *		(and compressed) together; it must be a multiple of 8, or 0
+ *		for a block of about 8KB.  COMPRESSION is
+ *		H5Z_BSHUF_COMPRESS_NONE or H5Z_BSHUF_COMPRESS_LZ4.
+ *
+ *		The data written is compatible with the external bitshuffle
+ *		filter that uses the same filter ID.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_bitshuffle(hid_t plist_id, unsigned block_size, unsigned compression)
+{
+    H5O_pline_t         pline;
+    H5P_genplist_t *plist;      /* Property list pointer */
+    unsigned cd_values[H5Z_BSHUF_TOTAL_NPARMS]; /* Filter parameters */
+    herr_t ret_value=SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE3("e", "iIuIu", plist_id, block_size, compression);
+
+    /* Check arguments */
+    if(TRUE != H5P_isa_class(plist_id, H5P_DATASET_CREATE))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset creation property list")
+    if(block_size % 8 != 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "block size must be a multiple of 8")
+    if(compression != H5Z_BSHUF_COMPRESS_NONE && compression != H5Z_BSHUF_COMPRESS_LZ4)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "unsupported bitshuffle compression")
+
+    /* Get the plist structure */
+    if(NULL == (plist = (H5P_genplist_t *)H5I_object(plist_id)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* The version and element size are set when the dataset is created */
+    cd_values[H5Z_BSHUF_PARM_VERS_MAJOR] = 0;
+    cd_values[H5Z_BSHUF_PARM_VERS_MINOR] = 0;
+    cd_values[H5Z_BSHUF_PARM_ELEM_SIZE] = 0;
+    cd_values[H5Z_BSHUF_PARM_BLOCK_SIZE] = block_size;
+    cd_values[H5Z_BSHUF_PARM_COMPRESS] = compression;
+
+    /* Add the filter */
+    if(H5P_peek(plist, H5O_CRT_PIPELINE_NAME, &pline) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get pipeline")
+    if(H5Z_append(&pline, H5Z_FILTER_BITSHUFFLE, H5Z_FLAG_OPTIONAL, (size_t)H5Z_BSHUF_TOTAL_NPARMS, cd_values) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to add bitshuffle filter")
+    if(H5P_poke(plist, H5O_CRT_PIPELINE_NAME, &pline) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to set pipeline")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_bitshuffle() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5Pset_nbit
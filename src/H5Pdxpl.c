@@ -148,6 +148,11 @@
 /* Definitions for filter callback function property */
 #define H5D_XFER_FILTER_CB_SIZE     sizeof(H5Z_cb_t)
 #define H5D_XFER_FILTER_CB_DEF      {NULL,NULL}
+/* Definitions for filter pipeline threads property */
+#define H5D_XFER_FILTER_THREADS_SIZE    sizeof(unsigned)
+#define H5D_XFER_FILTER_THREADS_DEF     1
+#define H5D_XFER_FILTER_THREADS_ENC     H5P__encode_unsigned
+#define H5D_XFER_FILTER_THREADS_DEC     H5P__decode_unsigned
 /* Definitions for type conversion callback function property */
 #define H5D_XFER_CONV_CB_SIZE       sizeof(H5T_conv_cb_t)
 #define H5D_XFER_CONV_CB_DEF        {NULL,NULL}
@@ -171,6 +176,31 @@
 #define H5D_XFER_DIRECT_CHUNK_WRITE_OFFSET_DEF		NULL
 #define H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZE_SIZE	sizeof(uint32_t)
 #define H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZE_DEF	0
+#define H5D_XFER_DIRECT_CHUNK_WRITE_NCHUNKS_SIZE	sizeof(size_t)
+#define H5D_XFER_DIRECT_CHUNK_WRITE_NCHUNKS_DEF		0
+#define H5D_XFER_DIRECT_CHUNK_WRITE_FILTERS_LIST_SIZE	sizeof(uint32_t *)
+#define H5D_XFER_DIRECT_CHUNK_WRITE_FILTERS_LIST_DEF	NULL
+#define H5D_XFER_DIRECT_CHUNK_WRITE_OFFSET_LIST_SIZE	sizeof(hsize_t **)
+#define H5D_XFER_DIRECT_CHUNK_WRITE_OFFSET_LIST_DEF	NULL
+#define H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZE_LIST_SIZE	sizeof(size_t *)
+#define H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZE_LIST_DEF	NULL
+/* Definitions for properties of direct chunk read */
+#define H5D_XFER_DIRECT_CHUNK_READ_FLAG_SIZE		sizeof(hbool_t)
+#define H5D_XFER_DIRECT_CHUNK_READ_FLAG_DEF		FALSE
+#define H5D_XFER_DIRECT_CHUNK_READ_OFFSET_SIZE		sizeof(hsize_t *)
+#define H5D_XFER_DIRECT_CHUNK_READ_OFFSET_DEF		NULL
+#define H5D_XFER_DIRECT_CHUNK_READ_FILTERS_SIZE		sizeof(uint32_t)
+#define H5D_XFER_DIRECT_CHUNK_READ_FILTERS_DEF		0
+#define H5D_XFER_DIRECT_CHUNK_READ_NCHUNKS_SIZE		sizeof(size_t)
+#define H5D_XFER_DIRECT_CHUNK_READ_NCHUNKS_DEF		0
+#define H5D_XFER_DIRECT_CHUNK_READ_OFFSET_LIST_SIZE	sizeof(hsize_t **)
+#define H5D_XFER_DIRECT_CHUNK_READ_OFFSET_LIST_DEF	NULL
+#define H5D_XFER_DIRECT_CHUNK_READ_FILTERS_LIST_SIZE	sizeof(uint32_t *)
+#define H5D_XFER_DIRECT_CHUNK_READ_FILTERS_LIST_DEF	NULL
+#define H5D_XFER_DIRECT_CHUNK_READ_DATASIZE_LIST_SIZE	sizeof(size_t *)
+#define H5D_XFER_DIRECT_CHUNK_READ_DATASIZE_LIST_DEF	NULL
+#define H5D_XFER_DIRECT_CHUNK_READ_BUF_SIZE_SIZE	sizeof(size_t)
+#define H5D_XFER_DIRECT_CHUNK_READ_BUF_SIZE_DEF		0
 /* Ring type - private property */
 #define H5AC_XFER_RING_SIZE      sizeof(unsigned)
 #define H5AC_XFER_RING_DEF       H5AC_RING_USER
@@ -289,12 +319,25 @@ static const H5P_coll_md_read_flag_t H5D_def_coll_md_read_g = H5D_XFER_COLL_MD_R
 #endif /* H5_HAVE_PARALLEL */
 static const H5Z_EDC_t H5D_def_enable_edc_g = H5D_XFER_EDC_DEF;            /* Default value for EDC property */
 static const H5Z_cb_t H5D_def_filter_cb_g = H5D_XFER_FILTER_CB_DEF;        /* Default value for filter callback */
+static const unsigned H5D_def_filter_threads_g = H5D_XFER_FILTER_THREADS_DEF; /* Default value for # of filter pipeline threads */
 static const H5T_conv_cb_t H5D_def_conv_cb_g = H5D_XFER_CONV_CB_DEF;       /* Default value for datatype conversion callback */
 static const void *H5D_def_xfer_xform_g = H5D_XFER_XFORM_DEF;          /* Default value for data transform */
 static const hbool_t H5D_def_direct_chunk_flag_g = H5D_XFER_DIRECT_CHUNK_WRITE_FLAG_DEF; 	/* Default value for the flag of direct chunk write */
 static const uint32_t H5D_def_direct_chunk_filters_g = H5D_XFER_DIRECT_CHUNK_WRITE_FILTERS_DEF;	/* Default value for the filters of direct chunk write */
 static const hsize_t *H5D_def_direct_chunk_offset_g = H5D_XFER_DIRECT_CHUNK_WRITE_OFFSET_DEF; 	/* Default value for the offset of direct chunk write */
 static const uint32_t H5D_def_direct_chunk_datasize_g = H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZE_DEF; /* Default value for the datasize of direct chunk write */
+static const size_t H5D_def_direct_chunk_nchunks_g = H5D_XFER_DIRECT_CHUNK_WRITE_NCHUNKS_DEF; /* Default value for the # of chunks of batched direct chunk write */
+static const uint32_t *H5D_def_direct_chunk_filters_list_g = H5D_XFER_DIRECT_CHUNK_WRITE_FILTERS_LIST_DEF; /* Default value for the filters of batched direct chunk write */
+static const hsize_t **H5D_def_direct_chunk_offset_list_g = H5D_XFER_DIRECT_CHUNK_WRITE_OFFSET_LIST_DEF; /* Default value for the offsets of batched direct chunk write */
+static const size_t *H5D_def_direct_chunk_datasize_list_g = H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZE_LIST_DEF; /* Default value for the datasizes of batched direct chunk write */
+static const hbool_t H5D_def_direct_chunk_read_flag_g = H5D_XFER_DIRECT_CHUNK_READ_FLAG_DEF; /* Default value for the flag of direct chunk read */
+static const hsize_t *H5D_def_direct_chunk_read_offset_g = H5D_XFER_DIRECT_CHUNK_READ_OFFSET_DEF; /* Default value for the offset of direct chunk read */
+static const uint32_t H5D_def_direct_chunk_read_filters_g = H5D_XFER_DIRECT_CHUNK_READ_FILTERS_DEF; /* Default value for the filters of direct chunk read */
+static const size_t H5D_def_direct_chunk_read_nchunks_g = H5D_XFER_DIRECT_CHUNK_READ_NCHUNKS_DEF; /* Default value for the # of chunks of batched direct chunk read */
+static const hsize_t **H5D_def_direct_chunk_read_offset_list_g = H5D_XFER_DIRECT_CHUNK_READ_OFFSET_LIST_DEF; /* Default value for the offsets of batched direct chunk read */
+static const uint32_t *H5D_def_direct_chunk_read_filters_list_g = H5D_XFER_DIRECT_CHUNK_READ_FILTERS_LIST_DEF; /* Default value for the filters of batched direct chunk read */
+static const size_t *H5D_def_direct_chunk_read_datasize_list_g = H5D_XFER_DIRECT_CHUNK_READ_DATASIZE_LIST_DEF; /* Default value for the datasizes of batched direct chunk read */
+static const size_t H5D_def_direct_chunk_read_buf_size_g = H5D_XFER_DIRECT_CHUNK_READ_BUF_SIZE_DEF; /* Default value for the buffer size of batched direct chunk read */
 static const H5AC_ring_t H5D_ring_g = H5AC_XFER_RING_DEF; /* Default value for the cache entry ring type */
 #ifdef H5_DEBUG_BUILD
 static const H5FD_dxpl_type_t H5D_dxpl_type_g = H5FD_NOIO_DXPL; /* Default value for the dxpl type */
@@ -463,6 +506,12 @@ H5P__dxfr_reg_prop(H5P_genclass_t *pclass)
             NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the filter pipeline threads property */
+    if(H5P_register_real(pclass, H5D_XFER_FILTER_THREADS_NAME, H5D_XFER_FILTER_THREADS_SIZE, &H5D_def_filter_threads_g,
+            NULL, NULL, NULL, H5D_XFER_FILTER_THREADS_ENC, H5D_XFER_FILTER_THREADS_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
     /* Register the type conversion callback property */
     /* (Note: this property should not have an encode/decode callback -QAK) */
     if(H5P_register_real(pclass, H5D_XFER_CONV_CB_NAME, H5D_XFER_CONV_CB_SIZE, &H5D_def_conv_cb_g,
@@ -499,6 +548,78 @@ H5P__dxfr_reg_prop(H5P_genclass_t *pclass)
             NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the property of number of chunks for batched direct chunk write */
+    /* (Note: this property should not have an encode/decode callback) */
+    if(H5P_register_real(pclass, H5D_XFER_DIRECT_CHUNK_WRITE_NCHUNKS_NAME, H5D_XFER_DIRECT_CHUNK_WRITE_NCHUNKS_SIZE, &H5D_def_direct_chunk_nchunks_g,
+            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the property of filters for batched direct chunk write */
+    /* (Note: this property should not have an encode/decode callback) */
+    if(H5P_register_real(pclass, H5D_XFER_DIRECT_CHUNK_WRITE_FILTERS_LIST_NAME, H5D_XFER_DIRECT_CHUNK_WRITE_FILTERS_LIST_SIZE, &H5D_def_direct_chunk_filters_list_g,
+            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the property of offsets for batched direct chunk write */
+    /* (Note: this property should not have an encode/decode callback) */
+    if(H5P_register_real(pclass, H5D_XFER_DIRECT_CHUNK_WRITE_OFFSET_LIST_NAME, H5D_XFER_DIRECT_CHUNK_WRITE_OFFSET_LIST_SIZE, &H5D_def_direct_chunk_offset_list_g,
+            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the property of datasizes for batched direct chunk write */
+    /* (Note: this property should not have an encode/decode callback) */
+    if(H5P_register_real(pclass, H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZE_LIST_NAME, H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZE_LIST_SIZE, &H5D_def_direct_chunk_datasize_list_g,
+            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the property of flag for direct chunk read */
+    /* (Note: this property should not have an encode/decode callback) */
+    if(H5P_register_real(pclass, H5D_XFER_DIRECT_CHUNK_READ_FLAG_NAME, H5D_XFER_DIRECT_CHUNK_READ_FLAG_SIZE, &H5D_def_direct_chunk_read_flag_g,
+            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the property of offset for direct chunk read */
+    /* (Note: this property should not have an encode/decode callback) */
+    if(H5P_register_real(pclass, H5D_XFER_DIRECT_CHUNK_READ_OFFSET_NAME, H5D_XFER_DIRECT_CHUNK_READ_OFFSET_SIZE, &H5D_def_direct_chunk_read_offset_g,
+            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the property of filters for direct chunk read */
+    /* (Note: this property should not have an encode/decode callback) */
+    if(H5P_register_real(pclass, H5D_XFER_DIRECT_CHUNK_READ_FILTERS_NAME, H5D_XFER_DIRECT_CHUNK_READ_FILTERS_SIZE, &H5D_def_direct_chunk_read_filters_g,
+            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the property of number of chunks for batched direct chunk read */
+    /* (Note: this property should not have an encode/decode callback) */
+    if(H5P_register_real(pclass, H5D_XFER_DIRECT_CHUNK_READ_NCHUNKS_NAME, H5D_XFER_DIRECT_CHUNK_READ_NCHUNKS_SIZE, &H5D_def_direct_chunk_read_nchunks_g,
+            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the property of offsets for batched direct chunk read */
+    /* (Note: this property should not have an encode/decode callback) */
+    if(H5P_register_real(pclass, H5D_XFER_DIRECT_CHUNK_READ_OFFSET_LIST_NAME, H5D_XFER_DIRECT_CHUNK_READ_OFFSET_LIST_SIZE, &H5D_def_direct_chunk_read_offset_list_g,
+            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the property of filters for batched direct chunk read */
+    /* (Note: this property should not have an encode/decode callback) */
+    if(H5P_register_real(pclass, H5D_XFER_DIRECT_CHUNK_READ_FILTERS_LIST_NAME, H5D_XFER_DIRECT_CHUNK_READ_FILTERS_LIST_SIZE, &H5D_def_direct_chunk_read_filters_list_g,
+            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the property of datasizes for batched direct chunk read */
+    /* (Note: this property should not have an encode/decode callback) */
+    if(H5P_register_real(pclass, H5D_XFER_DIRECT_CHUNK_READ_DATASIZE_LIST_NAME, H5D_XFER_DIRECT_CHUNK_READ_DATASIZE_LIST_SIZE, &H5D_def_direct_chunk_read_datasize_list_g,
+            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the property of buffer size for batched direct chunk read */
+    /* (Note: this property should not have an encode/decode callback) */
+    if(H5P_register_real(pclass, H5D_XFER_DIRECT_CHUNK_READ_BUF_SIZE_NAME, H5D_XFER_DIRECT_CHUNK_READ_BUF_SIZE_SIZE, &H5D_def_direct_chunk_read_buf_size_g,
+            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
     /* Register the ring property (private) */
     if(H5P_register_real(pclass, H5AC_RING_NAME, H5AC_XFER_RING_SIZE, &H5D_ring_g,
             NULL, NULL, NULL, H5AC_XFER_RING_ENC, H5AC_XFER_RING_DEC, 
@@ -1438,6 +1559,83 @@ done:
     FUNC_LEAVE_API(ret_value)
 }
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_filter_threads
+ *
+ * Purpose:	Sets the number of threads used to run the filter pipeline
+ *              over the chunks accessed by a single H5Dread or H5Dwrite
+ *              call.  Chunks are still read from and written to the file
+ *              in order by the calling thread; only the compression and
+ *              decompression is spread over the worker threads.
+ *
+ *              The default is 1, which runs every filter on the calling
+ *              thread.  Worker threads are only used by thread-safe builds
+ *              of the library and only for pipelines made up entirely of
+ *              the library's predefined filters; otherwise the setting is
+ *              accepted but the pipeline runs serially.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_filter_threads(hid_t plist_id, unsigned nthreads)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", plist_id, nthreads);
+
+    /* Check arguments */
+    if(nthreads < 1)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "number of filter threads must be positive")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_XFER_FILTER_THREADS_NAME, &nthreads) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_filter_threads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_filter_threads
+ *
+ * Purpose:	Reads the value previously set with H5Pset_filter_threads().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_filter_threads(hid_t plist_id, unsigned *nthreads/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, nthreads);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Return value */
+    if(nthreads)
+        if(H5P_get(plist, H5D_XFER_FILTER_THREADS_NAME, nthreads) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_filter_threads() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Pset_type_conv_cb
@@ -78,6 +78,11 @@
 #define H5F_ACS_PREEMPT_READ_CHUNKS_DEF         0.75f
 #define H5F_ACS_PREEMPT_READ_CHUNKS_ENC         H5P__encode_double
 #define H5F_ACS_PREEMPT_READ_CHUNKS_DEC         H5P__decode_double
+/* Definition for memory budget for growing raw data chunk caches */
+#define H5F_ACS_DATA_CACHE_BUDGET_SIZE          sizeof(size_t)
+#define H5F_ACS_DATA_CACHE_BUDGET_DEF           (64*1024*1024)
+#define H5F_ACS_DATA_CACHE_BUDGET_ENC           H5P__encode_size_t
+#define H5F_ACS_DATA_CACHE_BUDGET_DEC           H5P__decode_size_t
 /* Definition for threshold for alignment */
 #define H5F_ACS_ALIGN_THRHD_SIZE                sizeof(hsize_t)
 #define H5F_ACS_ALIGN_THRHD_DEF                 1
@@ -94,6 +99,15 @@
 #define H5F_ACS_META_BLOCK_SIZE_DEF             2048
 #define H5F_ACS_META_BLOCK_SIZE_ENC             H5P__encode_hsize_t
 #define H5F_ACS_META_BLOCK_SIZE_DEC             H5P__decode_hsize_t
+/* Definitions for metadata readahead page size & number of pages */
+#define H5F_ACS_META_READAHEAD_SIZE_SIZE        sizeof(size_t)
+#define H5F_ACS_META_READAHEAD_SIZE_DEF         0
+#define H5F_ACS_META_READAHEAD_SIZE_ENC         H5P__encode_size_t
+#define H5F_ACS_META_READAHEAD_SIZE_DEC         H5P__decode_size_t
+#define H5F_ACS_META_READAHEAD_NPAGES_SIZE      sizeof(size_t)
+#define H5F_ACS_META_READAHEAD_NPAGES_DEF       16
+#define H5F_ACS_META_READAHEAD_NPAGES_ENC       H5P__encode_size_t
+#define H5F_ACS_META_READAHEAD_NPAGES_DEC       H5P__decode_size_t
 /* Definition for maximum sieve buffer size (when data sieving
    is allowed by file driver */
 #define H5F_ACS_SIEVE_BUF_SIZE_SIZE             sizeof(size_t)
@@ -330,9 +344,12 @@ static const H5AC_cache_config_t H5F_def_mdc_initCacheCfg_g = H5F_ACS_META_CACHE
 static const size_t H5F_def_rdcc_nslots_g = H5F_ACS_DATA_CACHE_NUM_SLOTS_DEF;      /* Default raw data chunk cache # of slots */
 static const size_t H5F_def_rdcc_nbytes_g = H5F_ACS_DATA_CACHE_BYTE_SIZE_DEF;      /* Default raw data chunk cache # of bytes */
 static const double H5F_def_rdcc_w0_g = H5F_ACS_PREEMPT_READ_CHUNKS_DEF;           /* Default raw data chunk cache dirty ratio */
+static const size_t H5F_def_rdcc_budget_g = H5F_ACS_DATA_CACHE_BUDGET_DEF;         /* Default memory budget for growing raw data chunk caches */
 static const hsize_t H5F_def_threshold_g = H5F_ACS_ALIGN_THRHD_DEF;                /* Default allocation alignment threshold */
 static const hsize_t H5F_def_alignment_g = H5F_ACS_ALIGN_DEF;                      /* Default allocation alignment value */
 static const hsize_t H5F_def_meta_block_size_g = H5F_ACS_META_BLOCK_SIZE_DEF;      /* Default metadata allocation block size */
+static const size_t H5F_def_meta_readahead_size_g = H5F_ACS_META_READAHEAD_SIZE_DEF;     /* Default metadata readahead page size */
+static const size_t H5F_def_meta_readahead_npages_g = H5F_ACS_META_READAHEAD_NPAGES_DEF; /* Default metadata readahead # of pages */
 static const size_t H5F_def_sieve_buf_size_g = H5F_ACS_SIEVE_BUF_SIZE_DEF;         /* Default raw data I/O sieve buffer size */
 static const hsize_t H5F_def_sdata_block_size_g = H5F_ACS_SDATA_BLOCK_SIZE_DEF;    /* Default small data allocation block size */
 static const unsigned H5F_def_gc_ref_g = H5F_ACS_GARBG_COLCT_REF_DEF;              /* Default garbage collection for references setting */
@@ -404,6 +421,12 @@ H5P__facc_reg_prop(H5P_genclass_t *pclass)
             NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the memory budget for growing raw data chunk caches */
+    if(H5P_register_real(pclass, H5F_ACS_DATA_CACHE_BUDGET_NAME, H5F_ACS_DATA_CACHE_BUDGET_SIZE, &H5F_def_rdcc_budget_g,
+            NULL, NULL, NULL, H5F_ACS_DATA_CACHE_BUDGET_ENC, H5F_ACS_DATA_CACHE_BUDGET_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
     /* Register the threshold for alignment */
     if(H5P_register_real(pclass, H5F_ACS_ALIGN_THRHD_NAME, H5F_ACS_ALIGN_THRHD_SIZE, &H5F_def_threshold_g, 
             NULL, NULL, NULL, H5F_ACS_ALIGN_THRHD_ENC, H5F_ACS_ALIGN_THRHD_DEC, 
@@ -422,6 +445,18 @@ H5P__facc_reg_prop(H5P_genclass_t *pclass)
             NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the metadata readahead page size */
+    if(H5P_register_real(pclass, H5F_ACS_META_READAHEAD_SIZE_NAME, H5F_ACS_META_READAHEAD_SIZE_SIZE, &H5F_def_meta_readahead_size_g,
+            NULL, NULL, NULL, H5F_ACS_META_READAHEAD_SIZE_ENC, H5F_ACS_META_READAHEAD_SIZE_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the metadata readahead # of pages */
+    if(H5P_register_real(pclass, H5F_ACS_META_READAHEAD_NPAGES_NAME, H5F_ACS_META_READAHEAD_NPAGES_SIZE, &H5F_def_meta_readahead_npages_g,
+            NULL, NULL, NULL, H5F_ACS_META_READAHEAD_NPAGES_ENC, H5F_ACS_META_READAHEAD_NPAGES_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
     /* Register the maximum sieve buffer size */
     if(H5P_register_real(pclass, H5F_ACS_SIEVE_BUF_SIZE_NAME, H5F_ACS_SIEVE_BUF_SIZE_SIZE, &H5F_def_sieve_buf_size_g, 
             NULL, NULL, NULL, H5F_ACS_SIEVE_BUF_SIZE_ENC, H5F_ACS_SIEVE_BUF_SIZE_DEC, 
@@ -1560,6 +1595,74 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_cache() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_chunk_cache_budget
+ *
+ * Purpose:	Set the memory budget shared by the raw data chunk caches of
+ *		the datasets opened in a file with automatic resizing (see
+ *		H5Pset_chunk_cache_auto_resize).  A chunk cache only grows
+ *		past its initial size while the datasets' growth, added
+ *		together, stays within NBYTES.  The default is 64MB.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_cache_budget(hid_t fapl_id, size_t nbytes)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iz", fapl_id, nbytes);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set value */
+    if(H5P_set(plist, H5F_ACS_DATA_CACHE_BUDGET_NAME, &nbytes) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set data cache budget")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_cache_budget() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_chunk_cache_budget
+ *
+ * Purpose:	Retrieves the memory budget for growing raw data chunk
+ *		caches.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_cache_budget(hid_t fapl_id, size_t *nbytes)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "i*z", fapl_id, nbytes);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value */
+    if(nbytes)
+        if(H5P_get(plist, H5F_ACS_DATA_CACHE_BUDGET_NAME, nbytes) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get data cache budget")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_cache_budget() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Pset_mdc_image_config
@@ -2012,6 +2115,88 @@ done:
     FUNC_LEAVE_API(ret_value)
 }
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_meta_readahead
+ *
+ * Purpose:	Turn on metadata readahead for files opened with the file
+ *		access property list.  A metadata read that misses the
+ *		metadata accumulator reads the whole PAGE_SIZE-aligned page
+ *		of the file around it, and up to NPAGES of the most recently
+ *		used pages are kept, so later metadata reads that fall in
+ *		them don't go to the file driver.
+ *
+ *		A PAGE_SIZE of 0 (the default) turns readahead off.
+ *		Readahead isn't used for files opened for SWMR access or
+ *		with parallel file drivers.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_meta_readahead(hid_t plist_id, size_t page_size, size_t npages)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE3("e", "izz", plist_id, page_size, npages);
+
+    /* Check args */
+    if(page_size > 0 && npages == 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "number of readahead pages must be positive")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set values */
+    if(H5P_set(plist, H5F_ACS_META_READAHEAD_SIZE_NAME, &page_size) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set metadata readahead page size")
+    if(H5P_set(plist, H5F_ACS_META_READAHEAD_NPAGES_NAME, &npages) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set number of metadata readahead pages")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_meta_readahead() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_meta_readahead
+ *
+ * Purpose:	Returns the metadata readahead page size and number of
+ *		pages from a file access property list.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_meta_readahead(hid_t plist_id, size_t *page_size/*out*/, size_t *npages/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE3("e", "ixx", plist_id, page_size, npages);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get values */
+    if(page_size)
+        if(H5P_get(plist, H5F_ACS_META_READAHEAD_SIZE_NAME, page_size) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get metadata readahead page size")
+    if(npages)
+        if(H5P_get(plist, H5F_ACS_META_READAHEAD_NPAGES_NAME, npages) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get number of metadata readahead pages")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_meta_readahead() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Pset_sieve_buf_size
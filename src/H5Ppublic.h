@@ -323,6 +323,8 @@ H5_DLL herr_t H5Pget_cache(hid_t plist_id,
        int *mdc_nelmts, /* out */
        size_t *rdcc_nslots/*out*/,
        size_t *rdcc_nbytes/*out*/, double *rdcc_w0);
+H5_DLL herr_t H5Pset_chunk_cache_budget(hid_t fapl_id, size_t nbytes);
+H5_DLL herr_t H5Pget_chunk_cache_budget(hid_t fapl_id, size_t *nbytes/*out*/);
 H5_DLL herr_t H5Pset_mdc_config(hid_t    plist_id,
        H5AC_cache_config_t * config_ptr);
 H5_DLL herr_t H5Pget_mdc_config(hid_t     plist_id,
@@ -333,6 +335,9 @@ H5_DLL herr_t H5Pset_fclose_degree(hid_t fapl_id, H5F_close_degree_t degree);
 H5_DLL herr_t H5Pget_fclose_degree(hid_t fapl_id, H5F_close_degree_t *degree);
 H5_DLL herr_t H5Pset_meta_block_size(hid_t fapl_id, hsize_t size);
 H5_DLL herr_t H5Pget_meta_block_size(hid_t fapl_id, hsize_t *size/*out*/);
+H5_DLL herr_t H5Pset_meta_readahead(hid_t fapl_id, size_t page_size, size_t npages);
+H5_DLL herr_t H5Pget_meta_readahead(hid_t fapl_id, size_t *page_size/*out*/,
+    size_t *npages/*out*/);
 H5_DLL herr_t H5Pset_sieve_buf_size(hid_t fapl_id, size_t size);
 H5_DLL herr_t H5Pget_sieve_buf_size(hid_t fapl_id, size_t *size/*out*/);
 H5_DLL herr_t H5Pset_small_data_block_size(hid_t fapl_id, hsize_t size);
@@ -392,6 +397,8 @@ H5_DLL herr_t H5Pget_external(hid_t plist_id, unsigned idx, size_t name_size,
           hsize_t *size/*out*/);
 H5_DLL herr_t H5Pset_szip(hid_t plist_id, unsigned options_mask, unsigned pixels_per_block);
 H5_DLL herr_t H5Pset_shuffle(hid_t plist_id);
+H5_DLL herr_t H5Pset_bitshuffle(hid_t plist_id, unsigned block_size,
+    unsigned compression);
 H5_DLL herr_t H5Pset_nbit(hid_t plist_id);
 H5_DLL herr_t H5Pset_scaleoffset(hid_t plist_id, H5Z_SO_scale_type_t scale_type, int scale_factor);
 H5_DLL herr_t H5Pset_fill_value(hid_t plist_id, hid_t type_id,
@@ -414,6 +421,13 @@ H5_DLL herr_t H5Pget_chunk_cache(hid_t dapl_id,
        size_t *rdcc_nslots/*out*/,
        size_t *rdcc_nbytes/*out*/,
        double *rdcc_w0/*out*/);
+H5_DLL herr_t H5Pset_chunk_cache_ways(hid_t dapl_id, unsigned rdcc_nways);
+H5_DLL herr_t H5Pget_chunk_cache_ways(hid_t dapl_id,
+       unsigned *rdcc_nways/*out*/);
+H5_DLL herr_t H5Pset_chunk_cache_auto_resize(hid_t dapl_id, hbool_t auto_resize);
+H5_DLL herr_t H5Pget_chunk_cache_auto_resize(hid_t dapl_id, hbool_t *auto_resize/*out*/);
+H5_DLL herr_t H5Pset_chunk_write_behind(hid_t dapl_id, size_t nbytes);
+H5_DLL herr_t H5Pget_chunk_write_behind(hid_t dapl_id, size_t *nbytes/*out*/);
 H5_DLL herr_t H5Pset_virtual_view(hid_t plist_id, H5D_vds_view_t view);
 H5_DLL herr_t H5Pget_virtual_view(hid_t plist_id, H5D_vds_view_t *view);
 H5_DLL herr_t H5Pset_virtual_printf_gap(hid_t plist_id, hsize_t gap_size);
@@ -438,6 +452,8 @@ H5_DLL herr_t H5Pset_edc_check(hid_t plist_id, H5Z_EDC_t check);
 H5_DLL H5Z_EDC_t H5Pget_edc_check(hid_t plist_id);
 H5_DLL herr_t H5Pset_filter_callback(hid_t plist_id, H5Z_filter_func_t func,
                                      void* op_data);
+H5_DLL herr_t H5Pset_filter_threads(hid_t plist_id, unsigned nthreads);
+H5_DLL herr_t H5Pget_filter_threads(hid_t plist_id, unsigned *nthreads/*out*/);
 H5_DLL herr_t H5Pset_btree_ratios(hid_t plist_id, double left, double middle,
        double right);
 H5_DLL herr_t H5Pget_btree_ratios(hid_t plist_id, double *left/*out*/,
@@ -41,6 +41,10 @@ static herr_t H5S_hyper_span_precompute(H5S_hyper_span_info_t *spans, size_t elm
 static herr_t H5S_generate_hyperslab(H5S_t *space, H5S_seloper_t op,
     const hsize_t start[], const hsize_t stride[], const hsize_t count[], const hsize_t block[]);
 static herr_t H5S_hyper_generate_spans(H5S_t *space);
+#ifndef NEW_HYPERSLAB_API
+static hbool_t H5S__hyper_extend_regular(H5S_t *space, const hsize_t start[],
+    const hsize_t stride[], const hsize_t count[], const hsize_t block[]);
+#endif /* NEW_HYPERSLAB_API */
 /* Needed for use in hyperslab code (H5Shyper.c) */
 #ifdef NEW_HYPERSLAB_API
 static herr_t H5S_select_select (H5S_t *space1, H5S_seloper_t op, H5S_t *space2);
@@ -86,6 +90,8 @@ static herr_t H5S_hyper_iter_release(H5S_sel_iter_t *sel_iter);
 /* Static function for optimizing hyperslab */
 static hbool_t H5S_hyper_rebuild_helper(const H5S_hyper_span_t *span,
     H5S_hyper_dim_t span_slab_info[], unsigned rank);
+static hbool_t H5S__hyper_spans_shape_match(const H5S_hyper_span_info_t *span_info1,
+    const H5S_hyper_span_info_t *span_info2);
 static htri_t H5S_hyper_rebuild(H5S_t *space);
 
 /* Selection properties for hyperslab selections */
@@ -6027,6 +6033,7 @@ H5S_hyper_rebuild_helper(const H5S_hyper_span_t *span, H5S_hyper_dim_t span_slab
     size_t outcount;
     unsigned u;
     H5S_hyper_dim_t      canon_down_span_slab_info[H5S_MAX_RANK];
+    const H5S_hyper_span_info_t *prev_down;
     hbool_t ret_value = TRUE;
 
     FUNC_ENTER_NOAPI_NOINIT_NOERR
@@ -6040,8 +6047,20 @@ H5S_hyper_rebuild_helper(const H5S_hyper_span_t *span, H5S_hyper_dim_t span_slab
 
         /* Get "canonical" down span information */
         if(span->down) {
+            const H5S_hyper_span_t *last_span;
+
             HDassert(span->down->head);
 
+            /* Reject early if the last span's down tree can't match the
+             * first span's, before recursing through every span in between.
+             * (Catches a partially filled trailing row of tiles cheaply)
+             */
+            for(last_span = span; last_span->next; last_span = last_span->next)
+                ;
+            if(last_span != span && last_span->down != span->down)
+                if(!last_span->down || !H5S__hyper_spans_shape_match(span->down, last_span->down))
+                    HGOTO_DONE(FALSE)
+
             /* Go to the next down span and check whether the selection can be rebuilt.*/
             if(!H5S_hyper_rebuild_helper(span->down->head, span_slab_info, rank - 1))
                 HGOTO_DONE(FALSE)
@@ -6052,11 +6071,13 @@ H5S_hyper_rebuild_helper(const H5S_hyper_span_t *span, H5S_hyper_dim_t span_slab
         /* Assign the initial starting point & block size */
         curr_start = span->low;
         curr_block = (span->high - span->low) + 1;
+        prev_down = span->down;
 
         /* Loop the span */
         while(span) {
             if(outcount > 0) {
-                if(span->down) {
+                /* Spans sharing the previous span's down tree already match */
+                if(span->down && span->down != prev_down) {
                     H5S_hyper_dim_t      *curr_down_span_slab_info;
 
                     HDassert(span->down->head);
@@ -6081,6 +6102,8 @@ H5S_hyper_rebuild_helper(const H5S_hyper_span_t *span, H5S_hyper_dim_t span_slab
                        else if (!((curr_down_span_slab_info->count == 0) && (canon_down_span_slab_info[u].count == 0)))
                           HGOTO_DONE(FALSE)
                     }
+
+                    prev_down = span->down;
                 } /* end if */
             } /* end if */
 
@@ -6119,6 +6142,65 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5S_hyper_rebuild_helper() */
 
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5S__hyper_spans_shape_match
+ PURPOSE
+    Quick check whether two span trees could describe the same selection
+ USAGE
+    hbool_t H5S__hyper_spans_shape_match(span_info1, span_info2)
+        const H5S_hyper_span_info_t *span_info1;  IN: First span tree
+        const H5S_hyper_span_info_t *span_info2;  IN: Second span tree
+ RETURNS
+    TRUE if the trees may be identical, FALSE if they certainly differ
+ DESCRIPTION
+    Compares the spans at the top level of each tree, then follows the
+    last span of each level down the tree.  Only the paths walked are
+    compared, so a TRUE result must still be confirmed by a full comparison.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+    Used by H5S_hyper_rebuild_helper() to reject irregular selections
+    without visiting every span in the tree.
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+static hbool_t
+H5S__hyper_spans_shape_match(const H5S_hyper_span_info_t *span_info1,
+    const H5S_hyper_span_info_t *span_info2)
+{
+    hbool_t ret_value = TRUE;   /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    while(span_info1 != span_info2) {
+        const H5S_hyper_span_t *span1, *span2;     /* Current spans in each tree */
+        const H5S_hyper_span_t *last1, *last2;     /* Last spans in each tree */
+
+        if(!span_info1 || !span_info2)
+            HGOTO_DONE(FALSE)
+
+        /* Compare the spans in this dimension */
+        last1 = last2 = NULL;
+        for(span1 = span_info1->head, span2 = span_info2->head; span1 && span2;
+                span1 = span1->next, span2 = span2->next) {
+            if(span1->low != span2->low || span1->high != span2->high)
+                HGOTO_DONE(FALSE)
+            last1 = span1;
+            last2 = span2;
+        } /* end for */
+        if(span1 || span2 || !last1)
+            HGOTO_DONE(FALSE)
+
+        /* Follow the last spans down to the next dimension */
+        span_info1 = last1->down;
+        span_info2 = last2->down;
+    } /* end while */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5S__hyper_spans_shape_match() */
+
 
 /*--------------------------------------------------------------------------
  NAME
@@ -6495,6 +6577,110 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5S_generate_hyperslab() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5S__hyper_extend_regular
+ *
+ * Purpose:	Try to OR a regular hyperslab into a regular selection by
+ *              extending the selection's dimension information, without
+ *              building span trees.
+ *
+ *              This succeeds when the new hyperslab lines up with the
+ *              current selection in all dimensions but one, and continues
+ *              the selection's pattern in that dimension: either the next
+ *              blocks at the same stride, or a block adjacent to a single
+ *              block.  Tiles added in order along a dimension stay regular
+ *              this way, no matter how many are added.
+ *
+ * Note:	STRIDE, COUNT and BLOCK must already be optimized the way
+ *              H5S_select_hyperslab() optimizes them.
+ *
+ * Return:	TRUE if the selection was extended, FALSE if the caller must
+ *              fall back to combining span trees.
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5S__hyper_extend_regular(H5S_t *space, const hsize_t start[],
+    const hsize_t stride[], const hsize_t count[], const hsize_t block[])
+{
+    H5S_hyper_sel_t *hslab = space->select.sel_info.hslab;    /* Hyperslab selection info */
+    H5S_hyper_dim_t *diminfo = hslab->opt_diminfo;            /* Current selection's optimized info */
+    H5S_hyper_dim_t new_diminfo;    /* Dimension info in the dimension being extended */
+    int ext_dim = -1;               /* Dimension being extended */
+    unsigned u;                     /* Local index variable */
+    hbool_t ret_value = FALSE;      /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Only regular, limited selections can be extended */
+    if(!hslab->diminfo_valid || hslab->unlim_dim >= 0)
+        HGOTO_DONE(FALSE)
+
+    /* Find the single dimension where the new hyperslab differs */
+    for(u = 0; u < space->extent.rank; u++)
+        if(start[u] != diminfo[u].start || count[u] != diminfo[u].count
+                || block[u] != diminfo[u].block
+                || (count[u] > 1 && stride[u] != diminfo[u].stride)) {
+            if(ext_dim >= 0)
+                HGOTO_DONE(FALSE)
+            ext_dim = (int)u;
+        } /* end if */
+
+    /* The new hyperslab is already selected */
+    if(ext_dim < 0)
+        HGOTO_DONE(TRUE)
+
+    /* Check whether the new blocks continue the pattern in that dimension */
+    new_diminfo = diminfo[ext_dim];
+    if(start[ext_dim] <= diminfo[ext_dim].start)
+        HGOTO_DONE(FALSE)
+    if(diminfo[ext_dim].count > 1) {
+        /* Next block(s) at the existing stride */
+        if(block[ext_dim] != diminfo[ext_dim].block
+                || start[ext_dim] != diminfo[ext_dim].start + diminfo[ext_dim].count * diminfo[ext_dim].stride
+                || (count[ext_dim] > 1 && stride[ext_dim] != diminfo[ext_dim].stride))
+            HGOTO_DONE(FALSE)
+        new_diminfo.count += count[ext_dim];
+    } /* end if */
+    else if(start[ext_dim] == diminfo[ext_dim].start + diminfo[ext_dim].block) {
+        /* Contiguous block adjacent to a single block */
+        if(count[ext_dim] > 1)
+            HGOTO_DONE(FALSE)
+        new_diminfo.block += block[ext_dim];
+    } /* end if */
+    else if(start[ext_dim] > diminfo[ext_dim].start + diminfo[ext_dim].block) {
+        /* Block(s) after a gap, defining the stride */
+        new_diminfo.stride = start[ext_dim] - diminfo[ext_dim].start;
+        if(block[ext_dim] != diminfo[ext_dim].block
+                || (count[ext_dim] > 1 && stride[ext_dim] != new_diminfo.stride))
+            HGOTO_DONE(FALSE)
+        new_diminfo.count += count[ext_dim];
+    } /* end if */
+    else
+        HGOTO_DONE(FALSE)
+
+    /* Any span tree no longer describes the selection */
+    if(hslab->span_lst) {
+        if(H5S_hyper_free_span_info(hslab->span_lst) < 0)
+            HGOTO_DONE(FALSE)
+        hslab->span_lst = NULL;
+    } /* end if */
+
+    /* Update the selection */
+    diminfo[ext_dim] = new_diminfo;
+    space->select.num_elem = 1;
+    for(u = 0; u < space->extent.rank; u++) {
+        hslab->app_diminfo[u] = diminfo[u];
+        space->select.num_elem *= diminfo[u].count * diminfo[u].block;
+    } /* end for */
+
+    ret_value = TRUE;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5S__hyper_extend_regular() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5S_select_hyperslab
@@ -6826,6 +7012,11 @@ H5S_select_hyperslab (H5S_t *space, H5S_seloper_t op,
             } /* end if */
         } /* end if */
 
+        /* Extend a regular selection in place when possible */
+        if(op == H5S_SELECT_OR && unlim_dim < 0
+                && H5S__hyper_extend_regular(space, start, opt_stride, opt_count, opt_block))
+            HGOTO_DONE(SUCCEED)
+
         /* Check if there's no hyperslab span information currently */
         if(NULL == space->select.sel_info.hslab->span_lst)
             if(H5S_hyper_generate_spans(space) < 0)
@@ -60,6 +60,22 @@ typedef struct H5S_hyper_dim_t {
     hsize_t block;
 } H5S_hyper_dim_t;
 
+/* Maximum number of loops needed to describe a selection with H5S_strided_t:
+ * one for the blocks and one for the elements of each dimension, plus one
+ * for splitting runs to match another selection */
+#define H5S_STRIDED_NDIMS       ((2 * H5S_MAX_RANK) + 1)
+
+/* Regular selection in a memory buffer, described as nested strided loops
+ * over runs of contiguous bytes, outermost loop first.  The runs are visited
+ * in the same order as the selection's iterator visits its elements. */
+typedef struct H5S_strided_t {
+    unsigned ndims;                     /* Number of loops (0 for a single run) */
+    hsize_t count[H5S_STRIDED_NDIMS];   /* Number of iterations of each loop */
+    hsize_t stride[H5S_STRIDED_NDIMS];  /* Bytes between iterations of each loop */
+    hsize_t offset;                     /* Offset of the first run, in bytes */
+    hsize_t run;                        /* Number of bytes in each run */
+} H5S_strided_t;
+
 /* Point selection iteration container */
 typedef struct {
     H5S_pnt_node_t *curr;   /* Pointer to next node to output */
@@ -270,6 +286,11 @@ H5_DLL herr_t H5S_select_project_intersection(const H5S_t *src_space,
     const H5S_t *dst_space, const H5S_t *src_intersect_space,
     H5S_t **new_space_ptr);
 H5_DLL herr_t H5S_select_subtract(H5S_t *space, H5S_t *subtract_space);
+H5_DLL htri_t H5S_select_get_strided(const H5S_t *space, size_t elmt_size,
+    H5S_strided_t *layout);
+H5_DLL herr_t H5S_select_strided_copy(void *dst, const H5S_strided_t *dst_layout,
+    hsize_t dst_skip, const void *src, const H5S_strided_t *src_layout,
+    hsize_t src_skip, size_t nbytes);
 
 /* Operations on all selections */
 H5_DLL herr_t H5S_select_all(H5S_t *space, hbool_t rel_prev);
@@ -32,12 +32,35 @@
 #include "H5VMprivate.h"		/* Vector and array functions		*/
 #include "H5WBprivate.h"        /* Wrapped Buffers                      */
 
+/* Copy NRUNS runs of N bytes, for H5S_select_strided_runs() */
+#define H5S_STRIDED_COPY_RUNS(N)                                              \
+    while(nruns-- > 0) {                                                      \
+        HDmemcpy(dst, src, N);                                                \
+        dst += dst_step;                                                      \
+        src += src_step;                                                      \
+    } /* end while */
+
+/* Position in a buffer described by a H5S_strided_t */
+typedef struct H5S_strided_cur_t {
+    const H5S_strided_t *layout;        /* Layout of buffer (NULL if contiguous) */
+    uint8_t *buf;                       /* Start of buffer */
+    uint8_t *ptr;                       /* Start of current run */
+    hsize_t idx[H5S_STRIDED_NDIMS];     /* Current iteration of each loop */
+    hsize_t pos;                        /* Bytes already used in current run */
+    hsize_t run;                        /* Bytes in each run */
+} H5S_strided_cur_t;
+
 /* Local functions */
 #ifdef LATER
 static herr_t H5S_select_iter_block(const H5S_sel_iter_t *iter, hsize_t *start, hsize_t *end);
 static htri_t H5S_select_iter_has_next_block(const H5S_sel_iter_t *iter);
 static herr_t H5S_select_iter_next_block(H5S_sel_iter_t *iter);
 #endif /* LATER */
+static void H5S_select_strided_init(H5S_strided_cur_t *cur,
+    const H5S_strided_t *layout, uint8_t *buf, hsize_t skip, size_t nbytes);
+static void H5S_select_strided_next(H5S_strided_cur_t *cur, hsize_t nruns);
+static void H5S_select_strided_runs(uint8_t *dst, hsize_t dst_step,
+    const uint8_t *src, hsize_t src_step, size_t run, hsize_t nruns);
 
 /* Declare a free list to manage the H5S_sel_iter_t struct */
 H5FL_DEFINE(H5S_sel_iter_t);
@@ -2453,3 +2476,409 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5S_select_subtract() */
 
+
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5S_select_get_strided
+ PURPOSE
+    Describe a regular selection in a memory buffer as strided loops
+ USAGE
+    htri_t H5S_select_get_strided(space, elmt_size, layout)
+        const H5S_t *space;     IN: Dataspace describing the memory buffer
+        size_t elmt_size;       IN: Size of each element in the buffer
+        H5S_strided_t *layout;  OUT: Loops over the selected elements
+ RETURNS
+    TRUE if the selection was described, FALSE if it can't be, negative on
+    failure.
+ DESCRIPTION
+    Converts an "all" selection or a regular hyperslab selection into nested
+    loops over runs of contiguous bytes, for use with
+    H5S_select_strided_copy().  Each dimension of a hyperslab contributes a
+    loop over its blocks and a loop over the elements in a block; loops with
+    one iteration are dropped, and loops which step through memory
+    contiguously are merged with the loop inside them or with the run.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+    Point selections and irregular hyperslab selections aren't described.
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+htri_t
+H5S_select_get_strided(const H5S_t *space, size_t elmt_size, H5S_strided_t *layout)
+{
+    htri_t ret_value = TRUE;    /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Check args */
+    HDassert(space);
+    HDassert(elmt_size > 0);
+    HDassert(layout);
+
+    switch(H5S_GET_SELECT_TYPE(space)) {
+        case H5S_SEL_ALL:
+            layout->ndims = 0;
+            layout->offset = 0;
+            layout->run = space->extent.nelem * elmt_size;
+            break;
+
+        case H5S_SEL_HYPERSLABS:
+            {
+                const H5S_hyper_sel_t *hslab = space->select.sel_info.hslab;
+                hsize_t slice;          /* Bytes between elements in the current dimension */
+                unsigned ndims;         /* Number of loops kept */
+                unsigned u;             /* Local index variable */
+                int i;                  /* Local index variable */
+
+                if(!hslab->diminfo_valid || hslab->unlim_dim >= 0)
+                    HGOTO_DONE(FALSE)
+
+                /* Build a block loop & an element loop for each dimension */
+                slice = elmt_size;
+                layout->offset = 0;
+                for(i = (int)space->extent.rank - 1; i >= 0; i--) {
+                    const H5S_hyper_dim_t *diminfo = &hslab->opt_diminfo[i];
+
+                    layout->count[2 * i] = diminfo->count;
+                    layout->stride[2 * i] = diminfo->stride * slice;
+                    layout->count[(2 * i) + 1] = diminfo->block;
+                    layout->stride[(2 * i) + 1] = slice;
+                    layout->offset += (hsize_t)((hssize_t)diminfo->start + space->select.offset[i]) * slice;
+                    slice *= space->extent.size[i];
+                } /* end for */
+
+                /* Drop loops with one iteration, merging each loop with the
+                 * loop inside it when they step through memory together */
+                ndims = 0;
+                for(u = 0; u < 2 * space->extent.rank; u++)
+                    if(layout->count[u] > 1) {
+                        if(ndims > 0 && layout->stride[ndims - 1] == layout->count[u] * layout->stride[u]) {
+                            layout->count[ndims - 1] *= layout->count[u];
+                            layout->stride[ndims - 1] = layout->stride[u];
+                        } /* end if */
+                        else {
+                            layout->count[ndims] = layout->count[u];
+                            layout->stride[ndims] = layout->stride[u];
+                            ndims++;
+                        } /* end else */
+                    } /* end if */
+
+                /* Fold the innermost loops into the run while contiguous */
+                layout->run = elmt_size;
+                while(ndims > 0 && layout->stride[ndims - 1] == layout->run) {
+                    layout->run *= layout->count[ndims - 1];
+                    ndims--;
+                } /* end while */
+                layout->ndims = ndims;
+            }
+            break;
+
+        case H5S_SEL_NONE:
+        case H5S_SEL_POINTS:
+        case H5S_SEL_ERROR:
+        case H5S_SEL_N:
+        default:
+            HGOTO_DONE(FALSE)
+    } /* end switch */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5S_select_get_strided() */
+
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5S_select_strided_init
+ PURPOSE
+    Position a cursor on a strided layout
+ USAGE
+    void H5S_select_strided_init(cur, layout, buf, skip, nbytes)
+        H5S_strided_cur_t *cur;         OUT: Cursor to initialize
+        const H5S_strided_t *layout;    IN: Layout of buffer, or NULL
+        uint8_t *buf;                   IN: Buffer
+        hsize_t skip;                   IN: Bytes of the layout to skip
+        size_t nbytes;                  IN: Bytes which will be copied
+ RETURNS
+    None
+ DESCRIPTION
+    Sets the cursor on the byte SKIP bytes into the selected bytes of the
+    layout.  A NULL layout stands for a contiguous buffer.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+static void
+H5S_select_strided_init(H5S_strided_cur_t *cur, const H5S_strided_t *layout,
+    uint8_t *buf, hsize_t skip, size_t nbytes)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    cur->buf = buf;
+    if(NULL == layout || 0 == layout->ndims) {
+        /* Single run, the cursor just moves through it */
+        cur->layout = NULL;
+        cur->ptr = buf + (layout ? layout->offset : 0);
+        cur->pos = skip;
+        cur->run = layout ? layout->run : skip + nbytes;
+    } /* end if */
+    else {
+        hsize_t nruns = skip / layout->run;     /* Whole runs to skip */
+        int u;                                  /* Local index variable */
+
+        /* Locate the run holding the first byte */
+        cur->layout = layout;
+        cur->ptr = buf + layout->offset;
+        for(u = (int)layout->ndims - 1; u >= 0; u--) {
+            cur->idx[u] = nruns % layout->count[u];
+            nruns /= layout->count[u];
+            cur->ptr += cur->idx[u] * layout->stride[u];
+        } /* end for */
+        cur->pos = skip % layout->run;
+        cur->run = layout->run;
+    } /* end else */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5S_select_strided_init() */
+
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5S_select_strided_next
+ PURPOSE
+    Advance a cursor on a strided layout by whole runs
+ USAGE
+    void H5S_select_strided_next(cur, nruns)
+        H5S_strided_cur_t *cur;         IN/OUT: Cursor to advance
+        hsize_t nruns;                  IN: Number of runs to advance
+ RETURNS
+    None
+ DESCRIPTION
+    Moves the cursor, which must be at the start of a run, NRUNS runs
+    forward.  NRUNS must not be more than the iterations left in the
+    innermost loop.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+static void
+H5S_select_strided_next(H5S_strided_cur_t *cur, hsize_t nruns)
+{
+    const H5S_strided_t *layout = cur->layout;  /* Layout of the buffer */
+    unsigned u = layout->ndims - 1;             /* Innermost loop */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(cur->idx[u] + nruns <= layout->count[u]);
+
+    cur->idx[u] += nruns;
+    cur->ptr += nruns * layout->stride[u];
+
+    /* Carry into the outer loops when the innermost loop finishes */
+    if(cur->idx[u] == layout->count[u]) {
+        while(u > 0 && cur->idx[u] == layout->count[u]) {
+            cur->idx[u] = 0;
+            cur->idx[--u]++;
+        } /* end while */
+
+        /* Recompute the position of the run from the loop indices */
+        cur->ptr = cur->buf + layout->offset;
+        for(u = 0; u < layout->ndims; u++)
+            cur->ptr += cur->idx[u] * layout->stride[u];
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5S_select_strided_next() */
+
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5S_select_strided_runs
+ PURPOSE
+    Copy runs of the same size between two strided buffers
+ USAGE
+    void H5S_select_strided_runs(dst, dst_step, src, src_step, run, nruns)
+        uint8_t *dst;           OUT: First destination run
+        hsize_t dst_step;       IN: Bytes between destination runs
+        const uint8_t *src;     IN: First source run
+        hsize_t src_step;       IN: Bytes between source runs
+        size_t run;             IN: Bytes in each run
+        hsize_t nruns;          IN: Number of runs to copy
+ RETURNS
+    None
+ DESCRIPTION
+    Copies NRUNS runs, with fixed-size loops for runs of 1, 2, 4 and 8
+    bytes (single elements of the common datatypes) so that each run is
+    copied without a call to memcpy().
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+static void
+H5S_select_strided_runs(uint8_t *dst, hsize_t dst_step, const uint8_t *src,
+    hsize_t src_step, size_t run, hsize_t nruns)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Runs adjacent in both buffers are one block */
+    if(dst_step == run && src_step == run)
+        HDmemcpy(dst, src, run * nruns);
+    else
+        switch(run) {
+            case 1:
+                H5S_STRIDED_COPY_RUNS(1)
+                break;
+
+            case 2:
+                H5S_STRIDED_COPY_RUNS(2)
+                break;
+
+            case 4:
+                H5S_STRIDED_COPY_RUNS(4)
+                break;
+
+            case 8:
+                H5S_STRIDED_COPY_RUNS(8)
+                break;
+
+            default:
+                H5S_STRIDED_COPY_RUNS(run)
+                break;
+        } /* end switch */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5S_select_strided_runs() */
+
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5S_select_strided_copy
+ PURPOSE
+    Copy bytes between two buffers described by strided layouts
+ USAGE
+    herr_t H5S_select_strided_copy(dst, dst_layout, dst_skip, src, src_layout, src_skip, nbytes)
+        void *dst;                      OUT: Destination buffer
+        const H5S_strided_t *dst_layout; IN: Layout of destination, or NULL
+        hsize_t dst_skip;               IN: Bytes of destination layout to skip
+        const void *src;                IN: Source buffer
+        const H5S_strided_t *src_layout; IN: Layout of source, or NULL
+        hsize_t src_skip;               IN: Bytes of source layout to skip
+        size_t nbytes;                  IN: Number of bytes to copy
+ RETURNS
+    Non-negative on success/Negative on failure.
+ DESCRIPTION
+    Copies NBYTES bytes from the selected bytes of the source to the
+    selected bytes of the destination, in order, starting SRC_SKIP and
+    DST_SKIP bytes into each layout.  A NULL layout stands for a contiguous
+    buffer.  This does the work of H5VM_memcpyvv() on the sequences of two
+    regular selections, without building the sequence lists.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+    The layouts come from H5S_select_get_strided().
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+herr_t
+H5S_select_strided_copy(void *dst, const H5S_strided_t *dst_layout,
+    hsize_t dst_skip, const void *src, const H5S_strided_t *src_layout,
+    hsize_t src_skip, size_t nbytes)
+{
+    H5S_strided_cur_t dst_cur;  /* Cursor on destination */
+    H5S_strided_cur_t src_cur;  /* Cursor on source */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Check args */
+    HDassert(dst);
+    HDassert(src);
+
+    H5S_select_strided_init(&dst_cur, dst_layout, (uint8_t *)dst, dst_skip, nbytes);
+    H5S_select_strided_init(&src_cur, src_layout, (uint8_t *)src, src_skip, nbytes);
+
+    while(nbytes > 0) {
+        hsize_t run = 0;        /* Bytes in each run copied by the stride loop */
+        hsize_t nruns = 0;      /* Number of runs copied by the stride loop */
+        hsize_t dst_step = 0;   /* Bytes between destination runs */
+        hsize_t src_step = 0;   /* Bytes between source runs */
+
+        /* Whole runs are copied with a stride loop when the strided sides
+         * are at the start of a run and their runs are the same size */
+        if(dst_cur.layout && src_cur.layout) {
+            if(dst_cur.pos == 0 && src_cur.pos == 0 && dst_cur.run == src_cur.run)
+                run = dst_cur.run;
+        } /* end if */
+        else if(dst_cur.layout) {
+            if(dst_cur.pos == 0)
+                run = dst_cur.run;
+        } /* end if */
+        else if(src_cur.layout) {
+            if(src_cur.pos == 0)
+                run = src_cur.run;
+        } /* end if */
+        else
+            run = nbytes;
+        if(run > 0 && (nruns = nbytes / run) > 0) {
+            if(dst_cur.layout) {
+                unsigned u = dst_cur.layout->ndims - 1;     /* Innermost loop */
+
+                nruns = MIN(nruns, dst_cur.layout->count[u] - dst_cur.idx[u]);
+                dst_step = dst_cur.layout->stride[u];
+            } /* end if */
+            else {
+                nruns = MIN(nruns, (dst_cur.run - dst_cur.pos) / run);
+                dst_step = run;
+            } /* end else */
+            if(src_cur.layout) {
+                unsigned u = src_cur.layout->ndims - 1;     /* Innermost loop */
+
+                nruns = MIN(nruns, src_cur.layout->count[u] - src_cur.idx[u]);
+                src_step = src_cur.layout->stride[u];
+            } /* end if */
+            else {
+                nruns = MIN(nruns, (src_cur.run - src_cur.pos) / run);
+                src_step = run;
+            } /* end else */
+        } /* end if */
+
+        if(nruns > 0) {
+            H5S_select_strided_runs(dst_cur.ptr + dst_cur.pos, dst_step,
+                    src_cur.ptr + src_cur.pos, src_step, (size_t)run, nruns);
+
+            /* Advance both cursors past the runs */
+            if(dst_cur.layout)
+                H5S_select_strided_next(&dst_cur, nruns);
+            else
+                dst_cur.pos += nruns * run;
+            if(src_cur.layout)
+                H5S_select_strided_next(&src_cur, nruns);
+            else
+                src_cur.pos += nruns * run;
+            nbytes -= (size_t)(nruns * run);
+        } /* end if */
+        else {
+            size_t len;         /* Bytes to copy */
+
+            /* Copy up to the end of the shorter run */
+            len = (size_t)MIN3(dst_cur.run - dst_cur.pos, src_cur.run - src_cur.pos, nbytes);
+            HDmemcpy(dst_cur.ptr + dst_cur.pos, src_cur.ptr + src_cur.pos, len);
+
+            /* Advance both cursors past the bytes */
+            dst_cur.pos += len;
+            if(dst_cur.layout && dst_cur.pos == dst_cur.run) {
+                dst_cur.pos = 0;
+                H5S_select_strided_next(&dst_cur, (hsize_t)1);
+            } /* end if */
+            src_cur.pos += len;
+            if(src_cur.layout && src_cur.pos == src_cur.run) {
+                src_cur.pos = 0;
+                H5S_select_strided_next(&src_cur, (hsize_t)1);
+            } /* end if */
+            nbytes -= len;
+        } /* end else */
+    } /* end while */
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* H5S_select_strided_copy() */
@@ -55,6 +55,9 @@
 
 #define H5T_ENCODE_VERSION      0
 
+/* Number of entries in the conversion path cache (a power of two) */
+#define H5T_PATH_CACHE_SIZE     256
+
 /*
  * Type initialization macros
  *
@@ -276,6 +279,13 @@
 /* Local Typedefs */
 /******************/
 
+/* An entry in the conversion path cache */
+typedef struct H5T_path_cache_t {
+    uint32_t    src_hash;       /*fingerprint of the source type        */
+    uint32_t    dst_hash;       /*fingerprint of the destination type   */
+    H5T_path_t  *path;          /*path for the pair, or NULL if unused  */
+} H5T_path_cache_t;
+
 
 /********************/
 /* Local Prototypes */
@@ -286,6 +296,8 @@ static herr_t H5T_register(H5T_pers_t pers, const char *name, H5T_t *src,
         H5T_t *dst, H5T_conv_t func, hid_t dxpl_id, hbool_t api_call);
 static htri_t H5T_compiler_conv(H5T_t *src, H5T_t *dst);
 static herr_t H5T_set_size(H5T_t *dt, size_t size);
+static uint32_t H5T_path_hash(const H5T_t *dt);
+static hbool_t H5T_path_match(const H5T_t *dt1, const H5T_t *dt2);
 
 
 /*****************************/
@@ -507,6 +519,11 @@ H5FL_DEFINE(H5T_shared_t);
 /*
  * The path database. Each path has a source and destination data type pair
  * which is used as the key by which the `entries' array is sorted.
+ *
+ * Lookups of a type pair go through a direct-mapped cache first, indexed by
+ * fingerprints of the two types, which saves the binary search and its
+ * H5T_cmp() calls for pairs that are converted repeatedly.  The cache is
+ * emptied whenever a path is replaced or removed.
  */
 static struct {
     int	npaths;		/*number of paths defined		*/
@@ -515,6 +532,7 @@ static struct {
     int	nsoft;		/*number of soft conversions defined	*/
     size_t	asoft;		/*number of soft conversions allocated	*/
     H5T_soft_t	*soft;		/*unsorted array of soft conversions	*/
+    H5T_path_cache_t cache[H5T_PATH_CACHE_SIZE]; /*cache of path lookups */
 } H5T_g;
 
 /* Declare the free list for H5T_path_t's */
@@ -1387,6 +1405,7 @@ H5T_top_term_package(void)
             } /* end for */
 
             /* Clear conversion tables */
+            HDmemset(H5T_g.cache, 0, sizeof(H5T_g.cache));
             H5T_g.path = (H5T_path_t **)H5MM_xfree(H5T_g.path);
             H5T_g.npaths = 0;
             H5T_g.apaths = 0;
@@ -2367,9 +2386,10 @@ H5T_register(H5T_pers_t pers, const char *name, H5T_t *src, H5T_t *dst,
             new_path->is_hard = FALSE;
             new_path->cdata = cdata;
 
-            /* Replace previous path */
+            /* Replace previous path, which may be in the lookup cache */
             H5T_g.path[i] = new_path;
             new_path = NULL; /*so we don't free it on error*/
+            HDmemset(H5T_g.cache, 0, sizeof(H5T_g.cache));
 
             /* Free old path */
             H5T__print_stats(old_path, &nprint);
@@ -2539,9 +2559,10 @@ H5T_unregister(H5T_pers_t pers, const char *name, H5T_t *src, H5T_t *dst,
             path->cdata.recalc = TRUE;
         } /* end if */
         else {
-            /* Remove from table */
+            /* Remove from table and from the lookup cache */
             HDmemmove(H5T_g.path + i, H5T_g.path + i + 1, (size_t)(H5T_g.npaths - (i + 1)) * sizeof(H5T_path_t*));
             --H5T_g.npaths;
+            HDmemset(H5T_g.cache, 0, sizeof(H5T_g.cache));
 
             /* Shut down path */
             H5T__print_stats(path, &nprint);
@@ -4357,6 +4378,145 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5T_cmp() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_path_hash
+ *
+ * Purpose:	Computes a fingerprint of a datatype for the conversion
+ *		path cache.  Types that H5T_cmp() considers equal have the
+ *		same fingerprint; compound members are combined in a way that
+ *		doesn't depend on their order, since H5T_cmp() compares them
+ *		sorted by name.  Unlike H5T_cmp(), this is linear in the
+ *		number of members and doesn't allocate.
+ *
+ * Return:	The fingerprint (never fails)
+ *
+ *-------------------------------------------------------------------------
+ */
+static uint32_t
+H5T_path_hash(const H5T_t *dt)
+{
+    uint32_t    val[6];                 /* Values to hash */
+    unsigned    u;                      /* Local index variable */
+    uint32_t    ret_value;              /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(dt);
+    HDassert(dt->shared);
+
+    HDmemset(val, 0, sizeof(val));
+    val[0] = (uint32_t)dt->shared->type;
+    val[1] = (uint32_t)dt->shared->size;
+    val[2] = (uint32_t)dt->shared->force_conv;
+    val[3] = dt->shared->parent ? H5T_path_hash(dt->shared->parent) : 0;
+
+    switch(dt->shared->type) {
+        case H5T_COMPOUND:
+            val[4] = dt->shared->u.compnd.nmembs;
+            for(u = 0; u < dt->shared->u.compnd.nmembs; u++) {
+                const H5T_cmemb_t *memb = &dt->shared->u.compnd.memb[u];
+                uint32_t mval[3];
+
+                mval[0] = (uint32_t)memb->offset;
+                mval[1] = (uint32_t)memb->size;
+                mval[2] = H5T_path_hash(memb->type);
+                val[5] += H5_checksum_lookup3(mval, sizeof(mval), H5_hash_string(memb->name));
+            } /* end for */
+            break;
+
+        case H5T_ENUM:
+            val[4] = dt->shared->u.enumer.nmembs;
+            break;
+
+        case H5T_VLEN:
+            val[4] = (uint32_t)dt->shared->u.vlen.type;
+            val[5] = (uint32_t)dt->shared->u.vlen.loc;
+            break;
+
+        case H5T_ARRAY:
+            val[4] = dt->shared->u.array.ndims;
+            for(u = 0; u < dt->shared->u.array.ndims; u++)
+                val[5] = val[5] * 31 + (uint32_t)dt->shared->u.array.dim[u];
+            break;
+
+        case H5T_OPAQUE:
+            break;
+
+        case H5T_NO_CLASS:
+        case H5T_INTEGER:
+        case H5T_FLOAT:
+        case H5T_TIME:
+        case H5T_STRING:
+        case H5T_BITFIELD:
+        case H5T_REFERENCE:
+        case H5T_NCLASSES:
+        default:
+            val[4] = (uint32_t)dt->shared->u.atomic.prec;
+            val[5] = ((uint32_t)dt->shared->u.atomic.offset << 8) |
+                    ((uint32_t)dt->shared->u.atomic.order << 4) |
+                    ((uint32_t)dt->shared->u.atomic.lsb_pad << 2) |
+                    (uint32_t)dt->shared->u.atomic.msb_pad;
+            break;
+    } /* end switch */
+
+    ret_value = H5_checksum_lookup3(val, sizeof(val), 0);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T_path_hash() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_path_match
+ *
+ * Purpose:	Checks whether two datatypes are equal, for confirming a
+ *		conversion path cache hit.  Compound types whose members are
+ *		in the same order are compared member by member, which avoids
+ *		H5T_cmp() sorting the member names; everything else goes to
+ *		H5T_cmp().
+ *
+ * Return:	TRUE if the types are equal, FALSE otherwise (never fails)
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5T_path_match(const H5T_t *dt1, const H5T_t *dt2)
+{
+    unsigned    u;                      /* Local index variable */
+    hbool_t     ret_value = FALSE;      /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(dt1);
+    HDassert(dt2);
+
+    if(dt1 == dt2)
+        HGOTO_DONE(TRUE)
+
+    if(H5T_COMPOUND == dt1->shared->type && H5T_COMPOUND == dt2->shared->type &&
+            dt1->shared->size == dt2->shared->size && !dt1->shared->parent &&
+            !dt2->shared->parent &&
+            dt1->shared->u.compnd.nmembs == dt2->shared->u.compnd.nmembs) {
+        for(u = 0; u < dt1->shared->u.compnd.nmembs; u++) {
+            const H5T_cmemb_t *memb1 = &dt1->shared->u.compnd.memb[u];
+            const H5T_cmemb_t *memb2 = &dt2->shared->u.compnd.memb[u];
+
+            if(memb1->offset != memb2->offset || memb1->size != memb2->size ||
+                    HDstrcmp(memb1->name, memb2->name) ||
+                    !H5T_path_match(memb1->type, memb2->type))
+                break;
+        } /* end for */
+        if(u == dt1->shared->u.compnd.nmembs)
+            HGOTO_DONE(TRUE)
+    } /* end if */
+
+    /* Members in a different order, or not a compound type */
+    ret_value = (0 == H5T_cmp(dt1, dt2, FALSE));
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T_path_match() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5T_path_find
@@ -4405,6 +4565,8 @@ H5T_path_find(const H5T_t *src, const H5T_t *dst, const char *name,
     int old_npaths;             /* Previous number of paths in table */
     H5T_path_t	*table = NULL;		/*path existing in the table	*/
     H5T_path_t	*path = NULL;		/*new path			*/
+    H5T_path_cache_t *cache = NULL;	/*lookup cache entry for the pair */
+    uint32_t	src_hash = 0, dst_hash = 0; /*type fingerprints	*/
     hid_t	src_id = -1, dst_id = -1;	/*src and dst type identifiers	*/
     int	i;			/*counter			*/
     int	nprint = 0;		/*lines of output printed	*/
@@ -4441,6 +4603,26 @@ H5T_path_find(const H5T_t *src, const H5T_t *dst, const char *name,
 	H5T_g.npaths = 1;
     } /* end if */
 
+    /*
+     * Plain lookups (not registering a function) check the cache first.
+     * Entries are matched by the types' fingerprints and confirmed against
+     * the path's own types, so a fingerprint collision only costs a miss.
+     */
+    if(!func) {
+        src_hash = H5T_path_hash(src);
+        dst_hash = H5T_path_hash(dst);
+        cache = &H5T_g.cache[(src_hash ^ (dst_hash * 0x9e3779b9)) & (H5T_PATH_CACHE_SIZE - 1)];
+        if(cache->path && cache->src_hash == src_hash && cache->dst_hash == dst_hash) {
+            if(cache->path->is_noop ?
+                    (src->shared->force_conv == FALSE && dst->shared->force_conv == FALSE &&
+                     H5T_path_match(src, dst)) :
+                    (H5T_path_match(src, cache->path->src) && H5T_path_match(dst, cache->path->dst))) {
+                cache->path->stats.nhits++;
+                HGOTO_DONE(cache->path)
+            } /* end if */
+        } /* end if */
+    } /* end if */
+
     /*
      * Find the conversion path.  If source and destination types are equal
      * then use entry[0], otherwise do a binary search over the
@@ -4606,6 +4788,7 @@ H5T_path_find(const H5T_t *src, const H5T_t *dst, const char *name,
         table = H5FL_FREE(H5T_path_t, table);
 	table = path;
 	H5T_g.path[md] = path;
+        HDmemset(H5T_g.cache, 0, sizeof(H5T_g.cache));
     } else if(path != table) {
 	HDassert(cmp);
         if((size_t)H5T_g.npaths >= H5T_g.apaths) {
@@ -4630,6 +4813,14 @@ H5T_path_find(const H5T_t *src, const H5T_t *dst, const char *name,
     if(H5T_COMPOUND == H5T_get_class(src, TRUE) && H5T_COMPOUND == H5T_get_class(dst, TRUE))
         path->are_compounds = TRUE;
 
+    /* Remember the path for the next lookup of the pair */
+    if(cache) {
+        cache->src_hash = src_hash;
+        cache->dst_hash = dst_hash;
+        cache->path = path;
+        path->stats.nmisses++;
+    } /* end if */
+
     /* Set return value */
     ret_value = path;
 
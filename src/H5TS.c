@@ -37,6 +37,16 @@ H5TS_once_t H5TS_first_init_g = PTHREAD_ONCE_INIT;
 H5TS_key_t H5TS_errstk_key_g;
 H5TS_key_t H5TS_funcstk_key_g;
 H5TS_key_t H5TS_cancel_key_g;
+H5TS_mutex_simple_t H5TS_errstk_lock_g;
+
+/* Shared state for the threads running a set of tasks */
+typedef struct H5TS_task_pool_t {
+    H5TS_mutex_simple_t lock;   /* Lock protecting 'next' */
+    size_t next;                /* Next task to hand out */
+    size_t ntasks;              /* Number of tasks */
+    H5TS_task_func_t func;      /* Callback to run for each task */
+    void *udata;                /* User data for callback */
+} H5TS_task_pool_t;
 
 
 /*--------------------------------------------------------------------------
@@ -113,6 +123,9 @@ H5TS_pthread_first_thread_init(void)
 
     /* initialize key for thread cancellability mechanism */
     pthread_key_create(&H5TS_cancel_key_g, H5TS_key_destructor);
+
+    /* initialize lock for error stack ID reference counts */
+    pthread_mutex_init(&H5TS_errstk_lock_g, NULL);
 }
 #endif /* H5_HAVE_WIN_THREADS */
 
@@ -346,8 +359,9 @@ H5TS_win32_process_enter(PINIT_ONCE InitOnce, PVOID Parameter, PVOID *lpContex)
 {
     BOOL ret_value = TRUE;
 
-    /* Initialize the critical section (can't fail) */
+    /* Initialize the critical sections (can't fail) */
     InitializeCriticalSection(&H5_g.init_lock.CriticalSection);
+    InitializeCriticalSection(&H5TS_errstk_lock_g);
 
     /* Set up thread local storage */
     if(TLS_OUT_OF_INDEXES == (H5TS_errstk_key_g = TlsAlloc()))
@@ -520,4 +534,114 @@ H5TS_create_thread(void *(*func)(void *), H5TS_attr_t *attr, void *udata)
 
 } /* H5TS_create_thread */
 
+
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS_task_worker
+ *
+ * RETURNS
+ *    NULL
+ *
+ * DESCRIPTION
+ *    Thread body for H5TS_run_tasks(): claims tasks from the pool until
+ *    there are none left.
+ *
+ *--------------------------------------------------------------------------
+ */
+#ifdef H5_HAVE_WIN_THREADS
+static DWORD WINAPI
+#else /* H5_HAVE_WIN_THREADS */
+static void *
+#endif /* H5_HAVE_WIN_THREADS */
+H5TS_task_worker(void *_pool)
+{
+    H5TS_task_pool_t *pool = (H5TS_task_pool_t *)_pool;
+    size_t task;
+
+    for(;;) {
+        H5TS_mutex_lock_simple(&pool->lock);
+        task = pool->next++;
+        H5TS_mutex_unlock_simple(&pool->lock);
+
+        if(task >= pool->ntasks)
+            break;
+        (pool->func)(task, pool->udata);
+    } /* end for */
+
+#ifdef H5_HAVE_WIN_THREADS
+    return 0;
+#else /* H5_HAVE_WIN_THREADS */
+    return NULL;
+#endif /* H5_HAVE_WIN_THREADS */
+} /* H5TS_task_worker */
+
+
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS_run_tasks
+ *
+ * RETURNS
+ *    SUCCEED/FAIL
+ *
+ * DESCRIPTION
+ *    Calls 'func' once for each task number in [0, ntasks), spread over
+ *    up to 'nthreads' threads, and returns after all tasks have finished.
+ *    The calling thread only waits; it keeps holding the library's API
+ *    lock, so 'func' must not call back into the public API.
+ *
+ *    If fewer threads than requested can be created, the ones that were
+ *    created run all the tasks.  FAIL is only returned when no thread at
+ *    all could be started, in which case no task has been run.
+ *
+ *--------------------------------------------------------------------------
+ */
+herr_t
+H5TS_run_tasks(unsigned nthreads, size_t ntasks, H5TS_task_func_t func, void *udata)
+{
+    H5TS_task_pool_t pool;
+    H5TS_thread_t *threads;
+    unsigned nstarted, u;
+
+    if(ntasks < nthreads)
+        nthreads = (unsigned)ntasks;
+    if(0 == nthreads)
+        return SUCCEED;
+
+    /* Use HDmalloc here instead of H5MM_malloc(), to avoid calling the H5CS routines */
+    if(NULL == (threads = (H5TS_thread_t *)HDmalloc(nthreads * sizeof(H5TS_thread_t))))
+        return FAIL;
+
+    H5TS_mutex_init(&pool.lock);
+    pool.next = 0;
+    pool.ntasks = ntasks;
+    pool.func = func;
+    pool.udata = udata;
+
+    for(nstarted = 0; nstarted < nthreads; nstarted++) {
+#ifdef H5_HAVE_WIN_THREADS
+        if(NULL == (threads[nstarted] = CreateThread(NULL, 0, H5TS_task_worker, &pool, 0, NULL)))
+            break;
+#else /* H5_HAVE_WIN_THREADS */
+        if(0 != pthread_create(&threads[nstarted], NULL, H5TS_task_worker, &pool))
+            break;
+#endif /* H5_HAVE_WIN_THREADS */
+    } /* end for */
+
+    for(u = 0; u < nstarted; u++) {
+        H5TS_wait_for_thread(threads[u]);
+#ifdef H5_HAVE_WIN_THREADS
+        CloseHandle(threads[u]);
+#endif /* H5_HAVE_WIN_THREADS */
+    } /* end for */
+
+#ifdef H5_HAVE_WIN_THREADS
+    DeleteCriticalSection(&pool.lock);
+#else /* H5_HAVE_WIN_THREADS */
+    pthread_mutex_destroy(&pool.lock);
+#endif /* H5_HAVE_WIN_THREADS */
+    HDfree(threads);
+
+    return(nstarted > 0 ? SUCCEED : FAIL);
+} /* H5TS_run_tasks */
+
 #endif  /* H5_HAVE_THREADSAFE */
@@ -111,6 +111,10 @@ typedef pthread_once_t H5TS_once_t;
 extern H5TS_once_t H5TS_first_init_g;
 extern H5TS_key_t H5TS_errstk_key_g;
 extern H5TS_key_t H5TS_funcstk_key_g;
+extern H5TS_mutex_simple_t H5TS_errstk_lock_g;
+
+/* Callback for each task run by H5TS_run_tasks() */
+typedef void (*H5TS_task_func_t)(size_t task, void *udata);
 
 #if defined c_plusplus || defined __cplusplus
 extern      "C"
@@ -123,6 +127,7 @@ H5_DLL herr_t H5TS_mutex_unlock(H5TS_mutex_t *mutex);
 H5_DLL herr_t H5TS_cancel_count_inc(void);
 H5_DLL herr_t H5TS_cancel_count_dec(void);
 H5_DLL H5TS_thread_t H5TS_create_thread(void *(*func)(void *), H5TS_attr_t * attr, void *udata);
+H5_DLL herr_t H5TS_run_tasks(unsigned nthreads, size_t ntasks, H5TS_task_func_t func, void *udata);
 
 #if defined c_plusplus || defined __cplusplus
 }
@@ -42,6 +42,78 @@
 /* Local Macros */
 /****************/
 
+/*
+ * Vector kernels for the hardware conversions.  SSE2 is part of the x86-64
+ * baseline, so it is used whenever the compiler says it is available; the
+ * AVX2 kernels are compiled with a function-level target attribute and only
+ * called when the CPU reports AVX2 support at run time.
+ */
+#if defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#define H5T_CONV_VEC
+#include <emmintrin.h>
+#if !defined(__INTEL_COMPILER) && \
+        ((defined(__clang__) && __clang_major__ >= 4) || \
+         (!defined(__clang__) && defined(__GNUC__) && \
+          (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#define H5T_CONV_VEC_AVX2
+#include <immintrin.h>
+#endif
+#endif /* __SSE2__ */
+
+/* Kinds of elements the vector kernels know about */
+#define H5T_VEC_NONE    0
+#define H5T_VEC_S8      1
+#define H5T_VEC_U8      2
+#define H5T_VEC_S16     3
+#define H5T_VEC_U16     4
+#define H5T_VEC_S32     5
+#define H5T_VEC_U32     6
+#define H5T_VEC_S64     7
+#define H5T_VEC_U64     8
+#define H5T_VEC_F32     9
+#define H5T_VEC_F64     10
+
+/* The kind of each native type used by the hardware conversions */
+#define H5T_VEC_KIND_SCHAR      H5T_VEC_S8
+#define H5T_VEC_KIND_UCHAR      H5T_VEC_U8
+#if H5_SIZEOF_SHORT == 2
+#define H5T_VEC_KIND_SHORT      H5T_VEC_S16
+#define H5T_VEC_KIND_USHORT     H5T_VEC_U16
+#else
+#define H5T_VEC_KIND_SHORT      H5T_VEC_NONE
+#define H5T_VEC_KIND_USHORT     H5T_VEC_NONE
+#endif
+#if H5_SIZEOF_INT == 4
+#define H5T_VEC_KIND_INT        H5T_VEC_S32
+#define H5T_VEC_KIND_UINT       H5T_VEC_U32
+#else
+#define H5T_VEC_KIND_INT        H5T_VEC_NONE
+#define H5T_VEC_KIND_UINT       H5T_VEC_NONE
+#endif
+#if H5_SIZEOF_LONG == 4
+#define H5T_VEC_KIND_LONG       H5T_VEC_S32
+#define H5T_VEC_KIND_ULONG      H5T_VEC_U32
+#elif H5_SIZEOF_LONG == 8
+#define H5T_VEC_KIND_LONG       H5T_VEC_S64
+#define H5T_VEC_KIND_ULONG      H5T_VEC_U64
+#else
+#define H5T_VEC_KIND_LONG       H5T_VEC_NONE
+#define H5T_VEC_KIND_ULONG      H5T_VEC_NONE
+#endif
+#if H5_SIZEOF_LONG_LONG == 8
+#define H5T_VEC_KIND_LLONG      H5T_VEC_S64
+#define H5T_VEC_KIND_ULLONG     H5T_VEC_U64
+#else
+#define H5T_VEC_KIND_LLONG      H5T_VEC_NONE
+#define H5T_VEC_KIND_ULLONG     H5T_VEC_NONE
+#endif
+#define H5T_VEC_KIND_FLOAT      H5T_VEC_F32
+#define H5T_VEC_KIND_DOUBLE     H5T_VEC_F64
+#define H5T_VEC_KIND_LDOUBLE    H5T_VEC_NONE
+
+/* Combine the kinds of a source and destination type */
+#define H5T_VEC_PAIR(S, D)      (((unsigned)(S) << 4) | (unsigned)(D))
+
 /*
  * These macros are for the bodies of functions that convert buffers of one
  * atomic type to another using hardware.
@@ -770,6 +842,11 @@
                 safe=nelmts;						      \
             } /* end else */						      \
                                                                               \
+            /* Convert what the vector kernels can, when the elements are */ \
+            /* packed and there's no exception callback to call */	      \
+            elmtno = 0;							      \
+            H5T_CONV_VEC_PREPASS(STYPE, DTYPE, ST, DT)			      \
+                                                                              \
             /* Perform loop over elements to convert */			      \
             if (s_mv && d_mv) {						      \
                 /* Alignment is required for both source and dest */	      \
@@ -802,6 +879,22 @@ done:                                                                         \
     FUNC_LEAVE_NOAPI(ret_value)                                               \
 }
 
+/* Run the packed elements of a pass through the vector kernels first.  The
+ * kinds are compile-time constants, so this disappears for other types. */
+#ifdef H5T_CONV_VEC
+#define H5T_CONV_VEC_PREPASS(STYPE, DTYPE, ST, DT)                            \
+    if(H5_GLUE(H5T_VEC_KIND_, STYPE) != H5T_VEC_NONE &&                       \
+            H5_GLUE(H5T_VEC_KIND_, DTYPE) != H5T_VEC_NONE && !cb_struct.func  \
+            && s_stride == (ssize_t)sizeof(ST) && d_stride == (ssize_t)sizeof(DT)) { \
+        elmtno = H5T_conv_vec(H5T_VEC_PAIR(H5_GLUE(H5T_VEC_KIND_, STYPE),     \
+                H5_GLUE(H5T_VEC_KIND_, DTYPE)), safe, src_buf, dst_buf);      \
+        src = (ST *)(src_buf += elmtno * sizeof(ST));                         \
+        dst = (DT *)(dst_buf += elmtno * sizeof(DT));                         \
+    }
+#else /* H5T_CONV_VEC */
+#define H5T_CONV_VEC_PREPASS(STYPE, DTYPE, ST, DT) /* void */
+#endif /* H5T_CONV_VEC */
+
 /* Declare the source & destination precision variables */
 #define H5T_CONV_DECL_PREC(PREC) H5_GLUE(H5T_CONV_DECL_PREC_, PREC)
 
@@ -876,9 +969,10 @@ done:                                                                         \
         H5T_CONV_LOOP(PRE_SALIGN_GUTS,PRE_DALIGN_GUTS,POST_SALIGN_GUTS,POST_DALIGN_GUTS,H5_GLUE(GUTS,_NOEX),STYPE,DTYPE,S,D,ST,DT,D_MIN,D_MAX) \
     }
 
-/* The inner loop of the type conversion macro, actually converting the elements */
+/* The inner loop of the type conversion macro, actually converting the
+ * elements from ELMTNO on */
 #define H5T_CONV_LOOP(PRE_SALIGN_GUTS,PRE_DALIGN_GUTS,POST_SALIGN_GUTS,POST_DALIGN_GUTS,GUTS,STYPE,DTYPE,S,D,ST,DT,D_MIN,D_MAX) \
-    for (elmtno=0; elmtno<safe; elmtno++) {				      \
+    for (; elmtno<safe; elmtno++) {					      \
         /* Handle source pre-alignment */				      \
         H5_GLUE(H5T_CONV_LOOP_,PRE_SALIGN_GUTS)(ST)			      \
                                                                               \
@@ -965,6 +1059,14 @@ done:                                                                         \
 /* Local Typedefs */
 /******************/
 
+/* One run of bytes copied unchanged from a source compound element to a
+ * destination compound element */
+typedef struct H5T_conv_struct_run_t {
+    size_t      src_off;        /*offset of run in source element    */
+    size_t      dst_off;        /*offset of run in destination elmt  */
+    size_t      len;            /*number of bytes in run             */
+} H5T_conv_struct_run_t;
+
 /* Conversion data for H5T__conv_struct() */
 typedef struct H5T_conv_struct_t {
     int	*src2dst;		/*mapping from src to dst member num */
@@ -973,6 +1075,8 @@ typedef struct H5T_conv_struct_t {
     H5T_path_t	**memb_path;		/*conversion path for each member    */
     H5T_subset_info_t   subset_info;    /*info related to compound subsets   */
     unsigned            src_nmembs;     /*needed by free function            */
+    H5T_conv_struct_run_t *runs;        /*copy plan, NULL if members convert */
+    size_t              nruns;          /*number of runs in copy plan        */
 } H5T_conv_struct_t;
 
 /* Conversion data for H5T__conv_enum() */
@@ -998,6 +1102,16 @@ typedef struct H5T_conv_hw_t {
 /********************/
 
 static herr_t H5T_reverse_order(uint8_t *rev, uint8_t *s, size_t size, H5T_order_t order);
+#ifdef H5T_CONV_VEC
+static size_t H5T_conv_vec(unsigned pair, size_t nelmts, const uint8_t *src,
+    uint8_t *dst);
+static size_t H5T_conv_vec_sse2(unsigned pair, size_t nelmts, const uint8_t *src,
+    uint8_t *dst);
+#ifdef H5T_CONV_VEC_AVX2
+__attribute__((target("avx2"))) static size_t H5T_conv_vec_avx2(unsigned pair,
+    size_t nelmts, const uint8_t *src, uint8_t *dst);
+#endif /* H5T_CONV_VEC_AVX2 */
+#endif /* H5T_CONV_VEC */
 
 
 /*********************/
@@ -1025,6 +1139,504 @@ H5FL_BLK_DEFINE_STATIC(vlen_seq);
 /* Declare a free list to manage pieces of array data */
 H5FL_BLK_DEFINE_STATIC(array_seq);
 
+#ifdef H5T_CONV_VEC
+
+/*
+ * Vector kernels for the hardware conversions.  Each kernel converts blocks
+ * of 8 elements; a whole block is loaded before any of it is stored, so the
+ * kernels work in place as long as the destination elements don't start
+ * after their source elements, which is how H5T_CONV walks the buffer.
+ *
+ * An integer block is widened to 32-bit lanes (two SSE2 registers LO and HI,
+ * or one AVX2 register V) and then narrowed, widened or converted to floating
+ * point for the destination.  With H5_WANT_DCONV_EXCEPTION the results are
+ * clamped to the destination's range, like the "no exception" cores of the
+ * scalar conversions; otherwise they are truncated like C casts.
+ */
+
+/* Size of each kind of element */
+#define H5T_VEC_SIZE_S8         1
+#define H5T_VEC_SIZE_U8         1
+#define H5T_VEC_SIZE_S16        2
+#define H5T_VEC_SIZE_U16        2
+#define H5T_VEC_SIZE_S32        4
+#define H5T_VEC_SIZE_U32        4
+#define H5T_VEC_SIZE_S64        8
+#define H5T_VEC_SIZE_U64        8
+#define H5T_VEC_SIZE_F32        4
+#define H5T_VEC_SIZE_F64        8
+
+/* The conversions with vector kernels, as (source kind, loader, destination
+ * kind, storer).  Unsigned 32-bit sources don't fit in signed 32-bit lanes,
+ * so they are saturated first for the narrower destinations (U32S) and have
+ * their own storers for the wider ones.
+ */
+#define H5T_VEC_INT_CASES(CASE, S, LOAD)                                      \
+    CASE(S, LOAD, S64, S64) CASE(S, LOAD, U64, U64)                           \
+    CASE(S, LOAD, F32, F32) CASE(S, LOAD, F64, F64)
+#define H5T_VEC_CASES(CASE)                                                   \
+    CASE(S8, S8, U8, U8) CASE(S8, S8, S16, S16) CASE(S8, S8, U16, U16)        \
+    CASE(S8, S8, S32, S32) CASE(S8, S8, U32, U32)                             \
+    H5T_VEC_INT_CASES(CASE, S8, S8)                                           \
+    CASE(U8, U8, S8, S8) CASE(U8, U8, S16, S16) CASE(U8, U8, U16, U16)        \
+    CASE(U8, U8, S32, S32) CASE(U8, U8, U32, U32)                             \
+    H5T_VEC_INT_CASES(CASE, U8, U8)                                           \
+    CASE(S16, S16, S8, S8) CASE(S16, S16, U8, U8) CASE(S16, S16, U16, U16)    \
+    CASE(S16, S16, S32, S32) CASE(S16, S16, U32, U32)                         \
+    H5T_VEC_INT_CASES(CASE, S16, S16)                                         \
+    CASE(U16, U16, S8, S8) CASE(U16, U16, U8, U8) CASE(U16, U16, S16, S16)    \
+    CASE(U16, U16, S32, S32) CASE(U16, U16, U32, U32)                         \
+    H5T_VEC_INT_CASES(CASE, U16, U16)                                         \
+    CASE(S32, S32, S8, S8) CASE(S32, S32, U8, U8) CASE(S32, S32, S16, S16)    \
+    CASE(S32, S32, U16, U16) CASE(S32, S32, U32, U32)                         \
+    H5T_VEC_INT_CASES(CASE, S32, S32)                                         \
+    CASE(U32, U32S, S8, S8) CASE(U32, U32S, U8, U8)                           \
+    CASE(U32, U32S, S16, S16) CASE(U32, U32S, U16, U16)                       \
+    CASE(U32, U32S, S32, S32)                                                 \
+    CASE(U32, RAW, S64, UX64) CASE(U32, RAW, U64, UX64)                       \
+    CASE(U32, RAW, F32, UF32) CASE(U32, RAW, F64, UF64)                       \
+    CASE(F32, RAW, F64, DF64)
+
+/* SSE2 loaders: 8 elements at P into the 32-bit lanes of LO and HI */
+#define H5T_VEC_SSE2_LOAD_S8(P, LO, HI) {                                     \
+    __m128i _x = _mm_loadl_epi64((const __m128i *)(P));                       \
+                                                                              \
+    _x = _mm_srai_epi16(_mm_unpacklo_epi8(_x, _x), 8);                        \
+    LO = _mm_srai_epi32(_mm_unpacklo_epi16(_x, _x), 16);                      \
+    HI = _mm_srai_epi32(_mm_unpackhi_epi16(_x, _x), 16);                      \
+}
+#define H5T_VEC_SSE2_LOAD_U8(P, LO, HI) {                                     \
+    __m128i _x = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(P)),     \
+            _mm_setzero_si128());                                             \
+                                                                              \
+    LO = _mm_unpacklo_epi16(_x, _mm_setzero_si128());                         \
+    HI = _mm_unpackhi_epi16(_x, _mm_setzero_si128());                         \
+}
+#define H5T_VEC_SSE2_LOAD_S16(P, LO, HI) {                                    \
+    __m128i _x = _mm_loadu_si128((const __m128i *)(P));                       \
+                                                                              \
+    LO = _mm_srai_epi32(_mm_unpacklo_epi16(_x, _x), 16);                      \
+    HI = _mm_srai_epi32(_mm_unpackhi_epi16(_x, _x), 16);                      \
+}
+#define H5T_VEC_SSE2_LOAD_U16(P, LO, HI) {                                    \
+    __m128i _x = _mm_loadu_si128((const __m128i *)(P));                       \
+                                                                              \
+    LO = _mm_unpacklo_epi16(_x, _mm_setzero_si128());                         \
+    HI = _mm_unpackhi_epi16(_x, _mm_setzero_si128());                         \
+}
+#define H5T_VEC_SSE2_LOAD_RAW(P, LO, HI) {                                    \
+    LO = _mm_loadu_si128((const __m128i *)(P));                               \
+    HI = _mm_loadu_si128((const __m128i *)(P) + 1);                           \
+}
+#define H5T_VEC_SSE2_LOAD_S32(P, LO, HI) H5T_VEC_SSE2_LOAD_RAW(P, LO, HI)
+
+/* Replace the negative lanes of V with zero */
+#define H5T_VEC_SSE2_MAX0(V) _mm_andnot_si128(_mm_srai_epi32(V, 31), V)
+
+#ifdef H5_WANT_DCONV_EXCEPTION
+/* Unsigned lanes above INT_MAX become INT_MAX */
+#define H5T_VEC_SSE2_SATU(V)                                                  \
+    _mm_or_si128(H5T_VEC_SSE2_MAX0(V), _mm_and_si128(_mm_srai_epi32(V, 31),   \
+            _mm_set1_epi32(0x7fffffff)))
+#define H5T_VEC_SSE2_LOAD_U32S(P, LO, HI) {                                   \
+    H5T_VEC_SSE2_LOAD_RAW(P, LO, HI)                                          \
+    LO = H5T_VEC_SSE2_SATU(LO);                                               \
+    HI = H5T_VEC_SSE2_SATU(HI);                                               \
+}
+
+/* SSE2 storers: the 32-bit lanes of LO and HI to 8 elements at P */
+#define H5T_VEC_SSE2_STORE_S8(P, LO, HI) {                                    \
+    __m128i _p = _mm_packs_epi32(LO, HI);                                     \
+                                                                              \
+    _mm_storel_epi64((__m128i *)(P), _mm_packs_epi16(_p, _p));                \
+}
+#define H5T_VEC_SSE2_STORE_U8(P, LO, HI) {                                    \
+    __m128i _p = _mm_packs_epi32(LO, HI);                                     \
+                                                                              \
+    _mm_storel_epi64((__m128i *)(P), _mm_packus_epi16(_p, _p));               \
+}
+#define H5T_VEC_SSE2_STORE_S16(P, LO, HI)                                     \
+    _mm_storeu_si128((__m128i *)(P), _mm_packs_epi32(LO, HI));
+#define H5T_VEC_SSE2_STORE_U16(P, LO, HI) {                                   \
+    /* Bias into the signed range so the signed pack saturates correctly */  \
+    __m128i _b = _mm_set1_epi32(32768);                                       \
+                                                                              \
+    _mm_storeu_si128((__m128i *)(P), _mm_xor_si128(_mm_set1_epi16(-32768),    \
+            _mm_packs_epi32(_mm_sub_epi32(H5T_VEC_SSE2_MAX0(LO), _b),         \
+                    _mm_sub_epi32(H5T_VEC_SSE2_MAX0(HI), _b))));              \
+}
+#define H5T_VEC_SSE2_STORE_U32(P, LO, HI) {                                   \
+    _mm_storeu_si128((__m128i *)(P), H5T_VEC_SSE2_MAX0(LO));                  \
+    _mm_storeu_si128((__m128i *)(P) + 1, H5T_VEC_SSE2_MAX0(HI));              \
+}
+#define H5T_VEC_SSE2_STORE_U64(P, LO, HI) {                                   \
+    __m128i _lo = H5T_VEC_SSE2_MAX0(LO), _hi = H5T_VEC_SSE2_MAX0(HI);        \
+                                                                              \
+    H5T_VEC_SSE2_STORE_S64(P, _lo, _hi)                                       \
+}
+#else /* H5_WANT_DCONV_EXCEPTION */
+#define H5T_VEC_SSE2_LOAD_U32S(P, LO, HI) H5T_VEC_SSE2_LOAD_RAW(P, LO, HI)
+
+/* Keep the low 8 or 16 bits of each lane, as a C cast would */
+#define H5T_VEC_SSE2_TRUNC8(V) _mm_and_si128(V, _mm_set1_epi32(0xff))
+#define H5T_VEC_SSE2_TRUNC16(V) _mm_srai_epi32(_mm_slli_epi32(V, 16), 16)
+
+/* SSE2 storers: the 32-bit lanes of LO and HI to 8 elements at P */
+#define H5T_VEC_SSE2_STORE_S8(P, LO, HI) {                                    \
+    __m128i _p = _mm_packs_epi32(H5T_VEC_SSE2_TRUNC8(LO),                     \
+            H5T_VEC_SSE2_TRUNC8(HI));                                         \
+                                                                              \
+    _mm_storel_epi64((__m128i *)(P), _mm_packus_epi16(_p, _p));               \
+}
+#define H5T_VEC_SSE2_STORE_U8(P, LO, HI) H5T_VEC_SSE2_STORE_S8(P, LO, HI)
+#define H5T_VEC_SSE2_STORE_S16(P, LO, HI)                                     \
+    _mm_storeu_si128((__m128i *)(P), _mm_packs_epi32(                         \
+            H5T_VEC_SSE2_TRUNC16(LO), H5T_VEC_SSE2_TRUNC16(HI)));
+#define H5T_VEC_SSE2_STORE_U16(P, LO, HI) H5T_VEC_SSE2_STORE_S16(P, LO, HI)
+#define H5T_VEC_SSE2_STORE_U32(P, LO, HI) H5T_VEC_SSE2_STORE_S32(P, LO, HI)
+#define H5T_VEC_SSE2_STORE_U64(P, LO, HI) H5T_VEC_SSE2_STORE_S64(P, LO, HI)
+#endif /* H5_WANT_DCONV_EXCEPTION */
+
+#define H5T_VEC_SSE2_STORE_S32(P, LO, HI) {                                   \
+    _mm_storeu_si128((__m128i *)(P), LO);                                     \
+    _mm_storeu_si128((__m128i *)(P) + 1, HI);                                 \
+}
+#define H5T_VEC_SSE2_STORE_S64(P, LO, HI) {                                   \
+    _mm_storeu_si128((__m128i *)(P), _mm_unpacklo_epi32(LO, _mm_srai_epi32(LO, 31))); \
+    _mm_storeu_si128((__m128i *)(P) + 1, _mm_unpackhi_epi32(LO, _mm_srai_epi32(LO, 31))); \
+    _mm_storeu_si128((__m128i *)(P) + 2, _mm_unpacklo_epi32(HI, _mm_srai_epi32(HI, 31))); \
+    _mm_storeu_si128((__m128i *)(P) + 3, _mm_unpackhi_epi32(HI, _mm_srai_epi32(HI, 31))); \
+}
+#define H5T_VEC_SSE2_STORE_F32(P, LO, HI) {                                   \
+    _mm_storeu_ps((float *)(P), _mm_cvtepi32_ps(LO));                         \
+    _mm_storeu_ps((float *)(P) + 4, _mm_cvtepi32_ps(HI));                     \
+}
+#define H5T_VEC_SSE2_STORE_F64(P, LO, HI) {                                   \
+    _mm_storeu_pd((double *)(P), _mm_cvtepi32_pd(LO));                        \
+    _mm_storeu_pd((double *)(P) + 2, _mm_cvtepi32_pd(_mm_srli_si128(LO, 8))); \
+    _mm_storeu_pd((double *)(P) + 4, _mm_cvtepi32_pd(HI));                    \
+    _mm_storeu_pd((double *)(P) + 6, _mm_cvtepi32_pd(_mm_srli_si128(HI, 8))); \
+}
+
+/* Unsigned 32-bit lanes to 64-bit integers */
+#define H5T_VEC_SSE2_STORE_UX64(P, LO, HI) {                                  \
+    _mm_storeu_si128((__m128i *)(P), _mm_unpacklo_epi32(LO, _mm_setzero_si128())); \
+    _mm_storeu_si128((__m128i *)(P) + 1, _mm_unpackhi_epi32(LO, _mm_setzero_si128())); \
+    _mm_storeu_si128((__m128i *)(P) + 2, _mm_unpacklo_epi32(HI, _mm_setzero_si128())); \
+    _mm_storeu_si128((__m128i *)(P) + 3, _mm_unpackhi_epi32(HI, _mm_setzero_si128())); \
+}
+
+/* Unsigned 32-bit lanes to doubles: flip the sign bit, convert as signed and
+ * add 2^31 back, which is exact in double precision */
+#define H5T_VEC_SSE2_UF64(V, D0, D1) {                                        \
+    __m128i _t = _mm_xor_si128(V, _mm_set1_epi32((int)0x80000000));           \
+                                                                              \
+    D0 = _mm_add_pd(_mm_cvtepi32_pd(_t), _mm_set1_pd(2147483648.0));          \
+    D1 = _mm_add_pd(_mm_cvtepi32_pd(_mm_srli_si128(_t, 8)),                   \
+            _mm_set1_pd(2147483648.0));                                       \
+}
+#define H5T_VEC_SSE2_STORE_UF64(P, LO, HI) {                                  \
+    __m128d _d0, _d1, _d2, _d3;                                               \
+                                                                              \
+    H5T_VEC_SSE2_UF64(LO, _d0, _d1)                                           \
+    H5T_VEC_SSE2_UF64(HI, _d2, _d3)                                           \
+    _mm_storeu_pd((double *)(P), _d0);                                        \
+    _mm_storeu_pd((double *)(P) + 2, _d1);                                    \
+    _mm_storeu_pd((double *)(P) + 4, _d2);                                    \
+    _mm_storeu_pd((double *)(P) + 6, _d3);                                    \
+}
+
+/* Unsigned 32-bit lanes to floats, rounding once from the exact doubles */
+#define H5T_VEC_SSE2_STORE_UF32(P, LO, HI) {                                  \
+    __m128d _d0, _d1, _d2, _d3;                                               \
+                                                                              \
+    H5T_VEC_SSE2_UF64(LO, _d0, _d1)                                           \
+    H5T_VEC_SSE2_UF64(HI, _d2, _d3)                                           \
+    _mm_storeu_ps((float *)(P), _mm_movelh_ps(_mm_cvtpd_ps(_d0), _mm_cvtpd_ps(_d1))); \
+    _mm_storeu_ps((float *)(P) + 4, _mm_movelh_ps(_mm_cvtpd_ps(_d2), _mm_cvtpd_ps(_d3))); \
+}
+
+/* Float lanes to doubles */
+#define H5T_VEC_SSE2_STORE_DF64(P, LO, HI) {                                  \
+    __m128 _lo = _mm_castsi128_ps(LO), _hi = _mm_castsi128_ps(HI);            \
+                                                                              \
+    _mm_storeu_pd((double *)(P), _mm_cvtps_pd(_lo));                          \
+    _mm_storeu_pd((double *)(P) + 2, _mm_cvtps_pd(_mm_movehl_ps(_lo, _lo)));  \
+    _mm_storeu_pd((double *)(P) + 4, _mm_cvtps_pd(_hi));                      \
+    _mm_storeu_pd((double *)(P) + 6, _mm_cvtps_pd(_mm_movehl_ps(_hi, _hi)));  \
+}
+
+/* Doubles to floats, with values out of a float's range becoming infinity */
+#ifdef H5_WANT_DCONV_EXCEPTION
+#define H5T_VEC_SSE2_CLAMP_F64(X) {                                           \
+    __m128d _gt = _mm_cmpgt_pd(X, _mm_set1_pd((double)FLT_MAX));              \
+    __m128d _lt = _mm_cmplt_pd(X, _mm_set1_pd(-(double)FLT_MAX));             \
+                                                                              \
+    X = _mm_or_pd(_mm_andnot_pd(_mm_or_pd(_gt, _lt), X), _mm_or_pd(           \
+            _mm_and_pd(_gt, _mm_set1_pd((double)H5T_NATIVE_FLOAT_POS_INF_g)), \
+            _mm_and_pd(_lt, _mm_set1_pd((double)H5T_NATIVE_FLOAT_NEG_INF_g)))); \
+}
+#else /* H5_WANT_DCONV_EXCEPTION */
+#define H5T_VEC_SSE2_CLAMP_F64(X) /* void */
+#endif /* H5_WANT_DCONV_EXCEPTION */
+
+#define H5T_VEC_SSE2_CASE(S, LOAD, D, STORE)                                  \
+    case H5T_VEC_PAIR(H5T_VEC_##S, H5T_VEC_##D):                              \
+        for(; u + 8 <= nelmts; u += 8) {                                      \
+            __m128i lo, hi;                                                   \
+                                                                              \
+            H5T_VEC_SSE2_LOAD_##LOAD(src + u * H5T_VEC_SIZE_##S, lo, hi)      \
+            H5T_VEC_SSE2_STORE_##STORE(dst + u * H5T_VEC_SIZE_##D, lo, hi)    \
+        } /* end for */                                                       \
+        break;
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_conv_vec_sse2
+ *
+ * Purpose:	Convert the leading elements of a packed buffer from one
+ *              native type to another with SSE2, 8 elements at a time.
+ *
+ * Return:	Number of elements converted (a multiple of 8, possibly 0,
+ *              which it is for the pairs without a kernel).  The caller
+ *              converts the remaining elements.
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T_conv_vec_sse2(unsigned pair, size_t nelmts, const uint8_t *src, uint8_t *dst)
+{
+    size_t u = 0;               /* Number of elements converted */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    switch(pair) {
+        H5T_VEC_CASES(H5T_VEC_SSE2_CASE)
+
+        case H5T_VEC_PAIR(H5T_VEC_F64, H5T_VEC_F32):
+            for(; u + 8 <= nelmts; u += 8) {
+                const double *s = (const double *)(src + u * sizeof(double));
+                float *d = (float *)(dst + u * sizeof(float));
+                __m128d x0 = _mm_loadu_pd(s), x1 = _mm_loadu_pd(s + 2);
+                __m128d x2 = _mm_loadu_pd(s + 4), x3 = _mm_loadu_pd(s + 6);
+
+                H5T_VEC_SSE2_CLAMP_F64(x0)
+                H5T_VEC_SSE2_CLAMP_F64(x1)
+                H5T_VEC_SSE2_CLAMP_F64(x2)
+                H5T_VEC_SSE2_CLAMP_F64(x3)
+                _mm_storeu_ps(d, _mm_movelh_ps(_mm_cvtpd_ps(x0), _mm_cvtpd_ps(x1)));
+                _mm_storeu_ps(d + 4, _mm_movelh_ps(_mm_cvtpd_ps(x2), _mm_cvtpd_ps(x3)));
+            } /* end for */
+            break;
+
+        default:
+            break;
+    } /* end switch */
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5T_conv_vec_sse2() */
+
+#ifdef H5T_CONV_VEC_AVX2
+
+/* AVX2 loaders: 8 elements at P into the 32-bit lanes of V */
+#define H5T_VEC_AVX2_LOAD_S8(P, V)                                            \
+    V = _mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i *)(P)));
+#define H5T_VEC_AVX2_LOAD_U8(P, V)                                            \
+    V = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(P)));
+#define H5T_VEC_AVX2_LOAD_S16(P, V)                                           \
+    V = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(P)));
+#define H5T_VEC_AVX2_LOAD_U16(P, V)                                           \
+    V = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(P)));
+#define H5T_VEC_AVX2_LOAD_RAW(P, V)                                           \
+    V = _mm256_loadu_si256((const __m256i *)(P));
+#define H5T_VEC_AVX2_LOAD_S32(P, V) H5T_VEC_AVX2_LOAD_RAW(P, V)
+#ifdef H5_WANT_DCONV_EXCEPTION
+#define H5T_VEC_AVX2_LOAD_U32S(P, V)                                          \
+    V = _mm256_min_epu32(_mm256_loadu_si256((const __m256i *)(P)),            \
+            _mm256_set1_epi32(0x7fffffff));
+#define H5T_VEC_AVX2_MAX0(V) _mm256_max_epi32(V, _mm256_setzero_si256())
+#else /* H5_WANT_DCONV_EXCEPTION */
+#define H5T_VEC_AVX2_LOAD_U32S(P, V) H5T_VEC_AVX2_LOAD_RAW(P, V)
+#define H5T_VEC_AVX2_MAX0(V) (V)
+#endif /* H5_WANT_DCONV_EXCEPTION */
+
+/* AVX2 storers: the 32-bit lanes of V to 8 elements at P.  The narrowing
+ * ones split V and use the SSE2 storers. */
+#define H5T_VEC_AVX2_SPLIT(STORE, P, V) {                                     \
+    __m128i _lo = _mm256_castsi256_si128(V);                                  \
+    __m128i _hi = _mm256_extracti128_si256(V, 1);                             \
+                                                                              \
+    H5T_VEC_SSE2_STORE_##STORE(P, _lo, _hi)                                   \
+}
+#define H5T_VEC_AVX2_STORE_S8(P, V) H5T_VEC_AVX2_SPLIT(S8, P, V)
+#define H5T_VEC_AVX2_STORE_U8(P, V) H5T_VEC_AVX2_SPLIT(U8, P, V)
+#define H5T_VEC_AVX2_STORE_S16(P, V) H5T_VEC_AVX2_SPLIT(S16, P, V)
+#define H5T_VEC_AVX2_STORE_U16(P, V) H5T_VEC_AVX2_SPLIT(U16, P, V)
+#define H5T_VEC_AVX2_STORE_S32(P, V)                                          \
+    _mm256_storeu_si256((__m256i *)(P), V);
+#define H5T_VEC_AVX2_STORE_U32(P, V)                                          \
+    _mm256_storeu_si256((__m256i *)(P), H5T_VEC_AVX2_MAX0(V));
+#define H5T_VEC_AVX2_STORE_S64(P, V) {                                        \
+    _mm256_storeu_si256((__m256i *)(P),                                       \
+            _mm256_cvtepi32_epi64(_mm256_castsi256_si128(V)));                \
+    _mm256_storeu_si256((__m256i *)(P) + 1,                                   \
+            _mm256_cvtepi32_epi64(_mm256_extracti128_si256(V, 1)));           \
+}
+#define H5T_VEC_AVX2_STORE_U64(P, V) {                                        \
+    __m256i _v = H5T_VEC_AVX2_MAX0(V);                                        \
+                                                                              \
+    H5T_VEC_AVX2_STORE_S64(P, _v)                                             \
+}
+#define H5T_VEC_AVX2_STORE_F32(P, V)                                          \
+    _mm256_storeu_ps((float *)(P), _mm256_cvtepi32_ps(V));
+#define H5T_VEC_AVX2_STORE_F64(P, V) {                                        \
+    _mm256_storeu_pd((double *)(P),                                           \
+            _mm256_cvtepi32_pd(_mm256_castsi256_si128(V)));                   \
+    _mm256_storeu_pd((double *)(P) + 4,                                       \
+            _mm256_cvtepi32_pd(_mm256_extracti128_si256(V, 1)));              \
+}
+#define H5T_VEC_AVX2_STORE_UX64(P, V) {                                       \
+    _mm256_storeu_si256((__m256i *)(P),                                       \
+            _mm256_cvtepu32_epi64(_mm256_castsi256_si128(V)));                \
+    _mm256_storeu_si256((__m256i *)(P) + 1,                                   \
+            _mm256_cvtepu32_epi64(_mm256_extracti128_si256(V, 1)));           \
+}
+#define H5T_VEC_AVX2_UF64(V, D0, D1) {                                        \
+    __m256i _t = _mm256_xor_si256(V, _mm256_set1_epi32((int)0x80000000));     \
+                                                                              \
+    D0 = _mm256_add_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(_t)),        \
+            _mm256_set1_pd(2147483648.0));                                    \
+    D1 = _mm256_add_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(_t, 1)),   \
+            _mm256_set1_pd(2147483648.0));                                    \
+}
+#define H5T_VEC_AVX2_STORE_UF64(P, V) {                                       \
+    __m256d _d0, _d1;                                                         \
+                                                                              \
+    H5T_VEC_AVX2_UF64(V, _d0, _d1)                                            \
+    _mm256_storeu_pd((double *)(P), _d0);                                     \
+    _mm256_storeu_pd((double *)(P) + 4, _d1);                                 \
+}
+#define H5T_VEC_AVX2_STORE_UF32(P, V) {                                       \
+    __m256d _d0, _d1;                                                         \
+                                                                              \
+    H5T_VEC_AVX2_UF64(V, _d0, _d1)                                            \
+    _mm_storeu_ps((float *)(P), _mm256_cvtpd_ps(_d0));                        \
+    _mm_storeu_ps((float *)(P) + 4, _mm256_cvtpd_ps(_d1));                    \
+}
+#define H5T_VEC_AVX2_STORE_DF64(P, V) {                                       \
+    __m256 _f = _mm256_castsi256_ps(V);                                       \
+                                                                              \
+    _mm256_storeu_pd((double *)(P), _mm256_cvtps_pd(_mm256_castps256_ps128(_f))); \
+    _mm256_storeu_pd((double *)(P) + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(_f, 1))); \
+}
+#ifdef H5_WANT_DCONV_EXCEPTION
+#define H5T_VEC_AVX2_CLAMP_F64(X) {                                           \
+    X = _mm256_blendv_pd(X, _mm256_set1_pd((double)H5T_NATIVE_FLOAT_POS_INF_g), \
+            _mm256_cmp_pd(X, _mm256_set1_pd((double)FLT_MAX), _CMP_GT_OQ));   \
+    X = _mm256_blendv_pd(X, _mm256_set1_pd((double)H5T_NATIVE_FLOAT_NEG_INF_g), \
+            _mm256_cmp_pd(X, _mm256_set1_pd(-(double)FLT_MAX), _CMP_LT_OQ));  \
+}
+#else /* H5_WANT_DCONV_EXCEPTION */
+#define H5T_VEC_AVX2_CLAMP_F64(X) /* void */
+#endif /* H5_WANT_DCONV_EXCEPTION */
+
+#define H5T_VEC_AVX2_CASE(S, LOAD, D, STORE)                                  \
+    case H5T_VEC_PAIR(H5T_VEC_##S, H5T_VEC_##D):                              \
+        for(; u + 8 <= nelmts; u += 8) {                                      \
+            __m256i v;                                                        \
+                                                                              \
+            H5T_VEC_AVX2_LOAD_##LOAD(src + u * H5T_VEC_SIZE_##S, v)           \
+            H5T_VEC_AVX2_STORE_##STORE(dst + u * H5T_VEC_SIZE_##D, v)         \
+        } /* end for */                                                       \
+        break;
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_conv_vec_avx2
+ *
+ * Purpose:	AVX2 version of H5T_conv_vec_sse2.  Each block of 8
+ *              elements fits in one 256-bit register of 32-bit lanes.
+ *
+ * Return:	Number of elements converted (a multiple of 8, possibly 0).
+ *              The caller converts the remaining elements.
+ *
+ *-------------------------------------------------------------------------
+ */
+__attribute__((target("avx2"))) static size_t
+H5T_conv_vec_avx2(unsigned pair, size_t nelmts, const uint8_t *src, uint8_t *dst)
+{
+    size_t u = 0;               /* Number of elements converted */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    switch(pair) {
+        H5T_VEC_CASES(H5T_VEC_AVX2_CASE)
+
+        case H5T_VEC_PAIR(H5T_VEC_F64, H5T_VEC_F32):
+            for(; u + 8 <= nelmts; u += 8) {
+                const double *s = (const double *)(src + u * sizeof(double));
+                float *d = (float *)(dst + u * sizeof(float));
+                __m256d x0 = _mm256_loadu_pd(s), x1 = _mm256_loadu_pd(s + 4);
+
+                H5T_VEC_AVX2_CLAMP_F64(x0)
+                H5T_VEC_AVX2_CLAMP_F64(x1)
+                _mm_storeu_ps(d, _mm256_cvtpd_ps(x0));
+                _mm_storeu_ps(d + 4, _mm256_cvtpd_ps(x1));
+            } /* end for */
+            break;
+
+        default:
+            break;
+    } /* end switch */
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5T_conv_vec_avx2() */
+#endif /* H5T_CONV_VEC_AVX2 */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_conv_vec
+ *
+ * Purpose:	Convert the leading elements of a packed buffer of native
+ *              values with the vector kernels.  PAIR is the H5T_VEC_PAIR
+ *              of the source and destination kinds.  The AVX2 kernels are
+ *              used when the CPU supports them, the SSE2 ones otherwise.
+ *
+ * Return:	Number of elements converted.  The caller converts the
+ *              remaining elements with the scalar loop.
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T_conv_vec(unsigned pair, size_t nelmts, const uint8_t *src, uint8_t *dst)
+{
+#ifdef H5T_CONV_VEC_AVX2
+    static int have_avx2 = -1;  /* Whether the CPU supports AVX2 (-1 = unknown) */
+#endif /* H5T_CONV_VEC_AVX2 */
+    size_t ret_value = 0;       /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(src);
+    HDassert(dst);
+
+#ifdef H5T_CONV_VEC_AVX2
+    if(have_avx2 < 0) {
+        __builtin_cpu_init();
+        have_avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+    } /* end if */
+    if(have_avx2)
+        HGOTO_DONE(H5T_conv_vec_avx2(pair, nelmts, src, dst))
+#endif /* H5T_CONV_VEC_AVX2 */
+    ret_value = H5T_conv_vec_sse2(pair, nelmts, src, dst);
+
+#ifdef H5T_CONV_VEC_AVX2
+done:
+#endif /* H5T_CONV_VEC_AVX2 */
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T_conv_vec() */
+#endif /* H5T_CONV_VEC */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5T__conv_noop
@@ -1887,6 +2499,7 @@ H5T_conv_struct_free(H5T_conv_struct_t *priv)
     H5MM_xfree(src_memb_id);
     H5MM_xfree(dst_memb_id);
     H5MM_xfree(priv->memb_path);
+    H5MM_xfree(priv->runs);
 
     FUNC_LEAVE_NOAPI((H5T_conv_struct_t *)H5MM_xfree(priv))
 } /* end H5T_conv_struct_free() */
@@ -1938,6 +2551,14 @@ H5T_conv_struct_free(H5T_conv_struct_t *priv)
  *              The optimization is simply moving data to the appropriate
  *              places in the buffer.
  *
+ *              When no member needs converting (the destination members
+ *              are a subset or a reordering of the source members with the
+ *              same types) a copy plan is compiled: a list of byte runs
+ *              copied from the source element to the destination element,
+ *              with members that are adjacent in both types merged into a
+ *              single run.  If the runs cover the whole destination
+ *              element then no background buffer is needed.
+ *
  *-------------------------------------------------------------------------
  */
 static herr_t
@@ -2035,8 +2656,46 @@ H5T_conv_struct_init(H5T_t *src, H5T_t *dst, H5T_cdata_t *cdata, hid_t dxpl_id)
         } /* end if */
     } /* end for */
 
-    /* The compound conversion functions need a background buffer */
-    cdata->need_bkg = H5T_BKG_YES;
+    /*
+     * (Re)compile the copy plan.  Source members are sorted by offset, so
+     * a member continues the previous run when it follows it in both the
+     * source and the destination.
+     */
+    priv->runs = (H5T_conv_struct_run_t *)H5MM_xfree(priv->runs);
+    priv->nruns = 0;
+    for(i = 0; i < src_nmembs; i++)
+        if(src2dst[i] >= 0 && !priv->memb_path[i]->is_noop)
+            break;
+    if(i == src_nmembs && src_nmembs > 0) {
+        size_t covered = 0;     /* Bytes of destination written by the plan */
+
+        if(NULL == (priv->runs = (H5T_conv_struct_run_t *)H5MM_malloc(src_nmembs * sizeof(H5T_conv_struct_run_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+        for(i = 0; i < src_nmembs; i++)
+            if(src2dst[i] >= 0) {
+                const H5T_cmemb_t *src_memb = src->shared->u.compnd.memb + i;
+                const H5T_cmemb_t *dst_memb = dst->shared->u.compnd.memb + src2dst[i];
+                H5T_conv_struct_run_t *run = priv->nruns ? priv->runs + (priv->nruns - 1) : NULL;
+
+                if(run && run->src_off + run->len == src_memb->offset &&
+                        run->dst_off + run->len == dst_memb->offset)
+                    run->len += src_memb->size;
+                else {
+                    run = priv->runs + priv->nruns++;
+                    run->src_off = src_memb->offset;
+                    run->dst_off = dst_memb->offset;
+                    run->len = src_memb->size;
+                } /* end else */
+                covered += src_memb->size;
+            } /* end if */
+
+        /* Members never overlap, so the plan writes every byte of the
+         * destination when the run lengths add up to its size */
+        cdata->need_bkg = covered == dst->shared->size ? H5T_BKG_NO : H5T_BKG_YES;
+    } /* end if */
+    else
+        /* The compound conversion functions need a background buffer */
+        cdata->need_bkg = H5T_BKG_YES;
 
     if(src_nmembs < dst_nmembs) {
         priv->subset_info.subset = H5T_SUBSET_SRC;
@@ -2124,6 +2783,97 @@ H5T__conv_struct_subset(const H5T_cdata_t *cdata)
     FUNC_LEAVE_NOAPI((H5T_subset_info_t *) &priv->subset_info)
 } /* end H5T__conv_struct_subset() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_conv_struct_copy
+ *
+ * Purpose:	Converts between compound datatypes by executing the copy
+ *		plan compiled by H5T_conv_struct_init().  Each element's runs
+ *		are gathered into its slot in the background buffer, which
+ *		is then copied into BUF.  Without a background buffer (the
+ *		plan overwrites the whole destination element) each element
+ *		is gathered into a temporary element instead.
+ *
+ *		BUF_STRIDE and BKG_STRIDE have the same meaning as for the
+ *		conversion functions.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T_conv_struct_copy(const H5T_conv_struct_t *priv, size_t src_size,
+    size_t dst_size, size_t nelmts, size_t buf_stride, size_t bkg_stride,
+    uint8_t *buf, uint8_t *bkg)
+{
+    const H5T_conv_struct_run_t *runs = priv->runs;
+    size_t      nruns = priv->nruns;
+    uint8_t     *tmp = NULL;            /*temporary destination element */
+    size_t      elmtno;                 /*element counter               */
+    size_t      r;                      /*run counter                   */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(runs);
+
+    if(bkg) {
+        uint8_t *xbuf = buf, *xbkg = bkg;
+        size_t  src_delta = buf_stride ? buf_stride : src_size;
+
+        if(!buf_stride || !bkg_stride)
+            bkg_stride = dst_size;
+
+        /* Gather every element into the background buffer */
+        for(elmtno = 0; elmtno < nelmts; elmtno++) {
+            for(r = 0; r < nruns; r++)
+                HDmemcpy(xbkg + runs[r].dst_off, xbuf + runs[r].src_off, runs[r].len);
+            xbuf += src_delta;
+            xbkg += bkg_stride;
+        } /* end for */
+
+        /* Move background buffer into result buffer */
+        if(!buf_stride && bkg_stride == dst_size)
+            HDmemcpy(buf, bkg, nelmts * dst_size);
+        else
+            for(xbuf = buf, xbkg = bkg, elmtno = 0; elmtno < nelmts; elmtno++) {
+                HDmemmove(xbuf, xbkg, dst_size);
+                xbuf += buf_stride ? buf_stride : dst_size;
+                xbkg += bkg_stride;
+            } /* end for */
+    } /* end if */
+    else if(nelmts > 0) {
+        uint8_t *sp, *dp;               /*source and destination element*/
+        size_t  src_delta, dst_delta;   /*strides through buffer        */
+
+        if(NULL == (tmp = (uint8_t *)H5MM_malloc(dst_size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for temporary element")
+
+        /*
+         * A plan that covers the destination copies no more bytes than the
+         * source holds, so the elements stay in place or move left and
+         * element N is written only after element N has been read.
+         */
+        HDassert(dst_size <= src_size);
+        sp = dp = buf;
+        src_delta = buf_stride ? buf_stride : src_size;
+        dst_delta = buf_stride ? buf_stride : dst_size;
+
+        for(elmtno = 0; elmtno < nelmts; elmtno++) {
+            for(r = 0; r < nruns; r++)
+                HDmemcpy(tmp + runs[r].dst_off, sp + runs[r].src_off, runs[r].len);
+            HDmemcpy(dp, tmp, dst_size);
+            sp += src_delta;
+            dp += dst_delta;
+        } /* end for */
+    } /* end if */
+
+done:
+    if(tmp)
+        H5MM_xfree(tmp);
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T_conv_struct_copy() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5T__conv_struct
@@ -2207,11 +2957,19 @@ H5T__conv_struct(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts,
             if(NULL == (src = (H5T_t *)H5I_object(src_id)) || NULL == (dst = (H5T_t *)H5I_object(dst_id)))
                 HGOTO_ERROR(H5E_DATATYPE, H5E_BADTYPE, FAIL, "not a datatype")
             HDassert(priv);
-            HDassert(bkg && cdata->need_bkg);
 
             if(cdata->recalc && H5T_conv_struct_init(src, dst, cdata, dxpl_id) < 0)
                 HGOTO_ERROR(H5E_DATATYPE, H5E_CANTINIT, FAIL, "unable to initialize conversion data")
 
+            /* Members that only need copying are moved with the copy plan */
+            if(priv->runs) {
+                HDassert(bkg || !cdata->need_bkg);
+                if(H5T_conv_struct_copy(priv, src->shared->size, dst->shared->size, nelmts, buf_stride, bkg_stride, buf, bkg) < 0)
+                    HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCONVERT, FAIL, "unable to copy compound datatype members")
+                break;
+            } /* end if */
+            HDassert(bkg && cdata->need_bkg);
+
             /*
              * Insure that members are sorted.
              */
@@ -2403,6 +3161,10 @@ done:
  *              The optimization is simply moving data to the appropriate
  *              places in the buffer.
  *
+ *              The subset case above is now one case of the copy plan
+ *              used whenever no member needs converting; see
+ *              H5T_conv_struct_copy().
+ *
  *-------------------------------------------------------------------------
  */
 herr_t
@@ -2421,7 +3183,6 @@ H5T__conv_struct_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
     H5T_cmemb_t	*dst_memb = NULL;	/*destination struct memb desc.	*/
     size_t	offset;			/*byte offset wrt struct	*/
     size_t	elmtno;			/*element counter		*/
-    size_t      copy_size;              /*size of element for copying   */
     H5T_conv_struct_t *priv = NULL;	/*private data			*/
     hbool_t     no_stride = FALSE;      /*flag to indicate no stride    */
     unsigned	u;			/*counters			*/
@@ -2507,6 +3268,17 @@ H5T__conv_struct_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
             priv = (H5T_conv_struct_t *)(cdata->priv);
             HDassert(priv);
             src2dst = priv->src2dst;
+
+            /*
+             * Members that only need copying (which includes the subset
+             * cases) are moved with the copy plan.
+             */
+            if(priv->runs) {
+                HDassert(bkg || !cdata->need_bkg);
+                if(H5T_conv_struct_copy(priv, src->shared->size, dst->shared->size, nelmts, buf_stride, bkg_stride, buf, bkg) < 0)
+                    HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCONVERT, FAIL, "unable to copy compound datatype members")
+                break;
+            } /* end if */
             HDassert(bkg && cdata->need_bkg);
 
             /*
@@ -2532,88 +3304,70 @@ H5T__conv_struct_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
                 buf_stride = src->shared->size;
             } /* end if */
 
-            if(priv->subset_info.subset == H5T_SUBSET_SRC || priv->subset_info.subset == H5T_SUBSET_DST) {
-                /* If the optimization flag is set to indicate source members are a subset and
-                 * in the top of the destination, simply copy the source members to background buffer.
-                 */
-                xbuf = buf;
-                xbkg = bkg;
-                copy_size = priv->subset_info.copy_size;
-
-                for(elmtno = 0; elmtno < nelmts; elmtno++) {
-                    HDmemmove(xbkg, xbuf, copy_size);
-
-                    /* Update pointers */
-                    xbuf += buf_stride;
-                    xbkg += bkg_stride;
-                } /* end for */
-            } /* end if */
-            else {
-                /*
-                 * For each member where the destination is not larger than the
-                 * source, stride through all the elements converting only that member
-                 * in each element and then copying the element to its final
-                 * destination in the bkg buffer. Otherwise move the element as far
-                 * left as possible in the buffer.
-                 */
-                for(u = 0, offset = 0; u < src->shared->u.compnd.nmembs; u++) {
-                    if(src2dst[u] < 0)
-                        continue; /*subsetting*/
-                    src_memb = src->shared->u.compnd.memb + u;
-                    dst_memb = dst->shared->u.compnd.memb + src2dst[u];
-
-                    if(dst_memb->size <= src_memb->size) {
-                        xbuf = buf + src_memb->offset;
-                        xbkg = bkg + dst_memb->offset;
-                        if(H5T_convert(priv->memb_path[u], priv->src_memb_id[u],
-                                priv->dst_memb_id[src2dst[u]], nelmts,
-                                buf_stride, bkg_stride, xbuf, xbkg, dxpl_id) < 0)
-                            HGOTO_ERROR(H5E_DATATYPE, H5E_CANTINIT, FAIL, "unable to convert compound datatype member")
-                        for(elmtno = 0; elmtno < nelmts; elmtno++) {
-                            HDmemmove(xbkg, xbuf, dst_memb->size);
-                            xbuf += buf_stride;
-                            xbkg += bkg_stride;
-                        } /* end for */
-                    } /* end if */
-                    else {
-                        for(xbuf = buf, elmtno = 0; elmtno < nelmts; elmtno++) {
-                            HDmemmove(xbuf + offset, xbuf + src_memb->offset, src_memb->size);
-                            xbuf += buf_stride;
-                        } /* end for */
-                        offset += src_memb->size;
-                    } /* end else */
+            /*
+             * For each member where the destination is not larger than the
+             * source, stride through all the elements converting only that member
+             * in each element and then copying the element to its final
+             * destination in the bkg buffer. Otherwise move the element as far
+             * left as possible in the buffer.
+             */
+            for(u = 0, offset = 0; u < src->shared->u.compnd.nmembs; u++) {
+                if(src2dst[u] < 0)
+                    continue; /*subsetting*/
+                src_memb = src->shared->u.compnd.memb + u;
+                dst_memb = dst->shared->u.compnd.memb + src2dst[u];
+
+                if(dst_memb->size <= src_memb->size) {
+                    xbuf = buf + src_memb->offset;
+                    xbkg = bkg + dst_memb->offset;
+                    if(H5T_convert(priv->memb_path[u], priv->src_memb_id[u],
+                            priv->dst_memb_id[src2dst[u]], nelmts,
+                            buf_stride, bkg_stride, xbuf, xbkg, dxpl_id) < 0)
+                        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTINIT, FAIL, "unable to convert compound datatype member")
+                    for(elmtno = 0; elmtno < nelmts; elmtno++) {
+                        HDmemmove(xbkg, xbuf, dst_memb->size);
+                        xbuf += buf_stride;
+                        xbkg += bkg_stride;
+                    } /* end for */
+                } /* end if */
+                else {
+                    for(xbuf = buf, elmtno = 0; elmtno < nelmts; elmtno++) {
+                        HDmemmove(xbuf + offset, xbuf + src_memb->offset, src_memb->size);
+                        xbuf += buf_stride;
+                    } /* end for */
+                    offset += src_memb->size;
                 } /* end else */
-
-                /*
-                 * Work from right to left, converting those members that weren't
-                 * converted in the previous loop (those members where the destination
-                 * is larger than the source) and them to their final position in the
-                 * bkg buffer.
-                 */
-                H5_CHECK_OVERFLOW(src->shared->u.compnd.nmembs, size_t, int);
-                for(i = (int)src->shared->u.compnd.nmembs - 1; i >= 0; --i) {
-                    if(src2dst[i] < 0)
-                        continue;
-                    src_memb = src->shared->u.compnd.memb + i;
-                    dst_memb = dst->shared->u.compnd.memb + src2dst[i];
-
-                    if(dst_memb->size > src_memb->size) {
-                        offset -= src_memb->size;
-                        xbuf = buf + offset;
-                        xbkg = bkg + dst_memb->offset;
-                        if(H5T_convert(priv->memb_path[i], priv->src_memb_id[i],
-                                priv->dst_memb_id[src2dst[i]], nelmts,
-                                buf_stride, bkg_stride, xbuf, xbkg, dxpl_id) < 0)
-                            HGOTO_ERROR(H5E_DATATYPE, H5E_CANTINIT, FAIL, "unable to convert compound datatype member")
-                        for(elmtno = 0; elmtno < nelmts; elmtno++) {
-                            HDmemmove(xbkg, xbuf, dst_memb->size);
-                            xbuf += buf_stride;
-                            xbkg += bkg_stride;
-                        } /* end for */
-                    } /* end if */
-                } /* end for */
             } /* end else */
 
+            /*
+             * Work from right to left, converting those members that weren't
+             * converted in the previous loop (those members where the destination
+             * is larger than the source) and them to their final position in the
+             * bkg buffer.
+             */
+            H5_CHECK_OVERFLOW(src->shared->u.compnd.nmembs, size_t, int);
+            for(i = (int)src->shared->u.compnd.nmembs - 1; i >= 0; --i) {
+                if(src2dst[i] < 0)
+                    continue;
+                src_memb = src->shared->u.compnd.memb + i;
+                dst_memb = dst->shared->u.compnd.memb + src2dst[i];
+
+                if(dst_memb->size > src_memb->size) {
+                    offset -= src_memb->size;
+                    xbuf = buf + offset;
+                    xbkg = bkg + dst_memb->offset;
+                    if(H5T_convert(priv->memb_path[i], priv->src_memb_id[i],
+                            priv->dst_memb_id[src2dst[i]], nelmts,
+                            buf_stride, bkg_stride, xbuf, xbkg, dxpl_id) < 0)
+                        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTINIT, FAIL, "unable to convert compound datatype member")
+                    for(elmtno = 0; elmtno < nelmts; elmtno++) {
+                        HDmemmove(xbkg, xbuf, dst_memb->size);
+                        xbuf += buf_stride;
+                        xbkg += bkg_stride;
+                    } /* end for */
+                } /* end if */
+            } /* end for */
+
             if(no_stride)
                 buf_stride = dst->shared->size;
 
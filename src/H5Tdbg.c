@@ -85,6 +85,10 @@
  *		2. Data type debugging is turned on at run time.
  *		3. The path was called at least one time.
  *
+ *		Besides the conversion counts and times, the number of
+ *		lookups of the path answered by the path cache (hits) and
+ *		by searching the path table (misses) is shown.
+ *
  *		The optional NPRINT argument keeps track of the number of
  *		conversions paths for which statistics have been shown. If
  *		its value is zero then table headers are printed before the
@@ -115,12 +119,12 @@ H5T__print_stats(H5T_path_t H5_ATTR_UNUSED * path, int H5_ATTR_UNUSED * nprint/*
     if(H5DEBUG(T) && path->stats.ncalls > 0) {
 	if(nprint && 0 == (*nprint)++) {
 	    HDfprintf(H5DEBUG(T), "H5T: type conversion statistics:\n");
-	    HDfprintf(H5DEBUG(T), "   %-16s %10s %10s %8s %8s %8s %10s\n",
+	    HDfprintf(H5DEBUG(T), "   %-16s %10s %10s %8s %8s %8s %10s %10s %10s\n",
 		       "Conversion", "Elmts", "Calls", "User",
-		       "System", "Elapsed", "Bandwidth");
-	    HDfprintf(H5DEBUG(T), "   %-16s %10s %10s %8s %8s %8s %10s\n",
+		       "System", "Elapsed", "Bandwidth", "Hits", "Misses");
+	    HDfprintf(H5DEBUG(T), "   %-16s %10s %10s %8s %8s %8s %10s %10s %10s\n",
 		       "----------", "-----", "-----", "----",
-		       "------", "-------", "---------");
+		       "------", "-------", "---------", "----", "------");
 	}
         if(path->src && path->dst)
             nbytes = MAX(H5T_get_size(path->src), H5T_get_size(path->dst));
@@ -132,14 +136,16 @@ H5T__print_stats(H5T_path_t H5_ATTR_UNUSED * path, int H5_ATTR_UNUSED * nprint/*
             nbytes = 0;
 	nbytes *= path->stats.nelmts;
 	H5_bandwidth(bandwidth, (double)nbytes, path->stats.timer.etime);
-	HDfprintf(H5DEBUG(T), "   %-16s %10Hd %10d %8.2f %8.2f %8.2f %10s\n",
+	HDfprintf(H5DEBUG(T), "   %-16s %10Hd %10d %8.2f %8.2f %8.2f %10s %10u %10u\n",
 		   path->name,
 		   path->stats.nelmts,
 		   path->stats.ncalls,
 		   path->stats.timer.utime,
 		   path->stats.timer.stime,
 		   path->stats.timer.etime,
-		   bandwidth);
+		   bandwidth,
+		   path->stats.nhits,
+		   path->stats.nmisses);
     }
 #endif
     FUNC_LEAVE_NOAPI(SUCCEED)
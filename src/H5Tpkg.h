@@ -149,6 +149,8 @@ struct H5T_stats_t {
     unsigned	ncalls;			/*num calls to conversion function   */
     hsize_t	nelmts;			/*total data points converted	     */
     H5_timer_t	timer;			/*total time for conversion	     */
+    unsigned	nhits;			/*lookups answered by the path cache */
+    unsigned	nmisses;		/*lookups that searched the table    */
 };
 
 /* The datatype conversion database */
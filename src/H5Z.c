@@ -32,6 +32,8 @@
 #   include "szlib.h"
 #endif
 
+/* Local macros */
+
 /* Local typedefs */
 #ifdef H5Z_DEBUG
 typedef struct H5Z_stats_t {
@@ -43,6 +45,17 @@ typedef struct H5Z_stats_t {
 } H5Z_stats_t;
 #endif /* H5Z_DEBUG */
 
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+/* Shared information for the worker threads of H5Z_pipeline_batch() */
+typedef struct H5Z_batch_t {
+    const H5O_pline_t   *pline;         /* Filter pipeline */
+    unsigned            flags;          /* Pipeline flags */
+    H5Z_EDC_t           edc_read;       /* Error detection setting */
+    H5Z_cb_t            cb_struct;      /* Filter failure callback */
+    H5Z_pipeline_job_t  *jobs;          /* Buffers to filter */
+} H5Z_batch_t;
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
+
 typedef struct H5Z_object_t {
     H5Z_filter_t filter_id;     /* ID of the filter we're looking for         */
     htri_t       found;         /* Whether we find an object using the filter */
@@ -57,6 +70,9 @@ typedef enum {
 /* Package initialization variable */
 hbool_t H5_PKG_INIT_VAR = FALSE;
 
+/* Number of threads a filter may use for the buffer it is working on */
+unsigned H5Z_filter_threads_g = 1;
+
 /* Local variables */
 static size_t		H5Z_table_alloc_g = 0;
 static size_t		H5Z_table_used_g = 0;
@@ -67,6 +83,9 @@ static H5Z_stats_t	*H5Z_stat_table_g = NULL;
 
 /* Local functions */
 static int H5Z_find_idx(H5Z_filter_t id);
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+static void H5Z__pipeline_task(size_t task, void *_batch);
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
 static int H5Z__check_unregister_dset_cb(void *obj_ptr, hid_t obj_id, void *key);
 static int H5Z__check_unregister_group_cb(void *obj_ptr, hid_t obj_id, void *key);
 static int H5Z__flush_file_cb(void *obj_ptr, hid_t obj_id, void *key);
@@ -100,9 +119,12 @@ H5Z__init_package(void)
         HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register nbit filter")
     if(H5Z_register(H5Z_SCALEOFFSET) < 0)
         HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register scaleoffset filter")
+    if(H5Z_register(H5Z_BITSHUFFLE) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register bitshuffle filter")
 
     /* External filters */
 #ifdef H5_HAVE_FILTER_DEFLATE
+    H5Z__deflate_init();
     if(H5Z_register(H5Z_DEFLATE) < 0)
         HGOTO_ERROR (H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register deflate filter")
 #endif /* H5_HAVE_FILTER_DEFLATE */
@@ -191,6 +213,11 @@ H5Z_term_package(void)
 #endif /* H5Z_DEBUG */
 	/* Free the table of filters */
         if(H5Z_table_g) {
+#ifdef H5_HAVE_FILTER_DEFLATE
+            /* Release the deflate filter's idle streams */
+            H5Z__deflate_term();
+#endif /* H5_HAVE_FILTER_DEFLATE */
+
             H5Z_table_g = (H5Z_class2_t *)H5MM_xfree(H5Z_table_g);
 #ifdef H5Z_DEBUG
             H5Z_stat_table_g = (H5Z_stats_t *)H5MM_xfree(H5Z_stat_table_g);
@@ -1433,6 +1460,144 @@ done:
 }
 
 
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__pipeline_task
+ *
+ * Purpose:	Runs the filter pipeline over one buffer of a batch, on a
+ *              worker thread started by H5Z_pipeline_batch().
+ *
+ * Return:	void (the result is stored in the job)
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z__pipeline_task(size_t task, void *_batch)
+{
+    H5Z_batch_t *batch = (H5Z_batch_t *)_batch;
+    H5Z_pipeline_job_t *job = &batch->jobs[task];
+
+    job->status = H5Z_pipeline(batch->pline, batch->flags, &job->filter_mask,
+            batch->edc_read, batch->cb_struct, &job->nbytes, &job->buf_size,
+            &job->buf);
+    if(job->status >= 0 && job->op)
+        job->status = (job->op)(job->buf, job->nbytes, job->op_data);
+
+    /* The thread's error stack goes away with the thread; release its
+     * entries now, the caller reports the failure */
+    if(job->status < 0)
+        H5E_clear_stack(NULL);
+} /* end H5Z__pipeline_task() */
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_pipeline_batch
+ *
+ * Purpose:	Runs the filter pipeline over each of the NJOBS buffers in
+ *              JOBS, as H5Z_pipeline() would for each one in turn.  FLAGS,
+ *              EDC_READ and CB_STRUCT apply to every buffer.
+ *
+ *              When NTHREADS is greater than one, the buffers are filtered
+ *              concurrently on up to NTHREADS worker threads.  This is only
+ *              done in thread-safe builds, for pipelines made up entirely
+ *              of registered predefined filters and without a filter
+ *              callback (both of which could call back into the public
+ *              API, which the calling thread holds locked).  Otherwise the
+ *              buffers are filtered serially on the calling thread.  A
+ *              single buffer is filtered on the calling thread too, but
+ *              filters that can divide their work (bitshuffle) may then
+ *              use up to NTHREADS threads for it.
+ *
+ *              A job's OP, if set, is called with its buffer right after
+ *              the buffer was filtered, on the same thread.
+ *
+ * Return:	Non-negative if every buffer was filtered/Negative on
+ *              failure.  The status of each buffer is set in its job.
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Z_pipeline_batch(const H5O_pline_t *pline, unsigned flags, H5Z_EDC_t edc_read,
+    H5Z_cb_t cb_struct, unsigned H5_ATTR_UNUSED nthreads, size_t njobs,
+    H5Z_pipeline_job_t *jobs)
+{
+    hbool_t     done_jobs = FALSE;      /* Whether the jobs were run on worker threads */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(jobs || 0 == njobs);
+
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+    if(nthreads > 1 && njobs > 0 && pline && NULL == cb_struct.func) {
+        hbool_t use_threads = TRUE;     /* Whether the pipeline can run on worker threads */
+
+        /* Check for filters that aren't the library's own, or that would
+         * need to be loaded from a plugin */
+        for(u = 0; u < pline->nused; u++) {
+            int idx = H5Z_find_idx(pline->filter[u].id);   /* Filter's table index */
+
+            if(idx < 0 || (pline->filter[u].id >= H5Z_FILTER_RESERVED
+                    && H5Z_table_g[idx].filter != H5Z_BITSHUFFLE->filter)) {
+                use_threads = FALSE;
+                break;
+            } /* end if */
+        } /* end for */
+
+        /* A single buffer is left to the filters themselves, which may
+         * split it up over the threads (see H5Z_filter_threads_g) */
+        if(use_threads && njobs == 1) {
+            H5Z_filter_threads_g = nthreads;
+            jobs[0].status = H5Z_pipeline(pline, flags, &jobs[0].filter_mask,
+                    edc_read, cb_struct, &jobs[0].nbytes, &jobs[0].buf_size,
+                    &jobs[0].buf);
+            H5Z_filter_threads_g = 1;
+            if(jobs[0].status < 0)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "filter pipeline failed")
+            if(jobs[0].op && (jobs[0].status = (jobs[0].op)(jobs[0].buf, jobs[0].nbytes, jobs[0].op_data)) < 0)
+                HGOTO_ERROR(H5E_PLINE, H5E_CALLBACK, FAIL, "operation on filtered buffer failed")
+            done_jobs = TRUE;
+        } /* end if */
+        else if(use_threads) {
+            H5Z_batch_t batch;          /* Information for the worker threads */
+
+            batch.pline = pline;
+            batch.flags = flags;
+            batch.edc_read = edc_read;
+            batch.cb_struct = cb_struct;
+            batch.jobs = jobs;
+
+            /* (Falls through to filtering serially if no threads could be started) */
+            if(H5TS_run_tasks(nthreads, njobs, H5Z__pipeline_task, &batch) >= 0) {
+                done_jobs = TRUE;
+
+                for(u = 0; u < njobs; u++)
+                    if(jobs[u].status < 0)
+                        HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "filter pipeline failed on worker thread")
+            } /* end if */
+        } /* end if */
+    } /* end if */
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
+
+    if(!done_jobs)
+        for(u = 0; u < njobs; u++) {
+            jobs[u].status = H5Z_pipeline(pline, flags, &jobs[u].filter_mask,
+                    edc_read, cb_struct, &jobs[u].nbytes, &jobs[u].buf_size,
+                    &jobs[u].buf);
+            if(jobs[u].status < 0)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "filter pipeline failed")
+            if(jobs[u].op && (jobs[u].status = (jobs[u].op)(jobs[u].buf, jobs[u].nbytes, jobs[u].op_data)) < 0)
+                HGOTO_ERROR(H5E_PLINE, H5E_CALLBACK, FAIL, "operation on filtered buffer failed")
+        } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_pipeline_batch() */
+
+
 /*-------------------------------------------------------------------------
  * Function:	H5Z_filter_info
  *
@@ -0,0 +1,806 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:	The bitshuffle filter, optionally followed by LZ4.
+ *
+ *		The data is divided into blocks of BLOCK_SIZE elements (the
+ *		last block is shortened to a multiple of 8 elements, and the
+ *		final NELMTS%8 elements are stored as they are).  Within a
+ *		block, bit K of byte J of every element is gathered into
+ *		"bit row" 8*J+K, so bytes that only differ in a few low bits
+ *		become long runs.
+ *
+ *		With LZ4, the chunk starts with the uncompressed size (8
+ *		bytes) and the block size in bytes (4 bytes), and each block
+ *		is stored as its compressed size (4 bytes) followed by an LZ4
+ *		block.  All integers are big-endian.  This is the format of
+ *		the external bitshuffle filter registered as filter 32008, so
+ *		files written by either one can be read by the other.
+ *
+ *		Blocks are independent, so the blocks of one chunk can be
+ *		[de]compressed on several threads (see H5Z_filter_threads_g).
+ */
+
+#include "H5Zmodule.h"          /* This source code file is part of the H5Z module */
+
+
+#include "H5private.h"		/* Generic Functions			*/
+#include "H5Eprivate.h"		/* Error handling		  	*/
+#include "H5Iprivate.h"		/* IDs			  		*/
+#include "H5MMprivate.h"	/* Memory management			*/
+#include "H5Pprivate.h"         /* Property lists                       */
+#include "H5Tprivate.h"		/* Datatypes         			*/
+#include "H5Zpkg.h"		/* Data filters				*/
+
+/* The bit transposition uses SSE2 movemask where available */
+#if defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#define H5Z_BSHUF_SSE2
+#include <emmintrin.h>
+#endif /* __SSE2__ */
+
+/* Local macros */
+#define H5Z_BSHUF_VERSION_MAJOR     0       /* Format version recorded in the parameters */
+#define H5Z_BSHUF_VERSION_MINOR     3
+#define H5Z_BSHUF_MAX_NPARMS        8       /* Most parameters kept from the user */
+#define H5Z_BSHUF_BLOCK_MULT        8       /* Blocks hold a multiple of this many elements */
+#define H5Z_BSHUF_TARGET_BLOCK_SIZE 8192    /* Default block size, in bytes */
+#define H5Z_BSHUF_MIN_BLOCK_SIZE    128     /* Smallest default block size, in elements */
+#define H5Z_BSHUF_HEADER_SIZE       12      /* Bytes before the first LZ4 block */
+#define H5Z_BSHUF_MIN_TASK_BLOCKS   4       /* Fewest blocks worth handing to a thread */
+
+/* LZ4 block format limits */
+#define H5Z_LZ4_MIN_MATCH           4       /* Shortest match */
+#define H5Z_LZ4_LAST_LITERALS       5       /* The last bytes are always literals */
+#define H5Z_LZ4_MFLIMIT             12      /* The last match starts this far from the end */
+#define H5Z_LZ4_MAX_OFFSET          65535   /* Farthest match */
+#define H5Z_LZ4_HASH_LOG            12      /* Size of the compressor's hash table */
+#define H5Z_LZ4_HASH_SIZE           (1 << H5Z_LZ4_HASH_LOG)
+#define H5Z_LZ4_SKIP_TRIGGER        6       /* Speed up after 2^N misses in a row */
+#define H5Z_LZ4_BOUND(n)            ((n) + ((n) / 255) + 16)
+
+/* Transpose the 8x8 bit matrix held in X (byte J = row J), using T */
+#define H5Z_BSHUF_TRANS_8X8(x, t) {                                         \
+    t = (x ^ (x >> 7)) & (uint64_t)0x00AA00AA00AA00AAULL;                   \
+    x = x ^ t ^ (t << 7);                                                   \
+    t = (x ^ (x >> 14)) & (uint64_t)0x0000CCCC0000CCCCULL;                  \
+    x = x ^ t ^ (t << 14);                                                  \
+    t = (x ^ (x >> 28)) & (uint64_t)0x00000000F0F0F0F0ULL;                  \
+    x = x ^ t ^ (t << 28);                                                  \
+}
+
+/* Local typedefs */
+
+/* One [de]compression of a buffer, shared by the tasks its blocks are
+ * divided between */
+typedef struct H5Z_bshuf_t {
+    hbool_t reverse;            /* Whether the buffer is being decoded */
+    hbool_t lz4;                /* Whether the blocks are LZ4-compressed */
+    size_t elem_size;           /* Bytes per element */
+    size_t block_size;          /* Elements in a full block */
+    size_t nfull;               /* Number of full blocks */
+    size_t last_size;           /* Elements in the short last block (0 if none) */
+    size_t nblocks;             /* Number of blocks */
+    const unsigned char *src;   /* Input buffer */
+    unsigned char *dst;         /* Output buffer */
+    size_t *offsets;            /* Offset of each LZ4 block (in SRC when decoding, DST when encoding) */
+    size_t *csizes;             /* Compressed size of each LZ4 block */
+    size_t ntasks;              /* Number of tasks */
+    herr_t *status;             /* Status of each task */
+} H5Z_bshuf_t;
+
+/* Local function prototypes */
+static herr_t H5Z_set_local_bitshuffle(hid_t dcpl_id, hid_t type_id, hid_t space_id);
+static size_t H5Z_filter_bitshuffle(unsigned flags, size_t cd_nelmts,
+    const unsigned cd_values[], size_t nbytes, size_t *buf_size, void **buf);
+static void H5Z_bshuf_bits_fwd(const unsigned char *row, unsigned char *out, size_t nelmts);
+static void H5Z_bshuf_bits_rev(const unsigned char *in, unsigned char *row, size_t nelmts);
+static herr_t H5Z_bshuf_code_block(const H5Z_bshuf_t *info, size_t block,
+    unsigned char *scratch, uint32_t *htab);
+static void H5Z_bshuf_task(size_t task, void *_info);
+static size_t H5Z_lz4_compress(const unsigned char *src, size_t srclen,
+    unsigned char *dst, uint32_t *htab);
+static herr_t H5Z_lz4_decompress(const unsigned char *src, size_t srclen,
+    unsigned char *dst, size_t dstlen);
+
+/* This message derives from H5Z */
+const H5Z_class2_t H5Z_BITSHUFFLE[1] = {{
+    H5Z_CLASS_T_VERS,           /* H5Z_class_t version */
+    H5Z_FILTER_BITSHUFFLE,      /* Filter id number		*/
+    1,              /* encoder_present flag (set to true) */
+    1,              /* decoder_present flag (set to true) */
+    "bitshuffle",               /* Filter name for debugging	*/
+    NULL,                       /* The "can apply" callback     */
+    H5Z_set_local_bitshuffle,   /* The "set local" callback     */
+    H5Z_filter_bitshuffle,      /* The actual filter function	*/
+}};
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_set_local_bitshuffle
+ *
+ * Purpose:	Set the "local" dataset parameters for bitshuffle: the
+ *              format version and the size of the datatype.  Parameters
+ *              the user supplied beyond those are kept.
+ *
+ * Return:	Success: Non-negative
+ *		Failure: Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z_set_local_bitshuffle(hid_t dcpl_id, hid_t type_id, hid_t H5_ATTR_UNUSED space_id)
+{
+    H5P_genplist_t *dcpl_plist;     /* Property list pointer */
+    const H5T_t	*type;                  /* Datatype */
+    unsigned flags;                     /* Filter flags */
+    size_t cd_nelmts = H5Z_BSHUF_MAX_NPARMS;    /* Number of filter parameters */
+    unsigned cd_values[H5Z_BSHUF_MAX_NPARMS];   /* Filter parameters */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Get the plist structure */
+    if(NULL == (dcpl_plist = H5P_object_verify(dcpl_id, H5P_DATASET_CREATE)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get datatype */
+    if(NULL == (type = (const H5T_t *)H5I_object_verify(type_id, H5I_DATATYPE)))
+	HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a datatype")
+
+    /* Get the filter's current parameters */
+    HDmemset(cd_values, 0, sizeof(cd_values));
+    if(H5P_get_filter_by_id(dcpl_plist, H5Z_FILTER_BITSHUFFLE, &flags, &cd_nelmts, cd_values, (size_t)0, NULL, NULL) < 0)
+	HGOTO_ERROR(H5E_PLINE, H5E_CANTGET, FAIL, "can't get bitshuffle parameters")
+    if(cd_nelmts > H5Z_BSHUF_MAX_NPARMS)
+        cd_nelmts = H5Z_BSHUF_MAX_NPARMS;
+    for(u = cd_nelmts; u <= H5Z_BSHUF_PARM_ELEM_SIZE; u++)
+        cd_values[u] = 0;
+    if(cd_nelmts <= H5Z_BSHUF_PARM_ELEM_SIZE)
+        cd_nelmts = H5Z_BSHUF_PARM_ELEM_SIZE + 1;
+
+    /* Check the user's parameters */
+    if(cd_nelmts > H5Z_BSHUF_PARM_BLOCK_SIZE && (cd_values[H5Z_BSHUF_PARM_BLOCK_SIZE] % H5Z_BSHUF_BLOCK_MULT) != 0)
+	HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "bitshuffle block size must be a multiple of 8")
+    if(cd_nelmts > H5Z_BSHUF_PARM_COMPRESS && cd_values[H5Z_BSHUF_PARM_COMPRESS] != H5Z_BSHUF_COMPRESS_NONE
+            && cd_values[H5Z_BSHUF_PARM_COMPRESS] != H5Z_BSHUF_COMPRESS_LZ4)
+	HGOTO_ERROR(H5E_PLINE, H5E_UNSUPPORTED, FAIL, "unsupported bitshuffle compression")
+
+    /* Set "local" parameters for this dataset */
+    cd_values[H5Z_BSHUF_PARM_VERS_MAJOR] = H5Z_BSHUF_VERSION_MAJOR;
+    cd_values[H5Z_BSHUF_PARM_VERS_MINOR] = H5Z_BSHUF_VERSION_MINOR;
+    if((cd_values[H5Z_BSHUF_PARM_ELEM_SIZE] = (unsigned)H5T_get_size(type)) == 0)
+	HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "bad datatype size")
+
+    /* Modify the filter's parameters for this dataset */
+    if(H5P_modify_filter(dcpl_plist, H5Z_FILTER_BITSHUFFLE, flags, cd_nelmts, cd_values) < 0)
+	HGOTO_ERROR(H5E_PLINE, H5E_CANTSET, FAIL, "can't set local bitshuffle parameters")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_set_local_bitshuffle() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_bshuf_bits_fwd
+ *
+ * Purpose:	Split a row of NELMTS bytes (a multiple of 8) into 8 bit rows
+ *              of NELMTS/8 bytes: bit I%8 of byte I/8 of bit row K is bit
+ *              K of byte I.
+ *
+ *              With SSE2, movemask gathers the top bit of 16 bytes at a
+ *              time and the bytes are then shifted left for the next bit.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z_bshuf_bits_fwd(const unsigned char *row, unsigned char *out, size_t nelmts)
+{
+    size_t nb = nelmts / 8;             /* Bytes per bit row */
+    size_t i = 0;                       /* Local index variable */
+    unsigned k;                         /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+#ifdef H5Z_BSHUF_SSE2
+    for(; i + 16 <= nelmts; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(row + i));
+
+        for(k = 8; k > 0; k--) {
+            unsigned mask = (unsigned)_mm_movemask_epi8(v);
+
+            out[(k - 1) * nb + i / 8] = (unsigned char)mask;
+            out[(k - 1) * nb + i / 8 + 1] = (unsigned char)(mask >> 8);
+            v = _mm_add_epi8(v, v);
+        } /* end for */
+    } /* end for */
+#endif /* H5Z_BSHUF_SSE2 */
+
+    for(; i < nelmts; i += 8) {
+        uint64_t x = 0, t;              /* 8x8 bit matrix */
+
+        for(k = 0; k < 8; k++)
+            x |= (uint64_t)row[i + k] << (8 * k);
+        H5Z_BSHUF_TRANS_8X8(x, t)
+        for(k = 0; k < 8; k++)
+            out[k * nb + i / 8] = (unsigned char)(x >> (8 * k));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z_bshuf_bits_fwd() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_bshuf_bits_rev
+ *
+ * Purpose:	Inverse of H5Z_bshuf_bits_fwd: assemble a row of NELMTS
+ *              bytes from the 8 bit rows in IN.
+ *
+ *              With SSE2, 16 bytes of each bit row are first interleaved
+ *              so that each register holds the 8 bit-row bytes of two
+ *              groups of 8 elements, and movemask then yields one output
+ *              byte per group for each bit position.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z_bshuf_bits_rev(const unsigned char *in, unsigned char *row, size_t nelmts)
+{
+    size_t nb = nelmts / 8;             /* Bytes per bit row */
+    size_t g = 0;                       /* Group of 8 elements */
+    unsigned k;                         /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+#ifdef H5Z_BSHUF_SSE2
+    for(; g + 16 <= nb; g += 16) {
+        __m128i vec_a[8], vec_b[8];     /* Working registers */
+        __m128i *vin = vec_a, *vout = vec_b, *tmp;
+        unsigned q, r;                  /* Local index variables */
+
+        for(k = 0; k < 8; k++)
+            vin[k] = _mm_loadu_si128((const __m128i *)(in + k * nb + g));
+
+        /* Three rounds of interleaving turn 8 rows of 16 bytes into 16
+         * groups of 8 bytes */
+        for(r = 0; r < 3; r++) {
+            for(q = 0; q < 4; q++) {
+                vout[2 * q] = _mm_unpacklo_epi8(vin[q], vin[q + 4]);
+                vout[2 * q + 1] = _mm_unpackhi_epi8(vin[q], vin[q + 4]);
+            } /* end for */
+            tmp = vin; vin = vout; vout = tmp;
+        } /* end for */
+
+        for(q = 0; q < 8; q++) {
+            unsigned char *lo = row + (g + 2 * q) * 8;
+            __m128i v = vin[q];
+
+            for(k = 8; k > 0; k--) {
+                unsigned mask = (unsigned)_mm_movemask_epi8(v);
+
+                lo[k - 1] = (unsigned char)mask;
+                lo[8 + k - 1] = (unsigned char)(mask >> 8);
+                v = _mm_add_epi8(v, v);
+            } /* end for */
+        } /* end for */
+    } /* end for */
+#endif /* H5Z_BSHUF_SSE2 */
+
+    for(; g < nb; g++) {
+        uint64_t x = 0, t;              /* 8x8 bit matrix */
+
+        for(k = 0; k < 8; k++)
+            x |= (uint64_t)in[k * nb + g] << (8 * k);
+        H5Z_BSHUF_TRANS_8X8(x, t)
+        for(k = 0; k < 8; k++)
+            row[g * 8 + k] = (unsigned char)(x >> (8 * k));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z_bshuf_bits_rev() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_lz4_compress
+ *
+ * Purpose:	Compress SRCLEN bytes from SRC into an LZ4 block at DST,
+ *              which must hold H5Z_LZ4_BOUND(SRCLEN) bytes.  HTAB is the
+ *              compressor's hash table of H5Z_LZ4_HASH_SIZE entries.
+ *
+ *              This is a greedy single-probe compressor; any LZ4 block
+ *              decoder can read its output.
+ *
+ * Return:	Size of the compressed block
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z_lz4_compress(const unsigned char *src, size_t srclen, unsigned char *dst,
+    uint32_t *htab)
+{
+    size_t ip = 0;                      /* Input position */
+    size_t anchor = 0;                  /* Start of the pending literals */
+    size_t op = 0;                      /* Output position */
+    size_t nlit, n;                     /* Literal count, length to encode */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Inputs shorter than MFLIMIT+1 bytes are stored as literals */
+    if(srclen > H5Z_LZ4_MFLIMIT) {
+        size_t mflimit = srclen - H5Z_LZ4_MFLIMIT;          /* Matches start before this */
+        size_t matchlimit = srclen - H5Z_LZ4_LAST_LITERALS; /* Matches end by this */
+        unsigned misses = 1 << H5Z_LZ4_SKIP_TRIGGER;        /* Scaled count of misses */
+
+        HDmemset(htab, 0, sizeof(uint32_t) * H5Z_LZ4_HASH_SIZE);
+        while(ip < mflimit) {
+            uint32_t seq, ref_seq;      /* Next 4 bytes at IP and at the candidate */
+            unsigned h;                 /* Hash of SEQ */
+            size_t ref;                 /* Candidate match position */
+
+            HDmemcpy(&seq, src + ip, sizeof(seq));
+            h = (unsigned)((seq * 2654435761U) >> (32 - H5Z_LZ4_HASH_LOG));
+            ref = htab[h];
+            htab[h] = (uint32_t)ip;
+            HDmemcpy(&ref_seq, src + ref, sizeof(ref_seq));
+
+            if(ref < ip && ip - ref <= H5Z_LZ4_MAX_OFFSET && ref_seq == seq) {
+                size_t len = H5Z_LZ4_MIN_MATCH;     /* Match length */
+                unsigned char *token = dst + op++;  /* Sequence token */
+
+                /* Extend the match backwards over the pending literals,
+                 * then forwards */
+                while(ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1]) {
+                    ip--;
+                    ref--;
+                    len++;
+                } /* end while */
+                while(ip + len < matchlimit && src[ip + len] == src[ref + len])
+                    len++;
+
+                /* Literals */
+                nlit = ip - anchor;
+                *token = (unsigned char)((nlit < 15 ? nlit : 15) << 4);
+                if(nlit >= 15) {
+                    for(n = nlit - 15; n >= 255; n -= 255)
+                        dst[op++] = 255;
+                    dst[op++] = (unsigned char)n;
+                } /* end if */
+                HDmemcpy(dst + op, src + anchor, nlit);
+                op += nlit;
+
+                /* Match */
+                dst[op++] = (unsigned char)((ip - ref) & 0xff);
+                dst[op++] = (unsigned char)((ip - ref) >> 8);
+                n = len - H5Z_LZ4_MIN_MATCH;
+                *token |= (unsigned char)(n < 15 ? n : 15);
+                if(n >= 15) {
+                    for(n -= 15; n >= 255; n -= 255)
+                        dst[op++] = 255;
+                    dst[op++] = (unsigned char)n;
+                } /* end if */
+
+                ip += len;
+                anchor = ip;
+                misses = 1 << H5Z_LZ4_SKIP_TRIGGER;
+            } /* end if */
+            else
+                ip += misses++ >> H5Z_LZ4_SKIP_TRIGGER;
+        } /* end while */
+    } /* end if */
+
+    /* The last literals */
+    nlit = srclen - anchor;
+    dst[op++] = (unsigned char)((nlit < 15 ? nlit : 15) << 4);
+    if(nlit >= 15) {
+        for(n = nlit - 15; n >= 255; n -= 255)
+            dst[op++] = 255;
+        dst[op++] = (unsigned char)n;
+    } /* end if */
+    HDmemcpy(dst + op, src + anchor, nlit);
+    op += nlit;
+
+    FUNC_LEAVE_NOAPI(op)
+} /* end H5Z_lz4_compress() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_lz4_decompress
+ *
+ * Purpose:	Decompress the LZ4 block of SRCLEN bytes at SRC, which must
+ *              expand to exactly DSTLEN bytes, into DST.  Every length and
+ *              offset is checked against both buffers.
+ *
+ * Return:	Non-negative on success/Negative if the block is corrupt
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z_lz4_decompress(const unsigned char *src, size_t srclen, unsigned char *dst,
+    size_t dstlen)
+{
+    size_t ip = 0;                      /* Input position */
+    size_t op = 0;                      /* Output position */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    while(ip < srclen) {
+        unsigned token = src[ip++];     /* Sequence token */
+        size_t len = token >> 4;        /* Literal, then match, length */
+        size_t offset;                  /* Match offset */
+        unsigned char c;                /* Length byte */
+
+        /* Literals */
+        if(len == 15)
+            do {
+                if(ip >= srclen)
+                    HGOTO_DONE(FAIL)
+                c = src[ip++];
+                len += c;
+            } while(c == 255);
+        if(len > srclen - ip || len > dstlen - op)
+            HGOTO_DONE(FAIL)
+        HDmemcpy(dst + op, src + ip, len);
+        ip += len;
+        op += len;
+
+        /* The last sequence has no match */
+        if(ip == srclen)
+            break;
+
+        /* Match */
+        if(srclen - ip < 2)
+            HGOTO_DONE(FAIL)
+        offset = (size_t)src[ip] | ((size_t)src[ip + 1] << 8);
+        ip += 2;
+        if(offset == 0 || offset > op)
+            HGOTO_DONE(FAIL)
+        len = token & 15;
+        if(len == 15)
+            do {
+                if(ip >= srclen)
+                    HGOTO_DONE(FAIL)
+                c = src[ip++];
+                len += c;
+            } while(c == 255);
+        len += H5Z_LZ4_MIN_MATCH;
+        if(len > dstlen - op)
+            HGOTO_DONE(FAIL)
+        if(offset >= len)
+            HDmemcpy(dst + op, dst + op - offset, len);
+        else {
+            size_t u;                   /* Local index variable */
+
+            /* Overlapping copy repeats the last OFFSET bytes */
+            for(u = 0; u < len; u++)
+                dst[op + u] = dst[op - offset + u];
+        } /* end else */
+        op += len;
+    } /* end while */
+
+    if(op != dstlen)
+        HGOTO_DONE(FAIL)
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_lz4_decompress() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_bshuf_code_block
+ *
+ * Purpose:	Encode or decode block BLOCK of a buffer.  SCRATCH holds
+ *              twice the size of a full block, and HTAB is the LZ4 hash
+ *              table (only used when compressing).
+ *
+ * Return:	Non-negative on success/Negative if the block is corrupt
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z_bshuf_code_block(const H5Z_bshuf_t *info, size_t block, unsigned char *scratch,
+    uint32_t *htab)
+{
+    size_t nelmts;                      /* Elements in this block */
+    size_t nbytes;                      /* Bytes in this block */
+    size_t start;                       /* Offset of the block's uncompressed data */
+    unsigned char *bits;                /* Bit-transposed block */
+    unsigned char *bytes;               /* Byte-transposed block */
+    size_t j;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    nelmts = block < info->nfull ? info->block_size : info->last_size;
+    nbytes = nelmts * info->elem_size;
+    start = block * info->block_size * info->elem_size;
+    bytes = scratch;
+    bits = scratch + info->block_size * info->elem_size;
+
+    if(!info->reverse) {
+        /* Gather the bytes, then the bits, of each byte position */
+        if(!info->lz4)
+            bits = info->dst + start;
+        H5Z__shuffle_bytes(info->src + start, bytes, info->elem_size, nelmts, FALSE);
+        for(j = 0; j < info->elem_size; j++)
+            H5Z_bshuf_bits_fwd(bytes + j * nelmts, bits + j * nelmts, nelmts);
+
+        if(info->lz4) {
+            unsigned char *out = info->dst + info->offsets[block];
+            size_t csize = H5Z_lz4_compress(bits, nbytes, out + 4, htab);
+
+            out[0] = (unsigned char)(csize >> 24);
+            out[1] = (unsigned char)(csize >> 16);
+            out[2] = (unsigned char)(csize >> 8);
+            out[3] = (unsigned char)csize;
+            info->csizes[block] = csize;
+        } /* end if */
+    } /* end if */
+    else {
+        if(info->lz4) {
+            if(H5Z_lz4_decompress(info->src + info->offsets[block], info->csizes[block], bits, nbytes) < 0)
+                HGOTO_DONE(FAIL)
+        } /* end if */
+        else
+            bits = (unsigned char *)info->src + start;
+        for(j = 0; j < info->elem_size; j++)
+            H5Z_bshuf_bits_rev(bits + j * nelmts, bytes + j * nelmts, nelmts);
+        H5Z__shuffle_bytes(bytes, info->dst + start, info->elem_size, nelmts, TRUE);
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_bshuf_code_block() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_bshuf_task
+ *
+ * Purpose:	Encode or decode task TASK's share of the blocks of a
+ *              buffer.  Runs on a worker thread, or on the calling thread
+ *              when the buffer isn't divided up.
+ *
+ * Return:	void (the result is stored in INFO->STATUS)
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z_bshuf_task(size_t task, void *_info)
+{
+    H5Z_bshuf_t *info = (H5Z_bshuf_t *)_info;
+    unsigned char *scratch = NULL;      /* Transposition buffers */
+    uint32_t *htab = NULL;              /* LZ4 hash table */
+    size_t first = (task * info->nblocks) / info->ntasks;       /* First block */
+    size_t last = ((task + 1) * info->nblocks) / info->ntasks;  /* One past the last block */
+    size_t u;                           /* Local index variable */
+
+    info->status[task] = SUCCEED;
+    if(NULL == (scratch = (unsigned char *)H5MM_malloc(2 * info->block_size * info->elem_size)))
+        info->status[task] = FAIL;
+    else if(info->lz4 && !info->reverse
+            && NULL == (htab = (uint32_t *)H5MM_malloc(sizeof(uint32_t) * H5Z_LZ4_HASH_SIZE)))
+        info->status[task] = FAIL;
+
+    for(u = first; u < last && info->status[task] >= 0; u++)
+        info->status[task] = H5Z_bshuf_code_block(info, u, scratch, htab);
+
+    H5MM_xfree(htab);
+    H5MM_xfree(scratch);
+} /* end H5Z_bshuf_task() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_filter_bitshuffle
+ *
+ * Purpose:	Implement an I/O filter which transposes the bits of each
+ *              block of elements, then optionally compresses each block
+ *              with LZ4.  See the top of this file for the format.
+ *
+ *              When H5Z_filter_threads_g allows it and there are enough
+ *              blocks, the blocks are divided between worker threads.
+ *
+ * Return:	Success: Size of buffer filtered
+ *		Failure: 0
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z_filter_bitshuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
+    size_t nbytes, size_t *buf_size, void **buf)
+{
+    H5Z_bshuf_t info;                   /* Description of the blocks */
+    const unsigned char *src = (const unsigned char *)*buf; /* Input buffer */
+    unsigned char *outbuf = NULL;       /* Output buffer */
+    size_t *offsets = NULL;             /* Block offsets and sizes */
+    herr_t status = SUCCEED;            /* Status of a single task */
+    size_t nbytes_uncomp;               /* Size of the unfiltered data */
+    size_t nelmts;                      /* Number of elements */
+    size_t nleftover;                   /* Bytes stored as they are at the end */
+    size_t out_alloc;                   /* Size of the output buffer */
+    size_t out_nbytes;                  /* Bytes in the output buffer */
+    size_t pos;                         /* Position in the [compressed] buffer */
+    hbool_t ran_tasks = FALSE;          /* Whether the tasks ran on worker threads */
+    size_t u;                           /* Local index variable */
+    size_t ret_value = 0;               /* Return value */
+
+    FUNC_ENTER_NOAPI(0)
+
+    /* Check arguments */
+    if(cd_nelmts <= H5Z_BSHUF_PARM_ELEM_SIZE || cd_values[H5Z_BSHUF_PARM_ELEM_SIZE] == 0)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, 0, "invalid bitshuffle parameters")
+
+    HDmemset(&info, 0, sizeof(info));
+    info.reverse = (hbool_t)((flags & H5Z_FLAG_REVERSE) != 0);
+    info.elem_size = cd_values[H5Z_BSHUF_PARM_ELEM_SIZE];
+    if(cd_nelmts > H5Z_BSHUF_PARM_BLOCK_SIZE)
+        info.block_size = cd_values[H5Z_BSHUF_PARM_BLOCK_SIZE];
+    if(cd_nelmts > H5Z_BSHUF_PARM_COMPRESS) {
+        if(cd_values[H5Z_BSHUF_PARM_COMPRESS] == H5Z_BSHUF_COMPRESS_LZ4)
+            info.lz4 = TRUE;
+        else if(cd_values[H5Z_BSHUF_PARM_COMPRESS] != H5Z_BSHUF_COMPRESS_NONE)
+            HGOTO_ERROR(H5E_PLINE, H5E_UNSUPPORTED, 0, "unsupported bitshuffle compression")
+    } /* end if */
+
+    /* Compressed chunks record their size and block size */
+    if(info.lz4 && info.reverse) {
+        uint64_t nbytes64 = 0;          /* Size from the header */
+        size_t block_bytes = 0;         /* Block size from the header */
+
+        if(nbytes < H5Z_BSHUF_HEADER_SIZE)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "bitshuffle header is truncated")
+        for(u = 0; u < 8; u++)
+            nbytes64 = (nbytes64 << 8) | src[u];
+        for(u = 8; u < 12; u++)
+            block_bytes = (block_bytes << 8) | src[u];
+        H5_CHECKED_ASSIGN(nbytes_uncomp, size_t, nbytes64, uint64_t);
+        if(block_bytes == 0 || (block_bytes % info.elem_size) != 0)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "invalid bitshuffle block size")
+        info.block_size = block_bytes / info.elem_size;
+    } /* end if */
+    else {
+        nbytes_uncomp = nbytes;
+        if(info.block_size == 0) {
+            info.block_size = H5Z_BSHUF_TARGET_BLOCK_SIZE / info.elem_size;
+            info.block_size -= info.block_size % H5Z_BSHUF_BLOCK_MULT;
+            if(info.block_size < H5Z_BSHUF_MIN_BLOCK_SIZE)
+                info.block_size = H5Z_BSHUF_MIN_BLOCK_SIZE;
+        } /* end if */
+    } /* end else */
+    if((info.block_size % H5Z_BSHUF_BLOCK_MULT) != 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, 0, "bitshuffle block size must be a multiple of 8")
+    if((nbytes_uncomp % info.elem_size) != 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, 0, "buffer isn't a whole number of elements")
+
+    /* Divide the elements into blocks */
+    nelmts = nbytes_uncomp / info.elem_size;
+    info.nfull = nelmts / info.block_size;
+    info.last_size = nelmts % info.block_size;
+    info.last_size -= info.last_size % H5Z_BSHUF_BLOCK_MULT;
+    info.nblocks = info.nfull + (info.last_size > 0 ? 1 : 0);
+    nleftover = (nelmts % H5Z_BSHUF_BLOCK_MULT) * info.elem_size;
+
+    /* Locate the blocks */
+    if(info.lz4 && info.nblocks > 0) {
+        if(NULL == (offsets = (size_t *)H5MM_malloc(2 * info.nblocks * sizeof(size_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for bitshuffle blocks")
+        info.offsets = offsets;
+        info.csizes = offsets + info.nblocks;
+    } /* end if */
+    pos = H5Z_BSHUF_HEADER_SIZE;
+    if(info.lz4 && info.reverse) {
+        for(u = 0; u < info.nblocks; u++) {
+            size_t csize = 0;           /* Compressed size of the block */
+            unsigned v;                 /* Local index variable */
+
+            if(nbytes - pos < 4)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "bitshuffle data is truncated")
+            for(v = 0; v < 4; v++)
+                csize = (csize << 8) | src[pos++];
+            if(csize > nbytes - pos)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "bitshuffle data is truncated")
+            info.offsets[u] = pos;
+            info.csizes[u] = csize;
+            pos += csize;
+        } /* end for */
+        if(nbytes - pos < nleftover)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "bitshuffle data is truncated")
+        out_alloc = nbytes_uncomp;
+    } /* end if */
+    else if(info.lz4) {
+        size_t stride = 4 + H5Z_LZ4_BOUND(info.block_size * info.elem_size);  /* Room for each block */
+
+        /* Compress each block in its own space, and pack them afterwards */
+        for(u = 0; u < info.nblocks; u++)
+            info.offsets[u] = H5Z_BSHUF_HEADER_SIZE + u * stride;
+        out_alloc = H5Z_BSHUF_HEADER_SIZE + info.nblocks * stride + nleftover;
+    } /* end if */
+    else
+        out_alloc = nbytes_uncomp;
+
+    /* Allocate the output buffer */
+    if(NULL == (outbuf = (unsigned char *)H5MM_malloc(out_alloc ? out_alloc : 1)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for bitshuffle buffer")
+    info.src = src;
+    info.dst = outbuf;
+
+    /* Encode or decode the blocks, on several threads if allowed */
+    info.ntasks = 1;
+    info.status = &status;
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+    if(H5Z_filter_threads_g > 1 && info.nblocks >= 2 * H5Z_BSHUF_MIN_TASK_BLOCKS) {
+        info.ntasks = MIN(H5Z_filter_threads_g, info.nblocks / H5Z_BSHUF_MIN_TASK_BLOCKS);
+        if(NULL == (info.status = (herr_t *)H5MM_malloc(info.ntasks * sizeof(herr_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for bitshuffle tasks")
+
+        /* (Falls through to running the tasks serially if no threads could be started) */
+        if(H5TS_run_tasks((unsigned)info.ntasks, info.ntasks, H5Z_bshuf_task, &info) >= 0)
+            ran_tasks = TRUE;
+    } /* end if */
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
+    if(!ran_tasks)
+        for(u = 0; u < info.ntasks; u++)
+            H5Z_bshuf_task(u, &info);
+    for(u = 0; u < info.ntasks; u++)
+        if(info.status[u] < 0)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "bitshuffle filter failed")
+
+    /* Finish the output: pack the compressed blocks behind the header,
+     * and copy the elements that don't fill a group of 8 */
+    if(info.lz4 && !info.reverse) {
+        for(u = 0; u < 8; u++)
+            outbuf[u] = (unsigned char)((uint64_t)nbytes_uncomp >> (8 * (7 - u)));
+        for(u = 0; u < 4; u++)
+            outbuf[8 + u] = (unsigned char)((info.block_size * info.elem_size) >> (8 * (3 - u)));
+        for(u = 0; u < info.nblocks; u++) {
+            HDmemmove(outbuf + pos, outbuf + info.offsets[u], 4 + info.csizes[u]);
+            pos += 4 + info.csizes[u];
+        } /* end for */
+        HDmemcpy(outbuf + pos, src + (nbytes_uncomp - nleftover), nleftover);
+        out_nbytes = pos + nleftover;
+    } /* end if */
+    else if(info.lz4) {
+        HDmemcpy(outbuf + (nbytes_uncomp - nleftover), src + pos, nleftover);
+        out_nbytes = nbytes_uncomp;
+    } /* end if */
+    else {
+        HDmemcpy(outbuf + (nbytes - nleftover), src + (nbytes - nleftover), nleftover);
+        out_nbytes = nbytes;
+    } /* end else */
+
+    /* Free the input buffer */
+    H5MM_xfree(*buf);
+
+    /* Set the buffer information to return */
+    *buf = outbuf;
+    outbuf = NULL;
+    *buf_size = out_alloc;
+
+    /* Set the return value */
+    ret_value = out_nbytes;
+
+done:
+    if(info.status && info.status != &status)
+        H5MM_xfree(info.status);
+    H5MM_xfree(offsets);
+    H5MM_xfree(outbuf);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_filter_bitshuffle() */
+
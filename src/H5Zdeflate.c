@@ -35,9 +35,25 @@
 # include H5_ZLIB_HEADER /* "zlib.h" */
 #endif
 
+/* Local macros */
+#define H5Z_DEFLATE_POOL_MAX    8       /* Most idle streams kept of each kind */
+
+/* Local typedefs */
+
+/* A zlib stream kept between chunks, so its state doesn't have to be
+ * allocated and initialized for every chunk */
+typedef struct H5Z_deflate_strm_t {
+    z_stream z_strm;                    /* zlib stream */
+    int level;                          /* Compression level (compression streams only) */
+    size_t last_nbytes;                 /* Output size of the last chunk */
+    struct H5Z_deflate_strm_t *next;    /* Next idle stream in the pool */
+} H5Z_deflate_strm_t;
+
 /* Local function prototypes */
 static size_t H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
     const unsigned cd_values[], size_t nbytes, size_t *buf_size, void **buf);
+static H5Z_deflate_strm_t *H5Z_deflate_get_strm(hbool_t inflating, int level);
+static void H5Z_deflate_put_strm(H5Z_deflate_strm_t *strm, hbool_t inflating, hbool_t reuse);
 
 /* This message derives from H5Z */
 const H5Z_class2_t H5Z_DEFLATE[1] = {{
@@ -53,12 +69,224 @@ const H5Z_class2_t H5Z_DEFLATE[1] = {{
 
 #define H5Z_DEFLATE_SIZE_ADJUST(s) (HDceil(((double)(s)) * (double)1.001f) + 12)
 
+/* Idle decompression and compression streams.  Filters may run on several
+ * threads at once (see H5Z_pipeline_batch), so the pools are locked when
+ * that is possible. */
+static H5Z_deflate_strm_t *H5Z_inflate_pool_g = NULL;
+static H5Z_deflate_strm_t *H5Z_deflate_pool_g = NULL;
+static size_t H5Z_inflate_pool_n_g = 0;
+static size_t H5Z_deflate_pool_n_g = 0;
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+static H5TS_mutex_simple_t H5Z_deflate_pool_lock_g;
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__deflate_init
+ *
+ * Purpose:	Set up the pools of zlib streams.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5Z__deflate_init(void)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+    H5TS_mutex_init(&H5Z_deflate_pool_lock_g);
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__deflate_init() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__deflate_term
+ *
+ * Purpose:	Release the idle zlib streams.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5Z__deflate_term(void)
+{
+    H5Z_deflate_strm_t *strm;           /* Stream to release */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    while(NULL != (strm = H5Z_inflate_pool_g)) {
+        H5Z_inflate_pool_g = strm->next;
+        (void)inflateEnd(&strm->z_strm);
+        H5MM_xfree(strm);
+    } /* end while */
+    while(NULL != (strm = H5Z_deflate_pool_g)) {
+        H5Z_deflate_pool_g = strm->next;
+        (void)deflateEnd(&strm->z_strm);
+        H5MM_xfree(strm);
+    } /* end while */
+    H5Z_inflate_pool_n_g = H5Z_deflate_pool_n_g = 0;
+
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+#ifdef H5_HAVE_WIN_THREADS
+    DeleteCriticalSection(&H5Z_deflate_pool_lock_g);
+#else /* H5_HAVE_WIN_THREADS */
+    pthread_mutex_destroy(&H5Z_deflate_pool_lock_g);
+#endif /* H5_HAVE_WIN_THREADS */
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__deflate_term() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_deflate_get_strm
+ *
+ * Purpose:	Take a decompression stream (INFLATING) or a compression
+ *              stream for LEVEL from its pool, ready for a new chunk, or
+ *              create one if the pool is empty.
+ *
+ *              The streams are allocated with H5MM rather than a free
+ *              list, since they may be taken on a worker thread.
+ *
+ * Return:	Success:	Pointer to the stream
+ *		Failure:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5Z_deflate_strm_t *
+H5Z_deflate_get_strm(hbool_t inflating, int level)
+{
+    H5Z_deflate_strm_t *strm;           /* Stream to use */
+    H5Z_deflate_strm_t *ret_value = NULL;   /* Return value */
+
+    FUNC_ENTER_STATIC
+
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+    H5TS_mutex_lock_simple(&H5Z_deflate_pool_lock_g);
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
+    if(inflating) {
+        if(NULL != (strm = H5Z_inflate_pool_g)) {
+            H5Z_inflate_pool_g = strm->next;
+            H5Z_inflate_pool_n_g--;
+        } /* end if */
+    } /* end if */
+    else {
+        if(NULL != (strm = H5Z_deflate_pool_g)) {
+            H5Z_deflate_pool_g = strm->next;
+            H5Z_deflate_pool_n_g--;
+        } /* end if */
+    } /* end else */
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+    H5TS_mutex_unlock_simple(&H5Z_deflate_pool_lock_g);
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
+
+    if(strm) {
+        /* Reset the stream for the next chunk */
+        if(inflating) {
+            if(Z_OK != inflateReset(&strm->z_strm))
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, NULL, "inflateReset() failed")
+        } /* end if */
+        else {
+            if(Z_OK != deflateReset(&strm->z_strm))
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, NULL, "deflateReset() failed")
+            if(strm->level != level) {
+                if(Z_OK != deflateParams(&strm->z_strm, level, Z_DEFAULT_STRATEGY))
+                    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, NULL, "deflateParams() failed")
+                strm->level = level;
+            } /* end if */
+        } /* end else */
+    } /* end if */
+    else {
+        if(NULL == (strm = (H5Z_deflate_strm_t *)H5MM_calloc(sizeof(H5Z_deflate_strm_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for zlib stream")
+        if(inflating) {
+            if(Z_OK != inflateInit(&strm->z_strm))
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, NULL, "inflateInit() failed")
+        } /* end if */
+        else {
+            if(Z_OK != deflateInit(&strm->z_strm, level))
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, NULL, "deflateInit() failed")
+            strm->level = level;
+        } /* end else */
+    } /* end else */
+
+    ret_value = strm;
+    strm = NULL;
+
+done:
+    if(strm)
+        H5Z_deflate_put_strm(strm, inflating, FALSE);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_deflate_get_strm() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_deflate_put_strm
+ *
+ * Purpose:	Return a stream taken with H5Z_deflate_get_strm to its pool,
+ *              or release it if it can't be REUSEd or the pool is full.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z_deflate_put_strm(H5Z_deflate_strm_t *strm, hbool_t inflating, hbool_t reuse)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(strm);
+
+    /* Don't hold on to the chunk buffers */
+    strm->z_strm.next_in = NULL;
+    strm->z_strm.next_out = NULL;
+
+    if(reuse) {
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+        H5TS_mutex_lock_simple(&H5Z_deflate_pool_lock_g);
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
+        if(inflating && H5Z_inflate_pool_n_g < H5Z_DEFLATE_POOL_MAX) {
+            strm->next = H5Z_inflate_pool_g;
+            H5Z_inflate_pool_g = strm;
+            H5Z_inflate_pool_n_g++;
+            strm = NULL;
+        } /* end if */
+        else if(!inflating && H5Z_deflate_pool_n_g < H5Z_DEFLATE_POOL_MAX) {
+            strm->next = H5Z_deflate_pool_g;
+            H5Z_deflate_pool_g = strm;
+            H5Z_deflate_pool_n_g++;
+            strm = NULL;
+        } /* end if */
+#ifdef H5Z_HAVE_PIPELINE_THREADS
+        H5TS_mutex_unlock_simple(&H5Z_deflate_pool_lock_g);
+#endif /* H5Z_HAVE_PIPELINE_THREADS */
+    } /* end if */
+
+    if(strm) {
+        if(inflating)
+            (void)inflateEnd(&strm->z_strm);
+        else
+            (void)deflateEnd(&strm->z_strm);
+        H5MM_xfree(strm);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z_deflate_put_strm() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Z_filter_deflate
  *
  * Purpose:	Implement an I/O filter around the 'deflate' algorithm in
- *              libz
+ *              libz.  The zlib streams are reset and reused across chunks
+ *              (see H5Z_deflate_get_strm), and the uncompressed buffer
+ *              starts at the size of the last chunk the stream handled.
  *
  * Return:	Success: Size of buffer filtered
  *		Failure: 0
@@ -75,6 +303,9 @@ H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
 		    const unsigned cd_values[], size_t nbytes,
 		    size_t *buf_size, void **buf)
 {
+    H5Z_deflate_strm_t *strm = NULL;    /* zlib stream */
+    hbool_t     inflating = (hbool_t)((flags & H5Z_FLAG_REVERSE) != 0);
+    hbool_t     reuse_strm = FALSE;     /* Whether the stream can be pooled again */
     void	*outbuf = NULL;         /* Pointer to new buffer */
     int		status;                 /* Status from zlib operation */
     size_t	ret_value = 0;          /* Return value */
@@ -90,60 +321,71 @@ H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
     if (cd_nelmts!=1 || cd_values[0]>9)
 	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, 0, "invalid deflate aggression level")
 
-    if (flags & H5Z_FLAG_REVERSE) {
+    if (inflating) {
 	/* Input; uncompress */
-	z_stream	z_strm;                 /* zlib parameters */
-	size_t		nalloc = *buf_size;     /* Number of bytes for output (compressed) buffer */
+	z_stream	*z_strm;                /* zlib parameters */
+	size_t		nalloc;                 /* Number of bytes for output (uncompressed) buffer */
+
+        /* Get a decompression stream */
+        if(NULL == (strm = H5Z_deflate_get_strm(TRUE, 0)))
+	    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "can't get zlib stream")
+        z_strm = &strm->z_strm;
 
-        /* Allocate space for the compressed buffer */
+        /* Chunks of a dataset usually have the same size, so start with
+         * the size of the last chunk this stream uncompressed */
+        nalloc = MAX(*buf_size, strm->last_nbytes);
+
+        /* Allocate space for the uncompressed buffer */
 	if (NULL==(outbuf = H5MM_malloc(nalloc)))
 	    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for deflate uncompression")
 
         /* Set the uncompression parameters */
-	HDmemset(&z_strm, 0, sizeof(z_strm));
-	z_strm.next_in = (Bytef *)*buf;
-        H5_CHECKED_ASSIGN(z_strm.avail_in, unsigned, nbytes, size_t);
-	z_strm.next_out = (Bytef *)outbuf;
-        H5_CHECKED_ASSIGN(z_strm.avail_out, unsigned, nalloc, size_t);
-
-        /* Initialize the uncompression routines */
-	if (Z_OK!=inflateInit(&z_strm))
-	    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "inflateInit() failed")
+	z_strm->next_in = (Bytef *)*buf;
+        H5_CHECKED_ASSIGN(z_strm->avail_in, unsigned, nbytes, size_t);
+	z_strm->next_out = (Bytef *)outbuf;
+        H5_CHECKED_ASSIGN(z_strm->avail_out, unsigned, nalloc, size_t);
 
         /* Loop to uncompress the buffer */
 	do {
             /* Uncompress some data */
-	    status = inflate(&z_strm, Z_SYNC_FLUSH);
+	    status = inflate(z_strm, Z_SYNC_FLUSH);
 
             /* Check if we are done uncompressing data */
 	    if (Z_STREAM_END==status)
                 break;	/*done*/
 
             /* Check for error */
-	    if (Z_OK!=status) {
-		(void)inflateEnd(&z_strm);
+	    if (Z_OK!=status)
 		HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "inflate() failed")
-	    }
             else {
                 /* If we're not done and just ran out of buffer space, get more */
-                if(0 == z_strm.avail_out) {
+                if(0 == z_strm->avail_out) {
                     void	*new_outbuf;         /* Pointer to new output buffer */
 
                     /* Allocate a buffer twice as big */
                     nalloc *= 2;
-                    if(NULL == (new_outbuf = H5MM_realloc(outbuf, nalloc))) {
-                        (void)inflateEnd(&z_strm);
+                    if(NULL == (new_outbuf = H5MM_realloc(outbuf, nalloc)))
                         HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for deflate uncompression")
-                    } /* end if */
                     outbuf = new_outbuf;
 
                     /* Update pointers to buffer for next set of uncompressed data */
-                    z_strm.next_out = (unsigned char*)outbuf + z_strm.total_out;
-                    z_strm.avail_out = (uInt)(nalloc - z_strm.total_out);
+                    z_strm->next_out = (unsigned char*)outbuf + z_strm->total_out;
+                    z_strm->avail_out = (uInt)(nalloc - z_strm->total_out);
                 } /* end if */
             } /* end else */
 	} while(status==Z_OK);
 
+        /* Don't keep much more memory than needed when the chunk was
+         * smaller than the last one */
+        if(z_strm->total_out > 0 && z_strm->total_out < nalloc / 2) {
+            void	*new_outbuf;         /* Pointer to new output buffer */
+
+            if(NULL != (new_outbuf = H5MM_realloc(outbuf, (size_t)z_strm->total_out))) {
+                outbuf = new_outbuf;
+                nalloc = z_strm->total_out;
+            } /* end if */
+        } /* end if */
+
         /* Free the input buffer */
 	H5MM_xfree(*buf);
 
@@ -151,10 +393,9 @@ H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
 	*buf = outbuf;
 	outbuf = NULL;
 	*buf_size = nalloc;
-	ret_value = z_strm.total_out;
-
-        /* Finish uncompressing the stream */
-	(void)inflateEnd(&z_strm);
+	ret_value = z_strm->total_out;
+        strm->last_nbytes = ret_value;
+        reuse_strm = TRUE;
     } /* end if */
     else {
 	/*
@@ -162,29 +403,35 @@ H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
 	 * input.  The library doesn't provide in-place compression, so we
 	 * must allocate a separate buffer for the result.
 	 */
-	const Bytef *z_src = (const Bytef*)(*buf);
-	Bytef	    *z_dst;		/*destination buffer		*/
-	uLongf	     z_dst_nbytes = (uLongf)H5Z_DEFLATE_SIZE_ADJUST(nbytes);
-	uLong	     z_src_nbytes = (uLong)nbytes;
+	z_stream    *z_strm;            /* zlib parameters */
+	size_t	     z_dst_nbytes = (size_t)H5Z_DEFLATE_SIZE_ADJUST(nbytes);
         int          aggression;     /* Compression aggression setting */
 
         /* Set the compression aggression level */
         H5_CHECKED_ASSIGN(aggression, int, cd_values[0], unsigned);
 
+        /* Get a compression stream for the level */
+        if(NULL == (strm = H5Z_deflate_get_strm(FALSE, aggression)))
+	    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "can't get zlib stream")
+        z_strm = &strm->z_strm;
+
         /* Allocate output (compressed) buffer */
 	if(NULL == (outbuf = H5MM_malloc(z_dst_nbytes)))
 	    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "unable to allocate deflate destination buffer")
-        z_dst = (Bytef *)outbuf;
 
         /* Perform compression from the source to the destination buffer */
-	status = compress2(z_dst, &z_dst_nbytes, z_src, z_src_nbytes, aggression);
+	z_strm->next_in = (Bytef *)*buf;
+        H5_CHECKED_ASSIGN(z_strm->avail_in, unsigned, nbytes, size_t);
+	z_strm->next_out = (Bytef *)outbuf;
+        H5_CHECKED_ASSIGN(z_strm->avail_out, unsigned, z_dst_nbytes, size_t);
+	status = deflate(z_strm, Z_FINISH);
 
         /* Check for various zlib errors */
-	if(Z_BUF_ERROR == status)
+	if(Z_OK == status || Z_BUF_ERROR == status)
 	    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "overflow")
 	else if(Z_MEM_ERROR == status)
 	    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "deflate memory error")
-	else if(Z_OK != status)
+	else if(Z_STREAM_END != status)
 	    HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "other deflate error")
         /* Successfully uncompressed the buffer */
         else {
@@ -195,11 +442,14 @@ H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
 	    *buf = outbuf;
 	    outbuf = NULL;
 	    *buf_size = nbytes;
-	    ret_value = z_dst_nbytes;
+	    ret_value = z_strm->total_out;
+            reuse_strm = TRUE;
 	} /* end else */
     } /* end else */
 
 done:
+    if(strm)
+        H5Z_deflate_put_strm(strm, inflating, reuse_strm);
     if(outbuf)
         H5MM_xfree(outbuf);
     FUNC_LEAVE_NOAPI(ret_value)
@@ -23,6 +23,16 @@
 /* Include private header file */
 #include "H5Zprivate.h"          /* Filter functions                */
 
+/**************************/
+/* Package Private Macros */
+/**************************/
+
+/* Pipelines may only be run on worker threads when each thread has its own
+ * error stack and the filters don't update any other library state */
+#if defined(H5_HAVE_THREADSAFE) && !defined(H5Z_DEBUG) && !defined(H5_MEMORY_ALLOC_SANITY_CHECK)
+#define H5Z_HAVE_PIPELINE_THREADS
+#endif
+
 /********************/
 /* Internal filters */
 /********************/
@@ -39,6 +49,9 @@ H5_DLLVAR H5Z_class2_t H5Z_NBIT[1];
 /* Scale/offset filter */
 H5_DLLVAR H5Z_class2_t H5Z_SCALEOFFSET[1];
 
+/* Bitshuffle filter */
+H5_DLLVAR const H5Z_class2_t H5Z_BITSHUFFLE[1];
+
 /********************/
 /* External filters */
 /********************/
@@ -53,5 +66,26 @@ H5_DLLVAR const H5Z_class2_t H5Z_DEFLATE[1];
 H5_DLLVAR H5Z_class2_t H5Z_SZIP[1];
 #endif /* H5_HAVE_FILTER_SZIP */
 
+/*****************************/
+/* Package Private Variables */
+/*****************************/
+
+/* Number of threads a filter may use for the buffer it is working on */
+H5_DLLVAR unsigned H5Z_filter_threads_g;
+
+/******************************/
+/* Package Private Prototypes */
+/******************************/
+
+/* Byte transposition shared by the shuffle and bitshuffle filters */
+H5_DLL void H5Z__shuffle_bytes(const unsigned char *src, unsigned char *dest,
+    size_t bytesoftype, size_t numofelements, hbool_t reverse);
+
+/* Pools of zlib streams for the deflate filter */
+#ifdef H5_HAVE_FILTER_DEFLATE
+H5_DLL void H5Z__deflate_init(void);
+H5_DLL void H5Z__deflate_term(void);
+#endif /* H5_HAVE_FILTER_DEFLATE */
+
 #endif /* _H5Zpkg_H */
 
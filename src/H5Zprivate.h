@@ -61,6 +61,23 @@ typedef struct H5Z_filter_info_t {
     unsigned		*cd_values;	/*client data values		     */
 } H5Z_filter_info_t;
 
+/* Operation on a buffer once H5Z_pipeline_batch() has filtered it, run on
+ * the same thread as the filters.  It must not call back into the library
+ * beyond routines that use no shared state.
+ */
+typedef herr_t (*H5Z_pipeline_op_t)(const void *buf, size_t nbytes, void *op_data);
+
+/* Buffer to run through the filter pipeline with H5Z_pipeline_batch() */
+typedef struct H5Z_pipeline_job_t {
+    unsigned            filter_mask;    /*excluded filters (in,out)          */
+    size_t              nbytes;         /*bytes of data in buffer (in,out)   */
+    size_t              buf_size;       /*allocated size of buffer (in,out)  */
+    void                *buf;           /*buffer to filter (in,out)          */
+    H5Z_pipeline_op_t   op;             /*operation on filtered buffer, or NULL (in) */
+    void                *op_data;       /*user data for OP (in)              */
+    herr_t              status;         /*result of the pipeline and OP (out) */
+} H5Z_pipeline_job_t;
+
 /*****************************/
 /* Library-private Variables */
 /*****************************/
@@ -83,6 +100,9 @@ H5_DLL herr_t H5Z_pipeline(const struct H5O_pline_t *pline,
  			    H5Z_EDC_t edc_read, H5Z_cb_t cb_struct,
 			    size_t *nbytes/*in,out*/, size_t *buf_size/*in,out*/,
                             void **buf/*in,out*/);
+H5_DLL herr_t H5Z_pipeline_batch(const struct H5O_pline_t *pline,
+                            unsigned flags, H5Z_EDC_t edc_read, H5Z_cb_t cb_struct,
+                            unsigned nthreads, size_t njobs, H5Z_pipeline_job_t *jobs);
 H5_DLL H5Z_class2_t *H5Z_find(H5Z_filter_t id);
 H5_DLL herr_t H5Z_can_apply(hid_t dcpl_id, hid_t type_id);
 H5_DLL herr_t H5Z_set_local(hid_t dcpl_id, hid_t type_id);
@@ -42,6 +42,7 @@ typedef int H5Z_filter_t;
 #define H5Z_FILTER_NBIT         5       /*nbit compression              */
 #define H5Z_FILTER_SCALEOFFSET  6       /*scale+offset compression      */
 #define H5Z_FILTER_RESERVED     256	/*filter ids below this value are reserved for library use */
+#define H5Z_FILTER_BITSHUFFLE   32008   /*bitshuffle, optionally with LZ4 (registered id of the external filter) */
 
 #define H5Z_FILTER_MAX		65535	/*maximum filter id		*/
 
@@ -79,6 +80,16 @@ typedef int H5Z_filter_t;
 #define H5Z_SHUFFLE_USER_NPARMS    0    /* Number of parameters that users can set */
 #define H5Z_SHUFFLE_TOTAL_NPARMS   1    /* Total number of parameters for filter */
 
+/* Macros for the bitshuffle filter */
+#define H5Z_BSHUF_TOTAL_NPARMS      5   /* Number of parameters set by the library */
+#define H5Z_BSHUF_PARM_VERS_MAJOR   0   /* "Local" parameter for the format's major version */
+#define H5Z_BSHUF_PARM_VERS_MINOR   1   /* "Local" parameter for the format's minor version */
+#define H5Z_BSHUF_PARM_ELEM_SIZE    2   /* "Local" parameter for the element size */
+#define H5Z_BSHUF_PARM_BLOCK_SIZE   3   /* "User" parameter for elements per block (0 = default) */
+#define H5Z_BSHUF_PARM_COMPRESS     4   /* "User" parameter for the compression (H5Z_BSHUF_COMPRESS_*) */
+#define H5Z_BSHUF_COMPRESS_NONE     0   /* Bitshuffle only */
+#define H5Z_BSHUF_COMPRESS_LZ4      2   /* Bitshuffle followed by LZ4 on each block */
+
 /* Macros for the szip filter */
 #define H5Z_SZIP_USER_NPARMS    2       /* Number of parameters that users can set */
 #define H5Z_SZIP_TOTAL_NPARMS   4       /* Total number of parameters for filter */
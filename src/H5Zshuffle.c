@@ -24,6 +24,25 @@
 #include "H5Tprivate.h"		/* Datatypes         			*/
 #include "H5Zpkg.h"		/* Data filters				*/
 
+/*
+ * SIMD transpose kernels are used for the common power-of-two element sizes
+ * when the compiler can target them.  SSE2 is part of the x86-64 baseline, so
+ * it is used whenever the compiler says it is available; the AVX2 kernels are
+ * compiled with a function-level target attribute and only called when the
+ * CPU reports AVX2 support at run time.
+ */
+#if defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#define H5Z_SHUFFLE_SSE2
+#include <emmintrin.h>
+#if !defined(__INTEL_COMPILER) && \
+        ((defined(__clang__) && __clang_major__ >= 4) || \
+         (!defined(__clang__) && defined(__GNUC__) && \
+          (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#define H5Z_SHUFFLE_AVX2
+#include <immintrin.h>
+#endif
+#endif /* __SSE2__ */
+
 /* Local function prototypes */
 static herr_t H5Z_set_local_shuffle(hid_t dcpl_id, hid_t type_id, hid_t space_id);
 static size_t H5Z_filter_shuffle(unsigned flags, size_t cd_nelmts,
@@ -43,6 +62,16 @@ const H5Z_class2_t H5Z_SHUFFLE[1] = {{
 
 /* Local macros */
 #define H5Z_SHUFFLE_PARM_SIZE      0       /* "Local" parameter for shuffling size */
+#define H5Z_SHUFFLE_MAX_SIMD_SIZE  16      /* Largest element size with a SIMD kernel */
+
+#ifdef H5Z_SHUFFLE_SSE2
+static size_t H5Z_shuffle_sse2(const unsigned char *src, unsigned char *dest,
+    size_t bytesoftype, size_t numofelements, hbool_t reverse);
+#endif /* H5Z_SHUFFLE_SSE2 */
+#ifdef H5Z_SHUFFLE_AVX2
+__attribute__((target("avx2"))) static size_t H5Z_shuffle_avx2(const unsigned char *src, unsigned char *dest,
+    size_t bytesoftype, size_t numofelements, hbool_t reverse);
+#endif /* H5Z_SHUFFLE_AVX2 */
 
 
 /*-------------------------------------------------------------------------
@@ -97,6 +126,338 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5Z_set_local_shuffle() */
 
+#ifdef H5Z_SHUFFLE_SSE2
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_shuffle_sse2
+ *
+ * Purpose:	[Un]shuffle the leading elements of a buffer sixteen at a
+ *              time with SSE2 byte interleaves.
+ *
+ *              Sixteen elements of BYTESOFTYPE bytes occupy BYTESOFTYPE
+ *              vector registers.  Each round of unpacklo/unpackhi pairs
+ *              register K with register K+BYTESOFTYPE/2, which rotates the
+ *              (element, byte) bit index of every byte left by one bit.
+ *              Four rounds turn elements into byte streams (shuffle) and
+ *              log2(BYTESOFTYPE) rounds turn byte streams back into
+ *              elements (unshuffle).
+ *
+ * Return:	Number of elements processed (a multiple of 16, possibly 0).
+ *              The caller handles the remaining elements.
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z_shuffle_sse2(const unsigned char *src, unsigned char *dest,
+    size_t bytesoftype, size_t numofelements, hbool_t reverse)
+{
+    __m128i vec_a[H5Z_SHUFFLE_MAX_SIMD_SIZE];   /* Working registers */
+    __m128i vec_b[H5Z_SHUFFLE_MAX_SIMD_SIZE];   /* Working registers */
+    size_t nvec = numofelements & ~(size_t)15;  /* Elements handled here */
+    size_t half = bytesoftype / 2;      /* Distance between paired registers */
+    unsigned nrounds;                   /* Number of interleave rounds */
+    size_t elmt, k;                     /* Local index variables */
+    unsigned r;                         /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Only power-of-two element sizes map onto the interleave network */
+    switch(bytesoftype) {
+        case 2:
+            nrounds = reverse ? 1 : 4;
+            break;
+        case 4:
+            nrounds = reverse ? 2 : 4;
+            break;
+        case 8:
+            nrounds = reverse ? 3 : 4;
+            break;
+        case 16:
+            nrounds = 4;
+            break;
+        default:
+            nvec = 0;
+            nrounds = 0;
+            break;
+    } /* end switch */
+
+    for(elmt = 0; elmt < nvec; elmt += 16) {
+        __m128i *in = vec_a, *out = vec_b, *tmp;
+
+        if(reverse)
+            for(k = 0; k < bytesoftype; k++)
+                in[k] = _mm_loadu_si128((const __m128i *)(src + k * numofelements + elmt));
+        else
+            for(k = 0; k < bytesoftype; k++)
+                in[k] = _mm_loadu_si128((const __m128i *)(src + elmt * bytesoftype + k * 16));
+
+        for(r = 0; r < nrounds; r++) {
+            for(k = 0; k < half; k++) {
+                out[2 * k] = _mm_unpacklo_epi8(in[k], in[k + half]);
+                out[2 * k + 1] = _mm_unpackhi_epi8(in[k], in[k + half]);
+            } /* end for */
+            tmp = in; in = out; out = tmp;
+        } /* end for */
+
+        if(reverse)
+            for(k = 0; k < bytesoftype; k++)
+                _mm_storeu_si128((__m128i *)(dest + elmt * bytesoftype + k * 16), in[k]);
+        else
+            for(k = 0; k < bytesoftype; k++)
+                _mm_storeu_si128((__m128i *)(dest + k * numofelements + elmt), in[k]);
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5Z_shuffle_sse2() */
+#endif /* H5Z_SHUFFLE_SSE2 */
+
+#ifdef H5Z_SHUFFLE_AVX2
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_shuffle_avx2
+ *
+ * Purpose:	AVX2 version of H5Z_shuffle_sse2, handling 32 elements at a
+ *              time.  The 256-bit interleaves work on each 128-bit lane
+ *              separately, so the low lanes carry elements 0-15 of the
+ *              block and the high lanes carry elements 16-31 through the
+ *              same network.
+ *
+ * Return:	Number of elements processed (a multiple of 32, possibly 0).
+ *              The caller handles the remaining elements.
+ *
+ *-------------------------------------------------------------------------
+ */
+__attribute__((target("avx2"))) static size_t
+H5Z_shuffle_avx2(const unsigned char *src, unsigned char *dest,
+    size_t bytesoftype, size_t numofelements, hbool_t reverse)
+{
+    __m256i vec_a[H5Z_SHUFFLE_MAX_SIMD_SIZE];   /* Working registers */
+    __m256i vec_b[H5Z_SHUFFLE_MAX_SIMD_SIZE];   /* Working registers */
+    size_t nvec = numofelements & ~(size_t)31;  /* Elements handled here */
+    size_t half = bytesoftype / 2;      /* Distance between paired registers */
+    unsigned nrounds;                   /* Number of interleave rounds */
+    size_t elmt, k;                     /* Local index variables */
+    unsigned r;                         /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Only power-of-two element sizes map onto the interleave network */
+    switch(bytesoftype) {
+        case 2:
+            nrounds = reverse ? 1 : 4;
+            break;
+        case 4:
+            nrounds = reverse ? 2 : 4;
+            break;
+        case 8:
+            nrounds = reverse ? 3 : 4;
+            break;
+        case 16:
+            nrounds = 4;
+            break;
+        default:
+            nvec = 0;
+            nrounds = 0;
+            break;
+    } /* end switch */
+
+    for(elmt = 0; elmt < nvec; elmt += 32) {
+        __m256i *in = vec_a, *out = vec_b, *tmp;
+
+        if(reverse)
+            for(k = 0; k < bytesoftype; k++)
+                in[k] = _mm256_loadu_si256((const __m256i *)(src + k * numofelements + elmt));
+        else {
+            const unsigned char *lo = src + elmt * bytesoftype;
+            const unsigned char *hi = lo + 16 * bytesoftype;
+
+            for(k = 0; k < bytesoftype; k++)
+                in[k] = _mm256_inserti128_si256(
+                        _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(lo + k * 16))),
+                        _mm_loadu_si128((const __m128i *)(hi + k * 16)), 1);
+        } /* end else */
+
+        for(r = 0; r < nrounds; r++) {
+            for(k = 0; k < half; k++) {
+                out[2 * k] = _mm256_unpacklo_epi8(in[k], in[k + half]);
+                out[2 * k + 1] = _mm256_unpackhi_epi8(in[k], in[k + half]);
+            } /* end for */
+            tmp = in; in = out; out = tmp;
+        } /* end for */
+
+        if(reverse) {
+            unsigned char *lo = dest + elmt * bytesoftype;
+            unsigned char *hi = lo + 16 * bytesoftype;
+
+            for(k = 0; k < bytesoftype; k++) {
+                _mm_storeu_si128((__m128i *)(lo + k * 16), _mm256_castsi256_si128(in[k]));
+                _mm_storeu_si128((__m128i *)(hi + k * 16), _mm256_extracti128_si256(in[k], 1));
+            } /* end for */
+        } /* end if */
+        else
+            for(k = 0; k < bytesoftype; k++)
+                _mm256_storeu_si256((__m256i *)(dest + k * numofelements + elmt), in[k]);
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5Z_shuffle_avx2() */
+#endif /* H5Z_SHUFFLE_AVX2 */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__shuffle_bytes
+ *
+ * Purpose:	Transpose NUMOFELEMENTS elements of BYTESOFTYPE bytes from
+ *              SRC into DEST.  Shuffling stores byte I of element J at
+ *              I*NUMOFELEMENTS+J; unshuffling (REVERSE) undoes that.
+ *
+ *              For 2, 4, 8 and 16-byte elements the bulk of the buffer is
+ *              transposed with AVX2 or SSE2 kernels when the CPU supports
+ *              them; the remaining elements go through the scalar loops,
+ *              which produce byte-identical output.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5Z__shuffle_bytes(const unsigned char *src, unsigned char *dest,
+    size_t bytesoftype, size_t numofelements, hbool_t reverse)
+{
+#ifdef H5Z_SHUFFLE_AVX2
+    static int have_avx2 = -1;  /* Whether the CPU supports AVX2 (-1 = unknown) */
+#endif /* H5Z_SHUFFLE_AVX2 */
+    const unsigned char *_src=NULL;     /* Alias for source buffer */
+    unsigned char *_dest=NULL;  /* Alias for destination buffer */
+    size_t nsimd = 0;           /* Number of elements handled by SIMD kernels */
+    size_t nscalar;             /* Number of elements left for the scalar loops */
+    size_t i;                   /* Local index variables */
+#ifdef NO_DUFFS_DEVICE
+    size_t j;                   /* Local index variable */
+#endif /* NO_DUFFS_DEVICE */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    HDassert(src);
+    HDassert(dest);
+
+    /* Transpose as many elements as possible with the vector kernels */
+#ifdef H5Z_SHUFFLE_AVX2
+    if(have_avx2 < 0) {
+        __builtin_cpu_init();
+        have_avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+    } /* end if */
+    if(have_avx2)
+        nsimd = H5Z_shuffle_avx2(src, dest, bytesoftype, numofelements, reverse);
+#endif /* H5Z_SHUFFLE_AVX2 */
+#ifdef H5Z_SHUFFLE_SSE2
+    if(nsimd == 0)
+        nsimd = H5Z_shuffle_sse2(src, dest, bytesoftype, numofelements, reverse);
+#endif /* H5Z_SHUFFLE_SSE2 */
+    nscalar = numofelements - nsimd;
+
+    if(reverse) {
+        /* Input; unshuffle */
+        for(i=0; nscalar > 0 && i<bytesoftype; i++) {
+            _src=src+i*numofelements+nsimd;
+            _dest=dest+nsimd*bytesoftype+i;
+#define DUFF_GUTS							    \
+    *_dest=*_src++;                             \
+    _dest+=bytesoftype;
+#ifdef NO_DUFFS_DEVICE
+            j = nscalar;
+            while(j > 0) {
+                DUFF_GUTS;
+
+                j--;
+            } /* end for */
+#else /* NO_DUFFS_DEVICE */
+        {
+            size_t duffs_index; /* Counting index for Duff's device */
+
+            duffs_index = (nscalar + 7) / 8;
+            switch (nscalar % 8) {
+                default:
+                    HDassert(0 && "This Should never be executed!");
+                    break;
+                case 0:
+                    do
+                      {
+                        DUFF_GUTS
+                case 7:
+                        DUFF_GUTS
+                case 6:
+                        DUFF_GUTS
+                case 5:
+                        DUFF_GUTS
+                case 4:
+                        DUFF_GUTS
+                case 3:
+                        DUFF_GUTS
+                case 2:
+                        DUFF_GUTS
+                case 1:
+                        DUFF_GUTS
+                  } while (--duffs_index > 0);
+            } /* end switch */
+        }
+#endif /* NO_DUFFS_DEVICE */
+#undef DUFF_GUTS
+        } /* end for */
+    } /* end if */
+    else {
+        /* Output; shuffle */
+        for(i=0; nscalar > 0 && i<bytesoftype; i++) {
+            _src=src+nsimd*bytesoftype+i;
+            _dest=dest+i*numofelements+nsimd;
+#define DUFF_GUTS							    \
+    *_dest++=*_src;                             \
+    _src+=bytesoftype;
+#ifdef NO_DUFFS_DEVICE
+            j = nscalar;
+            while(j > 0) {
+                DUFF_GUTS;
+
+                j--;
+            } /* end for */
+#else /* NO_DUFFS_DEVICE */
+        {
+            size_t duffs_index; /* Counting index for Duff's device */
+
+            duffs_index = (nscalar + 7) / 8;
+            switch (nscalar % 8) {
+                default:
+                    HDassert(0 && "This Should never be executed!");
+                    break;
+                case 0:
+                    do
+                      {
+                        DUFF_GUTS
+                case 7:
+                        DUFF_GUTS
+                case 6:
+                        DUFF_GUTS
+                case 5:
+                        DUFF_GUTS
+                case 4:
+                        DUFF_GUTS
+                case 3:
+                        DUFF_GUTS
+                case 2:
+                        DUFF_GUTS
+                case 1:
+                        DUFF_GUTS
+                  } while (--duffs_index > 0);
+            } /* end switch */
+        }
+#endif /* NO_DUFFS_DEVICE */
+#undef DUFF_GUTS
+        } /* end for */
+    } /* end else */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__shuffle_bytes() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Z_filter_shuffle
@@ -125,14 +486,8 @@ H5Z_filter_shuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
                    size_t nbytes, size_t *buf_size, void **buf)
 {
     void *dest = NULL;          /* Buffer to deposit [un]shuffled bytes into */
-    unsigned char *_src=NULL;   /* Alias for source buffer */
-    unsigned char *_dest=NULL;  /* Alias for destination buffer */
     unsigned bytesoftype;       /* Number of bytes per element */
     size_t numofelements;       /* Number of elements in buffer */
-    size_t i;                   /* Local index variables */
-#ifdef NO_DUFFS_DEVICE
-    size_t j;                   /* Local index variable */
-#endif /* NO_DUFFS_DEVICE */
     size_t leftover;            /* Extra bytes at end of buffer */
     size_t ret_value = 0;       /* Return value */
 
@@ -157,122 +512,16 @@ H5Z_filter_shuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
         if (NULL==(dest = H5MM_malloc(nbytes)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for shuffle buffer")
 
-        if(flags & H5Z_FLAG_REVERSE) {
-            /* Get the pointer to the source buffer */
-            _src =(unsigned char *)(*buf);
-
-            /* Input; unshuffle */
-            for(i=0; i<bytesoftype; i++) {
-                _dest=((unsigned char *)dest)+i;
-#define DUFF_GUTS							    \
-    *_dest=*_src++;                             \
-    _dest+=bytesoftype;
-#ifdef NO_DUFFS_DEVICE
-                j = numofelements;
-                while(j > 0) {
-                    DUFF_GUTS;
+        /* [Un]shuffle the whole elements */
+        H5Z__shuffle_bytes((const unsigned char *)*buf, (unsigned char *)dest,
+                (size_t)bytesoftype, numofelements, (hbool_t)((flags & H5Z_FLAG_REVERSE) != 0));
 
-                    j--;
-                } /* end for */
-#else /* NO_DUFFS_DEVICE */
-            {
-                size_t duffs_index; /* Counting index for Duff's device */
-
-                duffs_index = (numofelements + 7) / 8;
-                switch (numofelements % 8) {
-                    default:
-                        HDassert(0 && "This Should never be executed!");
-                        break;
-                    case 0:
-                        do
-                          {
-                            DUFF_GUTS
-                    case 7:
-                            DUFF_GUTS
-                    case 6:
-                            DUFF_GUTS
-                    case 5:
-                            DUFF_GUTS
-                    case 4:
-                            DUFF_GUTS
-                    case 3:
-                            DUFF_GUTS
-                    case 2:
-                            DUFF_GUTS
-                    case 1:
-                            DUFF_GUTS
-                      } while (--duffs_index > 0);
-                } /* end switch */
-            }
-#endif /* NO_DUFFS_DEVICE */
-#undef DUFF_GUTS
-            } /* end for */
+        /* Add leftover to the end of data */
+        if(leftover>0) {
+            size_t nfull = numofelements * bytesoftype;     /* Bytes in whole elements */
 
-            /* Add leftover to the end of data */
-            if(leftover>0) {
-                /* Adjust back to end of shuffled bytes */
-                _dest -= (bytesoftype - 1);     /*lint !e794 _dest is initialized */
-                HDmemcpy((void*)_dest, (void*)_src, leftover);
-            }
+            HDmemcpy((unsigned char *)dest + nfull, (unsigned char *)(*buf) + nfull, leftover);
         } /* end if */
-        else {
-            /* Get the pointer to the destination buffer */
-            _dest =(unsigned char *)dest;
-
-            /* Output; shuffle */
-            for(i=0; i<bytesoftype; i++) {
-                _src=((unsigned char *)(*buf))+i;
-#define DUFF_GUTS							    \
-    *_dest++=*_src;                             \
-    _src+=bytesoftype;
-#ifdef NO_DUFFS_DEVICE
-                j = numofelements;
-                while(j > 0) {
-                    DUFF_GUTS;
-
-                    j--;
-                } /* end for */
-#else /* NO_DUFFS_DEVICE */
-            {
-                size_t duffs_index; /* Counting index for Duff's device */
-
-                duffs_index = (numofelements + 7) / 8;
-                switch (numofelements % 8) {
-                    default:
-                        HDassert(0 && "This Should never be executed!");
-                        break;
-                    case 0:
-                        do
-                          {
-                            DUFF_GUTS
-                    case 7:
-                            DUFF_GUTS
-                    case 6:
-                            DUFF_GUTS
-                    case 5:
-                            DUFF_GUTS
-                    case 4:
-                            DUFF_GUTS
-                    case 3:
-                            DUFF_GUTS
-                    case 2:
-                            DUFF_GUTS
-                    case 1:
-                            DUFF_GUTS
-                      } while (--duffs_index > 0);
-                } /* end switch */
-            }
-#endif /* NO_DUFFS_DEVICE */
-#undef DUFF_GUTS
-            } /* end for */
-
-            /* Add leftover to the end of data */
-            if(leftover>0) {
-                /* Adjust back to end of shuffled bytes */
-                _src -= (bytesoftype - 1);      /*lint !e794 _src is initialized */
-                HDmemcpy((void*)_dest, (void*)_src, leftover);
-            }
-        } /* end else */
 
         /* Free the input buffer */
         H5MM_xfree(*buf);
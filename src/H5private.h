@@ -141,6 +141,14 @@
 #   include <sys/ioctl.h>
 #endif
 
+/*
+ * Scatter/gather I/O.  Used by the sec2 driver for vectored reads and
+ * writes with preadv() and pwritev().
+ */
+#ifdef H5_HAVE_SYS_UIO_H
+#   include <sys/uio.h>
+#endif
+
 /*
  * System information. These are needed on the DEC Alpha to turn off fixing
  * of unaligned accesses by the operating system during detection of
@@ -1146,6 +1154,12 @@ typedef off_t               h5_stat_size_t;
 #ifndef HDpowf
     #define HDpowf(X,Y)   powf(X,Y)
 #endif /* HDpowf */
+#ifndef HDpread
+    #define HDpread(F,B,C,O)    pread(F,B,C,O)
+#endif /* HDpread */
+#ifndef HDpreadv
+    #define HDpreadv(F,V,C,O)   preadv(F,V,C,O)
+#endif /* HDpreadv */
 #ifndef HDprintf
     #define HDprintf(...)   HDfprintf(stdout, __VA_ARGS__)
 #endif /* HDprintf */
@@ -1158,6 +1172,12 @@ typedef off_t               h5_stat_size_t;
 #ifndef HDputs
     #define HDputs(S)    puts(S)
 #endif /* HDputs */
+#ifndef HDpwrite
+    #define HDpwrite(F,B,C,O)   pwrite(F,B,C,O)
+#endif /* HDpwrite */
+#ifndef HDpwritev
+    #define HDpwritev(F,V,C,O)  pwritev(F,V,C,O)
+#endif /* HDpwritev */
 #ifndef HDqsort
     #define HDqsort(M,N,Z,F)  qsort(M,N,Z,F)
 #endif /* HDqsort*/
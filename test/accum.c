@@ -41,6 +41,14 @@
 #define RAND_SEG_LEN    (1024)
 #define RANDOM_BASE_OFF (1024 * 1024)
 
+/* Metadata readahead test values */
+#define READAHEAD_BASE_OFF (1024 * 1024)
+#define READAHEAD_PAGE_SIZE 4096
+#define READAHEAD_NPAGES 4
+#define READAHEAD_PIECE 256
+#define READAHEAD_BUF_SIZE (16 * READAHEAD_PAGE_SIZE)
+#define READAHEAD_NGROUPS 200
+
 /* Make file global to all tests */
 H5F_t * f = NULL;
 
@@ -58,6 +66,8 @@ unsigned test_free(const H5F_io_info_t *fio_info);
 unsigned test_big(const H5F_io_info_t *fio_info);
 unsigned test_random_write(const H5F_io_info_t *fio_info);
 unsigned test_swmr_write_big(hbool_t newest_format);
+unsigned test_readahead(void);
+unsigned test_readahead_open(void);
 
 /* Helper Function Prototypes */
 void accum_printf(void);
@@ -132,7 +142,9 @@ main(void)
     if(H5Fclose(fid) < 0) TEST_ERROR
     HDremove(FILENAME);
 
-    /* This test uses a different file */
+    /* These tests use their own files */
+    nerrors += test_readahead();
+    nerrors += test_readahead_open();
     nerrors += test_swmr_write_big(TRUE);
     nerrors += test_swmr_write_big(FALSE);
 
@@ -1789,6 +1801,229 @@ error:
     return 1;
 } /* end test_random_write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    test_readahead
+ * 
+ * Purpose:     Test reading metadata through the readahead pages: pages
+ *              are read whole, the least recently used page is evicted,
+ *              and the pages are kept up to date by writes and with dirty
+ *              metadata in the accumulator.
+ * 
+ * Return:      Success: 0
+ *              Failure: 1
+ * 
+ *-------------------------------------------------------------------------
+ */
+unsigned
+test_readahead(void)
+{
+    hid_t fid = -1;                     /* File ID */
+    hid_t fapl = -1;                    /* File access property list */
+    H5F_io_info_t fio_info;             /* I/O info for operation */
+    H5F_meta_readahead_stats_t stats;   /* Readahead statistics */
+    uint8_t *wbuf = NULL, *rbuf = NULL; /* Buffers for reading & writing */
+    uint8_t wbuf2[READAHEAD_PIECE];     /* Buffer for writing new data */
+    size_t page_size, npages;           /* Readahead settings retrieved */
+    unsigned u;                         /* Local index variable */
+
+    TESTING("metadata readahead pages");
+
+    /* Allocate buffers */
+    if(NULL == (wbuf = (uint8_t *)HDmalloc((size_t)READAHEAD_BUF_SIZE))) FAIL_STACK_ERROR;
+    if(NULL == (rbuf = (uint8_t *)HDcalloc((size_t)1, (size_t)READAHEAD_BUF_SIZE))) FAIL_STACK_ERROR;
+    for(u = 0; u < READAHEAD_BUF_SIZE; u++)
+        wbuf[u] = (uint8_t)(u * 7);
+    for(u = 0; u < READAHEAD_PIECE; u++)
+        wbuf2[u] = (uint8_t)(u + 3);
+
+    /* Set up readahead */
+    if((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0) FAIL_STACK_ERROR;
+    if(H5Pset_meta_readahead(fapl, (size_t)READAHEAD_PAGE_SIZE, (size_t)READAHEAD_NPAGES) < 0) FAIL_STACK_ERROR;
+    if(H5Pget_meta_readahead(fapl, &page_size, &npages) < 0) FAIL_STACK_ERROR;
+    if(page_size != READAHEAD_PAGE_SIZE || npages != READAHEAD_NPAGES) TEST_ERROR;
+
+    /* Create a test file */
+    if((fid = H5Fcreate(FILENAME, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR;
+    if(NULL == (f = (H5F_t *)H5I_object(fid))) FAIL_STACK_ERROR;
+    if(H5FD_set_eoa(f->shared->lf, H5FD_MEM_DEFAULT, (haddr_t)(1024*1024*10)) < 0) FAIL_STACK_ERROR;
+    fio_info.f = f;
+    if(NULL == (fio_info.dxpl = (H5P_genplist_t *)H5I_object(H5AC_ind_read_dxpl_id))) FAIL_STACK_ERROR;
+
+    /* Write the data and flush it out of the accumulator */
+    if(accum_write(READAHEAD_BASE_OFF, READAHEAD_BUF_SIZE, wbuf) < 0) FAIL_STACK_ERROR;
+    if(accum_reset(&fio_info) < 0) FAIL_STACK_ERROR;
+
+    /* Read pieces a quarter page apart from the first pages */
+    for(u = 0; u < (READAHEAD_NPAGES * 4); u++) {
+        if(accum_read(READAHEAD_BASE_OFF + (u * (READAHEAD_PAGE_SIZE / 4)), READAHEAD_PIECE, rbuf) < 0) FAIL_STACK_ERROR;
+        if(HDmemcmp(rbuf, wbuf + (u * (READAHEAD_PAGE_SIZE / 4)), (size_t)READAHEAD_PIECE) != 0) TEST_ERROR;
+    } /* end for */
+
+    /* Each page is read once */
+    if(H5Fget_meta_readahead_stats(fid, &stats) < 0) FAIL_STACK_ERROR;
+    if(stats.nreads != (READAHEAD_NPAGES * 4) || stats.nfills != READAHEAD_NPAGES) TEST_ERROR;
+    if(stats.nhits != (READAHEAD_NPAGES * 3) || stats.nevictions != 0) TEST_ERROR;
+
+    /* Read from the next page, evicting the first page */
+    if(accum_read(READAHEAD_BASE_OFF + (READAHEAD_NPAGES * READAHEAD_PAGE_SIZE), READAHEAD_PIECE, rbuf) < 0) FAIL_STACK_ERROR;
+    if(HDmemcmp(rbuf, wbuf + (READAHEAD_NPAGES * READAHEAD_PAGE_SIZE), (size_t)READAHEAD_PIECE) != 0) TEST_ERROR;
+    if(H5Fget_meta_readahead_stats(fid, &stats) < 0) FAIL_STACK_ERROR;
+    if(stats.nfills != (READAHEAD_NPAGES + 1) || stats.nevictions != 1) TEST_ERROR;
+
+    /* The second page is still held, the first isn't */
+    if(accum_read(READAHEAD_BASE_OFF + READAHEAD_PAGE_SIZE, READAHEAD_PIECE, rbuf) < 0) FAIL_STACK_ERROR;
+    if(accum_read(READAHEAD_BASE_OFF, READAHEAD_PIECE, rbuf) < 0) FAIL_STACK_ERROR;
+    if(HDmemcmp(rbuf, wbuf, (size_t)READAHEAD_PIECE) != 0) TEST_ERROR;
+    if(H5Fget_meta_readahead_stats(fid, &stats) < 0) FAIL_STACK_ERROR;
+    if(stats.nfills != (READAHEAD_NPAGES + 2) || stats.nevictions != 2) TEST_ERROR;
+
+    /* Read across the end of the second page, whose next page was evicted */
+    if(accum_read(READAHEAD_BASE_OFF + (2 * READAHEAD_PAGE_SIZE) - (READAHEAD_PIECE / 2), READAHEAD_PIECE, rbuf) < 0) FAIL_STACK_ERROR;
+    if(HDmemcmp(rbuf, wbuf + (2 * READAHEAD_PAGE_SIZE) - (READAHEAD_PIECE / 2), (size_t)READAHEAD_PIECE) != 0) TEST_ERROR;
+
+    /* Write new data into the second page, then move the accumulator away */
+    if(accum_write(READAHEAD_BASE_OFF + READAHEAD_PAGE_SIZE + READAHEAD_PIECE, READAHEAD_PIECE, wbuf2) < 0) FAIL_STACK_ERROR;
+    if(accum_write(READAHEAD_BASE_OFF + (1024 * 1024 * 4), READAHEAD_PIECE, wbuf2) < 0) FAIL_STACK_ERROR;
+
+    /* The page holds the new data */
+    if(H5Fget_meta_readahead_stats(fid, &stats) < 0) FAIL_STACK_ERROR;
+    if(accum_read(READAHEAD_BASE_OFF + READAHEAD_PAGE_SIZE, 2 * READAHEAD_PIECE, rbuf) < 0) FAIL_STACK_ERROR;
+    if(HDmemcmp(rbuf, wbuf + READAHEAD_PAGE_SIZE, (size_t)READAHEAD_PIECE) != 0) TEST_ERROR;
+    if(HDmemcmp(rbuf + READAHEAD_PIECE, wbuf2, (size_t)READAHEAD_PIECE) != 0) TEST_ERROR;
+    if(H5Fget_meta_readahead_stats(fid, &stats) < 0) FAIL_STACK_ERROR;
+    if(stats.nfills != (READAHEAD_NPAGES + 3)) TEST_ERROR;
+
+    /* Read a page while the accumulator holds dirty metadata in it */
+    if(accum_write(READAHEAD_BASE_OFF + (8 * READAHEAD_PAGE_SIZE), READAHEAD_PIECE, wbuf2) < 0) FAIL_STACK_ERROR;
+    if(!f->shared->accum.dirty) TEST_ERROR;
+    if(accum_read(READAHEAD_BASE_OFF + (8 * READAHEAD_PAGE_SIZE) + (4 * READAHEAD_PIECE), READAHEAD_PIECE, rbuf) < 0) FAIL_STACK_ERROR;
+    if(HDmemcmp(rbuf, wbuf + (8 * READAHEAD_PAGE_SIZE) + (4 * READAHEAD_PIECE), (size_t)READAHEAD_PIECE) != 0) TEST_ERROR;
+
+    /* The page, now the most recently used, has the dirty metadata */
+    if(f->shared->meta_pages.head->addr != (READAHEAD_BASE_OFF + (8 * READAHEAD_PAGE_SIZE))) TEST_ERROR;
+    if(HDmemcmp(f->shared->meta_pages.head->buf, wbuf2, (size_t)READAHEAD_PIECE) != 0) TEST_ERROR;
+
+    /* Resetting the accumulator releases the pages */
+    if(accum_reset(&fio_info) < 0) FAIL_STACK_ERROR;
+    if(f->shared->meta_pages.npages != 0 || f->shared->meta_pages.head) TEST_ERROR;
+
+    /* Close the file */
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR;
+    fid = -1;
+    HDremove(FILENAME);
+
+    /* Number of pages must be positive */
+    H5E_BEGIN_TRY {
+        if(H5Pset_meta_readahead(fapl, (size_t)READAHEAD_PAGE_SIZE, (size_t)0) >= 0) TEST_ERROR;
+    } H5E_END_TRY;
+    if(H5Pclose(fapl) < 0) FAIL_STACK_ERROR;
+
+    PASSED();
+
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Fclose(fid);
+        H5Pclose(fapl);
+    } H5E_END_TRY;
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    return 1;
+} /* end test_readahead() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_readahead_open
+ * 
+ * Purpose:     Test that opening a file with many small objects with
+ *              metadata readahead saves driver reads.
+ * 
+ * Return:      Success: 0
+ *              Failure: 1
+ * 
+ *-------------------------------------------------------------------------
+ */
+unsigned
+test_readahead_open(void)
+{
+    hid_t fid = -1;                     /* File ID */
+    hid_t fapl = -1;                    /* File access property list */
+    hid_t gid = -1;                     /* Group ID */
+    hid_t aid = -1;                     /* Attribute ID */
+    hid_t sid = -1;                     /* Dataspace ID */
+    H5F_meta_readahead_stats_t stats;   /* Readahead statistics */
+    char name[32];                      /* Group name */
+    int val;                            /* Attribute value */
+    unsigned u;                         /* Local index variable */
+
+    TESTING("metadata readahead on file open");
+
+    /* Create groups with an attribute each */
+    if((fid = H5Fcreate(FILENAME, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR;
+    if((sid = H5Screate(H5S_SCALAR)) < 0) FAIL_STACK_ERROR;
+    for(u = 0; u < READAHEAD_NGROUPS; u++) {
+        HDsnprintf(name, sizeof(name), "group %u", u);
+        if((gid = H5Gcreate2(fid, name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR;
+        if((aid = H5Acreate2(gid, "attr", H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR;
+        val = (int)u;
+        if(H5Awrite(aid, H5T_NATIVE_INT, &val) < 0) FAIL_STACK_ERROR;
+        if(H5Aclose(aid) < 0) FAIL_STACK_ERROR;
+        if(H5Gclose(gid) < 0) FAIL_STACK_ERROR;
+    } /* end for */
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR;
+
+    /* Readahead is off by default */
+    if(H5Fget_meta_readahead_stats(fid, &stats) < 0) FAIL_STACK_ERROR;
+    if(stats.nreads != 0) TEST_ERROR;
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR;
+
+    /* Re-open the file with readahead and read the attributes */
+    if((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0) FAIL_STACK_ERROR;
+    if(H5Pset_meta_readahead(fapl, (size_t)(64 * 1024), (size_t)READAHEAD_NPAGES) < 0) FAIL_STACK_ERROR;
+    if((fid = H5Fopen(FILENAME, H5F_ACC_RDONLY, fapl)) < 0) FAIL_STACK_ERROR;
+    for(u = 0; u < READAHEAD_NGROUPS; u++) {
+        HDsnprintf(name, sizeof(name), "group %u", u);
+        if((gid = H5Gopen2(fid, name, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR;
+        if((aid = H5Aopen(gid, "attr", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR;
+        if(H5Aread(aid, H5T_NATIVE_INT, &val) < 0) FAIL_STACK_ERROR;
+        if(val != (int)u) TEST_ERROR;
+        if(H5Aclose(aid) < 0) FAIL_STACK_ERROR;
+        if(H5Gclose(gid) < 0) FAIL_STACK_ERROR;
+    } /* end for */
+
+    /* Most of the metadata reads didn't go to the driver */
+    if(H5Fget_meta_readahead_stats(fid, &stats) < 0) FAIL_STACK_ERROR;
+    if(stats.nreads < READAHEAD_NGROUPS) TEST_ERROR;
+    if(stats.nfills * 4 > stats.nreads) TEST_ERROR;
+    if(stats.nhits + stats.nfills < stats.nreads) TEST_ERROR;
+
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR;
+    fid = -1;
+    if(H5Pclose(fapl) < 0) FAIL_STACK_ERROR;
+    HDremove(FILENAME);
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Aclose(aid);
+        H5Gclose(gid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+        H5Pclose(fapl);
+    } H5E_END_TRY;
+
+    return 1;
+} /* end test_readahead_open() */
+
 /*-------------------------------------------------------------------------
  * Function:    test_swmr_write_big
  * 
@@ -39,6 +39,7 @@ const char *FILENAME[] = {
 #define INSERT_SPLIT_ROOT_NREC_REC  64
 #define INSERT_MANY             (1000 * 1000)
 #define INSERT_MANY_REC         (2700 * 1000)
+#define BULK_MANY               (100 * 1000)
 #define FIND_MANY               (INSERT_MANY / 100)
 #define FIND_MANY_REC           (INSERT_MANY_REC / 100)
 #define FIND_NEIGHBOR           2000
@@ -3191,6 +3192,193 @@ error:
     return 1;
 } /* test_insert_lots() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	test_insert_bulk
+ *
+ * Purpose:	Tests for loading records into an empty v2 B-tree in bulk,
+ *              for B-trees from a single leaf up to level 3.  The B-trees
+ *              built are then checked with regular inserts & removes.
+ *
+ * Return:	Success:	0
+ *		Failure:	1
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+test_insert_bulk(hid_t fapl, const H5B2_create_t *cparam,
+    const bt2_test_param_t *tparam)
+{
+    hid_t	file = -1;              /* File ID */
+    H5F_t	*f = NULL;              /* Internal file object pointer */
+    hid_t       dxpl = H5AC_ind_read_dxpl_id;        /* DXPL to use */
+    H5B2_t      *bt2 = NULL;            /* v2 B-tree wrapper */
+    haddr_t     bt2_addr;               /* Address of B-tree created */
+    hsize_t     record;                 /* Record to insert into tree */
+    hsize_t     rrecord;                /* Record to remove from tree */
+    hsize_t     idx;                    /* Index within B-tree, for iterator */
+    H5B2_stat_t bt2_stat;               /* Statistics about B-tree created */
+    hsize_t     nrec;                   /* Number of records in B-tree */
+    hsize_t     bulk_nrec[] = {1, 40, 1000, 5000, BULK_MANY}; /* Sizes of B-trees to load */
+    unsigned    u, v;                   /* Local index variables */
+    herr_t      ret;                    /* Generic error return value */
+
+    TESTING("B-tree insert: load records in bulk");
+
+    /* Create the file for the test */
+    if(create_file(&file, &f, fapl) < 0)
+        TEST_ERROR
+
+    for(u = 0; u < NELMTS(bulk_nrec); u++) {
+        /* Create the v2 B-tree & get its address */
+        if(create_btree(f, dxpl, cparam, &bt2, &bt2_addr) < 0)
+            TEST_ERROR
+
+        /* Load the even records */
+        if(H5B2_bulk_begin(bt2, dxpl, bulk_nrec[u]) < 0)
+            FAIL_STACK_ERROR
+        for(record = 0; record < bulk_nrec[u]; record++) {
+            rrecord = record * 2;
+            if(H5B2_insert(bt2, dxpl, &rrecord) < 0)
+                FAIL_STACK_ERROR
+        } /* end for */
+        if(H5B2_bulk_end(bt2, dxpl) < 0)
+            FAIL_STACK_ERROR
+
+        /* Check up on B-tree, which should be no deeper than it needs to be */
+        if(H5B2_stat_info(bt2, &bt2_stat) < 0)
+            FAIL_STACK_ERROR
+        if(bt2_stat.nrecords != bulk_nrec[u])
+            TEST_ERROR
+        if(bt2_stat.depth > 0 && bt2->hdr->node_info[bt2_stat.depth - 1].cum_max_nrec >= bulk_nrec[u])
+            TEST_ERROR
+
+        /* Check for closing & re-opening the B-tree */
+        if(reopen_btree(f, dxpl, &bt2, bt2_addr, tparam) < 0)
+            TEST_ERROR
+
+        /* Find the records loaded */
+        for(record = 0; record < bulk_nrec[u]; record++) {
+            idx = record * 2;
+            if(H5B2_find(bt2, dxpl, &idx, find_cb, &idx) != TRUE)
+                FAIL_STACK_ERROR
+        } /* end for */
+
+        /* Insert the odd records around them */
+        for(record = 0; record < bulk_nrec[u]; record++) {
+            rrecord = (record * 2) + 1;
+            if(H5B2_insert(bt2, dxpl, &rrecord) < 0)
+                FAIL_STACK_ERROR
+        } /* end for */
+
+        /* Iterate over B-tree to check records are all in order */
+        idx = 0;
+        if(H5B2_iterate(bt2, dxpl, iter_cb, &idx) < 0)
+            FAIL_STACK_ERROR
+        if(idx != bulk_nrec[u] * 2)
+            TEST_ERROR
+
+        /* Remove the records loaded */
+        for(record = 0; record < bulk_nrec[u]; record++) {
+            idx = record * 2;
+            rrecord = HSIZET_MAX;
+            if(H5B2_remove(bt2, dxpl, &idx, remove_cb, &rrecord) < 0)
+                FAIL_STACK_ERROR
+            if(rrecord != idx)
+                TEST_ERROR
+        } /* end for */
+
+        /* Query the number of records in the B-tree */
+        if(H5B2_get_nrec(bt2, &nrec) < 0)
+            FAIL_STACK_ERROR
+        if(nrec != bulk_nrec[u])
+            TEST_ERROR
+
+        /* Close the v2 B-tree */
+        if(H5B2_close(bt2, dxpl) < 0)
+            FAIL_STACK_ERROR
+        bt2 = NULL;
+    } /* end for */
+
+    PASSED();
+
+    TESTING("B-tree insert: load records in bulk out of order");
+
+    /* Create the v2 B-tree & get its address */
+    if(create_btree(f, dxpl, cparam, &bt2, &bt2_addr) < 0)
+        TEST_ERROR
+
+    /* Attempt to load a record that's out of order */
+    if(H5B2_bulk_begin(bt2, dxpl, (hsize_t)100) < 0)
+        FAIL_STACK_ERROR
+    for(v = 0; v < 50; v++) {
+        record = v;
+        if(H5B2_insert(bt2, dxpl, &record) < 0)
+            FAIL_STACK_ERROR
+    } /* end for */
+    record = 10;
+    H5E_BEGIN_TRY {
+        ret = H5B2_insert(bt2, dxpl, &record);
+    } H5E_END_TRY;
+    /* Should fail */
+    if(ret != FAIL)
+        TEST_ERROR
+
+    /* Attempt to finish loading before all the records are loaded */
+    H5E_BEGIN_TRY {
+        ret = H5B2_bulk_end(bt2, dxpl);
+    } H5E_END_TRY;
+    /* Should fail */
+    if(ret != FAIL)
+        TEST_ERROR
+
+    /* Close the v2 B-tree */
+    if(H5B2_close(bt2, dxpl) < 0)
+        FAIL_STACK_ERROR
+    bt2 = NULL;
+
+    /* Loading a B-tree that isn't empty inserts the records as usual */
+    if(create_btree(f, dxpl, cparam, &bt2, &bt2_addr) < 0)
+        TEST_ERROR
+    record = 5;
+    if(H5B2_insert(bt2, dxpl, &record) < 0)
+        FAIL_STACK_ERROR
+    if(H5B2_bulk_begin(bt2, dxpl, (hsize_t)4) < 0)
+        FAIL_STACK_ERROR
+    for(v = 0; v < 10; v += 3) {
+        record = (hsize_t)(9 - v);
+        if(H5B2_insert(bt2, dxpl, &record) < 0)
+            FAIL_STACK_ERROR
+    } /* end for */
+    if(H5B2_bulk_end(bt2, dxpl) < 0)
+        FAIL_STACK_ERROR
+    if(H5B2_get_nrec(bt2, &nrec) < 0)
+        FAIL_STACK_ERROR
+    if(nrec != 5)
+        TEST_ERROR
+
+    /* Close the v2 B-tree */
+    if(H5B2_close(bt2, dxpl) < 0)
+        FAIL_STACK_ERROR
+    bt2 = NULL;
+
+    /* Close file */
+    if(H5Fclose(file) < 0)
+        TEST_ERROR
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        if(bt2)
+            H5B2_close(bt2, dxpl);
+	H5Fclose(file);
+    } H5E_END_TRY;
+    return 1;
+} /* test_insert_bulk() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	test_update_basic
@@ -10041,6 +10229,7 @@ main(void)
             printf("***Express test mode on.  test_insert_lots skipped\n");
         else
             nerrors += test_insert_lots(fapl, &cparam, &tparam);
+        nerrors += test_insert_bulk(fapl, &cparam, &tparam);
 
         /* Test B-tree record update (ie. insert/modify) */
         /* (Iteration, find & index routines exercised in these routines as well) */
@@ -204,6 +204,8 @@ static unsigned check_stats(void);
 #if H5C_COLLECT_CACHE_STATS
 static void check_stats__smoke_check_1(H5F_t * file_ptr);
 #endif /* H5C_COLLECT_CACHE_STATS */
+static unsigned check_index_resize(void);
+static unsigned check_slist_order(void);
 
 
 /**************************************************************************/
@@ -34327,6 +34329,20 @@ check_entry_deletions_during_scans(void)
         cedds__H5C__autoadjust__ageout__evict_aged_out_entries(file_ptr);
     }
 
+    if(pass) {
+
+        /* the cache's hash table index is never shrunk, and the bucket 
+         * scan test needs several entries sharing a hash bucket.  Run it 
+         * in a fresh cache, whose index still has its initial size.
+         */
+        takedown_cache(file_ptr, FALSE, FALSE);
+
+        reset_entries();
+
+        file_ptr = setup_cache((size_t)(2 * 1024 * 1024),
+                                (size_t)(1 * 1024 * 1024));
+    }
+
     if(pass) {
 
         cedds__H5C_flush_invalidate_cache__bucket_scan(file_ptr);
@@ -35393,16 +35409,17 @@ cedds__H5C__autoadjust__ageout__evict_aged_out_entries(H5F_t * file_ptr)
  *
  *		!!!!!!!!!!WARNING !!!!!!!!!!
  *
- *		This test may fail to function correctly if the hash 
- *		table size or hash function is altered.  
+ *		The test entries are picked by searching the monster
+ *		entries for four that share a hash bucket under the
+ *		cache's current hash function and table size, so the
+ *		test does not depend on either.
  *
  *		To setup the test, this function depends on the fact that 
  *		H5C_flush_invalidate_cache() does alternating scans of the
  *		slist and the index.  If this changes, the test will likely
  *		also cease to function correctly.
  *
- *		The test relies on a known hash function and hash table 
- *		size to select a set of test entries that will all hash 
+ *		The test selects a set of test entries that will all hash 
  *		to the same hash bucket -- call it the test hash bucket.  
  *		It also relies on known behavior of the cache to place 
  *		the entries in the test bucket in a known order.
@@ -35462,6 +35479,10 @@ cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t * file_ptr)
 {
     H5C_t *                    cache_ptr = file_ptr->shared->cache;
     int		               i;
+    int		               j;
+    int		               n;
+    int		               bucket_entries[4];
+    int		               child_index = -1;
     int		               expected_hash_bucket = 0;
     herr_t	               result;
     haddr_t                    entry_addr;
@@ -35477,11 +35498,11 @@ cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t * file_ptr)
        */
       /* entry			entry				in	at main                                                  flush dep flush dep child flush   flush       flush */
       /* type:			index:	size:			cache:	addr:	dirty:	prot:	pinned:	dsrlzd:	srlzd:	dest:     par type[]: par idx[]: dep npart: dep nchd: dep ndirty chd: order:     corked: */
-      { MONSTER_ENTRY_TYPE,	 0,	MONSTER_ENTRY_SIZE,	TRUE,	TRUE,	TRUE,	FALSE,	TRUE,	TRUE,	FALSE,	FALSE,      {-1,0,0,0,0,0,0,0},                 {-1,0,0,0,0,0,0,0}, 0, 1, 1, -1, FALSE},
-      { MONSTER_ENTRY_TYPE,	 8,	MONSTER_ENTRY_SIZE,	TRUE,	TRUE,	FALSE,	FALSE,	FALSE,	TRUE,	FALSE,	FALSE,      {-1,0,0,0,0,0,0,0},                 {-1,0,0,0,0,0,0,0}, 0, 0, 0, -1, FALSE},
-      { MONSTER_ENTRY_TYPE,     16,	MONSTER_ENTRY_SIZE,	TRUE,	TRUE,	FALSE,	FALSE,	FALSE,	TRUE,	FALSE,	FALSE,      {-1,0,0,0,0,0,0,0},                 {-1,0,0,0,0,0,0,0}, 0, 0, 0, -1, FALSE},
-      { MONSTER_ENTRY_TYPE,     24,	MONSTER_ENTRY_SIZE,	TRUE,	TRUE,	FALSE,	FALSE,	FALSE,	TRUE,	FALSE,	FALSE,      {-1,0,0,0,0,0,0,0},                 {-1,0,0,0,0,0,0,0}, 0, 0, 0, -1, FALSE},
-      { MONSTER_ENTRY_TYPE,     31,	MONSTER_ENTRY_SIZE,	TRUE,	TRUE,	TRUE,	FALSE,	FALSE,	TRUE,	FALSE,	FALSE, 	    {MONSTER_ENTRY_TYPE,0,0,0,0,0,0,0}, {0,0,0,0,0,0,0,0},  1, 0, 0, -1, FALSE},
+      { MONSTER_ENTRY_TYPE,	-1,	MONSTER_ENTRY_SIZE,	TRUE,	TRUE,	TRUE,	FALSE,	TRUE,	TRUE,	FALSE,	FALSE,      {-1,0,0,0,0,0,0,0},                 {-1,0,0,0,0,0,0,0}, 0, 1, 1, -1, FALSE},
+      { MONSTER_ENTRY_TYPE,	-1,	MONSTER_ENTRY_SIZE,	TRUE,	TRUE,	FALSE,	FALSE,	FALSE,	TRUE,	FALSE,	FALSE,      {-1,0,0,0,0,0,0,0},                 {-1,0,0,0,0,0,0,0}, 0, 0, 0, -1, FALSE},
+      { MONSTER_ENTRY_TYPE,     -1,	MONSTER_ENTRY_SIZE,	TRUE,	TRUE,	FALSE,	FALSE,	FALSE,	TRUE,	FALSE,	FALSE,      {-1,0,0,0,0,0,0,0},                 {-1,0,0,0,0,0,0,0}, 0, 0, 0, -1, FALSE},
+      { MONSTER_ENTRY_TYPE,     -1,	MONSTER_ENTRY_SIZE,	TRUE,	TRUE,	FALSE,	FALSE,	FALSE,	TRUE,	FALSE,	FALSE,      {-1,0,0,0,0,0,0,0},                 {-1,0,0,0,0,0,0,0}, 0, 0, 0, -1, FALSE},
+      { MONSTER_ENTRY_TYPE,     -1,	MONSTER_ENTRY_SIZE,	TRUE,	TRUE,	TRUE,	FALSE,	FALSE,	TRUE,	FALSE,	FALSE, 	    {MONSTER_ENTRY_TYPE,0,0,0,0,0,0,0}, {-1,0,0,0,0,0,0,0}, 1, 0, 0, -1, FALSE},
     };
 
     if(pass) {
@@ -35515,6 +35536,47 @@ cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t * file_ptr)
     }
 
 
+    if(pass) {
+
+        /* find four monster entries that hash to the same bucket, and
+         * an entry with a higher address than the first of them that
+         * hashes to a different bucket.
+         */
+        base_addr = entries[MONSTER_ENTRY_TYPE];
+
+        for(i = 0; (child_index < 0) && (i < NUM_MONSTER_ENTRIES); i++) {
+
+            entry_addr = base_addr[i].addr;
+
+            expected_hash_bucket = H5C__HASH_FCN(cache_ptr, entry_addr);
+
+            n = 0;
+            for(j = i; (n < 4) && (j < NUM_MONSTER_ENTRIES); j++)
+                if(H5C__HASH_FCN(cache_ptr, base_addr[j].addr) ==
+                        expected_hash_bucket)
+                    bucket_entries[n++] = j;
+
+            if(n == 4)
+                for(j = i + 1; (child_index < 0) && (j < NUM_MONSTER_ENTRIES); j++)
+                    if(H5C__HASH_FCN(cache_ptr, base_addr[j].addr) !=
+                            expected_hash_bucket)
+                        child_index = j;
+        }
+
+        if(child_index < 0) {
+
+            pass = FALSE;
+            failure_mssg = "Can't find four monster entries that map to the same bucket?!?!";
+
+        } else {
+
+            for(i = 0; i < 4; i++)
+                expected[i].entry_index = bucket_entries[i];
+            expected[4].entry_index = child_index;
+            expected[4].flush_dep_par_idx[0] = bucket_entries[0];
+        }
+    }
+
     if(pass) {
 
 	/* reset the stats before we start.  If stats are enabled, we will
@@ -35524,40 +35586,36 @@ cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t * file_ptr)
 	H5C_stats__reset(cache_ptr);
 
 
-	/* load one dirty and three clean entries that should hash to the 
+	/* load one dirty and three clean entries that hash to the 
          * same hash bucket.  
          */
 
-        protect_entry(file_ptr, MONSTER_ENTRY_TYPE, 0);
-        unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, 0, H5C__DIRTIED_FLAG);
+        protect_entry(file_ptr, MONSTER_ENTRY_TYPE, bucket_entries[0]);
+        unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, bucket_entries[0], 
+                        H5C__DIRTIED_FLAG);
 
-	for (i = 8; i <= 24; i += 8)
+	for (i = 1; i < 4; i++)
 	{
-	    protect_entry(file_ptr, MONSTER_ENTRY_TYPE, i);
-            unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+	    protect_entry(file_ptr, MONSTER_ENTRY_TYPE, bucket_entries[i]);
+            unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, bucket_entries[i], 
+                            H5C__NO_FLAGS_SET);
 	}
     }
 
     if(pass) {
 
-        /* verify that the above entries hash to the same bucket */
-        base_addr = entries[MONSTER_ENTRY_TYPE];
-        entry_ptr = &(base_addr[0]);
-        entry_addr = entry_ptr->header.addr;
-
-        HDassert(entry_addr == entry_ptr->addr);
-
-        expected_hash_bucket = H5C__HASH_FCN(entry_addr);
-
-        for (i = 8; i <= 24; i += 8) {
+        /* verify that the above entries still hash to the same bucket,
+         * i.e. that loading them didn't resize the index.
+         */
+        for (i = 1; i < 4; i++) {
         
-            entry_ptr = &(base_addr[i]);
+            entry_ptr = &(base_addr[bucket_entries[i]]);
             entry_addr = entry_ptr->header.addr;
 
-            if(expected_hash_bucket != H5C__HASH_FCN(entry_addr)) {
+            if(expected_hash_bucket != H5C__HASH_FCN(cache_ptr, entry_addr)) {
 
                 pass = FALSE;
-                failure_mssg = "Test entries don't map to same bucket -- hash table size or hash fcn change?";
+                failure_mssg = "Test entries don't map to same bucket -- hash table resized?";
             }
         }
     }
@@ -35566,22 +35624,22 @@ cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t * file_ptr)
 
        /* setup the expunge flush operation:
 	 *
-	 *     (MET, 0) expunges (MET, 8)
+	 *     (MET, bucket_entries[0]) expunges (MET, bucket_entries[1])
 	 *
 	 */
-        add_flush_op(MONSTER_ENTRY_TYPE, 0, FLUSH_OP__EXPUNGE,
-                     MONSTER_ENTRY_TYPE, 8, FALSE, (size_t)0, NULL);
+        add_flush_op(MONSTER_ENTRY_TYPE, bucket_entries[0], FLUSH_OP__EXPUNGE,
+                     MONSTER_ENTRY_TYPE, bucket_entries[1], FALSE, (size_t)0, NULL);
     }
 
     if(pass) {
 
-        /* load the entry that will have a flush dependencey with (MET, 0),
-         * thus preventing it from being flushed on the first pass through
-         * the skip list. 
+        /* load the entry that will have a flush dependencey with 
+         * (MET, bucket_entries[0]), thus preventing it from being flushed 
+         * on the first pass through the skip list. 
          */
 
-	protect_entry(file_ptr, MONSTER_ENTRY_TYPE, 31);
-	unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, 31, H5C__DIRTIED_FLAG);
+	protect_entry(file_ptr, MONSTER_ENTRY_TYPE, child_index);
+	unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, child_index, H5C__DIRTIED_FLAG);
     }
 
     if(pass) {
@@ -35590,10 +35648,10 @@ cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t * file_ptr)
          * hash bucket as the clean entries.
          */
 
-        entry_ptr = &(base_addr[31]);
+        entry_ptr = &(base_addr[child_index]);
         entry_addr = entry_ptr->header.addr;
 
-        if(expected_hash_bucket == H5C__HASH_FCN(entry_addr)) {
+        if(expected_hash_bucket == H5C__HASH_FCN(cache_ptr, entry_addr)) {
 
             pass = FALSE;
             failure_mssg = "Dirty entry maps to same hash bucket as clean entries?!?!";
@@ -35602,26 +35660,29 @@ cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t * file_ptr)
 
     if(pass) {
 
-	/* Next, create the flush dependency requiring (MET, 31) to 
-         * be flushed prior to (MET, 0).
+	/* Next, create the flush dependency requiring (MET, child_index) 
+         * to be flushed prior to (MET, bucket_entries[0]).
 	 */
 
-        protect_entry(file_ptr, MONSTER_ENTRY_TYPE, 0);
-        create_flush_dependency(MONSTER_ENTRY_TYPE, 0, MONSTER_ENTRY_TYPE, 31);
-        unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, 0, H5C__DIRTIED_FLAG);
+        protect_entry(file_ptr, MONSTER_ENTRY_TYPE, bucket_entries[0]);
+        create_flush_dependency(MONSTER_ENTRY_TYPE, bucket_entries[0], 
+                                MONSTER_ENTRY_TYPE, child_index);
+        unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, bucket_entries[0], 
+                        H5C__DIRTIED_FLAG);
 
     }
 
     if(pass) {
 
         /* Then, setup the flush operation to take down the flush 
-         * dependency when (MET, 31) is flushed.
+         * dependency when (MET, child_index) is flushed.
 	 *
-	 *     (MET, 31) destroys flush dependency with (MET, 8)
+	 *     (MET, child_index) destroys flush dependency with 
+	 *     (MET, bucket_entries[0])
 	 *
          */
-        add_flush_op(MONSTER_ENTRY_TYPE, 31, FLUSH_OP__DEST_FLUSH_DEP,
-                     MONSTER_ENTRY_TYPE, 0, FALSE, (size_t)0, NULL);
+        add_flush_op(MONSTER_ENTRY_TYPE, child_index, FLUSH_OP__DEST_FLUSH_DEP,
+                     MONSTER_ENTRY_TYPE, bucket_entries[0], FALSE, (size_t)0, NULL);
 
     }
 
@@ -35639,10 +35700,11 @@ cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t * file_ptr)
          * hash bucket list on lookup.
          */
 
-	for (i = 24; i >= 0; i -= 8)
+	for (i = 3; i >= 0; i--)
 	{
-	    protect_entry(file_ptr, MONSTER_ENTRY_TYPE, i);
-            unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+	    protect_entry(file_ptr, MONSTER_ENTRY_TYPE, bucket_entries[i]);
+            unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, bucket_entries[i], 
+                            H5C__NO_FLAGS_SET);
 	}
     }
 
@@ -35655,9 +35717,9 @@ cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t * file_ptr)
 
         i = 0;
 
-        while(pass && (i <= 24))
+        while(pass && (i < 4))
 	{
-            entry_ptr = &(base_addr[i]);
+            entry_ptr = &(base_addr[bucket_entries[i]]);
 
             if(scan_ptr == NULL) {
 
@@ -35674,7 +35736,7 @@ cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t * file_ptr)
             if(pass) {
 
                 scan_ptr = scan_ptr->ht_next;
-                i += 8;
+                i++;
             }
 	}
     }
@@ -35932,7 +35994,10 @@ check_stats__smoke_check_1(H5F_t * file_ptr)
              (cache_ptr->successful_ht_searches != 0) ||
              (cache_ptr->total_successful_ht_search_depth != 0) ||
              (cache_ptr->failed_ht_searches != 32) ||
-             (cache_ptr->total_failed_ht_search_depth != 48) ||
+             (cache_ptr->total_failed_ht_search_depth != 0) ||
+             (cache_ptr->max_successful_ht_search_depth != 0) ||
+             (cache_ptr->max_failed_ht_search_depth != 0) ||
+             (cache_ptr->index_nbuckets != H5C__HASH_TABLE_MIN_LEN) ||
              (cache_ptr->max_index_len != 32) ||
              (cache_ptr->max_index_size != 2 * 1024 * 1024) ||
              (cache_ptr->max_clean_index_size != 0) ||
@@ -36015,9 +36080,12 @@ check_stats__smoke_check_1(H5F_t * file_ptr)
         if((cache_ptr->total_ht_insertions != 32) ||
              (cache_ptr->total_ht_deletions != 0) ||
              (cache_ptr->successful_ht_searches != 32) ||
-             (cache_ptr->total_successful_ht_search_depth != 96) ||
+             (cache_ptr->total_successful_ht_search_depth != 0) ||
              (cache_ptr->failed_ht_searches != 32) ||
-             (cache_ptr->total_failed_ht_search_depth != 48) ||
+             (cache_ptr->total_failed_ht_search_depth != 0) ||
+             (cache_ptr->max_successful_ht_search_depth != 0) ||
+             (cache_ptr->max_failed_ht_search_depth != 0) ||
+             (cache_ptr->index_nbuckets != H5C__HASH_TABLE_MIN_LEN) ||
              (cache_ptr->max_index_len != 32) ||
              (cache_ptr->max_index_size != 2 * 1024 * 1024) ||
              (cache_ptr->max_clean_index_size != 0) ||
@@ -36100,9 +36168,12 @@ check_stats__smoke_check_1(H5F_t * file_ptr)
         if((cache_ptr->total_ht_insertions != 33) ||
              (cache_ptr->total_ht_deletions != 1) ||
              (cache_ptr->successful_ht_searches != 32) ||
-             (cache_ptr->total_successful_ht_search_depth != 96) ||
+             (cache_ptr->total_successful_ht_search_depth != 0) ||
              (cache_ptr->failed_ht_searches != 33) ||
-             (cache_ptr->total_failed_ht_search_depth != 52) ||
+             (cache_ptr->total_failed_ht_search_depth != 0) ||
+             (cache_ptr->max_successful_ht_search_depth != 0) ||
+             (cache_ptr->max_failed_ht_search_depth != 0) ||
+             (cache_ptr->index_nbuckets != H5C__HASH_TABLE_MIN_LEN) ||
              (cache_ptr->max_index_len != 32) ||
              (cache_ptr->max_index_size != 2 * 1024 * 1024) ||
              (cache_ptr->max_clean_index_size != 2 * 1024 * 1024) ||
@@ -36204,9 +36275,12 @@ check_stats__smoke_check_1(H5F_t * file_ptr)
         if((cache_ptr->total_ht_insertions != 33) ||
              (cache_ptr->total_ht_deletions != 33) ||
              (cache_ptr->successful_ht_searches != 33) ||
-             (cache_ptr->total_successful_ht_search_depth != 99) ||
+             (cache_ptr->total_successful_ht_search_depth != 0) ||
              (cache_ptr->failed_ht_searches != 33) ||
-             (cache_ptr->total_failed_ht_search_depth != 52) ||
+             (cache_ptr->total_failed_ht_search_depth != 0) ||
+             (cache_ptr->max_successful_ht_search_depth != 0) ||
+             (cache_ptr->max_failed_ht_search_depth != 0) ||
+             (cache_ptr->index_nbuckets != H5C__HASH_TABLE_MIN_LEN) ||
              (cache_ptr->max_index_len != 32) ||
              (cache_ptr->max_index_size != 2 * 1024 * 1024) ||
              (cache_ptr->max_clean_index_size != 2 * 1024 * 1024) ||
@@ -36260,6 +36334,288 @@ check_stats__smoke_check_1(H5F_t * file_ptr)
 
 #endif /* H5C_COLLECT_CACHE_STATS */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	check_index_resize()
+ *
+ * Purpose:	Verify that the hash table index grows as entries are
+ *		inserted into the cache, and that all entries can still
+ *		be found after the index has been resized.
+ *
+ *		Insert all pico and nano entries -- many more entries 
+ *		than the index has buckets initially -- and then verify 
+ *		that:
+ *
+ *		1) the index has grown, and its load factor is within
+ *		   bounds,
+ *
+ *		2) every entry in each hash bucket hashes to that bucket,
+ *		   and the hash buckets hold all entries in the index, and
+ *
+ *		3) every inserted entry can be found in the index.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+
+static unsigned
+check_index_resize(void)
+{
+    H5F_t *                     file_ptr = NULL;
+    H5C_t *                     cache_ptr = NULL;
+    H5C_cache_entry_t *         scan_ptr;
+    uint32_t                    bucket;
+    uint32_t                    entry_count = 0;
+    int                         i;
+
+    TESTING("metadata cache index resize");
+
+    pass = TRUE;
+
+    reset_entries();
+
+    file_ptr = setup_cache((size_t)(2 * 1024 * 1024),
+                           (size_t)(1 * 1024 * 1024));
+
+    if(pass) {
+
+        cache_ptr = file_ptr->shared->cache;
+
+        if(cache_ptr->index_nbuckets != H5C__HASH_TABLE_MIN_LEN) {
+
+            pass = FALSE;
+            failure_mssg = "unexpected initial index size.";
+        }
+    }
+
+    for(i = 0; pass && (i < NUM_PICO_ENTRIES); i++)
+        insert_entry(file_ptr, PICO_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+
+    for(i = 0; pass && (i < NUM_NANO_ENTRIES); i++)
+        insert_entry(file_ptr, NANO_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+
+    if(pass) {
+
+        if(cache_ptr->index_len != (uint32_t)(NUM_PICO_ENTRIES + NUM_NANO_ENTRIES)) {
+
+            pass = FALSE;
+            failure_mssg = "unexpected index length after insertions.";
+
+        } else if((cache_ptr->index_nbuckets <= H5C__HASH_TABLE_MIN_LEN) ||
+                  (cache_ptr->index_nbuckets != ((uint32_t)1 << cache_ptr->index_nbits)) ||
+                  (cache_ptr->index_len > 
+                   cache_ptr->index_nbuckets * H5C__HASH_TABLE_MAX_LOAD)) {
+
+            pass = FALSE;
+            failure_mssg = "index not resized as expected.";
+        }
+#if H5C_COLLECT_CACHE_STATS
+        /* 20K entries take the index from 4K to 32K buckets */
+        else if(cache_ptr->total_ht_resizes != 3) {
+
+            pass = FALSE;
+            failure_mssg = "unexpected index resize count.";
+        }
+#endif /* H5C_COLLECT_CACHE_STATS */
+    }
+
+    /* verify that every entry is in the correct bucket, and that the 
+     * buckets hold every entry in the index.
+     */
+    for(bucket = 0; pass && (bucket < cache_ptr->index_nbuckets); bucket++) {
+
+        for(scan_ptr = cache_ptr->index[bucket]; pass && (scan_ptr != NULL);
+                scan_ptr = scan_ptr->ht_next) {
+
+            if((uint32_t)H5C__HASH_FCN(cache_ptr, scan_ptr->addr) != bucket) {
+
+                pass = FALSE;
+                failure_mssg = "entry in wrong hash bucket after index resize.";
+
+            } else if((scan_ptr->ht_next != NULL) &&
+                      (scan_ptr->ht_next->ht_prev != scan_ptr)) {
+
+                pass = FALSE;
+                failure_mssg = "corrupt hash bucket list after index resize.";
+            }
+
+            entry_count++;
+        }
+    }
+
+    if(pass && (entry_count != cache_ptr->index_len)) {
+
+        pass = FALSE;
+        failure_mssg = "hash buckets don't hold all entries after index resize.";
+    }
+
+    /* verify that every entry can still be found */
+    for(i = 0; pass && (i < NUM_PICO_ENTRIES); i++)
+        if(!entry_in_cache(cache_ptr, PICO_ENTRY_TYPE, i)) {
+
+            pass = FALSE;
+            failure_mssg = "pico entry not found after index resize.";
+        }
+
+    for(i = 0; pass && (i < NUM_NANO_ENTRIES); i++)
+        if(!entry_in_cache(cache_ptr, NANO_ENTRY_TYPE, i)) {
+
+            pass = FALSE;
+            failure_mssg = "nano entry not found after index resize.";
+        }
+
+    takedown_cache(file_ptr, FALSE, FALSE);
+
+    if(pass) {
+
+        verify_clean();
+        verify_unprotected();
+    }
+
+    if(pass) { PASSED(); } else { H5_FAILED(); }
+
+    if(!pass) {
+
+        HDfprintf(stdout, "%s(): failure_mssg = \"%s\".\n",
+                  FUNC, failure_mssg);
+    }
+
+    return (unsigned)!pass;
+
+} /* check_index_resize() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	check_slist_order()
+ *
+ * Purpose:	Verify that the slist is sorted into increasing address
+ *		order before it is scanned, regardless of the order in
+ *		which entries are marked dirty.
+ *
+ *		Insert all pico entries in scrambled order, expunge every
+ *		third one to exercise removal from the unsorted list, and
+ *		then verify that:
+ *
+ *		1) H5C__slist_first() returns the remaining dirty entries
+ *		   in increasing address order with consistent links, and
+ *
+ *		2) a flush empties the slist.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+
+static unsigned
+check_slist_order(void)
+{
+    H5F_t *                     file_ptr = NULL;
+    H5C_t *                     cache_ptr = NULL;
+    H5C_cache_entry_t *         scan_ptr;
+    H5C_cache_entry_t *         prev_ptr = NULL;
+    uint32_t                    entry_count = 0;
+    int                         i;
+
+    TESTING("metadata cache slist ordering");
+
+    pass = TRUE;
+
+    reset_entries();
+
+    file_ptr = setup_cache((size_t)(2 * 1024 * 1024),
+                           (size_t)(1 * 1024 * 1024));
+
+    if(pass)
+        cache_ptr = file_ptr->shared->cache;
+
+    /* 7919 is prime, so this visits every pico entry once */
+    for(i = 0; pass && (i < NUM_PICO_ENTRIES); i++)
+        insert_entry(file_ptr, PICO_ENTRY_TYPE, 
+                     (int32_t)(((long)i * 7919) % NUM_PICO_ENTRIES),
+                     H5C__NO_FLAGS_SET);
+
+    if(pass && cache_ptr->slist_sorted) {
+
+        pass = FALSE;
+        failure_mssg = "slist unexpectedly sorted after scrambled inserts.";
+    }
+
+    for(i = 0; pass && (i < NUM_PICO_ENTRIES); i += 3)
+        expunge_entry(file_ptr, PICO_ENTRY_TYPE, i);
+
+    if(pass) {
+
+        scan_ptr = H5C__slist_first(cache_ptr);
+
+        if((scan_ptr != cache_ptr->slist_head) || (!cache_ptr->slist_sorted)) {
+
+            pass = FALSE;
+            failure_mssg = "slist not sorted by H5C__slist_first().";
+        }
+
+        while(pass && (scan_ptr != NULL)) {
+
+            if((!scan_ptr->in_slist) || (!scan_ptr->is_dirty)) {
+
+                pass = FALSE;
+                failure_mssg = "clean entry in slist.";
+
+            } else if(scan_ptr->slist_prev != prev_ptr) {
+
+                pass = FALSE;
+                failure_mssg = "corrupt slist prev pointer after sort.";
+
+            } else if((prev_ptr != NULL) && 
+                      (!H5F_addr_lt(prev_ptr->addr, scan_ptr->addr))) {
+
+                pass = FALSE;
+                failure_mssg = "slist out of address order after sort.";
+            }
+
+            entry_count++;
+            prev_ptr = scan_ptr;
+            scan_ptr = scan_ptr->slist_next;
+        }
+    }
+
+    if(pass && ((entry_count != cache_ptr->slist_len) ||
+                (entry_count != cache_ptr->index_len) ||
+                (prev_ptr != cache_ptr->slist_tail))) {
+
+        pass = FALSE;
+        failure_mssg = "slist doesn't hold all dirty entries after sort.";
+    }
+
+    if(pass)
+        flush_cache(file_ptr, FALSE, FALSE, FALSE);
+
+    if(pass && ((cache_ptr->slist_len != 0) ||
+                (cache_ptr->slist_head != NULL) ||
+                (cache_ptr->slist_tail != NULL))) {
+
+        pass = FALSE;
+        failure_mssg = "slist not empty after flush.";
+    }
+
+    takedown_cache(file_ptr, FALSE, FALSE);
+
+    /* the expunged entries were never flushed, so don't verify_clean() */
+    if(pass)
+        verify_unprotected();
+
+    if(pass) { PASSED(); } else { H5_FAILED(); }
+
+    if(!pass) {
+
+        HDfprintf(stdout, "%s(): failure_mssg = \"%s\".\n",
+                  FUNC, failure_mssg);
+    }
+
+    return (unsigned)!pass;
+
+} /* check_slist_order() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    main
@@ -36348,6 +36704,8 @@ main(void)
     nerrs += check_metadata_cork(FALSE);
     nerrs += check_entry_deletions_during_scans();
     nerrs += check_stats();
+    nerrs += check_index_resize();
+    nerrs += check_slist_order();
 
     /* can't fail, returns void */
     free_entry_arrays();
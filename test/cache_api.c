@@ -36,6 +36,7 @@ static hbool_t mdc_api_call_smoke_check(int express_test);
 static H5AC_cache_config_t * init_invalid_configs(void);
 static hbool_t check_fapl_mdc_api_errs(void);
 static hbool_t check_file_mdc_api_errs(void);
+static hbool_t check_flush_write_batch(void);
 
 
 
@@ -2250,6 +2251,326 @@ check_file_mdc_api_errs(void)
 } /* check_file_mdc_api_errs() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:    check_flush_write_batch()
+ *
+ * Purpose:     Verify that the metadata cache coalesces the writes of
+ *              adjacent entries when it is flushed, and that the file
+ *              reads back correctly afterwards -- including after a
+ *              flush in SWMR write mode, where flush dependency parents
+ *              must not share a write with their children.
+ *
+ * Return:      Test pass status (TRUE/FALSE)
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#define WRITE_BATCH_NGROUPS     200
+#define WRITE_BATCH_NCHUNKS     500
+
+static hbool_t
+check_flush_write_batch(void)
+{
+    char filename[512];
+    char name[32];
+    hid_t fapl_id = -1;
+    hid_t file_id = -1;
+    hid_t group_id = -1;
+    hid_t attr_id = -1;
+    hid_t space_id = -1;
+    hid_t dcpl_id = -1;
+    hid_t dset_id = -1;
+    hsize_t dims = 0;
+    hsize_t max_dims = H5S_UNLIMITED;
+    hsize_t chunk_dims = 1;
+    H5F_t * file_ptr = NULL;
+    H5C_t * cache_ptr = NULL;
+    int64_t writes = 0;
+    int64_t entries = 0;
+    int data[WRITE_BATCH_NCHUNKS];
+    int check[WRITE_BATCH_NCHUNKS];
+    int value;
+    int i;
+
+    TESTING("coalesced writes on metadata cache flush");
+
+    pass = TRUE;
+
+    for ( i = 0; i < WRITE_BATCH_NCHUNKS; i++ ) {
+
+        data[i] = i * 3 + 1;
+    }
+
+    /* setup the file name */
+    if ( pass ) {
+
+        if ( h5_fixname(FILENAME[1], H5P_DEFAULT, filename, sizeof(filename))
+            == NULL ) {
+
+            pass = FALSE;
+            failure_mssg = "h5_fixname() failed.\n";
+        }
+    }
+
+    /* create a file in the latest format, with an empty extendible
+     * chunked dataset and many small groups with an attribute each.
+     */
+    if ( pass ) {
+
+        if ( ( (fapl_id = H5Pcreate(H5P_FILE_ACCESS)) < 0 ) ||
+             ( H5Pset_libver_bounds(fapl_id, H5F_LIBVER_LATEST,
+                                    H5F_LIBVER_LATEST) < 0 ) ||
+             ( (file_id = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT,
+                                    fapl_id)) < 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "can't create file.\n";
+        }
+    }
+
+    if ( pass ) {
+
+        if ( ( (space_id = H5Screate_simple(1, &dims, &max_dims)) < 0 ) ||
+             ( (dcpl_id = H5Pcreate(H5P_DATASET_CREATE)) < 0 ) ||
+             ( H5Pset_chunk(dcpl_id, 1, &chunk_dims) < 0 ) ||
+             ( (dset_id = H5Dcreate2(file_id, "dset", H5T_NATIVE_INT,
+                                     space_id, H5P_DEFAULT, dcpl_id,
+                                     H5P_DEFAULT)) < 0 ) ||
+             ( H5Dclose(dset_id) < 0 ) ||
+             ( H5Pclose(dcpl_id) < 0 ) ||
+             ( H5Sclose(space_id) < 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "can't create dataset.\n";
+        }
+    }
+
+    if ( pass ) {
+
+        if ( (space_id = H5Screate(H5S_SCALAR)) < 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "H5Screate() failed.\n";
+        }
+    }
+
+    for ( i = 0; pass && i < WRITE_BATCH_NGROUPS; i++ ) {
+
+        HDsnprintf(name, sizeof(name), "group_%d", i);
+
+        if ( ( (group_id = H5Gcreate2(file_id, name, H5P_DEFAULT,
+                                      H5P_DEFAULT, H5P_DEFAULT)) < 0 ) ||
+             ( (attr_id = H5Acreate2(group_id, "attr", H5T_NATIVE_INT,
+                                     space_id, H5P_DEFAULT,
+                                     H5P_DEFAULT)) < 0 ) ||
+             ( H5Awrite(attr_id, H5T_NATIVE_INT, &i) < 0 ) ||
+             ( H5Aclose(attr_id) < 0 ) ||
+             ( H5Gclose(group_id) < 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "can't create group.\n";
+        }
+    }
+
+    if ( pass ) {
+
+        if ( H5Sclose(space_id) < 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "H5Sclose() failed.\n";
+        }
+    }
+
+    /* flush the file, and verify that the images of the entries flushed
+     * went to the file in fewer writes than there were entries.
+     */
+    if ( pass ) {
+
+        file_ptr = (H5F_t *)H5I_object_verify(file_id, H5I_FILE);
+
+        if ( file_ptr == NULL ) {
+
+            pass = FALSE;
+            failure_mssg = "Can't get file_ptr.";
+
+        } else {
+
+            cache_ptr = file_ptr->shared->cache;
+            writes = cache_ptr->write_batch_writes;
+            entries = cache_ptr->write_batch_entries;
+        }
+    }
+
+    if ( pass ) {
+
+        if ( H5Fflush(file_id, H5F_SCOPE_GLOBAL) < 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "H5Fflush() failed.\n";
+        }
+    }
+
+    if ( pass ) {
+
+        if ( ( cache_ptr->write_batch_enabled ) ||
+             ( cache_ptr->write_batch_len != 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "write batch still open after flush.\n";
+
+        } else if ( ( cache_ptr->write_batch_writes <= writes ) ||
+                    ( (cache_ptr->write_batch_entries - entries) <=
+                      (cache_ptr->write_batch_writes - writes) ) ) {
+
+            pass = FALSE;
+            failure_mssg = "entry writes not coalesced on flush.\n";
+        }
+    }
+
+    if ( pass ) {
+
+        if ( ( H5Fclose(file_id) < 0 ) ||
+             ( H5Pclose(fapl_id) < 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "can't close file.\n";
+        }
+    }
+
+    /* reopen the file for SWMR writing, and extend and write the dataset
+     * one chunk at a time, flushing the file as we go.  The chunk index
+     * entries are tied together by flush dependencies here.
+     */
+    if ( pass ) {
+
+        if ( ( (fapl_id = H5Pcreate(H5P_FILE_ACCESS)) < 0 ) ||
+             ( H5Pset_libver_bounds(fapl_id, H5F_LIBVER_LATEST,
+                                    H5F_LIBVER_LATEST) < 0 ) ||
+             ( (file_id = H5Fopen(filename,
+                                  H5F_ACC_RDWR | H5F_ACC_SWMR_WRITE,
+                                  fapl_id)) < 0 ) ||
+             ( (dset_id = H5Dopen2(file_id, "dset", H5P_DEFAULT)) < 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "can't reopen file for SWMR writing.\n";
+        }
+    }
+
+    for ( i = 0; pass && i < WRITE_BATCH_NCHUNKS; i++ ) {
+
+        hsize_t start = (hsize_t)i;
+        hsize_t count = 1;
+        hid_t mspace_id = -1;
+
+        dims = (hsize_t)(i + 1);
+
+        if ( ( H5Dset_extent(dset_id, &dims) < 0 ) ||
+             ( (space_id = H5Dget_space(dset_id)) < 0 ) ||
+             ( H5Sselect_hyperslab(space_id, H5S_SELECT_SET, &start, NULL,
+                                   &count, NULL) < 0 ) ||
+             ( (mspace_id = H5Screate_simple(1, &count, NULL)) < 0 ) ||
+             ( H5Dwrite(dset_id, H5T_NATIVE_INT, mspace_id, space_id,
+                        H5P_DEFAULT, &data[i]) < 0 ) ||
+             ( H5Sclose(mspace_id) < 0 ) ||
+             ( H5Sclose(space_id) < 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "can't write chunk.\n";
+
+        } else if ( ( (i + 1) % 50 == 0 ) &&
+                    ( H5Fflush(file_id, H5F_SCOPE_GLOBAL) < 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "H5Fflush() failed in SWMR mode.\n";
+        }
+    }
+
+    if ( pass ) {
+
+        if ( ( H5Dclose(dset_id) < 0 ) ||
+             ( H5Fclose(file_id) < 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "can't close file after SWMR writing.\n";
+        }
+    }
+
+    /* reopen the file read only, and verify its contents */
+    if ( pass ) {
+
+        if ( ( (file_id = H5Fopen(filename, H5F_ACC_RDONLY,
+                                  fapl_id)) < 0 ) ||
+             ( (dset_id = H5Dopen2(file_id, "dset", H5P_DEFAULT)) < 0 ) ||
+             ( H5Dread(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL,
+                       H5P_DEFAULT, check) < 0 ) ||
+             ( H5Dclose(dset_id) < 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "can't read dataset.\n";
+
+        } else if ( HDmemcmp(data, check, sizeof(data)) != 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "unexpected dataset contents.\n";
+        }
+    }
+
+    for ( i = 0; pass && i < WRITE_BATCH_NGROUPS; i++ ) {
+
+        HDsnprintf(name, sizeof(name), "group_%d", i);
+
+        value = -1;
+
+        if ( ( (attr_id = H5Aopen_by_name(file_id, name, "attr",
+                                          H5P_DEFAULT, H5P_DEFAULT)) < 0 ) ||
+             ( H5Aread(attr_id, H5T_NATIVE_INT, &value) < 0 ) ||
+             ( H5Aclose(attr_id) < 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "can't read attribute.\n";
+
+        } else if ( value != i ) {
+
+            pass = FALSE;
+            failure_mssg = "unexpected attribute value.\n";
+        }
+    }
+
+    /* close the file and delete it */
+    if ( pass ) {
+
+        if ( ( H5Fclose(file_id) < 0 ) ||
+             ( H5Pclose(fapl_id) < 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "can't close file.\n";
+
+        } else if ( HDremove(filename) < 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "HDremove() failed.\n";
+        }
+    }
+
+    if ( pass ) {
+
+        PASSED();
+
+    } else {
+
+        H5_FAILED();
+    }
+
+    if ( ! pass ) {
+
+        HDfprintf(stdout, "%s: failure_mssg = \"%s\".\n", FUNC, failure_mssg);
+    }
+
+    return pass;
+
+} /* check_flush_write_batch() */
+
+
 /*-------------------------------------------------------------------------
  * Function:    main
  *
@@ -2314,6 +2635,11 @@ main(void)
         nerrs += 1;
     }
 
+    if ( !check_flush_write_batch() ) {
+
+        nerrs += 1;
+    }
+
     if ( invalid_configs ) {
 
         HDfree(invalid_configs);
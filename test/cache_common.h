@@ -371,16 +371,15 @@ typedef struct test_entry_t
  * updated as necessary.
  */
 
-#define H5C__HASH_MASK          ((size_t)(H5C__HASH_TABLE_LEN - 1) << 3)
-
 #define H5C_TEST__PRE_HT_SEARCH_SC(cache_ptr, Addr)          \
 if ( ( (cache_ptr) == NULL ) ||                              \
      ( (cache_ptr)->magic != H5C__H5C_T_MAGIC ) ||           \
      ( (cache_ptr)->index_size !=                            \
        ((cache_ptr)->clean_index_size + (cache_ptr)->dirty_index_size) ) || \
      ( ! H5F_addr_defined(Addr) ) ||                         \
-     ( H5C__HASH_FCN(Addr) < 0 ) ||                          \
-     ( H5C__HASH_FCN(Addr) >= H5C__HASH_TABLE_LEN ) ) {      \
+     ( H5C__HASH_FCN(cache_ptr, Addr) < 0 ) ||               \
+     ( (uint32_t)H5C__HASH_FCN(cache_ptr, Addr) >=           \
+       (cache_ptr)->index_nbuckets ) ) {                     \
     HDfprintf(stdout, "Pre HT search SC failed.\n");         \
 }
 
@@ -416,7 +415,7 @@ if ( ( (cache_ptr) == NULL ) ||                                        \
 {                                                                       \
     int k;                                                              \
     H5C_TEST__PRE_HT_SEARCH_SC(cache_ptr, Addr)                         \
-    k = H5C__HASH_FCN(Addr);                                            \
+    k = H5C__HASH_FCN(cache_ptr, Addr);                                 \
     entry_ptr = ((cache_ptr)->index)[k];                                \
     while ( entry_ptr )                                                 \
     {                                                                   \
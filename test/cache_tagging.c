@@ -159,7 +159,7 @@ verify_no_unknown_tags(hid_t fid)
         TEST_ERROR;
     cache_ptr = f->shared->cache;
 
-    for(i = 0; i < H5C__HASH_TABLE_LEN; i++) {
+    for(i = 0; i < (int)cache_ptr->index_nbuckets; i++) {
         H5C_cache_entry_t *entry_ptr;      /* entry pointer */
 
         entry_ptr = cache_ptr->index[i];
@@ -207,7 +207,7 @@ mark_all_entries_investigated(hid_t fid)
         TEST_ERROR;
     cache_ptr = f->shared->cache;
 
-    for(i = 0; i < H5C__HASH_TABLE_LEN; i++) {
+    for(i = 0; i < (int)cache_ptr->index_nbuckets; i++) {
         H5C_cache_entry_t *entry_ptr;      /* entry pointer */
 
         entry_ptr = cache_ptr->index[i];
@@ -253,7 +253,7 @@ reset_all_entries_investigated(hid_t fid)
         TEST_ERROR;
     cache_ptr = f->shared->cache;
 
-    for(i = 0; i < H5C__HASH_TABLE_LEN; i++) {
+    for(i = 0; i < (int)cache_ptr->index_nbuckets; i++) {
         H5C_cache_entry_t *entry_ptr;      /* entry pointer */
 
         entry_ptr = cache_ptr->index[i];
@@ -282,6 +282,10 @@ error:
  *              attempts can skip over this entry, knowing it has already been 
  *              checked.
  *
+ *              When several unchecked entries have the provided entry id,
+ *              the one with the lowest address is checked, so that the
+ *              order of the checks doesn't depend on the hash function.
+ *
  * Return:      0 on Success, -1 on Failure
  *
  * Programmer:  Mike McGreevy
@@ -294,37 +298,29 @@ verify_tag(hid_t fid, int id, haddr_t tag)
 {
     H5F_t *f;                   /* File Pointer */
     H5C_t *cache_ptr;           /* Cache Pointer */
-    int i;                      /* Iterator */
+    H5C_cache_entry_t *entry_ptr; /* entry pointer */
+    H5C_cache_entry_t *found_ptr = NULL; /* lowest unchecked entry of type id */
 
     /* Get Internal File / Cache Pointers */
     if(NULL == (f = (H5F_t *)H5I_object(fid)))
         TEST_ERROR;
     cache_ptr = f->shared->cache;
 
-    for(i = 0; i < H5C__HASH_TABLE_LEN; i++) {
-        H5C_cache_entry_t *entry_ptr; /* entry pointer */
-
-        entry_ptr = cache_ptr->index[i];
-        while(entry_ptr != NULL) {
-            if(entry_ptr->type->id == id && !entry_ptr->dirtied) {
-                if(entry_ptr->tag_info->tag != tag)
-                    TEST_ERROR;
+    for(entry_ptr = cache_ptr->il_head; entry_ptr != NULL; entry_ptr = entry_ptr->il_next)
+        if(entry_ptr->type->id == id && !entry_ptr->dirtied)
+            if(found_ptr == NULL || H5F_addr_lt(entry_ptr->addr, found_ptr->addr))
+                found_ptr = entry_ptr;
 
-                /* Mark the entry/tag pair as found */
-                entry_ptr->dirtied = TRUE;
+    /* Didn't find the tagged entry, throw an error */
+    if(found_ptr == NULL)
+        TEST_ERROR;
 
-                /* leave now that we've found the entry */
-                goto done;
-            } /* end if */
+    if(found_ptr->tag_info->tag != tag)
+        TEST_ERROR;
 
-            entry_ptr = entry_ptr->ht_next;
-        } /* end if */
-    } /* end for */
+    /* Mark the entry/tag pair as found */
+    found_ptr->dirtied = TRUE;
 
-    /* Didn't find the tagged entry, throw an error */
-    TEST_ERROR;
-    
-done:
     return 0;
 
 error:
@@ -63,6 +63,12 @@ const char *FILENAME[] = {
     "bt2_hdr_fd",       /* 21 */
     "storage_size",	/* 22 */
     "dls_01_strings",   /* 23 */
+    "chunk_cache_ways", /* 24 */
+    "filter_threads",   /* 25 */
+    "vector_io",        /* 26 */
+    "chunk_info_range", /* 27 */
+    "chunk_write_behind", /* 28 */
+    "chunk_cache_auto", /* 29 */
     NULL
 };
 #define FILENAME_BUF_SIZE       1024
@@ -81,6 +87,8 @@ const char *FILENAME[] = {
 #define DSET_COMPACT_MAX2_NAME   "max_compact_2"
 #define DSET_CONV_BUF_NAME	"conv_buf"
 #define DSET_TCONV_NAME		"tconv"
+#define DSET_TCONV_INPLACE_NAME	"tconv_inplace"
+#define DSET_TCONV_BKG_NAME	"tconv_bkg"
 #define DSET_DEFLATE_NAME	"deflate"
 #define DSET_SHUFFLE_NAME	"shuffle"
 #define DSET_FLETCHER32_NAME	"fletcher32"
@@ -104,6 +112,10 @@ const char *FILENAME[] = {
 #define DSET_SET_LOCAL_NAME	"set_local"
 #define DSET_SET_LOCAL_NAME_2	"set_local_2"
 #define DSET_ONEBYTE_SHUF_NAME	"onebyte_shuffle"
+#define DSET_SHUF_SIZES_NAME	"shuffle_sizes"
+#define DSET_BITSHUFFLE_NAME	"bitshuffle"
+#define DSET_DEFLATE_MIXED_NAME_1	"deflate_mixed_1"
+#define DSET_DEFLATE_MIXED_NAME_2	"deflate_mixed_2"
 #define DSET_NBIT_INT_NAME             "nbit_int"
 #define DSET_NBIT_FLOAT_NAME           "nbit_float"
 #define DSET_NBIT_DOUBLE_NAME          "nbit_double"
@@ -157,6 +169,7 @@ const char *FILENAME[] = {
 #define H5Z_FILTER_EXPAND	310
 #define H5Z_FILTER_CAN_APPLY_TEST2	311
 #define H5Z_FILTER_COUNT        312
+#define H5Z_FILTER_SHUF_CHECK   313
 
 /* Flags for testing filters */
 #define DISABLE_FLETCHER32      0
@@ -231,6 +244,27 @@ const char *FILENAME[] = {
 #define BYPASS_CHUNK_DIM         500
 #define BYPASS_FILL_VALUE        7
 
+/* Parameters for looking up chunks by range */
+#define RANGE_NX                96
+#define RANGE_NY                80
+#define RANGE_CX                8
+#define RANGE_CY                10
+#define RANGE_NCHUNKS           ((RANGE_NX / RANGE_CX) * (RANGE_NY / RANGE_CY))
+
+/* Parameters for writing chunks behind */
+#define WB_NX                   64
+#define WB_NY                   60
+#define WB_CX                   8
+#define WB_CY                   10
+#define WB_CHUNK_NBYTES         (WB_CX * WB_CY * sizeof(int))
+
+/* Parameters for resizing the chunk cache automatically */
+#define AUTO_NX                 80
+#define AUTO_NY                 100
+#define AUTO_CX                 10
+#define AUTO_NCHUNKS            (AUTO_NX / AUTO_CX)
+#define AUTO_CHUNK_NBYTES       (AUTO_CX * AUTO_NY * sizeof(int))
+
 /* Parameters for testing extensible array chunk indices */
 #define EARRAY_MAX_RANK         3
 #define EARRAY_DSET_DIM         15
@@ -282,6 +316,8 @@ static size_t filter_expand(unsigned int flags, size_t cd_nelmts,
     const unsigned int *cd_values, size_t nbytes, size_t *buf_size, void **buf);
 static size_t filter_count(unsigned int flags, size_t cd_nelmts,
     const unsigned int *cd_values, size_t nbytes, size_t *buf_size, void **buf);
+static size_t filter_shuf_check(unsigned int flags, size_t cd_nelmts,
+    const unsigned int *cd_values, size_t nbytes, size_t *buf_size, void **buf);
 
 /* This message derives from H5Z */
 const H5Z_class2_t H5Z_COUNT[1] = {{
@@ -324,6 +360,55 @@ filter_count(unsigned int flags, size_t H5_ATTR_UNUSED cd_nelmts,
     return nbytes;
 }
 
+/* Expected output of the shuffle filter, checked by filter_shuf_check().
+ * When shuf_check_prefix is set, only the first shuf_check_nbytes bytes of
+ * the output are compared. */
+static const unsigned char *shuf_check_expect = NULL;
+static size_t shuf_check_nbytes = 0;
+static int shuf_check_prefix = 0;
+static int shuf_check_mismatch = 0;
+
+/* This message derives from H5Z */
+const H5Z_class2_t H5Z_SHUF_CHECK[1] = {{
+    H5Z_CLASS_T_VERS,       /* H5Z_class_t version */
+    H5Z_FILTER_SHUF_CHECK,      /* Filter id number             */
+    1, 1,               /* Encoding and decoding enabled */
+    "shuffle_check",            /* Filter name for debugging    */
+    NULL,                       /* The "can apply" callback     */
+    NULL,                       /* The "set local" callback     */
+    filter_shuf_check,          /* The actual filter function   */
+}};
+
+
+/*-------------------------------------------------------------------------
+ * Function:    filter_shuf_check
+ *
+ * Purpose:     This filter runs after the [bit]shuffle filter on write and
+ *              compares the shuffled bytes with shuf_check_expect, setting
+ *              shuf_check_mismatch if they differ.  The data is passed
+ *              through unchanged in both directions.
+ *
+ * Return:      Success:        Data chunk size
+ *
+ *              Failure:        0
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+filter_shuf_check(unsigned int flags, size_t H5_ATTR_UNUSED cd_nelmts,
+      const unsigned int H5_ATTR_UNUSED *cd_values, size_t nbytes,
+      size_t H5_ATTR_UNUSED *buf_size, void **buf)
+{
+    if(!(flags & H5Z_FLAG_REVERSE) && shuf_check_expect) {
+        if(shuf_check_prefix ? nbytes < shuf_check_nbytes : nbytes != shuf_check_nbytes)
+            shuf_check_mismatch = 1;
+        else if(HDmemcmp(*buf, shuf_check_expect, shuf_check_nbytes))
+            shuf_check_mismatch = 1;
+    } /* end if */
+
+    return nbytes;
+}
+
 
 /*-------------------------------------------------------------------------
  * Function:	test_create
@@ -1342,6 +1427,155 @@ error:
     return -1;
 }
 
+/*-------------------------------------------------------------------------
+ * Function:	test_tconv_inplace
+ *
+ * Purpose:	Test reads that widen the datatype into a contiguous block
+ *		of the application's buffer, which are converted in place,
+ *		and repeated reads of one dataset, which reuse the dataset's
+ *		conversion and background buffers.
+ *
+ * Return:	Success:	0
+ *
+ *		Failure:	-1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_tconv_inplace(hid_t file)
+{
+    typedef struct {
+        short   a;
+        short   b;
+    } pair_t;
+    typedef struct {
+        int     x;
+        int     b;
+    } mem_pair_t;
+    pair_t      *wdata = NULL;
+    double      *rdata = NULL;
+    mem_pair_t  *mdata = NULL;
+    hsize_t     dims[1] = {10000}, mdims[1] = {20010};
+    hsize_t     start[1], stride[1], count[1];
+    hid_t       space = -1, mspace = -1, dataset = -1, dataset2 = -1;
+    hid_t       ftype = -1, mtype = -1;
+    int         i, pass;
+
+    TESTING("in-place data type conversion on read");
+
+    if(NULL == (wdata = (pair_t *)HDmalloc(dims[0] * sizeof(pair_t)))) goto error;
+    if(NULL == (rdata = (double *)HDmalloc(mdims[0] * sizeof(double)))) goto error;
+    if(NULL == (mdata = (mem_pair_t *)HDmalloc(dims[0] * sizeof(mem_pair_t)))) goto error;
+    for(i = 0; i < (int)dims[0]; i++) {
+        wdata[i].a = (short)(i - 5000);
+        wdata[i].b = (short)(3 * i);
+    } /* end for */
+
+    /* Create a dataset of shorts, written from ints, and one of pairs */
+    for(i = 0; i < (int)dims[0]; i++)
+        mdata[i].x = wdata[i].a;
+    if((space = H5Screate_simple(1, dims, NULL)) < 0) goto error;
+    if((dataset = H5Dcreate2(file, DSET_TCONV_INPLACE_NAME, H5T_STD_I16BE, space,
+            H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) goto error;
+    if((mspace = H5Screate_simple(1, mdims, NULL)) < 0) goto error;
+    start[0] = 0; stride[0] = 2; count[0] = dims[0];
+    if(H5Sselect_hyperslab(mspace, H5S_SELECT_SET, start, stride, count, NULL) < 0) goto error;
+    if(H5Dwrite(dataset, H5T_NATIVE_INT, mspace, H5S_ALL, H5P_DEFAULT, mdata) < 0) goto error;
+    if(H5Sclose(mspace) < 0) goto error;
+
+    if((ftype = H5Tcreate(H5T_COMPOUND, sizeof(pair_t))) < 0) goto error;
+    if(H5Tinsert(ftype, "a", HOFFSET(pair_t, a), H5T_NATIVE_SHORT) < 0) goto error;
+    if(H5Tinsert(ftype, "b", HOFFSET(pair_t, b), H5T_NATIVE_SHORT) < 0) goto error;
+    if((dataset2 = H5Dcreate2(file, DSET_TCONV_BKG_NAME, ftype, space,
+            H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) goto error;
+    if(H5Dwrite(dataset2, ftype, H5S_ALL, H5S_ALL, H5P_DEFAULT, wdata) < 0) goto error;
+
+    /* Read as doubles into a memory space with room for a guard before
+     * and after a contiguous block */
+    if((mspace = H5Screate_simple(1, mdims, NULL)) < 0) goto error;
+
+    for(pass = 0; pass < 2; pass++) {
+        for(i = 0; i < (int)mdims[0]; i++)
+            rdata[i] = -1.0;
+
+        if(pass == 0) {
+            /* Contiguous block at offset 5, converted in place */
+            start[0] = 5; stride[0] = 1; count[0] = dims[0];
+        } /* end if */
+        else {
+            /* Every other element, converted through the conversion buffer */
+            start[0] = 1; stride[0] = 2; count[0] = dims[0];
+        } /* end else */
+        if(H5Sselect_hyperslab(mspace, H5S_SELECT_SET, start, stride, count, NULL) < 0) goto error;
+        if(H5Dread(dataset, H5T_NATIVE_DOUBLE, mspace, H5S_ALL, H5P_DEFAULT, rdata) < 0) goto error;
+
+        for(i = 0; i < (int)mdims[0]; i++) {
+            double expect = -1.0;
+
+            if(i >= (int)start[0] && (i - (int)start[0]) % (int)stride[0] == 0 &&
+                    (i - (int)start[0]) / (int)stride[0] < (int)dims[0])
+                expect = (double)wdata[(i - (int)start[0]) / (int)stride[0]].a;
+            if(rdata[i] != expect) {
+                H5_FAILED();
+                printf("    Read %s selection: element %d is %g, expected %g\n",
+                        pass ? "strided" : "contiguous", i, rdata[i], expect);
+                goto error;
+            } /* end if */
+        } /* end for */
+    } /* end for */
+
+    /* Reads into a memory type with a gap need the background, which must
+     * come from the application's buffer on every read */
+    if((mtype = H5Tcreate(H5T_COMPOUND, sizeof(mem_pair_t))) < 0) goto error;
+    if(H5Tinsert(mtype, "b", HOFFSET(mem_pair_t, b), H5T_NATIVE_INT) < 0) goto error;
+    for(pass = 0; pass < 2; pass++) {
+        for(i = 0; i < (int)dims[0]; i++) {
+            mdata[i].x = i + pass;
+            mdata[i].b = -1;
+        } /* end for */
+        if(H5Dread(dataset2, mtype, H5S_ALL, H5S_ALL, H5P_DEFAULT, mdata) < 0) goto error;
+        for(i = 0; i < (int)dims[0]; i++)
+            if(mdata[i].x != i + pass || mdata[i].b != wdata[i].b) {
+                H5_FAILED();
+                printf("    Read with background, pass %d: element %d is {%d, %d}\n",
+                        pass, i, mdata[i].x, mdata[i].b);
+                goto error;
+            } /* end if */
+    } /* end for */
+
+    if(H5Dclose(dataset) < 0) goto error;
+    if(H5Dclose(dataset2) < 0) goto error;
+    if(H5Sclose(space) < 0) goto error;
+    if(H5Sclose(mspace) < 0) goto error;
+    if(H5Tclose(ftype) < 0) goto error;
+    if(H5Tclose(mtype) < 0) goto error;
+    HDfree(wdata);
+    HDfree(rdata);
+    HDfree(mdata);
+
+    PASSED();
+    return 0;
+
+error:
+    if(wdata)
+        HDfree(wdata);
+    if(rdata)
+        HDfree(rdata);
+    if(mdata)
+        HDfree(mdata);
+
+    H5E_BEGIN_TRY {
+        H5Dclose(dataset);
+        H5Dclose(dataset2);
+        H5Sclose(space);
+        H5Sclose(mspace);
+        H5Tclose(ftype);
+        H5Tclose(mtype);
+    } H5E_END_TRY;
+
+    return -1;
+}
+
 /* This message derives from H5Z */
 const H5Z_class2_t H5Z_BOGUS[1] = {{
     H5Z_CLASS_T_VERS,       /* H5Z_class_t version */
@@ -2813,6 +3047,450 @@ error:
 }
 
 
+/*-------------------------------------------------------------------------
+ * Function:	test_shuffle_sizes
+ *
+ * Purpose:	Tests the shuffle filter for a range of element sizes and
+ *              element counts, so that both the vectorized kernels and the
+ *              scalar loop that handles the remaining elements are used.
+ *              The shuffled bytes are compared against a straightforward
+ *              reference transpose and the data is read back.
+ *
+ * Return:	Success:	0
+ *
+ *		Failure:	-1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_shuffle_sizes(hid_t file)
+{
+    const size_t        type_sizes[] = {2, 3, 4, 5, 8, 16};
+    const hsize_t       nelmts[] = {2, 15, 20, 33, 1000, 1037};
+    hid_t		dataset = -1, space = -1, dc = -1, type = -1;
+    unsigned char       *orig = NULL, *expect = NULL, *rbuf = NULL;
+    char                name[64];
+    size_t		s, n, i, b;
+
+    TESTING("shuffling of assorted element sizes");
+
+    if(H5Zregister(H5Z_SHUF_CHECK) < 0) goto error;
+
+    for(s = 0; s < NELMTS(type_sizes); s++) {
+        for(n = 0; n < NELMTS(nelmts); n++) {
+            size_t tsize = type_sizes[s];
+            size_t count = (size_t)nelmts[n];
+            size_t nbytes = tsize * count;
+
+            if(NULL == (orig = (unsigned char *)HDmalloc(nbytes))) goto error;
+            if(NULL == (expect = (unsigned char *)HDmalloc(nbytes))) goto error;
+            if(NULL == (rbuf = (unsigned char *)HDmalloc(nbytes))) goto error;
+
+            /* Reference shuffle: byte B of element I goes to B*count+I */
+            for(i = 0; i < nbytes; i++)
+                orig[i] = (unsigned char)HDrandom();
+            for(i = 0; i < count; i++)
+                for(b = 0; b < tsize; b++)
+                    expect[b * count + i] = orig[i * tsize + b];
+
+            if((space = H5Screate_simple(1, &nelmts[n], NULL)) < 0) goto error;
+            if((type = H5Tcreate(H5T_OPAQUE, tsize)) < 0) goto error;
+            if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) goto error;
+            if(H5Pset_chunk(dc, 1, &nelmts[n]) < 0) goto error;
+            if(H5Pset_shuffle(dc) < 0) goto error;
+            if(H5Pset_filter(dc, H5Z_FILTER_SHUF_CHECK, 0, (size_t)0, NULL) < 0) goto error;
+
+            HDsnprintf(name, sizeof(name), "%s_%lu_%lu", DSET_SHUF_SIZES_NAME,
+                    (unsigned long)tsize, (unsigned long)count);
+            if((dataset = H5Dcreate2(file, name, type, space, H5P_DEFAULT, dc,
+                    H5P_DEFAULT)) < 0) goto error;
+
+            shuf_check_expect = expect;
+            shuf_check_nbytes = nbytes;
+            shuf_check_mismatch = 0;
+            if(H5Dwrite(dataset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig) < 0)
+                goto error;
+            if(H5Dclose(dataset) < 0) goto error;
+            dataset = -1;
+            shuf_check_expect = NULL;
+            if(shuf_check_mismatch) {
+                H5_FAILED();
+                printf("    Shuffled bytes differ from reference for %lu %lu-byte elements\n",
+                       (unsigned long)count, (unsigned long)tsize);
+                goto error;
+            }
+
+            /* Read the data back through the unshuffle path */
+            if((dataset = H5Dopen2(file, name, H5P_DEFAULT)) < 0) goto error;
+            if(H5Dread(dataset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
+                goto error;
+            if(HDmemcmp(rbuf, orig, nbytes)) {
+                H5_FAILED();
+                printf("    Read different values than written for %lu %lu-byte elements\n",
+                       (unsigned long)count, (unsigned long)tsize);
+                goto error;
+            }
+
+            if(H5Dclose(dataset) < 0) goto error;
+            if(H5Pclose(dc) < 0) goto error;
+            if(H5Tclose(type) < 0) goto error;
+            if(H5Sclose(space) < 0) goto error;
+            HDfree(orig);
+            HDfree(expect);
+            HDfree(rbuf);
+            orig = expect = rbuf = NULL;
+        } /* end for */
+    } /* end for */
+
+    PASSED();
+
+    return 0;
+
+error:
+    shuf_check_expect = NULL;
+    H5E_BEGIN_TRY {
+        H5Dclose(dataset);
+        H5Pclose(dc);
+        H5Tclose(type);
+        H5Sclose(space);
+    } H5E_END_TRY;
+    if(orig)
+        HDfree(orig);
+    if(expect)
+        HDfree(expect);
+    if(rbuf)
+        HDfree(rbuf);
+    return -1;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	test_bitshuffle
+ *
+ * Purpose:	Tests the bitshuffle filter with and without LZ4, for a
+ *              range of element sizes, element counts and block sizes.
+ *              Without compression the output is compared against a
+ *              reference bit transpose; with LZ4 the chunk header is
+ *              checked.  The data is read back in both cases.  Also
+ *              checks that bad parameters are rejected.
+ *
+ * Return:	Success:	0
+ *
+ *		Failure:	-1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_bitshuffle(hid_t file)
+{
+    const size_t        type_sizes[] = {1, 2, 3, 4, 8};
+    const hsize_t       nelmts[] = {7, 64, 1003, 5000};
+    const unsigned      block_sizes[] = {0, 64};
+    const unsigned      compress[] = {H5Z_BSHUF_COMPRESS_NONE, H5Z_BSHUF_COMPRESS_LZ4};
+    unsigned            cd_values[H5Z_BSHUF_TOTAL_NPARMS];
+    hid_t		dataset = -1, space = -1, dc = -1, type = -1;
+    unsigned char       *orig = NULL, *expect = NULL, *rbuf = NULL;
+    char                name[64];
+    herr_t              ret;
+    size_t		s, n, z, c, i, j, k;
+
+    TESTING("bitshuffle filter");
+
+    if(H5Zregister(H5Z_SHUF_CHECK) < 0) goto error;
+
+    for(s = 0; s < NELMTS(type_sizes); s++)
+    for(n = 0; n < NELMTS(nelmts); n++)
+    for(z = 0; z < NELMTS(block_sizes); z++)
+    for(c = 0; c < NELMTS(compress); c++) {
+        size_t tsize = type_sizes[s];
+        size_t count = (size_t)nelmts[n];
+        size_t nbytes = tsize * count;
+        size_t bsize = block_sizes[z];
+        size_t e0;
+
+        if(NULL == (orig = (unsigned char *)HDmalloc(nbytes))) goto error;
+        if(NULL == (expect = (unsigned char *)HDcalloc(nbytes, 1))) goto error;
+        if(NULL == (rbuf = (unsigned char *)HDmalloc(nbytes))) goto error;
+
+        /* Slowly varying values with a little noise in the low bits */
+        for(i = 0; i < count; i++)
+            for(j = 0; j < tsize; j++)
+                orig[i * tsize + j] = (unsigned char)(j == 0 ? (i / 3) + (HDrandom() & 1) :
+                        (j == 1 ? i >> 8 : 0));
+
+        if(bsize == 0) {
+            bsize = (8192 / tsize) - (8192 / tsize) % 8;
+            if(bsize < 128)
+                bsize = 128;
+        } /* end if */
+
+        if(compress[c] == H5Z_BSHUF_COMPRESS_NONE) {
+            /* Reference bit transpose: within each block of NB elements,
+             * bit K of byte J of element I goes to bit (J*8+K)*NB+I */
+            for(e0 = 0; e0 < count; e0 += bsize) {
+                size_t nb = MIN(bsize, count - e0);
+                unsigned char *out = expect + e0 * tsize;
+
+                nb -= nb % 8;
+                for(i = 0; i < nb; i++)
+                    for(j = 0; j < tsize; j++)
+                        for(k = 0; k < 8; k++)
+                            if((orig[(e0 + i) * tsize + j] >> k) & 1) {
+                                size_t pos = (j * 8 + k) * nb + i;
+
+                                out[pos / 8] = (unsigned char)(out[pos / 8] | (1 << (pos % 8)));
+                            } /* end if */
+            } /* end for */
+
+            /* The elements after the last group of 8 are stored as they are */
+            e0 = count - count % 8;
+            HDmemcpy(expect + e0 * tsize, orig + e0 * tsize, (count - e0) * tsize);
+            shuf_check_nbytes = nbytes;
+            shuf_check_prefix = 0;
+        } /* end if */
+        else {
+            /* LZ4 chunks start with the size and the block size in bytes */
+            for(i = 0; i < 8; i++)
+                expect[i] = (unsigned char)(((unsigned long long)nbytes) >> (8 * (7 - i)));
+            for(i = 0; i < 4; i++)
+                expect[8 + i] = (unsigned char)((bsize * tsize) >> (8 * (3 - i)));
+            shuf_check_nbytes = MIN(nbytes, 12);
+            shuf_check_prefix = 1;
+        } /* end else */
+
+        if((space = H5Screate_simple(1, &nelmts[n], NULL)) < 0) goto error;
+        if((type = H5Tcreate(H5T_OPAQUE, tsize)) < 0) goto error;
+        if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) goto error;
+        if(H5Pset_chunk(dc, 1, &nelmts[n]) < 0) goto error;
+        if(H5Pset_bitshuffle(dc, block_sizes[z], compress[c]) < 0) goto error;
+        if(H5Pset_filter(dc, H5Z_FILTER_SHUF_CHECK, 0, (size_t)0, NULL) < 0) goto error;
+
+        HDsnprintf(name, sizeof(name), "%s_%lu_%lu_%u_%u", DSET_BITSHUFFLE_NAME,
+                (unsigned long)tsize, (unsigned long)count, block_sizes[z], compress[c]);
+        if((dataset = H5Dcreate2(file, name, type, space, H5P_DEFAULT, dc,
+                H5P_DEFAULT)) < 0) goto error;
+
+        shuf_check_expect = expect;
+        shuf_check_mismatch = 0;
+        if(H5Dwrite(dataset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig) < 0)
+            goto error;
+        if(H5Dclose(dataset) < 0) goto error;
+        dataset = -1;
+        shuf_check_expect = NULL;
+        shuf_check_prefix = 0;
+        if(shuf_check_mismatch) {
+            H5_FAILED();
+            printf("    Bitshuffled bytes differ from reference for %lu %lu-byte elements (block size %u, compression %u)\n",
+                   (unsigned long)count, (unsigned long)tsize, block_sizes[z], compress[c]);
+            goto error;
+        } /* end if */
+
+        /* Read the data back and rbuf that LZ4 compressed it */
+        if((dataset = H5Dopen2(file, name, H5P_DEFAULT)) < 0) goto error;
+        if(H5Dread(dataset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
+            goto error;
+        if(HDmemcmp(rbuf, orig, nbytes)) {
+            H5_FAILED();
+            printf("    Read different values than written for %lu %lu-byte elements (block size %u, compression %u)\n",
+                   (unsigned long)count, (unsigned long)tsize, block_sizes[z], compress[c]);
+            goto error;
+        } /* end if */
+        if(compress[c] == H5Z_BSHUF_COMPRESS_LZ4 && count >= 1000
+                && H5Dget_storage_size(dataset) >= nbytes) {
+            H5_FAILED();
+            printf("    LZ4 didn't compress %lu %lu-byte elements\n",
+                   (unsigned long)count, (unsigned long)tsize);
+            goto error;
+        } /* end if */
+
+        if(H5Dclose(dataset) < 0) goto error;
+        if(H5Pclose(dc) < 0) goto error;
+        if(H5Tclose(type) < 0) goto error;
+        if(H5Sclose(space) < 0) goto error;
+        HDfree(orig);
+        HDfree(expect);
+        HDfree(rbuf);
+        orig = expect = rbuf = NULL;
+    } /* end for */
+
+    /* Block sizes must be a multiple of 8, and the compression known */
+    if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) goto error;
+    H5E_BEGIN_TRY {
+        ret = H5Pset_bitshuffle(dc, 12, H5Z_BSHUF_COMPRESS_NONE);
+    } H5E_END_TRY;
+    if(ret >= 0) {
+        H5_FAILED();
+        puts("    Block size that isn't a multiple of 8 accepted.");
+        goto error;
+    } /* end if */
+    H5E_BEGIN_TRY {
+        ret = H5Pset_bitshuffle(dc, 0, 1);
+    } H5E_END_TRY;
+    if(ret >= 0) {
+        H5_FAILED();
+        puts("    Unknown bitshuffle compression accepted.");
+        goto error;
+    } /* end if */
+
+    /* ... including when the parameters are set directly */
+    HDmemset(cd_values, 0, sizeof(cd_values));
+    cd_values[H5Z_BSHUF_PARM_COMPRESS] = 7;
+    if(H5Pset_chunk(dc, 1, &nelmts[1]) < 0) goto error;
+    if(H5Pset_filter(dc, H5Z_FILTER_BITSHUFFLE, 0, (size_t)H5Z_BSHUF_TOTAL_NPARMS, cd_values) < 0) goto error;
+    if((space = H5Screate_simple(1, &nelmts[1], NULL)) < 0) goto error;
+    H5E_BEGIN_TRY {
+        dataset = H5Dcreate2(file, DSET_BITSHUFFLE_NAME, H5T_NATIVE_INT, space, H5P_DEFAULT, dc, H5P_DEFAULT);
+    } H5E_END_TRY;
+    if(dataset >= 0) {
+        H5_FAILED();
+        puts("    Dataset created with unknown bitshuffle compression.");
+        goto error;
+    } /* end if */
+    if(H5Sclose(space) < 0) goto error;
+    if(H5Pclose(dc) < 0) goto error;
+
+    PASSED();
+
+    return 0;
+
+error:
+    shuf_check_expect = NULL;
+    shuf_check_prefix = 0;
+    H5E_BEGIN_TRY {
+        H5Dclose(dataset);
+        H5Pclose(dc);
+        H5Tclose(type);
+        H5Sclose(space);
+    } H5E_END_TRY;
+    if(orig)
+        HDfree(orig);
+    if(expect)
+        HDfree(expect);
+    if(rbuf)
+        HDfree(rbuf);
+    return -1;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	test_deflate_mixed
+ *
+ * Purpose:	Tests the deflate filter on two datasets with different
+ *              compression levels and chunk sizes, accessed in turn, so
+ *              the filter's reused zlib streams switch between levels and
+ *              between larger and smaller chunks.
+ *
+ * Return:	Success:	0
+ *
+ *		Failure:	-1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_deflate_mixed(hid_t file)
+{
+#ifdef H5_HAVE_FILTER_DEFLATE
+    const char          *names[2] = {DSET_DEFLATE_MIXED_NAME_1, DSET_DEFLATE_MIXED_NAME_2};
+    const hsize_t       chunk_dims[2] = {100, 5000};
+    const unsigned      levels[2] = {1, 9};
+    const hsize_t       dims[1] = {20000};
+    hid_t		dsets[2] = {-1, -1}, space = -1, dc = -1;
+    int                 *orig = NULL, *rbuf = NULL;
+    hsize_t             start[1], count[1];
+    hid_t               mspace = -1;
+    int                 round;
+    size_t		i, u;
+
+    TESTING("deflate filter with mixed levels and chunk sizes");
+
+    if(NULL == (orig = (int *)HDmalloc((size_t)dims[0] * sizeof(int)))) goto error;
+    if(NULL == (rbuf = (int *)HDmalloc((size_t)dims[0] * sizeof(int)))) goto error;
+    for(i = 0; i < (size_t)dims[0]; i++)
+        orig[i] = (int)(i / 5) + (int)(HDrandom() % 3);
+
+    if((space = H5Screate_simple(1, dims, NULL)) < 0) goto error;
+    for(u = 0; u < 2; u++) {
+        if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) goto error;
+        if(H5Pset_chunk(dc, 1, &chunk_dims[u]) < 0) goto error;
+        if(H5Pset_deflate(dc, levels[u]) < 0) goto error;
+        if((dsets[u] = H5Dcreate2(file, names[u], H5T_NATIVE_INT, space, H5P_DEFAULT,
+                dc, H5P_DEFAULT)) < 0) goto error;
+        if(H5Pclose(dc) < 0) goto error;
+        dc = -1;
+    } /* end for */
+
+    /* Write, then read, a part of each dataset in turn */
+    for(round = 0; round < 4; round++) {
+        start[0] = (hsize_t)round * 5000;
+        count[0] = 5000;
+        if((mspace = H5Screate_simple(1, count, NULL)) < 0) goto error;
+        if(H5Sselect_hyperslab(space, H5S_SELECT_SET, start, NULL, count, NULL) < 0) goto error;
+        for(u = 0; u < 2; u++)
+            if(H5Dwrite(dsets[u], H5T_NATIVE_INT, mspace, space, H5P_DEFAULT, orig + start[0]) < 0)
+                goto error;
+        for(u = 0; u < 2; u++) {
+            if(H5Dclose(dsets[u]) < 0) goto error;
+            if((dsets[u] = H5Dopen2(file, names[u], H5P_DEFAULT)) < 0) goto error;
+        } /* end for */
+        for(u = 0; u < 2; u++) {
+            HDmemset(rbuf, 0, (size_t)count[0] * sizeof(int));
+            if(H5Dread(dsets[1 - u], H5T_NATIVE_INT, mspace, space, H5P_DEFAULT, rbuf) < 0)
+                goto error;
+            if(HDmemcmp(rbuf, orig + start[0], (size_t)count[0] * sizeof(int))) {
+                H5_FAILED();
+                printf("    Read different values than written in dataset %s\n", names[1 - u]);
+                goto error;
+            } /* end if */
+        } /* end for */
+        if(H5Sclose(mspace) < 0) goto error;
+        mspace = -1;
+    } /* end for */
+
+    /* Read all of both datasets */
+    for(u = 0; u < 2; u++) {
+        if(H5Dread(dsets[u], H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
+            goto error;
+        if(HDmemcmp(rbuf, orig, (size_t)dims[0] * sizeof(int))) {
+            H5_FAILED();
+            printf("    Read different values than written in dataset %s\n", names[u]);
+            goto error;
+        } /* end if */
+        if(H5Dclose(dsets[u]) < 0) goto error;
+        dsets[u] = -1;
+    } /* end for */
+    if(H5Sclose(space) < 0) goto error;
+
+    HDfree(orig);
+    HDfree(rbuf);
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsets[0]);
+        H5Dclose(dsets[1]);
+        H5Pclose(dc);
+        H5Sclose(mspace);
+        H5Sclose(space);
+    } H5E_END_TRY;
+    if(orig)
+        HDfree(orig);
+    if(rbuf)
+        HDfree(rbuf);
+    return -1;
+#else /* H5_HAVE_FILTER_DEFLATE */
+    (void)file;
+
+    TESTING("deflate filter with mixed levels and chunk sizes");
+    SKIPPED();
+    puts("    Deflate filter not enabled");
+    return 0;
+#endif /* H5_HAVE_FILTER_DEFLATE */
+}
+
+
 /*-------------------------------------------------------------------------
  * Function:    test_nbit_int
  *
@@ -7926,6 +8604,1041 @@ error:
 } /* end test_chunk_cache() */
 
 
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_cache_ways
+ *
+ * Purpose: Tests the associativity of the raw data chunk cache.  Writes a
+ *          group of chunks which all hash to the same set of slots and
+ *          verifies that they stay in the cache together when the cache is
+ *          set-associative, while only one of them stays when the cache is
+ *          direct-mapped.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_cache_ways(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;       /* File ID */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       dapl = -1;      /* Dataset access property list ID */
+    hid_t       dapl2 = -1;     /* Dataset access property list ID */
+    hid_t       sid = -1;       /* Dataspace ID */
+    hid_t       mid = -1;       /* Memory dataspace ID */
+    hid_t       dsid = -1;      /* Dataset ID */
+    hsize_t     dim, chunk_dim; /* Dataset and chunk dimensions */
+    hsize_t     start, stride, count; /* Hyperslab selection */
+    size_t      nbytes_used;    /* Bytes in chunk cache */
+    int         nused;          /* Entries in chunk cache */
+    unsigned    nways;          /* Associativity of chunk cache */
+    int         wbuf[8], rbuf[8]; /* Data buffers */
+    unsigned    u;              /* Local index variable */
+    herr_t      ret;            /* Generic return value */
+
+    TESTING("dataset chunk cache associativity");
+
+    h5_fixname(FILENAME[24], fapl, filename, sizeof filename);
+
+    /* Check the default value and argument checking */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache_ways(dapl, &nways) < 0) FAIL_STACK_ERROR
+    if(nways != 8) FAIL_PUTS_ERROR("    Default chunk cache associativity is not 8.")
+    H5E_BEGIN_TRY {
+        ret = H5Pset_chunk_cache_ways(dapl, 0);
+    } H5E_END_TRY;
+    if(ret >= 0) FAIL_PUTS_ERROR("    Zero chunk cache associativity accepted.")
+
+    /* Create file with a 1-D dataset of single element chunks.  The 8 chunks
+     * selected below are 64 chunks apart, so they collide in a 64 slot
+     * direct-mapped cache, but fit in one set of an 8-way cache.
+     */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    chunk_dim = 1;
+    if(H5Pset_chunk(dcpl, 1, &chunk_dim) < 0) FAIL_STACK_ERROR
+    dim = 8 * 64;
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+    count = 8;
+    if((mid = H5Screate_simple(1, &count, NULL)) < 0) FAIL_STACK_ERROR
+    start = 0;
+    stride = 64;
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, &stride, &count, NULL) < 0) FAIL_STACK_ERROR
+    for(u = 0; u < 8; u++)
+        wbuf[u] = (int)u + 1;
+
+    /* Set-associative cache: all 8 chunks stay cached */
+    if(H5Pset_chunk_cache(dapl, (size_t)64, (size_t)(1024 * 1024), H5D_CHUNK_CACHE_W0_DEFAULT) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache_ways(dapl, 8) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dopen2(fid, "dset", dapl)) < 0) FAIL_STACK_ERROR
+    if((dapl2 = H5Dget_access_plist(dsid)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache_ways(dapl2, &nways) < 0) FAIL_STACK_ERROR
+    if(nways != 8) FAIL_PUTS_ERROR("    Chunk cache associativity from dataset doesn't match.")
+    if(H5Pclose(dapl2) < 0) FAIL_STACK_ERROR
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5D__current_cache_size_test(dsid, &nbytes_used, &nused) < 0) FAIL_STACK_ERROR
+    if(nused != 8 || nbytes_used != 8 * sizeof(int))
+        FAIL_PUTS_ERROR("    Colliding chunks were not all cached.")
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+    /* Direct-mapped cache: the chunks preempt each other */
+    if(H5Pset_chunk_cache_ways(dapl, 1) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dopen2(fid, "dset", dapl)) < 0) FAIL_STACK_ERROR
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    if(H5Dread(dsid, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    if(H5D__current_cache_size_test(dsid, &nbytes_used, &nused) < 0) FAIL_STACK_ERROR
+    if(nused != 1)
+        FAIL_PUTS_ERROR("    Colliding chunks were cached in a direct-mapped cache.")
+    for(u = 0; u < 8; u++)
+        if(rbuf[u] != wbuf[u])
+            FAIL_PUTS_ERROR("    Incorrect data read.")
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+    /* More ways than slots: one fully associative set */
+    if(H5Pset_chunk_cache(dapl, (size_t)4, (size_t)(1024 * 1024), H5D_CHUNK_CACHE_W0_DEFAULT) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache_ways(dapl, 8) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dopen2(fid, "dset", dapl)) < 0) FAIL_STACK_ERROR
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    if(H5Dread(dsid, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    if(H5D__current_cache_size_test(dsid, &nbytes_used, &nused) < 0) FAIL_STACK_ERROR
+    if(nused != 4)
+        FAIL_PUTS_ERROR("    Fully associative cache not filled.")
+    for(u = 0; u < 8; u++)
+        if(rbuf[u] != wbuf[u])
+            FAIL_PUTS_ERROR("    Incorrect data read.")
+    if((dapl2 = H5Dget_access_plist(dsid)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache_ways(dapl2, &nways) < 0) FAIL_STACK_ERROR
+    if(nways != 4) FAIL_PUTS_ERROR("    Chunk cache associativity not limited to number of slots.")
+    if(H5Pclose(dapl2) < 0) FAIL_STACK_ERROR
+
+    /* Close */
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(mid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dapl);
+        H5Pclose(dapl2);
+        H5Pclose(dcpl);
+        H5Dclose(dsid);
+        H5Sclose(mid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_chunk_cache_ways() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_filter_threads
+ *
+ * Purpose: Tests running the filter pipeline on several threads.  Writes
+ *          and reads datasets with partial edge chunks through a dxpl
+ *          asking for several filter threads, and verifies the data and the
+ *          file contents match those produced with the default serial
+ *          pipeline.  Also reads strided selections, with and without type
+ *          conversion and with some chunks already cached, through the
+ *          chunk read pipeline.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_filter_threads(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;       /* File ID */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       dxpl = -1;      /* Dataset transfer property list ID */
+    hid_t       dxpl2 = -1;     /* Dataset transfer property list ID */
+    hid_t       sid = -1;       /* Dataspace ID */
+    hid_t       dsid = -1;      /* Dataset ID */
+    hid_t       dsid2 = -1;     /* Dataset ID */
+    hsize_t     dims[2] = {100, 37};    /* Dataset dimensions */
+    hsize_t     chunk_dims[2] = {10, 8};/* Chunk dimensions */
+    hsize_t     start[2] = {15, 3}, count[2] = {40, 30}; /* Hyperslab selection */
+    hsize_t     sstart[2] = {1, 2}, sstride[2] = {3, 5}, scount[2] = {33, 7}, sblock[2] = {2, 3}; /* Strided selection */
+    hsize_t     size, size2;    /* Dataset storage sizes */
+    unsigned    nthreads;       /* Number of filter threads */
+    int         *wbuf = NULL, *rbuf = NULL, *rbuf2 = NULL; /* Data buffers */
+    long long   *lbuf = NULL, *lbuf2 = NULL; /* Data buffers for conversion */
+    size_t      nelmts = 100 * 37, u; /* Local index variables */
+    unsigned    i;              /* Local index variable */
+    herr_t      ret;            /* Generic return value */
+
+    TESTING("filter pipeline threads");
+
+    h5_fixname(FILENAME[25], fapl, filename, sizeof filename);
+
+    /* Check the default value and argument checking */
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_filter_threads(dxpl, &nthreads) < 0) FAIL_STACK_ERROR
+    if(nthreads != 1) FAIL_PUTS_ERROR("    Default number of filter threads is not 1.")
+    H5E_BEGIN_TRY {
+        ret = H5Pset_filter_threads(dxpl, 0);
+    } H5E_END_TRY;
+    if(ret >= 0) FAIL_PUTS_ERROR("    Zero filter threads accepted.")
+    if(H5Pset_filter_threads(dxpl, 4) < 0) FAIL_STACK_ERROR
+    if((dxpl2 = H5Pcopy(dxpl)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_filter_threads(dxpl2, &nthreads) < 0) FAIL_STACK_ERROR
+    if(nthreads != 4) FAIL_PUTS_ERROR("    Number of filter threads not copied.")
+    if(H5Pclose(dxpl2) < 0) FAIL_STACK_ERROR
+
+    if(NULL == (wbuf = (int *)HDmalloc(nelmts * sizeof(int)))) TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(nelmts * sizeof(int)))) TEST_ERROR
+    if(NULL == (rbuf2 = (int *)HDmalloc(nelmts * sizeof(int)))) TEST_ERROR
+    if(NULL == (lbuf = (long long *)HDmalloc(nelmts * sizeof(long long)))) TEST_ERROR
+    if(NULL == (lbuf2 = (long long *)HDmalloc(nelmts * sizeof(long long)))) TEST_ERROR
+    for(u = 0; u < nelmts; u++)
+        wbuf[u] = (int)(u / 7) + (int)(u % 3);
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(2, dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) FAIL_STACK_ERROR
+    if(H5Pset_shuffle(dcpl) < 0) FAIL_STACK_ERROR
+#ifdef H5_HAVE_FILTER_DEFLATE
+    if(H5Pset_deflate(dcpl, 6) < 0) FAIL_STACK_ERROR
+#endif /* H5_HAVE_FILTER_DEFLATE */
+    if(H5Pset_fletcher32(dcpl) < 0) FAIL_STACK_ERROR
+
+    /* Run once with the partial edge chunks filtered and once without */
+    for(i = 0; i < 2; i++) {
+        if(i == 1)
+            if(H5Pset_chunk_opts(dcpl, H5D_CHUNK_DONT_FILTER_PARTIAL_CHUNKS) < 0) FAIL_STACK_ERROR
+
+        /* Write the same data serially and with several threads */
+        if((dsid = H5Dcreate2(fid, i ? "serial_edge" : "serial", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+            FAIL_STACK_ERROR
+        if((dsid2 = H5Dcreate2(fid, i ? "threads_edge" : "threads", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+            FAIL_STACK_ERROR
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+        if(H5Dwrite(dsid2, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, wbuf) < 0) FAIL_STACK_ERROR
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        if(H5Dclose(dsid2) < 0) FAIL_STACK_ERROR
+
+        /* Read both back with several threads */
+        if((dsid = H5Dopen2(fid, i ? "serial_edge" : "serial", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        if((dsid2 = H5Dopen2(fid, i ? "threads_edge" : "threads", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        if(0 == (size = H5Dget_storage_size(dsid))) FAIL_STACK_ERROR
+        if(0 == (size2 = H5Dget_storage_size(dsid2))) FAIL_STACK_ERROR
+        if(size != size2) FAIL_PUTS_ERROR("    Storage sizes differ.")
+        HDmemset(rbuf, 0, nelmts * sizeof(int));
+        HDmemset(rbuf2, 0, nelmts * sizeof(int));
+        if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0) FAIL_STACK_ERROR
+        if(H5Dread(dsid2, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf2) < 0) FAIL_STACK_ERROR
+        if(HDmemcmp(wbuf, rbuf, nelmts * sizeof(int))) FAIL_PUTS_ERROR("    Incorrect data read.")
+        if(HDmemcmp(wbuf, rbuf2, nelmts * sizeof(int))) FAIL_PUTS_ERROR("    Incorrect data read.")
+
+        /* Overwrite part of the datasets, serially and with several threads */
+        for(u = 0; u < nelmts; u++)
+            rbuf[u] = -(int)u;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        if(H5Dwrite(dsid2, H5T_NATIVE_INT, sid, sid, dxpl, rbuf) < 0) FAIL_STACK_ERROR
+        if(H5Sselect_all(sid) < 0) FAIL_STACK_ERROR
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        if(H5Dclose(dsid2) < 0) FAIL_STACK_ERROR
+
+        /* Read serially and with several threads, and compare */
+        if((dsid = H5Dopen2(fid, i ? "serial_edge" : "serial", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        if((dsid2 = H5Dopen2(fid, i ? "threads_edge" : "threads", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        HDmemset(rbuf, 0, nelmts * sizeof(int));
+        HDmemset(rbuf2, 0, nelmts * sizeof(int));
+        if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        if(H5Dread(dsid2, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf2) < 0) FAIL_STACK_ERROR
+        if(HDmemcmp(rbuf, rbuf2, nelmts * sizeof(int))) FAIL_PUTS_ERROR("    Incorrect data read.")
+        for(u = 0; u < nelmts; u++) {
+            hsize_t row = u / dims[1], col = u % dims[1];
+
+            if(row >= start[0] && row < start[0] + count[0] &&
+                    col >= start[1] && col < start[1] + count[1]) {
+                if(rbuf[u] != -(int)u)
+                    FAIL_PUTS_ERROR("    Incorrect data read.")
+            } /* end if */
+            else if(rbuf[u] != wbuf[u])
+                FAIL_PUTS_ERROR("    Incorrect data read.")
+        } /* end for */
+
+        /* Read a strided selection into the same selection in memory with
+         * several threads, after caching some of the chunks, and compare */
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, chunk_dims, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dread(dsid2, H5T_NATIVE_INT, sid, sid, dxpl, rbuf2) < 0) FAIL_STACK_ERROR
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, sstart, sstride, scount, sblock) < 0) FAIL_STACK_ERROR
+        HDmemset(rbuf2, 0, nelmts * sizeof(int));
+        if(H5Dread(dsid2, H5T_NATIVE_INT, sid, sid, dxpl, rbuf2) < 0) FAIL_STACK_ERROR
+        HDmemset(lbuf, 0, nelmts * sizeof(long long));
+        HDmemset(lbuf2, 0, nelmts * sizeof(long long));
+        if(H5Dread(dsid, H5T_NATIVE_LLONG, sid, sid, H5P_DEFAULT, lbuf) < 0) FAIL_STACK_ERROR
+        if(H5Dclose(dsid2) < 0) FAIL_STACK_ERROR
+        if((dsid2 = H5Dopen2(fid, i ? "threads_edge" : "threads", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        if(H5Dread(dsid2, H5T_NATIVE_LLONG, sid, sid, dxpl, lbuf2) < 0) FAIL_STACK_ERROR
+        if(H5Sselect_all(sid) < 0) FAIL_STACK_ERROR
+        for(u = 0; u < nelmts; u++) {
+            hsize_t row = u / dims[1], col = u % dims[1];
+
+            if(row >= sstart[0] && (row - sstart[0]) % sstride[0] < sblock[0] &&
+                    col >= sstart[1] && (col - sstart[1]) % sstride[1] < sblock[1]) {
+                if(rbuf2[u] != rbuf[u] || lbuf[u] != (long long)rbuf[u])
+                    FAIL_PUTS_ERROR("    Incorrect data read.")
+            } /* end if */
+            else if(rbuf2[u] != 0 || lbuf[u] != 0)
+                FAIL_PUTS_ERROR("    Incorrect data read.")
+        } /* end for */
+        if(HDmemcmp(lbuf, lbuf2, nelmts * sizeof(long long))) FAIL_PUTS_ERROR("    Incorrect data read.")
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        if(H5Dclose(dsid2) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    /* Close */
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dxpl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    HDfree(wbuf);
+    HDfree(rbuf);
+    HDfree(rbuf2);
+    HDfree(lbuf);
+    HDfree(lbuf2);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dxpl);
+        H5Pclose(dxpl2);
+        H5Pclose(dcpl);
+        H5Dclose(dsid);
+        H5Dclose(dsid2);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    if(rbuf)
+        HDfree(rbuf);
+    if(rbuf2)
+        HDfree(rbuf2);
+    if(lbuf)
+        HDfree(lbuf);
+    if(lbuf2)
+        HDfree(lbuf2);
+    return -1;
+} /* end test_filter_threads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_vector_io
+ *
+ * Purpose: Tests raw data I/O that is passed to the file driver as
+ *          vectors of blocks.  Writes and reads a selection mixing blocks
+ *          larger and smaller than a (tiny) sieve buffer, in contiguous
+ *          datasets and in chunked datasets that bypass the chunk cache,
+ *          through the given file driver and the core driver.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_vector_io(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;       /* File ID */
+    hid_t       my_fapl = -1;   /* File access property list ID */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       dapl = -1;      /* Dataset access property list ID */
+    hid_t       sid = -1;       /* Dataspace ID */
+    hid_t       dsid = -1;      /* Dataset ID */
+    hsize_t     dims[2] = {64, 64};     /* Dataset dimensions */
+    hsize_t     chunk_dims[2] = {8, 16};/* Chunk dimensions */
+    hsize_t     start[2] = {1, 4}, stride[2] = {2, 20}, count[2] = {32, 3}, block[2] = {1, 9}; /* Blocks larger than the sieve buffer */
+    hsize_t     start2[2] = {0, 0}, stride2[2] = {2, 1}, count2[2] = {32, 1}, block2[2] = {1, 2}; /* Blocks smaller than the sieve buffer */
+    int         *wbuf = NULL, *obuf = NULL, *rbuf = NULL, *rbuf2 = NULL; /* Data buffers */
+    size_t      nelmts = 64 * 64, u; /* Local index variables */
+    unsigned    i, j;           /* Local index variables */
+
+    TESTING("vector I/O of raw data");
+
+    if(NULL == (wbuf = (int *)HDmalloc(nelmts * sizeof(int)))) TEST_ERROR
+    if(NULL == (obuf = (int *)HDmalloc(nelmts * sizeof(int)))) TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(nelmts * sizeof(int)))) TEST_ERROR
+    if(NULL == (rbuf2 = (int *)HDmalloc(nelmts * sizeof(int)))) TEST_ERROR
+    for(u = 0; u < nelmts; u++) {
+        wbuf[u] = (int)u;
+        obuf[u] = -(int)u;
+    } /* end for */
+
+    if((sid = H5Screate_simple(2, dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) FAIL_STACK_ERROR
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, 0, 0, H5D_CHUNK_CACHE_W0_DEFAULT) < 0) FAIL_STACK_ERROR
+
+    /* Use the given file driver, then the core driver */
+    for(i = 0; i < 2; i++) {
+        if((my_fapl = H5Pcopy(fapl)) < 0) FAIL_STACK_ERROR
+        if(i == 1)
+            if(H5Pset_fapl_core(my_fapl, (size_t)(64 * KB), FALSE) < 0) FAIL_STACK_ERROR
+        if(H5Pset_sieve_buf_size(my_fapl, (size_t)16) < 0) FAIL_STACK_ERROR
+
+        h5_fixname(FILENAME[26], fapl, filename, sizeof filename);
+        if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, my_fapl)) < 0) FAIL_STACK_ERROR
+
+        /* Contiguous dataset, then chunked dataset */
+        for(j = 0; j < 2; j++) {
+            if((dsid = H5Dcreate2(fid, j ? "chunked" : "contig", H5T_NATIVE_INT, sid, H5P_DEFAULT,
+                    j ? dcpl : H5P_DEFAULT, dapl)) < 0)
+                FAIL_STACK_ERROR
+            if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+
+            /* Overwrite the selection */
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, stride, count, block) < 0) FAIL_STACK_ERROR
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_OR, start2, stride2, count2, block2) < 0) FAIL_STACK_ERROR
+            if(H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, obuf) < 0) FAIL_STACK_ERROR
+
+            /* Read the selection back */
+            HDmemset(rbuf, 0, nelmts * sizeof(int));
+            if(H5Dread(dsid, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+            if(H5Sselect_all(sid) < 0) FAIL_STACK_ERROR
+            if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+            /* Reopen and read the whole dataset */
+            if((dsid = H5Dopen2(fid, j ? "chunked" : "contig", dapl)) < 0) FAIL_STACK_ERROR
+            HDmemset(rbuf2, 0, nelmts * sizeof(int));
+            if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf2) < 0) FAIL_STACK_ERROR
+            for(u = 0; u < nelmts; u++) {
+                hsize_t row = u / dims[1], col = u % dims[1];
+                hbool_t selected = FALSE;
+
+                if(row % 2 == 1 && col >= start[1] && (col - start[1]) % stride[1] < block[1]
+                        && (col - start[1]) / stride[1] < count[1])
+                    selected = TRUE;
+                if(row % 2 == 0 && col < block2[1])
+                    selected = TRUE;
+                if(rbuf[u] != (selected ? obuf[u] : 0))
+                    FAIL_PUTS_ERROR("    Incorrect selection read.")
+                if(rbuf2[u] != (selected ? obuf[u] : wbuf[u]))
+                    FAIL_PUTS_ERROR("    Incorrect data read.")
+            } /* end for */
+            if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        } /* end for */
+
+        if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+        if(H5Pclose(my_fapl) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    /* Close */
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    HDfree(wbuf);
+    HDfree(obuf);
+    HDfree(rbuf);
+    HDfree(rbuf2);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(my_fapl);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Dclose(dsid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    if(obuf)
+        HDfree(obuf);
+    if(rbuf)
+        HDfree(rbuf);
+    if(rbuf2)
+        HDfree(rbuf2);
+    return -1;
+} /* end test_vector_io() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_info_by_range
+ *
+ * Purpose:     Tests looking up the chunks in a range with
+ *              H5Dget_chunk_info_by_range, and reads that look up their
+ *              chunks with one pass over the chunk index, with each
+ *              chunk index type.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_info_by_range(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;       /* File ID */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       dapl = -1;      /* Dataset access property list ID */
+    hid_t       sid = -1;       /* Dataspace ID */
+    hid_t       dsid = -1;      /* Dataset ID */
+    hsize_t     dims[2] = {RANGE_NX, RANGE_NY};         /* Dataset dimensions */
+    hsize_t     max_dims[2];                            /* Maximum dataset dimensions */
+    hsize_t     chunk_dims[2] = {RANGE_CX, RANGE_CY};   /* Chunk dimensions */
+    hsize_t     start[2] = {5, 13}, count[2] = {60, 50};/* Range of elements queried */
+    hsize_t     bad_count[2] = {60, 68};                /* Range extending beyond the dataset */
+    hsize_t     chunk_start[2];                         /* Offset of chunk */
+    hsize_t     offsets[RANGE_NCHUNKS * 2];             /* Offsets of chunks in range */
+    unsigned    filter_masks[RANGE_NCHUNKS];            /* Filter masks of chunks in range */
+    haddr_t     addrs[RANGE_NCHUNKS];                   /* Addresses of chunks in range */
+    hsize_t     sizes[RANGE_NCHUNKS];                   /* Sizes of chunks in range */
+    size_t      nchunks, nexpected;                     /* Number of chunks in range */
+    unsigned    filter_mask;    /* Filter mask of one chunk */
+    haddr_t     addr;           /* Address of one chunk */
+    hsize_t     size;           /* Size of one chunk */
+    int         *wbuf = NULL, *rbuf = NULL;             /* Data buffers */
+    size_t      nelmts = RANGE_NX * RANGE_NY, u;        /* Local index variables */
+    unsigned    i, r, c;        /* Local index variables */
+    herr_t      ret;            /* Generic return value */
+
+    TESTING("chunk lookups by range");
+
+    if(NULL == (wbuf = (int *)HDmalloc(nelmts * sizeof(int)))) TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(nelmts * sizeof(int)))) TEST_ERROR
+    for(u = 0; u < nelmts; u++)
+        wbuf[u] = (int)u + 1;
+
+    /* Cache only a few chunks, so that dirty chunks are flushed during reads */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)521, (size_t)(8 * RANGE_CX * RANGE_CY * sizeof(int)), 1.0F) < 0) FAIL_STACK_ERROR
+
+    h5_fixname(FILENAME[27], fapl, filename, sizeof filename);
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+
+    /* Fixed size, one unlimited and two unlimited dimensions, which use
+     * each type of chunk index with the latest format */
+    for(i = 0; i < 3; i++) {
+        char dset_name[16];     /* Dataset name */
+
+        max_dims[0] = i > 0 ? H5S_UNLIMITED : RANGE_NX;
+        max_dims[1] = i > 1 ? H5S_UNLIMITED : RANGE_NY;
+        if((sid = H5Screate_simple(2, dims, max_dims)) < 0) FAIL_STACK_ERROR
+        if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+        if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) FAIL_STACK_ERROR
+#ifdef H5_HAVE_FILTER_DEFLATE
+        if(H5Pset_deflate(dcpl, 6) < 0) FAIL_STACK_ERROR
+#endif /* H5_HAVE_FILTER_DEFLATE */
+        HDsnprintf(dset_name, sizeof(dset_name), "range%u", i);
+        if((dsid = H5Dcreate2(fid, dset_name, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0) FAIL_STACK_ERROR
+
+        /* Write the chunks at (r, c) with (r + c) % 3 != 0, in reverse order */
+        if(H5Sselect_none(sid) < 0) FAIL_STACK_ERROR
+        for(r = RANGE_NX / RANGE_CX; r > 0; r--)
+            for(c = RANGE_NY / RANGE_CY; c > 0; c--)
+                if(((r - 1) + (c - 1)) % 3 != 0) {
+                    chunk_start[0] = (r - 1) * RANGE_CX;
+                    chunk_start[1] = (c - 1) * RANGE_CY;
+                    if(H5Sselect_hyperslab(sid, H5S_SELECT_OR, chunk_start, NULL, chunk_dims, NULL) < 0) FAIL_STACK_ERROR
+                    if(H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+                    if(H5Sselect_none(sid) < 0) FAIL_STACK_ERROR
+                } /* end if */
+        if(H5Sselect_all(sid) < 0) FAIL_STACK_ERROR
+
+        /* Count the written chunks in the range */
+        nexpected = 0;
+        for(r = (unsigned)(start[0] / RANGE_CX); r <= (unsigned)((start[0] + count[0] - 1) / RANGE_CX); r++)
+            for(c = (unsigned)(start[1] / RANGE_CY); c <= (unsigned)((start[1] + count[1] - 1) / RANGE_CY); c++)
+                if((r + c) % 3 != 0)
+                    nexpected++;
+        if(nexpected > RANGE_NCHUNKS) TEST_ERROR
+
+        /* Find the number of chunks, then look them up */
+        if(H5Dget_chunk_info_by_range(dsid, start, count, (size_t)0, NULL, NULL, NULL, NULL, &nchunks) < 0) FAIL_STACK_ERROR
+        if(nchunks != nexpected) FAIL_PUTS_ERROR("    Wrong number of chunks in range.")
+        if(H5Dget_chunk_info_by_range(dsid, start, count, (size_t)RANGE_NCHUNKS, offsets, filter_masks, addrs, sizes, &nchunks) < 0) FAIL_STACK_ERROR
+        if(nchunks != nexpected) FAIL_PUTS_ERROR("    Wrong number of chunks in range.")
+        for(u = 0; u < nchunks; u++) {
+            r = (unsigned)(offsets[u * 2] / RANGE_CX);
+            c = (unsigned)(offsets[(u * 2) + 1] / RANGE_CY);
+            if(offsets[u * 2] % RANGE_CX || offsets[(u * 2) + 1] % RANGE_CY)
+                FAIL_PUTS_ERROR("    Chunk offset not on chunk boundary.")
+            if((r + c) % 3 == 0 || offsets[u * 2] + RANGE_CX <= start[0] || offsets[u * 2] >= start[0] + count[0]
+                    || offsets[(u * 2) + 1] + RANGE_CY <= start[1] || offsets[(u * 2) + 1] >= start[1] + count[1])
+                FAIL_PUTS_ERROR("    Wrong chunk in range.")
+            if(u > 0 && addrs[u] <= addrs[u - 1])
+                FAIL_PUTS_ERROR("    Chunks not in order of address.")
+
+            /* Compare with the chunk's own information */
+            if(H5Dget_chunk_info_by_coord(dsid, &offsets[u * 2], &filter_mask, &addr, &size) < 0) FAIL_STACK_ERROR
+            if(filter_mask != filter_masks[u] || addr != addrs[u] || size != sizes[u])
+                FAIL_PUTS_ERROR("    Chunk information differs from H5Dget_chunk_info_by_coord.")
+        } /* end for */
+
+        /* Ranges beyond the dataset are rejected */
+        H5E_BEGIN_TRY {
+            ret = H5Dget_chunk_info_by_range(dsid, start, bad_count, (size_t)RANGE_NCHUNKS, offsets, NULL, NULL, NULL, &nchunks);
+        } H5E_END_TRY;
+        if(ret >= 0) FAIL_PUTS_ERROR("    Range beyond dataset accepted.")
+
+        /* Write a few of the missing chunks, which stay dirty in the cache
+         * until the next read flushes them */
+        for(c = 0; c < 4; c++) {
+            chunk_start[0] = (hsize_t)(3 * c * RANGE_CX);
+            chunk_start[1] = 0;
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, chunk_start, NULL, chunk_dims, NULL) < 0) FAIL_STACK_ERROR
+            if(H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+        } /* end for */
+        if(H5Sselect_all(sid) < 0) FAIL_STACK_ERROR
+
+        /* Read the whole dataset, then again after reopening it */
+        for(r = 0; r < 2; r++) {
+            if(r == 1) {
+                if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+                if((dsid = H5Dopen2(fid, dset_name, dapl)) < 0) FAIL_STACK_ERROR
+            } /* end if */
+            HDmemset(rbuf, 0, nelmts * sizeof(int));
+            if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+            for(u = 0; u < nelmts; u++) {
+                unsigned row = (unsigned)(u / RANGE_NY) / RANGE_CX, col = (unsigned)(u % RANGE_NY) / RANGE_CY;
+                hbool_t written = (row + col) % 3 != 0 || col == 0;
+
+                if(rbuf[u] != (written ? wbuf[u] : 0))
+                    FAIL_PUTS_ERROR("    Incorrect data read.")
+            } /* end for */
+        } /* end for */
+
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+        if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    /* Close */
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Dclose(dsid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    if(rbuf)
+        HDfree(rbuf);
+    return -1;
+} /* end test_chunk_info_by_range() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_write_behind
+ *
+ * Purpose:     Tests writing filtered chunks behind with
+ *              H5Pset_chunk_write_behind: chunks evicted from a small
+ *              chunk cache are queued, then written when the queue fills,
+ *              when they are accessed again, when the dataset is flushed,
+ *              extended or shrunk, and when it is closed.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_write_behind(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;       /* File ID */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       dapl = -1;      /* Dataset access property list ID */
+    hid_t       dapl2 = -1;     /* Dataset's access property list ID */
+    hid_t       dxpl = -1;      /* Dataset transfer property list ID */
+    hid_t       sid = -1;       /* Dataspace ID */
+    hid_t       dsid = -1;      /* Dataset ID */
+    hsize_t     dims[2] = {WB_NX, WB_NY};               /* Dataset dimensions */
+    hsize_t     small_dims[2] = {WB_NX / 2, WB_NY};     /* Shrunk dataset dimensions */
+    hsize_t     max_dims[2] = {H5S_UNLIMITED, WB_NY};   /* Maximum dataset dimensions */
+    hsize_t     chunk_dims[2] = {WB_CX, WB_CY};         /* Chunk dimensions */
+    hsize_t     half_dims[2] = {WB_CX / 2, WB_CY};      /* Half a chunk */
+    hsize_t     chunk_start[2];                         /* Offset of chunk */
+    size_t      wb_nbytes;      /* Size of write-behind queue */
+    int         *wbuf = NULL, *rbuf = NULL;             /* Data buffers */
+    size_t      nelmts = WB_NX * WB_NY, u;              /* Local index variables */
+    unsigned    pass, r, c;     /* Local index variables */
+
+    TESTING("writing chunks behind");
+
+    if(NULL == (wbuf = (int *)HDmalloc(nelmts * sizeof(int)))) TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(nelmts * sizeof(int)))) TEST_ERROR
+
+    /* Cache 4 chunks and queue up to 10 more */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_write_behind(dapl, &wb_nbytes) < 0) FAIL_STACK_ERROR
+    if(wb_nbytes != 0) FAIL_PUTS_ERROR("    Writing behind is on by default.")
+    if(H5Pset_chunk_cache(dapl, (size_t)521, (size_t)(4 * WB_CHUNK_NBYTES), 1.0F) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_write_behind(dapl, (size_t)(10 * WB_CHUNK_NBYTES)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_write_behind(dapl, &wb_nbytes) < 0) FAIL_STACK_ERROR
+    if(wb_nbytes != 10 * WB_CHUNK_NBYTES) FAIL_PUTS_ERROR("    Wrong write-behind queue size.")
+
+    /* Filter on several threads */
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_filter_threads(dxpl, 4) < 0) FAIL_STACK_ERROR
+
+    h5_fixname(FILENAME[28], fapl, filename, sizeof filename);
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+
+    if((sid = H5Screate_simple(2, dims, max_dims)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) FAIL_STACK_ERROR
+
+    /* Chunks are only written behind when they are filtered */
+    if((dsid = H5Dcreate2(fid, "unfiltered", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0) FAIL_STACK_ERROR
+    if((dapl2 = H5Dget_access_plist(dsid)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_write_behind(dapl2, &wb_nbytes) < 0) FAIL_STACK_ERROR
+    if(wb_nbytes != 0) FAIL_PUTS_ERROR("    Unfiltered chunks written behind.")
+    if(H5Pclose(dapl2) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+#ifdef H5_HAVE_FILTER_DEFLATE
+    if(H5Pset_deflate(dcpl, 6) < 0) FAIL_STACK_ERROR
+#endif /* H5_HAVE_FILTER_DEFLATE */
+    if(H5Pset_fletcher32(dcpl) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, "write_behind", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0) FAIL_STACK_ERROR
+    if((dapl2 = H5Dget_access_plist(dsid)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_write_behind(dapl2, &wb_nbytes) < 0) FAIL_STACK_ERROR
+    if(wb_nbytes != 10 * WB_CHUNK_NBYTES) FAIL_PUTS_ERROR("    Wrong write-behind queue size in use.")
+    if(H5Pclose(dapl2) < 0) FAIL_STACK_ERROR
+
+    /* Write each chunk in halves, so it goes through the chunk cache, then
+     * rewrite every third chunk, some of which are still cached or queued */
+    for(pass = 0; pass < 2; pass++) {
+        for(u = 0; u < nelmts; u++)
+            wbuf[u] = pass ? -((int)u + 1) : (int)u + 1;
+        for(r = 0; r < WB_NX / WB_CX; r++)
+            for(c = 0; c < WB_NY / WB_CY; c++)
+                if(pass == 0 || (r * (WB_NY / WB_CY) + c) % 3 == 0) {
+                    chunk_start[0] = r * WB_CX;
+                    chunk_start[1] = c * WB_CY;
+                    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, chunk_start, NULL, half_dims, NULL) < 0) FAIL_STACK_ERROR
+                    if(H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, dxpl, wbuf) < 0) FAIL_STACK_ERROR
+                    chunk_start[0] += WB_CX / 2;
+                    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, chunk_start, NULL, half_dims, NULL) < 0) FAIL_STACK_ERROR
+                    if(H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, dxpl, wbuf) < 0) FAIL_STACK_ERROR
+                } /* end if */
+    } /* end for */
+    if(H5Sselect_all(sid) < 0) FAIL_STACK_ERROR
+
+    /* The storage size counts the queued chunks */
+    if(H5Dget_storage_size(dsid) == 0) FAIL_PUTS_ERROR("    Queued chunks not written.")
+
+    /* Read the data back, while it's cached, queued and in the file, then
+     * after flushing the file, then after reopening the dataset */
+    for(pass = 0; pass < 3; pass++) {
+        if(pass == 1 && H5Fflush(fid, H5F_SCOPE_GLOBAL) < 0) FAIL_STACK_ERROR
+        if(pass == 2) {
+            if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+            if((dsid = H5Dopen2(fid, "write_behind", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        } /* end if */
+        HDmemset(rbuf, 0, nelmts * sizeof(int));
+        if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0) FAIL_STACK_ERROR
+        for(u = 0; u < nelmts; u++) {
+            r = (unsigned)(u / WB_NY) / WB_CX;
+            c = (unsigned)(u % WB_NY) / WB_CY;
+            if(rbuf[u] != ((r * (WB_NY / WB_CY) + c) % 3 == 0 ? -((int)u + 1) : (int)u + 1))
+                FAIL_PUTS_ERROR("    Incorrect data read.")
+        } /* end for */
+
+        /* Reopen with writing behind for the next pass */
+        if(pass == 2) {
+            if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+            if((dsid = H5Dopen2(fid, "write_behind", dapl)) < 0) FAIL_STACK_ERROR
+        } /* end if */
+    } /* end for */
+
+    /* Shrink the dataset while chunks are queued, then extend it again */
+    for(u = 0; u < nelmts; u++)
+        wbuf[u] = 7;
+    for(r = 0; r < WB_NX / (WB_CX / 2); r++) {
+        chunk_start[0] = r * (WB_CX / 2);
+        chunk_start[1] = 0;
+        half_dims[1] = WB_NY;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, chunk_start, NULL, half_dims, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, dxpl, wbuf) < 0) FAIL_STACK_ERROR
+    } /* end for */
+    if(H5Sselect_all(sid) < 0) FAIL_STACK_ERROR
+    if(H5Dset_extent(dsid, small_dims) < 0) FAIL_STACK_ERROR
+    if(H5Dset_extent(dsid, dims) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dopen2(fid, "write_behind", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    for(u = 0; u < nelmts; u++)
+        if(rbuf[u] != (u < nelmts / 2 ? 7 : 0))
+            FAIL_PUTS_ERROR("    Incorrect data read after changing extent.")
+
+    /* Close */
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dxpl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dapl2);
+        H5Pclose(dapl);
+        H5Pclose(dxpl);
+        H5Pclose(dcpl);
+        H5Dclose(dsid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    if(rbuf)
+        HDfree(rbuf);
+    return -1;
+} /* end test_chunk_write_behind() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    auto_read_rows
+ *
+ * Purpose:     Reads one row from each of the first NCHUNKS chunks of a
+ *              dataset in turn, NREADS rows in all.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+auto_read_rows(hid_t dsid, hid_t sid, hid_t msid, unsigned nchunks, unsigned nreads, int *rbuf)
+{
+    hsize_t     start[2] = {0, 0};                      /* Offset of row */
+    hsize_t     count[2] = {1, AUTO_NY};                /* One row */
+    unsigned    u, v;                                   /* Local index variables */
+
+    for(u = 0; u < nreads; u++) {
+        start[0] = (hsize_t)((u % nchunks) * AUTO_CX);
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) TEST_ERROR
+        if(H5Dread(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, rbuf) < 0) TEST_ERROR
+        for(v = 0; v < AUTO_NY; v++)
+            if(rbuf[v] != (int)(start[0] * AUTO_NY + v))
+                TEST_ERROR
+    } /* end for */
+
+    return 0;
+
+error:
+    return -1;
+} /* end auto_read_rows() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_cache_auto_resize
+ *
+ * Purpose:     Tests resizing the chunk cache for the access pattern with
+ *              H5Pset_chunk_cache_auto_resize: the cache grows while the
+ *              hit rate is low, within the file's budget from
+ *              H5Pset_chunk_cache_budget, and shrinks back once chunks
+ *              are no longer accessed.  Also checks the statistics from
+ *              H5Dget_chunk_cache_stats.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_cache_auto_resize(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    const char *dset_names[3] = {"a", "b", "c"};        /* Dataset names */
+    hid_t       my_fapl = -1;   /* File access property list ID */
+    hid_t       fid = -1;       /* File ID */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       dapl = -1;      /* Dataset access property list ID */
+    hid_t       dapl2 = -1;     /* Dataset's access property list ID */
+    hid_t       sid = -1;       /* Dataspace ID */
+    hid_t       msid = -1;      /* Memory dataspace ID */
+    hid_t       dsid[3] = {-1, -1, -1};                 /* Dataset IDs */
+    hsize_t     dims[2] = {AUTO_NX, AUTO_NY};           /* Dataset dimensions */
+    hsize_t     chunk_dims[2] = {AUTO_CX, AUTO_NY};     /* Chunk dimensions */
+    hsize_t     mdims[1] = {AUTO_NY};                   /* Memory dimensions */
+    H5D_chunk_cache_stats_t stats;                      /* Chunk cache statistics */
+    size_t      budget;         /* Budget for growing chunk caches */
+    size_t      nslots, nbytes; /* Chunk cache parameters */
+    double      w0;             /* Chunk cache preemption policy */
+    hbool_t     auto_resize;    /* Whether the chunk cache resizes */
+    int         *wbuf = NULL, *rbuf = NULL;             /* Data buffers */
+    size_t      nelmts = AUTO_NX * AUTO_NY, u;          /* Local index variables */
+
+    TESTING("resizing the chunk cache automatically");
+
+    if(NULL == (wbuf = (int *)HDmalloc(nelmts * sizeof(int)))) TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(AUTO_NY * sizeof(int)))) TEST_ERROR
+    for(u = 0; u < nelmts; u++)
+        wbuf[u] = (int)u;
+
+    /* Let the chunk caches grow by 3 chunks in all */
+    if((my_fapl = H5Pcopy(fapl)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache_budget(my_fapl, (size_t)(3 * AUTO_CHUNK_NBYTES)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache_budget(my_fapl, &budget) < 0) FAIL_STACK_ERROR
+    if(budget != 3 * AUTO_CHUNK_NBYTES) FAIL_PUTS_ERROR("    Wrong chunk cache budget.")
+
+    h5_fixname(FILENAME[29], fapl, filename, sizeof filename);
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, my_fapl)) < 0) FAIL_STACK_ERROR
+
+    if((sid = H5Screate_simple(2, dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((msid = H5Screate_simple(1, mdims, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) FAIL_STACK_ERROR
+    for(u = 0; u < 3; u++) {
+        if((dsid[u] = H5Dcreate2(fid, dset_names[u], H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        if(H5Dwrite(dsid[u], H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+        if(H5Dclose(dsid[u]) < 0) FAIL_STACK_ERROR
+        dsid[u] = -1;
+    } /* end for */
+
+    /* Cache 2 chunks to start with, resizing automatically */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache_auto_resize(dapl, &auto_resize) < 0) FAIL_STACK_ERROR
+    if(auto_resize) FAIL_PUTS_ERROR("    Automatic resizing is on by default.")
+    if(H5Pset_chunk_cache(dapl, (size_t)521, (size_t)(2 * AUTO_CHUNK_NBYTES), 0.75F) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache_auto_resize(dapl, TRUE) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache_auto_resize(dapl, &auto_resize) < 0) FAIL_STACK_ERROR
+    if(!auto_resize) FAIL_PUTS_ERROR("    Automatic resizing not set.")
+    if((dsid[0] = H5Dopen2(fid, dset_names[0], dapl)) < 0) FAIL_STACK_ERROR
+    if((dsid[1] = H5Dopen2(fid, dset_names[1], dapl)) < 0) FAIL_STACK_ERROR
+
+    /* Cycling through 4 chunks misses until the first cache grows to hold them */
+    if(auto_read_rows(dsid[0], sid, msid, 4, 300, rbuf) < 0) FAIL_PUTS_ERROR("    Incorrect data read.")
+    if(H5Dget_chunk_cache_stats(dsid[0], &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nbytes_max != 4 * AUTO_CHUNK_NBYTES) FAIL_PUTS_ERROR("    Chunk cache didn't grow.")
+    if(stats.nresizes != 1) FAIL_PUTS_ERROR("    Wrong number of resizes.")
+    if(stats.nhits + stats.nmisses != 300) FAIL_PUTS_ERROR("    Wrong number of accesses.")
+    if(stats.nhits < 150) FAIL_PUTS_ERROR("    Too few hits after growing.")
+    if(stats.nused != 4 || stats.nbytes_used != 4 * AUTO_CHUNK_NBYTES || stats.nslots != 521)
+        FAIL_PUTS_ERROR("    Wrong chunk cache contents.")
+
+    /* The dataset's access property list reports the current size */
+    if((dapl2 = H5Dget_access_plist(dsid[0])) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache(dapl2, &nslots, &nbytes, &w0) < 0) FAIL_STACK_ERROR
+    if(nbytes != 4 * AUTO_CHUNK_NBYTES) FAIL_PUTS_ERROR("    Wrong chunk cache size in access property list.")
+    if(H5Pget_chunk_cache_auto_resize(dapl2, &auto_resize) < 0) FAIL_STACK_ERROR
+    if(!auto_resize) FAIL_PUTS_ERROR("    Automatic resizing not in use.")
+    if(H5Pclose(dapl2) < 0) FAIL_STACK_ERROR
+    dapl2 = -1;
+
+    /* Reading only one chunk ages out the others and shrinks the cache back */
+    if(auto_read_rows(dsid[0], sid, msid, 1, 500, rbuf) < 0) FAIL_PUTS_ERROR("    Incorrect data read.")
+    if(H5Dget_chunk_cache_stats(dsid[0], &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nbytes_max != 2 * AUTO_CHUNK_NBYTES) FAIL_PUTS_ERROR("    Chunk cache didn't shrink.")
+    if(stats.nresizes != 2) FAIL_PUTS_ERROR("    Wrong number of resizes.")
+    if(stats.nused != 1) FAIL_PUTS_ERROR("    Unaccessed chunks not aged out.")
+
+    /* Cycling through all the chunks grows the second cache to the budget */
+    if(H5Dget_chunk_cache_stats(dsid[1], &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nbytes_max != 2 * AUTO_CHUNK_NBYTES || stats.nresizes != 0 || stats.nhits || stats.nmisses)
+        FAIL_PUTS_ERROR("    Wrong initial chunk cache statistics.")
+    if(auto_read_rows(dsid[1], sid, msid, AUTO_NCHUNKS, 400, rbuf) < 0) FAIL_PUTS_ERROR("    Incorrect data read.")
+    if(H5Dget_chunk_cache_stats(dsid[1], &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nbytes_max != 5 * AUTO_CHUNK_NBYTES) FAIL_PUTS_ERROR("    Chunk cache grew past the budget.")
+    if(stats.nresizes != 2) FAIL_PUTS_ERROR("    Wrong number of resizes.")
+
+    /* Closing the dataset returns its part of the budget, which is then
+     * reserved by the first cache as it grows again */
+    if(H5Dclose(dsid[1]) < 0) FAIL_STACK_ERROR
+    dsid[1] = -1;
+    if(auto_read_rows(dsid[0], sid, msid, AUTO_NCHUNKS, 300, rbuf) < 0) FAIL_PUTS_ERROR("    Incorrect data read.")
+    if(H5Dget_chunk_cache_stats(dsid[0], &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nbytes_max != 5 * AUTO_CHUNK_NBYTES) FAIL_PUTS_ERROR("    Budget not returned.")
+    if(H5Dclose(dsid[0]) < 0) FAIL_STACK_ERROR
+    dsid[0] = -1;
+
+    /* Without automatic resizing, the cache stays the same size */
+    if(H5Pset_chunk_cache_auto_resize(dapl, FALSE) < 0) FAIL_STACK_ERROR
+    if((dsid[2] = H5Dopen2(fid, dset_names[2], dapl)) < 0) FAIL_STACK_ERROR
+    if(auto_read_rows(dsid[2], sid, msid, AUTO_NCHUNKS, 400, rbuf) < 0) FAIL_PUTS_ERROR("    Incorrect data read.")
+    if(H5Dget_chunk_cache_stats(dsid[2], &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nbytes_max != 2 * AUTO_CHUNK_NBYTES || stats.nresizes != 0 || stats.nmisses != 400 || stats.nhits)
+        FAIL_PUTS_ERROR("    Chunk cache resized.")
+    if(H5Dclose(dsid[2]) < 0) FAIL_STACK_ERROR
+
+    /* Chunks too large for the cache bypass it */
+    if(H5Pset_chunk_cache(dapl, (size_t)521, (size_t)(AUTO_CHUNK_NBYTES / 2), 0.75F) < 0) FAIL_STACK_ERROR
+    if((dsid[2] = H5Dopen2(fid, dset_names[2], dapl)) < 0) FAIL_STACK_ERROR
+    if(auto_read_rows(dsid[2], sid, msid, AUTO_NCHUNKS, 10, rbuf) < 0) FAIL_PUTS_ERROR("    Incorrect data read.")
+    if(H5Dget_chunk_cache_stats(dsid[2], &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nbypasses != 10 || stats.nhits || stats.nmisses || stats.nused)
+        FAIL_PUTS_ERROR("    Chunks didn't bypass the cache.")
+    if(H5Dclose(dsid[2]) < 0) FAIL_STACK_ERROR
+    dsid[2] = -1;
+
+    /* Close */
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(msid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(my_fapl) < 0) FAIL_STACK_ERROR
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dapl2);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        for(u = 0; u < 3; u++)
+            H5Dclose(dsid[u]);
+        H5Sclose(msid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+        H5Pclose(my_fapl);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    if(rbuf)
+        HDfree(rbuf);
+    return -1;
+} /* end test_chunk_cache_auto_resize() */
+
+
 /*-------------------------------------------------------------------------
  * Function:    test_big_chunks_bypass_cache
  *
@@ -12723,8 +14436,12 @@ main(void)
         nerrors += (test_max_compact(my_fapl) < 0  		? 1 : 0);
         nerrors += (test_conv_buffer(file) < 0		        ? 1 : 0);
         nerrors += (test_tconv(file) < 0			? 1 : 0);
+        nerrors += (test_tconv_inplace(file) < 0		? 1 : 0);
         nerrors += (test_filters(file, my_fapl) < 0		? 1 : 0);
         nerrors += (test_onebyte_shuffle(file) < 0 		? 1 : 0);
+        nerrors += (test_shuffle_sizes(file) < 0 		? 1 : 0);
+        nerrors += (test_bitshuffle(file) < 0 		? 1 : 0);
+        nerrors += (test_deflate_mixed(file) < 0 		? 1 : 0);
         nerrors += (test_nbit_int(file) < 0 		        ? 1 : 0);
         nerrors += (test_nbit_float(file) < 0         	        ? 1 : 0);
         nerrors += (test_nbit_double(file) < 0         	        ? 1 : 0);
@@ -12760,6 +14477,12 @@ main(void)
 #endif /* H5_NO_DEPRECATED_SYMBOLS */
         nerrors += (test_huge_chunks(my_fapl) < 0		? 1 : 0);
         nerrors += (test_chunk_cache(my_fapl) < 0		? 1 : 0);
+        nerrors += (test_chunk_cache_ways(my_fapl) < 0		? 1 : 0);
+        nerrors += (test_filter_threads(my_fapl) < 0		? 1 : 0);
+        nerrors += (test_vector_io(my_fapl) < 0			? 1 : 0);
+        nerrors += (test_chunk_info_by_range(my_fapl) < 0	? 1 : 0);
+        nerrors += (test_chunk_write_behind(my_fapl) < 0	? 1 : 0);
+        nerrors += (test_chunk_cache_auto_resize(my_fapl) < 0	? 1 : 0);
         nerrors += (test_big_chunks_bypass_cache(my_fapl) < 0   ? 1 : 0);
         nerrors += (test_chunk_fast(envval, my_fapl) < 0	? 1 : 0);
         nerrors += (test_reopen_chunk_fast(my_fapl) < 0		? 1 : 0);
@@ -3394,6 +3394,227 @@ error:
     return 1;
 } /* end test_compound_18() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    test_compound_19
+ *
+ * Purpose:     Tests conversion path lookups for compound datatypes with
+ *              many members, which go through the library's cache of
+ *              conversion paths.  An equal type with its members inserted
+ *              in a different order must find the same path, and
+ *              registering or unregistering a conversion function for the
+ *              pair must take effect on the next conversion.
+ *
+ * Return:      Success:        0
+ *              Failure:        number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_compound_19(void)
+{
+#define COMPOUND19_NMEMBS       48
+#define COMPOUND19_NELMTS       10
+    hid_t       src = -1, src2 = -1, dst = -1;
+    H5T_cdata_t *cdata = NULL, *cdata2 = NULL;
+    int         *buf = NULL;
+    double      *dbuf;
+    void        *bkg = NULL;
+    char        name[16];
+    unsigned    u, v;
+
+    TESTING("conversion path lookups for large compound types");
+
+    /* Source type with int members, and an equal one built in reverse */
+    if((src = H5Tcreate(H5T_COMPOUND, COMPOUND19_NMEMBS * sizeof(int))) < 0) FAIL_STACK_ERROR
+    if((src2 = H5Tcreate(H5T_COMPOUND, COMPOUND19_NMEMBS * sizeof(int))) < 0) FAIL_STACK_ERROR
+    if((dst = H5Tcreate(H5T_COMPOUND, COMPOUND19_NMEMBS * sizeof(double))) < 0) FAIL_STACK_ERROR
+    for(u = 0; u < COMPOUND19_NMEMBS; u++) {
+        unsigned r = COMPOUND19_NMEMBS - 1 - u;
+
+        HDsnprintf(name, sizeof(name), "f%02u", u);
+        if(H5Tinsert(src, name, u * sizeof(int), H5T_NATIVE_INT) < 0) FAIL_STACK_ERROR
+        /* Destination members are laid out in reverse order */
+        if(H5Tinsert(dst, name, r * sizeof(double), H5T_NATIVE_DOUBLE) < 0) FAIL_STACK_ERROR
+        HDsnprintf(name, sizeof(name), "f%02u", r);
+        if(H5Tinsert(src2, name, r * sizeof(int), H5T_NATIVE_INT) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    /* Both source types must find the same path */
+    if(NULL == H5Tfind(src, dst, &cdata)) FAIL_STACK_ERROR
+    if(NULL == H5Tfind(src2, dst, &cdata2)) FAIL_STACK_ERROR
+    if(cdata != cdata2) FAIL_PUTS_ERROR("equal source types found different conversion paths")
+
+    if(NULL == (buf = (int *)HDmalloc(COMPOUND19_NELMTS * COMPOUND19_NMEMBS * sizeof(double)))) TEST_ERROR
+    if(NULL == (bkg = HDcalloc(COMPOUND19_NELMTS, COMPOUND19_NMEMBS * sizeof(double)))) TEST_ERROR
+    dbuf = (double *)buf;
+
+    /* Convert repeatedly, alternating the equal source types */
+    for(v = 0; v < 4; v++) {
+        for(u = 0; u < COMPOUND19_NELMTS * COMPOUND19_NMEMBS; u++)
+            buf[u] = (int)(u + v);
+        if(H5Tconvert((v % 2) ? src2 : src, dst, COMPOUND19_NELMTS, buf, bkg, H5P_DEFAULT) < 0) FAIL_STACK_ERROR
+        for(u = 0; u < COMPOUND19_NELMTS * COMPOUND19_NMEMBS; u++) {
+            unsigned elmt = u / COMPOUND19_NMEMBS, memb = u % COMPOUND19_NMEMBS;
+
+            if(dbuf[elmt * COMPOUND19_NMEMBS + (COMPOUND19_NMEMBS - 1 - memb)] != (double)(u + v))
+                FAIL_PUTS_ERROR("incorrect conversion of compound members")
+        } /* end for */
+    } /* end for */
+
+    /* A newly registered function must be used for the pair */
+    num_opaque_conversions_g = 0;
+    if(H5Tregister(H5T_PERS_HARD, "cmpd19_test", src, dst, convert_opaque) < 0) FAIL_STACK_ERROR
+    if(H5Tconvert(src2, dst, COMPOUND19_NELMTS, buf, bkg, H5P_DEFAULT) < 0) FAIL_STACK_ERROR
+    if(H5Tconvert(src, dst, COMPOUND19_NELMTS, buf, bkg, H5P_DEFAULT) < 0) FAIL_STACK_ERROR
+    if(num_opaque_conversions_g != 2) FAIL_PUTS_ERROR("registered conversion function not used")
+
+    /* ... and must not be used once it's unregistered */
+    if(H5Tunregister(H5T_PERS_HARD, "cmpd19_test", src, dst, convert_opaque) < 0) FAIL_STACK_ERROR
+    for(u = 0; u < COMPOUND19_NELMTS * COMPOUND19_NMEMBS; u++)
+        buf[u] = (int)u;
+    if(H5Tconvert(src, dst, COMPOUND19_NELMTS, buf, bkg, H5P_DEFAULT) < 0) FAIL_STACK_ERROR
+    if(num_opaque_conversions_g != 2) FAIL_PUTS_ERROR("unregistered conversion function used")
+    if(dbuf[COMPOUND19_NMEMBS - 1] != 0.0 || dbuf[0] != (double)(COMPOUND19_NMEMBS - 1))
+        FAIL_PUTS_ERROR("incorrect conversion after unregistering function")
+
+    HDfree(buf);
+    HDfree(bkg);
+    if(H5Tclose(src) < 0) FAIL_STACK_ERROR
+    if(H5Tclose(src2) < 0) FAIL_STACK_ERROR
+    if(H5Tclose(dst) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    if(buf)
+        HDfree(buf);
+    if(bkg)
+        HDfree(bkg);
+    H5E_BEGIN_TRY {
+        H5Tclose(src);
+        H5Tclose(src2);
+        H5Tclose(dst);
+    } H5E_END_TRY;
+    return 1;
+#undef COMPOUND19_NMEMBS
+#undef COMPOUND19_NELMTS
+} /* end test_compound_19() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_compound_20
+ *
+ * Purpose:     Tests conversions that pick a few members out of a wide
+ *              compound datatype or reorder them without converting any
+ *              of them.  A destination whose members fill it completely
+ *              must not need a background buffer; one with gaps must keep
+ *              the background values in the gaps.
+ *
+ * Return:      Success:        0
+ *              Failure:        number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_compound_20(void)
+{
+#define COMPOUND20_NMEMBS       60
+#define COMPOUND20_NELMTS       7
+    hid_t       src = -1, dst = -1, gap = -1;
+    H5T_cdata_t *cdata = NULL;
+    int         *buf = NULL, *bkg = NULL;
+    char        name[16];
+    unsigned    u;
+
+    TESTING("copying members of wide compound types");
+
+    if((src = H5Tcreate(H5T_COMPOUND, COMPOUND20_NMEMBS * sizeof(int))) < 0) FAIL_STACK_ERROR
+    for(u = 0; u < COMPOUND20_NMEMBS; u++) {
+        HDsnprintf(name, sizeof(name), "f%02u", u);
+        if(H5Tinsert(src, name, u * sizeof(int), H5T_NATIVE_INT) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    /* Packed destination: f40, then the adjacent f02 and f03 */
+    if((dst = H5Tcreate(H5T_COMPOUND, 3 * sizeof(int))) < 0) FAIL_STACK_ERROR
+    if(H5Tinsert(dst, "f40", 0, H5T_NATIVE_INT) < 0) FAIL_STACK_ERROR
+    if(H5Tinsert(dst, "f02", sizeof(int), H5T_NATIVE_INT) < 0) FAIL_STACK_ERROR
+    if(H5Tinsert(dst, "f03", 2 * sizeof(int), H5T_NATIVE_INT) < 0) FAIL_STACK_ERROR
+
+    /* Destination with gaps around f11 and f10 */
+    if((gap = H5Tcreate(H5T_COMPOUND, 5 * sizeof(int))) < 0) FAIL_STACK_ERROR
+    if(H5Tinsert(gap, "f11", sizeof(int), H5T_NATIVE_INT) < 0) FAIL_STACK_ERROR
+    if(H5Tinsert(gap, "f10", 3 * sizeof(int), H5T_NATIVE_INT) < 0) FAIL_STACK_ERROR
+
+    if(NULL == (buf = (int *)HDmalloc(COMPOUND20_NELMTS * COMPOUND20_NMEMBS * sizeof(int)))) TEST_ERROR
+    if(NULL == (bkg = (int *)HDmalloc(COMPOUND20_NELMTS * COMPOUND20_NMEMBS * sizeof(int)))) TEST_ERROR
+
+    /* The packed destination is overwritten, so no background is needed */
+    if(NULL == H5Tfind(src, dst, &cdata)) FAIL_STACK_ERROR
+    if(cdata->need_bkg != H5T_BKG_NO) FAIL_PUTS_ERROR("background buffer requested for a covered destination")
+    for(u = 0; u < COMPOUND20_NELMTS * COMPOUND20_NMEMBS; u++)
+        buf[u] = (int)u;
+    if(H5Tconvert(src, dst, COMPOUND20_NELMTS, buf, NULL, H5P_DEFAULT) < 0) FAIL_STACK_ERROR
+    for(u = 0; u < COMPOUND20_NELMTS; u++)
+        if(buf[3 * u] != (int)(u * COMPOUND20_NMEMBS + 40) ||
+                buf[3 * u + 1] != (int)(u * COMPOUND20_NMEMBS + 2) ||
+                buf[3 * u + 2] != (int)(u * COMPOUND20_NMEMBS + 3))
+            FAIL_PUTS_ERROR("incorrect members copied to packed destination")
+
+    /* The other way round the other source members come from the background */
+    for(u = 0; u < COMPOUND20_NELMTS * COMPOUND20_NMEMBS; u++)
+        bkg[u] = -(int)u;
+    if(H5Tconvert(dst, src, COMPOUND20_NELMTS, buf, bkg, H5P_DEFAULT) < 0) FAIL_STACK_ERROR
+    for(u = 0; u < COMPOUND20_NELMTS * COMPOUND20_NMEMBS; u++) {
+        unsigned memb = u % COMPOUND20_NMEMBS;
+
+        if(memb == 40 || memb == 2 || memb == 3) {
+            if(buf[u] != (int)u)
+                FAIL_PUTS_ERROR("incorrect members copied to wide destination")
+        } /* end if */
+        else if(buf[u] != -(int)u)
+            FAIL_PUTS_ERROR("background values not preserved in wide destination")
+    } /* end for */
+
+    /* A destination with gaps keeps the background values in them */
+    if(NULL == H5Tfind(src, gap, &cdata)) FAIL_STACK_ERROR
+    if(cdata->need_bkg != H5T_BKG_YES) FAIL_PUTS_ERROR("no background buffer requested for a destination with gaps")
+    for(u = 0; u < COMPOUND20_NELMTS * COMPOUND20_NMEMBS; u++) {
+        buf[u] = (int)u;
+        bkg[u] = -1;
+    } /* end for */
+    if(H5Tconvert(src, gap, COMPOUND20_NELMTS, buf, bkg, H5P_DEFAULT) < 0) FAIL_STACK_ERROR
+    for(u = 0; u < COMPOUND20_NELMTS; u++)
+        if(buf[5 * u] != -1 || buf[5 * u + 1] != (int)(u * COMPOUND20_NMEMBS + 11) ||
+                buf[5 * u + 2] != -1 || buf[5 * u + 3] != (int)(u * COMPOUND20_NMEMBS + 10) ||
+                buf[5 * u + 4] != -1)
+            FAIL_PUTS_ERROR("incorrect conversion to destination with gaps")
+
+    HDfree(buf);
+    HDfree(bkg);
+    if(H5Tclose(src) < 0) FAIL_STACK_ERROR
+    if(H5Tclose(dst) < 0) FAIL_STACK_ERROR
+    if(H5Tclose(gap) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    if(buf)
+        HDfree(buf);
+    if(bkg)
+        HDfree(bkg);
+    H5E_BEGIN_TRY {
+        H5Tclose(src);
+        H5Tclose(dst);
+        H5Tclose(gap);
+    } H5E_END_TRY;
+    return 1;
+#undef COMPOUND20_NMEMBS
+#undef COMPOUND20_NELMTS
+} /* end test_compound_20() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    test_query
@@ -7468,6 +7689,8 @@ main(void)
     nerrors += test_compound_16();
     nerrors += test_compound_17();
     nerrors += test_compound_18();
+    nerrors += test_compound_19();
+    nerrors += test_compound_20();
     nerrors += test_conv_enum_1();
     nerrors += test_conv_enum_2();
     nerrors += test_conv_bitfield();
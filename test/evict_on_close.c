@@ -100,7 +100,7 @@ verify_tag_not_in_cache(H5F_t *f, haddr_t tag)
     /* Get Internal Cache Pointers */
     cache_ptr = f->shared->cache;
 
-    for(i = 0; i < H5C__HASH_TABLE_LEN; i++) {
+    for(i = 0; i < (int)cache_ptr->index_nbuckets; i++) {
         H5C_cache_entry_t *entry_ptr;    /* entry pointer                */
 
         entry_ptr = cache_ptr->index[i];
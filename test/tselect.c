@@ -13228,6 +13228,256 @@ test_hyper_regular(void)
     CHECK(ret, FAIL, "H5Sclose");
 }   /* test_hyper_regular() */
 
+/****************************************************************
+**
+**  test_hyper_regular_union(): Tests that unions of hyperslabs which
+**      extend a regular pattern stay regular hyperslabs
+**
+****************************************************************/
+static void
+test_hyper_regular_union(void)
+{
+    hid_t sid;          /* Dataspace ID */
+    hsize_t dims[2] = {40, 40};     /* Dataspace dimensions */
+    hsize_t start[2];               /* The start of the hyperslab */
+    hsize_t stride[2];              /* The stride between block starts for the hyperslab */
+    hsize_t count[2];               /* The number of blocks for the hyperslab */
+    hsize_t block[2];               /* The size of each block for the hyperslab */
+    hsize_t q_start[2];             /* The queried start of the hyperslab */
+    hsize_t q_stride[2];            /* The queried stride between block starts for the hyperslab */
+    hsize_t q_count[2];             /* The queried number of blocks for the hyperslab */
+    hsize_t q_block[2];             /* The queried size of each block for the hyperslab */
+    hssize_t npoints;               /* Number of elements selected */
+    htri_t is_regular;              /* Whether a hyperslab selection is regular */
+    unsigned i, j, u;               /* Local index variables */
+    herr_t ret;                     /* Generic return value */
+
+    /* Output message about test being performed */
+    MESSAGE(6, ("Testing unions of regular hyperslabs\n"));
+
+    /* Create dataspace */
+    sid = H5Screate_simple(2, dims, NULL);
+    CHECK(sid, FAIL, "H5Screate_simple");
+
+    /* Select 8x8 tiles of 3x3 elements at a stride of 5, one at a time in
+     * row-major order, then in column-major order */
+    for(u = 0; u < 2; u++) {
+        for(i = 0; i < 8; i++)
+            for(j = 0; j < 8; j++) {
+                start[0] = (hsize_t)(u ? j : i) * 5;
+                start[1] = (hsize_t)(u ? i : j) * 5;
+                block[0] = block[1] = 3;
+                ret = H5Sselect_hyperslab(sid, (i || j) ? H5S_SELECT_OR : H5S_SELECT_SET, start, NULL, block, NULL);
+                CHECK(ret, FAIL, "H5Sselect_hyperslab");
+            } /* end for */
+
+        npoints = H5Sget_select_npoints(sid);
+        VERIFY(npoints, 8 * 8 * 3 * 3, "H5Sget_select_npoints");
+        is_regular = H5Sis_regular_hyperslab(sid);
+        VERIFY(is_regular, TRUE, "H5Sis_regular_hyperslab");
+        ret = H5Sget_regular_hyperslab(sid, q_start, q_stride, q_count, q_block);
+        CHECK(ret, FAIL, "H5Sget_regular_hyperslab");
+        for(i = 0; i < 2; i++) {
+            VERIFY(q_start[i], 0, "H5Sget_regular_hyperslab");
+            VERIFY(q_stride[i], 5, "H5Sget_regular_hyperslab");
+            VERIFY(q_count[i], 8, "H5Sget_regular_hyperslab");
+            VERIFY(q_block[i], 3, "H5Sget_regular_hyperslab");
+        } /* end for */
+    } /* end for */
+
+    /* Adjacent block grows the block */
+    start[0] = 2; start[1] = 4;
+    count[0] = 6; count[1] = 4;
+    ret = H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    start[1] = 8;
+    count[1] = 10;
+    ret = H5Sselect_hyperslab(sid, H5S_SELECT_OR, start, NULL, count, NULL);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    npoints = H5Sget_select_npoints(sid);
+    VERIFY(npoints, 6 * 14, "H5Sget_select_npoints");
+    ret = H5Sget_regular_hyperslab(sid, q_start, q_stride, q_count, q_block);
+    CHECK(ret, FAIL, "H5Sget_regular_hyperslab");
+    VERIFY(q_start[1], 4, "H5Sget_regular_hyperslab");
+    VERIFY(q_count[1], 1, "H5Sget_regular_hyperslab");
+    VERIFY(q_block[1], 14, "H5Sget_regular_hyperslab");
+
+    /* Strided blocks continued by more blocks at the same stride */
+    start[0] = 0; start[1] = 1;
+    stride[0] = 1; stride[1] = 4;
+    count[0] = 1; count[1] = 3;
+    block[0] = 5; block[1] = 2;
+    ret = H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, stride, count, block);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    start[1] = 13;
+    count[1] = 2;
+    ret = H5Sselect_hyperslab(sid, H5S_SELECT_OR, start, stride, count, block);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    npoints = H5Sget_select_npoints(sid);
+    VERIFY(npoints, 5 * 5 * 2, "H5Sget_select_npoints");
+    ret = H5Sget_regular_hyperslab(sid, q_start, q_stride, q_count, q_block);
+    CHECK(ret, FAIL, "H5Sget_regular_hyperslab");
+    VERIFY(q_start[1], 1, "H5Sget_regular_hyperslab");
+    VERIFY(q_stride[1], 4, "H5Sget_regular_hyperslab");
+    VERIFY(q_count[1], 5, "H5Sget_regular_hyperslab");
+    VERIFY(q_block[1], 2, "H5Sget_regular_hyperslab");
+
+    /* Blocks at a different stride break the pattern */
+    start[1] = 23;
+    stride[1] = 6;
+    ret = H5Sselect_hyperslab(sid, H5S_SELECT_OR, start, stride, count, block);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    npoints = H5Sget_select_npoints(sid);
+    VERIFY(npoints, 5 * 7 * 2, "H5Sget_select_npoints");
+    is_regular = H5Sis_regular_hyperslab(sid);
+    VERIFY(is_regular, FALSE, "H5Sis_regular_hyperslab");
+
+    /* Overlapping blocks are merged through the span trees */
+    start[0] = 0; start[1] = 0;
+    count[0] = 5; count[1] = 10;
+    ret = H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    start[1] = 6;
+    ret = H5Sselect_hyperslab(sid, H5S_SELECT_OR, start, NULL, count, NULL);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    npoints = H5Sget_select_npoints(sid);
+    VERIFY(npoints, 5 * 16, "H5Sget_select_npoints");
+    ret = H5Sget_regular_hyperslab(sid, q_start, q_stride, q_count, q_block);
+    CHECK(ret, FAIL, "H5Sget_regular_hyperslab");
+    VERIFY(q_count[1], 1, "H5Sget_regular_hyperslab");
+    VERIFY(q_block[1], 16, "H5Sget_regular_hyperslab");
+
+    /* Close the dataspace */
+    ret = H5Sclose(sid);
+    CHECK(ret, FAIL, "H5Sclose");
+}   /* test_hyper_regular_union() */
+
+/****************************************************************
+**
+**  test_select_strided_io(): Tests I/O between regular hyperslab
+**      selections which is done with strided copies instead of
+**      offset/length sequences.
+**
+****************************************************************/
+static void
+test_select_strided_io(void)
+{
+    hid_t fid;                      /* File ID */
+    hid_t sid;                      /* Dataset dataspace ID */
+    hid_t mem_sid;                  /* Memory dataspace ID */
+    hid_t dcpl;                     /* Dataset creation property list ID */
+    hid_t did;                      /* Dataset ID */
+    hsize_t dims[2] = {12, 16};     /* Dataset dimensions */
+    hsize_t mem_dims[2] = {10, 30}; /* Memory dataspace dimensions */
+    hsize_t chunk_dims[2] = {4, 8}; /* Chunk dimensions */
+    hsize_t start[2], stride[2], count[2], block[2];    /* Hyperslab parameters */
+    int wbuf[12][16];               /* Dataset contents */
+    int mem_buf[10][30];            /* Memory buffer */
+    long long lmem_buf[10][30];     /* Memory buffer with conversion */
+    unsigned layout;                /* Dataset layout */
+    unsigned i, j;                  /* Local index variables */
+    herr_t ret;                     /* Generic return value */
+
+    /* Output message about test being performed */
+    MESSAGE(6, ("Testing I/O between regular hyperslab selections\n"));
+
+    for(i = 0; i < 12; i++)
+        for(j = 0; j < 16; j++)
+            wbuf[i][j] = (int)(i * 100 + j);
+
+    fid = H5Fcreate(FILENAME, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(fid, FAIL, "H5Fcreate");
+    sid = H5Screate_simple(2, dims, NULL);
+    CHECK(sid, FAIL, "H5Screate_simple");
+    mem_sid = H5Screate_simple(2, mem_dims, NULL);
+    CHECK(mem_sid, FAIL, "H5Screate_simple");
+
+    /* File selection: 5x3 blocks of 2x3 elements, strided by 2x5 */
+    start[0] = 1; start[1] = 1;
+    stride[0] = 2; stride[1] = 5;
+    count[0] = 5; count[1] = 3;
+    block[0] = 2; block[1] = 3;
+    ret = H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, stride, count, block);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+
+    /* Memory selection: every other element of every row */
+    start[0] = 0; start[1] = 3;
+    stride[0] = 1; stride[1] = 2;
+    count[0] = 10; count[1] = 9;
+    ret = H5Sselect_hyperslab(mem_sid, H5S_SELECT_SET, start, stride, count, NULL);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+
+    for(layout = 0; layout < 3; layout++) {
+        dcpl = H5Pcreate(H5P_DATASET_CREATE);
+        CHECK(dcpl, FAIL, "H5Pcreate");
+        if(layout == 0) {
+            ret = H5Pset_layout(dcpl, H5D_COMPACT);
+            CHECK(ret, FAIL, "H5Pset_layout");
+        } /* end if */
+        else if(layout == 1) {
+            ret = H5Pset_chunk(dcpl, 2, chunk_dims);
+            CHECK(ret, FAIL, "H5Pset_chunk");
+        } /* end if */
+
+        did = H5Dcreate2(fid, (layout == 0 ? "compact" : (layout == 1 ? "chunked" : "contig")), H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+        CHECK(did, FAIL, "H5Dcreate2");
+        ret = H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf);
+        CHECK(ret, FAIL, "H5Dwrite");
+
+        /* Read the file selection into the memory selection, with and
+         * without conversion */
+        HDmemset(mem_buf, 0, sizeof(mem_buf));
+        ret = H5Dread(did, H5T_NATIVE_INT, mem_sid, sid, H5P_DEFAULT, mem_buf);
+        CHECK(ret, FAIL, "H5Dread");
+        HDmemset(lmem_buf, 0, sizeof(lmem_buf));
+        ret = H5Dread(did, H5T_NATIVE_LLONG, mem_sid, sid, H5P_DEFAULT, lmem_buf);
+        CHECK(ret, FAIL, "H5Dread");
+
+        /* Elements arrive in file selection order: rows 1-10, columns
+         * 1-3, 6-8 and 11-13 */
+        for(i = 0; i < 10; i++)
+            for(j = 0; j < 30; j++) {
+                int expect = 0;
+
+                if(j >= 3 && j < 21 && (j % 2) == 1) {
+                    unsigned n = (j - 3) / 2;
+
+                    expect = wbuf[i + 1][1 + (n / 3) * 5 + (n % 3)];
+                } /* end if */
+                VERIFY(mem_buf[i][j], expect, "H5Dread");
+                VERIFY(lmem_buf[i][j], (long long)expect, "H5Dread");
+            } /* end for */
+
+        /* Write the memory selection back negated and check the dataset */
+        for(i = 0; i < 10; i++)
+            for(j = 0; j < 30; j++)
+                mem_buf[i][j] = -mem_buf[i][j];
+        ret = H5Dwrite(did, H5T_NATIVE_INT, mem_sid, sid, H5P_DEFAULT, mem_buf);
+        CHECK(ret, FAIL, "H5Dwrite");
+        HDmemset(mem_buf, 0, sizeof(mem_buf));
+        ret = H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, mem_buf);
+        CHECK(ret, FAIL, "H5Dread");
+        for(i = 0; i < 12; i++)
+            for(j = 0; j < 16; j++) {
+                int selected = (i >= 1 && i <= 10 && j >= 1 && (j - 1) % 5 < 3);
+
+                VERIFY(((int *)mem_buf)[i * 16 + j], selected ? -wbuf[i][j] : wbuf[i][j], "H5Dread");
+            } /* end for */
+
+        ret = H5Dclose(did);
+        CHECK(ret, FAIL, "H5Dclose");
+        ret = H5Pclose(dcpl);
+        CHECK(ret, FAIL, "H5Pclose");
+    } /* end for */
+
+    ret = H5Sclose(mem_sid);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Sclose(sid);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Fclose(fid);
+    CHECK(ret, FAIL, "H5Fclose");
+}   /* test_select_strided_io() */
+
 /****************************************************************
 **
 **  test_hyper_unlim(): Tests unlimited hyperslab selections
@@ -13825,6 +14075,12 @@ test_select(void)
     /* Test 'regular' hyperslab query routines */
     test_hyper_regular();
 
+    /* Test unions of hyperslabs that extend a regular pattern */
+    test_hyper_regular_union();
+
+    /* Test I/O between regular hyperslab selections */
+    test_select_strided_io();
+
     /* Test unlimited hyperslab selections */
     test_hyper_unlim();
 
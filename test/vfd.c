@@ -49,6 +49,12 @@
 #define DSET2_DIM    4
 #endif /* H5_HAVE_DIRECT */
 
+/* Macros for io_uring VFD */
+#ifdef H5_HAVE_IOURING
+#define IOURING_DIM1    256
+#define IOURING_DIM2    64
+#endif /* H5_HAVE_IOURING */
+
 const char *FILENAME[] = {
     "sec2_file",         /*0*/
     "core_file",         /*1*/
@@ -60,11 +66,17 @@ const char *FILENAME[] = {
     "stdio_file",        /*7*/
     "windows_file",      /*8*/
     "new_multi_file_v16",/*9*/
+    "vector_file",       /*10*/
+    "iouring_file",      /*11*/
     NULL
 };
 
 #define LOG_FILENAME "log_vfd_out.log"
 
+/* Macros for vector I/O */
+#define VECTOR_NRUN     100     /* Blocks in the long run of adjacent blocks */
+#define VECTOR_NBLOCKS  (8 + VECTOR_NRUN)
+
 #define COMPAT_BASENAME "family_v16_"
 #define MULTI_COMPAT_BASENAME "multi_file_v16"
 
@@ -156,6 +168,193 @@ error:
     return -1;
 } /* end test_sec2() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    test_vector_io_drvr
+ *
+ * Purpose:     Tests H5FDwrite_vector() and H5FDread_vector() on a file
+ *              opened with the file access property list FAPL_ID, using
+ *              blocks which follow each other in the file, blocks which
+ *              don't, an empty block, a run of blocks longer than one
+ *              system call takes and a block past the end of the file.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_vector_io_drvr(const char *drv_name, hid_t fapl_id)
+{
+    H5FD_t      *file = NULL;               /* VFD file struct              */
+    char        filename[1024];             /* filename                     */
+    char        test_name[64];              /* test description             */
+    H5FD_mem_t  types[VECTOR_NBLOCKS];      /* block types                  */
+    haddr_t     addrs[VECTOR_NBLOCKS];      /* block addresses              */
+    size_t      sizes[VECTOR_NBLOCKS];      /* block sizes                  */
+    const void  *wbufs[VECTOR_NBLOCKS];     /* buffers to write             */
+    void        *rbufs[VECTOR_NBLOCKS];     /* buffers to read into         */
+    unsigned char *wbuf = NULL;             /* data written to the file     */
+    unsigned char *rbuf = NULL;             /* data read from the file      */
+    size_t      off;                        /* offset in buffers            */
+    size_t      nbytes;                     /* size of all blocks           */
+    size_t      nblocks = 0;                /* number of blocks             */
+    size_t      u;                          /* local index variable         */
+    herr_t      ret;                        /* generic return value         */
+
+    HDsnprintf(test_name, sizeof(test_name), "vector I/O with %s file driver", drv_name);
+    TESTING(test_name);
+
+    h5_fixname(FILENAME[10], fapl_id, filename, sizeof(filename));
+
+    /* Blocks in the order given, which is not the file order */
+    addrs[nblocks] = 0;    sizes[nblocks++] = 100;
+    addrs[nblocks] = 100;  sizes[nblocks++] = 28;  /* follows the previous block */
+    addrs[nblocks] = 1000; sizes[nblocks++] = 500;
+    addrs[nblocks] = 300;  sizes[nblocks++] = 200;
+    addrs[nblocks] = 500;  sizes[nblocks++] = 0;   /* empty block */
+    addrs[nblocks] = 500;  sizes[nblocks++] = 300;
+    for(u = 0; u < VECTOR_NRUN; u++) {
+        addrs[nblocks] = 4 * KB + u * 8;
+        sizes[nblocks++] = 8;
+    } /* end for */
+    addrs[nblocks] = 3 * KB; sizes[nblocks++] = 1 * KB;
+    addrs[nblocks] = 6 * KB; sizes[nblocks++] = 64;    /* written after the end of file */
+
+    if(NULL == (wbuf = (unsigned char *)HDmalloc(8 * KB)))
+        TEST_ERROR;
+    if(NULL == (rbuf = (unsigned char *)HDmalloc(8 * KB)))
+        TEST_ERROR;
+    for(u = 0, off = 0; u < nblocks; u++) {
+        size_t v;
+
+        types[u] = H5FD_MEM_DRAW;
+        for(v = 0; v < sizes[u]; v++)
+            wbuf[off + v] = (unsigned char)(u + v);
+        wbufs[u] = wbuf + off;
+        rbufs[u] = rbuf + off;
+        off += sizes[u];
+    } /* end for */
+    nbytes = off;
+
+    /* Write all but the last block with one call and check them one by one */
+    if(NULL == (file = H5FDopen(filename, H5F_ACC_RDWR | H5F_ACC_CREAT | H5F_ACC_TRUNC, fapl_id, (haddr_t)(1024 * KB))))
+        TEST_ERROR;
+    if(H5FDset_eoa(file, H5FD_MEM_DEFAULT, (haddr_t)(8 * KB)) < 0)
+        TEST_ERROR;
+    if(H5FDwrite_vector(file, H5P_DEFAULT, nblocks - 1, types, addrs, sizes, wbufs) < 0)
+        TEST_ERROR;
+    HDmemset(rbuf, 0xff, 8 * KB);
+    for(u = 0; u < nblocks - 1; u++) {
+        if(H5FDread(file, types[u], H5P_DEFAULT, addrs[u], sizes[u], rbufs[u]) < 0)
+            TEST_ERROR;
+        if(sizes[u] && HDmemcmp(wbufs[u], rbufs[u], sizes[u]))
+            FAIL_PUTS_ERROR("block read doesn't match vector written");
+    } /* end for */
+
+    /* Read all the blocks with one call; the last one is past the end of
+     * the file and should read back as zeros.
+     */
+    HDmemset(rbuf, 0xff, 8 * KB);
+    if(H5FDread_vector(file, H5P_DEFAULT, nblocks, types, addrs, sizes, rbufs) < 0)
+        TEST_ERROR;
+    for(u = 0; u < nblocks - 1; u++)
+        if(sizes[u] && HDmemcmp(wbufs[u], rbufs[u], sizes[u]))
+            FAIL_PUTS_ERROR("vector read doesn't match vector written");
+    for(off = 0; off < sizes[nblocks - 1]; off++)
+        if(((unsigned char *)rbufs[nblocks - 1])[off] != 0)
+            FAIL_PUTS_ERROR("vector read past the end of file isn't zero");
+
+    /* Write and read back the last block */
+    if(H5FDwrite_vector(file, H5P_DEFAULT, (size_t)1, &types[nblocks - 1], &addrs[nblocks - 1], &sizes[nblocks - 1], &wbufs[nblocks - 1]) < 0)
+        TEST_ERROR;
+    if(H5FDget_eof(file, H5FD_MEM_DEFAULT) < addrs[nblocks - 1] + sizes[nblocks - 1])
+        FAIL_PUTS_ERROR("end of file not updated by vector write");
+    HDmemset(rbuf, 0xff, 8 * KB);
+    if(H5FDread_vector(file, H5P_DEFAULT, nblocks, types, addrs, sizes, rbufs) < 0)
+        TEST_ERROR;
+    if(HDmemcmp(wbuf, rbuf, nbytes))
+        FAIL_PUTS_ERROR("vector read doesn't match vector written");
+
+    /* Blocks past the end of the allocated space are an error */
+    addrs[0] = 8 * KB;
+    H5E_BEGIN_TRY {
+        ret = H5FDread_vector(file, H5P_DEFAULT, nblocks, types, addrs, sizes, rbufs);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("vector read past the end of allocated space succeeded");
+
+    if(H5FDclose(file) < 0)
+        TEST_ERROR;
+    file = NULL;
+    HDremove(filename);
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        if(file)
+            H5FDclose(file);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    if(rbuf)
+        HDfree(rbuf);
+    return -1;
+} /* end test_vector_io_drvr() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_vector_io
+ *
+ * Purpose:     Tests vector I/O with the SEC2 driver, which has vector
+ *              callbacks, and with the STDIO driver, which doesn't, and
+ *              with the IOURING driver when it's built.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_vector_io(void)
+{
+    hid_t       fapl_id = -1;               /* file access property list ID */
+    int         nerrors = 0;                /* number of failed drivers     */
+
+    if((fapl_id = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        goto error;
+
+    if(H5Pset_fapl_sec2(fapl_id) < 0)
+        goto error;
+    nerrors += test_vector_io_drvr("SEC2", fapl_id) < 0 ? 1 : 0;
+
+    if(H5Pset_fapl_stdio(fapl_id) < 0)
+        goto error;
+    nerrors += test_vector_io_drvr("STDIO", fapl_id) < 0 ? 1 : 0;
+
+#ifdef H5_HAVE_IOURING
+    /* A queue depth smaller than the number of blocks */
+    if(H5Pset_fapl_iouring(fapl_id, 8) < 0)
+        goto error;
+    nerrors += test_vector_io_drvr("IOURING", fapl_id) < 0 ? 1 : 0;
+#endif /* H5_HAVE_IOURING */
+
+    if(H5Pclose(fapl_id) < 0)
+        goto error;
+
+    return nerrors ? -1 : 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(fapl_id);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_vector_io() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    test_core
@@ -706,6 +905,212 @@ error:
 #endif /*H5_HAVE_DIRECT*/
 }
 
+
+/*-------------------------------------------------------------------------
+ * Function:    test_iouring
+ *
+ * Purpose:     Tests the io_uring driver: the file handle interface as for
+ *              the SEC2 driver, the queue depth property, and chunked
+ *              writes which outnumber the requests kept in flight, read
+ *              back through the driver and, after closing, through the
+ *              SEC2 driver.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_iouring(void)
+{
+#ifdef H5_HAVE_IOURING
+    hid_t       fid = -1;                   /* file ID                      */
+    hid_t       fapl_id = -1;               /* file access property list ID */
+    hid_t       fapl_id_out = -1;           /* from H5Fget_access_plist     */
+    hid_t       sec2_fapl_id = -1;          /* SEC2 file access property list */
+    hid_t       dcpl_id = -1;               /* dataset creation property list */
+    hid_t       space_id = -1;              /* dataspace ID                 */
+    hid_t       dset_id = -1;               /* dataset ID                   */
+    char        filename[1024];             /* filename                     */
+    void        *os_file_handle = NULL;     /* OS file handle               */
+    hsize_t     file_size;                  /* file size                    */
+    hsize_t     dims[2] = {IOURING_DIM1, IOURING_DIM2};
+    hsize_t     chunk_dims[2] = {IOURING_DIM1 / 16, IOURING_DIM2};
+    hsize_t     start[2] = {IOURING_DIM1 / 4, 0};
+    hsize_t     count[2] = {IOURING_DIM1 / 2, IOURING_DIM2};
+    unsigned    queue_depth;                /* queue depth                  */
+    int         *wbuf = NULL;               /* data written                 */
+    int         *rbuf = NULL;               /* data read                    */
+    size_t      u;                          /* local index variable         */
+    herr_t      ret;                        /* generic return value         */
+#endif /* H5_HAVE_IOURING */
+
+    TESTING("IOURING file driver");
+
+#ifndef H5_HAVE_IOURING
+    SKIPPED();
+    return 0;
+#else /* H5_HAVE_IOURING */
+
+    /* Check the queue depth property */
+    if((fapl_id = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        TEST_ERROR;
+    if(H5Pset_fapl_iouring(fapl_id, 0) < 0)
+        TEST_ERROR;
+    if(H5Pget_fapl_iouring(fapl_id, &queue_depth) < 0)
+        TEST_ERROR;
+    if(queue_depth != H5FD_IOURING_QUEUE_DEPTH_DEF)
+        FAIL_PUTS_ERROR("default queue depth not set");
+    H5E_BEGIN_TRY {
+        ret = H5Pset_fapl_iouring(fapl_id, H5FD_IOURING_QUEUE_DEPTH_MAX + 1);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        FAIL_PUTS_ERROR("queue depth too large accepted");
+
+    /* Keep fewer requests in flight than there are chunks */
+    if(H5Pset_fapl_iouring(fapl_id, 4) < 0)
+        TEST_ERROR;
+    h5_fixname(FILENAME[11], fapl_id, filename, sizeof(filename));
+
+    H5E_BEGIN_TRY {
+        fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl_id);
+    } H5E_END_TRY;
+    if(fid < 0) {
+        H5Pclose(fapl_id);
+        SKIPPED();
+        HDputs("    Probably the kernel doesn't allow io_uring");
+        return 0;
+    } /* end if */
+
+    /* Retrieve the access property list... */
+    if((fapl_id_out = H5Fget_access_plist(fid)) < 0)
+        TEST_ERROR;
+
+    /* Check that the driver and queue depth are correct */
+    if(H5FD_IOURING != H5Pget_driver(fapl_id_out))
+        TEST_ERROR;
+    if(H5Pget_fapl_iouring(fapl_id_out, &queue_depth) < 0)
+        TEST_ERROR;
+    if(queue_depth != 4)
+        FAIL_PUTS_ERROR("wrong queue depth in file's access property list");
+
+    /* ...and close the property list */
+    if(H5Pclose(fapl_id_out) < 0)
+        TEST_ERROR;
+
+    /* Check that we can get an operating-system-specific handle from
+     * the library.
+     */
+    if(H5Fget_vfd_handle(fid, H5P_DEFAULT, &os_file_handle) < 0)
+        TEST_ERROR;
+    if(os_file_handle == NULL)
+        FAIL_PUTS_ERROR("NULL os-specific vfd/file handle was returned from H5Fget_vfd_handle");
+
+    /* Check the file size, as for the SEC2 driver */
+    if(H5Fget_filesize(fid, &file_size) < 0)
+        TEST_ERROR;
+    if(file_size < 1 * KB || file_size > 4 * KB)
+        FAIL_PUTS_ERROR("suspicious file size obtained from H5Fget_filesize");
+
+    /* Write all the chunks, then overwrite the middle of the dataset */
+    if(NULL == (wbuf = (int *)HDmalloc(sizeof(int) * IOURING_DIM1 * IOURING_DIM2)))
+        TEST_ERROR;
+    if(NULL == (rbuf = (int *)HDmalloc(sizeof(int) * IOURING_DIM1 * IOURING_DIM2)))
+        TEST_ERROR;
+    for(u = 0; u < IOURING_DIM1 * IOURING_DIM2; u++)
+        wbuf[u] = (int)u;
+
+    if((dcpl_id = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        TEST_ERROR;
+    if(H5Pset_chunk(dcpl_id, 2, chunk_dims) < 0)
+        TEST_ERROR;
+    if((space_id = H5Screate_simple(2, dims, NULL)) < 0)
+        TEST_ERROR;
+    if((dset_id = H5Dcreate2(fid, DSET1_NAME, H5T_NATIVE_INT, space_id, H5P_DEFAULT, dcpl_id, H5P_DEFAULT)) < 0)
+        TEST_ERROR;
+    if(H5Dwrite(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0)
+        TEST_ERROR;
+
+    for(u = 0; u < IOURING_DIM1 * IOURING_DIM2; u++)
+        wbuf[u] = -(int)u;
+    if(H5Sselect_hyperslab(space_id, H5S_SELECT_SET, start, NULL, count, NULL) < 0)
+        TEST_ERROR;
+    if(H5Dwrite(dset_id, H5T_NATIVE_INT, space_id, space_id, H5P_DEFAULT, wbuf) < 0)
+        TEST_ERROR;
+
+    /* Flush, and read the data back through the driver */
+    if(H5Fflush(fid, H5F_SCOPE_GLOBAL) < 0)
+        TEST_ERROR;
+    if(H5Dread(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
+        TEST_ERROR;
+    for(u = 0; u < IOURING_DIM1 * IOURING_DIM2; u++) {
+        hsize_t row = u / IOURING_DIM2;
+        int expect = (row >= start[0] && row < start[0] + count[0]) ? -(int)u : (int)u;
+
+        if(rbuf[u] != expect)
+            FAIL_PUTS_ERROR("data read doesn't match data written");
+    } /* end for */
+
+    if(H5Dclose(dset_id) < 0)
+        TEST_ERROR;
+    if(H5Fclose(fid) < 0)
+        TEST_ERROR;
+
+    /* Closing the file completes the writes, so the SEC2 driver sees them */
+    if((sec2_fapl_id = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        TEST_ERROR;
+    if(H5Pset_fapl_sec2(sec2_fapl_id) < 0)
+        TEST_ERROR;
+    if((fid = H5Fopen(filename, H5F_ACC_RDONLY, sec2_fapl_id)) < 0)
+        TEST_ERROR;
+    if((dset_id = H5Dopen2(fid, DSET1_NAME, H5P_DEFAULT)) < 0)
+        TEST_ERROR;
+    HDmemset(rbuf, 0, sizeof(int) * IOURING_DIM1 * IOURING_DIM2);
+    if(H5Dread(dset_id, H5T_NATIVE_INT, space_id, space_id, H5P_DEFAULT, rbuf) < 0)
+        TEST_ERROR;
+    for(u = start[0] * IOURING_DIM2; u < (start[0] + count[0]) * IOURING_DIM2; u++)
+        if(rbuf[u] != -(int)u)
+            FAIL_PUTS_ERROR("data read with SEC2 driver doesn't match data written");
+
+    /* Close and delete the file */
+    if(H5Dclose(dset_id) < 0)
+        TEST_ERROR;
+    if(H5Fclose(fid) < 0)
+        TEST_ERROR;
+    h5_delete_test_file(FILENAME[11], fapl_id);
+
+    if(H5Sclose(space_id) < 0)
+        TEST_ERROR;
+    if(H5Pclose(dcpl_id) < 0)
+        TEST_ERROR;
+    if(H5Pclose(sec2_fapl_id) < 0)
+        TEST_ERROR;
+    if(H5Pclose(fapl_id) < 0)
+        TEST_ERROR;
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dset_id);
+        H5Sclose(space_id);
+        H5Pclose(dcpl_id);
+        H5Pclose(sec2_fapl_id);
+        H5Pclose(fapl_id);
+        H5Pclose(fapl_id_out);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    if(rbuf)
+        HDfree(rbuf);
+    return -1;
+#endif /* H5_HAVE_IOURING */
+} /* end test_iouring() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    test_family_opens
@@ -1760,8 +2165,10 @@ main(void)
     HDprintf("Testing basic Virtual File Driver functionality.\n");
 
     nerrors += test_sec2() < 0           ? 1 : 0;
+    nerrors += test_vector_io() < 0      ? 1 : 0;
     nerrors += test_core() < 0           ? 1 : 0;
     nerrors += test_direct() < 0         ? 1 : 0;
+    nerrors += test_iouring() < 0        ? 1 : 0;
     nerrors += test_family() < 0         ? 1 : 0;
     nerrors += test_family_compat() < 0  ? 1 : 0;
     nerrors += test_multi() < 0          ? 1 : 0;
@@ -136,6 +136,36 @@ else ()
   )
 endif ()
 
+if (HDF5_ENABLE_USING_MEMCHECKER)
+  add_test (NAME PERFORM_filter_perf COMMAND $<TARGET_FILE:filter_perf> -c 64K -n 16 -t 4)
+else ()
+  add_test (NAME PERFORM_filter_perf COMMAND "${CMAKE_COMMAND}"
+      -D "TEST_PROGRAM=$<TARGET_FILE:filter_perf>"
+      -D "TEST_ARGS:STRING=-c;64K;-n;16;-t;4"
+      -D "TEST_EXPECT=0"
+      -D "TEST_SKIP_COMPARE=TRUE"
+      -D "TEST_OUTPUT=filter_perf.txt"
+      #-D "TEST_REFERENCE=filter_perf.out"
+      -D "TEST_FOLDER=${PROJECT_BINARY_DIR}"
+      -P "${HDF_RESOURCES_EXT_DIR}/runTest.cmake"
+  )
+endif ()
+
+if (HDF5_ENABLE_USING_MEMCHECKER)
+  add_test (NAME PERFORM_shuffle_perf COMMAND $<TARGET_FILE:shuffle_perf> -c 64K -n 16 -i 1)
+else ()
+  add_test (NAME PERFORM_shuffle_perf COMMAND "${CMAKE_COMMAND}"
+      -D "TEST_PROGRAM=$<TARGET_FILE:shuffle_perf>"
+      -D "TEST_ARGS:STRING=-c;64K;-n;16;-i;1"
+      -D "TEST_EXPECT=0"
+      -D "TEST_SKIP_COMPARE=TRUE"
+      -D "TEST_OUTPUT=shuffle_perf.txt"
+      #-D "TEST_REFERENCE=shuffle_perf.out"
+      -D "TEST_FOLDER=${PROJECT_BINARY_DIR}"
+      -P "${HDF_RESOURCES_EXT_DIR}/runTest.cmake"
+  )
+endif ()
+
 if (H5_HAVE_PARALLEL)
   add_test (NAME PERFORM_h5perf COMMAND ${MPIEXEC} ${MPIEXEC_PREFLAGS} ${MPIEXEC_NUMPROC_FLAG} ${MPIEXEC_MAX_NUMPROCS} ${MPIEXEC_POSTFLAGS} $<TARGET_FILE:h5perf>)
 
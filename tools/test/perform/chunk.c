@@ -32,6 +32,9 @@
 #   include <stdlib.h>
 #   include <string.h>
 #endif
+#ifdef H5_HAVE_SYS_TIME_H
+#   include <sys/time.h>
+#endif
 
 /* Solaris Studio defines attribute, but for the attributes we need */
 #if !defined(H5_HAVE_ATTRIBUTE) || defined __cplusplus || defined(__SUNPRO_C)
@@ -73,6 +76,20 @@
 /* #define DIAG_W0		0.65F */
 /* #define DIAG_NRDCC		521 */
 
+/* Cache associativity tests: strided and tiled access to a TILE x TILE chunk
+ * region, using a cache whose slot count is a power of two so chunks in the
+ * same column of the chunk grid collide when the cache is direct-mapped. */
+#define ASSOC_CACHE	25
+#define ASSOC_NSLOTS	64
+#define ASSOC_TILE	4
+
+/* Pipelined read tests: whole and strided reads of a deflate-compressed
+ * copy of the dataset, bypassing the chunk cache, with an increasing number
+ * of filter threads. */
+#define PIPE_DSET	"dset_z"
+#define PIPE_NREADS	5
+#define PIPE_MAX_THREADS	8
+
 static size_t	nio_g;
 static hid_t	fapl_g = -1;
 
@@ -165,10 +182,24 @@ create_dataset (void)
     /* The data */
     buf = (signed char *)calloc(1, SQUARE (DS_SIZE*CH_SIZE));
     H5Dwrite(dset, H5T_NATIVE_SCHAR, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf);
+    H5Dclose(dset);
+
+    /* A compressed copy with less regular data, for the pipelined reads */
+    if (H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0) {
+	size_t	i;
+
+	H5Premove_filter(dcpl, FILTER_COUNTER);
+	H5Pset_deflate(dcpl, 1);
+	dset = H5Dcreate2(file, PIPE_DSET, H5T_NATIVE_SCHAR, space, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+	assert(dset>=0);
+	for (i=0; i<SQUARE (DS_SIZE*CH_SIZE); i++)
+	    buf[i] = (signed char)((i*i) >> 7);
+	H5Dwrite(dset, H5T_NATIVE_SCHAR, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf);
+	H5Dclose(dset);
+    }
     free(buf);
 
     /* Close */
-    H5Dclose(dset);
     H5Sclose(space);
     H5Pclose(dcpl);
     H5Fclose(file);
@@ -324,6 +355,137 @@ test_diag (int op, size_t cache_size, size_t io_size, size_t offset)
 }
 
 
+/*-------------------------------------------------------------------------
+ * Function:	nchunks
+ *
+ * Purpose:	Counts the chunks touched by an I/O request.
+ *
+ * Return:	Number of chunks.
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+nchunks (const hsize_t *hs_offset, const hsize_t *hs_size)
+{
+    size_t	n = 1;
+    int		i;
+
+    for (i=0; i<2; i++)
+	n *= (size_t)((hs_offset[i]+hs_size[i]-1)/CH_SIZE - hs_offset[i]/CH_SIZE + 1);
+    return n;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	test_assoc
+ *
+ * Purpose:	Reads the ASSOC_TILE x ASSOC_TILE chunks in the corner of the
+ *		dataset with a chunk cache of the specified associativity.
+ *		When TILED is zero the region is read in column strips of
+ *		width IO_SIZE (a strided pattern down the chunk grid),
+ *		otherwise it is read in IO_SIZE squared tiles in
+ *		column-major order.
+ *
+ * Return:	Hit rate: fraction of chunk accesses that did not need the
+ *		chunk to be read from the file.
+ *
+ *-------------------------------------------------------------------------
+ */
+static double
+test_assoc (int tiled, unsigned nways, size_t io_size)
+{
+    hid_t	file, dset, dapl, mem_space, file_space;
+    signed char	*buf = (signed char *)calloc (1, (size_t)(CH_SIZE*ASSOC_TILE*io_size));
+    hsize_t	i, j, hs_size[2];
+    hsize_t	hs_offset[2];
+    size_t	naccess = 0;
+
+    dapl = H5Pcreate (H5P_DATASET_ACCESS);
+    H5Pset_chunk_cache (dapl, ASSOC_NSLOTS, ASSOC_CACHE*SQUARE (CH_SIZE),
+			H5D_CHUNK_CACHE_W0_DEFAULT);
+    H5Pset_chunk_cache_ways (dapl, nways);
+    file = H5Fopen(FILE_NAME, H5F_ACC_RDONLY, fapl_g);
+    dset = H5Dopen2(file, "dset", dapl);
+    file_space = H5Dget_space(dset);
+    nio_g = 0;
+
+    for (j=0; j<CH_SIZE*ASSOC_TILE; j+=io_size) {
+	for (i=0; i<CH_SIZE*ASSOC_TILE; i+=(tiled ? io_size : CH_SIZE*ASSOC_TILE)) {
+	    hs_offset[0] = i;
+	    hs_size[0] = tiled ? MIN (io_size, CH_SIZE*ASSOC_TILE-i) :
+				 CH_SIZE*ASSOC_TILE;
+	    hs_offset[1] = j;
+	    hs_size[1] = MIN (io_size, CH_SIZE*ASSOC_TILE-j);
+	    mem_space = H5Screate_simple (2, hs_size, hs_size);
+	    H5Sselect_hyperslab (file_space, H5S_SELECT_SET, hs_offset,
+				 NULL, hs_size, NULL);
+	    H5Dread (dset, H5T_NATIVE_SCHAR, mem_space, file_space,
+		     H5P_DEFAULT, buf);
+	    H5Sclose (mem_space);
+	    naccess += nchunks (hs_offset, hs_size);
+	}
+    }
+
+    free (buf);
+    H5Sclose (file_space);
+    H5Dclose (dset);
+    H5Fclose (file);
+    H5Pclose (dapl);
+
+    return 1.0 - (double)nio_g/(double)(naccess*SQUARE (CH_SIZE));
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	test_pipeline
+ *
+ * Purpose:	Reads the compressed copy of the dataset PIPE_NREADS times
+ *		with NTHREADS filter threads and no chunk cache.  When
+ *		STRIDED is non-zero every other column is read, into every
+ *		other element of the buffer.
+ *
+ * Return:	Seconds taken by the reads.
+ *
+ *-------------------------------------------------------------------------
+ */
+static double
+test_pipeline (int strided, unsigned nthreads)
+{
+    hid_t	file, dset, dapl, dxpl, space;
+    signed char	*buf = (signed char *)calloc (1, (size_t)SQUARE (CH_SIZE*DS_SIZE));
+    hsize_t	start[2] = {0, 0}, stride[2] = {1, 2};
+    hsize_t	count[2] = {CH_SIZE*DS_SIZE, CH_SIZE*DS_SIZE/2};
+    struct timeval	t_start, t_stop;
+    int		i;
+
+    dapl = H5Pcreate (H5P_DATASET_ACCESS);
+    H5Pset_chunk_cache (dapl, 0, 0, H5D_CHUNK_CACHE_W0_DEFAULT);
+    dxpl = H5Pcreate (H5P_DATASET_XFER);
+    H5Pset_filter_threads (dxpl, nthreads);
+    file = H5Fopen(FILE_NAME, H5F_ACC_RDONLY, fapl_g);
+    dset = H5Dopen2(file, PIPE_DSET, dapl);
+    space = H5Dget_space(dset);
+    if (strided)
+	H5Sselect_hyperslab (space, H5S_SELECT_SET, start, stride, count,
+			     NULL);
+
+    gettimeofday (&t_start, NULL);
+    for (i=0; i<PIPE_NREADS; i++)
+	H5Dread (dset, H5T_NATIVE_SCHAR, space, space, dxpl, buf);
+    gettimeofday (&t_stop, NULL);
+
+    free (buf);
+    H5Sclose (space);
+    H5Dclose (dset);
+    H5Fclose (file);
+    H5Pclose (dxpl);
+    H5Pclose (dapl);
+
+    return ((double)t_stop.tv_sec + (double)t_stop.tv_usec/1e6) -
+	   ((double)t_start.tv_sec + (double)t_start.tv_usec/1e6);
+}
+
+
 /*-------------------------------------------------------------------------
  * Function:	main
  *
@@ -542,6 +704,53 @@ main (void)
     fprintf (f, "pause -1\n");
 #endif
 
+#if 1
+    /*
+     * Test strided and tiled reads with direct-mapped and set-associative
+     * chunk caches.
+     */
+    printf("\nTest      %8s %8s %8s\n", "Ways", "ChunkSz",  "HitRate");
+    printf("--------- -------- -------- --------\n");
+    for (io_percent=0.25F; io_percent<=0.5F; io_percent*=2) {
+	unsigned nways;
+
+	io_size = MAX (1, (size_t)(CH_SIZE*io_percent));
+	for (nways=1; nways<=8; nways*=8) {
+	    printf ("Stride-rd %8u %8.2f", nways, io_percent);
+	    fflush (stdout);
+	    printf (" %8.2f\n", test_assoc (0, nways, io_size));
+	    printf ("Tile-rd   %8u %8.2f", nways, io_percent);
+	    fflush (stdout);
+	    printf (" %8.2f\n", test_assoc (1, nways, io_size));
+	}
+    }
+#endif
+
+#if 1
+    /*
+     * Test whole and strided reads of the compressed dataset with an
+     * increasing number of filter threads.
+     */
+    if (H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0) {
+	printf("\nTest      %8s %8s %8s\n", "Threads", "Seconds",  "Speedup");
+	printf("--------- -------- -------- --------\n");
+	int	strided;
+
+	for (strided=0; strided<2; strided++) {
+	    unsigned	nthreads;
+	    double	secs, secs1 = 0.0;
+
+	    for (nthreads=1; nthreads<=PIPE_MAX_THREADS; nthreads*=2) {
+		printf ("%s %8u", strided ? "Stride-pl" : "Whole-pl ", nthreads);
+		fflush (stdout);
+		secs = test_pipeline (strided, nthreads);
+		if (1==nthreads)
+		    secs1 = secs;
+		printf (" %8.3f %8.2f\n", secs, secs1/secs);
+	    }
+	}
+    }
+#endif
 
     H5Pclose (fapl_g);
     fclose (f);
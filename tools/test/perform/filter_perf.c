@@ -0,0 +1,412 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* ===========================================================================
+ * Usage:  filter_perf [OPTIONS]
+ *
+ * Writes and reads back a deflate-compressed chunked dataset with one
+ * H5Dwrite and one H5Dread, using an increasing number of filter pipeline
+ * threads (H5Pset_filter_threads), and reports the chunks/s for each.
+ */
+
+/* our header files */
+#include "h5test.h"
+#include "h5tools.h"
+#include "h5tools_utils.h"
+
+#ifdef H5_HAVE_FILTER_DEFLATE
+
+#define ONE_KB              1024
+#define ONE_MB              (ONE_KB * ONE_KB)
+
+#define MICROSECOND         1000000.0F
+
+/* report 0.0 in case t is zero too */
+#define PER_SEC(n,t)        ((fabs(t) < (double)0.0000000001F) ? (double)0.0F : (((double)(n)) / (t)))
+
+#define FILTER_PERF_FILE    "filter_perf.h5"
+#define FILTER_PERF_DSET    "dset"
+
+/* internal variables */
+static const char *prog = NULL;
+static const char *option_prefix = NULL;
+static char *filename = NULL;
+static int compress_level = 6;
+static int use_shuffle = FALSE;
+
+/* commandline options : long and short form */
+static const char *s_opts = "hc:n:p:St:0123456789";
+static struct long_options l_opts[] = {
+    { "help", no_arg, 'h' },
+    { "chunk-size", require_arg, 'c' },
+    { "chunk-siz", require_arg, 'c' },
+    { "chunk-si", require_arg, 'c' },
+    { "chunk-s", require_arg, 'c' },
+    { "chunk", require_arg, 'c' },
+    { "nchunks", require_arg, 'n' },
+    { "nchunk", require_arg, 'n' },
+    { "nchun", require_arg, 'n' },
+    { "nchu", require_arg, 'n' },
+    { "nch", require_arg, 'n' },
+    { "prefix", require_arg, 'p' },
+    { "prefi", require_arg, 'p' },
+    { "pref", require_arg, 'p' },
+    { "pre", require_arg, 'p' },
+    { "pr", require_arg, 'p' },
+    { "shuffle", no_arg, 'S' },
+    { "shuffl", no_arg, 'S' },
+    { "shuff", no_arg, 'S' },
+    { "shuf", no_arg, 'S' },
+    { "threads", require_arg, 't' },
+    { "thread", require_arg, 't' },
+    { "threa", require_arg, 't' },
+    { "thre", require_arg, 't' },
+    { "thr", require_arg, 't' },
+    { NULL, 0, '\0' }
+};
+
+/*
+ * Function:    error
+ * Purpose:     Display error message and exit.
+ */
+static void
+error(const char *fmt, ...)
+{
+    va_list ap;
+
+    va_start(ap, fmt);
+    HDfprintf(stderr, "%s: error: ", prog);
+    HDvfprintf(stderr, fmt, ap);
+    HDfprintf(stderr, "\n");
+    va_end(ap);
+    HDexit(EXIT_FAILURE);
+}
+
+/*
+ * Function:    cleanup
+ * Purpose:     Cleanup the output file.
+ * Returns:     Nothing
+ */
+static void
+cleanup(void)
+{
+    if (!HDgetenv("HDF5_NOCLEANUP"))
+        HDunlink(filename);
+    HDfree(filename);
+}
+
+/*
+ * Function:    get_unique_name
+ * Purpose:     Build the name of the output file from the directory prefix.
+ * Returns:     Nothing
+ */
+static void
+get_unique_name(void)
+{
+    const char *prefix = NULL;
+    const char *env = HDgetenv("HDF5_PREFIX");
+
+    if (env)
+        prefix = env;
+
+    if (option_prefix)
+        prefix = option_prefix;
+
+    if (prefix)
+        /* 2 = 1 for '/' + 1 for null terminator */
+        filename = (char *) HDmalloc(HDstrlen(prefix) + HDstrlen(FILTER_PERF_FILE) + 2);
+    else
+        filename = (char *) HDmalloc(HDstrlen(FILTER_PERF_FILE) + 1);
+
+    if (!filename)
+        error("out of memory");
+
+    filename[0] = 0;
+    if (prefix){
+        HDstrcpy(filename, prefix);
+        HDstrcat(filename, "/");
+    }
+    HDstrcat(filename, FILTER_PERF_FILE);
+}
+
+/*
+ * Function:    usage
+ * Purpose:     Print a usage message and then exit.
+ * Return:      Nothing
+ */
+static void
+usage(void)
+{
+    HDfprintf(stdout, "usage: %s [OPTIONS]\n", prog);
+    HDfprintf(stdout, "  OPTIONS\n");
+    HDfprintf(stdout, "     -h, --help                 Print this usage message and exit\n");
+    HDfprintf(stdout, "     -0...-9                    Level of compression, from 0 to 9 [default: 6]\n");
+    HDfprintf(stdout, "     -c S, --chunk-size=S       Size of each chunk [default: 1M]\n");
+    HDfprintf(stdout, "     -n N, --nchunks=N          Number of chunks in the dataset [default: 64]\n");
+    HDfprintf(stdout, "     -p D, --prefix=D           The directory prefix to place the file\n");
+    HDfprintf(stdout, "     -S, --shuffle              Apply the shuffle filter before deflate\n");
+    HDfprintf(stdout, "     -t N, --threads=N          Maximum number of filter threads; the\n");
+    HDfprintf(stdout, "                                number is doubled from 1 up to N [default: 8]\n");
+    HDfprintf(stdout, "\n");
+    HDfprintf(stdout, "  D  - a directory which exists\n");
+    HDfprintf(stdout, "  N  - a positive integer\n");
+    HDfprintf(stdout, "  S  - is a size specifier, an integer >=0 followed by a size indicator:\n");
+    HDfprintf(stdout, "\n");
+    HDfprintf(stdout, "          K - Kilobyte (%d)\n", ONE_KB);
+    HDfprintf(stdout, "          M - Megabyte (%d)\n", ONE_MB);
+    HDfprintf(stdout, "\n");
+    HDfprintf(stdout, "      Example: 4M = 4 Megabytes = %d bytes\n", 4 * ONE_MB);
+    HDfprintf(stdout, "\n");
+    HDfflush(stdout);
+}
+
+/*
+ * Function:    parse_size_directive
+ * Purpose:     Parse the size directive passed on the commandline. The size
+ *              directive is an integer followed by a size indicator:
+ *
+ *                  K, k - Kilobyte
+ *                  M, m - Megabyte
+ *
+ * Return:      The size.  If an unknown size indicator is used, then the
+ *              program will exit with EXIT_FAILURE as the return value.
+ */
+static unsigned long
+parse_size_directive(const char *size)
+{
+    unsigned long s;
+    char *endptr;
+
+    s = HDstrtoul(size, &endptr, 10);
+
+    if (endptr && *endptr) {
+        while (*endptr != '\0' && (*endptr == ' ' || *endptr == '\t'))
+            ++endptr;
+
+        switch (*endptr) {
+            case 'K':
+            case 'k':
+                s *= ONE_KB;
+                break;
+            case 'M':
+            case 'm':
+                s *= ONE_MB;
+                break;
+            default:
+                error("illegal size specifier '%c'", *endptr);
+                break;
+        }
+    }
+
+    return s;
+}
+
+/*
+ * Function:    elapsed
+ * Purpose:     Seconds between two timer readings.
+ */
+static double
+elapsed(const struct timeval *timer_start, const struct timeval *timer_stop)
+{
+    return ((double)timer_stop->tv_sec +
+                ((double)timer_stop->tv_usec) / (double)MICROSECOND) -
+           ((double)timer_start->tv_sec +
+                ((double)timer_start->tv_usec) / (double)MICROSECOND);
+}
+
+/*
+ * Function:    do_test
+ * Purpose:     Write and read back the whole dataset once with NTHREADS
+ *              filter threads, and report the rates.
+ */
+static void
+do_test(unsigned nthreads, unsigned long chunk_size, unsigned long nchunks,
+        const int *wbuf, int *rbuf)
+{
+    hsize_t dims[1], chunk_dims[1];
+    hid_t file, space, dcpl, dxpl, dset;
+    struct timeval timer_start, timer_stop;
+    double write_time, read_time;
+    size_t nelmts;
+
+    chunk_dims[0] = chunk_size / sizeof(int);
+    dims[0] = chunk_dims[0] * nchunks;
+    nelmts = (size_t)dims[0];
+
+    if ((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        error("unable to create file '%s'", filename);
+    if ((space = H5Screate_simple(1, dims, NULL)) < 0)
+        error("unable to create dataspace");
+    if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        error("unable to create dataset creation property list");
+    if (H5Pset_chunk(dcpl, 1, chunk_dims) < 0)
+        error("unable to set chunk size");
+    if (use_shuffle && H5Pset_shuffle(dcpl) < 0)
+        error("unable to set shuffle filter");
+    if (H5Pset_deflate(dcpl, (unsigned)compress_level) < 0)
+        error("unable to set deflate filter");
+    if ((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0)
+        error("unable to create dataset transfer property list");
+    if (H5Pset_filter_threads(dxpl, nthreads) < 0)
+        error("unable to set number of filter threads");
+    if ((dset = H5Dcreate2(file, FILTER_PERF_DSET, H5T_NATIVE_INT, space,
+                           H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        error("unable to create dataset");
+
+    /* Write the whole dataset, including flushing it to the file */
+    HDgettimeofday(&timer_start, NULL);
+    if (H5Dwrite(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, wbuf) < 0)
+        error("unable to write dataset");
+    if (H5Dclose(dset) < 0)
+        error("unable to close dataset");
+    if (H5Fflush(file, H5F_SCOPE_LOCAL) < 0)
+        error("unable to flush file");
+    HDgettimeofday(&timer_stop, NULL);
+    write_time = elapsed(&timer_start, &timer_stop);
+
+    /* Read the whole dataset back */
+    if ((dset = H5Dopen2(file, FILTER_PERF_DSET, H5P_DEFAULT)) < 0)
+        error("unable to open dataset");
+    HDmemset(rbuf, 0, nelmts * sizeof(int));
+    HDgettimeofday(&timer_start, NULL);
+    if (H5Dread(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0)
+        error("unable to read dataset");
+    HDgettimeofday(&timer_stop, NULL);
+    read_time = elapsed(&timer_start, &timer_stop);
+
+    if (HDmemcmp(wbuf, rbuf, nelmts * sizeof(int)))
+        error("data read doesn't match data written with %u threads", nthreads);
+
+    H5Dclose(dset);
+    H5Pclose(dxpl);
+    H5Pclose(dcpl);
+    H5Sclose(space);
+    H5Fclose(file);
+
+    HDfprintf(stdout, "%7u %12.1f %12.1f %12.1f %12.1f\n", nthreads,
+              PER_SEC(nchunks, write_time), PER_SEC(nchunks, read_time),
+              PER_SEC((double)nchunks * (double)chunk_size / (double)ONE_MB, write_time),
+              PER_SEC((double)nchunks * (double)chunk_size / (double)ONE_MB, read_time));
+    HDfflush(stdout);
+}
+
+/*
+ * Function:    main
+ * Purpose:     Run the program
+ * Return:      EXIT_SUCCESS or EXIT_FAILURE
+ */
+int
+main(int argc, char **argv)
+{
+    unsigned long chunk_size = ONE_MB, nchunks = 64;
+    unsigned max_threads = 8, nthreads;
+    hbool_t is_ts = FALSE;
+    int *wbuf, *rbuf;
+    size_t nelmts, u;
+    int opt;
+
+    prog = argv[0];
+
+    /* Initialize h5tools lib */
+    h5tools_init();
+
+    while ((opt = get_option(argc, (const char **)argv, s_opts, l_opts)) > 0) {
+        switch ((char)opt) {
+        case '0': case '1': case '2':
+        case '3': case '4': case '5':
+        case '6': case '7': case '8':
+        case '9':
+            compress_level = opt - '0';
+            break;
+        case 'c':
+            chunk_size = parse_size_directive(opt_arg);
+            break;
+        case 'n':
+            nchunks = HDstrtoul(opt_arg, NULL, 10);
+            break;
+        case 'p':
+            option_prefix = opt_arg;
+            break;
+        case 'S':
+            use_shuffle = TRUE;
+            break;
+        case 't':
+            max_threads = (unsigned)HDstrtoul(opt_arg, NULL, 10);
+            break;
+        case '?':
+            usage();
+            exit(EXIT_FAILURE);
+            break;
+        case 'h':
+        default:
+            usage();
+            exit(EXIT_SUCCESS);
+            break;
+        }
+    }
+
+    if (chunk_size < sizeof(int) || nchunks < 1 || max_threads < 1)
+        error("chunk size, number of chunks and threads must be positive");
+
+    H5is_library_threadsafe(&is_ts);
+
+    HDfprintf(stdout, "Chunk Size: %lu\n", chunk_size);
+    HDfprintf(stdout, "Chunks: %lu\n", nchunks);
+    HDfprintf(stdout, "Compression Level: %d%s\n", compress_level,
+              use_shuffle ? " (with shuffle)" : "");
+    if (!is_ts)
+        HDfprintf(stdout, "Library isn't thread-safe: filters run on the calling thread\n");
+    HDfprintf(stdout, "\n");
+
+    /* Data that compresses moderately well: a slow ramp with some noise */
+    nelmts = (chunk_size / sizeof(int)) * nchunks;
+    wbuf = (int *)HDmalloc(nelmts * sizeof(int));
+    rbuf = (int *)HDmalloc(nelmts * sizeof(int));
+    if (!wbuf || !rbuf)
+        error("out of memory");
+    for (u = 0; u < nelmts; u++)
+        wbuf[u] = (int)(u / 64) + (HDrandom() % 16);
+
+    get_unique_name();
+
+    HDfprintf(stdout, "%7s %12s %12s %12s %12s\n", "Threads", "Write chk/s",
+              "Read chk/s", "Write MB/s", "Read MB/s");
+    for (nthreads = 1; nthreads <= max_threads; nthreads <<= 1)
+        do_test(nthreads, chunk_size, nchunks, wbuf, rbuf);
+    if ((max_threads & (max_threads - 1)) != 0)
+        do_test(max_threads, chunk_size, nchunks, wbuf, rbuf);
+
+    HDfree(wbuf);
+    HDfree(rbuf);
+    cleanup();
+    return EXIT_SUCCESS;
+}
+
+#else
+
+/*
+ * Function:    main
+ * Purpose:     Dummy main() function for if HDF5 was configured without
+ *              zlib stuff.
+ * Return:      EXIT_SUCCESS
+ */
+int
+main(void)
+{
+    HDfprintf(stdout, "No filter pipeline performance because zlib was not configured\n");
+    return EXIT_SUCCESS;
+}
+
+#endif  /* !H5_HAVE_FILTER_DEFLATE */
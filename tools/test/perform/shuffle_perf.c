@@ -0,0 +1,313 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* ===========================================================================
+ * Usage:  shuffle_perf [OPTIONS]
+ *
+ * Writes and reads back a chunked dataset whose only filter is shuffle, for
+ * a range of element sizes, and reports the shuffle and unshuffle throughput.
+ * The file lives in memory (core driver) and the chunk cache is disabled,
+ * so nearly all of the time is spent in the filter.
+ */
+
+/* our header files */
+#include "h5test.h"
+#include "h5tools.h"
+#include "h5tools_utils.h"
+
+#define ONE_KB              1024
+#define ONE_MB              (ONE_KB * ONE_KB)
+
+#define MICROSECOND         1000000.0F
+
+/* report 0.0 in case t is zero too */
+#define PER_SEC(n,t)        ((fabs(t) < (double)0.0000000001F) ? (double)0.0F : (((double)(n)) / (t)))
+
+#define SHUFFLE_PERF_FILE   "shuffle_perf.h5"
+#define SHUFFLE_PERF_DSET   "dset"
+
+/* internal variables */
+static const char *prog = NULL;
+
+/* commandline options : long and short form */
+static const char *s_opts = "hc:i:n:";
+static struct long_options l_opts[] = {
+    { "help", no_arg, 'h' },
+    { "chunk-size", require_arg, 'c' },
+    { "chunk-siz", require_arg, 'c' },
+    { "chunk-si", require_arg, 'c' },
+    { "chunk-s", require_arg, 'c' },
+    { "chunk", require_arg, 'c' },
+    { "iterations", require_arg, 'i' },
+    { "iteration", require_arg, 'i' },
+    { "iteratio", require_arg, 'i' },
+    { "iterati", require_arg, 'i' },
+    { "iterat", require_arg, 'i' },
+    { "itera", require_arg, 'i' },
+    { "iter", require_arg, 'i' },
+    { "ite", require_arg, 'i' },
+    { "nchunks", require_arg, 'n' },
+    { "nchunk", require_arg, 'n' },
+    { "nchun", require_arg, 'n' },
+    { "nchu", require_arg, 'n' },
+    { "nch", require_arg, 'n' },
+    { NULL, 0, '\0' }
+};
+
+/*
+ * Function:    error
+ * Purpose:     Display error message and exit.
+ */
+static void
+error(const char *fmt, ...)
+{
+    va_list ap;
+
+    va_start(ap, fmt);
+    HDfprintf(stderr, "%s: error: ", prog);
+    HDvfprintf(stderr, fmt, ap);
+    HDfprintf(stderr, "\n");
+    va_end(ap);
+    HDexit(EXIT_FAILURE);
+}
+
+/*
+ * Function:    usage
+ * Purpose:     Print a usage message and then exit.
+ * Return:      Nothing
+ */
+static void
+usage(void)
+{
+    HDfprintf(stdout, "usage: %s [OPTIONS]\n", prog);
+    HDfprintf(stdout, "  OPTIONS\n");
+    HDfprintf(stdout, "     -h, --help                 Print this usage message and exit\n");
+    HDfprintf(stdout, "     -c S, --chunk-size=S       Size of each chunk [default: 1M]\n");
+    HDfprintf(stdout, "     -i N, --iterations=N       Number of times the dataset is written\n");
+    HDfprintf(stdout, "                                and read for each element size [default: 4]\n");
+    HDfprintf(stdout, "     -n N, --nchunks=N          Number of chunks in the dataset [default: 64]\n");
+    HDfprintf(stdout, "\n");
+    HDfprintf(stdout, "  N  - a positive integer\n");
+    HDfprintf(stdout, "  S  - is a size specifier, an integer >=0 followed by a size indicator:\n");
+    HDfprintf(stdout, "\n");
+    HDfprintf(stdout, "          K - Kilobyte (%d)\n", ONE_KB);
+    HDfprintf(stdout, "          M - Megabyte (%d)\n", ONE_MB);
+    HDfprintf(stdout, "\n");
+    HDfprintf(stdout, "      Example: 4M = 4 Megabytes = %d bytes\n", 4 * ONE_MB);
+    HDfprintf(stdout, "\n");
+    HDfflush(stdout);
+}
+
+/*
+ * Function:    parse_size_directive
+ * Purpose:     Parse the size directive passed on the commandline. The size
+ *              directive is an integer followed by a size indicator:
+ *
+ *                  K, k - Kilobyte
+ *                  M, m - Megabyte
+ *
+ * Return:      The size.  If an unknown size indicator is used, then the
+ *              program will exit with EXIT_FAILURE as the return value.
+ */
+static unsigned long
+parse_size_directive(const char *size)
+{
+    unsigned long s;
+    char *endptr;
+
+    s = HDstrtoul(size, &endptr, 10);
+
+    if (endptr && *endptr) {
+        while (*endptr != '\0' && (*endptr == ' ' || *endptr == '\t'))
+            ++endptr;
+
+        switch (*endptr) {
+            case 'K':
+            case 'k':
+                s *= ONE_KB;
+                break;
+            case 'M':
+            case 'm':
+                s *= ONE_MB;
+                break;
+            default:
+                error("illegal size specifier '%c'", *endptr);
+                break;
+        }
+    }
+
+    return s;
+}
+
+/*
+ * Function:    elapsed
+ * Purpose:     Seconds between two timer readings.
+ */
+static double
+elapsed(const struct timeval *timer_start, const struct timeval *timer_stop)
+{
+    return ((double)timer_stop->tv_sec +
+                ((double)timer_stop->tv_usec) / (double)MICROSECOND) -
+           ((double)timer_start->tv_sec +
+                ((double)timer_start->tv_usec) / (double)MICROSECOND);
+}
+
+/*
+ * Function:    do_test
+ * Purpose:     Write and read back the whole dataset NITER times using
+ *              elements of TYPE_SIZE bytes, and report the rates.
+ */
+static void
+do_test(size_t type_size, unsigned long chunk_size, unsigned long nchunks,
+        unsigned long niter, const unsigned char *wbuf, unsigned char *rbuf)
+{
+    hsize_t dims[1], chunk_dims[1];
+    hid_t fapl, file, space, type, dcpl, dapl, dset;
+    struct timeval timer_start, timer_stop;
+    double write_time = 0.0, read_time = 0.0;
+    double nmbytes;
+    size_t nbytes;
+    unsigned long u;
+
+    chunk_dims[0] = chunk_size / type_size;
+    dims[0] = chunk_dims[0] * nchunks;
+    nbytes = (size_t)dims[0] * type_size;
+
+    if ((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        error("unable to create file access property list");
+    if (H5Pset_fapl_core(fapl, (size_t)ONE_MB, FALSE) < 0)
+        error("unable to set core file driver");
+    if ((file = H5Fcreate(SHUFFLE_PERF_FILE, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        error("unable to create file '%s'", SHUFFLE_PERF_FILE);
+    if ((space = H5Screate_simple(1, dims, NULL)) < 0)
+        error("unable to create dataspace");
+    if ((type = H5Tcreate(H5T_OPAQUE, type_size)) < 0)
+        error("unable to create datatype");
+    if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        error("unable to create dataset creation property list");
+    if (H5Pset_chunk(dcpl, 1, chunk_dims) < 0)
+        error("unable to set chunk size");
+    if (H5Pset_shuffle(dcpl) < 0)
+        error("unable to set shuffle filter");
+    if ((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0)
+        error("unable to create dataset access property list");
+    if (H5Pset_chunk_cache(dapl, (size_t)0, (size_t)0, H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        error("unable to disable chunk cache");
+    if ((dset = H5Dcreate2(file, SHUFFLE_PERF_DSET, type, space,
+                           H5P_DEFAULT, dcpl, dapl)) < 0)
+        error("unable to create dataset");
+
+    for (u = 0; u < niter; u++) {
+        /* Write the whole dataset: every chunk goes through the shuffle */
+        HDgettimeofday(&timer_start, NULL);
+        if (H5Dwrite(dset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0)
+            error("unable to write dataset");
+        HDgettimeofday(&timer_stop, NULL);
+        write_time += elapsed(&timer_start, &timer_stop);
+
+        /* Read it back: every chunk goes through the unshuffle */
+        HDmemset(rbuf, 0, nbytes);
+        HDgettimeofday(&timer_start, NULL);
+        if (H5Dread(dset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
+            error("unable to read dataset");
+        HDgettimeofday(&timer_stop, NULL);
+        read_time += elapsed(&timer_start, &timer_stop);
+
+        if (HDmemcmp(wbuf, rbuf, nbytes))
+            error("data read doesn't match data written for %lu-byte elements",
+                  (unsigned long)type_size);
+    }
+
+    H5Dclose(dset);
+    H5Pclose(dapl);
+    H5Pclose(dcpl);
+    H5Tclose(type);
+    H5Sclose(space);
+    H5Fclose(file);
+    H5Pclose(fapl);
+
+    nmbytes = (double)niter * (double)nbytes / (double)ONE_MB;
+    HDfprintf(stdout, "%9lu %14.1f %14.1f\n", (unsigned long)type_size,
+              PER_SEC(nmbytes, write_time), PER_SEC(nmbytes, read_time));
+    HDfflush(stdout);
+}
+
+/*
+ * Function:    main
+ * Purpose:     Run the program
+ * Return:      EXIT_SUCCESS or EXIT_FAILURE
+ */
+int
+main(int argc, char **argv)
+{
+    /* 3 and 12 have no vectorized kernel and show the scalar rate */
+    const size_t type_sizes[] = {2, 3, 4, 8, 12, 16};
+    unsigned long chunk_size = ONE_MB, nchunks = 64, niter = 4;
+    unsigned char *wbuf, *rbuf;
+    size_t nbytes, u;
+    int opt;
+
+    prog = argv[0];
+
+    /* Initialize h5tools lib */
+    h5tools_init();
+
+    while ((opt = get_option(argc, (const char **)argv, s_opts, l_opts)) > 0) {
+        switch ((char)opt) {
+        case 'c':
+            chunk_size = parse_size_directive(opt_arg);
+            break;
+        case 'i':
+            niter = HDstrtoul(opt_arg, NULL, 10);
+            break;
+        case 'n':
+            nchunks = HDstrtoul(opt_arg, NULL, 10);
+            break;
+        case '?':
+            usage();
+            exit(EXIT_FAILURE);
+            break;
+        case 'h':
+        default:
+            usage();
+            exit(EXIT_SUCCESS);
+            break;
+        }
+    }
+
+    if (chunk_size < 16 || nchunks < 1 || niter < 1)
+        error("chunk size must be at least 16 bytes; chunks and iterations must be positive");
+
+    HDfprintf(stdout, "Chunk Size: %lu\n", chunk_size);
+    HDfprintf(stdout, "Chunks: %lu\n", nchunks);
+    HDfprintf(stdout, "Iterations: %lu\n", niter);
+    HDfprintf(stdout, "\n");
+
+    nbytes = (size_t)chunk_size * (size_t)nchunks;
+    wbuf = (unsigned char *)HDmalloc(nbytes);
+    rbuf = (unsigned char *)HDmalloc(nbytes);
+    if (!wbuf || !rbuf)
+        error("out of memory");
+    for (u = 0; u < nbytes; u++)
+        wbuf[u] = (unsigned char)HDrandom();
+
+    HDfprintf(stdout, "%9s %14s %14s\n", "Elem Size", "Shuffle MB/s", "Unshuffle MB/s");
+    for (u = 0; u < NELMTS(type_sizes); u++)
+        do_test(type_sizes[u], chunk_size, nchunks, niter, wbuf, rbuf);
+
+    HDfree(wbuf);
+    HDfree(rbuf);
+    return EXIT_SUCCESS;
+}
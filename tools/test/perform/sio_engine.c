@@ -1185,6 +1185,11 @@ set_vfd(parameters *param)
         /* Linux direct read() and write() system calls.  Set memory boundary, file block size,
          * and copy buffer size to the default values. */
         if (H5Pset_fapl_direct(my_fapl, 1024, 4096, 8*4096)<0) return -1;
+#endif
+    } else if (vfd == iouring) {
+#ifdef H5_HAVE_IOURING
+        /* Linux io_uring, with the default queue depth */
+        if (H5Pset_fapl_iouring(my_fapl, 0)<0) return -1;
 #endif
     } else {
         /* Unknown driver */